@@ -283,16 +283,12 @@ function unsafe_copyto!(dest::Array{T}, doffs, src::Array{T}, soffs, n) where T
         ccall(:jl_array_ptr_copy, Cvoid, (Any, Ptr{Cvoid}, Any, Ptr{Cvoid}, Int),
               dest, destp, src, srcp, n)
     elseif isbitstype(T)
-        ccall(:memmove, Ptr{Cvoid}, (Ptr{Cvoid}, Ptr{Cvoid}, Csize_t),
+        ccall(:jl_memmove_bulk, Ptr{Cvoid}, (Ptr{Cvoid}, Ptr{Cvoid}, Csize_t),
               destp, srcp, n * aligned_sizeof(T))
     elseif isbitsunion(T)
-        ccall(:memmove, Ptr{Cvoid}, (Ptr{Cvoid}, Ptr{Cvoid}, Csize_t),
-              destp, srcp, n * aligned_sizeof(T))
-        # copy selector bytes
-        ccall(:memmove, Ptr{Cvoid}, (Ptr{Cvoid}, Ptr{Cvoid}, Csize_t),
-              ccall(:jl_array_typetagdata, Ptr{UInt8}, (Any,), dest) + doffs - 1,
-              ccall(:jl_array_typetagdata, Ptr{UInt8}, (Any,), src) + soffs - 1,
-              n)
+        # single fused kernel moves the data and selector bytes together
+        ccall(:jl_array_bitsunion_copy, Cvoid, (Any, Csize_t, Any, Csize_t, Csize_t),
+              dest, doffs - 1, src, soffs - 1, n)
     else
         _unsafe_copyto!(dest, doffs, src, soffs, n)
     end
@@ -345,6 +341,13 @@ copyto!(dest::Array{T}, src::Array{T}) where {T} = copyto!(dest, 1, src, 1, leng
 # for bootstrapping purposes.
 function fill!(dest::Array{T}, x) where T
     xT = convert(T, x)
+    if isbitsunion(T)
+        # bulk kernel writes the selector bytes with one memset and the
+        # element data with a doubling pattern copy
+        ccall(:jl_array_bitsunion_fill, Cvoid, (Any, Any, Csize_t, Csize_t),
+              dest, xT, 0, length(dest) % Csize_t)
+        return dest
+    end
     for i in eachindex(dest)
         @inbounds dest[i] = xT
     end
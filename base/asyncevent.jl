@@ -97,19 +97,18 @@ mutable struct Timer
         # libuv has a tendency to timeout 1 ms early, so we need +1 on the timeout (in milliseconds), unless it is zero
         timeoutms = ceil(UInt64, timeout * 1000) + !iszero(timeout)
         intervalms = ceil(UInt64, interval * 1000)
-        loop = eventloop()
 
-        this = new(Libc.malloc(_sizeof_uv_timer), ThreadSynchronizer(), true, false)
-        associate_julia_struct(this.handle, this)
+        # timers are lightweight entries in the runtime's timer wheel, not
+        # full uv handles; one uv timer drives expiry for all of them
+        this = new(C_NULL, ThreadSynchronizer(), true, false)
         iolock_begin()
-        err = ccall(:uv_timer_init, Cint, (Ptr{Cvoid}, Ptr{Cvoid}), loop, this)
-        @assert err == 0
+        preserve_handle(this)
+        handle = ccall(:jl_timer_wheel_start, Ptr{Cvoid},
+                       (UInt64, UInt64, Ptr{Cvoid}, Any),
+                       timeoutms, intervalms,
+                       @cfunction(wheel_timercb, Cvoid, (Any,)), this)
+        @atomic :monotonic this.handle = handle
         finalizer(uvfinalize, this)
-        ccall(:uv_update_time, Cvoid, (Ptr{Cvoid},), loop)
-        err = ccall(:uv_timer_start, Cint, (Ptr{Cvoid}, Ptr{Cvoid}, UInt64, UInt64),
-            this, @cfunction(uv_timercb, Cvoid, (Ptr{Cvoid},)),
-            timeoutms, intervalms)
-        @assert err == 0
         iolock_end()
         return this
     end
@@ -159,7 +158,7 @@ end
 
 isopen(t::Union{Timer, AsyncCondition}) = t.isopen && t.handle != C_NULL
 
-function close(t::Union{Timer, AsyncCondition})
+function close(t::AsyncCondition)
     iolock_begin()
     if isopen(t)
         @atomic :monotonic t.isopen = false
@@ -169,7 +168,45 @@ function close(t::Union{Timer, AsyncCondition})
     nothing
 end
 
-function uvfinalize(t::Union{Timer, AsyncCondition})
+function close(t::Timer)
+    iolock_begin()
+    if isopen(t)
+        @atomic :monotonic t.isopen = false
+        h = @atomicswap :monotonic t.handle = C_NULL
+        if h != C_NULL
+            ccall(:jl_timer_wheel_stop, Cvoid, (Ptr{Cvoid},), h)
+            unpreserve_handle(t)
+        end
+        lock(t.cond)
+        try
+            notify(t.cond, false)
+        finally
+            unlock(t.cond)
+        end
+    end
+    iolock_end()
+    nothing
+end
+
+function uvfinalize(t::Timer)
+    iolock_begin()
+    lock(t.cond)
+    try
+        h = @atomicswap :monotonic t.handle = C_NULL
+        if h != C_NULL
+            @atomic :monotonic t.isopen = false
+            ccall(:jl_timer_wheel_stop, Cvoid, (Ptr{Cvoid},), h)
+            unpreserve_handle(t)
+            notify(t.cond, false)
+        end
+    finally
+        unlock(t.cond)
+    end
+    iolock_end()
+    nothing
+end
+
+function uvfinalize(t::AsyncCondition)
     iolock_begin()
     lock(t.cond)
     try
@@ -189,7 +226,7 @@ function uvfinalize(t::Union{Timer, AsyncCondition})
     nothing
 end
 
-function _uv_hook_close(t::Union{Timer, AsyncCondition})
+function _uv_hook_close(t::AsyncCondition)
     lock(t.cond)
     try
         @atomic :monotonic t.isopen = false
@@ -213,14 +250,19 @@ function uv_asynccb(handle::Ptr{Cvoid})
     nothing
 end
 
-function uv_timercb(handle::Ptr{Cvoid})
-    t = @handle_as handle Timer
+function wheel_timercb(t::Timer)
+    # runs on the thread pumping the event loop, under the iolock,
+    # exactly like a uv_timer_cb
     lock(t.cond)
     try
         @atomic :monotonic t.set = true
-        if ccall(:uv_timer_get_repeat, UInt64, (Ptr{Cvoid},), t) == 0
-            # timer is stopped now
-            close(t)
+        h = t.handle
+        if h != C_NULL && ccall(:jl_timer_wheel_get_repeat, UInt64, (Ptr{Cvoid},), h) == 0
+            # one-shot: the wheel frees the entry when this callback
+            # returns, so drop our reference without stopping it
+            @atomic :monotonic t.isopen = false
+            @atomic :monotonic t.handle = C_NULL
+            unpreserve_handle(t)
         end
         notify(t.cond, true)
     finally
@@ -151,6 +151,25 @@ function copy_chunks!(dest::Vector{UInt64}, pos_d::Int, src::Vector{UInt64}, pos
     delta_ks = ks1 - ks0
 
     u = _msk64
+
+    if ld0 == ls0
+        # source and destination are bit-aligned: the interior is a straight
+        # (memmove-style) chunk copy and only the boundary chunks need masking
+        if delta_kd == 0
+            msk_d0 = ~(u << ld0) | (u << (ld1+1))
+            @inbounds dest[kd0] = (dest[kd0] & msk_d0) | (src[ks0] & ~msk_d0)
+            return
+        end
+        msk_d0 = ~(u << ld0)
+        msk_d1 = (u << (ld1+1))
+        @inbounds begin
+            dest[kd0] = (dest[kd0] & msk_d0) | (src[ks0] & ~msk_d0)
+            delta_kd > 1 && copyto!(dest, kd0 + 1, src, ks0 + 1, delta_kd - 1)
+            dest[kd1] = (dest[kd1] & msk_d1) | (src[ks1] & ~msk_d1)
+        end
+        return
+    end
+
     if delta_kd == 0
         msk_d0 = ~(u << ld0) | (u << (ld1+1))
     else
@@ -169,14 +188,27 @@ function copy_chunks!(dest::Vector{UInt64}, pos_d::Int, src::Vector{UInt64}, pos
 
     delta_kd == 0 && return
 
-    for i = 1 : kd1 - kd0 - 1
-        chunk_s1 = glue_src_bitchunks(src, ks0 + i, ks1, msk_s0, ls0)
-
-        chunk_s = (chunk_s0 >>> (64 - ld0)) | (chunk_s1 << ld0)
-
-        dest[kd0 + i] = chunk_s
-
-        chunk_s0 = chunk_s1
+    # the branches inside glue_src_bitchunks are invariant over the interior
+    # chunks, so hoist them out and fuse the shifts into a plain funnel loop
+    if ls0 == 0
+        @inbounds for i = 1 : kd1 - kd0 - 1
+            chunk_s1 = src[ks0 + i]
+            dest[kd0 + i] = (chunk_s0 >>> (64 - ld0)) | (chunk_s1 << ld0)
+            chunk_s0 = chunk_s1
+        end
+    elseif delta_ks >= delta_kd # every interior chunk spans two source chunks
+        @inbounds for i = 1 : kd1 - kd0 - 1
+            k = ks0 + i
+            chunk_s1 = (src[k] >>> ls0) | (src[k + 1] << (64 - ls0))
+            dest[kd0 + i] = (chunk_s0 >>> (64 - ld0)) | (chunk_s1 << ld0)
+            chunk_s0 = chunk_s1
+        end
+    else
+        for i = 1 : kd1 - kd0 - 1
+            chunk_s1 = glue_src_bitchunks(src, ks0 + i, ks1, msk_s0, ls0)
+            dest[kd0 + i] = (chunk_s0 >>> (64 - ld0)) | (chunk_s1 << ld0)
+            chunk_s0 = chunk_s1
+        end
     end
 
     if ks1 >= ks0 + delta_kd
@@ -42,7 +42,12 @@ mutable struct IdDict{K,V} <: AbstractDict{K,V}
         d
     end
 
-    IdDict{K,V}(d::IdDict{K,V}) where {K, V} = new{K,V}(copy(d.ht), d.count, d.ndel)
+    function IdDict{K,V}(d::IdDict{K,V}) where {K, V}
+        # finish any pending incremental growth first, so that the new
+        # table is fully described by the single copied array
+        d.ht = ccall(:jl_idtable_drain, Vector{Any}, (Any,), d.ht)
+        new{K,V}(copy(d.ht), d.count, d.ndel)
+    end
 end
 
 IdDict() = IdDict{Any,Any}()
@@ -93,7 +98,7 @@ function setindex!(d::IdDict{K,V}, @nospecialize(val), @nospecialize(key)) where
         d.ndel = 0
     end
     inserted = RefValue{Cint}(0)
-    d.ht = ccall(:jl_eqtable_put, Array{Any,1}, (Any, Any, Any, Ptr{Cint}), d.ht, key, val, inserted)
+    d.ht = ccall(:jl_eqtable_put_incremental, Array{Any,1}, (Any, Any, Any, Ptr{Cint}), d.ht, key, val, inserted)
     d.count += inserted[]
     return d
 end
@@ -143,6 +148,11 @@ end
 _oidd_nextind(a, i) = reinterpret(Int, ccall(:jl_eqtable_nextind, Csize_t, (Any, Csize_t), a, i))
 
 function iterate(d::IdDict{K,V}, idx=0) where {K, V}
+    if idx == 0
+        # finish any pending incremental growth, so that walking the
+        # backing array visits every entry exactly once
+        d.ht = ccall(:jl_idtable_drain, Vector{Any}, (Any,), d.ht)
+    end
     idx = _oidd_nextind(d.ht, idx)
     idx == -1 && return nothing
     return (Pair{K, V}(d.ht[idx + 1]::K, d.ht[idx + 2]::V), idx + 2)
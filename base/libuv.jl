@@ -103,17 +103,22 @@ uv_error(prefix::AbstractString, c::Integer) = c < 0 ? throw(_UVError(prefix, c)
 
 eventloop() = ccall(:jl_global_event_loop, Ptr{Cvoid}, ())
 
-function process_events()
-    return ccall(:jl_process_events, Int32, ())
+# shard == -1 pumps the global event loop; 0 <= shard < n_event_shards()
+# pumps one of the sharded loops (see `JULIA_UV_SHARDS` and src/jl_uv.c)
+function process_events(shard::Integer = -1)
+    return ccall(:jl_process_events, Int32, (Cint,), shard)
 end
 
+n_event_shards() = Int(ccall(:jl_uv_n_event_shards, Cint, ()))
+shard_eventloop(shard::Integer) = ccall(:jl_uv_shard_loop, Ptr{Cvoid}, (Cint,), shard)
+
 function uv_alloc_buf end
 function uv_readcb end
 function uv_writecb_task end
 function uv_shutdowncb_task end
 function uv_return_spawn end
 function uv_asynccb end
-function uv_timercb end
+function wheel_timercb end
 
 function reinit_stdio()
     global stdin = init_stdio(ccall(:jl_stdin_stream, Ptr{Cvoid}, ()))
@@ -833,18 +833,28 @@ function find_all_in_cache_path(pkg::PkgId)
                  (pkg.uuid !== nothing && startswith(file, entryfile * "_")))
                  continue
             end
-            filepath = joinpath(path, file)
-            isfile_casesensitive(filepath) && push!(paths, filepath)
+            push!(paths, joinpath(path, file))
         end
     end
-    if length(paths) > 1
-        # allocating the sort vector is less expensive than using sort!(.. by=mtime), which would
-        # call the relatively slow mtime multiple times per path
-        p = sortperm(mtime.(paths), rev = true)
-        return paths[p]
-    else
-        return paths
+    isempty(paths) && return paths
+    # one batched stat answers both the existence filter and the mtime sort;
+    # the names come straight from readdir, so their case is already exact
+    sts = Filesystem.statbatch(paths)
+    keep = [i for i in eachindex(paths) if isfile(sts[i])]
+    if length(keep) > 1
+        sort!(keep, by = i -> mtime(sts[i]), rev = true)
     end
+    return paths[keep]
+end
+
+# Ask the kernel to begin reading `paths` into the page cache. The hint is
+# asynchronous and best-effort, so queueing every candidate cache file before
+# stale_cachefile walks them one by one overlaps their disk reads instead of
+# paying a cold sequential read per file.
+function prefetch_cache_files(paths::Vector{String})
+    isempty(paths) && return nothing
+    ccall(:jl_prefetch_files, Cvoid, (Ptr{Ptr{UInt8}}, Csize_t), paths, length(paths))
+    nothing
 end
 
 # use an Int counter so that nested @time_imports calls all remain open
@@ -1043,18 +1053,32 @@ end
 @constprop :none function _require_search_from_serialized(pkg::PkgId, sourcepath::String, build_id::UInt64)
     assert_havelock(require_lock)
     paths = find_all_in_cache_path(pkg)
+    prefetch_cache_files(paths)
     for path_to_try in paths::Vector{String}
         staledeps = stale_cachefile(pkg, build_id, sourcepath, path_to_try)
         if staledeps === true
             continue
         end
         staledeps = staledeps::Vector{Any}
+        # collect every dependency's candidate caches up front and start
+        # readahead on all of them, so verifying dependency i below overlaps
+        # with the disk reads for dependencies i+1..n
+        depmodpaths = Vector{Vector{String}}(undef, length(staledeps))
+        prefetchpaths = String[]
+        for i in 1:length(staledeps)
+            dep = staledeps[i]
+            dep isa Module && continue
+            modpaths = find_all_in_cache_path((dep::Tuple{String, PkgId, UInt64})[2])
+            depmodpaths[i] = modpaths
+            append!(prefetchpaths, modpaths)
+        end
+        prefetch_cache_files(prefetchpaths)
         # finish checking staledeps module graph
         for i in 1:length(staledeps)
             dep = staledeps[i]
             dep isa Module && continue
             modpath, modkey, modbuild_id = dep::Tuple{String, PkgId, UInt64}
-            modpaths = find_all_in_cache_path(modkey)
+            modpaths = depmodpaths[i]
             modfound = false
             for modpath_to_try in modpaths::Vector{String}
                 modstaledeps = stale_cachefile(modkey, modbuild_id, modpath, modpath_to_try)
@@ -1471,7 +1495,9 @@ function include_string(mapexpr::Function, mod::Module, code::AbstractString,
                         filename::AbstractString="string")
     loc = LineNumberNode(1, Symbol(filename))
     try
-        ast = Meta.parseall(code, filename=filename)
+        # equivalent to Meta.parseall, but consults the on-disk parse cache
+        # (JULIA_PARSE_CACHE) before running the parser
+        ast = ccall(:jl_parse_all_cached, Any, (Any, Any), String(code), String(filename))
         @assert Meta.isexpr(ast, :toplevel)
         result = nothing
         line_and_ex = Expr(:toplevel, loc, nothing)
@@ -2276,6 +2302,56 @@ function precompile(@nospecialize(argt::Type))
     return ret
 end
 
+# Invoked from jl_precompile (precompile.c) before native code emission when
+# running with multiple threads: run type inference for the enqueued method
+# instances on all threads, so that the serial emission loop that follows only
+# reads already-cached inferred code.
+function _parallel_precompile_infer(worklist::Vector{Any})
+    world = ccall(:jl_get_world_counter, UInt, ())
+    ch = Channel{Any}(length(worklist))
+    for item in worklist
+        # the worklist also carries svec(rettype, sig) ccallable requests,
+        # which have no inference work of their own
+        item isa Core.MethodInstance && put!(ch, item)
+    end
+    close(ch)
+    @sync for _ in 1:Threads.nthreads()
+        Threads.@spawn for mi in ch
+            ccall(:jl_precompile_infer, Cvoid, (Any, UInt), mi, world)
+        end
+    end
+    nothing
+end
+
+# Invoked from jl_verify_edges (dump.c) when restoring a package cache with
+# multiple threads: validate the recorded call edges concurrently. `targets`
+# is the serialized [callee1, matches1, ...] list and `valids[i]` receives the
+# verdict for edge `i`.
+function _parallel_verify_edges(targets::Vector{Any}, valids::Vector{UInt8})
+    n = length(valids)
+    chunk = cld(n, Threads.nthreads())
+    @sync for r in Iterators.partition(1:n, chunk)
+        Threads.@spawn for i in r
+            valids[i] = ccall(:jl_verify_edge_target, Cint, (Any, Csize_t), targets, i - 1) % UInt8
+        end
+    end
+    nothing
+end
+
+# Invoked from _jl_restore_incremental (dump.c) when JULIA_PKG_WARMUP is set:
+# compile the restored precompile-flagged method instances on a background
+# task so that first calls into the freshly loaded package skip JIT latency.
+function _background_warmup(mis::Vector{Any})
+    Threads.@spawn for mi in mis
+        try
+            precompile((mi::Core.MethodInstance).specTypes)
+        catch
+            # a stale or uncompilable signature is not worth a warning here
+        end
+    end
+    nothing
+end
+
 precompile(include_package_for_output, (PkgId, String, Vector{String}, Vector{String}, Vector{String}, typeof(_concrete_dependencies), Nothing))
 precompile(include_package_for_output, (PkgId, String, Vector{String}, Vector{String}, Vector{String}, typeof(_concrete_dependencies), String))
 precompile(create_expr_cache, (PkgId, String, String, typeof(_concrete_dependencies), IO, IO))
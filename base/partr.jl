@@ -10,7 +10,13 @@ mutable struct taskheap
     const tasks::Vector{Task}
     @atomic ntasks::Int32
     @atomic priority::UInt16
-    taskheap() = new(SpinLock(), Vector{Task}(undef, 256), zero(Int32), typemax(UInt16))
+    # pad each heap out to its own cache line: deletemin's two-choice probe
+    # reads every candidate heap's `priority`, and without the padding
+    # adjacent heaps share a line, so one heap's insertions invalidate its
+    # neighbors' probes
+    const _pad::NTuple{5,UInt64}
+    taskheap() = new(SpinLock(), Vector{Task}(undef, 256), zero(Int32), typemax(UInt16),
+                     ntuple(_ -> zero(UInt64), 5))
 end
 
 
@@ -29,6 +35,297 @@ function unbias_cong(max::UInt32)
 end
 
 
+# Per-thread work-stealing deques
+#
+# Tasks scheduled with the default priority go to the scheduling thread's own
+# deque instead of the multiqueue: the owner pushes and pops at the tail (LIFO,
+# which keeps fork/join work hot in cache), thieves take from the head (FIFO).
+# Every operation holds the deque's spinlock, but only steals ever contend on
+# it -- the owner's push/pop hits an uncontended lock, so the multiqueue's
+# global sift/trylock traffic disappears from the hot path. The multiqueue is
+# kept for tasks with an explicit priority.
+
+mutable struct workdeque
+    const lock::SpinLock
+    buffer::Vector{Task}
+    head::Int64    # index of the oldest task (steal end)
+    tail::Int64    # index one past the newest task (owner end)
+    @atomic ntasks::Int32
+    workdeque() = new(SpinLock(), Vector{Task}(undef, 256), 1, 1, zero(Int32))
+end
+
+const deques = [Vector{workdeque}(undef, 0), Vector{workdeque}(undef, 0)]
+const deques_lock = [SpinLock(), SpinLock()]
+
+function deques_resize(tp::Int)
+    nt = nthreads()
+    tpdeques = deques[tp]
+    if length(tpdeques) >= nt
+        return tpdeques
+    end
+    @lock deques_lock[tp] begin
+        tpdeques = deques[tp]
+        if length(tpdeques) < nt
+            newdeques = copyto!(Vector{workdeque}(undef, nt), tpdeques)
+            for i = (1 + length(tpdeques)):nt
+                newdeques[i] = workdeque()
+            end
+            deques[tp] = newdeques
+            tpdeques = newdeques
+        end
+        return tpdeques
+    end
+end
+
+function deque_push!(q::workdeque, task::Task)
+    @lock q.lock begin
+        n = length(q.buffer)
+        len = Int(q.tail - q.head)
+        if len >= n
+            newbuffer = Vector{Task}(undef, 2 * n)
+            for i = 1:len
+                newbuffer[i] = q.buffer[mod1(Int(q.head) + i - 1, n)]
+            end
+            q.buffer = newbuffer
+            q.head = 1
+            q.tail = len + 1
+            n = 2 * n
+        end
+        q.buffer[mod1(Int(q.tail), n)] = task
+        q.tail += 1
+        @atomic :monotonic q.ntasks = Int32(len + 1)
+    end
+    return true
+end
+
+# Owner pop: newest task first.
+function deque_pop!(q::workdeque)
+    q.ntasks == 0 && return nothing
+    @lock q.lock begin
+        q.tail == q.head && return nothing
+        q.tail -= 1
+        idx = mod1(Int(q.tail), length(q.buffer))
+        task = q.buffer[idx]
+        Base._unsetindex!(q.buffer, idx)
+        @atomic :monotonic q.ntasks = Int32(q.tail - q.head)
+        return task
+    end
+end
+
+# FIFO pop from the head; unlike `deque_steal!` this waits for the lock, so
+# the strict-priority lane cannot be skipped just because it is contended.
+function deque_popfirst!(q::workdeque)
+    q.ntasks == 0 && return nothing
+    @lock q.lock begin
+        q.tail == q.head && return nothing
+        idx = mod1(Int(q.head), length(q.buffer))
+        task = q.buffer[idx]
+        Base._unsetindex!(q.buffer, idx)
+        q.head += 1
+        @atomic :monotonic q.ntasks = Int32(q.tail - q.head)
+        return task
+    end
+end
+
+# Thief pop: oldest task first.
+function deque_steal!(q::workdeque)
+    q.ntasks == 0 && return nothing
+    trylock(q.lock) || return nothing
+    try
+        q.tail == q.head && return nothing
+        idx = mod1(Int(q.head), length(q.buffer))
+        task = q.buffer[idx]
+        Base._unsetindex!(q.buffer, idx)
+        q.head += 1
+        @atomic :monotonic q.ntasks = Int32(q.tail - q.head)
+        return task
+    finally
+        unlock(q.lock)
+    end
+end
+
+# Pick a thread of threadpool `tp` pinned to NUMA node `sock` (0 if none),
+# starting from a random offset so hinted work spreads across the node.
+function socket_thread(tp::Int, sock::Int16)
+    nt = UInt32(nthreads())
+    rn = cong(nt, unbias_cong(nt))
+    for i = 0:(nt - 1)
+        t = Int(mod1(rn + i, nt))
+        ccall(:jl_threadpoolid, Int8, (Int16,), t - 1) + 1 == tp || continue
+        if ccall(:jl_thread_socket, Int16, (Int16,), t - 1) == sock
+            return t
+        end
+    end
+    return 0
+end
+
+# Pick any thread of threadpool `tp`, starting from a random offset so
+# cross-pool inserts spread across the pool's deques.
+function pool_thread(tp::Int)
+    nt = UInt32(nthreads())
+    rn = cong(nt, unbias_cong(nt))
+    for i = 0:(nt - 1)
+        t = Int(mod1(rn + i, nt))
+        if ccall(:jl_threadpoolid, Int8, (Int16,), t - 1) + 1 == tp
+            return t
+        end
+    end
+    return 0
+end
+
+function deque_insert(task::Task)
+    tid = threadid()
+    # route by the *task's* pool, not the inserting thread's: an :interactive
+    # task spawned from a default-pool thread must land in the interactive
+    # pool's deques (and vice versa), just as multiq_insert keys its heap
+    # selection on jl_get_task_threadpoolid
+    tp = Int(ccall(:jl_get_task_threadpoolid, Int8, (Any,), task)) + 1
+    tpdeques = deques_resize(tp)
+    target = ccall(:jl_threadpoolid, Int8, (Int16,), tid - 1) + 1 == tp ?
+        tid : pool_thread(tp)
+    if ccall(:jl_n_sockets, Int16, ()) > 1
+        # keep the task near its working set: a task hinted to (or last run
+        # on) another NUMA node goes to the deque of a thread pinned there,
+        # where same-node stealing will pick it up
+        sock = ccall(:jl_get_task_socket, Int16, (Any,), task)
+        if sock >= 0 && (target == 0 ||
+                sock != ccall(:jl_thread_socket, Int16, (Int16,), target - 1))
+            t = socket_thread(tp, sock)
+            t > 0 && (target = t)
+        end
+    end
+    if target == 0
+        # no thread in the task's pool yet; use our own slot of that pool's
+        # deque vector, where work conservation can still pick it up
+        target = tid
+    end
+    if target == tid
+        return deque_push!(@inbounds(tpdeques[tid]), task)
+    end
+    deque_push!(@inbounds(tpdeques[target]), task)
+    ccall(:jl_wakeup_thread, Cvoid, (Int16,), Int16(target - 1))
+    return true
+end
+
+function deque_deletemin()
+    tid = threadid()
+    tp = ccall(:jl_threadpoolid, Int8, (Int16,), tid - 1) + 1
+    tpdeques = deques_resize(Int(tp))
+    # our own deque first
+    task = deque_pop!(@inbounds tpdeques[tid])
+    if task !== nothing
+        if ccall(:jl_set_task_tid, Cint, (Any, Cint), task, tid - 1) != 0
+            return task
+        end
+        # claimed by (or sticky to) another thread; make it stealable again
+        deque_push!(@inbounds(tpdeques[tid]), task)
+        return nothing
+    end
+    # steal from a random victim in our threadpool; on multi-node machines
+    # (JULIA_NUMA pinning) try victims on our own node first, since pulling
+    # a compute task across sockets drags its working set along
+    nq = UInt32(length(tpdeques))
+    rn = cong(nq, unbias_cong(nq))
+    npasses = ccall(:jl_n_sockets, Int16, ()) > 1 ? 2 : 1
+    my_socket = ccall(:jl_thread_socket, Int16, (Int16,), tid - 1)
+    for pass = 1:npasses
+        for i = 0:(nq - 1)
+            victim = Int(mod1(rn + i, nq))
+            victim == tid && continue
+            ccall(:jl_threadpoolid, Int8, (Int16,), victim - 1) + 1 == tp || continue
+            if npasses == 2
+                local_victim = ccall(:jl_thread_socket, Int16, (Int16,), victim - 1) == my_socket
+                (pass == 1) == local_victim || continue
+            end
+            task = deque_steal!(@inbounds tpdeques[victim])
+            if task !== nothing
+                # 2 == JL_SCHED_EV_STEAL (scheduler decision tracing, src/partr.c)
+                ccall(:jl_sched_trace_note, Cvoid, (Cint, Cint), 2, victim - 1)
+                if ccall(:jl_set_task_tid, Cint, (Any, Cint), task, tid - 1) != 0
+                    return task
+                end
+                deque_push!(@inbounds(tpdeques[tid]), task)
+                return nothing
+            end
+        end
+    end
+    return nothing
+end
+
+function deque_check_empty()
+    for j = 1:length(deques)
+        for i = 1:length(deques[j])
+            if deques[j][i].ntasks != 0
+                return false
+            end
+        end
+    end
+    return true
+end
+
+
+# Strict-priority lanes
+#
+# One FIFO per threadpool, drained before any deque or heap is looked at, so
+# a designated task (jl_set_task_priority_lane, encoded as priority 1) never
+# waits behind bulk work in its pool. Latency-critical tasks go here; the
+# multiqueue's randomized two-choice ordering is only approximate and can
+# invert priorities under load.
+
+const lanes = [workdeque(), workdeque()]
+
+function lane_deletemin(tp::Int)
+    task = deque_popfirst!(lanes[tp])
+    task === nothing && return nothing
+    if ccall(:jl_set_task_tid, Cint, (Any, Cint), task, threadid() - 1) == 0
+        # claimed by (or sticky to) another thread
+        deque_push!(lanes[tp], task)
+        return nothing
+    end
+    return task
+end
+
+function lane_check_empty()
+    for i = 1:length(lanes)
+        if lanes[i].ntasks != 0
+            return false
+        end
+    end
+    return true
+end
+
+
+# Work conservation (jl_set_work_conservation): when enabled, an idle thread
+# in the default pool may run work queued for the interactive pool -- never
+# the other way around, so bulk compute tasks can never occupy an
+# interactive thread.
+
+work_conserving() = ccall(:jl_get_work_conservation, Int8, ()) != 0
+
+# steal from the deques of another threadpool (no own-deque fast path)
+function deque_steal_other(tp::Int)
+    tpdeques = deques[tp]
+    nq = UInt32(length(tpdeques))
+    nq == 0 && return nothing
+    tid = threadid()
+    rn = cong(nq, unbias_cong(nq))
+    for i = 0:(nq - 1)
+        victim = Int(mod1(rn + i, nq))
+        task = deque_steal!(@inbounds tpdeques[victim])
+        if task !== nothing
+            # 2 == JL_SCHED_EV_STEAL (scheduler decision tracing, src/partr.c)
+            ccall(:jl_sched_trace_note, Cvoid, (Cint, Cint), 2, victim - 1)
+            if ccall(:jl_set_task_tid, Cint, (Any, Cint), task, tid - 1) != 0
+                return task
+            end
+            deque_push!(@inbounds(tpdeques[victim]), task)
+            return nothing
+        end
+    end
+    return nothing
+end
+
+
 function multiq_sift_up(heap::taskheap, idx::Int32)
     while idx > Int32(1)
         parent = (idx - Int32(2)) ÷ heap_d + Int32(1)
@@ -93,6 +390,31 @@ function multiq_size(tpid::Int8)
 end
 
 
+# Add heaps beyond the thread-count-based sizing when sustained insertion
+# contention shows the current fanout is too small for the load; capped so a
+# burst cannot balloon the scan cost of deletemin forever.
+function multiq_grow(tpid::Int8)
+    tp = tpid + 1
+    @lock heaps_lock[tp] begin
+        tpheaps = heaps[tp]
+        nt = UInt32(Threads._nthreads_in_pool(tpid))
+        heap_p = UInt32(length(tpheaps))
+        if heap_p >= UInt32(8) * nt
+            return heap_p
+        end
+        heap_p += nt
+        newheaps = Vector{taskheap}(undef, heap_p)
+        copyto!(newheaps, tpheaps)
+        for i = (1 + length(tpheaps)):heap_p
+            newheaps[i] = taskheap()
+        end
+        heaps[tp] = newheaps
+        cong_unbias[tp] = unbias_cong(heap_p)
+        return heap_p
+    end
+end
+
+
 function multiq_insert(task::Task, priority::UInt16)
     tpid = ccall(:jl_get_task_threadpoolid, Int8, (Any,), task)
     heap_p = multiq_size(tpid)
@@ -102,7 +424,20 @@ function multiq_insert(task::Task, priority::UInt16)
 
     rn = cong(heap_p, cong_unbias[tp])
     tpheaps = heaps[tp]
+    failures = 0
     while !trylock(tpheaps[rn].lock)
+        # randomized exponential backoff: without it a burst of inserters
+        # re-probes immediately and hammers the same contended lines
+        failures += 1
+        for _ in 1:cong(UInt32(1) << min(failures, 6), typemax(UInt32))
+            ccall(:jl_cpu_pause, Cvoid, ())
+        end
+        if failures >= 8
+            # sustained contention: widen the fanout and spread out
+            heap_p = multiq_grow(tpid)
+            tpheaps = heaps[tp]
+            failures = 0
+        end
         rn = cong(heap_p, cong_unbias[tp])
     end
 
@@ -125,12 +460,11 @@ function multiq_insert(task::Task, priority::UInt16)
 end
 
 
-function multiq_deletemin()
+function multiq_deletemin(tp::Int = Int(ccall(:jl_threadpoolid, Int8, (Int16,), Threads.threadid()-1)) + 1)
     local rn1, rn2
     local prio1, prio2
 
     tid = Threads.threadid()
-    tp = ccall(:jl_threadpoolid, Int8, (Int16,), tid-1) + 1
     tpheaps = heaps[tp]
 
     @label retry
@@ -191,4 +525,42 @@ function multiq_check_empty()
     return true
 end
 
+
+# Entry points used by `Base.enq_work` and the scheduler: default-priority
+# tasks use the work-stealing deques, priority-1 tasks the strict lane, and
+# tasks with any other explicit priority still go through the multiqueue.
+
+function queue_insert(task::Task)
+    prio = task.priority
+    if prio == zero(UInt16)
+        return deque_insert(task)
+    elseif prio == one(UInt16)
+        tp = ccall(:jl_get_task_threadpoolid, Int8, (Any,), task) + 1
+        return deque_push!(lanes[Int(tp)], task)
+    end
+    return multiq_insert(task, prio)
+end
+
+function queue_deletemin()
+    tid = threadid()
+    tp = Int(ccall(:jl_threadpoolid, Int8, (Int16,), tid - 1)) + 1
+    task = lane_deletemin(tp)
+    task === nothing || return task
+    task = deque_deletemin()
+    task === nothing || return task
+    task = multiq_deletemin(tp)
+    task === nothing || return task
+    # work conservation: tp 1 is the default pool, tp 2 the interactive one
+    if tp == 1 && work_conserving()
+        task = lane_deletemin(2)
+        task === nothing || return task
+        task = deque_steal_other(2)
+        task === nothing || return task
+        return multiq_deletemin(2)
+    end
+    return nothing
+end
+
+queue_check_empty() = lane_check_empty() && deque_check_empty() && multiq_check_empty()
+
 end
@@ -1086,6 +1086,7 @@ struct CodegenParams
     track_allocations::Cint
     code_coverage::Cint
     prefer_specsig::Cint
+    speculate_globals::Cint
     gnu_pubnames::Cint
     debug_info_kind::Cint
 
@@ -1094,13 +1095,13 @@ struct CodegenParams
     generic_context::Any
 
     function CodegenParams(; track_allocations::Bool=true, code_coverage::Bool=true,
-                   prefer_specsig::Bool=false,
+                   prefer_specsig::Bool=false, speculate_globals::Bool=false,
                    gnu_pubnames=true, debug_info_kind::Cint = default_debug_info_kind(),
                    lookup::Ptr{Cvoid}=cglobal(:jl_rettype_inferred),
                    generic_context = nothing)
         return new(
             Cint(track_allocations), Cint(code_coverage),
-            Cint(prefer_specsig),
+            Cint(prefer_specsig), Cint(speculate_globals),
             Cint(gnu_pubnames), debug_info_kind,
             lookup, generic_context)
     end
@@ -722,6 +722,27 @@ function radix_sort!(v::AbstractVector{U}, lo::Integer, hi::Integer, bits::Unsig
 
     v
 end
+# Native kernels for dense Vectors of machine-width keys: the runtime does one
+# histogram prescan covering every pass and skips passes whose keys all share a
+# digit, which the uint mapping's minimum subtraction makes common in the high
+# bytes. Same buffer contract as the generic method above.
+function radix_sort!(v::Vector{U}, lo::Integer, hi::Integer, bits::Unsigned,
+                     t::Vector{U}, chunk_size=radix_chunk_size_heuristic(lo, hi, bits)) where U <: Union{UInt16, UInt32, UInt64}
+    n = hi - lo + 1
+    flipped = GC.@preserve v t begin
+        if U === UInt64
+            ccall(:jl_radix_sort_64, Cint, (Ptr{UInt64}, Ptr{UInt64}, Csize_t, Cuint),
+                  pointer(v, lo), pointer(t, lo), n, bits)
+        elseif U === UInt32
+            ccall(:jl_radix_sort_32, Cint, (Ptr{UInt32}, Ptr{UInt32}, Csize_t, Cuint),
+                  pointer(v, lo), pointer(t, lo), n, bits)
+        else
+            ccall(:jl_radix_sort_16, Cint, (Ptr{UInt16}, Ptr{UInt16}, Csize_t, Cuint),
+                  pointer(v, lo), pointer(t, lo), n, bits)
+        end
+    end
+    flipped == 0 ? v : t
+end
 function radix_chunk_size_heuristic(lo::Integer, hi::Integer, bits::Unsigned)
     # chunk_size is the number of bits to radix over at once.
     # We need to allocate an array of size 2^chunk size, and on the other hand the higher
@@ -167,6 +167,41 @@ if RawFD !== OS_HANDLE
 end
 stat(fd::Integer)           = stat(RawFD(fd))
 
+"""
+    statbatch(paths) -> Vector{StatStruct}
+
+Stat every path in `paths` in one batched call. The individual stat requests
+overlap on libuv's filesystem threadpool, so this is much faster than calling
+[`stat`](@ref) in a loop when probing many paths on high-latency storage.
+Nonexistent paths yield a [`StatStruct`](@ref) with [`ispath`](@ref) `false`,
+matching `stat`; other errors throw.
+"""
+function statbatch(paths::AbstractVector{<:AbstractString})
+    n = length(paths)
+    sz = Int(ccall(:jl_sizeof_stat, Int32, ()))
+    stat_bufs = zeros(UInt8, n * sz)
+    rets = Vector{Int32}(undef, n)
+    cpaths = String[String(p) for p in paths]
+    GC.@preserve cpaths begin
+        ptrs = Ptr{UInt8}[pointer(p) for p in cpaths]
+        ccall(:jl_stat_batch, Cvoid, (Ptr{Ptr{UInt8}}, Csize_t, Ptr{UInt8}, Ptr{Int32}),
+              ptrs, n, stat_bufs, rets)
+    end
+    sts = Vector{StatStruct}(undef, n)
+    GC.@preserve stat_bufs for i = 1:n
+        r = rets[i]
+        if !(r in (0, Base.UV_ENOENT, Base.UV_ENOTDIR, Base.UV_EINVAL))
+            uv_error(string("stat(", repr(cpaths[i]), ")"), r)
+        end
+        st = StatStruct(cpaths[i], pointer(stat_bufs, (i - 1) * sz + 1))
+        if ispath(st) != (r == 0)
+            error("stat returned zero type for a valid path")
+        end
+        sts[i] = st
+    end
+    return sts
+end
+
 """
     stat(file)
 
@@ -1032,6 +1032,25 @@ end
 
 uv_write(s::LibuvStream, p::Vector{UInt8}) = GC.@preserve p uv_write(s, pointer(p), UInt(sizeof(p)))
 
+"""
+    uv_write_splice(s::LibuvStream, p::Vector{UInt8})
+
+Fire-and-forget write: hand `p`'s memory to libuv by reference instead of
+copying it or parking the current task until the write drains. The runtime
+keeps `p` rooted until the write completes, so `p` must not be mutated or
+reused afterwards — pass a freshly `take!`n buffer. Write errors are sticky
+on the stream and surface on the next blocking write.
+"""
+function uv_write_splice(s::LibuvStream, p::Vector{UInt8})
+    check_open(s)
+    iolock_begin()
+    err = ccall(:jl_uv_write_splice, Int32, (Ptr{Cvoid}, Ptr{UInt8}, Csize_t, Any),
+                s.handle, p, sizeof(p) % Csize_t, p)
+    iolock_end()
+    uv_error("write", err)
+    return sizeof(p)
+end
+
 # caller must have acquired the iolock
 function uv_write(s::LibuvStream, p::Ptr{UInt8}, n::UInt)
     uvw = uv_write_async(s, p, n)
@@ -207,7 +207,17 @@ _nthbyte(t::AbstractVector, index) = t[index + (firstindex(t)-1)]
 function _searchindex(s::String, t::String, i::Integer)
     # Check for fast case of a single byte
     lastindex(t) == 1 && return something(findnext(isequal(t[1]), s, i), 0)
-    _searchindex(unsafe_wrap(Vector{UInt8},s), unsafe_wrap(Vector{UInt8},t), i)
+    # the runtime's vectorized substring search beats the byte loop below
+    n = ncodeunits(t)
+    m = ncodeunits(s)
+    j = Int(i)
+    (j < 1 || j > m + 1) && throw(BoundsError(s, i))
+    n == 0 && return j
+    (m == 0 || j + n - 1 > m) && return 0
+    r = GC.@preserve s t ccall(:jl_memmem, Int64,
+                               (Ptr{UInt8}, Csize_t, Ptr{UInt8}, Csize_t),
+                               pointer(s) + j - 1, m - j + 1, pointer(t), n)
+    return r < 0 ? 0 : Int(r) + j
 end
 
 function _searchindex(s::AbstractVector{<:Union{Int8,UInt8}},
@@ -223,6 +223,32 @@ function cpu_info()
     return cpus
 end
 
+struct CPUTopology
+    logical_cpus::Cint
+    smt_threads::Cint
+    cores_per_llc::Cint
+    l1d_size::UInt32
+    l1d_linesize::UInt32
+    l2_size::UInt32
+    l2_sharing::UInt32
+    l3_size::UInt32
+    l3_sharing::UInt32
+end
+
+"""
+    Sys.cpu_topology() -> Sys.CPUTopology
+
+Return the host CPU cache and core topology detected by the runtime: the
+number of online logical CPUs, hardware threads per core, cores sharing the
+last-level cache, and the sizes (in bytes), line size and sharing degree of
+the L1 data, L2 and L3 caches. A field is zero when the platform does not
+expose that information. Intended for libraries that derive cache-blocking
+parameters at load time.
+"""
+function cpu_topology()
+    unsafe_load(ccall(:jl_cpu_topology, Ptr{CPUTopology}, ()))
+end
+
 """
     Sys.uptime()
 
@@ -760,7 +760,7 @@ function enq_work(t::Task)
         end
         push!(workqueue_for(tid), t)
     else
-        Partr.multiq_insert(t, t.priority)
+        Partr.queue_insert(t)
         tid = 0
     end
     ccall(:jl_wakeup_thread, Cvoid, (Int16,), (tid - 1) % Int16)
@@ -931,10 +931,10 @@ function trypoptask(W::StickyWorkqueue)
         end
         return t
     end
-    return Partr.multiq_deletemin()
+    return Partr.queue_deletemin()
 end
 
-checktaskempty = Partr.multiq_check_empty
+checktaskempty = Partr.queue_check_empty
 
 @noinline function poptask(W::StickyWorkqueue)
     task = trypoptask(W)
@@ -960,3 +960,18 @@ if Sys.iswindows()
 else
     pause() = ccall(:pause, Cvoid, ())
 end
+
+# Tiered execution support (JULIA_TIERED_COMPILE): the runtime calls this after
+# installing an interpreted baseline for `mi`, so the optimizing compile runs on
+# a background task and is published when ready. See jl_compile_method_internal.
+function _background_tier_compile(mi::Core.MethodInstance, world::UInt)
+    t = Task(function ()
+        try
+            ccall(:jl_tiered_compile_upgrade, Cvoid, (Any, UInt), mi, world)
+        catch
+        end
+    end)
+    t.sticky = false
+    schedule(t)
+    nothing
+end
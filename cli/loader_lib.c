@@ -218,9 +218,15 @@ __attribute__((constructor)) void jl_load_libjulia_internal(void) {
         codegen_liberr = " from libjulia-codegen\n";
     }
 
-    // Once we have libjulia-internal loaded, re-export its symbols:
+    // Once we have libjulia-internal loaded, re-export its symbols.
+    // libjulia-internal publishes its own address table (loader_exports.c) in
+    // the same jl_exported_funcs.inc order as our name list, so normally a
+    // single lookup binds every trampoline; fall back to resolving each
+    // symbol individually if the table is unavailable (e.g. stripped).
+    void *const *runtime_func_table = (void *const *)lookup_symbol(libjulia_internal, "jl_runtime_exported_func_table");
     for (unsigned int symbol_idx=0; jl_runtime_exported_func_names[symbol_idx] != NULL; ++symbol_idx) {
-        void *addr = lookup_symbol(libjulia_internal, jl_runtime_exported_func_names[symbol_idx]);
+        void *addr = runtime_func_table != NULL ? runtime_func_table[symbol_idx]
+                   : lookup_symbol(libjulia_internal, jl_runtime_exported_func_names[symbol_idx]);
         if (addr == NULL) {
             jl_loader_print_stderr3("ERROR: Unable to load ", jl_runtime_exported_func_names[symbol_idx], " from libjulia-internal\n");
             exit(1);
@@ -38,6 +38,10 @@
 
 enum ArgClass { Integer, Sse, SseUp, X87, X87Up, ComplexX87, NoClass, Memory };
 
+// memoized aggregate classifications, keyed by datatype pointer identity;
+// declared in julia_internal.h so the GC can root the keys
+jl_abi_classify_slot_t jl_abi_classify_cache[N_ABI_CLASSIFY_CACHE];
+
 struct ABI_x86_64Layout : AbiLayout {
 
 // used to track the state of the ABI generator during
@@ -161,10 +165,43 @@ void classifyType(Classification& accum, jl_datatype_t *dt, uint64_t offset) con
     }
 }
 
+// Classification depends only on the (immutable) field layout of dt, but is
+// requested several times per value while generating a signature (once in
+// use_sret or needPassByRef and again in preferred_llvm_type) and re-derived
+// for every ccall emission that mentions the type.  The scalar cases are
+// resolved inline without any table; aggregates go through a direct-mapped
+// memo table like subtype_memo_cache: the GC roots the keys (see mark_roots),
+// so pointer equality really does mean the same type object (a collected
+// type's address could otherwise be recycled and inherit its classification),
+// and a colliding entry is simply overwritten, bounding what the table pins.
+// Emission runs under the codegen lock, which serializes everything but the
+// GC's read of the keys.
 Classification classify(jl_datatype_t *dt) const
 {
     Classification cl;
+    if (dt == jl_float64_type || dt == jl_float32_type) {
+        cl.addField(0, Sse);
+        return cl;
+    }
+    if (jl_is_primitivetype(dt) && jl_datatype_size(dt) <= 8) {
+        // covers pointers; ghosts stay NoClass
+        if (jl_datatype_size(dt) != 0)
+            cl.addField(0, Integer);
+        return cl;
+    }
+    jl_abi_classify_slot_t *slot =
+        &jl_abi_classify_cache[inthash((uintptr_t)dt) & (N_ABI_CLASSIFY_CACHE - 1)];
+    if (jl_atomic_load_relaxed(&slot->dt) == dt) {
+        cl.isMemory = slot->isMemory;
+        cl.classes[0] = (ArgClass)slot->classes[0];
+        cl.classes[1] = (ArgClass)slot->classes[1];
+        return cl;
+    }
     classifyType(cl, dt, 0);
+    slot->isMemory = cl.isMemory;
+    slot->classes[0] = (uint8_t)cl.classes[0];
+    slot->classes[1] = (uint8_t)cl.classes[1];
+    jl_atomic_store_relaxed(&slot->dt, dt);
     return cl;
 }
 
@@ -46,13 +46,16 @@
 #endif
 
 // for outputting code
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/Bitcode/BitcodeWriterPass.h>
 #include "llvm/Object/ArchiveWriter.h"
 #include <llvm/IR/IRPrintingPasses.h>
 
 #include <llvm/IR/LegacyPassManagers.h>
+#include <llvm/Support/ThreadPool.h>
 #include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
 
 
 using namespace llvm;
@@ -478,26 +481,31 @@ void jl_dump_native_impl(void *native_code,
     TheTriple.setObjectFormat(Triple::MachO);
     TheTriple.setOS(llvm::Triple::MacOSX);
 #endif
-    std::unique_ptr<TargetMachine> TM(
-        jl_ExecutionEngine->getTarget().createTargetMachine(
-            TheTriple.getTriple(),
-            jl_ExecutionEngine->getTargetCPU(),
-            jl_ExecutionEngine->getTargetFeatureString(),
-            jl_ExecutionEngine->getTargetOptions(),
+    // TargetMachines are not thread-safe, so give every emission thread its
+    // own instance built with the same configuration
+    auto createTM = [&TheTriple]() {
+        return std::unique_ptr<TargetMachine>(
+            jl_ExecutionEngine->getTarget().createTargetMachine(
+                TheTriple.getTriple(),
+                jl_ExecutionEngine->getTargetCPU(),
+                jl_ExecutionEngine->getTargetFeatureString(),
+                jl_ExecutionEngine->getTargetOptions(),
 #if defined(_OS_LINUX_) || defined(_OS_FREEBSD_)
-            Reloc::PIC_,
+                Reloc::PIC_,
 #else
-            Optional<Reloc::Model>(),
+                Optional<Reloc::Model>(),
 #endif
 #if defined(_CPU_PPC_) || defined(_CPU_PPC64_)
-            // On PPC the small model is limited to 16bit offsets
-            CodeModel::Medium,
+                // On PPC the small model is limited to 16bit offsets
+                CodeModel::Medium,
 #else
-            // Use small model so that we can use signed 32bits offset in the function and GV tables
-            CodeModel::Small,
+                // Use small model so that we can use signed 32bits offset in the function and GV tables
+                CodeModel::Small,
 #endif
-            CodeGenOpt::Aggressive // -O3 TODO: respect command -O0 flag?
-            ));
+                CodeGenOpt::Aggressive // -O3 TODO: respect command -O0 flag?
+                ));
+    };
+    std::unique_ptr<TargetMachine> TM = createTM();
 
 
     // set up optimization passes
@@ -514,6 +522,7 @@ void jl_dump_native_impl(void *native_code,
     std::vector<NewArchiveMember> asm_Archive;
     std::vector<NewArchiveMember> unopt_bc_Archive;
     std::vector<std::string> outputs;
+    std::vector<std::string> shard_names; // archive member names must outlive writeArchive
 
     PassBuilder emptyPB;
     AnalysisManagers empty(emptyPB);
@@ -601,7 +610,123 @@ void jl_dump_native_impl(void *native_code,
             emit_result(asm_Archive, asm_Buffer, asm_Name, outputs);
     };
 
-    add_output(*dataM, "unopt.bc", "text.bc", "text.o", "text.s");
+    // Optionally partition the text module into shards compiled on a thread
+    // pool. Each shard runs the same pipeline on a private TargetMachine and
+    // LLVMContext (neither is thread-safe), and the resulting archive members
+    // are put back together by the system linker when the image is built, so
+    // the split is invisible in the final object. Multiversioning runs once
+    // over the whole module before splitting, which keeps the clone sets and
+    // dispatch tables coherent across shards (the per-shard pipelines see it
+    // as already done and skip it).
+    int nshards = 1;
+    if (char *env = getenv("JULIA_IMAGE_THREADS")) {
+        nshards = atoi(env);
+        if (nshards < 1)
+            nshards = 1;
+    }
+    if (nshards > 1) {
+        if (unopt_bc_fname) {
+            preopt.run(*dataM, empty.MAM);
+            emit_result(unopt_bc_Archive, unopt_bc_Buffer, "unopt.bc", outputs);
+        }
+        {
+            // multiversioning emits absolute tables under this flag, since
+            // base-relative offsets cannot relocate across shard objects
+            dataM->addModuleFlag(Module::Error, "julia.image.sharded", 1);
+            legacy::PassManager mvpass;
+            addTargetPasses(&mvpass, TM->getTargetTriple(), TM->getTargetIRAnalysis());
+            mvpass.add(createMultiVersioningPass(false));
+            mvpass.run(*dataM);
+        }
+        // hand each shard to a worker as bitcode, to be re-parsed into a
+        // context owned by that thread
+        std::vector<SmallVector<char, 0>> shard_bc(nshards);
+        unsigned si = 0;
+        SplitModule(*dataM, nshards, [&](std::unique_ptr<Module> MPart) {
+            raw_svector_ostream OS(shard_bc[si++]);
+            WriteBitcodeToFile(*MPart, OS);
+        }, false);
+        struct ShardOutput {
+            SmallVector<char, 0> bc;
+            SmallVector<char, 0> obj;
+            SmallVector<char, 0> asm_;
+        };
+        std::vector<ShardOutput> shard_out(nshards);
+        ThreadPool pool(hardware_concurrency(nshards));
+        for (int i = 0; i < nshards; i++) {
+            pool.async([&, i]() {
+                LLVMContext ShardCtx;
+                auto MPart = cantFail(parseBitcodeFile(
+                        MemoryBufferRef(StringRef(shard_bc[i].data(), shard_bc[i].size()), "text"),
+                        ShardCtx));
+                if (i != 0) {
+                    // only the primary shard defines the pgcstack relocation
+                    // slots (see LowerPTLS) and the CRT interposers below
+                    MPart->addModuleFlag(Module::Error, "julia.image.secondary_shard", 1);
+                }
+                auto ShardTM = createTM();
+                legacy::PassManager shardopt;
+                addTargetPasses(&shardopt, ShardTM->getTargetTriple(), ShardTM->getTargetIRAnalysis());
+                addOptimizationPasses(&shardopt, jl_options.opt_level, true, true);
+                addMachinePasses(&shardopt, jl_options.opt_level);
+                shardopt.run(*MPart);
+                if (i == 0) {
+                    // the half-float helpers only need (and only tolerate) one
+                    // weak definition across the whole image
+                    LLVMContext &C = ShardCtx;
+                    injectCRTAlias(*MPart, "__gnu_h2f_ieee", "julia__gnu_h2f_ieee",
+                            FunctionType::get(Type::getFloatTy(C), { Type::getHalfTy(C) }, false));
+                    injectCRTAlias(*MPart, "__extendhfsf2", "julia__gnu_h2f_ieee",
+                            FunctionType::get(Type::getFloatTy(C), { Type::getHalfTy(C) }, false));
+                    injectCRTAlias(*MPart, "__gnu_f2h_ieee", "julia__gnu_f2h_ieee",
+                            FunctionType::get(Type::getHalfTy(C), { Type::getFloatTy(C) }, false));
+                    injectCRTAlias(*MPart, "__truncsfhf2", "julia__gnu_f2h_ieee",
+                            FunctionType::get(Type::getHalfTy(C), { Type::getFloatTy(C) }, false));
+                    injectCRTAlias(*MPart, "__truncdfhf2", "julia__truncdfhf2",
+                            FunctionType::get(Type::getHalfTy(C), { Type::getDoubleTy(C) }, false));
+                }
+                if (bc_fname) {
+                    PassBuilder shardPB;
+                    AnalysisManagers shardAM(shardPB);
+                    ModulePassManager MPM;
+                    raw_svector_ostream OS(shard_out[i].bc);
+                    MPM.addPass(BitcodeWriterPass(OS));
+                    MPM.run(*MPart, shardAM.MAM);
+                }
+                legacy::PassManager shardemit;
+                addTargetPasses(&shardemit, ShardTM->getTargetTriple(), ShardTM->getTargetIRAnalysis());
+                raw_svector_ostream shard_obj_OS(shard_out[i].obj);
+                raw_svector_ostream shard_asm_OS(shard_out[i].asm_);
+                if (obj_fname)
+                    if (ShardTM->addPassesToEmitFile(shardemit, shard_obj_OS, nullptr, CGFT_ObjectFile, false))
+                        jl_safe_printf("ERROR: target does not support generation of object files\n");
+                if (asm_fname)
+                    if (ShardTM->addPassesToEmitFile(shardemit, shard_asm_OS, nullptr, CGFT_AssemblyFile, false))
+                        jl_safe_printf("ERROR: target does not support generation of object files\n");
+                shardemit.run(*MPart);
+            });
+        }
+        pool.wait();
+        shard_names.reserve(3 * nshards); // SSO buffers move on reallocation
+        for (int i = 0; i < nshards; i++) {
+            std::string suffix = "#" + std::to_string(i + 1);
+            if (bc_fname) {
+                shard_names.push_back("text" + suffix + ".bc");
+                emit_result(bc_Archive, shard_out[i].bc, shard_names.back(), outputs);
+            }
+            if (obj_fname) {
+                shard_names.push_back("text" + suffix + ".o");
+                emit_result(obj_Archive, shard_out[i].obj, shard_names.back(), outputs);
+            }
+            if (asm_fname) {
+                shard_names.push_back("text" + suffix + ".s");
+                emit_result(asm_Archive, shard_out[i].asm_, shard_names.back(), outputs);
+            }
+        }
+    }
+    else {
+        add_output(*dataM, "unopt.bc", "text.bc", "text.o", "text.s");
+    }
 
     orc::ThreadSafeModule sysimage(std::make_unique<Module>("sysimage", Context), TSCtx);
     auto sysimageM = sysimage.getModuleUnlocked();
@@ -821,6 +946,10 @@ void addOptimizationPasses(legacy::PassManagerBase *PM, int opt_level,
     PM->add(createCorrelatedValuePropagationPass());
     PM->add(createDeadCodeEliminationPass());
 
+    // Remove bounds checks subsumed by a dominating check (after GVN has
+    // unified the array length loads they test against)
+    PM->add(createBoundsCheckElimPass());
+
     PM->add(createInductiveRangeCheckEliminationPass()); // Must come between the two GVN passes
 
     // Run instcombine after redundancy elimination to exploit opportunities
@@ -11,6 +11,9 @@
 #include "julia.h"
 #include "julia_internal.h"
 #include "julia_assert.h"
+#ifdef _CPU_X86_64_
+#include <emmintrin.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,6 +55,54 @@ static inline void memmove_safe(int hasptr, char *dst, const char *src, size_t n
         memmove(dst, src, nb);
 }
 
+#ifdef _CPU_X86_64_
+// at this size and bigger, copies bypass the cache with non-temporal stores:
+// the data is far larger than the last-level cache, so cached stores would
+// evict useful lines and pay read-for-ownership traffic for lines that are
+// about to be fully overwritten anyway
+#define MEMCPY_STREAM_THRESH (4 * 1024 * 1024)
+
+static void memcpy_stream(char *dst, const char *src, size_t nb) JL_NOTSAFEPOINT
+{
+    // align the store side; the loads can stay unaligned
+    size_t head = (0 - (uintptr_t)dst) & 15;
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    nb -= head;
+    while (nb >= 64) {
+        __m128i x0 = _mm_loadu_si128((const __m128i*)src);
+        __m128i x1 = _mm_loadu_si128((const __m128i*)(src + 16));
+        __m128i x2 = _mm_loadu_si128((const __m128i*)(src + 32));
+        __m128i x3 = _mm_loadu_si128((const __m128i*)(src + 48));
+        _mm_stream_si128((__m128i*)dst, x0);
+        _mm_stream_si128((__m128i*)(dst + 16), x1);
+        _mm_stream_si128((__m128i*)(dst + 32), x2);
+        _mm_stream_si128((__m128i*)(dst + 48), x3);
+        dst += 64;
+        src += 64;
+        nb -= 64;
+    }
+    _mm_sfence();
+    memcpy(dst, src, nb);
+}
+#endif
+
+// memmove for bulk array data: very large non-overlapping copies stream
+// around the cache (see MEMCPY_STREAM_THRESH), everything else is a plain
+// memmove
+JL_DLLEXPORT void *jl_memmove_bulk(void *dst, const void *src, size_t nb) JL_NOTSAFEPOINT
+{
+#ifdef _CPU_X86_64_
+    if (nb >= MEMCPY_STREAM_THRESH &&
+        ((char*)dst + nb <= (const char*)src || (const char*)src + nb <= (char*)dst)) {
+        memcpy_stream((char*)dst, (const char*)src, nb);
+        return dst;
+    }
+#endif
+    return memmove(dst, src, nb);
+}
+
 // array constructors ---------------------------------------------------------
 JL_DLLEXPORT char *jl_array_typetagdata(jl_array_t *a) JL_NOTSAFEPOINT
 {
@@ -96,7 +147,8 @@ JL_DLLEXPORT int jl_array_validate_dims(size_t *nel, size_t *tot, uint32_t ndims
 }
 
 static jl_array_t *_new_array_(jl_value_t *atype, uint32_t ndims, size_t *dims,
-                               int8_t isunboxed, int8_t hasptr, int8_t isunion, int8_t zeroinit, size_t elsz)
+                               int8_t isunboxed, int8_t hasptr, int8_t isunion, int8_t zeroinit,
+                               size_t elsz, size_t align)
 {
     jl_task_t *ct = jl_current_task;
     size_t i, tot, nel;
@@ -122,7 +174,11 @@ static jl_array_t *_new_array_(jl_value_t *atype, uint32_t ndims, size_t *dims,
 
     int ndimwords = jl_array_ndimwords(ndims);
     int tsz = sizeof(jl_array_t) + ndimwords*sizeof(size_t);
-    if (tot <= ARRAY_INLINE_NBYTES) {
+    // pool objects are only guaranteed 16-byte alignment, so inline data can
+    // only promise more than JL_SMALL_BYTE_ALIGNMENT once the object is large
+    // enough to come from the (cache-aligned) big object allocator
+    if (tot <= ARRAY_INLINE_NBYTES &&
+        (align <= JL_SMALL_BYTE_ALIGNMENT || tot >= ARRAY_CACHE_ALIGN_THRESHOLD)) {
         // align data area
         if (tot >= ARRAY_CACHE_ALIGN_THRESHOLD)
             tsz = JL_ARRAY_ALIGN(tsz, JL_CACHE_BYTE_ALIGNMENT);
@@ -138,7 +194,10 @@ static jl_array_t *_new_array_(jl_value_t *atype, uint32_t ndims, size_t *dims,
         data = (char*)a + doffs;
     }
     else {
-        data = jl_gc_managed_malloc(tot);
+        if (jl_buf_mmapped(tot, ndims, isunion))
+            data = jl_gc_managed_mmap(tot);
+        else
+            data = jl_gc_managed_malloc(tot);
         // Allocate the Array **after** allocating the data
         // to make sure the array is still young
         a = (jl_array_t*)jl_gc_alloc(ct->ptls, tsz, atype);
@@ -155,6 +214,7 @@ static jl_array_t *_new_array_(jl_value_t *atype, uint32_t ndims, size_t *dims,
         ((char*)data)[tot - 1] = '\0';
     a->length = nel;
     a->flags.ndims = ndims;
+    a->flags.hashint = 0;
     a->flags.ptrarray = !isunboxed;
     a->flags.hasptr = hasptr;
     a->elsize = elsz;
@@ -195,13 +255,13 @@ static inline jl_array_t *_new_array(jl_value_t *atype, uint32_t ndims, size_t *
     }
     int zi = !isunboxed || hasptr || isunion || (jl_is_datatype(eltype) && ((jl_datatype_t*)eltype)->zeroinit);
 
-    return _new_array_(atype, ndims, dims, isunboxed, hasptr, isunion, zi, elsz);
+    return _new_array_(atype, ndims, dims, isunboxed, hasptr, isunion, zi, elsz, 0);
 }
 
 jl_array_t *jl_new_array_for_deserialization(jl_value_t *atype, uint32_t ndims, size_t *dims,
                                              int isunboxed, int hasptr, int isunion, int elsz)
 {
-    return _new_array_(atype, ndims, dims, isunboxed, hasptr, isunion, 0, (size_t)elsz);
+    return _new_array_(atype, ndims, dims, isunboxed, hasptr, isunion, 0, (size_t)elsz, 0);
 }
 
 #ifndef JL_NDEBUG
@@ -236,6 +296,7 @@ JL_DLLEXPORT jl_array_t *jl_reshape_array(jl_value_t *atype, jl_array_t *data,
     // copy data (except dims) from the old object
     a->flags.pooled = tsz <= GC_MAX_SZCLASS;
     a->flags.ndims = ndims;
+    a->flags.hashint = 0;
     a->offset = 0;
     a->data = NULL;
     a->flags.isaligned = data->flags.isaligned;
@@ -289,6 +350,7 @@ JL_DLLEXPORT jl_array_t *jl_string_to_array(jl_value_t *str)
     a = (jl_array_t*)jl_gc_alloc(ct->ptls, tsz, jl_array_uint8_type);
     a->flags.pooled = tsz <= GC_MAX_SZCLASS;
     a->flags.ndims = 1;
+    a->flags.hashint = 0;
     a->offset = 0;
     a->data = jl_string_data(str);
     a->flags.isaligned = 0;
@@ -340,6 +402,7 @@ JL_DLLEXPORT jl_array_t *jl_ptr_to_array_1d(jl_value_t *atype, void *data,
     a->flags.ptrarray = !isunboxed;
     a->flags.hasptr = isunboxed && (jl_is_datatype(eltype) && ((jl_datatype_t*)eltype)->layout->npointers > 0);
     a->flags.ndims = 1;
+    a->flags.hashint = 0;
     a->flags.isshared = 1;
     a->flags.isaligned = 0;  // TODO: allow passing memalign'd buffers
     if (own_buffer) {
@@ -405,6 +468,7 @@ JL_DLLEXPORT jl_array_t *jl_ptr_to_array(jl_value_t *atype, void *data,
     a->flags.ptrarray = !isunboxed;
     a->flags.hasptr = isunboxed && (jl_is_datatype(eltype) && ((jl_datatype_t*)eltype)->layout->npointers > 0);
     a->flags.ndims = ndims;
+    a->flags.hashint = 0;
     a->offset = 0;
     a->flags.isshared = 1;
     a->flags.isaligned = 0;
@@ -424,6 +488,30 @@ JL_DLLEXPORT jl_array_t *jl_ptr_to_array(jl_value_t *atype, void *data,
     return a;
 }
 
+// Construct an array over externally managed memory (e.g. an mmap'd or
+// shared-memory region) without copying it. Unlike `jl_ptr_to_array` with
+// `own_buffer`, the GC never touches the buffer itself: when the wrapper
+// object becomes unreachable, `release` (if non-NULL) is called with the
+// array so the caller can munmap the region or drop its reference count.
+// The array cannot be resized (its data is marked shared).
+JL_DLLEXPORT jl_array_t *jl_map_array_1d(jl_value_t *atype, void *data, size_t nel,
+                                         void (*release)(jl_array_t *a))
+{
+    jl_array_t *a = jl_ptr_to_array_1d(atype, data, nel, 0);
+    if (release != NULL)
+        jl_gc_add_ptr_finalizer(jl_current_task->ptls, (jl_value_t*)a, (void*)release);
+    return a;
+}
+
+JL_DLLEXPORT jl_array_t *jl_map_array(jl_value_t *atype, void *data, jl_value_t *_dims,
+                                      void (*release)(jl_array_t *a))
+{
+    jl_array_t *a = jl_ptr_to_array(atype, data, _dims, 0);
+    if (release != NULL)
+        jl_gc_add_ptr_finalizer(jl_current_task->ptls, (jl_value_t*)a, (void*)release);
+    return a;
+}
+
 JL_DLLEXPORT jl_array_t *jl_new_array(jl_value_t *atype, jl_value_t *_dims)
 {
     size_t ndims = jl_nfields(_dims);
@@ -436,6 +524,33 @@ JL_DLLEXPORT jl_array_t *jl_alloc_array_1d(jl_value_t *atype, size_t nr)
     return _new_array(atype, 1, &nr);
 }
 
+// Like `jl_alloc_array_1d`, but guarantees that the data is aligned to (at
+// least) `align` bytes, up to JL_CACHE_BYTE_ALIGNMENT. Arrays of plain bits
+// types are left uninitialized as usual, so this gives numeric kernels a
+// cache-line-aligned, uninitialized buffer regardless of the array size.
+JL_DLLEXPORT jl_array_t *jl_alloc_array_1d_align(jl_value_t *atype, size_t nr, size_t align)
+{
+    if (align == 0 || (align & (align - 1)) || align > JL_CACHE_BYTE_ALIGNMENT)
+        jl_exceptionf(jl_argumenterror_type, "invalid data alignment");
+    jl_value_t *eltype = jl_tparam0(atype);
+    size_t elsz = 0, al = 0;
+    if (!jl_is_kind(jl_typeof(eltype)))
+        jl_type_error_rt("Array", "element type", (jl_value_t*)jl_type_type, eltype);
+    int isunboxed = jl_islayout_inline(eltype, &elsz, &al);
+    int isunion = jl_is_uniontype(eltype);
+    int hasptr = isunboxed && (jl_is_datatype(eltype) && ((jl_datatype_t*)eltype)->layout->npointers > 0);
+    if (!isunboxed) {
+        elsz = sizeof(void*);
+        al = elsz;
+    }
+    else {
+        elsz = LLT_ALIGN(elsz, al);
+    }
+    int zi = !isunboxed || hasptr || isunion || (jl_is_datatype(eltype) && ((jl_datatype_t*)eltype)->zeroinit);
+
+    return _new_array_(atype, 1, &nr, isunboxed, hasptr, isunion, zi, elsz, align);
+}
+
 JL_DLLEXPORT jl_array_t *jl_alloc_array_2d(jl_value_t *atype, size_t nr,
                                            size_t nc)
 {
@@ -498,7 +613,9 @@ JL_DLLEXPORT jl_value_t *jl_alloc_string(size_t len)
     const size_t allocsz = sz + sizeof(jl_taggedvalue_t);
     if (sz <= GC_MAX_SZCLASS) {
         int pool_id = jl_gc_szclass_align8(allocsz);
-        jl_gc_pool_t *p = &ptls->heap.norm_pools[pool_id];
+        // strings go to the dedicated string pools so that they fill
+        // string-only pages (see gc_pool_from_n in gc.h)
+        jl_gc_pool_t *p = &ptls->heap.string_pools[pool_id];
         int osize = jl_gc_sizeclasses[pool_id];
         // We call `jl_gc_pool_alloc_noinline` instead of `jl_gc_pool_alloc` to avoid double-counting in
         // the Allocations Profiler. (See https://github.com/JuliaLang/julia/pull/43868 for more details.)
@@ -529,6 +646,132 @@ JL_DLLEXPORT jl_value_t *jl_cstr_to_string(const char *str)
     return jl_pchar_to_string(str, strlen(str));
 }
 
+// --- opt-in string interning ---
+
+// Open-addressed table of weakly held interned strings. Entries are raw
+// (unrooted) pointers: the GC sweeps the table alongside the weak refs
+// (sweep_intern_tab in gc.c), tombstoning entries whose string has died, so
+// interning never keeps a string alive by itself. All critical sections are
+// allocation-free and guarded by a no-safepoint lock, so the sweep (which
+// runs with the world stopped) can never observe a probe in progress.
+
+jl_interned_str_t *jl_intern_tab = NULL;
+size_t jl_intern_tab_sz = 0;      // allocated slots (power of two)
+size_t jl_intern_tab_count = 0;   // occupied slots (live + tombstones)
+static jl_mutex_t intern_lock;
+
+static void intern_insert_slot(jl_value_t *s, uint64_t h) JL_NOTSAFEPOINT
+{
+    size_t mask = jl_intern_tab_sz - 1;
+    size_t i = h & mask;
+    while (1) {
+        jl_value_t *v = jl_intern_tab[i].str;
+        if (v == NULL || v == JL_INTERN_DELETED) {
+            if (v == NULL)
+                jl_intern_tab_count++;
+            jl_intern_tab[i].str = s;
+            jl_intern_tab[i].hash = h;
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static void intern_rehash(size_t newsz) JL_NOTSAFEPOINT
+{
+    jl_interned_str_t *old = jl_intern_tab;
+    size_t oldsz = jl_intern_tab_sz;
+    jl_intern_tab = (jl_interned_str_t*)malloc_s(newsz * sizeof(jl_interned_str_t));
+    memset(jl_intern_tab, 0, newsz * sizeof(jl_interned_str_t));
+    jl_intern_tab_sz = newsz;
+    jl_intern_tab_count = 0;
+    for (size_t i = 0; i < oldsz; i++) {
+        if (old[i].str != NULL && old[i].str != JL_INTERN_DELETED)
+            intern_insert_slot(old[i].str, old[i].hash);
+    }
+    free(old);
+}
+
+static jl_value_t *intern_lookup(const char *str, size_t len, uint64_t h) JL_NOTSAFEPOINT
+{
+    if (jl_intern_tab_sz == 0)
+        return NULL;
+    size_t mask = jl_intern_tab_sz - 1;
+    size_t i = h & mask;
+    while (1) {
+        jl_value_t *v = jl_intern_tab[i].str;
+        if (v == NULL)
+            return NULL;
+        if (v != JL_INTERN_DELETED && jl_intern_tab[i].hash == h &&
+            jl_string_len(v) == len && memcmp(jl_string_data(v), str, len) == 0)
+            return v;
+        i = (i + 1) & mask;
+    }
+}
+
+static void intern_insert(jl_value_t *s, uint64_t h) JL_NOTSAFEPOINT
+{
+    if (jl_intern_tab_sz == 0) {
+        intern_rehash(1024);
+    }
+    else if (jl_intern_tab_count >= jl_intern_tab_sz - jl_intern_tab_sz / 4) {
+        // rebuild to purge tombstones; grow only if the table is mostly live
+        size_t live = 0;
+        for (size_t i = 0; i < jl_intern_tab_sz; i++)
+            live += (jl_intern_tab[i].str != NULL && jl_intern_tab[i].str != JL_INTERN_DELETED);
+        size_t newsz = jl_intern_tab_sz;
+        while (live + 1 > newsz / 2)
+            newsz *= 2;
+        intern_rehash(newsz);
+    }
+    intern_insert_slot(s, h);
+}
+
+// Return the canonical copy of the `len` bytes at `str`, interning them on
+// first sight. Distinct callers receive the identical String object as long
+// as any copy of it remains alive, which deduplicates workloads that
+// allocate the same small strings over and over.
+JL_DLLEXPORT jl_value_t *jl_intern_pchar(const char *str, size_t len)
+{
+    if (len == 0)
+        return jl_an_empty_string;
+    uint64_t h = memhash(str, len);
+    JL_LOCK_NOGC(&intern_lock);
+    jl_value_t *v = intern_lookup(str, len, h);
+    JL_UNLOCK_NOGC(&intern_lock);
+    if (v != NULL)
+        return v;
+    jl_value_t *s = jl_pchar_to_string(str, len);
+    JL_LOCK_NOGC(&intern_lock);
+    // another thread may have interned the same contents meanwhile
+    v = intern_lookup(jl_string_data(s), len, h);
+    if (v == NULL) {
+        intern_insert(s, h);
+        v = s;
+    }
+    JL_UNLOCK_NOGC(&intern_lock);
+    return v;
+}
+
+// like jl_intern_pchar, but can adopt `s` itself as the canonical copy,
+// avoiding the allocation when interning an existing String
+JL_DLLEXPORT jl_value_t *jl_intern_string(jl_value_t *s)
+{
+    JL_TYPECHK(intern, string, s);
+    size_t len = jl_string_len(s);
+    if (len == 0)
+        return jl_an_empty_string;
+    uint64_t h = memhash(jl_string_data(s), len);
+    JL_LOCK_NOGC(&intern_lock);
+    jl_value_t *v = intern_lookup(jl_string_data(s), len, h);
+    if (v == NULL) {
+        intern_insert(s, h);
+        v = s;
+    }
+    JL_UNLOCK_NOGC(&intern_lock);
+    return v;
+}
+
 JL_DLLEXPORT jl_array_t *jl_alloc_vec_any(size_t n)
 {
     return jl_alloc_array_1d(jl_array_any_type, n);
@@ -650,6 +893,10 @@ static int NOINLINE array_resize_buffer(jl_array_t *a, size_t newlen)
 {
     jl_task_t *ct = jl_current_task;
     assert(!a->flags.isshared || a->flags.how == 3);
+    // a pinned array's buffer may be in flight in a foreign async operation
+    // (see jl_gc_pin_object); every `how` flavor below can move the data
+    if (__unlikely(jl_gc_is_pinned((jl_value_t*)a)))
+        jl_error("cannot resize array: buffer is pinned for foreign use");
     size_t elsz = a->elsize;
     size_t nbytes = newlen * elsz;
     size_t oldnbytes = a->maxsize * elsz;
@@ -669,8 +916,22 @@ static int NOINLINE array_resize_buffer(jl_array_t *a, size_t newlen)
     if (a->flags.how == 2) {
         // already malloc'd - use realloc
         char *olddata = (char*)a->data - oldoffsnb;
-        a->data = jl_gc_managed_realloc(olddata, nbytes, oldnbytes,
-                                        a->flags.isaligned, (jl_value_t*)a);
+        int willmmap = a->flags.isaligned &&
+            jl_buf_mmapped(nbytes, jl_array_ndims(a), isbitsunion);
+        if (willmmap && jl_buf_mmapped(oldnbytes, jl_array_ndims(a), isbitsunion)) {
+            a->data = jl_gc_managed_mremap(olddata, nbytes, oldnbytes, (jl_value_t*)a);
+        }
+        else if (willmmap) {
+            // growing past the mmap threshold: move into a fresh mapping so
+            // that future growth can use mremap instead of copying
+            a->data = jl_gc_managed_mmap(nbytes);
+            memcpy(a->data, olddata, oldnbytes);
+            jl_gc_free_managed_buf(olddata, oldnbytes, a->flags.isaligned);
+        }
+        else {
+            a->data = jl_gc_managed_realloc(olddata, nbytes, oldnbytes,
+                                            a->flags.isaligned, (jl_value_t*)a);
+        }
     }
     else if (a->flags.how == 3 && jl_is_string(jl_array_data_owner(a)) && !isbitsunion) {
         // if data is in a String, keep it that way
@@ -689,7 +950,10 @@ static int NOINLINE array_resize_buffer(jl_array_t *a, size_t newlen)
     else {
         newbuf = 1;
         if (nbytes >= MALLOC_THRESH) {
-            a->data = jl_gc_managed_malloc(nbytes);
+            if (jl_buf_mmapped(nbytes, jl_array_ndims(a), isbitsunion))
+                a->data = jl_gc_managed_mmap(nbytes);
+            else
+                a->data = jl_gc_managed_malloc(nbytes);
             jl_gc_track_malloced_array(ct->ptls, a);
             a->flags.how = 2;
             a->flags.isaligned = 1;
@@ -889,6 +1153,11 @@ STATIC_INLINE void jl_array_grow_at_end(jl_array_t *a, size_t idx,
         size_t newmaxsize = overallocation(a->maxsize);
         if (newmaxsize < reqmaxsize)
             newmaxsize = reqmaxsize;
+        // round the capacity up to a whole number of cache lines, so that
+        // repeatedly appending to an array keeps the buffer tail usable by
+        // vectorized fill loops without a scalar epilogue
+        if (!isbitsunion && elsz > 0 && newmaxsize <= MAXINTVAL / elsz)
+            newmaxsize = LLT_ALIGN(newmaxsize * elsz, JL_CACHE_BYTE_ALIGNMENT) / elsz;
         size_t oldmaxsize = a->maxsize;
         int newbuf = array_resize_buffer(a, newmaxsize);
         char *newdata = (char*)a->data + a->offset * elsz;
@@ -1003,6 +1272,19 @@ STATIC_INLINE void jl_array_shrink(jl_array_t *a, size_t dec)
     }
     else if (a->flags.how == 2) {
         //malloc-allocated pointer this array object manages
+        if (a->flags.isaligned &&
+            jl_buf_mmapped(oldnbytes, jl_array_ndims(a), isbitsunion)) {
+            // mmap-backed buffer: shrinking below the threshold would mean
+            // copying the data back into malloc'd memory, so only release
+            // tail pages while the buffer stays above it
+            if (!jl_buf_mmapped(newbytes, jl_array_ndims(a), isbitsunion))
+                return;
+            size_t oldoffsnb = a->offset * elsz;
+            a->data = ((char*)jl_gc_managed_mremap(originalptr, newbytes, oldnbytes,
+                    (jl_value_t*)a)) + oldoffsnb;
+            a->maxsize -= dec;
+            return;
+        }
         char *typetagdata;
         char *newtypetagdata;
         if (isbitsunion) {
@@ -1149,6 +1431,21 @@ JL_DLLEXPORT void jl_array_del_end(jl_array_t *a, size_t dec)
     if (dec == 0)
         return;
     jl_array_del_at_end(a, n - dec, dec, n);
+    // once a large malloc'd buffer is mostly empty, return the tail to the
+    // allocator instead of holding peak footprint until the array object
+    // dies; keep 2x slack so a refill doesn't immediately regrow. Capacity
+    // reserved by an explicit sizehint is never given back this way --
+    // `sizehint!(v, N); ...; empty!(v)` is the documented idiom for reusing
+    // a buffer across fill/drain cycles.
+    if (a->flags.how == 2 && a->elsize > 0 && !a->flags.hashint &&
+        a->maxsize * a->elsize >= MALLOC_THRESH &&
+        a->length < a->maxsize / 4) {
+        size_t newmax = a->offset + a->length * 2;
+        if (newmax < 16)
+            newmax = 16;
+        if (newmax < a->maxsize)
+            jl_array_shrink(a, a->maxsize - newmax);
+    }
 }
 
 JL_DLLEXPORT void jl_array_sizehint(jl_array_t *a, size_t sz)
@@ -1159,6 +1456,9 @@ JL_DLLEXPORT void jl_array_sizehint(jl_array_t *a, size_t sz)
     sz = (sz < min) ? min : sz;
 
     if (sz <= a->maxsize) {
+        // a hint at or below the current capacity releases any standing
+        // reservation, so jl_array_del_end may auto-shrink again
+        a->flags.hashint = 0;
         size_t dec = a->maxsize - sz;
         //if we don't save at least an eighth of maxsize then its not worth it to shrink
         if (dec < a->maxsize / 8) return;
@@ -1170,6 +1470,9 @@ JL_DLLEXPORT void jl_array_sizehint(jl_array_t *a, size_t sz)
 
         a->nrows = n;
         a->length = n;
+        // remember the reservation: deletions must not hand the hinted
+        // capacity back to the allocator behind the caller's back
+        a->flags.hashint = 1;
     }
 }
 
@@ -1180,8 +1483,8 @@ JL_DLLEXPORT jl_array_t *jl_array_copy(jl_array_t *ary)
     int isunion = jl_is_uniontype(jl_tparam0(jl_typeof(ary)));
     jl_array_t *new_ary = _new_array_(jl_typeof(ary), jl_array_ndims(ary),
                                       &ary->nrows, !ary->flags.ptrarray,
-                                      ary->flags.hasptr, isunion, 0, elsz);
-    memcpy(new_ary->data, ary->data, len * elsz);
+                                      ary->flags.hasptr, isunion, 0, elsz, 0);
+    jl_memmove_bulk(new_ary->data, ary->data, len * elsz);
     // ensure isbits union arrays copy their selector bytes correctly
     if (jl_array_isbitsunion(ary))
         memcpy(jl_array_typetagdata(new_ary), jl_array_typetagdata(ary), len);
@@ -1253,6 +1556,50 @@ JL_DLLEXPORT void jl_array_ptr_copy(jl_array_t *dest, void **dest_p,
     memmove_refs(dest_p, src_p, n);
 }
 
+// Fused copy for isbits-Union arrays: moves the element data and the
+// selector bytes in one call (jl_array_ptr_copy is refs-only and refuses
+// these arrays, which otherwise forces two ccalls per copy from Base).
+// Unsafe, assumes inbounds, matching eltypes and 0-based offsets.
+JL_DLLEXPORT void jl_array_bitsunion_copy(jl_array_t *dest, size_t doffs,
+                                          jl_array_t *src, size_t soffs, size_t n) JL_NOTSAFEPOINT
+{
+    assert(jl_array_isbitsunion(dest) && jl_array_isbitsunion(src));
+    size_t elsz = dest->elsize;
+    memmove((char*)dest->data + doffs * elsz, (char*)src->data + soffs * elsz, n * elsz);
+    memmove(jl_array_typetagdata(dest) + doffs, jl_array_typetagdata(src) + soffs, n);
+}
+
+// Bulk fill for isbits-Union arrays: one selector memset plus a doubling
+// element-pattern copy instead of a per-element store/select loop.
+// `offs` is 0-based; assumes offs + n is inbounds.
+JL_DLLEXPORT void jl_array_bitsunion_fill(jl_array_t *a, jl_value_t *v, size_t offs, size_t n)
+{
+    assert(jl_array_isbitsunion(a));
+    jl_value_t *eltype = jl_tparam0(jl_typeof(a));
+    if (!jl_isa(v, eltype))
+        jl_type_error("fill!", eltype, v);
+    if (n == 0)
+        return;
+    unsigned nth = 0;
+    if (!jl_find_union_component(eltype, jl_typeof(v), &nth))
+        assert(0 && "invalid fill! of isbits union");
+    memset(jl_array_typetagdata(a) + offs, nth, n);
+    if (jl_is_datatype_singleton((jl_datatype_t*)jl_typeof(v)))
+        return; // selector bytes alone identify the value
+    size_t elsz = a->elsize;
+    size_t dtsz = jl_datatype_size(jl_typeof(v));
+    char *data = (char*)a->data + offs * elsz;
+    memcpy(data, jl_data_ptr(v), dtsz);
+    if (dtsz < elsz)
+        memset(data + dtsz, 0, elsz - dtsz);
+    size_t filled = 1;
+    while (filled < n) {
+        size_t m = filled < n - filled ? filled : n - filled;
+        memcpy(data + filled * elsz, data, m * elsz);
+        filled += m;
+    }
+}
+
 JL_DLLEXPORT void jl_array_ptr_1d_push(jl_array_t *a, jl_value_t *item)
 {
     assert(jl_typeis(a, jl_array_any_type));
@@ -13,6 +13,7 @@
 #include "julia.h"
 #include "julia_internal.h"
 #include "flisp.h"
+#include "serialize.h"
 #include "julia_assert.h"
 
 #ifdef __cplusplus
@@ -239,6 +240,7 @@ static void jl_init_ast_ctx(jl_ast_context_t *ctx) JL_NOTSAFEPOINT
 
 // There should be no GC allocation while holding this lock
 static uv_mutex_t flisp_lock;
+static uv_mutex_t lowering_cache_lock; // guards jl_lowering_cache (see jl_lower_cached)
 static jl_ast_context_t *jl_ast_ctx_freed = NULL;
 
 static jl_ast_context_t *jl_ast_ctx_enter(jl_module_t *m) JL_GLOBALLY_ROOTED JL_NOTSAFEPOINT
@@ -275,6 +277,7 @@ void jl_init_flisp(void)
     if (jl_ast_ctx_freed)
         return;
     uv_mutex_init(&flisp_lock);
+    uv_mutex_init(&lowering_cache_lock);
     jl_init_ast_ctx(&jl_ast_main_ctx);
     // To match the one in jl_ast_ctx_leave
     JL_SIGATOMIC_BEGIN();
@@ -801,6 +804,7 @@ JL_DLLEXPORT jl_value_t *jl_fl_parse(const char *text, size_t text_len,
 
     jl_ast_context_t *ctx = jl_ast_ctx_enter(NULL);
     fl_context_t *fl_ctx = &ctx->fl;
+    fl_parse_arena_begin(fl_ctx);
     value_t fl_text = cvalue_static_cstrn(fl_ctx, text, text_len);
     fl_gc_handle(fl_ctx, &fl_text);
     value_t fl_filename = cvalue_static_cstrn(fl_ctx, jl_string_data(filename),
@@ -828,6 +832,7 @@ JL_DLLEXPORT jl_value_t *jl_fl_parse(const char *text, size_t text_len,
     JL_GC_PUSH2(&expr, &end_offset);
     expr = fl_expr == fl_ctx->FL_EOF ? jl_nothing : scm_to_julia(fl_ctx, fl_expr, NULL);
     end_offset = jl_box_long(offset1);
+    fl_parse_arena_end(fl_ctx); // nothing escapes flisp past this point; compact the parse output
     jl_ast_ctx_leave(ctx);
     jl_value_t *result = (jl_value_t*)jl_svec2(expr, end_offset);
     JL_GC_POP();
@@ -1174,6 +1179,112 @@ JL_DLLEXPORT jl_value_t *jl_expand_with_loc(jl_value_t *expr, jl_module_t *inmod
     return jl_expand_in_world(expr, inmodule, file, line, ~(size_t)0);
 }
 
+// --- lowering memo ---
+
+// Macro-heavy code lowers structurally identical trees over and over
+// (generated functions emitting near-identical bodies). Once macros are
+// expanded, lowering is a pure function of the tree, the module, and the
+// source location, so memoize it in a small direct-mapped table. Entries
+// hold private copies of both key and result (callers mutate these trees
+// freely), and a hit hands back a fresh copy, which also keeps reuse
+// hygiene-safe: lowering-introduced names only need to be unique within
+// their own thunk, so replaying the cached names for identical source is
+// indistinguishable from re-running the lowerer.
+#define LOWERING_CACHE_SIZE 256
+#define LOWERING_CACHE_STRIDE 5 // slots per entry: expr, module, file, line, result
+jl_array_t *jl_lowering_cache JL_GLOBALLY_ROOTED = NULL; // marked as a root in gc.c
+
+static uintptr_t expr_tree_hash(jl_value_t *v) JL_NOTSAFEPOINT
+{
+    if (jl_is_symbol(v))
+        return ((jl_sym_t*)v)->hash;
+    if (jl_is_expr(v)) {
+        jl_expr_t *e = (jl_expr_t*)v;
+        uintptr_t h = bitmix(((jl_sym_t*)e->head)->hash, jl_expr_nargs(e));
+        size_t i, l = jl_expr_nargs(e);
+        for (i = 0; i < l; i++)
+            h = bitmix(h, expr_tree_hash(jl_exprarg(e, i)));
+        return h;
+    }
+    // identity hash for mutable values, content hash for immutable ones;
+    // both are sound since a mutable literal is embedded by reference in
+    // the lowered code either way
+    return jl_object_id(v);
+}
+
+static int expr_tree_equal(jl_value_t *a, jl_value_t *b) JL_NOTSAFEPOINT
+{
+    if (a == b)
+        return 1;
+    if (jl_is_expr(a)) {
+        if (!jl_is_expr(b))
+            return 0;
+        jl_expr_t *ea = (jl_expr_t*)a, *eb = (jl_expr_t*)b;
+        size_t i, l = jl_expr_nargs(ea);
+        if (ea->head != eb->head || l != jl_expr_nargs(eb))
+            return 0;
+        for (i = 0; i < l; i++)
+            if (!expr_tree_equal(jl_exprarg(ea, i), jl_exprarg(eb, i)))
+                return 0;
+        return 1;
+    }
+    return jl_egal(a, b);
+}
+
+static jl_value_t *jl_lower_cached(jl_value_t *expr, jl_module_t *inmodule,
+                                   const char *file, int line)
+{
+    if (!jl_is_expr(expr))
+        return jl_call_scm_on_ast_and_loc("jl-expand-to-thunk", expr, inmodule, file, line);
+    jl_value_t *filesym = (jl_value_t*)jl_symbol(file);
+    uintptr_t h = bitmix(bitmix(expr_tree_hash(expr), (uintptr_t)filesym), (uintptr_t)line);
+    size_t idx = (h % LOWERING_CACHE_SIZE) * LOWERING_CACHE_STRIDE;
+    jl_value_t *result = NULL, *keycopy = NULL, *rescopy = NULL, *linebox = NULL;
+    JL_GC_PUSH5(&expr, &result, &keycopy, &rescopy, &linebox);
+    uv_mutex_lock(&lowering_cache_lock);
+    jl_array_t *cache = jl_lowering_cache;
+    if (cache != NULL) {
+        jl_value_t *k = jl_array_ptr_ref(cache, idx);
+        if (k != NULL &&
+            jl_array_ptr_ref(cache, idx + 1) == (jl_value_t*)inmodule &&
+            jl_array_ptr_ref(cache, idx + 2) == filesym &&
+            jl_unbox_long(jl_array_ptr_ref(cache, idx + 3)) == (long)line &&
+            expr_tree_equal(k, expr)) {
+            result = jl_array_ptr_ref(cache, idx + 4);
+        }
+    }
+    uv_mutex_unlock(&lowering_cache_lock);
+    if (result != NULL) {
+        result = jl_copy_ast(result);
+        JL_GC_POP();
+        return result;
+    }
+    result = jl_call_scm_on_ast_and_loc("jl-expand-to-thunk", expr, inmodule, file, line);
+    // store private copies of both trees: the caller mutates the result we
+    // hand back, and macro expansion may have spliced in subtrees aliased
+    // elsewhere, so the key must be immune to later mutation too
+    keycopy = jl_copy_ast(expr);
+    rescopy = jl_copy_ast(result);
+    linebox = jl_box_long(line);
+    if (jl_lowering_cache == NULL) {
+        jl_array_t *newcache = jl_alloc_vec_any(LOWERING_CACHE_SIZE * LOWERING_CACHE_STRIDE);
+        uv_mutex_lock(&lowering_cache_lock);
+        if (jl_lowering_cache == NULL)
+            jl_lowering_cache = newcache;
+        uv_mutex_unlock(&lowering_cache_lock);
+    }
+    uv_mutex_lock(&lowering_cache_lock);
+    cache = jl_lowering_cache;
+    jl_array_ptr_set(cache, idx, keycopy);
+    jl_array_ptr_set(cache, idx + 1, (jl_value_t*)inmodule);
+    jl_array_ptr_set(cache, idx + 2, filesym);
+    jl_array_ptr_set(cache, idx + 3, linebox);
+    jl_array_ptr_set(cache, idx + 4, rescopy);
+    uv_mutex_unlock(&lowering_cache_lock);
+    JL_GC_POP();
+    return result;
+}
+
 // Lowering, with starting program location and worldage specified
 JL_DLLEXPORT jl_value_t *jl_expand_in_world(jl_value_t *expr, jl_module_t *inmodule,
                                             const char *file, int line, size_t world)
@@ -1182,7 +1293,7 @@ JL_DLLEXPORT jl_value_t *jl_expand_in_world(jl_value_t *expr, jl_module_t *inmod
     JL_GC_PUSH1(&expr);
     expr = jl_copy_ast(expr);
     expr = jl_expand_macros(expr, inmodule, NULL, 0, world, 1);
-    expr = jl_call_scm_on_ast_and_loc("jl-expand-to-thunk", expr, inmodule, file, line);
+    expr = jl_lower_cached(expr, inmodule, file, line);
     JL_GC_POP();
     return expr;
 }
@@ -1328,6 +1439,276 @@ JL_DLLEXPORT jl_value_t *jl_parse_input_line(const char *text, size_t text_len,
     return jl_parse_all(text, text_len, filename, filename_len, 1);
 }
 
+//------------------------------------------------------------------------------
+// On-disk cache of parsed top-level ASTs, keyed by file content hash
+//
+// When $JULIA_PARSE_CACHE names a directory, `jl_parse_all_cached` looks the
+// content hash up there before invoking the parser and stores the parse tree
+// after a miss, so repeated include()s of unchanged files are parse-free.
+// Only the closed set of values the parser emits is serialized; if anything
+// else shows up (e.g. a replacement `Core._parse` producing foreign objects)
+// the entry is simply not written and the file parses as usual.
+
+#define AST_CACHE_MAGIC   0x74734135u // "5Ast"
+#define AST_CACHE_FORMAT  1
+
+#define AST_C_EXPR       1
+#define AST_C_SYMBOL     2
+#define AST_C_STRING     3
+#define AST_C_LINENODE   4
+#define AST_C_QUOTENODE  5
+#define AST_C_NOTHING    6
+#define AST_C_TRUE       7
+#define AST_C_FALSE      8
+#define AST_C_CHAR       9
+#define AST_C_INT8      10
+#define AST_C_INT16     11
+#define AST_C_INT32     12
+#define AST_C_INT64     13
+#define AST_C_UINT8     14
+#define AST_C_UINT16    15
+#define AST_C_UINT32    16
+#define AST_C_UINT64    17
+#define AST_C_FLOAT32   18
+#define AST_C_FLOAT64   19
+
+static int ast_cache_write_value(ios_t *s, jl_value_t *v)
+{
+    if (v == jl_nothing) {
+        write_uint8(s, AST_C_NOTHING);
+        return 1;
+    }
+    if (v == jl_true || v == jl_false) {
+        write_uint8(s, v == jl_true ? AST_C_TRUE : AST_C_FALSE);
+        return 1;
+    }
+    if (jl_is_symbol(v)) {
+        const char *name = jl_symbol_name((jl_sym_t*)v);
+        size_t len = strlen(name);
+        write_uint8(s, AST_C_SYMBOL);
+        write_uint32(s, len);
+        ios_write(s, name, len);
+        return 1;
+    }
+    if (jl_is_string(v)) {
+        write_uint8(s, AST_C_STRING);
+        write_uint32(s, jl_string_len(v));
+        ios_write(s, jl_string_data(v), jl_string_len(v));
+        return 1;
+    }
+    if (jl_is_expr(v)) {
+        jl_expr_t *e = (jl_expr_t*)v;
+        size_t nargs = jl_expr_nargs(e);
+        write_uint8(s, AST_C_EXPR);
+        if (!ast_cache_write_value(s, (jl_value_t*)e->head))
+            return 0;
+        write_uint32(s, nargs);
+        for (size_t i = 0; i < nargs; i++) {
+            if (!ast_cache_write_value(s, jl_exprarg(e, i)))
+                return 0;
+        }
+        return 1;
+    }
+    if (jl_typeis(v, jl_linenumbernode_type)) {
+        write_uint8(s, AST_C_LINENODE);
+        return ast_cache_write_value(s, jl_fieldref(v, 0)) &&
+               ast_cache_write_value(s, jl_fieldref_noalloc(v, 1));
+    }
+    if (jl_typeis(v, jl_quotenode_type)) {
+        write_uint8(s, AST_C_QUOTENODE);
+        return ast_cache_write_value(s, jl_fieldref_noalloc(v, 0));
+    }
+    if (jl_typeis(v, jl_char_type)) {
+        write_uint8(s, AST_C_CHAR);
+        write_uint32(s, *(uint32_t*)v);
+        return 1;
+    }
+    if (jl_typeis(v, jl_int8_type) || jl_typeis(v, jl_uint8_type)) {
+        write_uint8(s, jl_typeis(v, jl_int8_type) ? AST_C_INT8 : AST_C_UINT8);
+        write_uint8(s, *(uint8_t*)v);
+        return 1;
+    }
+    if (jl_typeis(v, jl_int16_type) || jl_typeis(v, jl_uint16_type)) {
+        write_uint8(s, jl_typeis(v, jl_int16_type) ? AST_C_INT16 : AST_C_UINT16);
+        write_uint16(s, *(uint16_t*)v);
+        return 1;
+    }
+    if (jl_typeis(v, jl_int32_type) || jl_typeis(v, jl_uint32_type) ||
+        jl_typeis(v, jl_float32_type)) {
+        write_uint8(s, jl_typeis(v, jl_int32_type) ? AST_C_INT32 :
+                       jl_typeis(v, jl_uint32_type) ? AST_C_UINT32 : AST_C_FLOAT32);
+        write_uint32(s, *(uint32_t*)v);
+        return 1;
+    }
+    if (jl_typeis(v, jl_int64_type) || jl_typeis(v, jl_uint64_type) ||
+        jl_typeis(v, jl_float64_type)) {
+        write_uint8(s, jl_typeis(v, jl_int64_type) ? AST_C_INT64 :
+                       jl_typeis(v, jl_uint64_type) ? AST_C_UINT64 : AST_C_FLOAT64);
+        write_int64(s, *(int64_t*)v);
+        return 1;
+    }
+    return 0; // not something the parser emits; give up on this entry
+}
+
+// returns NULL (without throwing) on malformed or truncated input
+static jl_value_t *ast_cache_read_value(ios_t *s)
+{
+    switch (read_uint8(s)) {
+    case AST_C_NOTHING: return jl_nothing;
+    case AST_C_TRUE:    return jl_true;
+    case AST_C_FALSE:   return jl_false;
+    case AST_C_SYMBOL: {
+        uint32_t len = read_uint32(s);
+        char buf[512];
+        if (len > sizeof(buf) || ios_read(s, buf, len) != len)
+            return NULL;
+        return (jl_value_t*)jl_symbol_n(buf, len);
+    }
+    case AST_C_STRING: {
+        uint32_t len = read_uint32(s);
+        if (len > (uint32_t)(1 << 30))
+            return NULL;
+        jl_value_t *str = jl_alloc_string(len);
+        JL_GC_PUSH1(&str);
+        int ok = ios_read(s, jl_string_data(str), len) == len;
+        JL_GC_POP();
+        return ok ? str : NULL;
+    }
+    case AST_C_EXPR: {
+        jl_value_t *head = ast_cache_read_value(s);
+        if (head == NULL || !jl_is_symbol(head))
+            return NULL;
+        uint32_t nargs = read_uint32(s);
+        if (nargs > (uint32_t)(1 << 26))
+            return NULL;
+        jl_expr_t *e = jl_exprn((jl_sym_t*)head, nargs);
+        JL_GC_PUSH1(&e);
+        for (uint32_t i = 0; i < nargs; i++) {
+            jl_value_t *arg = ast_cache_read_value(s);
+            if (arg == NULL) {
+                JL_GC_POP();
+                return NULL;
+            }
+            jl_exprargset(e, i, arg);
+        }
+        JL_GC_POP();
+        return (jl_value_t*)e;
+    }
+    case AST_C_LINENODE: {
+        jl_value_t *line = ast_cache_read_value(s);
+        if (line == NULL || !jl_is_long(line))
+            return NULL;
+        JL_GC_PUSH1(&line);
+        jl_value_t *file = ast_cache_read_value(s);
+        jl_value_t *node = NULL;
+        if (file != NULL && (jl_is_symbol(file) || file == jl_nothing))
+            node = jl_new_struct(jl_linenumbernode_type, line, file);
+        JL_GC_POP();
+        return node;
+    }
+    case AST_C_QUOTENODE: {
+        jl_value_t *val = ast_cache_read_value(s);
+        if (val == NULL)
+            return NULL;
+        JL_GC_PUSH1(&val);
+        jl_value_t *node = jl_new_struct(jl_quotenode_type, val);
+        JL_GC_POP();
+        return node;
+    }
+    case AST_C_CHAR:    return jl_box_char(read_uint32(s));
+    case AST_C_INT8:    return jl_box_int8(read_uint8(s));
+    case AST_C_UINT8:   return jl_box_uint8(read_uint8(s));
+    case AST_C_INT16:   return jl_box_int16(read_uint16(s));
+    case AST_C_UINT16:  return jl_box_uint16(read_uint16(s));
+    case AST_C_INT32:   return jl_box_int32(read_uint32(s));
+    case AST_C_UINT32:  return jl_box_uint32(read_uint32(s));
+    case AST_C_FLOAT32: {
+        uint32_t bits = read_uint32(s);
+        float x;
+        memcpy(&x, &bits, sizeof(x));
+        return jl_box_float32(x);
+    }
+    case AST_C_INT64:   return jl_box_int64(read_uint64(s));
+    case AST_C_UINT64:  return jl_box_uint64(read_uint64(s));
+    case AST_C_FLOAT64: {
+        uint64_t bits = read_uint64(s);
+        double x;
+        memcpy(&x, &bits, sizeof(x));
+        return jl_box_float64(x);
+    }
+    }
+    return NULL;
+}
+
+static jl_value_t *ast_cache_load(const char *path, uint64_t h, size_t textlen)
+{
+    ios_t f;
+    if (ios_file(&f, path, 1, 0, 0, 0) == NULL)
+        return NULL;
+    jl_value_t *ast = NULL;
+    if (read_uint32(&f) == AST_CACHE_MAGIC && read_uint8(&f) == AST_CACHE_FORMAT &&
+        read_uint64(&f) == h && read_uint64(&f) == (uint64_t)textlen)
+        ast = ast_cache_read_value(&f);
+    ios_close(&f);
+    if (ast != NULL && (!jl_is_expr(ast) || ((jl_expr_t*)ast)->head != jl_toplevel_sym))
+        ast = NULL;
+    return ast;
+}
+
+static void ast_cache_store(const char *path, uint64_t h, size_t textlen, jl_value_t *ast)
+{
+    // write to a pid-suffixed temp file, then move it into place, so
+    // concurrent julia processes never observe a partial entry
+    size_t tmplen = strlen(path) + 8;
+    char *tmp = (char*)malloc_s(tmplen);
+    snprintf(tmp, tmplen, "%s.XXXXXX", path);
+    ios_t f;
+    if (ios_mkstemp(&f, tmp) == NULL) {
+        free(tmp);
+        return; // unwritable cache directory; not an error
+    }
+    write_uint32(&f, AST_CACHE_MAGIC);
+    write_uint8(&f, AST_CACHE_FORMAT);
+    write_uint64(&f, h);
+    write_uint64(&f, (uint64_t)textlen);
+    int ok = ast_cache_write_value(&f, ast);
+    ios_close(&f);
+    if (!ok || rename(tmp, path) != 0)
+        remove(tmp);
+    free(tmp);
+}
+
+// Parse `text` as an entire file like `jl_parse_all`, consulting the on-disk
+// parse cache first when $JULIA_PARSE_CACHE is set.
+JL_DLLEXPORT jl_value_t *jl_parse_all_cached(jl_value_t *text, jl_value_t *filename)
+{
+    JL_TYPECHK(parse, string, text);
+    JL_TYPECHK(parse, string, filename);
+    const char *dir = getenv(PARSE_CACHE_NAME);
+    if (dir == NULL || dir[0] == '\0')
+        return jl_svecref(jl_parse(jl_string_data(text), jl_string_len(text),
+                                   filename, 1, 0, (jl_value_t*)jl_all_sym), 0);
+    // seed with the runtime version so entries do not survive an upgrade
+    const char *ver = jl_ver_string();
+    uint64_t h = memhash_seed(jl_string_data(text), jl_string_len(text),
+                              memhash32(ver, strlen(ver)));
+    size_t pathlen = strlen(dir) + 64;
+    char *path = (char*)malloc_s(pathlen);
+    snprintf(path, pathlen, "%s/jlparse_%08x%08x_%zu.ast", dir,
+             (unsigned)(h >> 32), (unsigned)h, jl_string_len(text));
+    jl_value_t *ast = ast_cache_load(path, h, jl_string_len(text));
+    if (ast == NULL) {
+        ast = jl_svecref(jl_parse(jl_string_data(text), jl_string_len(text),
+                                  filename, 1, 0, (jl_value_t*)jl_all_sym), 0);
+        JL_GC_PUSH1(&ast);
+        if (jl_is_expr(ast) && ((jl_expr_t*)ast)->head == jl_toplevel_sym)
+            ast_cache_store(path, h, jl_string_len(text), ast);
+        JL_GC_POP();
+    }
+    free(path);
+    return ast;
+}
+
 #ifdef __cplusplus
 }
 #endif
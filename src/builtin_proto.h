@@ -60,10 +60,13 @@ DECLARE_BUILTIN(setglobal);
 DECLARE_BUILTIN(finalizer);
 
 JL_CALLABLE(jl_f_invoke_kwsorter);
+JL_CALLABLE(jl_f_kwfunc);
 #ifdef DEFINE_BUILTIN_GLOBALS
 JL_DLLEXPORT jl_fptr_args_t jl_f_invoke_kwsorter_addr = &jl_f_invoke_kwsorter;
+JL_DLLEXPORT jl_fptr_args_t jl_f_kwfunc_addr = &jl_f_kwfunc;
 #else
 JL_DLLEXPORT extern jl_fptr_args_t jl_f_invoke_kwsorter_addr;
+JL_DLLEXPORT extern jl_fptr_args_t jl_f_kwfunc_addr;
 #endif
 JL_CALLABLE(jl_f__structtype);
 JL_CALLABLE(jl_f__abstracttype);
@@ -20,6 +20,9 @@
 #include <unistd.h>
 #endif
 #include <ctype.h>
+#ifdef _CPU_X86_64_
+#include <emmintrin.h>
+#endif
 #include "julia.h"
 #include "julia_internal.h"
 #include "builtin_proto.h"
@@ -81,51 +84,91 @@ static int NOINLINE compare_fields(const jl_value_t *a, const jl_value_t *b, jl_
     size_t nf = jl_datatype_nfields(dt);
     // npointers is used at end, but fetched here for locality with nfields.
     int npointers = ((jl_datatype_t*)dt)->layout->npointers;
-    for (size_t f = 0; f < nf; f++) {
-        size_t offs = jl_field_offset(dt, f);
-        char *ao = (char*)a + offs;
-        char *bo = (char*)b + offs;
-        if (jl_field_isptr(dt, f)) {
-            // Save ptr recursion until the end -- only recurse if otherwise equal
-            // Note that we also skip comparing the pointers for null here, because
-            // null fields are rare so it can save CPU to delay this read too.
-            continue;
-        }
-        else {
-            jl_datatype_t *ft = (jl_datatype_t*)jl_field_type_concrete(dt, f);
-            if (jl_is_uniontype(ft)) {
-                size_t idx = jl_field_size(dt, f) - 1;
-                uint8_t asel = ((uint8_t*)ao)[idx];
-                uint8_t bsel = ((uint8_t*)bo)[idx];
-                if (asel != bsel)
-                    return 0;
-                ft = (jl_datatype_t*)jl_nth_union_component((jl_value_t*)ft, asel);
-            }
-            else if (ft->layout->first_ptr >= 0) {
-                // If the field is a inline immutable that can be undef
-                // we need to check for undef first since undef struct
-                // may have fields that are different but should still be treated as equal.
-                int32_t idx = ft->layout->first_ptr;
-                jl_value_t *ptra = ((jl_value_t**)ao)[idx];
-                jl_value_t *ptrb = ((jl_value_t**)bo)[idx];
-                if ((ptra == NULL) != (ptrb == NULL)) {
-                    return 0;
-                }
-                else if (ptra == NULL) { // implies ptrb == NULL
-                    continue; // skip this field (it is #undef)
-                }
-            }
-            if (!ft->layout->haspadding) {
-                if (!bits_equal(ao, bo, ft->size))
-                    return 0;
-            }
-            else {
-                assert(jl_datatype_nfields(ft) > 0);
-                if (!compare_fields((jl_value_t*)ao, (jl_value_t*)bo, ft))
-                    return 0;
-            }
-        }
+    // As in immut_id_, dispatch on the fielddesc width once up front instead
+    // of switching on it inside jl_field_offset/jl_field_size/jl_field_isptr
+    // for every field.  Padding-free non-pointer fields that are adjacent in
+    // memory are additionally compared with a single bits_equal over the
+    // combined span: a field without padding cannot contain a non-pointer-egal
+    // pointer (jl_compute_field_offsets sets haspadding for those), so bytewise
+    // equality of the span is exactly fieldwise egal.
+    const jl_datatype_layout_t *layout = dt->layout;
+    jl_value_t **types = jl_svec_data(dt->types);
+#define COMPARE_FIELDS_LOOP(fielddesc_t)                                       \
+    do {                                                                       \
+        const fielddesc_t *desc = (const fielddesc_t*)jl_dt_layout_fields(layout); \
+        for (size_t f = 0; f < nf; f++) {                                      \
+            size_t offs = desc[f].offset;                                      \
+            char *ao = (char*)a + offs;                                        \
+            char *bo = (char*)b + offs;                                        \
+            if (desc[f].isptr) {                                               \
+                /* Save ptr recursion until the end -- only recurse if         \
+                   otherwise equal.  Note that we also skip comparing the      \
+                   pointers for null here, because null fields are rare so     \
+                   it can save CPU to delay this read too. */                  \
+                continue;                                                      \
+            }                                                                  \
+            jl_datatype_t *ft = (jl_datatype_t*)types[f];                      \
+            if (jl_is_uniontype(ft)) {                                         \
+                size_t idx = desc[f].size - 1;                                 \
+                uint8_t asel = ((uint8_t*)ao)[idx];                            \
+                uint8_t bsel = ((uint8_t*)bo)[idx];                            \
+                if (asel != bsel)                                              \
+                    return 0;                                                  \
+                ft = (jl_datatype_t*)jl_nth_union_component((jl_value_t*)ft, asel); \
+            }                                                                  \
+            else if (ft->layout->first_ptr >= 0) {                             \
+                /* If the field is a inline immutable that can be undef        \
+                   we need to check for undef first since undef struct         \
+                   may have fields that are different but should still be      \
+                   treated as equal. */                                        \
+                int32_t idx = ft->layout->first_ptr;                           \
+                jl_value_t *ptra = ((jl_value_t**)ao)[idx];                    \
+                jl_value_t *ptrb = ((jl_value_t**)bo)[idx];                    \
+                if ((ptra == NULL) != (ptrb == NULL)) {                        \
+                    return 0;                                                  \
+                }                                                              \
+                else if (ptra == NULL) { /* implies ptrb == NULL */            \
+                    continue; /* skip this field (it is #undef) */             \
+                }                                                              \
+            }                                                                  \
+            else if (!ft->layout->haspadding) {                                \
+                /* extend the compare over any directly following fields of    \
+                   the same shape so they share one memcmp */                  \
+                size_t end = offs + desc[f].size;                              \
+                while (f + 1 < nf && !desc[f + 1].isptr && desc[f + 1].offset == end) { \
+                    jl_datatype_t *nft = (jl_datatype_t*)types[f + 1];         \
+                    if (jl_is_uniontype(nft) || nft->layout->first_ptr >= 0 || \
+                        nft->layout->haspadding)                               \
+                        break;                                                 \
+                    end += desc[f + 1].size;                                   \
+                    f++;                                                       \
+                }                                                              \
+                if (!bits_equal(ao, bo, end - offs))                           \
+                    return 0;                                                  \
+                continue;                                                      \
+            }                                                                  \
+            if (!ft->layout->haspadding) {                                     \
+                if (!bits_equal(ao, bo, ft->size))                             \
+                    return 0;                                                  \
+            }                                                                  \
+            else {                                                             \
+                assert(jl_datatype_nfields(ft) > 0);                           \
+                if (!compare_fields((jl_value_t*)ao, (jl_value_t*)bo, ft))     \
+                    return 0;                                                  \
+            }                                                                  \
+        }                                                                      \
+    } while (0)
+    if (layout->fielddesc_type == 0) {
+        COMPARE_FIELDS_LOOP(jl_fielddesc8_t);
+    }
+    else if (layout->fielddesc_type == 1) {
+        COMPARE_FIELDS_LOOP(jl_fielddesc16_t);
     }
+    else {
+        assert(layout->fielddesc_type == 2);
+        COMPARE_FIELDS_LOOP(jl_fielddesc32_t);
+    }
+#undef COMPARE_FIELDS_LOOP
     // If we've gotten here, the objects are bitwise equal, besides their pointer fields.
     // Now, we will recurse into jl_egal for the pointed-to elements, which might be
     // arbitrarily expensive.
@@ -367,34 +410,54 @@ static uintptr_t immut_id_(jl_datatype_t *dt, jl_value_t *v, uintptr_t h) JL_NOT
     }
     if (dt == jl_unionall_type)
         return type_object_id_(v, NULL);
-    for (f = 0; f < nf; f++) {
-        size_t offs = jl_field_offset(dt, f);
-        char *vo = (char*)v + offs;
-        uintptr_t u;
-        if (jl_field_isptr(dt, f)) {
-            jl_value_t *f = *(jl_value_t**)vo;
-            u = (f == NULL) ? 0 : jl_object_id(f);
-        }
-        else {
-            jl_datatype_t *fieldtype = (jl_datatype_t*)jl_field_type_concrete(dt, f);
-            if (jl_is_uniontype(fieldtype)) {
-                uint8_t sel = ((uint8_t*)vo)[jl_field_size(dt, f) - 1];
-                fieldtype = (jl_datatype_t*)jl_nth_union_component((jl_value_t*)fieldtype, sel);
-            }
-            assert(jl_is_datatype(fieldtype) && !fieldtype->name->abstract && !fieldtype->name->mutabl);
-            int32_t first_ptr = fieldtype->layout->first_ptr;
-            if (first_ptr >= 0 && ((jl_value_t**)vo)[first_ptr] == NULL) {
-                // If the field is a inline immutable that can be can be undef
-                // we need to check to check for undef first since undef struct
-                // may have fields that are different but should still be treated as equal.
-                u = 0;
-            }
-            else {
-                u = immut_id_(fieldtype, (jl_value_t*)vo, 0);
-            }
-        }
-        h = bitmix(h, u);
+    // This loop is hot in Dict-of-structs workloads, so do the dispatch on
+    // the fielddesc width once up front instead of switching on it inside
+    // jl_field_offset/jl_field_size/jl_field_isptr for every field.
+    const jl_datatype_layout_t *layout = dt->layout;
+    jl_value_t **types = jl_svec_data(dt->types);
+#define IMMUT_ID_FIELD_LOOP(fielddesc_t)                                       \
+    do {                                                                       \
+        const fielddesc_t *desc = (const fielddesc_t*)jl_dt_layout_fields(layout); \
+        for (f = 0; f < nf; f++) {                                             \
+            char *vo = (char*)v + desc[f].offset;                              \
+            uintptr_t u;                                                       \
+            if (desc[f].isptr) {                                               \
+                jl_value_t *fld = *(jl_value_t**)vo;                           \
+                u = (fld == NULL) ? 0 : jl_object_id(fld);                     \
+            }                                                                  \
+            else {                                                             \
+                jl_datatype_t *fieldtype = (jl_datatype_t*)types[f];           \
+                if (jl_is_uniontype(fieldtype)) {                              \
+                    uint8_t sel = ((uint8_t*)vo)[desc[f].size - 1];            \
+                    fieldtype = (jl_datatype_t*)jl_nth_union_component((jl_value_t*)fieldtype, sel); \
+                }                                                              \
+                assert(jl_is_datatype(fieldtype) && !fieldtype->name->abstract && !fieldtype->name->mutabl); \
+                int32_t first_ptr = fieldtype->layout->first_ptr;              \
+                if (first_ptr >= 0 && ((jl_value_t**)vo)[first_ptr] == NULL) { \
+                    /* If the field is a inline immutable that can be undef    \
+                       we need to check for undef first since undef struct     \
+                       may have fields that are different but should still     \
+                       be treated as equal. */                                 \
+                    u = 0;                                                     \
+                }                                                              \
+                else {                                                         \
+                    u = immut_id_(fieldtype, (jl_value_t*)vo, 0);              \
+                }                                                              \
+            }                                                                  \
+            h = bitmix(h, u);                                                  \
+        }                                                                      \
+    } while (0)
+    if (layout->fielddesc_type == 0) {
+        IMMUT_ID_FIELD_LOOP(jl_fielddesc8_t);
+    }
+    else if (layout->fielddesc_type == 1) {
+        IMMUT_ID_FIELD_LOOP(jl_fielddesc16_t);
+    }
+    else {
+        assert(layout->fielddesc_type == 2);
+        IMMUT_ID_FIELD_LOOP(jl_fielddesc32_t);
     }
+#undef IMMUT_ID_FIELD_LOOP
     return h;
 }
 
@@ -440,6 +503,67 @@ JL_DLLEXPORT uintptr_t jl_object_id(jl_value_t *v) JL_NOTSAFEPOINT
     return jl_object_id_(jl_typeof(v), v);
 }
 
+// substring search -----------------------------------------------------------
+
+// Find the first occurrence of an `nlen`-byte needle in an `hlen`-byte
+// haystack; returns its 0-based offset, or -1 if absent. The x86 hot loop
+// compares the needle's first and last bytes across 16-byte blocks and runs
+// memcmp only where both hit, which filters nearly every position on long
+// inputs; elsewhere a memchr-driven first-byte filter does the same job one
+// candidate at a time. Used by the substring paths of `findnext`/`occursin`
+// in base/strings/search.jl.
+JL_DLLEXPORT int64_t jl_memmem(const char *hay, size_t hlen,
+                               const char *needle, size_t nlen) JL_NOTSAFEPOINT
+{
+    if (nlen == 0)
+        return 0;
+    if (hlen < nlen)
+        return -1;
+    if (nlen == 1) {
+        const char *p = (const char*)memchr(hay, needle[0], hlen);
+        return p ? (int64_t)(p - hay) : -1;
+    }
+    const unsigned char c0 = (unsigned char)needle[0];
+    const unsigned char c1 = (unsigned char)needle[nlen - 1];
+    size_t w = hlen - nlen; // last valid match offset
+#ifdef _CPU_X86_64_
+    const __m128i v0 = _mm_set1_epi8((char)c0);
+    const __m128i v1 = _mm_set1_epi8((char)c1);
+    size_t i = 0;
+    while (i + 16 <= w + 1) {
+        __m128i b0 = _mm_loadu_si128((const __m128i*)(hay + i));
+        __m128i b1 = _mm_loadu_si128((const __m128i*)(hay + i + nlen - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(b0, v0), _mm_cmpeq_epi8(b1, v1)));
+        while (mask) {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            mask &= mask - 1;
+            if (memcmp(hay + i + bit + 1, needle + 1, nlen - 2) == 0)
+                return (int64_t)(i + bit);
+        }
+        i += 16;
+    }
+    for (; i <= w; i++) {
+        if ((unsigned char)hay[i] == c0 && (unsigned char)hay[i + nlen - 1] == c1 &&
+            memcmp(hay + i + 1, needle + 1, nlen - 2) == 0)
+            return (int64_t)i;
+    }
+#else
+    const char *p = hay;
+    const char *end = hay + w + 1; // one past the last valid match offset
+    while (p < end) {
+        p = (const char*)memchr(p, (int)c0, (size_t)(end - p));
+        if (p == NULL)
+            break;
+        if ((unsigned char)p[nlen - 1] == c1 &&
+            memcmp(p + 1, needle + 1, nlen - 2) == 0)
+            return (int64_t)(p - hay);
+        p++;
+    }
+#endif
+    return -1;
+}
+
 // eq hash table --------------------------------------------------------------
 
 #include "iddict.c"
@@ -591,6 +715,31 @@ static jl_value_t *do_apply( jl_value_t **args, uint32_t nargs, jl_value_t *iter
         else if (f == jl_builtin_tuple && jl_is_tuple(args[1])) {
             return args[1];
         }
+        // single-splat fast path: `f(xs...)` where `xs` already stores its
+        // elements as a contiguous array of boxed values can forward that
+        // storage to dispatch directly, with no argument buffer allocated or
+        // copied (the elements stay rooted through `args[1]`)
+        jl_value_t *ai = args[1];
+        if (jl_is_svec(ai)) {
+            size_t al = jl_svec_len(ai);
+            if (al > 0 && al < UINT32_MAX)
+                return jl_apply_generic(f, jl_svec_data(ai), (uint32_t)al);
+        }
+        else if (jl_is_tuple(ai)) {
+            jl_datatype_t *dt = (jl_datatype_t*)jl_typeof(ai);
+            size_t al = jl_nfields(ai);
+            if (al > 0 && al < UINT32_MAX) {
+                // every field stored boxed (not merely pointer-containing
+                // inline structs): the object body is exactly the argument
+                // array dispatch expects
+                size_t j;
+                for (j = 0; j < al; j++)
+                    if (!jl_field_isptr(dt, j))
+                        break;
+                if (j == al)
+                    return jl_apply_generic(f, (jl_value_t**)ai, (uint32_t)al);
+            }
+        }
     }
     // estimate how many real arguments we appear to have
     size_t precount = 1;
@@ -824,18 +973,15 @@ JL_CALLABLE(jl_f__call_in_world_total)
 
 JL_CALLABLE(jl_f_tuple)
 {
-    size_t i;
     if (nargs == 0)
         return (jl_value_t*)jl_emptytuple;
     jl_datatype_t *tt = jl_inst_arg_tuple_type(args[0], &args[1], nargs, 0);
     JL_GC_PROMISE_ROOTED(tt); // it is a concrete type
     if (tt->instance != NULL)
         return tt->instance;
-    jl_task_t *ct = jl_current_task;
-    jl_value_t *jv = jl_gc_alloc(ct->ptls, jl_datatype_size(tt), tt);
-    for (i = 0; i < nargs; i++)
-        set_nth_field(tt, jv, i, args[i], 0);
-    return jv;
+    // tt was computed from these exact argument values, so the generic
+    // per-field checks of set_nth_field are not needed here
+    return jl_new_tuplev(tt, args, nargs);
 }
 
 JL_CALLABLE(jl_f_svec)
@@ -979,7 +1125,7 @@ JL_CALLABLE(jl_f_swapfield)
     if (isatomic == (order == jl_memory_order_notatomic))
         jl_atomic_error(isatomic ? "swapfield!: atomic field cannot be written non-atomically"
                                  : "swapfield!: non-atomic field cannot be written atomically");
-    v = swap_nth_field(st, v, idx, args[2], isatomic); // always seq_cst, if isatomic needed at all
+    v = swap_nth_field(st, v, idx, args[2], isatomic, order);
     return v;
 }
 
@@ -998,7 +1144,7 @@ JL_CALLABLE(jl_f_modifyfield)
     if (isatomic == (order == jl_memory_order_notatomic))
         jl_atomic_error(isatomic ? "modifyfield!: atomic field cannot be written non-atomically"
                                  : "modifyfield!: non-atomic field cannot be written atomically");
-    v = modify_nth_field(st, v, idx, args[2], args[3], isatomic); // always seq_cst, if isatomic needed at all
+    v = modify_nth_field(st, v, idx, args[2], args[3], isatomic, order);
     return v;
 }
 
@@ -1028,7 +1174,7 @@ JL_CALLABLE(jl_f_replacefield)
     if (isatomic == (failure_order == jl_memory_order_notatomic))
         jl_atomic_error(isatomic ? "replacefield!: atomic field cannot be accessed non-atomically"
                                  : "replacefield!: non-atomic field cannot be accessed atomically");
-    v = replace_nth_field(st, v, idx, args[2], args[3], isatomic); // always seq_cst, if isatomic needed at all
+    v = replace_nth_field(st, v, idx, args[2], args[3], isatomic, success_order, failure_order);
     return v;
 }
 
@@ -1351,6 +1497,15 @@ JL_CALLABLE(jl_f_invoke)
     return res;
 }
 
+// Builtin version of Core.kwfunc: a dynamic keyword call looks up the
+// keyword sorter on every invocation, so resolving it must not cost a full
+// generic dispatch of its own.
+JL_CALLABLE(jl_f_kwfunc)
+{
+    JL_NARGS(kwfunc, 1, 1);
+    return jl_get_keyword_sorter(args[0]);
+}
+
 JL_CALLABLE(jl_f_invoke_kwsorter)
 {
     JL_NARGSV(invoke, 3);
@@ -1960,6 +2115,7 @@ void jl_init_primitives(void) JL_GC_DISABLED
     // method table utils
     jl_builtin_applicable = add_builtin_func("applicable", jl_f_applicable);
     jl_builtin_invoke = add_builtin_func("invoke", jl_f_invoke);
+    add_builtin_func("kwfunc", jl_f_kwfunc);
     jl_typename_t *itn = ((jl_datatype_t*)jl_typeof(jl_builtin_invoke))->name;
     jl_value_t *ikws = jl_new_generic_function_with_supertype(itn->name, jl_core_module, jl_builtin_type);
     itn->mt->kwsorter = ikws;
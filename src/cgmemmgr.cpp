@@ -29,8 +29,25 @@
 
 namespace {
 
-static size_t get_block_size(size_t size)
+#if defined(_OS_LINUX_) && defined(MADV_HUGEPAGE)
+#  define JL_CGMEMMGR_HUGEPAGES
+// Transparent hugepage size on every Linux target we support.
+static constexpr size_t hugepage_size = 2 * 1024 * 1024;
+#endif
+
+static size_t get_block_size(size_t size, bool exec)
 {
+#ifdef JL_CGMEMMGR_HUGEPAGES
+    // Size code regions in whole hugepage ranges. A `jl_add_to_ee` batch is
+    // bump-allocated from the current block, so a bigger block keeps the
+    // whole batch contiguous, and the kernel can back the region with
+    // hugepages to cut iTLB misses on dispatch-heavy workloads.
+    if (exec)
+        return LLT_ALIGN(size < hugepage_size ? hugepage_size : size,
+                         hugepage_size);
+#else
+    (void)exec;
+#endif
     return (size > jl_page_size * 256 ? LLT_ALIGN(size, jl_page_size) :
             jl_page_size * 256);
 }
@@ -51,6 +68,28 @@ static void *map_anon_page(size_t size)
     return mem;
 }
 
+#ifdef JL_CGMEMMGR_HUGEPAGES
+// `mmap` only guarantees page alignment but transparent hugepages only back
+// hugepage-aligned ranges; over-map, give back the slack and ask for
+// hugepages so the whole block is eligible.
+static void *map_hugepage_exec_block(size_t size)
+{
+    assert(size % hugepage_size == 0);
+    size_t alloc_size = size + hugepage_size - jl_page_size;
+    char *mem = (char*)mmap(nullptr, alloc_size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(mem != MAP_FAILED && "Cannot allocate RW memory");
+    char *aligned = (char*)LLT_ALIGN(uintptr_t(mem), hugepage_size);
+    if (aligned != mem)
+        munmap(mem, aligned - mem);
+    size_t tail = alloc_size - (aligned - mem) - size;
+    if (tail)
+        munmap(aligned + size, tail);
+    madvise(aligned, size, MADV_HUGEPAGE);
+    return aligned;
+}
+#endif // JL_CGMEMMGR_HUGEPAGES
+
 static void unmap_page(void *ptr, size_t size)
 {
 #ifdef _OS_WINDOWS_
@@ -467,7 +506,7 @@ public:
                 min_id = i;
             }
         }
-        size_t block_size = get_block_size(size);
+        size_t block_size = get_block_size(size, false);
         blocks[min_id].reset(map_anon_page(block_size), block_size);
         return blocks[min_id].alloc(size, align);
     }
@@ -491,6 +530,10 @@ struct SplitPtrBlock : public Block {
 
     uintptr_t wr_ptr{0};
     uint32_t state{0};
+    // File offset of the block in the shared mapping handle for
+    // `DualMapAllocator` ((uintptr_t)-1 otherwise); needed to punch holes
+    // in the backing file when cold code is released (see `release_range`).
+    uintptr_t fd_off{(uintptr_t)-1};
     SplitPtrBlock() = default;
 
     void swap(SplitPtrBlock &other)
@@ -500,6 +543,7 @@ struct SplitPtrBlock : public Block {
         std::swap(avail, other.avail);
         std::swap(wr_ptr, other.wr_ptr);
         std::swap(state, other.state);
+        std::swap(fd_off, other.fd_off);
     }
 
     SplitPtrBlock(SplitPtrBlock &&other)
@@ -529,6 +573,38 @@ protected:
     virtual void *get_wr_ptr(SplitPtrBlock &block, void *rt_ptr,
                              size_t size, size_t align) = 0;
     virtual SplitPtrBlock alloc_block(size_t size) = 0;
+    // Page-align `[*addr, *addr + *size)` inward (pages shared with live
+    // code must survive) and locate the live or retired block containing
+    // it. Returns `false` when nothing whole-page remains or the range
+    // does not belong to this allocator.
+    bool find_release_range(uintptr_t *addr, size_t *size,
+                            uintptr_t *block_ptr, uintptr_t *fd_off)
+    {
+        uintptr_t lo = LLT_ALIGN(*addr, jl_page_size);
+        uintptr_t hi = (*addr + *size) & ~(uintptr_t)(jl_page_size - 1);
+        if (hi <= lo)
+            return false;
+        for (auto &block : blocks) {
+            if (block.ptr && lo >= (uintptr_t)block.ptr &&
+                hi <= (uintptr_t)block.ptr + block.total) {
+                *addr = lo;
+                *size = hi - lo;
+                *block_ptr = (uintptr_t)block.ptr;
+                *fd_off = block.fd_off;
+                return true;
+            }
+        }
+        for (auto &block : retired) {
+            if (lo >= block.ptr && hi <= block.ptr + block.total) {
+                *addr = lo;
+                *size = hi - lo;
+                *block_ptr = block.ptr;
+                *fd_off = block.fd_off;
+                return true;
+            }
+        }
+        return false;
+    }
 public:
     virtual ~ROAllocator() {}
     virtual void finalize()
@@ -545,6 +621,36 @@ public:
     }
     // Allocations that have not been finalized yet.
     SmallVector<Allocation, 16> allocations;
+    // Runtime address ranges handed out since the last drain, for the JIT's
+    // per-emission code accounting (see `JITCodeRegion` in jitlayers.cpp).
+    SmallVector<std::pair<void*, size_t>, 16> recent_rt;
+    // Blocks retired from `completed` at finalization. The mappings stay
+    // alive forever, so this only records where they are: cold-code
+    // eviction needs to find the block backing a runtime address long
+    // after the block stopped accepting allocations.
+    struct RetiredBlock {
+        uintptr_t ptr;
+        size_t total;
+        uintptr_t fd_off;
+    };
+    SmallVector<RetiredBlock, 16> retired;
+    // Return the backing pages of `[rt_addr, rt_addr + size)` to the OS.
+    // The caller guarantees the code there can no longer be reached; the
+    // bump allocators never reuse the virtual range, which simply reads
+    // back as zeros afterwards. Returns the number of bytes released.
+    virtual size_t release_range(void *rt_addr, size_t size)
+    {
+        (void)rt_addr;
+        (void)size;
+        return 0;
+    }
+    // Region accounting (see `jl_jit_code_region_stats`). The blocks backing
+    // old allocations are never unmapped so these only ever grow.
+    size_t region_bytes{0};
+    size_t region_count{0};
+    // Bytes of regions that were mapped (or at least advised) for
+    // hugepage backing; updated by `alloc_block`.
+    size_t hugepage_bytes{0};
     void *alloc(size_t size, size_t align)
     {
         size_t min_size = (size_t)-1;
@@ -562,6 +668,8 @@ public:
                 }
                 block.state |= SplitPtrBlock::Alloc;
                 allocations.push_back(Allocation{wr_ptr, ptr, size, false});
+                if (exec)
+                    recent_rt.push_back(std::make_pair(ptr, size));
                 return wr_ptr;
             }
             if (block.avail < min_size) {
@@ -569,9 +677,11 @@ public:
                 min_id = i;
             }
         }
-        size_t block_size = get_block_size(size);
+        size_t block_size = get_block_size(size, exec);
         auto &block = blocks[min_id];
         auto new_block = alloc_block(block_size);
+        region_count++;
+        region_bytes += block_size;
         block.swap(new_block);
         if (new_block.state) {
             completed.push_back(std::move(new_block));
@@ -584,10 +694,14 @@ public:
         block.state = SplitPtrBlock::Alloc;
         void *wr_ptr = get_wr_ptr(block, ptr, size, align);
         allocations.push_back(Allocation{wr_ptr, ptr, size, false});
+        if (exec)
+            recent_rt.push_back(std::make_pair(ptr, size));
         ptr = wr_ptr;
 #else
         block.state = SplitPtrBlock::Alloc | SplitPtrBlock::InitAlloc;
         allocations.push_back(Allocation{ptr, ptr, size, false});
+        if (exec)
+            recent_rt.push_back(std::make_pair(ptr, size));
 #endif
         return ptr;
     }
@@ -616,6 +730,15 @@ protected:
         SplitPtrBlock new_block;
         // use `wr_ptr` to record the id initially
         auto ptr = alloc_shared_page(size, (size_t*)&new_block.wr_ptr, exec);
+        // the id is the file offset; keep it after `wr_ptr` is repurposed
+        new_block.fd_off = new_block.wr_ptr;
+#ifdef JL_CGMEMMGR_HUGEPAGES
+        // The shared pool hands out page-aligned offsets so hugepage-aligned
+        // backing is not guaranteed here; the madvise is only a hint and the
+        // kernel collapses whatever aligned subranges it can.
+        if (exec && madvise(ptr, size, MADV_HUGEPAGE) == 0)
+            this->hugepage_bytes += size;
+#endif
         new_block.reset(ptr, size);
         return new_block;
     }
@@ -666,10 +789,33 @@ public:
         }
         for (auto &block : this->completed) {
             finalize_block(block, true);
+            this->retired.push_back({(uintptr_t)block.ptr, block.total,
+                                     block.fd_off});
             block.reset(nullptr, 0);
         }
         ROAllocator<exec>::finalize();
     }
+    size_t release_range(void *rt_addr, size_t size) override
+    {
+#if defined(_OS_LINUX_) && defined(FALLOC_FL_PUNCH_HOLE)
+        uintptr_t addr = (uintptr_t)rt_addr;
+        uintptr_t block_ptr;
+        uintptr_t fd_off;
+        if (!this->find_release_range(&addr, &size, &block_ptr, &fd_off))
+            return 0;
+        // punching a hole in the shared mapping handle (a memfd/shm tmpfs
+        // file) frees the physical pages behind both the runtime and any
+        // write mapping; the range reads back as zeros if ever touched
+        if (fallocate(anon_hdl, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                      (off_t)(fd_off + (addr - block_ptr)), (off_t)size) != 0)
+            return 0;
+        return size;
+#else
+        (void)rt_addr;
+        (void)size;
+        return 0;
+#endif
+    }
 };
 
 #ifdef _OS_LINUX_
@@ -688,13 +834,20 @@ protected:
         }
         temp_buff.emplace_back();
         Block &new_block = temp_buff.back();
-        size_t block_size = get_block_size(size);
+        size_t block_size = get_block_size(size, false);
         new_block.reset(map_anon_page(block_size), block_size);
         return new_block.alloc(size, align);
     }
     SplitPtrBlock alloc_block(size_t size) override
     {
         SplitPtrBlock new_block;
+#ifdef JL_CGMEMMGR_HUGEPAGES
+        if (exec) {
+            new_block.reset(map_hugepage_exec_block(size), size);
+            this->hugepage_bytes += size;
+            return new_block;
+        }
+#endif
         new_block.reset(map_anon_page(size), size);
         return new_block;
     }
@@ -717,6 +870,20 @@ public:
     {
         assert(get_self_mem_fd() != -1);
     }
+    size_t release_range(void *rt_addr, size_t size) override
+    {
+        uintptr_t addr = (uintptr_t)rt_addr;
+        uintptr_t block_ptr;
+        uintptr_t fd_off;
+        if (!this->find_release_range(&addr, &size, &block_ptr, &fd_off))
+            return 0;
+        // private anonymous mapping: the pages are freed eagerly and read
+        // back as zeros if ever touched again. Fails (harmlessly) on
+        // hugetlb-backed blocks when the range is not hugepage-aligned.
+        if (madvise((void*)addr, size, MADV_DONTNEED) != 0)
+            return 0;
+        return size;
+    }
     void finalize() override
     {
         for (auto &block : this->blocks) {
@@ -724,6 +891,8 @@ public:
         }
         for (auto &block : this->completed) {
             finalize_block(block, true);
+            this->retired.push_back({(uintptr_t)block.ptr, block.total,
+                                     block.fd_off});
             block.reset(nullptr, 0);
         }
         for (auto &alloc : this->allocations) {
@@ -791,6 +960,33 @@ public:
     {
     }
     size_t getTotalBytes() { return total_allocated; }
+    size_t releaseCodeRange(void *rt_addr, size_t size)
+    {
+        return exe_alloc ? exe_alloc->release_range(rt_addr, size) : 0;
+    }
+    size_t drainRecentCodeAllocs(void **addrs, size_t *sizes, size_t max)
+    {
+        if (!exe_alloc)
+            return 0;
+        auto &recent = exe_alloc->recent_rt;
+        size_t n = recent.size() < max ? recent.size() : max;
+        for (size_t i = 0; i < n; i++) {
+            addrs[i] = recent[i].first;
+            sizes[i] = recent[i].second;
+        }
+        recent.clear();
+        return n;
+    }
+    void getCodeRegionStats(size_t *region_bytes, size_t *region_count,
+                            size_t *hugepage_bytes)
+    {
+        *region_bytes = *region_count = *hugepage_bytes = 0;
+        if (exe_alloc) {
+            *region_bytes = exe_alloc->region_bytes;
+            *region_count = exe_alloc->region_count;
+            *hugepage_bytes = exe_alloc->hugepage_bytes;
+        }
+    }
     void registerEHFrames(uint8_t *Addr, uint64_t LoadAddr,
                           size_t Size) override;
 #if 0
@@ -949,3 +1145,25 @@ size_t getRTDyldMemoryManagerTotalBytes(RTDyldMemoryManager *mm)
 {
     return ((RTDyldMemoryManagerJL*)mm)->getTotalBytes();
 }
+
+void getRTDyldMemoryManagerCodeRegionStats(RTDyldMemoryManager *mm,
+                                           size_t *region_bytes,
+                                           size_t *region_count,
+                                           size_t *hugepage_bytes)
+{
+    ((RTDyldMemoryManagerJL*)mm)->getCodeRegionStats(region_bytes, region_count,
+                                                     hugepage_bytes);
+}
+
+size_t getRTDyldMemoryManagerReleaseCodeRange(RTDyldMemoryManager *mm,
+                                              void *rt_addr, size_t size)
+{
+    return ((RTDyldMemoryManagerJL*)mm)->releaseCodeRange(rt_addr, size);
+}
+
+size_t getRTDyldMemoryManagerDrainCodeAllocs(RTDyldMemoryManager *mm,
+                                             void **addrs, size_t *sizes,
+                                             size_t max)
+{
+    return ((RTDyldMemoryManagerJL*)mm)->drainRecentCodeAllocs(addrs, sizes, max);
+}
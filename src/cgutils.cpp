@@ -943,7 +943,11 @@ static void emit_memcpy_llvm(jl_codectx_t &ctx, Value *dst, MDNode *tbaa_dst, Va
     // since the tbaa lattice has to be a tree we have unfortunately
     // x.tbaa ∪ ctx.tbaa().tbaa_stack = tbaa_root if x.tbaa != ctx.tbaa().tbaa_stack
     ++EmittedMemcpys;
-    ctx.builder.CreateMemCpy(dst, MaybeAlign(align), src, MaybeAlign(0), sz, is_volatile, MDNode::getMostGenericTBAA(tbaa_dst, tbaa_src));
+    // `align` describes both operands (the direct load/store above relies on
+    // that already); claiming it for the source as well lets the backend
+    // expand small fixed-size copies with full-width (per target-features of
+    // the enclosing clone) vector moves instead of byte-aligned ones.
+    ctx.builder.CreateMemCpy(dst, MaybeAlign(align), src, MaybeAlign(align), sz, is_volatile, MDNode::getMostGenericTBAA(tbaa_dst, tbaa_src));
 }
 
 static void emit_memcpy_llvm(jl_codectx_t &ctx, Value *dst, MDNode *tbaa_dst, Value *src, MDNode *tbaa_src,
@@ -954,7 +958,7 @@ static void emit_memcpy_llvm(jl_codectx_t &ctx, Value *dst, MDNode *tbaa_dst, Va
         return;
     }
     ++EmittedMemcpys;
-    ctx.builder.CreateMemCpy(dst, MaybeAlign(align), src, MaybeAlign(0), sz, is_volatile, MDNode::getMostGenericTBAA(tbaa_dst, tbaa_src));
+    ctx.builder.CreateMemCpy(dst, MaybeAlign(align), src, MaybeAlign(align), sz, is_volatile, MDNode::getMostGenericTBAA(tbaa_dst, tbaa_src));
 }
 
 template<typename T1>
@@ -2345,7 +2349,21 @@ static jl_cgval_t emit_unionload(jl_codectx_t &ctx, Value *addr, Value *ptindex,
         AllocaInst *lv = emit_static_alloca(ctx, AT);
         if (al > 1)
             lv->setAlignment(Align(al));
-        emit_memcpy(ctx, lv, tbaa, addr, tbaa, fsz, al);
+        if ((fsz & (fsz - 1)) == 0 && fsz <= 16 && fsz % al == 0) {
+            // small-union fast lane: a single typed load/store keeps the
+            // slot promotable by SROA, so tight loops over small isbits
+            // unions (Union{T,Missing} arrays and the like) stay branchless
+            // and can vectorize with selects on the selector byte, instead
+            // of carrying a memcpy and a stack slot per element
+            Type *IT = IntegerType::get(ctx.builder.getContext(), 8 * fsz);
+            Value *v = tbaa_decorate(tbaa, ctx.builder.CreateAlignedLoad(IT,
+                    emit_bitcast(ctx, addr, IT->getPointerTo()), Align(al)));
+            tbaa_decorate(tbaa, ctx.builder.CreateAlignedStore(v,
+                    emit_bitcast(ctx, lv, IT->getPointerTo()), Align(al)));
+        }
+        else {
+            emit_memcpy(ctx, lv, tbaa, addr, tbaa, fsz, al);
+        }
         addr = lv;
     }
     return mark_julia_slot(fsz > 0 ? addr : nullptr, jfty, tindex, tbaa);
@@ -2735,7 +2753,7 @@ static Value *emit_arrayndims(jl_codectx_t &ctx, const jl_cgval_t &ary)
     Value *flags = emit_arrayflags(ctx, ary);
     cast<LoadInst>(flags)->setMetadata(LLVMContext::MD_invariant_load, MDNode::get(ctx.builder.getContext(), None));
     flags = ctx.builder.CreateLShr(flags, 2);
-    flags = ctx.builder.CreateAnd(flags, 0x1FF); // (1<<9) - 1
+    flags = ctx.builder.CreateAnd(flags, 0xFF); // (1<<8) - 1
     return flags;
 }
 
@@ -2884,7 +2902,10 @@ static void init_bits_cgval(jl_codectx_t &ctx, Value *newv, const jl_cgval_t& v,
 {
     // newv should already be tagged
     if (v.ispointer()) {
-        emit_memcpy(ctx, newv, tbaa, v, jl_datatype_size(v.typ), sizeof(void*));
+        // the source may be a stack slot with only the type's alignment, so
+        // don't claim more than that (the box itself is pointer-aligned)
+        emit_memcpy(ctx, newv, tbaa, v, jl_datatype_size(v.typ),
+                    std::min<unsigned>(julia_alignment(v.typ), sizeof(void*)));
     }
     else {
         init_bits_value(ctx, newv, v.V, tbaa);
@@ -3450,6 +3471,18 @@ static Value *emit_allocobj(jl_codectx_t &ctx, size_t static_size, Value *jt)
     Function *F = prepare_call(jl_alloc_obj_func);
     auto call = ctx.builder.CreateCall(F, {current_task, ConstantInt::get(getSizeTy(ctx.builder.getContext()), static_size), maybe_decay_untracked(ctx, jt)});
     call->setAttributes(F->getAttributes());
+    // opt-in per-site allocation accounting: assign this allocation
+    // instruction a dense site ID and bump that site's per-thread counters
+    // at runtime. Site IDs are session-local, so code destined for a
+    // sysimage is never instrumented.
+    if (jl_alloc_site_tracking_enabled && !ctx.emission_context.imaging) {
+        uint32_t site = jl_register_alloc_site(ctx.name, ctx.file.str().c_str(),
+                                               ctx.line ? (int)*ctx.line : -1);
+        ctx.builder.CreateCall(prepare_call(jl_count_alloc_site_func),
+                {ConstantInt::get(getInt32Ty(ctx.builder.getContext()), site),
+                 maybe_decay_untracked(ctx, jt),
+                 ConstantInt::get(getSizeTy(ctx.builder.getContext()), static_size)});
+    }
     return call;
 }
 
@@ -3963,6 +3996,7 @@ static int compare_cgparams(const jl_cgparams_t *a, const jl_cgparams_t *b)
            (a->track_allocations == b->track_allocations) &&
            (a->code_coverage == b->code_coverage) &&
            (a->prefer_specsig == b->prefer_specsig) &&
+           (a->speculate_globals == b->speculate_globals) &&
            (a->gnu_pubnames == b->gnu_pubnames) &&
            (a->debug_info_kind == b->debug_info_kind) &&
            (a->lookup == b->lookup) &&
@@ -47,6 +47,20 @@ JL_DLLEXPORT void jl_generate_fptr_for_unspecialized_fallback(jl_code_instance_t
     jl_atomic_store_release(&unspec->invoke, &jl_fptr_interpret_call);
 }
 
+JL_DLLEXPORT void jl_tiered_compile_upgrade_fallback(jl_method_instance_t *mi, size_t world)
+{
+}
+
+JL_DLLEXPORT size_t jl_profile_recompile_hot_fallback(int64_t threshold)
+{
+    return 0;
+}
+
+JL_DLLEXPORT size_t jl_jit_freeze_invokes_fallback(void)
+{
+    return 0;
+}
+
 JL_DLLEXPORT uint32_t jl_get_LLVM_VERSION_fallback(void)
 {
     return 0;
@@ -66,6 +80,18 @@ JL_DLLEXPORT size_t jl_jit_total_bytes_fallback(void)
     return 0;
 }
 
+JL_DLLEXPORT void jl_jit_code_region_stats_fallback(size_t *region_bytes,
+                                                    size_t *region_count,
+                                                    size_t *hugepage_bytes)
+{
+    *region_bytes = *region_count = *hugepage_bytes = 0;
+}
+
+JL_DLLEXPORT size_t jl_jit_evict_cold_fallback(size_t target_bytes)
+{
+    return 0;
+}
+
 JL_DLLEXPORT void *jl_create_native_fallback(jl_array_t *methods, LLVMOrcThreadSafeModuleRef llvmctxt, const jl_cgparams_t *cgparams, int _policy) UNAVAILABLE
 
 JL_DLLEXPORT void jl_dump_compiles_fallback(void *s)
@@ -116,6 +142,8 @@ JL_DLLEXPORT void LLVMExtraAddRemoveJuliaAddrspacesPass_fallback(void *PM) UNAVA
 
 JL_DLLEXPORT void LLVMExtraAddCombineMulAddPass_fallback(void *PM) UNAVAILABLE
 
+JL_DLLEXPORT void LLVMExtraAddBoundsCheckElimPass_fallback(void *PM) UNAVAILABLE
+
 JL_DLLEXPORT void LLVMExtraAddMultiVersioningPass_fallback(void *PM) UNAVAILABLE
 
 JL_DLLEXPORT void LLVMExtraAddLowerExcHandlersPass_fallback(void *PM) UNAVAILABLE
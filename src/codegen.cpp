@@ -480,6 +480,7 @@ static Type *get_pjlvalue(LLVMContext &C) { return JuliaType::get_pjlvalue_ty(C)
 
 static FunctionType *get_func_sig(LLVMContext &C) { return JuliaType::get_jlfunc_ty(C); }
 static FunctionType *get_func2_sig(LLVMContext &C) { return JuliaType::get_jlfunc2_ty(C); }
+static FunctionType *get_funcparams_sig(LLVMContext &C) { return JuliaType::get_jlfuncparams_ty(C); }
 
 static FunctionType *get_donotdelete_sig(LLVMContext &C) {
     return FunctionType::get(getVoidTy(C), true);
@@ -740,6 +741,14 @@ static const auto jlapplygeneric_func = new JuliaFunction{
     get_func_sig,
     get_func_attrs,
 };
+// `jl_apply_generic` with a per-callsite inline-cache slot passed as the
+// trailing pointer argument (same shape as the sparam_vals slot in
+// T_jlfuncparams)
+static const auto jlapplygenericpic_func = new JuliaFunction{
+    XSTR(jl_apply_generic_pic),
+    get_funcparams_sig,
+    get_func_attrs,
+};
 static const auto jlinvoke_func = new JuliaFunction{
     XSTR(jl_invoke),
     get_func2_sig,
@@ -854,6 +863,18 @@ static const auto jl_newbits_func = new JuliaFunction{
             Attributes(C, {Attribute::NonNull}),
             None); },
 };
+static const auto jl_count_alloc_site_func = new JuliaFunction{
+    XSTR(jl_count_alloc_site),
+    [](LLVMContext &C) {
+        auto T_prjlvalue = JuliaType::get_prjlvalue_ty(C);
+        return FunctionType::get(getVoidTy(C),
+                {getInt32Ty(C), T_prjlvalue, getSizeTy(C)}, false);
+    },
+    [](LLVMContext &C) { return AttributeList::get(C,
+            Attributes(C, {Attribute::NoUnwind}),
+            AttributeSet(),
+            None); },
+};
 // `julia.typeof` does read memory, but it is effectively readnone before we lower
 // the allocation function. This is OK as long as we lower `julia.typeof` no later than
 // `julia.gc_alloc_obj`.
@@ -1139,6 +1160,25 @@ static const auto julia_call2 = new JuliaFunction{
     get_attrs_basic,
 };
 
+// julia.call3 is like julia.call2, except that %arg1 is an untracked pointer
+// (an inline-cache slot handed out by the runtime) rather than a boxed value,
+// so it is passed through to the callee without being rooted.
+static const auto julia_call3 = new JuliaFunction{
+    "julia.call3",
+    [](LLVMContext &C) {
+        auto T_prjlvalue = JuliaType::get_prjlvalue_ty(C);
+        return FunctionType::get(T_prjlvalue,
+#ifdef JL_LLVM_OPAQUE_POINTERS
+            {PointerType::get(C, 0),
+#else
+            {get_funcparams_sig(C)->getPointerTo(),
+#endif
+             JuliaType::get_pprjlvalue_ty(C), // %arg1
+             T_prjlvalue}, // %f
+            true); }, // %args
+    get_attrs_basic,
+};
+
 static const auto jltuple_func = new JuliaFunction{XSTR(jl_f_tuple), get_func_sig, get_func_attrs};
 static const auto &builtin_func_map() {
     static std::map<jl_fptr_args_t, JuliaFunction*> builtins = {
@@ -1160,6 +1200,7 @@ static const auto &builtin_func_map() {
           { jl_f_applicable_addr,         new JuliaFunction{XSTR(jl_f_applicable), get_func_sig, get_func_attrs} },
           { jl_f_invoke_addr,             new JuliaFunction{XSTR(jl_f_invoke), get_func_sig, get_func_attrs} },
           { jl_f_invoke_kwsorter_addr,    new JuliaFunction{XSTR(jl_f_invoke_kwsorter), get_func_sig, get_func_attrs} },
+          { jl_f_kwfunc_addr,             new JuliaFunction{XSTR(jl_f_kwfunc), get_func_sig, get_func_attrs} },
           { jl_f_isdefined_addr,          new JuliaFunction{XSTR(jl_f_isdefined), get_func_sig, get_func_attrs} },
           { jl_f_getfield_addr,           new JuliaFunction{XSTR(jl_f_getfield), get_func_sig, get_func_attrs} },
           { jl_f_setfield_addr,           new JuliaFunction{XSTR(jl_f_setfield), get_func_sig, get_func_attrs} },
@@ -1184,9 +1225,15 @@ static const auto jl_new_opaque_closure_jlcall_func = new JuliaFunction{XSTR(jl_
 
 static std::atomic<int> globalUniqueGeneratedNames{0};
 
+// When enabled (JULIA_BACKEDGE_SAFEPOINTS), emit a safepoint poll (a read of
+// the thread's safepoint page) before every backward branch, so that threads
+// executing long non-allocating loops still reach a safepoint promptly when
+// another thread requests a stop-the-world.
+static bool jl_backedge_safepoints = false;
+
 // --- code generation ---
 extern "C" {
-    jl_cgparams_t jl_default_cgparams = {1, 1, 0,
+    jl_cgparams_t jl_default_cgparams = {1, 1, 0, 0,
 #ifdef _OS_WINDOWS_
         0,
 #else
@@ -2191,15 +2238,16 @@ JL_DLLEXPORT void jl_coverage_alloc_line(StringRef filename, int line);
 JL_DLLEXPORT uint64_t *jl_coverage_data_pointer(StringRef filename, int line);
 JL_DLLEXPORT uint64_t *jl_malloc_data_pointer(StringRef filename, int line);
 
-static void visitLine(jl_codectx_t &ctx, uint64_t *ptr, Value *addend, const char *name)
+static void visitLine(jl_codectx_t &ctx, uint64_t *ptr, Value *addend)
 {
     Value *pv = ConstantExpr::getIntToPtr(
         ConstantInt::get(getSizeTy(ctx.builder.getContext()), (uintptr_t)ptr),
         getInt64PtrTy(ctx.builder.getContext()));
-    Value *v = ctx.builder.CreateLoad(getInt64Ty(ctx.builder.getContext()), pv, true, name);
-    v = ctx.builder.CreateAdd(v, addend);
-    ctx.builder.CreateStore(v, pv, true); // volatile, not atomic, so this might be an underestimate,
-                                          // but it's faster this way
+    // a single monotonic increment: one instruction on common targets, and
+    // concurrent updates are counted exactly instead of the underestimate a
+    // plain load/add/store race produces
+    ctx.builder.CreateAtomicRMW(AtomicRMWInst::Add, pv, addend, Align(8),
+                                AtomicOrdering::Monotonic);
 }
 
 // Code coverage
@@ -2209,7 +2257,7 @@ static void coverageVisitLine(jl_codectx_t &ctx, StringRef filename, int line)
     assert(!ctx.emission_context.imaging);
     if (filename == "" || filename == "none" || filename == "no file" || filename == "<missing>" || line < 0)
         return;
-    visitLine(ctx, jl_coverage_data_pointer(filename, line), ConstantInt::get(getInt64Ty(ctx.builder.getContext()), 1), "lcnt");
+    visitLine(ctx, jl_coverage_data_pointer(filename, line), ConstantInt::get(getInt64Ty(ctx.builder.getContext()), 1));
 }
 
 // Memory allocation log (malloc_log)
@@ -2222,7 +2270,7 @@ static void mallocVisitLine(jl_codectx_t &ctx, StringRef filename, int line, Val
     Value *addend = sync
         ? ctx.builder.CreateCall(prepare_call(sync_gc_total_bytes_func), {sync})
         : ctx.builder.CreateCall(prepare_call(diff_gc_total_bytes_func), {});
-    visitLine(ctx, jl_malloc_data_pointer(filename, line), addend, "bytecnt");
+    visitLine(ctx, jl_malloc_data_pointer(filename, line), addend);
 }
 
 // --- constant determination ---
@@ -2565,6 +2613,22 @@ static jl_cgval_t emit_globalref(jl_codectx_t &ctx, jl_module_t *mod, jl_sym_t *
         if (bnd->constp) {
             return mark_julia_const(ctx, bnd->value);
         }
+        if (ctx.params->speculate_globals && !ctx.emission_context.imaging &&
+            !jl_options.incremental && !bnd->reassigned &&
+            ctx.linfo && jl_is_method(ctx.linfo->def.method)) {
+            // speculate that an assigned-once global keeps its current value:
+            // register this method instance with the binding so a later
+            // assignment pushes the emitted code out of the new world, then
+            // embed the value as a constant. The edge is registered before the
+            // value is read and `reassigned` is rechecked after, so a racing
+            // assignment either sees the edge or forces the generic load below.
+            jl_binding_add_speculation(bnd, ctx.linfo);
+            jl_value_t *v = bnd->value;
+            if (v != NULL && !bnd->reassigned) {
+                jl_add_method_root(ctx, v);
+                return mark_julia_const(ctx, v);
+            }
+        }
         LoadInst *v = ctx.builder.CreateAlignedLoad(ctx.types().T_prjlvalue, bp, Align(sizeof(void*)));
         v->setOrdering(order);
         tbaa_decorate(ctx.tbaa().tbaa_binding, v);
@@ -2578,6 +2642,12 @@ static void emit_globalset(jl_codectx_t &ctx, jl_binding_t *bnd, Value *bp, cons
 {
     Value *rval = boxed(ctx, rval_info);
     if (bnd && !bnd->constp && bnd->ty && jl_subtype(rval_info.typ, bnd->ty)) {
+        if (!bnd->reassigned) {
+            // a direct store bypasses jl_checked_assignment, so this binding
+            // can no longer support (or keep) speculated constants
+            bnd->reassigned = 1;
+            jl_binding_invalidate_speculations(bnd);
+        }
         StoreInst *v = ctx.builder.CreateAlignedStore(rval, julia_binding_pvalue(ctx, bp), Align(sizeof(void*)));
         v->setOrdering(Order);
         tbaa_decorate(ctx.tbaa().tbaa_binding, v);
@@ -3808,6 +3878,21 @@ static CallInst *emit_jlcall(jl_codectx_t &ctx, JuliaFunction *theFptr, Value *t
     return emit_jlcall(ctx, prepare_call(theFptr), theF, argv, nargs, trampoline);
 }
 
+// Emit a dynamically-dispatched call. In the JIT, each such site gets its own
+// inline-cache slot so that a repeat dispatch only revalidates the cached
+// typemap entry (see `jl_apply_generic_pic` in gf.c); the slot address is
+// baked into the generated code, so system images fall back to the plain
+// `jl_apply_generic` entry point.
+// Returns ctx.types().T_prjlvalue
+static CallInst *emit_apply_generic(jl_codectx_t &ctx, const jl_cgval_t *argv, size_t nargs)
+{
+    if (!ctx.emission_context.imaging) {
+        Value *pic = literal_static_pointer_val(jl_alloc_pic_slot(), ctx.types().T_pprjlvalue);
+        return emit_jlcall(ctx, jlapplygenericpic_func, pic, argv, nargs, julia_call3);
+    }
+    return emit_jlcall(ctx, jlapplygeneric_func, nullptr, argv, nargs, julia_call);
+}
+
 
 static jl_cgval_t emit_call_specfun_other(jl_codectx_t &ctx, jl_method_instance_t *mi, jl_value_t *jlretty, StringRef specFunctionObject,
                                           const jl_cgval_t *argv, size_t nargs, jl_returninfo_t::CallingConv *cc, unsigned *return_roots, jl_value_t *inferred_retty)
@@ -4066,7 +4151,7 @@ static jl_cgval_t emit_invoke_modify(jl_codectx_t &ctx, jl_expr_t *ex, jl_value_
     }
 
     // emit function and arguments
-    Value *callval = emit_jlcall(ctx, jlapplygeneric_func, nullptr, argv, nargs, julia_call);
+    Value *callval = emit_apply_generic(ctx, argv, nargs);
     return mark_julia_type(ctx, callval, true, rt);
 }
 
@@ -4117,7 +4202,7 @@ static jl_cgval_t emit_call(jl_codectx_t &ctx, jl_expr_t *ex, jl_value_t *rt, bo
     }
 
     // emit function and arguments
-    Value *callval = emit_jlcall(ctx, jlapplygeneric_func, nullptr, generic_argv, n_generic_args, julia_call);
+    Value *callval = emit_apply_generic(ctx, generic_argv, n_generic_args);
     return mark_julia_type(ctx, callval, true, rt);
 }
 
@@ -7767,6 +7852,8 @@ static jl_llvm_functions_t
         }
         if (jl_is_gotonode(stmt)) {
             int lname = jl_gotonode_label(stmt);
+            if (jl_backedge_safepoints && lname - 1 <= cursor)
+                emit_gc_safepoint(ctx);
             come_from_bb[cursor+1] = ctx.builder.GetInsertBlock();
             ctx.builder.CreateBr(BB[lname]);
             find_next_stmt(lname - 1);
@@ -7782,6 +7869,8 @@ static jl_llvm_functions_t
             int lname = jl_gotoifnot_label(stmt);
             Value *isfalse = emit_condition(ctx, cond, "if");
             mallocVisitStmt(debuginfoloc, nullptr);
+            if (jl_backedge_safepoints && lname - 1 <= cursor)
+                emit_gc_safepoint(ctx);
             come_from_bb[cursor+1] = ctx.builder.GetInsertBlock();
             workstack.push_back(lname - 1);
             BasicBlock *ifnot = BB[lname];
@@ -7798,9 +7887,34 @@ static jl_llvm_functions_t
 
             assert(jl_is_long(args[0]));
             int lname = jl_unbox_long(args[0]);
-            // Save exception stack depth at enter for use in pop_exception
-            Value *excstack_state =
-                ctx.builder.CreateCall(prepare_call(jl_excstack_state_func));
+            // Save exception stack depth at enter for use in pop_exception.
+            // Expanded inline from jl_excstack_state so that the non-throwing
+            // path of `enter` pays two loads here instead of a runtime call.
+            Type *T_size = getSizeTy(ctx.builder.getContext());
+            Value *ct = get_current_task(ctx);
+            Value *pexcstack = ctx.builder.CreateInBoundsGEP(
+                    T_size,
+                    ctx.builder.CreateBitCast(ct, getSizePtrTy(ctx.builder.getContext())),
+                    ConstantInt::get(T_size, offsetof(jl_task_t, excstack) / sizeof(size_t)),
+                    "excstack");
+            // The excstack pointer is loaded as a size_t so the null check and
+            // the `top` load (first field of jl_excstack_t) share one type.
+            Value *stk = ctx.builder.CreateAlignedLoad(T_size, pexcstack, Align(sizeof(size_t)));
+            BasicBlock *enterBB = ctx.builder.GetInsertBlock();
+            BasicBlock *loadtopBB = BasicBlock::Create(ctx.builder.getContext(), "excstack.load", f);
+            BasicBlock *stateBB = BasicBlock::Create(ctx.builder.getContext(), "excstack.state", f);
+            Value *stknull = ctx.builder.CreateICmpEQ(stk, ConstantInt::get(T_size, 0));
+            ctx.builder.CreateCondBr(stknull, stateBB, loadtopBB);
+            ctx.builder.SetInsertPoint(loadtopBB);
+            static_assert(offsetof(jl_excstack_t, top) == 0, "excstack top expected at offset 0");
+            Value *stktop = ctx.builder.CreateAlignedLoad(T_size,
+                    ctx.builder.CreateIntToPtr(stk, getSizePtrTy(ctx.builder.getContext())),
+                    Align(sizeof(size_t)));
+            ctx.builder.CreateBr(stateBB);
+            ctx.builder.SetInsertPoint(stateBB);
+            PHINode *excstack_state = ctx.builder.CreatePHI(T_size, 2);
+            excstack_state->addIncoming(ConstantInt::get(T_size, 0), enterBB);
+            excstack_state->addIncoming(stktop, loadtopBB);
             assert(!ctx.ssavalue_assigned.at(cursor));
             ctx.SAvalues.at(cursor) = jl_cgval_t(excstack_state, (jl_value_t*)jl_ulong_type, NULL);
             ctx.ssavalue_assigned.at(cursor) = true;
@@ -8466,6 +8580,7 @@ static void init_jit_functions(void)
     for (auto it : builtin_func_map())
         add_named_global(it.second, it.first);
     add_named_global(jlapplygeneric_func, &jl_apply_generic);
+    add_named_global(jlapplygenericpic_func, &jl_apply_generic_pic);
     add_named_global(jlinvoke_func, &jl_invoke);
     add_named_global(jltopeval_func, &jl_toplevel_eval);
     add_named_global(jlcopyast_func, &jl_copy_ast);
@@ -8485,6 +8600,7 @@ static void init_jit_functions(void)
     add_named_global(jl_object_id__func, &jl_object_id_);
     add_named_global(jl_alloc_obj_func, (void*)NULL);
     add_named_global(jl_newbits_func, (void*)jl_new_bits);
+    add_named_global(jl_count_alloc_site_func, &jl_count_alloc_site);
     add_named_global(jl_loopinfo_marker_func, (void*)NULL);
     add_named_global(jl_typeof_func, (void*)NULL);
     add_named_global(jl_write_barrier_func, (void*)NULL);
@@ -8502,6 +8618,7 @@ static void init_jit_functions(void)
     add_named_global(except_enter_func, (void*)NULL);
     add_named_global(julia_call, (void*)NULL);
     add_named_global(julia_call2, (void*)NULL);
+    add_named_global(julia_call3, (void*)NULL);
 
 #ifdef _OS_WINDOWS_
 #if defined(_CPU_X86_64_)
@@ -8586,6 +8703,10 @@ extern "C" void jl_init_llvm(void)
 
     jl_ExecutionEngine = new JuliaOJIT();
 
+    const char *backedge_sp = getenv("JULIA_BACKEDGE_SAFEPOINTS");
+    if (backedge_sp && atoi(backedge_sp))
+        jl_backedge_safepoints = true;
+
     bool jl_using_gdb_jitevents = false;
     // Register GDB event listener
 #if defined(JL_DEBUG_BUILD)
@@ -55,7 +55,14 @@ JL_DLLEXPORT void jl_coverage_alloc_line(StringRef filename, int line)
 
 JL_DLLEXPORT uint64_t *jl_coverage_data_pointer(StringRef filename, int line)
 {
-    return allocLine(coverageData[filename], line);
+    // consecutive queries during emission are almost always for the same
+    // file, so remember the last entry to skip the StringMap probe
+    // (StringMap entries are stable across rehashing; this runs under the
+    // same codegen serialization as the map itself)
+    static logdata_t::MapEntryTy *last = NULL;
+    if (last == NULL || filename != last->getKey())
+        last = &*coverageData.try_emplace(filename).first;
+    return allocLine(last->getValue(), line);
 }
 
 extern "C" JL_DLLEXPORT void jl_coverage_visit_line(const char *filename_, size_t len_filename, int line)
@@ -63,8 +70,7 @@ extern "C" JL_DLLEXPORT void jl_coverage_visit_line(const char *filename_, size_
     StringRef filename = StringRef(filename_, len_filename);
     if (codegen_imaging_mode() || filename == "" || filename == "none" || filename == "no file" || filename == "<missing>" || line < 0)
         return;
-    std::vector<logdata_block*> &vec = coverageData[filename];
-    uint64_t *ptr = allocLine(vec, line);
+    uint64_t *ptr = jl_coverage_data_pointer(filename, line);
     (*ptr)++;
 }
 
@@ -74,7 +80,11 @@ static logdata_t mallocData;
 
 JL_DLLEXPORT uint64_t *jl_malloc_data_pointer(StringRef filename, int line)
 {
-    return allocLine(mallocData[filename], line);
+    // same last-file memo as jl_coverage_data_pointer above
+    static logdata_t::MapEntryTy *last = NULL;
+    if (last == NULL || filename != last->getKey())
+        last = &*mallocData.try_emplace(filename).first;
+    return allocLine(last->getValue(), line);
 }
 
 // Resets the malloc counts.
@@ -387,6 +387,22 @@ JL_DLLEXPORT uint32_t jl_crc32c(uint32_t crc, const char *buf, size_t len)
 #  endif
 #endif
 
+/* Report whether jl_crc32c resolves to a hardware implementation. Callers
+   choosing the checksum for a new file (dump.c's compressed sections) prefer
+   the fast 64-bit digest over the 15x-slower software table when the crc
+   instructions are missing; existing data always validates with whichever
+   algorithm wrote it. */
+JL_DLLEXPORT int jl_checksum_crc32c_hw(void)
+{
+#if defined(__SSE4_2__) || defined(__ARM_FEATURE_CRC32)
+    return 1;
+#elif defined(crc32c_dispatch)
+    return crc32c_dispatch() != jl_crc32c_sw;
+#else
+    return 0;
+#endif
+}
+
 /* Table-driven software version as a fall-back.  This is about 15 times slower
    than using the hardware instructions.  This computes a little-endian
    CRC32c, equivalent to the little-endian CRC of the SSE4.2 or ARMv8 instructions,
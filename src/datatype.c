@@ -158,6 +158,16 @@ static jl_datatype_layout_t *jl_get_layout(uint32_t nfields,
     flddesc->fielddesc_type = fielddesc_type;
     flddesc->npointers = npointers;
     flddesc->first_ptr = (npointers > 0 ? pointers[0] : -1);
+    // most struct shapes keep their pointers in consecutive words; tag those
+    // so the GC can scan them arithmetically without decoding the index list
+    int ptrs_run = npointers > 0;
+    for (uint32_t i = 1; i < npointers; i++) {
+        if (pointers[i] != pointers[0] + i) {
+            ptrs_run = 0;
+            break;
+        }
+    }
+    flddesc->ptrs_run = ptrs_run;
 
     // fill out the fields of the new descriptor
     jl_fielddesc8_t* desc8 = (jl_fielddesc8_t*)jl_dt_layout_fields(flddesc);
@@ -726,6 +736,7 @@ JL_DLLEXPORT jl_datatype_t * jl_new_foreign_type(jl_sym_t *name,
     layout->haspadding = 1;
     layout->npointers = haspointers;
     layout->fielddesc_type = 3;
+    layout->ptrs_run = 0;
     jl_fielddescdyn_t * desc =
       (jl_fielddescdyn_t *) ((char *)layout + sizeof(*layout));
     desc->markfunc = markfunc;
@@ -1128,6 +1139,29 @@ UNBOX_FUNC(float64, double)
 UNBOX_FUNC(voidpointer, void*)
 UNBOX_FUNC(uint8pointer, uint8_t*)
 
+// Thread-local memoization of recent boxes (see julia_threads.h): a box of a
+// bits value is immutable and `===`-identified by its bits, so returning an
+// earlier box for a repeated value is indistinguishable from allocating a
+// fresh one and skips the allocation entirely.
+STATIC_INLINE jl_value_t *jl_lookup_box_cache(jl_ptls_t ptls, jl_datatype_t *ty,
+                                              uint64_t bits, size_t *slot) JL_NOTSAFEPOINT
+{
+    size_t i = (size_t)(((bits ^ (uintptr_t)ty) * 0x9E3779B97F4A7C15ULL) >> 32) &
+               (JL_TLS_BOX_CACHE_SIZE - 1);
+    *slot = i;
+    if (ptls->box_cache_type[i] == (jl_value_t*)ty && ptls->box_cache_bits[i] == bits)
+        return ptls->box_cache[i];
+    return NULL;
+}
+
+STATIC_INLINE void jl_store_box_cache(jl_ptls_t ptls, size_t slot, jl_datatype_t *ty,
+                                      uint64_t bits, jl_value_t *v) JL_NOTSAFEPOINT
+{
+    ptls->box_cache[slot] = v;
+    ptls->box_cache_type[slot] = (jl_value_t*)ty;
+    ptls->box_cache_bits[slot] = bits;
+}
+
 #define BOX_FUNC(typ,c_type,pfx,nw)                                     \
     JL_DLLEXPORT jl_value_t *pfx##_##typ(c_type x)                      \
     {                                                                   \
@@ -1137,13 +1171,30 @@ UNBOX_FUNC(uint8pointer, uint8_t*)
         *(c_type*)jl_data_ptr(v) = x;                                   \
         return v;                                                       \
     }
-BOX_FUNC(float32, float,  jl_box, 1)
+#define BOX_CACHED_FUNC(typ,c_type,u_type,nw)                           \
+    JL_DLLEXPORT jl_value_t *jl_box_##typ(c_type x)                     \
+    {                                                                   \
+        jl_task_t *ct = jl_current_task;                                \
+        u_type u;                                                       \
+        memcpy(&u, &x, sizeof(u));                                      \
+        size_t slot;                                                    \
+        jl_value_t *v = jl_lookup_box_cache(ct->ptls, jl_##typ##_type,  \
+                                            (uint64_t)u, &slot);        \
+        if (v != NULL)                                                  \
+            return v;                                                   \
+        v = jl_gc_alloc(ct->ptls, nw * sizeof(void*),                   \
+                        jl_##typ##_type);                               \
+        *(c_type*)jl_data_ptr(v) = x;                                   \
+        jl_store_box_cache(ct->ptls, slot, jl_##typ##_type, (uint64_t)u, v); \
+        return v;                                                       \
+    }
+BOX_CACHED_FUNC(float32, float, uint32_t, 1)
 BOX_FUNC(voidpointer, void*,  jl_box, 1)
 BOX_FUNC(uint8pointer, uint8_t*,  jl_box, 1)
 #ifdef _P64
-BOX_FUNC(float64, double, jl_box, 1)
+BOX_CACHED_FUNC(float64, double, uint64_t, 1)
 #else
-BOX_FUNC(float64, double, jl_box, 2)
+BOX_CACHED_FUNC(float64, double, uint64_t, 2)
 #endif
 
 #define NBOX_C 1024
@@ -1156,9 +1207,16 @@ BOX_FUNC(float64, double, jl_box, 2)
         c_type idx = x+NBOX_C/2;                                        \
         if ((u##c_type)idx < (u##c_type)NBOX_C)                         \
             return boxed_##typ##_cache[idx];                            \
-        jl_value_t *v = jl_gc_alloc(ct->ptls, nw * sizeof(void*),       \
-                                    jl_##typ##_type);                   \
+        size_t slot;                                                    \
+        jl_value_t *v = jl_lookup_box_cache(ct->ptls, jl_##typ##_type,  \
+                                            (uint64_t)(u##c_type)x, &slot); \
+        if (v != NULL)                                                  \
+            return v;                                                   \
+        v = jl_gc_alloc(ct->ptls, nw * sizeof(void*),                   \
+                        jl_##typ##_type);                               \
         *(c_type*)jl_data_ptr(v) = x;                                   \
+        jl_store_box_cache(ct->ptls, slot, jl_##typ##_type,             \
+                           (uint64_t)(u##c_type)x, v);                  \
         return v;                                                       \
     }
 #define UIBOX_FUNC(typ,c_type,nw)                                       \
@@ -1168,9 +1226,15 @@ BOX_FUNC(float64, double, jl_box, 2)
         jl_task_t *ct = jl_current_task;                                \
         if (x < NBOX_C)                                                 \
             return boxed_##typ##_cache[x];                              \
-        jl_value_t *v = jl_gc_alloc(ct->ptls, nw * sizeof(void*),       \
-                                    jl_##typ##_type);                   \
+        size_t slot;                                                    \
+        jl_value_t *v = jl_lookup_box_cache(ct->ptls, jl_##typ##_type,  \
+                                            (uint64_t)x, &slot);        \
+        if (v != NULL)                                                  \
+            return v;                                                   \
+        v = jl_gc_alloc(ct->ptls, nw * sizeof(void*),                   \
+                        jl_##typ##_type);                               \
         *(c_type*)jl_data_ptr(v) = x;                                   \
+        jl_store_box_cache(ct->ptls, slot, jl_##typ##_type, (uint64_t)x, v); \
         return v;                                                       \
     }
 SIBOX_FUNC(int16,  int16_t, 1)
@@ -1289,7 +1353,28 @@ JL_DLLEXPORT jl_value_t *jl_new_structv(jl_datatype_t *type, jl_value_t **args,
     }
     if (type->instance != NULL)
         return type->instance;
-    jl_value_t *jv = jl_gc_alloc(ct->ptls, jl_datatype_size(type), type);
+    size_t size = jl_datatype_size(type);
+    if (type->isbitstype && !type->layout->haspadding && na == nf &&
+        size <= sizeof(uint64_t)) {
+        // assemble the bits on the stack and memoize the result like the
+        // primitive box caches above: every field of an isbits struct with no
+        // padding is itself plain bits, so the argument boxes can be copied
+        // straight into place and a cache hit skips the allocation that a
+        // dynamically-dispatched constructor call would otherwise pay
+        uint64_t bits = 0;
+        for (size_t i = 0; i < na; i++)
+            memcpy((char*)&bits + jl_field_offset(type, i),
+                   jl_data_ptr(args[i]), jl_field_size(type, i));
+        size_t slot;
+        jl_value_t *v = jl_lookup_box_cache(ct->ptls, type, bits, &slot);
+        if (v != NULL)
+            return v;
+        v = jl_gc_alloc(ct->ptls, size, type);
+        memcpy(jl_data_ptr(v), &bits, size);
+        jl_store_box_cache(ct->ptls, slot, type, bits, v);
+        return v;
+    }
+    jl_value_t *jv = jl_gc_alloc(ct->ptls, size, type);
     if (jl_datatype_nfields(type) > 0) {
         if (jl_field_offset(type, 0) != 0) {
             memset(jl_data_ptr(jv), 0, jl_field_offset(type, 0));
@@ -1330,6 +1415,45 @@ JL_DLLEXPORT jl_value_t *jl_new_structt(jl_datatype_t *type, jl_value_t *tup)
         return type->instance;
     }
     size_t size = jl_datatype_size(type);
+    jl_datatype_t *tupt = (jl_datatype_t*)jl_typeof(tup);
+    if (type->isbitstype && tupt->isbitstype && nargs == nf) {
+        // when the tuple's field types match exactly, the fields can be
+        // copied from the tuple's inline data without materializing a box
+        // per field through jl_get_nth_field
+        int exact = 1;
+        for (size_t i = 0; i < nf; i++) {
+            if (jl_field_type_concrete(type, i) != jl_field_type_concrete(tupt, i)) {
+                exact = 0;
+                break;
+            }
+        }
+        if (exact) {
+            char *src = (char*)jl_data_ptr(tup);
+            if (!type->layout->haspadding && size <= sizeof(uint64_t)) {
+                // small enough for the thread-local box memoization above
+                uint64_t bits = 0;
+                for (size_t i = 0; i < nf; i++)
+                    memcpy((char*)&bits + jl_field_offset(type, i),
+                           src + jl_field_offset(tupt, i), jl_field_size(type, i));
+                size_t slot;
+                jl_value_t *v = jl_lookup_box_cache(ct->ptls, type, bits, &slot);
+                if (v != NULL)
+                    return v;
+                v = jl_gc_alloc(ct->ptls, size, type);
+                memcpy(jl_data_ptr(v), &bits, size);
+                jl_store_box_cache(ct->ptls, slot, type, bits, v);
+                return v;
+            }
+            jl_value_t *v = jl_gc_alloc(ct->ptls, size, type);
+            char *dst = (char*)jl_data_ptr(v);
+            if (type->zeroinit)
+                memset(dst, 0, size);
+            for (size_t i = 0; i < nf; i++)
+                memcpy(dst + jl_field_offset(type, i),
+                       src + jl_field_offset(tupt, i), jl_field_size(type, i));
+            return v;
+        }
+    }
     jl_value_t *jv = jl_gc_alloc(ct->ptls, size, type);
     if (nf == 0)
         return jv;
@@ -1532,7 +1656,88 @@ void set_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *rhs,
     }
 }
 
-jl_value_t *swap_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *rhs, int isatomic)
+// Specialized constructor for tuples of runtime values: `type` must be the
+// result of jl_inst_arg_tuple_type on the same arguments, so that each field
+// type is exactly jl_typeof(args[i]).  That makes the isa checks, union
+// selectors and atomic orderings of set_nth_field statically dead, and lets
+// us dispatch on the fielddesc width once instead of per field.
+jl_value_t *jl_new_tuplev(jl_datatype_t *type, jl_value_t **args, size_t nargs)
+{
+    assert(jl_is_tuple_type(type) && jl_datatype_nfields(type) == nargs);
+    assert(type->instance == NULL);
+    jl_task_t *ct = jl_current_task;
+    jl_value_t *jv = jl_gc_alloc(ct->ptls, jl_datatype_size(type), type);
+    const jl_datatype_layout_t *layout = type->layout;
+#define TUPLE_FILL_LOOP(fielddesc_t)                                           \
+    do {                                                                       \
+        const fielddesc_t *desc = (const fielddesc_t*)jl_dt_layout_fields(layout); \
+        for (size_t i = 0; i < nargs; i++) {                                   \
+            char *fo = (char*)jv + desc[i].offset;                             \
+            jl_value_t *vi = args[i];                                          \
+            assert(jl_typeof(vi) == jl_field_type_concrete(type, i));          \
+            if (desc[i].isptr) {                                               \
+                *(jl_value_t**)fo = vi;                                        \
+                jl_gc_wb(jv, vi);                                              \
+            }                                                                  \
+            else if (desc[i].size > 0) { /* skip singleton fields */           \
+                int hasptr = ((jl_datatype_t*)jl_typeof(vi))->layout->npointers > 0; \
+                memassign_safe(hasptr, jv, fo, vi, desc[i].size);              \
+            }                                                                  \
+        }                                                                      \
+    } while (0)
+    if (layout->fielddesc_type == 0) {
+        TUPLE_FILL_LOOP(jl_fielddesc8_t);
+    }
+    else if (layout->fielddesc_type == 1) {
+        TUPLE_FILL_LOOP(jl_fielddesc16_t);
+    }
+    else {
+        assert(layout->fielddesc_type == 2);
+        TUPLE_FILL_LOOP(jl_fielddesc32_t);
+    }
+#undef TUPLE_FILL_LOOP
+    return jv;
+}
+
+#ifdef __clang_gcanalyzer__
+// the analyzer's non-atomic _Atomic(T) stand-ins cannot express the
+// explicit-order operations; substitute the modeled seq_cst macros
+#define atomic_exchange_explicit(p, v, order) jl_atomic_exchange(p, v)
+#define atomic_compare_exchange_strong_explicit(p, e, v, so, fo) jl_atomic_cmpswap(p, e, v)
+#endif
+
+// map a Julia memory order to the C11 order for an explicit atomic op;
+// callers have already rejected notatomic/invalid orders
+static memory_order memory_order_from_jl(enum jl_memory_order order) JL_NOTSAFEPOINT
+{
+    switch (order) {
+    case jl_memory_order_unordered:
+    case jl_memory_order_monotonic:
+        return memory_order_relaxed;
+    case jl_memory_order_consume:
+    case jl_memory_order_acquire:
+        return memory_order_acquire;
+    case jl_memory_order_release:
+        return memory_order_release;
+    case jl_memory_order_acq_rel:
+        return memory_order_acq_rel;
+    default:
+        return memory_order_seq_cst;
+    }
+}
+
+// the failure order of a cmpswap may not be release or stronger than the
+// success order; derive the strongest valid one from the success order
+static memory_order memory_order_cmpswap_failure(memory_order succ) JL_NOTSAFEPOINT
+{
+    if (succ == memory_order_release)
+        return memory_order_relaxed;
+    if (succ == memory_order_acq_rel)
+        return memory_order_acquire;
+    return succ;
+}
+
+jl_value_t *swap_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *rhs, int isatomic, enum jl_memory_order order)
 {
     jl_value_t *ty = jl_field_type_concrete(st, i);
     if (!jl_isa(rhs, ty))
@@ -1541,7 +1746,8 @@ jl_value_t *swap_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_
     jl_value_t *r;
     if (jl_field_isptr(st, i)) {
         if (isatomic)
-            r = jl_atomic_exchange((_Atomic(jl_value_t*)*)((char*)v + offs), rhs);
+            r = atomic_exchange_explicit((_Atomic(jl_value_t*)*)((char*)v + offs), rhs,
+                                         memory_order_from_jl(order));
         else
             r = jl_atomic_exchange_relaxed((_Atomic(jl_value_t*)*)((char*)v + offs), rhs);
         jl_gc_wb(v, rhs);
@@ -1569,6 +1775,9 @@ jl_value_t *swap_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_
         size_t fsz = jl_datatype_size((jl_datatype_t*)rty); // need to shrink-wrap the final copy
         int needlock = (isatomic && fsz > MAX_ATOMIC_SIZE);
         if (isatomic && !needlock) {
+            // seq_cst, deliberately: stronger than any requested order, and
+            // the unboxed explicit-order fast path for inline fields is
+            // emitted directly by codegen when the types are known
             r = jl_atomic_swap_bits(rty, (char*)v + offs, rhs, fsz);
             if (hasptr)
                 jl_gc_multi_wb(v, rhs); // rhs is immutable
@@ -1596,12 +1805,12 @@ jl_value_t *swap_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_
     return r;
 }
 
-jl_value_t *modify_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *op, jl_value_t *rhs, int isatomic)
+jl_value_t *modify_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *op, jl_value_t *rhs, int isatomic, enum jl_memory_order order)
 {
     size_t offs = jl_field_offset(st, i);
     jl_value_t *ty = jl_field_type_concrete(st, i);
     jl_value_t *r = jl_get_nth_field_checked(v, i);
-    if (isatomic && jl_field_isptr(st, i))
+    if (isatomic && jl_field_isptr(st, i) && order >= jl_memory_order_acquire)
         jl_fence(); // load was previously only relaxed
     jl_value_t **args;
     JL_GC_PUSHARGS(args, 2);
@@ -1614,8 +1823,15 @@ jl_value_t *modify_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_valu
             jl_type_error("modifyfield!", ty, y);
         if (jl_field_isptr(st, i)) {
             _Atomic(jl_value_t*) *p = (_Atomic(jl_value_t*)*)((char*)v + offs);
-            if (isatomic ? jl_atomic_cmpswap(p, &r, y) : jl_atomic_cmpswap_relaxed(p, &r, y))
+            if (isatomic) {
+                memory_order succ = memory_order_from_jl(order);
+                if (atomic_compare_exchange_strong_explicit(p, &r, y, succ,
+                        memory_order_cmpswap_failure(succ)))
+                    break;
+            }
+            else if (jl_atomic_cmpswap_relaxed(p, &r, y)) {
                 break;
+            }
         }
         else {
             jl_value_t *yty = jl_typeof(y);
@@ -1682,7 +1898,7 @@ jl_value_t *modify_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_valu
     return args[0];
 }
 
-jl_value_t *replace_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *expected, jl_value_t *rhs, int isatomic)
+jl_value_t *replace_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *expected, jl_value_t *rhs, int isatomic, enum jl_memory_order success_order, enum jl_memory_order failure_order)
 {
     jl_value_t *ty = jl_field_type_concrete(st, i);
     if (!jl_isa(rhs, ty))
@@ -1695,7 +1911,16 @@ jl_value_t *replace_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_val
         _Atomic(jl_value_t*) *p = (_Atomic(jl_value_t*)*)((char*)v + offs);
         int success;
         while (1) {
-            success = isatomic ? jl_atomic_cmpswap(p, &r, rhs) : jl_atomic_cmpswap_relaxed(p, &r, rhs);
+            if (isatomic) {
+                memory_order succ = memory_order_from_jl(success_order);
+                memory_order fail = memory_order_from_jl(failure_order);
+                if (fail == memory_order_release || fail == memory_order_acq_rel)
+                    fail = memory_order_cmpswap_failure(succ);
+                success = atomic_compare_exchange_strong_explicit(p, &r, rhs, succ, fail);
+            }
+            else {
+                success = jl_atomic_cmpswap_relaxed(p, &r, rhs);
+            }
             if (success)
                 jl_gc_wb(v, rhs);
             if (__unlikely(r == NULL))
@@ -7,7 +7,9 @@
 
 #include <map>
 #include <mutex>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 typedef struct {
     const llvm::object::ObjectFile *obj;
@@ -15,6 +17,14 @@ typedef struct {
     int64_t slide;
 } objfileentry_t;
 
+// one decoded (possibly inlined) source-level frame from a DWARF line-table query
+typedef struct {
+    std::string func_name;
+    std::string file_name;
+    int line;
+} decoded_frame_t;
+typedef std::vector<decoded_frame_t> decoded_frames_t;
+
 // Central registry for resolving function addresses to `jl_method_instance_t`s and
 // originating `ObjectFile`s (for the DWARF debug info).
 //
@@ -112,6 +122,8 @@ private:
 
     typedef rev_map<size_t, ObjectInfo> objectmap_t;
     typedef rev_map<uint64_t, objfileentry_t> objfilemap_t;
+    // memoized lookup_pointer decodes, keyed by (address, flag bits)
+    typedef std::map<std::pair<size_t, int>, decoded_frames_t> frame_decode_cache_t;
 
     objectmap_t objectmap{};
     rev_map<size_t, std::pair<size_t, jl_method_instance_t *>> linfomap{};
@@ -125,6 +137,8 @@ private:
 
     Locked<objfilemap_t> objfilemap{};
 
+    Locked<frame_decode_cache_t> frame_decode_cache{};
+
     static std::string mangle(llvm::StringRef Name, const llvm::DataLayout &DL) JL_NOTSAFEPOINT;
 
 public:
@@ -143,4 +157,5 @@ public:
     void set_sysimg_info(sysimg_info_t info) JL_NOTSAFEPOINT;
     Locked<sysimg_info_t>::ConstLockT get_sysimg_info() const JL_NOTSAFEPOINT;
     Locked<objfilemap_t>::LockT get_objfile_map() JL_NOTSAFEPOINT;
+    Locked<frame_decode_cache_t>::LockT get_frame_decode_cache() JL_NOTSAFEPOINT;
 };
@@ -27,6 +27,10 @@ using namespace llvm;
 #include "debuginfo.h"
 #if defined(_OS_LINUX_)
 #  include <link.h>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
 #endif
 #include "processor.h"
 
@@ -125,6 +129,11 @@ JITDebugInfoRegistry::get_objfile_map() JL_NOTSAFEPOINT {
     return *this->objfilemap;
 }
 
+JITDebugInfoRegistry::Locked<JITDebugInfoRegistry::frame_decode_cache_t>::LockT
+JITDebugInfoRegistry::get_frame_decode_cache() JL_NOTSAFEPOINT {
+    return *this->frame_decode_cache;
+}
+
 JITDebugInfoRegistry::JITDebugInfoRegistry() JL_NOTSAFEPOINT { }
 
 struct unw_table_entry
@@ -215,6 +224,125 @@ static void create_PRUNTIME_FUNCTION(uint8_t *Code, size_t Size, StringRef fnnam
 }
 #endif
 
+#if defined(_OS_LINUX_)
+// --- perf(1) integration ---------------------------------------------------
+// JULIA_PERF_MAP=1 streams a line per registered function into
+// /tmp/perf-<pid>.map, which `perf top` and `perf report` read live to
+// attribute samples to jitted frames. JULIA_JITDUMP=1 additionally writes
+// /tmp/jit-<pid>.dump in the jitdump format; `perf inject --jit` turns that
+// into annotatable ELF images with the machine code embedded. Both are
+// append-only streams written from the symbol loop in registerJITObject;
+// when the variables are unset the cost is a single pointer check.
+
+static std::mutex perf_stream_lock;
+static FILE *perf_map_stream;
+static FILE *jitdump_stream;
+static uint64_t jitdump_code_index;
+
+static uint64_t perf_timestamp(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void perf_streams_init(void)
+{
+    char path[64];
+    const char *e = getenv("JULIA_PERF_MAP");
+    if (e && atoi(e)) {
+        snprintf(path, sizeof(path), "/tmp/perf-%d.map", (int)getpid());
+        perf_map_stream = fopen(path, "a");
+    }
+    e = getenv("JULIA_JITDUMP");
+    if (e && atoi(e)) {
+        snprintf(path, sizeof(path), "/tmp/jit-%d.dump", (int)getpid());
+        int fd = open(path, O_CREAT | O_TRUNC | O_RDWR, 0666);
+        if (fd != -1) {
+            // perf locates the jitdump stream through an executable mapping
+            // of its first page recorded in the mmap events; leak it
+            void *marker = mmap(NULL, jl_page_size, PROT_READ | PROT_EXEC,
+                                MAP_PRIVATE, fd, 0);
+            jitdump_stream = fdopen(fd, "w");
+            if (marker == MAP_FAILED || !jitdump_stream) {
+                if (jitdump_stream) {
+                    fclose(jitdump_stream);
+                    jitdump_stream = NULL;
+                }
+                else {
+                    close(fd);
+                }
+            }
+            else {
+                struct {
+                    uint32_t magic, version, total_size, elf_mach;
+                    uint32_t pad1, pid;
+                    uint64_t timestamp, flags;
+                } header;
+                header.magic = 0x4A695444; // "JiTD"
+                header.version = 1;
+                header.total_size = sizeof(header);
+#if defined(_CPU_X86_64_)
+                header.elf_mach = 62;  // EM_X86_64
+#elif defined(_CPU_AARCH64_)
+                header.elf_mach = 183; // EM_AARCH64
+#elif defined(_CPU_ARM_)
+                header.elf_mach = 40;  // EM_ARM
+#elif defined(_CPU_X86_)
+                header.elf_mach = 3;   // EM_386
+#else
+                header.elf_mach = 0;
+#endif
+                header.pad1 = 0;
+                header.pid = (uint32_t)getpid();
+                header.timestamp = perf_timestamp();
+                header.flags = 0;
+                fwrite(&header, sizeof(header), 1, jitdump_stream);
+                fflush(jitdump_stream);
+            }
+        }
+    }
+}
+
+static void perf_record_code(uint64_t addr, size_t size, StringRef name)
+{
+    static std::once_flag once;
+    std::call_once(once, perf_streams_init);
+    if (__likely(!perf_map_stream && !jitdump_stream))
+        return;
+    std::lock_guard<std::mutex> guard(perf_stream_lock);
+    if (perf_map_stream) {
+        fprintf(perf_map_stream, "%" PRIx64 " %zx %.*s\n", addr, size,
+                (int)name.size(), name.data());
+        fflush(perf_map_stream);
+    }
+    if (jitdump_stream) {
+        struct {
+            uint32_t id, total_size;
+            uint64_t timestamp;
+            uint32_t pid, tid;
+            uint64_t vma, code_addr, code_size, code_index;
+        } rec;
+        rec.id = 0; // JIT_CODE_LOAD
+        rec.total_size = (uint32_t)(sizeof(rec) + name.size() + 1 + size);
+        rec.timestamp = perf_timestamp();
+        rec.pid = (uint32_t)getpid();
+        rec.tid = (uint32_t)syscall(SYS_gettid);
+        rec.vma = addr;
+        rec.code_addr = addr;
+        rec.code_size = size;
+        rec.code_index = jitdump_code_index++;
+        fwrite(&rec, sizeof(rec), 1, jitdump_stream);
+        fwrite(name.data(), 1, name.size(), jitdump_stream);
+        fputc('\0', jitdump_stream);
+        // executable pages are mapped readable, so the code can be copied
+        // straight out of the running image
+        fwrite((const void*)(uintptr_t)addr, 1, size, jitdump_stream);
+        fflush(jitdump_stream);
+    }
+}
+#endif
+
 void JITDebugInfoRegistry::registerJITObject(const object::ObjectFile &Object,
                         std::function<uint64_t(const StringRef &)> getLoadAddress,
                         std::function<void*(void*)> lookupWriteAddress)
@@ -346,6 +474,10 @@ void JITDebugInfoRegistry::registerJITObject(const object::ObjectFile &Object,
         StringRef sName = cantFail(sym_iter.getName());
         uint64_t SectionSize = Section->getSize();
         size_t Size = sym_size.second;
+#if defined(_OS_LINUX_)
+        if (Size)
+            perf_record_code(Addr, Size, sName);
+#endif
 #if defined(_OS_WINDOWS_)
         if (SectionAddrCheck)
             assert(SectionAddrCheck == SectionAddr &&
@@ -451,24 +583,67 @@ static int lookup_pointer(
         }
         return 1;
     }
-    DILineInfoSpecifier infoSpec(DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath,
-                                 DILineInfoSpecifier::FunctionNameKind::ShortName);
+    int fromC = (*frames)[0].fromC;
 
-    // DWARFContext/DWARFUnit update some internal tables during these queries, so
-    // a lock is needed.
-    assert(0 == jl_lock_profile_rd_held());
-    jl_lock_profile_wr();
-    auto inlineInfo = context->getInliningInfoForAddress(makeAddress(Section, pointer + slide), infoSpec);
-    jl_unlock_profile_wr();
+    // The DWARF line-table walk below is by far the most expensive part of
+    // symbolization and its result for a given address never changes (JIT
+    // objects and loaded images are not unloaded), so memoize the decoded
+    // frame stacks.  Repeat symbolization of a hot profile PC then costs one
+    // map probe instead of a DWARF query.  The decode depends on the caller's
+    // fromC flag (inline-name trimming) and on noInline, so both are part of
+    // the key.  An empty entry records "no line info available".
+    std::pair<size_t, int> key(pointer, (fromC << 1) | (noInline ? 1 : 0));
+    decoded_frames_t decoded;
+    bool cached = false;
+    {
+        auto cache = getJITDebugRegistry().get_frame_decode_cache();
+        auto it = cache->find(key);
+        if (it != cache->end()) {
+            decoded = it->second;
+            cached = true;
+        }
+    }
+    if (!cached) {
+        DILineInfoSpecifier infoSpec(DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath,
+                                     DILineInfoSpecifier::FunctionNameKind::ShortName);
+
+        // DWARFContext/DWARFUnit update some internal tables during these queries, so
+        // a lock is needed.
+        assert(0 == jl_lock_profile_rd_held());
+        jl_lock_profile_wr();
+        auto inlineInfo = context->getInliningInfoForAddress(makeAddress(Section, pointer + slide), infoSpec);
+        jl_unlock_profile_wr();
+
+        int n_frames = inlineInfo.getNumberOfFrames();
+        if (noInline && n_frames > 1)
+            n_frames = 1;
+        for (int i = 0; i < n_frames; i++) {
+            DILineInfo info;
+            if (!noInline) {
+                info = inlineInfo.getFrame(i);
+            }
+            else {
+                jl_lock_profile_wr();
+                info = context->getLineInfoForAddress(makeAddress(Section, pointer + slide), infoSpec);
+                jl_unlock_profile_wr();
+            }
+            std::string func_name(info.FunctionName);
+            if (i != n_frames - 1 && !fromC) {
+                std::size_t semi_pos = func_name.find(';');
+                if (semi_pos != std::string::npos)
+                    func_name = func_name.substr(0, semi_pos);
+            }
+            decoded.push_back({std::move(func_name), std::string(info.FileName), (int)info.Line});
+        }
+        auto cache = getJITDebugRegistry().get_frame_decode_cache();
+        cache->emplace(key, decoded);
+    }
 
-    int fromC = (*frames)[0].fromC;
-    int n_frames = inlineInfo.getNumberOfFrames();
+    int n_frames = (int)decoded.size();
     if (n_frames == 0) {
         // no line number info available in the context, return without the context
         return lookup_pointer(object::SectionRef(), NULL, frames, pointer, slide, demangle, noInline);
     }
-    if (noInline)
-        n_frames = 1;
     if (n_frames > 1) {
         jl_frame_t *new_frames = (jl_frame_t*)calloc(sizeof(jl_frame_t), n_frames);
         memcpy(&new_frames[n_frames - 1], *frames, sizeof(jl_frame_t));
@@ -477,45 +652,27 @@ static int lookup_pointer(
     }
     for (int i = 0; i < n_frames; i++) {
         bool inlined_frame = i != n_frames - 1;
-        DILineInfo info;
-        if (!noInline) {
-            info = inlineInfo.getFrame(i);
-        }
-        else {
-            jl_lock_profile_wr();
-            info = context->getLineInfoForAddress(makeAddress(Section, pointer + slide), infoSpec);
-            jl_unlock_profile_wr();
-        }
+        const decoded_frame_t &info = decoded[i];
 
         jl_frame_t *frame = &(*frames)[i];
-        std::string func_name(info.FunctionName);
-
         if (inlined_frame) {
             frame->inlined = 1;
             frame->fromC = fromC;
-            if (!fromC) {
-                std::size_t semi_pos = func_name.find(';');
-                if (semi_pos != std::string::npos) {
-                    func_name = func_name.substr(0, semi_pos);
-                    frame->linfo = NULL; // TODO: if (new_frames[n_frames - 1].linfo) frame->linfo = lookup(func_name in linfo)?
-                }
-            }
         }
 
-        if (func_name == "<invalid>")
+        if (info.func_name == "<invalid>")
             frame->func_name = NULL;
         else
-            jl_copy_str(&frame->func_name, func_name.c_str());
+            jl_copy_str(&frame->func_name, info.func_name.c_str());
         if (!frame->func_name)
             frame->fromC = 1;
 
-        frame->line = info.Line;
-        std::string file_name(info.FileName);
+        frame->line = info.line;
 
-        if (file_name == "<invalid>")
+        if (info.file_name == "<invalid>")
             frame->file_name = NULL;
         else
-            jl_copy_str(&frame->file_name, file_name.c_str());
+            jl_copy_str(&frame->file_name, info.file_name.c_str());
     }
     return n_frames;
 }
@@ -1171,25 +1328,40 @@ int jl_DI_for_fptr(uint64_t fptr, uint64_t *symsize, int64_t *slide,
         object::SectionRef *Section, llvm::DIContext **context) JL_NOTSAFEPOINT
 {
     int found = 0;
-    assert(0 == jl_lock_profile_rd_held());
-    jl_lock_profile_wr();
+    llvm::DIContext *ctx = nullptr;
 
     if (symsize)
         *symsize = 0;
 
+    // Take only the shared (read) lock for the map probe so concurrent
+    // lookups don't serialize against each other or against unrelated
+    // profiler activity; the write lock is needed just for the one-time lazy
+    // construction of the DWARF context, which mutates the map entry.
+    assert(0 == jl_lock_profile_rd_held());
+    jl_lock_profile();
     auto &objmap = getJITDebugRegistry().getObjectMap();
     auto fit = objmap.lower_bound(fptr);
     if (fit != objmap.end() && fptr < fit->first + fit->second.SectionSize) {
         *slide = fit->second.slide;
         *Section = fit->second.Section;
-        if (context) {
+        ctx = fit->second.context;
+        found = 1;
+    }
+    jl_unlock_profile();
+    if (found && context) {
+        if (ctx == nullptr) {
+            jl_lock_profile_wr();
+            // re-find under the write lock; entries are never erased, so the
+            // key is still present even if registration grew the map
+            fit = objmap.lower_bound(fptr);
+            assert(fit != objmap.end() && fptr < fit->first + fit->second.SectionSize);
             if (fit->second.context == nullptr)
                 fit->second.context = DWARFContext::create(*fit->second.object).release();
-            *context = fit->second.context;
+            ctx = fit->second.context;
+            jl_unlock_profile_wr();
         }
-        found = 1;
+        *context = ctx;
     }
-    jl_unlock_profile_wr();
     return found;
 }
 
@@ -237,17 +237,29 @@ JL_DLLEXPORT void *jl_load_dynamic_library(const char *modname, unsigned flags,
 
 #ifdef _OS_WINDOWS_
                     if (i == 0) { // LoadLibrary already tested the extensions, we just need to check the `stat` result
-#endif
                         handle = jl_dlopen(path, flags);
                         if (handle)
                             goto done;
-#ifdef _OS_WINDOWS_
                         err = GetLastError();
                     }
-#endif
                     // bail out and show the error if file actually exists
                     if (jl_stat(path, (char*)&stbuf) == 0)
                         goto notfound;
+#else
+                    // Check the `stat` result before handing the candidate to
+                    // dlopen: the joined path always contains a separator, so
+                    // dlopen would do no further search and can only succeed
+                    // when the file exists.  This keeps the DL_LOAD_PATH x
+                    // extensions cross-product from taking the loader lock
+                    // once per missing candidate during startup.
+                    if (jl_stat(path, (char*)&stbuf) != 0)
+                        continue;
+                    handle = jl_dlopen(path, flags);
+                    if (handle)
+                        goto done;
+                    // the file exists but loading failed: bail out and show the error
+                    goto notfound;
+#endif
                 }
             }
         }
@@ -14,6 +14,10 @@
 
 #ifndef _OS_WINDOWS_
 #include <dlfcn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 #include "valgrind.h"
@@ -126,6 +130,10 @@ static jl_value_t *deser_symbols[256];
 // left shift by 1
 static htable_t backref_table;    // pos = backref_table[obj]
 static int backref_table_numel;
+// content-addressed companion to backref_table: maps egal immutables to the
+// encoded backref pos of their first serialized occurrence (NULL when dedup
+// is off; only live while the serializer runs, with the GC disabled)
+static jl_array_t *serialize_dedup_table = NULL;
 static arraylist_t backref_list;  // obj = backref_list[pos]
 
 // set of all CodeInstances yet to be (in)validated
@@ -181,8 +189,16 @@ typedef struct {
     ios_t *s;
     jl_ptls_t ptls;
     jl_array_t *loaded_modules_array;
+    // when non-NULL, compressed method IR is diverted here instead of being
+    // serialized inline, and restore maps the section so that `m->source`
+    // becomes a demand-paged view into the cache file
+    ios_t *srcblobs;
 } jl_serializer_state;
 
+// (method, offset, len) triples for sources diverted to the blob section,
+// patched once the section position is known
+static arraylist_t lazy_source_list;
+
 static jl_value_t *jl_idtable_type = NULL;
 static jl_typename_t *jl_idtable_typename = NULL;
 static jl_value_t *jl_bigint_type = NULL;
@@ -554,7 +570,7 @@ static void jl_serialize_module(jl_serializer_state *s, jl_module_t *m)
             jl_serialize_value(s, jl_atomic_load_relaxed(&b->globalref));
             jl_serialize_value(s, b->owner);
             jl_serialize_value(s, jl_atomic_load_relaxed(&b->ty));
-            write_int8(s->s, (b->deprecated<<3) | (b->constp<<2) | (b->exportp<<1) | (b->imported));
+            write_int8(s->s, (b->reassigned<<5) | (b->deprecated<<3) | (b->constp<<2) | (b->exportp<<1) | (b->imported));
         }
     }
     jl_serialize_value(s, NULL);
@@ -625,6 +641,28 @@ static int jl_serialize_generic(jl_serializer_state *s, jl_value_t *v) JL_GC_DIS
             }
             return 1;
         }
+        // content-addressed dedup: `===` is egal, so an egal repeat of an
+        // immutable value is indistinguishable from its first occurrence and
+        // can collapse onto it. Interned types already hit the pointer check
+        // above; this catches strings and the parameter svecs of type trees
+        // that dependencies rebuilt independently.
+        int dedup = serialize_dedup_table != NULL &&
+                    (jl_is_string(v) || jl_is_svec(v));
+        if (dedup) {
+            jl_value_t *first = jl_eqtable_get(serialize_dedup_table, v, NULL);
+            if (first != NULL) {
+                uintptr_t pos = jl_unbox_long(first);
+                if (pos < 65536) {
+                    write_uint8(s->s, TAG_SHORT_BACKREF);
+                    write_uint16(s->s, pos);
+                }
+                else {
+                    write_uint8(s->s, TAG_BACKREF);
+                    write_int32(s->s, pos);
+                }
+                return 1;
+            }
+        }
         intptr_t pos = backref_table_numel++;
         if (((jl_datatype_t*)(jl_typeof(v)))->name == jl_idtable_typename) {
             // will need to rehash this, later (after types are fully constructed)
@@ -646,6 +684,9 @@ static int jl_serialize_generic(jl_serializer_state *s, jl_value_t *v) JL_GC_DIS
         }
         pos <<= 1;
         ptrhash_put(&backref_table, v, (char*)HT_NOTFOUND + pos + 1);
+        if (dedup)
+            serialize_dedup_table = jl_eqtable_put(serialize_dedup_table, v,
+                                                   jl_box_long(pos), NULL);
     }
 
     return 0;
@@ -910,7 +951,18 @@ static void jl_serialize_value_(jl_serializer_state *s, jl_value_t *v, int as_li
         jl_serialize_value(s, (jl_value_t*)m->root_blocks);
         write_int32(s->s, m->nroots_sysimg);
         jl_serialize_value(s, (jl_value_t*)m->ccallable);
-        jl_serialize_value(s, (jl_value_t*)m->source);
+        if (s->srcblobs && m->source && jl_typeis(m->source, jl_array_uint8_type)) {
+            // compressed IR: divert the raw bytes to the trailing blob
+            // section so restore does not have to materialize them eagerly
+            write_uint8(s->s, 1);
+            write_uint64(s->s, (uint64_t)ios_pos(s->srcblobs));
+            write_uint64(s->s, (uint64_t)jl_array_len(m->source));
+            ios_write(s->srcblobs, (const char*)jl_array_data(m->source), jl_array_len(m->source));
+        }
+        else {
+            write_uint8(s->s, 0);
+            jl_serialize_value(s, (jl_value_t*)m->source);
+        }
         jl_serialize_value(s, (jl_value_t*)m->unspecialized);
         jl_serialize_value(s, (jl_value_t*)m->generator);
         jl_serialize_value(s, (jl_value_t*)m->invokes);
@@ -1385,7 +1437,7 @@ static void write_mod_list(ios_t *s, jl_array_t *a)
 }
 
 // "magic" string and version header of .ji file
-static const int JI_FORMAT_VERSION = 11;
+static const int JI_FORMAT_VERSION = 13;
 static const char JI_MAGIC[] = "\373jli\r\n\032\n"; // based on PNG signature
 static const uint16_t BOM = 0xFEFF; // byte-order marker
 static void write_header(ios_t *s)
@@ -1402,6 +1454,179 @@ static void write_header(ios_t *s)
     ios_write(s, commit, strlen(commit)+1);
 }
 
+// The serialized module data is stored compressed, as a sequence of chunks
+// that are compressed independently so they can be processed in parallel:
+//   uint64  total uncompressed size
+//   int32   chunk size
+//   int32   number of chunks
+//   uint8   checksum kind (see JI_CHECKSUM_*)
+// then for each chunk:
+//   uint8   codec (0 = stored uncompressed, 1 = LZ4 block)
+//   int32   stored payload size
+//   uint32  checksum of the stored payload
+//   payload bytes
+// Incompressible chunks are stored raw. The checksum covers the bytes as they
+// appear in the file, so corruption is detected before decompression. The
+// writer picks hardware crc32c when the machine has it and the fast 64-bit
+// digest (folded to 32 bits) otherwise — the software crc table is ~15x
+// slower than either; the reader validates with whichever kind was recorded.
+#define JI_CHUNK_SIZE (1 << 20)
+#define JI_MAX_COMPRESS_THREADS 8
+#define JI_CHECKSUM_CRC32C 0
+#define JI_CHECKSUM_FAST64 1
+
+static uint32_t ji_chunk_checksum(uint8_t kind, const char *buf, size_t len)
+{
+    if (kind == JI_CHECKSUM_FAST64) {
+        uint64_t h = jl_checksum_fast64(buf, len, 0);
+        return (uint32_t)(h ^ (h >> 32));
+    }
+    return jl_crc32c(0, buf, len);
+}
+
+typedef struct {
+    const char *src;    // the whole uncompressed section
+    size_t total;
+    size_t c0, c1;      // the range of chunk indexes owned by this worker
+    char **bufs;        // per-chunk compressed output (NULL means store raw)
+    size_t *lens;       // per-chunk stored payload size
+    uint32_t *crcs;
+    uint8_t ckind;
+} jl_compress_job_t;
+
+static void jl_compress_chunks(void *argp)
+{
+    jl_compress_job_t *job = (jl_compress_job_t*)argp;
+    size_t i;
+    for (i = job->c0; i < job->c1; i++) {
+        size_t off = i * (size_t)JI_CHUNK_SIZE;
+        size_t len = job->total - off < JI_CHUNK_SIZE ? job->total - off : JI_CHUNK_SIZE;
+        size_t bound = jl_lz4_compress_bound(len);
+        char *buf = (char*)malloc_s(bound);
+        size_t clen = jl_lz4_compress(job->src + off, len, buf, bound);
+        if (clen == 0 || clen >= len) {
+            // incompressible; store the chunk as-is
+            free(buf);
+            job->bufs[i] = NULL;
+            job->lens[i] = len;
+            job->crcs[i] = ji_chunk_checksum(job->ckind, job->src + off, len);
+        }
+        else {
+            job->bufs[i] = buf;
+            job->lens[i] = clen;
+            job->crcs[i] = ji_chunk_checksum(job->ckind, buf, clen);
+        }
+    }
+}
+
+static void jl_write_compressed_section(ios_t *f, const char *data, size_t total)
+{
+    size_t nchunks = (total + JI_CHUNK_SIZE - 1) / JI_CHUNK_SIZE;
+    uint8_t ckind = jl_checksum_crc32c_hw() ? JI_CHECKSUM_CRC32C : JI_CHECKSUM_FAST64;
+    write_uint64(f, total);
+    write_int32(f, JI_CHUNK_SIZE);
+    write_int32(f, (int32_t)nchunks);
+    write_uint8(f, ckind);
+    if (nchunks == 0)
+        return;
+    char **bufs = (char**)malloc_s(nchunks * sizeof(char*));
+    size_t *lens = (size_t*)malloc_s(nchunks * sizeof(size_t));
+    uint32_t *crcs = (uint32_t*)malloc_s(nchunks * sizeof(uint32_t));
+    size_t nthreads = jl_cpu_threads();
+    if (nthreads > JI_MAX_COMPRESS_THREADS)
+        nthreads = JI_MAX_COMPRESS_THREADS;
+    if (nthreads > nchunks)
+        nthreads = nchunks;
+    jl_compress_job_t jobs[JI_MAX_COMPRESS_THREADS];
+    uv_thread_t tids[JI_MAX_COMPRESS_THREADS];
+    size_t t, c0 = 0, per = nchunks / nthreads, rem = nchunks % nthreads;
+    for (t = 0; t < nthreads; t++) {
+        jobs[t].src = data;
+        jobs[t].total = total;
+        jobs[t].c0 = c0;
+        c0 += per + (t < rem);
+        jobs[t].c1 = c0;
+        jobs[t].bufs = bufs;
+        jobs[t].lens = lens;
+        jobs[t].crcs = crcs;
+        jobs[t].ckind = ckind;
+    }
+    // chunks are independent: compress them on worker threads, keeping the
+    // last range for this thread (and falling back to it if spawning fails)
+    size_t nspawned = 0;
+    for (t = 0; t + 1 < nthreads; t++) {
+        if (uv_thread_create(&tids[nspawned], jl_compress_chunks, &jobs[t]) == 0)
+            nspawned++;
+        else
+            jl_compress_chunks(&jobs[t]);
+    }
+    jl_compress_chunks(&jobs[nthreads - 1]);
+    for (t = 0; t < nspawned; t++)
+        uv_thread_join(&tids[t]);
+    // frames must land in the file in chunk order
+    size_t i, off = 0;
+    for (i = 0; i < nchunks; i++) {
+        size_t len = total - off < JI_CHUNK_SIZE ? total - off : JI_CHUNK_SIZE;
+        write_uint8(f, bufs[i] == NULL ? 0 : 1);
+        write_int32(f, lens[i]);
+        write_uint32(f, crcs[i]);
+        ios_write(f, bufs[i] == NULL ? data + off : bufs[i], lens[i]);
+        free(bufs[i]);
+        off += len;
+    }
+    free(bufs);
+    free(lens);
+    free(crcs);
+}
+
+// read a compressed section back into a malloc'd buffer; returns NULL if the
+// section is malformed or a chunk fails its checksum
+static char *jl_read_compressed_section(ios_t *f, size_t *plen)
+{
+    uint64_t total = read_uint64(f);
+    int32_t chunksz = read_int32(f);
+    int32_t nchunks = read_int32(f);
+    uint8_t ckind = read_uint8(f);
+    if (chunksz <= 0 || nchunks < 0 || ckind > JI_CHECKSUM_FAST64 ||
+        (uint64_t)nchunks != (total + chunksz - 1) / chunksz)
+        return NULL;
+    size_t cbound = jl_lz4_compress_bound(chunksz);
+    char *data = (char*)malloc_s(total == 0 ? 1 : total);
+    char *cbuf = (char*)malloc_s(cbound);
+    size_t off = 0;
+    int32_t i;
+    for (i = 0; i < nchunks; i++) {
+        size_t len = total - off < (size_t)chunksz ? (size_t)(total - off) : (size_t)chunksz;
+        uint8_t codec = read_uint8(f);
+        int32_t clen = read_int32(f);
+        uint32_t crc = read_uint32(f);
+        if (clen <= 0)
+            goto fail;
+        if (codec == 0) {
+            if ((size_t)clen != len || ios_readall(f, data + off, len) != len ||
+                ji_chunk_checksum(ckind, data + off, len) != crc)
+                goto fail;
+        }
+        else if (codec == 1) {
+            if ((size_t)clen > cbound || ios_readall(f, cbuf, clen) != (size_t)clen ||
+                ji_chunk_checksum(ckind, cbuf, clen) != crc ||
+                jl_lz4_decompress(cbuf, clen, data + off, len) != len)
+                goto fail;
+        }
+        else {
+            goto fail;
+        }
+        off += len;
+    }
+    free(cbuf);
+    *plen = (size_t)total;
+    return data;
+fail:
+    free(cbuf);
+    free(data);
+    return NULL;
+}
+
 // serialize information about the result of deserializing this file
 static void write_work_list(ios_t *s)
 {
@@ -1840,9 +2065,21 @@ static jl_value_t *jl_deserialize_value_method(jl_serializer_state *s, jl_value_
         jl_gc_wb(m, m->ccallable);
         arraylist_push(&ccallable_list, m->ccallable);
     }
-    m->source = jl_deserialize_value(s, &m->source);
-    if (m->source)
-        jl_gc_wb(m, m->source);
+    if (read_uint8(s->s)) {
+        // source was diverted to the blob section; record the window and
+        // attach it once the section position is known (_jl_restore_incremental)
+        uintptr_t offset = (uintptr_t)read_uint64(s->s);
+        uintptr_t len = (uintptr_t)read_uint64(s->s);
+        m->source = NULL;
+        arraylist_push(&lazy_source_list, m);
+        arraylist_push(&lazy_source_list, (void*)offset);
+        arraylist_push(&lazy_source_list, (void*)len);
+    }
+    else {
+        m->source = jl_deserialize_value(s, &m->source);
+        if (m->source)
+            jl_gc_wb(m, m->source);
+    }
     m->unspecialized = (jl_method_instance_t*)jl_deserialize_value(s, (jl_value_t**)&m->unspecialized);
     if (m->unspecialized)
         jl_gc_wb(m, m->unspecialized);
@@ -1971,6 +2208,7 @@ static jl_value_t *jl_deserialize_value_module(jl_serializer_state *s) JL_GC_DIS
         jl_value_t *bty = jl_deserialize_value(s, (jl_value_t**)&b->ty);
         *(jl_value_t**)&b->ty = bty;
         int8_t flags = read_int8(s->s);
+        b->reassigned = (flags>>5) & 1;
         b->deprecated = (flags>>3) & 1;
         b->constp = (flags>>2) & 1;
         b->exportp = (flags>>1) & 1;
@@ -2272,6 +2510,11 @@ static jl_value_t *jl_deserialize_value(jl_serializer_state *s, jl_value_t **loc
 static void jl_insert_methods(jl_array_t *list)
 {
     size_t i, l = jl_array_len(list);
+    // insert all extension methods as one batch: a single world bump covers
+    // the whole list and the per-table cache invalidation sweeps are
+    // coalesced, instead of being re-run for every method as if each had
+    // been defined interactively
+    jl_method_batch_begin();
     for (i = 0; i < l; i += 2) {
         jl_method_t *meth = (jl_method_t*)jl_array_ptr_ref(list, i);
         assert(jl_is_method(meth));
@@ -2281,6 +2524,7 @@ static void jl_insert_methods(jl_array_t *list)
         assert((jl_value_t*)mt != jl_nothing);
         jl_method_table_insert(mt, meth, simpletype);
     }
+    jl_method_batch_end();
 }
 
 void remove_code_instance_from_validation(jl_code_instance_t *codeinst)
@@ -2307,7 +2551,7 @@ static void jl_insert_method_instances(jl_array_t *list)
                 jl_value_t *mworld = entry->func.value;
                 if (jl_is_method(mworld) && mi->def.method != (jl_method_t*)mworld && jl_type_morespecific(((jl_method_t*)mworld)->sig, mi->def.method->sig)) {
                     jl_array_uint8_set(valids, i, 0);
-                    invalidate_backedges(&remove_code_instance_from_validation, mi, world, "jl_insert_method_instance");
+                    invalidate_backedges(&remove_code_instance_from_validation, mi, world, "jl_insert_method_instance", NULL);
                     // The codeinst of this mi haven't yet been removed
                     jl_code_instance_t *codeinst = mi->cache;
                     while (codeinst) {
@@ -2390,6 +2634,47 @@ static void jl_insert_method_instances(jl_array_t *list)
 }
 
 // verify that these edges intersect with the same methods as before
+// validate a single recorded call edge against the current method tables;
+// safe to call concurrently from multiple threads (method matching is what
+// any multithreaded workload already does concurrently)
+JL_DLLEXPORT int jl_verify_edge_target(jl_array_t *targets, size_t i)
+{
+    jl_value_t *callee = jl_array_ptr_ref(targets, i * 2);
+    jl_method_instance_t *callee_mi = (jl_method_instance_t*)callee;
+    jl_value_t *sig;
+    if (jl_is_method_instance(callee)) {
+        sig = callee_mi->specTypes;
+    }
+    else {
+        sig = callee;
+    }
+    jl_array_t *expected = (jl_array_t*)jl_array_ptr_ref(targets, i * 2 + 1);
+    assert(jl_is_array(expected));
+    size_t min_valid = 0;
+    size_t max_valid = ~(size_t)0;
+    int ambig = 0;
+    // TODO: possibly need to included ambiguities too (for the optimizer correctness)?
+    jl_value_t *matches = jl_matching_methods((jl_tupletype_t*)sig, jl_nothing, -1, 0, jl_atomic_load_acquire(&jl_world_counter), &min_valid, &max_valid, &ambig);
+    if (matches == jl_false || jl_array_len(matches) != jl_array_len(expected))
+        return 0;
+    size_t j, k, l = jl_array_len(expected);
+    for (k = 0; k < jl_array_len(matches); k++) {
+        jl_method_match_t *match = (jl_method_match_t*)jl_array_ptr_ref(matches, k);
+        jl_method_t *m = match->method;
+        for (j = 0; j < l; j++) {
+            if (m == (jl_method_t*)jl_array_ptr_ref(expected, j))
+                break;
+        }
+        if (j == l) {
+            // intersection has a new method or a method was
+            // deleted--this is now probably no good, just invalidate
+            // everything about it now
+            return 0;
+        }
+    }
+    return 1;
+}
+
 static void jl_verify_edges(jl_array_t *targets, jl_array_t **pvalids)
 {
     size_t i, l = jl_array_len(targets) / 2;
@@ -2398,48 +2683,26 @@ static void jl_verify_edges(jl_array_t *targets, jl_array_t **pvalids)
     jl_value_t *loctag = NULL;
     JL_GC_PUSH1(&loctag);
     *pvalids = valids;
-    for (i = 0; i < l; i++) {
-        jl_value_t *callee = jl_array_ptr_ref(targets, i * 2);
-        jl_method_instance_t *callee_mi = (jl_method_instance_t*)callee;
-        jl_value_t *sig;
-        if (jl_is_method_instance(callee)) {
-            sig = callee_mi->specTypes;
-        }
-        else {
-            sig = callee;
-        }
-        jl_array_t *expected = (jl_array_t*)jl_array_ptr_ref(targets, i * 2 + 1);
-        assert(jl_is_array(expected));
-        int valid = 1;
-        size_t min_valid = 0;
-        size_t max_valid = ~(size_t)0;
-        int ambig = 0;
-        // TODO: possibly need to included ambiguities too (for the optimizer correctness)?
-        jl_value_t *matches = jl_matching_methods((jl_tupletype_t*)sig, jl_nothing, -1, 0, jl_atomic_load_acquire(&jl_world_counter), &min_valid, &max_valid, &ambig);
-        if (matches == jl_false || jl_array_len(matches) != jl_array_len(expected)) {
-            valid = 0;
-        }
-        else {
-            size_t j, k, l = jl_array_len(expected);
-            for (k = 0; k < jl_array_len(matches); k++) {
-                jl_method_match_t *match = (jl_method_match_t*)jl_array_ptr_ref(matches, k);
-                jl_method_t *m = match->method;
-                for (j = 0; j < l; j++) {
-                    if (m == (jl_method_t*)jl_array_ptr_ref(expected, j))
-                        break;
-                }
-                if (j == l) {
-                    // intersection has a new method or a method was
-                    // deleted--this is now probably no good, just invalidate
-                    // everything about it now
-                    valid = 0;
-                    break;
-                }
-            }
+    if (jl_n_threads > 1 && l > 256 && !_jl_debug_method_invalidation && jl_base_module) {
+        // the verification loop is embarrassingly parallel, and with deep
+        // dependency trees it dominates cache load time
+        jl_value_t *f = jl_get_global(jl_base_module, jl_symbol("_parallel_verify_edges"));
+        if (f != NULL) {
+            jl_task_t *ct = jl_current_task;
+            size_t last_age = ct->world_age;
+            ct->world_age = jl_get_world_counter();
+            jl_value_t *args[3] = {f, (jl_value_t*)targets, (jl_value_t*)valids};
+            jl_apply(args, 3);
+            ct->world_age = last_age;
+            JL_GC_POP();
+            return;
         }
+    }
+    for (i = 0; i < l; i++) {
+        int valid = jl_verify_edge_target(targets, i);
         jl_array_uint8_set(valids, i, valid);
         if (!valid && _jl_debug_method_invalidation) {
-            jl_array_ptr_1d_push(_jl_debug_method_invalidation, (jl_value_t*)callee);
+            jl_array_ptr_1d_push(_jl_debug_method_invalidation, jl_array_ptr_ref(targets, i * 2));
             loctag = jl_cstr_to_string("insert_backedges_callee");
             jl_array_ptr_1d_push(_jl_debug_method_invalidation, loctag);
         }
@@ -2732,7 +2995,8 @@ JL_DLLEXPORT int jl_save_incremental(const char *fname, jl_array_t *worklist)
     }
 
     int en = jl_gc_enable(0); // edges map is not gc-safe
-    jl_array_t *extext_methods = jl_alloc_vec_any(0);  // [method1, simplesig1, ...], worklist-owned "extending external" methods added to functions owned by modules outside the worklist
+    serialize_dedup_table = jl_alloc_vec_any(1024);
+    jl_array_t *extext_methods = jl_alloc_vec_any(0); // [method1, simplesig1, ...], worklist-owned "extending external" methods added to functions owned by modules outside the worklist
     jl_array_t *ext_targets = jl_alloc_vec_any(0);     // [callee1, matches1, ...] non-worklist callees of worklist-owned methods
     jl_array_t *edges = jl_alloc_vec_any(0);           // [caller1, ext_targets_indexes1, ...] for worklist-owned methods calling external methods
 
@@ -2755,10 +3019,16 @@ JL_DLLEXPORT int jl_save_incremental(const char *fname, jl_array_t *worklist)
     // Process this to extract `edges` and `ext_targets`.
     jl_collect_backedges(edges, ext_targets);
 
+    ios_t srcblobs;
+    ios_mem(&srcblobs, 1000000);
+    // serialize into memory first; the data lands in the file compressed
+    ios_t sdata;
+    ios_mem(&sdata, 1000000);
     jl_serializer_state s = {
-        &f,
+        &sdata,
         jl_current_task->ptls,
-        mod_array
+        mod_array,
+        &srcblobs
     };
     jl_serialize_value(&s, worklist);   // serialize module-owned items (those accessible from the bindings table)
     jl_serialize_value(&s, extext_methods);  // serialize new worklist-owned methods for external functions
@@ -2770,6 +3040,17 @@ JL_DLLEXPORT int jl_save_incremental(const char *fname, jl_array_t *worklist)
     jl_serialize_value(&s, ext_targets);
     jl_finalize_serializer(&s);
     serializer_worklist = NULL;
+    serialize_dedup_table = NULL;
+
+    // write the serialized data as independently compressed, checksummed chunks
+    jl_write_compressed_section(&f, sdata.buf, (size_t)ios_pos(&sdata));
+    ios_close(&sdata);
+
+    // append the diverted compressed-IR blobs as one contiguous section;
+    // restore maps this region and creates array views into it
+    write_uint64(&f, (uint64_t)ios_pos(&srcblobs));
+    ios_write(&f, srcblobs.buf, ios_pos(&srcblobs));
+    ios_close(&srcblobs);
 
     jl_gc_enable(en);
     htable_reset(&edges_map, 0);
@@ -3136,6 +3417,18 @@ static jl_value_t *_jl_restore_incremental(ios_t *f, jl_array_t *mod_array)
         return verify_fail;
     }
 
+    // decompress the serialized data section, leaving f positioned at the
+    // compressed-IR blob section that follows it
+    size_t sdatalen = 0;
+    char *sdatabuf = jl_read_compressed_section(f, &sdatalen);
+    if (sdatabuf == NULL) {
+        ios_close(f);
+        return jl_get_exceptionf(jl_errorexception_type,
+                "Precompile file is corrupt: serialized data failed its checksum.");
+    }
+    ios_t sdata;
+    ios_static_buffer(&sdata, sdatabuf, sdatalen);
+
     // prepare to deserialize
     int en = jl_gc_enable(0);
     jl_gc_enable_finalizers(ct, 0);
@@ -3147,12 +3440,14 @@ static jl_value_t *_jl_restore_incremental(ios_t *f, jl_array_t *mod_array)
     htable_new(&queued_method_roots, 0);
     htable_new(&new_code_instance_validate, 0);
     arraylist_new(&ccallable_list, 0);
+    arraylist_new(&lazy_source_list, 0);
     htable_new(&uniquing_table, 0);
 
     jl_serializer_state s = {
-        f,
+        &sdata,
         ct->ptls,
-        mod_array
+        mod_array,
+        NULL
     };
     jl_array_t *restored = (jl_array_t*)jl_deserialize_value(&s, (jl_value_t**)&restored);
     serializer_worklist = restored;
@@ -3181,7 +3476,43 @@ static jl_value_t *_jl_restore_incremental(ios_t *f, jl_array_t *mod_array)
     // At this point, the novel specializations in mi_list reference the real method, but they haven't been cached in its specializations
     jl_insert_method_instances(mi_list);   // insert novel specializations
     htable_free(&uniquing_table);
-    jl_array_t *init_order = jl_finalize_deserializer(&s, tracee_list); // done with f and s (needs to be after recache)
+    jl_array_t *init_order = jl_finalize_deserializer(&s, tracee_list); // done with s (needs to be after recache)
+    ios_close(&sdata);
+    free(sdatabuf);
+    { // attach the compressed-IR blob section written after the serialized data
+        uint64_t blobslen = read_uint64(f);
+        int64_t blobsstart = ios_pos(f);
+        char *blobs = NULL;
+        if (f->fd != -1 && blobslen > 0) {
+            // map the whole file so the views below are demand-paged from the
+            // cache file; the mapping intentionally stays alive for the
+            // lifetime of the process since methods keep pointing into it.
+            // No prefault policy: the blobs are read lazily (if ever), when
+            // uncompressed IR is requested
+            char *data = jl_image_map_file(f->fd, (size_t)(blobsstart + blobslen), 0);
+            if (data)
+                blobs = data + blobsstart;
+        }
+        for (size_t j = 0; j < lazy_source_list.len; j += 3) {
+            jl_method_t *m = (jl_method_t*)lazy_source_list.items[j];
+            size_t offset = (size_t)(uintptr_t)lazy_source_list.items[j + 1];
+            size_t len = (size_t)(uintptr_t)lazy_source_list.items[j + 2];
+            jl_array_t *src;
+            if (blobs) {
+                src = jl_ptr_to_array_1d((jl_value_t*)jl_array_uint8_type, blobs + offset, len, 0);
+            }
+            else {
+                // stream not backed by a mappable file: materialize a copy
+                src = jl_alloc_array_1d(jl_array_uint8_type, len);
+                ios_seek(f, blobsstart + offset);
+                ios_readall(f, (char*)jl_array_data(src), len);
+            }
+            m->source = (jl_value_t*)src;
+            jl_gc_wb(m, m->source);
+        }
+        ios_seek(f, blobsstart + blobslen);
+        arraylist_free(&lazy_source_list);
+    }
     if (init_order == NULL)
         init_order = (jl_array_t*)jl_an_empty_vec_any;
     assert(jl_isa((jl_value_t*)init_order, jl_array_any_type));
@@ -3194,6 +3525,36 @@ static jl_value_t *_jl_restore_incremental(ios_t *f, jl_array_t *mod_array)
     // check new CodeInstances and validate any that lack external backedges
     validate_new_code_instances();
 
+    // optionally start compiling the restored precompile-flagged instances on
+    // a background task, so first calls into the package skip JIT latency
+    if (jl_n_threads > 1 && jl_base_module) {
+        static int pkg_warmup = -1;
+        if (pkg_warmup == -1) {
+            char *ev = getenv("JULIA_PKG_WARMUP");
+            pkg_warmup = ev && atoi(ev);
+        }
+        jl_value_t *bgf = pkg_warmup ? jl_get_global(jl_base_module, jl_symbol("_background_warmup")) : NULL;
+        if (bgf != NULL) {
+            jl_array_t *warm = jl_alloc_vec_any(0);
+            JL_GC_PUSH1(&warm);
+            for (size_t j = 0; j < new_code_instance_validate.size; j += 2) {
+                if (new_code_instance_validate.table[j + 1] != HT_NOTFOUND) {
+                    jl_code_instance_t *ci = (jl_code_instance_t*)new_code_instance_validate.table[j];
+                    if (ci->precompile && jl_atomic_load_relaxed(&ci->invoke) == NULL)
+                        jl_array_ptr_1d_push(warm, (jl_value_t*)ci->def);
+                }
+            }
+            if (jl_array_len(warm) > 0) {
+                size_t last_age = ct->world_age;
+                ct->world_age = jl_get_world_counter();
+                jl_value_t *args[2] = {bgf, (jl_value_t*)warm};
+                jl_apply(args, 2);
+                ct->world_age = last_age;
+            }
+            JL_GC_POP();
+        }
+    }
+
     serializer_worklist = NULL;
     htable_free(&new_code_instance_validate);
     arraylist_free(&flagref_list);
@@ -3349,6 +3710,266 @@ void jl_init_serializer(void)
     assert(i <= 256);
 }
 
+// --- shared inference cache ---
+
+// A read-mostly, append-only cache of inference results shared between
+// identically-configured worker processes through a memory-mapped file
+// (JULIA_SHARED_INFER_CACHE=<path>). Each entry holds the compressed
+// inferred IR and the return type of one specialization, and is only
+// written when every root the encoding references has provenance (the
+// `relocatability` rule the incremental serializer also relies on), so any
+// worker that loaded the same sysimage and packages can decode it. One
+// designated process (JULIA_SHARED_INFER_CACHE_WRITE=1) appends entries and
+// publishes each one by bumping the committed size in the header only after
+// the entry bytes are in place, so readers never see a torn tail. World
+// numbers are recorded verbatim: the cache assumes a fleet whose workers
+// load identical code in identical order, which the Base build id in the
+// header spot-checks.
+
+#ifndef _OS_WINDOWS_
+
+#define SHINFER_MAGIC UINT64_C(0x3148434e49666c6a) // "jlfINCH1"
+
+typedef struct {
+    uint64_t magic;
+    uint64_t base_build_id;
+    uint64_t committed; // bytes of valid data, including this header
+    uint64_t reserved;
+} shinfer_header_t;
+
+typedef struct {
+    uint64_t key[2];
+    uint64_t min_world;
+    uint64_t max_world;
+    uint32_t ir_len;
+    uint32_t ret_len;
+    // followed by `ir_len + ret_len` payload bytes, padded to 8 bytes
+} shinfer_entry_t;
+
+static int shinfer_fd = -1;
+static int shinfer_write = 0;
+static char *shinfer_map = NULL;
+static size_t shinfer_map_len = 0;
+static size_t shinfer_scanned = 0;
+static htable_t shinfer_index; // folded entry key -> file offset + 1
+// Raw mutex, so nothing may allocate while holding it (a blocked thread
+// would stall the GC); payloads are copied out before decoding.
+static uv_mutex_t shinfer_lock;
+
+static void shinfer_entry_key(jl_method_instance_t *mi, uint64_t *key)
+{
+    jl_method_t *m = mi->def.method;
+    // object ids here hash types by structure and names, so they agree
+    // between workers; the module build id ties the entry to one precompile
+    // of the defining package
+    key[0] = (uint64_t)jl_object_id((jl_value_t*)mi->specTypes);
+    key[1] = (uint64_t)jl_object_id((jl_value_t*)m->sig) ^ m->module->build_id;
+}
+
+static void *shinfer_index_key(const uint64_t *key)
+{
+    // fold to a pointer-sized key; keep it distinct from HT_NOTFOUND/NULL
+    return (void*)(uintptr_t)((key[0] ^ (key[1] * UINT64_C(0x9e3779b97f4a7c15))) | 1);
+}
+
+void jl_init_shared_infer_cache(void)
+{
+    char *path = getenv("JULIA_SHARED_INFER_CACHE");
+    if (path == NULL || path[0] == '\0' || jl_base_module == NULL)
+        return;
+    char *wr = getenv("JULIA_SHARED_INFER_CACHE_WRITE");
+    shinfer_write = (wr != NULL && atoi(wr) != 0);
+    int fd = open(path, shinfer_write ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (fd == -1)
+        return;
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    shinfer_header_t hdr;
+    ssize_t nr = pread(fd, &hdr, sizeof(hdr), 0);
+    if (nr == 0 && shinfer_write) {
+        memset(&hdr, 0, sizeof(hdr));
+        hdr.magic = SHINFER_MAGIC;
+        hdr.base_build_id = jl_base_module->build_id;
+        hdr.committed = sizeof(hdr);
+        if (pwrite(fd, &hdr, sizeof(hdr), 0) != sizeof(hdr)) {
+            close(fd);
+            return;
+        }
+    }
+    else if (nr != sizeof(hdr) || hdr.magic != SHINFER_MAGIC ||
+             hdr.base_build_id != jl_base_module->build_id) {
+        // not a cache for this sysimage (or a torn header): stay disabled
+        close(fd);
+        return;
+    }
+    uv_mutex_init(&shinfer_lock);
+    htable_new(&shinfer_index, 0);
+    shinfer_scanned = sizeof(shinfer_header_t);
+    shinfer_fd = fd;
+}
+
+// catch up with entries the writer committed since our last scan
+// (shinfer_lock held)
+static int shinfer_refresh(void)
+{
+    shinfer_header_t hdr;
+    if (pread(shinfer_fd, &hdr, sizeof(hdr), 0) != sizeof(hdr))
+        return 0;
+    size_t committed = (size_t)hdr.committed;
+    if (committed < sizeof(shinfer_header_t))
+        return 0;
+    if (committed > shinfer_map_len) {
+        if (shinfer_map)
+            munmap(shinfer_map, shinfer_map_len);
+        shinfer_map_len = 0;
+        shinfer_map = (char*)mmap(NULL, committed, PROT_READ, MAP_SHARED,
+                                  shinfer_fd, 0);
+        if (shinfer_map == MAP_FAILED) {
+            shinfer_map = NULL;
+            return 0;
+        }
+        shinfer_map_len = committed;
+    }
+    // index the new entries; a later entry for the same specialization
+    // (e.g. re-inference in a newer world) shadows the earlier one
+    while (shinfer_scanned + sizeof(shinfer_entry_t) <= committed) {
+        shinfer_entry_t *e = (shinfer_entry_t*)(shinfer_map + shinfer_scanned);
+        size_t len = sizeof(shinfer_entry_t) +
+            LLT_ALIGN((size_t)e->ir_len + e->ret_len, 8);
+        if (shinfer_scanned + len > committed)
+            break;
+        ptrhash_put(&shinfer_index, shinfer_index_key(e->key),
+                    (void*)(uintptr_t)(shinfer_scanned + 1));
+        shinfer_scanned += len;
+    }
+    return 1;
+}
+
+jl_code_info_t *jl_shared_infer_cache_lookup(jl_method_instance_t *mi, size_t world)
+{
+    if (shinfer_fd == -1 || !jl_is_method(mi->def.method))
+        return NULL;
+    jl_method_t *m = mi->def.method;
+    uint64_t key[2];
+    shinfer_entry_key(mi, key);
+    uv_mutex_lock(&shinfer_lock);
+    void *idx = ptrhash_get(&shinfer_index, shinfer_index_key(key));
+    if (idx == HT_NOTFOUND && shinfer_refresh())
+        idx = ptrhash_get(&shinfer_index, shinfer_index_key(key));
+    shinfer_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+    char *buf = NULL;
+    if (idx != HT_NOTFOUND) {
+        shinfer_entry_t *e =
+            (shinfer_entry_t*)(shinfer_map + ((size_t)(uintptr_t)idx - 1));
+        if (e->key[0] == key[0] && e->key[1] == key[1] &&
+            e->min_world <= world && world <= e->max_world) {
+            entry = *e;
+            buf = (char*)malloc_s((size_t)entry.ir_len + entry.ret_len);
+            memcpy(buf, e + 1, (size_t)entry.ir_len + entry.ret_len);
+        }
+    }
+    uv_mutex_unlock(&shinfer_lock);
+    if (buf == NULL)
+        return NULL;
+    jl_code_info_t *src = NULL;
+    jl_array_t *data = NULL;
+    jl_value_t *ret = NULL;
+    JL_GC_PUSH3(&src, &data, &ret);
+    JL_TRY {
+        data = jl_ptr_to_array_1d((jl_value_t*)jl_array_uint8_type, buf,
+                                  entry.ir_len, 0);
+        src = jl_uncompress_ir(m, NULL, data);
+        data = jl_ptr_to_array_1d((jl_value_t*)jl_array_uint8_type,
+                                  buf + entry.ir_len, entry.ret_len, 0);
+        ret = jl_uncompress_ir_value(m, data);
+    }
+    JL_CATCH {
+        // a root this entry relies on is not present here; treat as a miss
+        src = NULL;
+    }
+    if (src != NULL) {
+        src->rettype = ret;
+        jl_gc_wb(src, ret);
+        src->min_world = entry.min_world;
+        src->max_world = entry.max_world;
+        src->inferred = 1;
+    }
+    free(buf);
+    JL_GC_POP();
+    return src;
+}
+
+void jl_shared_infer_cache_store(jl_method_instance_t *mi, jl_code_info_t *src)
+{
+    if (shinfer_fd == -1 || !shinfer_write || !jl_is_method(mi->def.method))
+        return;
+    if (!src->inferred || src->rettype == NULL)
+        return;
+    jl_method_t *m = mi->def.method;
+    jl_array_t *ir = NULL;
+    jl_array_t *ret = NULL;
+    JL_GC_PUSH3(&src, &ir, &ret);
+    ir = jl_compress_ir(m, src);
+    // shareable only when every referenced root has provenance
+    if (((uint8_t*)ir->data)[jl_array_len(ir) - 1] == 1)
+        ret = jl_compress_ir_value(m, src->rettype);
+    if (ret != NULL) {
+        shinfer_entry_t e;
+        memset(&e, 0, sizeof(e));
+        shinfer_entry_key(mi, e.key);
+        e.min_world = src->min_world;
+        e.max_world = src->max_world;
+        e.ir_len = (uint32_t)jl_array_len(ir);
+        e.ret_len = (uint32_t)jl_array_len(ret);
+        size_t paylen = LLT_ALIGN((size_t)e.ir_len + e.ret_len, 8);
+        uv_mutex_lock(&shinfer_lock);
+        shinfer_header_t hdr;
+        // take the append position from the header so restarts of the
+        // writer keep extending the same file
+        if (pread(shinfer_fd, &hdr, sizeof(hdr), 0) == sizeof(hdr)) {
+            size_t off = (size_t)hdr.committed;
+            uint64_t zero = 0;
+            int ok = pwrite(shinfer_fd, &e, sizeof(e), off) == sizeof(e);
+            ok = ok && pwrite(shinfer_fd, jl_array_data(ir), e.ir_len,
+                              off + sizeof(e)) == (ssize_t)e.ir_len;
+            ok = ok && pwrite(shinfer_fd, jl_array_data(ret), e.ret_len,
+                              off + sizeof(e) + e.ir_len) == (ssize_t)e.ret_len;
+            if (ok && paylen > (size_t)e.ir_len + e.ret_len)
+                ok = pwrite(shinfer_fd, &zero, paylen - e.ir_len - e.ret_len,
+                            off + sizeof(e) + e.ir_len + e.ret_len) ==
+                     (ssize_t)(paylen - e.ir_len - e.ret_len);
+            if (ok) {
+                // publish only after the entry bytes are in place
+                hdr.committed = off + sizeof(e) + paylen;
+                (void)!pwrite(shinfer_fd, &hdr, sizeof(hdr), 0);
+            }
+        }
+        uv_mutex_unlock(&shinfer_lock);
+    }
+    JL_GC_POP();
+}
+
+#else // _OS_WINDOWS_
+
+void jl_init_shared_infer_cache(void)
+{
+}
+
+jl_code_info_t *jl_shared_infer_cache_lookup(jl_method_instance_t *mi, size_t world)
+{
+    (void)mi;
+    (void)world;
+    return NULL;
+}
+
+void jl_shared_infer_cache_store(jl_method_instance_t *mi, jl_code_info_t *src)
+{
+    (void)mi;
+    (void)src;
+}
+
+#endif // _OS_WINDOWS_
+
 #ifdef __cplusplus
 }
 #endif
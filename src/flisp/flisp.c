@@ -617,6 +617,10 @@ void gc(fl_context_t *fl_ctx, int mustgrow)
     // more space to fill next time. if we grew tospace last time,
     // grow the other half of the heap this time to catch up.
     if (fl_ctx->gc_grew || mustgrow
+        // while a parse arena is active, always take the growth path so the
+        // heap doubles geometrically instead of re-collecting the growing
+        // parse output at a fixed size (see fl_parse_arena_begin)
+        || fl_ctx->parse_arena
 #ifdef MEMDEBUG
         // GC more often
         || ((fl_ctx->lim-fl_ctx->curheap) < (int)(fl_ctx->heapsize/128))
@@ -649,6 +653,29 @@ void gc(fl_context_t *fl_ctx, int mustgrow)
 #endif
 }
 
+// Parse-scoped arena mode. A parse unit allocates cons cells that are almost
+// all dead the moment the converted AST leaves scm_to_julia, but a large file
+// can trigger many collections along the way, each re-copying the growing
+// parse output at load-bearing latency. While a region is active every
+// collection takes the growth path in gc() above, so the heap doubles until
+// the unit fits and the copying cost amortizes to a constant per cons; a
+// single contiguous fromspace is kept (cons_index and ismanaged assume one),
+// which is why the heap grows in place rather than chaining fresh segments.
+// Closing the outermost region collects once, compacting the then-dead parse
+// output; the grown semispaces are kept for the next parse, matching the
+// allocator's usual no-shrink policy. Regions nest.
+void fl_parse_arena_begin(fl_context_t *fl_ctx)
+{
+    fl_ctx->parse_arena++;
+}
+
+void fl_parse_arena_end(fl_context_t *fl_ctx)
+{
+    assert(fl_ctx->parse_arena > 0);
+    if (--fl_ctx->parse_arena == 0)
+        gc(fl_ctx, 0);
+}
+
 static void grow_stack(fl_context_t *fl_ctx)
 {
     size_t newsz = fl_ctx->N_STACK + (fl_ctx->N_STACK>>1);
@@ -2314,6 +2341,7 @@ static void lisp_init(fl_context_t *fl_ctx, size_t initial_heapsize)
     fl_ctx->N_GCHND = 0;
     fl_ctx->readstate = NULL;
     fl_ctx->gensym_ctr = 0;
+    fl_ctx->parse_arena = 0;
     fl_ctx->gsnameno = 0;
 
 #ifdef MEMDEBUG2
@@ -380,6 +380,8 @@ value_t cvalue_byte(fl_context_t *fl_ctx, value_t *args, uint32_t nargs);
 value_t cvalue_wchar(fl_context_t *fl_ctx, value_t *args, uint32_t nargs);
 
 void fl_init(fl_context_t *fl_ctx, size_t initial_heapsize) JL_NOTSAFEPOINT;
+void fl_parse_arena_begin(fl_context_t *fl_ctx) JL_NOTSAFEPOINT;
+void fl_parse_arena_end(fl_context_t *fl_ctx);
 int fl_load_system_image(fl_context_t *fl_ctx, value_t ios);
 int fl_load_system_image_str(fl_context_t *fl_ctx, char* str, size_t len) JL_NOTSAFEPOINT;
 
@@ -496,6 +498,7 @@ struct _fl_context_t {
     value_t memory_exception_value;
 
     int gc_grew;
+    int parse_arena; // nonzero while a parse-scoped arena region is active (see gc())
     cons_t *apply_c;
     value_t *apply_pv;
     int64_t apply_accum;
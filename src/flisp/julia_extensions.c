@@ -64,6 +64,119 @@ value_t fl_skipws(fl_context_t *fl_ctx, value_t *args, uint32_t nargs)
     return skipped;
 }
 
+// native version of the scheme skip-line-comment: consume everything up to
+// (but not including) the next newline, so comment bodies cost no
+// interpretation per character
+value_t fl_skip_line_comment(fl_context_t *fl_ctx, value_t *args, uint32_t nargs)
+{
+    argcount(fl_ctx, "skip-line-comment", nargs, 1);
+    ios_t *s = fl_toiostream(fl_ctx, args[0], "skip-line-comment");
+    uint32_t wc = 0;
+    while (1) {
+        if (safe_peekutf8(fl_ctx, s, &wc) == IOS_EOF) {
+            ios_getutf8(s, &wc); // to set EOF flag if this is a true EOF
+            if (!ios_eof(s))
+                lerror(fl_ctx, symbol(fl_ctx, "error"), "incomplete character");
+            return fl_ctx->FL_EOF;
+        }
+        if (wc == '\n')
+            return mk_wchar(fl_ctx, wc);
+        ios_getutf8(s, &wc);
+    }
+}
+
+static int is_digit_base(int c, const char *base)
+{
+    switch (base[0]) {
+    case 'h': return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
+                     (c >= 'A' && c <= 'F');
+    case 'o': return c >= '0' && c <= '7';
+    case 'b': return c == '0' || c == '1';
+    default:  return c >= '0' && c <= '9';
+    }
+}
+
+// native version of the scheme accum-digits: read a run of digits in the
+// given base ('dec, 'hex, 'oct or 'bin), eliding '_' separators when allowed;
+// a trailing '_' not followed by a digit is left in the port
+value_t fl_julia_accum_digits(fl_context_t *fl_ctx, value_t *args, uint32_t nargs)
+{
+    argcount(fl_ctx, "accum-digits", nargs, 4);
+    // args[0] is the already-peeked first char; nothing was consumed,
+    // so it is re-read from the port below
+    if (!issymbol(args[1]))
+        type_error(fl_ctx, "accum-digits", "symbol", args[1]);
+    const char *base = symbol_name(fl_ctx, args[1]);
+    ios_t *s = fl_toiostream(fl_ctx, args[2], "accum-digits");
+    int sep = (args[3] != fl_ctx->F);
+    ios_t str;
+    ios_mem(&str, 0);
+    while (1) {
+        int c = ios_peekc(s);
+        if (c == IOS_EOF)
+            break;
+        if (is_digit_base(c, base)) {
+            ios_getc(s);
+            ios_putc(c, &str);
+            continue;
+        }
+        if (sep && c == '_') {
+            ios_getc(s);
+            int c2 = ios_peekc(s);
+            if (c2 != IOS_EOF && is_digit_base(c2, base))
+                continue; // separators are elided from the result
+            ios_ungetc('_', s);
+        }
+        break;
+    }
+    value_t v = cvalue_string(fl_ctx, str.size);
+    memcpy(cvalue_data(v), str.buf, str.size);
+    ios_close(&str);
+    return v;
+}
+
+// Bulk-copy a run of "plain" string-literal characters from `in` to `out`:
+// printable ASCII that is not the delimiter, a backslash, or (outside raw
+// strings) '$'. These cannot affect quoting, interpolation, line numbering or
+// bidi state, so the scheme string reader only interprets the bytes that
+// matter and everything else moves at memcpy speed.
+value_t fl_copy_plain_string_chars(fl_context_t *fl_ctx, value_t *args, uint32_t nargs)
+{
+    argcount(fl_ctx, "string.copy-plain", nargs, 4);
+    ios_t *in = fl_toiostream(fl_ctx, args[0], "string.copy-plain");
+    ios_t *out = fl_toiostream(fl_ctx, args[1], "string.copy-plain");
+    if (!iscprim(args[2]) || ((cprim_t*)ptr(args[2]))->type != fl_ctx->wchartype)
+        type_error(fl_ctx, "string.copy-plain", "wchar", args[2]);
+    uint32_t delim = *(uint32_t*)cp_data((cprim_t*)ptr(args[2]));
+    int raw = (args[3] != fl_ctx->F);
+    while (in->state == bst_rd) {
+        if (in->bpos >= in->size) {
+            if (ios_peekc(in) == IOS_EOF) // refills the buffer
+                break;
+            continue;
+        }
+        size_t i = in->bpos, n = in->size;
+        const char *buf = in->buf;
+        while (i < n) {
+            uint8_t b = (uint8_t)buf[i];
+            // stop at control chars and non-ASCII too: they interact with
+            // line/column tracking and bidi checking
+            if (b < 0x20 || b >= 0x7f || b == delim || b == '\\' ||
+                (!raw && b == '$'))
+                break;
+            i++;
+        }
+        if (i == in->bpos)
+            break; // next byte needs the scheme reader
+        ios_write(out, buf + in->bpos, i - in->bpos);
+        in->u_colno += i - in->bpos; // all copied chars have width 1
+        in->bpos = i;
+        if (i < n)
+            break;
+    }
+    return fl_ctx->T;
+}
+
 static int is_wc_cat_id_start(uint32_t wc, utf8proc_category_t cat)
 {
     return (cat == UTF8PROC_CATEGORY_LU || cat == UTF8PROC_CATEGORY_LL ||
@@ -412,7 +525,10 @@ value_t fl_string_only_julia_char(fl_context_t *fl_ctx, value_t *args, uint32_t
 
 static const builtinspec_t julia_flisp_func_info[] = {
     { "skip-ws", fl_skipws },
+    { "skip-line-comment", fl_skip_line_comment },
     { "accum-julia-symbol", fl_accum_julia_symbol },
+    { "accum-digits", fl_julia_accum_digits },
+    { "string.copy-plain", fl_copy_plain_string_chars },
     { "identifier-char?", fl_julia_identifier_char },
     { "identifier-start-char?", fl_julia_identifier_start_char },
     { "never-identifier-char?", fl_julia_never_identifier_char },
@@ -5,6 +5,7 @@
 #include "julia_internal.h"
 #include "gc.h"
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -43,7 +44,8 @@ struct jl_combined_results {
 // == Global variables manipulated by callbacks ==
 
 jl_alloc_profile_t g_alloc_profile;
-int g_alloc_profile_enabled = false;
+JL_DLLEXPORT int g_alloc_profile_enabled = false;
+size_t g_alloc_profile_interval = 0;
 jl_combined_results g_combined_results; // Will live forever.
 
 // === stack stuff ===
@@ -85,6 +87,23 @@ JL_DLLEXPORT void jl_start_alloc_profile(double sample_rate) {
     }
 
     g_alloc_profile.sample_rate = sample_rate;
+    g_alloc_profile_interval = 0;
+    g_alloc_profile_enabled = true;
+}
+
+JL_DLLEXPORT void jl_start_alloc_profile_sampled(size_t sample_interval_bytes) {
+    // Sampling mode: instead of a coin flip per allocation, each thread
+    // counts down allocated bytes and records one backtrace per
+    // `sample_interval_bytes`, cheap enough to leave on in production.
+    while (g_alloc_profile.per_thread_profiles.size() < (size_t)jl_n_threads) {
+        g_alloc_profile.per_thread_profiles.push_back(jl_per_thread_alloc_profile_t{});
+    }
+
+    for (int i = 0; i < jl_n_threads; i++) {
+        jl_all_tls_states[i]->alloc_profile_countdown = sample_interval_bytes;
+    }
+    g_alloc_profile.sample_rate = 1.0;
+    g_alloc_profile_interval = sample_interval_bytes;
     g_alloc_profile_enabled = true;
 }
 
@@ -107,6 +126,7 @@ JL_DLLEXPORT jl_profile_allocs_raw_results_t jl_fetch_alloc_profile() {
 
 JL_DLLEXPORT void jl_stop_alloc_profile() {
     g_alloc_profile_enabled = false;
+    g_alloc_profile_interval = 0;
 }
 
 JL_DLLEXPORT void jl_free_alloc_profile() {
@@ -149,4 +169,103 @@ void _maybe_record_alloc_to_profile(jl_value_t *val, size_t size, jl_datatype_t
     });
 }
 
+// == per-site allocation counters (alloc-site tracking) ==
+//
+// Complementary to the sampling profiler above: no backtrace capture, just
+// a dense site ID that codegen assigns to each allocation instruction it
+// instruments (emit_allocobj in cgutils.cpp) and per-thread
+// (count, bytes, type) counters bumped by jl_count_alloc_site. The
+// per-allocation cost is one call and three stores, so it can stay enabled
+// on production services. Counter blocks never move once allocated, which
+// lets the fetch side read them while the mutators keep counting; the
+// counters are monotonic, so a racing read only lags.
+
+#define ALLOC_SITE_BLOCK_SZ 256
+
+struct jl_alloc_site_table_t {
+    vector<jl_alloc_site_stat_t*> blocks; // ALLOC_SITE_BLOCK_SZ stats each
+};
+
+JL_DLLEXPORT int jl_alloc_site_tracking_enabled = 0;
+static std::mutex alloc_site_lock; // guards the registry and table growth
+static vector<jl_alloc_site_info_t> alloc_site_registry;
+static vector<jl_alloc_site_table_t*> alloc_site_tables; // one per thread
+
+JL_DLLEXPORT void jl_start_alloc_site_tracking(void) {
+    std::lock_guard<std::mutex> lock(alloc_site_lock);
+    while (alloc_site_tables.size() < (size_t)jl_n_threads)
+        alloc_site_tables.push_back(new jl_alloc_site_table_t());
+    jl_alloc_site_tracking_enabled = 1;
+}
+
+JL_DLLEXPORT void jl_stop_alloc_site_tracking(void) {
+    // already-compiled code keeps its instrumentation calls, but the
+    // counters stop moving
+    jl_alloc_site_tracking_enabled = 0;
+}
+
+JL_DLLEXPORT uint32_t jl_register_alloc_site(const char *func, const char *file, int line) {
+    std::lock_guard<std::mutex> lock(alloc_site_lock);
+    jl_alloc_site_info_t info;
+    info.func = func ? strdup(func) : "";
+    info.file = file ? strdup(file) : "";
+    info.line = line;
+    alloc_site_registry.push_back(info);
+    return (uint32_t)(alloc_site_registry.size() - 1);
+}
+
+JL_DLLEXPORT size_t jl_alloc_site_count(void) {
+    std::lock_guard<std::mutex> lock(alloc_site_lock);
+    return alloc_site_registry.size();
+}
+
+JL_DLLEXPORT jl_alloc_site_info_t jl_alloc_site_info(uint32_t site) {
+    std::lock_guard<std::mutex> lock(alloc_site_lock);
+    if (site >= alloc_site_registry.size()) {
+        jl_alloc_site_info_t empty = {"", "", -1};
+        return empty;
+    }
+    return alloc_site_registry[site];
+}
+
+JL_DLLEXPORT void jl_count_alloc_site(uint32_t site, jl_value_t *type, size_t bytes) JL_NOTSAFEPOINT {
+    if (!jl_alloc_site_tracking_enabled)
+        return;
+    size_t tid = (size_t)jl_atomic_load_relaxed(&jl_current_task->tid);
+    if (tid >= alloc_site_tables.size())
+        return;
+    jl_alloc_site_table_t *table = alloc_site_tables[tid];
+    size_t block = site / ALLOC_SITE_BLOCK_SZ;
+    if (block >= table->blocks.size() || table->blocks[block] == NULL) {
+        // rare: first time this thread hits a site in this block
+        std::lock_guard<std::mutex> lock(alloc_site_lock);
+        if (block >= table->blocks.size())
+            table->blocks.resize(block + 1, NULL);
+        if (table->blocks[block] == NULL)
+            table->blocks[block] = (jl_alloc_site_stat_t*)calloc(
+                ALLOC_SITE_BLOCK_SZ, sizeof(jl_alloc_site_stat_t));
+    }
+    jl_alloc_site_stat_t *stat = &table->blocks[block][site % ALLOC_SITE_BLOCK_SZ];
+    stat->count++;
+    stat->bytes += bytes;
+    stat->type = type;
+}
+
+JL_DLLEXPORT jl_alloc_site_stat_t jl_fetch_alloc_site(uint32_t site) {
+    // live query: sums whatever each thread has counted so far
+    jl_alloc_site_stat_t sum = {0, 0, NULL};
+    std::lock_guard<std::mutex> lock(alloc_site_lock);
+    size_t block = site / ALLOC_SITE_BLOCK_SZ;
+    for (auto *table : alloc_site_tables) {
+        if (block >= table->blocks.size() || table->blocks[block] == NULL)
+            continue;
+        jl_alloc_site_stat_t *stat = &table->blocks[block][site % ALLOC_SITE_BLOCK_SZ];
+        sum.count += stat->count;
+        sum.bytes += stat->bytes;
+        if (stat->type)
+            sum.type = stat->type;
+    }
+    return sum;
+}
+
 }  // extern "C"
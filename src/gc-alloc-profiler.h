@@ -23,22 +23,70 @@ typedef struct {
 } jl_profile_allocs_raw_results_t;
 
 JL_DLLEXPORT void jl_start_alloc_profile(double sample_rate);
+JL_DLLEXPORT void jl_start_alloc_profile_sampled(size_t sample_interval_bytes);
 JL_DLLEXPORT jl_profile_allocs_raw_results_t jl_fetch_alloc_profile(void);
 JL_DLLEXPORT void jl_stop_alloc_profile(void);
 JL_DLLEXPORT void jl_free_alloc_profile(void);
 
+// ---------------------------------------------------------------------
+// Per-site allocation counters (alloc-site tracking)
+// ---------------------------------------------------------------------
+
+// Aggregated counters for one codegen allocation site. `type` is the tag
+// most recently allocated at the site (sites are almost always
+// monomorphic, so one slot suffices).
+typedef struct {
+    uint64_t count;
+    uint64_t bytes;
+    jl_value_t *type;
+} jl_alloc_site_stat_t;
+
+// Source location registered for a site at emission time.
+typedef struct {
+    const char *func;
+    const char *file;
+    int line;
+} jl_alloc_site_info_t;
+
+// Nonzero while site tracking is on. Codegen checks this at emission
+// time, so only code compiled after jl_start_alloc_site_tracking carries
+// the instrumentation; sysimage code is never instrumented.
+extern JL_DLLEXPORT int jl_alloc_site_tracking_enabled;
+
+JL_DLLEXPORT void jl_start_alloc_site_tracking(void);
+JL_DLLEXPORT void jl_stop_alloc_site_tracking(void);
+JL_DLLEXPORT uint32_t jl_register_alloc_site(const char *func, const char *file, int line);
+JL_DLLEXPORT void jl_count_alloc_site(uint32_t site, jl_value_t *type, size_t bytes) JL_NOTSAFEPOINT;
+JL_DLLEXPORT size_t jl_alloc_site_count(void);
+JL_DLLEXPORT jl_alloc_site_info_t jl_alloc_site_info(uint32_t site);
+JL_DLLEXPORT jl_alloc_site_stat_t jl_fetch_alloc_site(uint32_t site);
+
 // ---------------------------------------------------------------------
 // Functions to call from GC when alloc profiling is enabled
 // ---------------------------------------------------------------------
 
 void _maybe_record_alloc_to_profile(jl_value_t *val, size_t size, jl_datatype_t *typ) JL_NOTSAFEPOINT;
 
-extern int g_alloc_profile_enabled;
+// exported so that the inline pool-allocation fast path emitted by
+// llvm-final-gc-lowering can test it and fall back to jl_gc_pool_alloc
+extern JL_DLLEXPORT int g_alloc_profile_enabled;
+// When nonzero, only every `g_alloc_profile_interval`-th allocated byte is
+// recorded (per-thread byte countdown) instead of coin-flipping per
+// allocation, which is cheap enough to leave enabled on live services.
+extern size_t g_alloc_profile_interval;
 
 #define jl_gc_unknown_type_tag ((jl_datatype_t*)0xdeadaa03)
 
 static inline void maybe_record_alloc_to_profile(jl_value_t *val, size_t size, jl_datatype_t *typ) JL_NOTSAFEPOINT {
     if (__unlikely(g_alloc_profile_enabled)) {
+        if (g_alloc_profile_interval) {
+            jl_ptls_t ptls = jl_current_task->ptls;
+            if (__likely(ptls->alloc_profile_countdown > size)) {
+                ptls->alloc_profile_countdown -= size;
+                return;
+            }
+            ptls->alloc_profile_countdown = g_alloc_profile_interval;
+        }
         _maybe_record_alloc_to_profile(val, size, typ);
     }
 }
@@ -100,7 +100,7 @@ static arraylist_t bits_save[4];
 static void gc_clear_mark_page(jl_gc_pagemeta_t *pg, int bits)
 {
     jl_ptls_t ptls2 = jl_all_tls_states[pg->thread_n];
-    jl_gc_pool_t *pool = &ptls2->heap.norm_pools[pg->pool_n];
+    jl_gc_pool_t *pool = gc_pool_from_n(ptls2, pg->pool_n);
     jl_taggedvalue_t *pv = (jl_taggedvalue_t*)(pg->data + GC_PAGE_OFFSET);
     char *lim = (char*)pv + GC_PAGE_SZ - GC_PAGE_OFFSET - pool->osize;
     while ((char*)pv <= lim) {
@@ -298,7 +298,7 @@ static void gc_verify_tags_page(jl_gc_pagemeta_t *pg)
     int p_n = pg->pool_n;
     int t_n = pg->thread_n;
     jl_ptls_t ptls2 = jl_all_tls_states[t_n];
-    jl_gc_pool_t *p = &ptls2->heap.norm_pools[p_n];
+    jl_gc_pool_t *p = gc_pool_from_n(ptls2, p_n);
     int osize = pg->osize;
     char *data = pg->data;
     char *page_begin = data + GC_PAGE_OFFSET;
@@ -403,9 +403,9 @@ void gc_verify_tags(void)
     // verify the freelist chains look valid
     for (int t_i = 0; t_i < jl_n_threads; t_i++) {
         jl_ptls_t ptls2 = jl_all_tls_states[t_i];
-        for (int i = 0; i < JL_GC_N_POOLS; i++) {
+        for (int i = 0; i < 2 * JL_GC_N_POOLS; i++) {
             // for all pools, iterate its freelist
-            jl_gc_pool_t *p = &ptls2->heap.norm_pools[i];
+            jl_gc_pool_t *p = gc_pool_from_n(ptls2, i);
             jl_taggedvalue_t *next = p->freelist;
             jl_taggedvalue_t *last = NULL;
             char *allocating = gc_page_data(next);
@@ -1084,16 +1084,17 @@ static size_t pool_stats(jl_gc_pool_t *p, size_t *pwaste, size_t *np,
 void gc_stats_all_pool(void)
 {
     size_t nb=0, w, tw=0, no=0, tp=0, nold=0, noldbytes=0, np, nol;
-    for (int i = 0; i < JL_GC_N_POOLS; i++) {
+    for (int i = 0; i < 2 * JL_GC_N_POOLS; i++) {
         for (int t_i = 0; t_i < jl_n_threads; t_i++) {
             jl_ptls_t ptls2 = jl_all_tls_states[t_i];
-            size_t b = pool_stats(&ptls2->heap.norm_pools[i], &w, &np, &nol);
+            jl_gc_pool_t *p = gc_pool_from_n(ptls2, i);
+            size_t b = pool_stats(p, &w, &np, &nol);
             nb += b;
-            no += (b / ptls2->heap.norm_pools[i].osize);
+            no += (b / p->osize);
             tw += w;
             tp += np;
             nold += nol;
-            noldbytes += nol * ptls2->heap.norm_pools[i].osize;
+            noldbytes += nol * p->osize;
         }
     }
     jl_safe_printf("%lld objects (%lld%% old), %lld kB (%lld%% old) total allocated, "
@@ -1402,6 +1403,215 @@ NOINLINE void gc_mark_loop_unwind(jl_ptls_t ptls, jl_gc_mark_sp_t sp, int pc_off
     jl_set_safe_restore(old_buf);
 }
 
+// heap snapshot
+
+// Streams a compact binary graph of the live heap to a file so that
+// retention (dominator-tree) analysis can be done offline:
+//   header:  "JLHEAP01", uint8 sizeof(void*)
+//   'T' <type addr> <uint32 len> <name bytes>   -- first time a type is seen
+//   'N' <obj addr> <type addr> <size_t size>    -- one per reachable object
+//   'E' <from addr> <to addr>                   -- one per reference
+// Nodes are discovered by a breadth-first walk that decodes object layouts
+// directly (fields, svec and array elements, module bindings), so the GC
+// mark state is left untouched. Weak references are emitted as nodes without
+// outgoing edges. Task stacks are not walked; objects only reachable from a
+// stack frame appear as edge targets without a node record and can be
+// treated as external roots by the analysis.
+
+static ios_t heapsnap_io;
+static htable_t heapsnap_seen;
+static htable_t heapsnap_types;
+static arraylist_t heapsnap_queue;
+
+static void heapsnap_write_ptr(uintptr_t p) JL_NOTSAFEPOINT
+{
+    ios_write(&heapsnap_io, (const char*)&p, sizeof(p));
+}
+
+static void heapsnap_push(jl_value_t *v) JL_NOTSAFEPOINT
+{
+    if (v == NULL || ptrhash_has(&heapsnap_seen, v))
+        return;
+    ptrhash_put(&heapsnap_seen, v, (void*)1);
+    arraylist_push(&heapsnap_queue, v);
+}
+
+static void heapsnap_edge(jl_value_t *from, jl_value_t *to) JL_NOTSAFEPOINT
+{
+    if (to == NULL)
+        return;
+    ios_putc('E', &heapsnap_io);
+    heapsnap_write_ptr((uintptr_t)from);
+    heapsnap_write_ptr((uintptr_t)to);
+    heapsnap_push(to);
+}
+
+static void heapsnap_type(jl_value_t *vt) JL_NOTSAFEPOINT
+{
+    if (ptrhash_has(&heapsnap_types, vt))
+        return;
+    ptrhash_put(&heapsnap_types, vt, (void*)1);
+    const char *name = "?";
+    if (jl_is_datatype(vt))
+        name = jl_symbol_name(((jl_datatype_t*)vt)->name->name);
+    uint32_t len = (uint32_t)strlen(name);
+    ios_putc('T', &heapsnap_io);
+    heapsnap_write_ptr((uintptr_t)vt);
+    ios_write(&heapsnap_io, (const char*)&len, sizeof(len));
+    ios_write(&heapsnap_io, name, len);
+}
+
+// emit an edge for every pointer slot `ly` describes at `base`
+static void heapsnap_layout_edges(jl_value_t *from, char *base,
+                                  const jl_datatype_layout_t *ly) JL_NOTSAFEPOINT
+{
+    const uint8_t *ptrs8 = (const uint8_t*)jl_dt_layout_ptrs(ly);
+    const uint16_t *ptrs16 = (const uint16_t*)jl_dt_layout_ptrs(ly);
+    const uint32_t *ptrs32 = (const uint32_t*)jl_dt_layout_ptrs(ly);
+    for (size_t i = 0; i < ly->npointers; i++) {
+        uint32_t fld;
+        if (ly->fielddesc_type == 0)
+            fld = ptrs8[i];
+        else if (ly->fielddesc_type == 1)
+            fld = ptrs16[i];
+        else
+            fld = ptrs32[i];
+        heapsnap_edge(from, ((jl_value_t**)base)[fld]);
+    }
+}
+
+static void heapsnap_visit(jl_value_t *v) JL_NOTSAFEPOINT
+{
+    jl_value_t *vt = jl_typeof(v);
+    heapsnap_type(vt);
+    size_t sz = 0;
+    if (jl_is_datatype(vt) && ((jl_datatype_t*)vt)->layout)
+        sz = jl_datatype_size(vt);
+    if (jl_is_svec(v))
+        sz = sizeof(void*) * (jl_svec_len(v) + 1);
+    else if (jl_is_string(v))
+        sz = sizeof(size_t) + jl_string_len(v) + 1;
+    else if (jl_is_array(v))
+        sz = sizeof(jl_array_t) + jl_array_nbytes((jl_array_t*)v);
+    else if (jl_is_module(v))
+        sz = sizeof(jl_module_t);
+    ios_putc('N', &heapsnap_io);
+    heapsnap_write_ptr((uintptr_t)v);
+    heapsnap_write_ptr((uintptr_t)vt);
+    ios_write(&heapsnap_io, (const char*)&sz, sizeof(sz));
+
+    if (jl_is_svec(v)) {
+        jl_value_t **data = jl_svec_data(v);
+        size_t l = jl_svec_len(v);
+        for (size_t i = 0; i < l; i++)
+            heapsnap_edge(v, data[i]);
+    }
+    else if (jl_is_array(v)) {
+        jl_array_t *a = (jl_array_t*)v;
+        if (a->flags.how == 3)
+            heapsnap_edge(v, jl_array_data_owner(a));
+        size_t l = jl_array_len(a);
+        if (a->flags.ptrarray) {
+            jl_value_t **data = (jl_value_t**)a->data;
+            for (size_t i = 0; i < l; i++)
+                heapsnap_edge(v, data[i]);
+        }
+        else if (a->flags.hasptr) {
+            jl_datatype_t *et = (jl_datatype_t*)jl_tparam0(vt);
+            const jl_datatype_layout_t *ly = et->layout;
+            size_t elsize = a->elsize;
+            for (size_t i = 0; i < l; i++)
+                heapsnap_layout_edges(v, (char*)a->data + i * elsize, ly);
+        }
+    }
+    else if (jl_is_module(v)) {
+        jl_module_t *m = (jl_module_t*)v;
+        heapsnap_edge(v, (jl_value_t*)m->parent);
+        for (size_t i = 0; i < m->bindings.size; i += 2) {
+            if (m->bindings.table[i + 1] == HT_NOTFOUND)
+                continue;
+            jl_binding_t *b = (jl_binding_t*)m->bindings.table[i + 1];
+            heapsnap_edge(v, jl_atomic_load_relaxed(&b->value));
+            heapsnap_edge(v, jl_atomic_load_relaxed(&b->globalref));
+            heapsnap_edge(v, jl_atomic_load_relaxed(&b->ty));
+            heapsnap_edge(v, (jl_value_t*)b->owner);
+        }
+        for (size_t i = 0; i < m->usings.len; i++)
+            heapsnap_edge(v, (jl_value_t*)m->usings.items[i]);
+    }
+    else if ((jl_datatype_t*)vt == jl_weakref_type) {
+        // weak edges must not contribute to retained size
+    }
+    else if (jl_is_datatype(vt) && ((jl_datatype_t*)vt)->layout &&
+             ((jl_datatype_t*)vt)->layout->npointers > 0) {
+        heapsnap_layout_edges(v, (char*)v, ((jl_datatype_t*)vt)->layout);
+    }
+}
+
+// Push the (object, finalizer) pairs of a finalizer list; a tag bit on the
+// object means the finalizer is a raw C function pointer, not an object.
+static void heapsnap_push_finlist(arraylist_t *list) JL_NOTSAFEPOINT
+{
+    for (size_t i = 0; i < list->len; i += 2) {
+        void *v0 = list->items[i];
+        if (v0 == NULL)
+            continue;
+        heapsnap_push((jl_value_t*)gc_ptr_clear_tag(v0, 1));
+        if (!gc_ptr_tag(v0, 1))
+            heapsnap_push((jl_value_t*)list->items[i + 1]);
+    }
+}
+
+// Write a snapshot of everything reachable from the global and thread roots
+// to `path`. The caller is responsible for quiescing other threads (e.g.
+// calling this from a breakpoint or with a single thread); allocation and
+// collection are disabled for the duration of the walk.
+JL_DLLEXPORT int jl_gc_take_heap_snapshot(const char *path)
+{
+    if (ios_file(&heapsnap_io, path, 1, 1, 1, 1) == NULL)
+        return -1;
+    int en = jl_gc_enable(0);
+    htable_new(&heapsnap_seen, 8192);
+    htable_new(&heapsnap_types, 256);
+    arraylist_new(&heapsnap_queue, 0);
+    ios_write(&heapsnap_io, "JLHEAP01", 8);
+    ios_putc(sizeof(void*), &heapsnap_io);
+
+    // globals, mirroring mark_roots
+    heapsnap_push((jl_value_t*)jl_main_module);
+    heapsnap_push(jl_an_empty_vec_any);
+    heapsnap_push((jl_value_t*)jl_module_init_order);
+    for (size_t i = 0; i < jl_current_modules.size; i += 2) {
+        if (jl_current_modules.table[i + 1] != HT_NOTFOUND)
+            heapsnap_push((jl_value_t*)jl_current_modules.table[i]);
+    }
+    heapsnap_push(jl_anytuple_type_type);
+    heapsnap_push((jl_value_t*)jl_all_methods);
+    heapsnap_push((jl_value_t*)_jl_debug_method_invalidation);
+    heapsnap_push((jl_value_t*)jl_emptytuple_type);
+
+    // per-thread roots and finalizers
+    for (int t_i = 0; t_i < jl_n_threads; t_i++) {
+        jl_ptls_t ptls2 = jl_all_tls_states[t_i];
+        heapsnap_push((jl_value_t*)ptls2->root_task);
+        heapsnap_push((jl_value_t*)jl_atomic_load_relaxed(&ptls2->current_task));
+        heapsnap_push(ptls2->previous_exception);
+        heapsnap_push_finlist(&ptls2->finalizers);
+    }
+    heapsnap_push_finlist(&to_finalize);
+    heapsnap_push_finlist(&finalizer_list_marked);
+
+    while (heapsnap_queue.len > 0)
+        heapsnap_visit((jl_value_t*)arraylist_pop(&heapsnap_queue));
+
+    ios_close(&heapsnap_io);
+    arraylist_free(&heapsnap_queue);
+    htable_free(&heapsnap_types);
+    htable_free(&heapsnap_seen);
+    jl_gc_enable(en);
+    return 0;
+}
+
 static int gc_logging_enabled = 0;
 
 JL_DLLEXPORT void jl_enable_gc_logging(int enable) {
@@ -21,10 +21,70 @@ extern "C" {
 static int block_pg_cnt = DEFAULT_BLOCK_PG_ALLOC;
 static size_t current_pg_count = 0;
 
+// Conservative address bounds of the pool-page space, widened under
+// `gc_perm_lock` whenever a new page block is mapped and read lock-free
+// through jl_gc_pool_heap_bounds. The range can span unmapped gaps between
+// blocks, so it only serves as a prefilter: a hit still has to be confirmed
+// through `page_metadata`. A miss, however, definitively rules out a pool
+// pointer, which is what makes conservative scans of foreign stacks cheap --
+// nearly every word on them rejects on the two comparisons alone.
+static _Atomic(uintptr_t) gc_pools_lo = ~(uintptr_t)0;
+static _Atomic(uintptr_t) gc_pools_hi = 0;
+
+JL_DLLEXPORT void jl_gc_pool_heap_bounds(uintptr_t *lo, uintptr_t *hi) JL_NOTSAFEPOINT
+{
+    *lo = jl_atomic_load_relaxed(&gc_pools_lo);
+    *hi = jl_atomic_load_relaxed(&gc_pools_hi);
+}
+
+// When enabled (JULIA_GC_HUGEPAGES=1), page blocks are aligned to the
+// hugepage size and madvise(MADV_HUGEPAGE)d so the kernel can back the pool
+// with transparent hugepages, cutting TLB misses on very large heaps.
+#define GC_HUGEPAGE_SZ ((size_t)2 * 1024 * 1024)
+static int gc_hugepages_enabled = 0;
+
+// Confined-heap mode (JULIA_GC_COMPRESSED_HEAP, 64-bit unix only): all pool
+// pages are carved out of one contiguous PROT_NONE reservation so that a pool
+// object can be named by a 32-bit offset from jl_gc_heap_base (the jl_cref_t
+// encoding in julia.h). The reservation is capped at 32GB, the most a 32-bit
+// offset can span at the 8-byte granule; allocation past the cap throws
+// jl_memory_exception through the usual out-of-pages path. The first GC page
+// of the reservation is never handed out so that offset 0 stays NULL.
+JL_DLLEXPORT uintptr_t jl_gc_heap_base = 0;
+JL_DLLEXPORT size_t jl_gc_heap_size = 0;
+#define GC_CONFINED_HEAP_MAX_SZ (((size_t)1 << 32) << JL_CREF_SHIFT) // 32GB
+static uintptr_t confined_heap_cursor = 0;
+
 void jl_gc_init_page(void)
 {
     if (GC_PAGE_SZ * block_pg_cnt < jl_page_size)
         block_pg_cnt = jl_page_size / GC_PAGE_SZ; // exact division
+    char *hp = getenv("JULIA_GC_HUGEPAGES");
+    if (hp && atoi(hp))
+        gc_hugepages_enabled = 1;
+#if defined(_P64) && !defined(_OS_WINDOWS_)
+    char *ch = getenv("JULIA_GC_COMPRESSED_HEAP");
+    if (ch && atoi(ch)) {
+        // over-allocate so the base can be aligned to the gc page data size,
+        // then trim; pages stay PROT_NONE until jl_gc_try_alloc_pages
+        // commits them
+        size_t map_sz = GC_CONFINED_HEAP_MAX_SZ + GC_PAGE_SZ;
+        char *raw = (char*)mmap(0, map_sz, PROT_NONE,
+                                MAP_NORESERVE | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw != MAP_FAILED) {
+            char *aligned = (char*)gc_page_data(raw + GC_PAGE_SZ - 1);
+            if (aligned != raw)
+                munmap(raw, aligned - raw);
+            size_t tail = map_sz - (aligned - raw) - GC_CONFINED_HEAP_MAX_SZ;
+            if (tail)
+                munmap(aligned + GC_CONFINED_HEAP_MAX_SZ, tail);
+            jl_gc_heap_base = (uintptr_t)aligned;
+            jl_gc_heap_size = GC_CONFINED_HEAP_MAX_SZ;
+            confined_heap_cursor = jl_gc_heap_base + GC_PAGE_SZ; // keep offset 0 as NULL
+        }
+        // reservation failure silently falls back to the unconfined layout
+    }
+#endif
 }
 
 #ifndef MAP_NORESERVE // not defined in POSIX, FreeBSD, etc.
@@ -36,6 +96,26 @@ void jl_gc_init_page(void)
 static char *jl_gc_try_alloc_pages(int pg_cnt) JL_NOTSAFEPOINT
 {
     size_t pages_sz = GC_PAGE_SZ * pg_cnt;
+#if defined(_P64) && !defined(_OS_WINDOWS_)
+    if (confined_heap_cursor) {
+        // bump-carve from the confined reservation; `gc_perm_lock` is held
+        // by all callers, so the cursor needs no further synchronization.
+        // The base and every carve are GC_PAGE_SZ-aligned, so the page-data
+        // alignment fixup below is never needed on this path.
+        if (confined_heap_cursor + pages_sz > jl_gc_heap_base + jl_gc_heap_size)
+            return NULL; // 32-bit offset space exhausted
+        char *mem = (char*)confined_heap_cursor;
+        if (mprotect(mem, pages_sz, PROT_READ | PROT_WRITE) != 0)
+            return NULL;
+        confined_heap_cursor += pages_sz;
+#ifdef MADV_HUGEPAGE
+        if (gc_hugepages_enabled && pages_sz >= GC_HUGEPAGE_SZ &&
+            ((uintptr_t)mem % GC_HUGEPAGE_SZ) == 0)
+            madvise(mem, pages_sz, MADV_HUGEPAGE);
+#endif
+        return mem;
+    }
+#endif
 #ifdef _OS_WINDOWS_
     char *mem = (char*)VirtualAlloc(NULL, pages_sz + GC_PAGE_SZ,
                                     MEM_RESERVE, PAGE_READWRITE);
@@ -44,6 +124,26 @@ static char *jl_gc_try_alloc_pages(int pg_cnt) JL_NOTSAFEPOINT
 #else
     if (GC_PAGE_SZ > jl_page_size)
         pages_sz += GC_PAGE_SZ;
+#ifdef MADV_HUGEPAGE
+    if (gc_hugepages_enabled && pages_sz >= GC_HUGEPAGE_SZ) {
+        // over-allocate so the block can be aligned to the hugepage size,
+        // give back the slack, and ask for transparent hugepages; the
+        // result is hugepage-aligned and therefore also page-data aligned
+        size_t map_sz = pages_sz + GC_HUGEPAGE_SZ;
+        char *raw = (char*)mmap(0, map_sz, PROT_READ | PROT_WRITE,
+                                MAP_NORESERVE | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            return NULL;
+        char *aligned = (char*)LLT_ALIGN((uintptr_t)raw, GC_HUGEPAGE_SZ);
+        if (aligned != raw)
+            munmap(raw, aligned - raw);
+        size_t tail = map_sz - (aligned - raw) - pages_sz;
+        if (tail)
+            munmap(aligned + pages_sz, tail);
+        madvise(aligned, pages_sz, MADV_HUGEPAGE);
+        return aligned;
+    }
+#endif
     char *mem = (char*)mmap(0, pages_sz, PROT_READ | PROT_WRITE,
                             MAP_NORESERVE | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
     if (mem == MAP_FAILED)
@@ -87,6 +187,13 @@ static jl_gc_pagemeta_t *jl_gc_alloc_new_page(void) JL_NOTSAFEPOINT
         }
     }
 
+    // widen the conservative pool-space bounds; covering the whole block even
+    // if the metadata loop below trims it keeps the range a valid prefilter
+    if ((uintptr_t)mem < jl_atomic_load_relaxed(&gc_pools_lo))
+        jl_atomic_store_relaxed(&gc_pools_lo, (uintptr_t)mem);
+    if ((uintptr_t)mem + GC_PAGE_SZ * pg_cnt > jl_atomic_load_relaxed(&gc_pools_hi))
+        jl_atomic_store_relaxed(&gc_pools_hi, (uintptr_t)mem + GC_PAGE_SZ * pg_cnt);
+
     // now need to insert these pages into the pagetable metadata
     // if any allocation fails, this just stops recording more pages from that point
     // and will free (munmap) the remainder
@@ -151,6 +258,15 @@ static jl_gc_pagemeta_t *jl_gc_alloc_new_page(void) JL_NOTSAFEPOINT
 
     if (pg < pg_cnt) {
 #ifndef _OS_WINDOWS_
+#ifdef _P64
+        if (confined_heap_cursor) {
+            // hand the unrecorded tail back to the reservation; unmapping it
+            // would punch a hole in the confined region
+            mprotect(mem + GC_PAGE_SZ * pg, GC_PAGE_SZ * (pg_cnt - pg), PROT_NONE);
+            confined_heap_cursor = (uintptr_t)mem + GC_PAGE_SZ * pg;
+        }
+        else
+#endif
         // Trim the allocation to only cover the region
         // that we successfully created the metadata for.
         // This is not supported by the Windows kernel,
@@ -259,6 +375,11 @@ have_free_page:
     return info.meta;
 }
 
+size_t jl_gc_current_pg_count(void) JL_NOTSAFEPOINT
+{
+    return current_pg_count;
+}
+
 // return a page to the freemap allocator
 void jl_gc_free_page(void *p) JL_NOTSAFEPOINT
 {
@@ -286,6 +407,15 @@ void jl_gc_free_page(void *p) JL_NOTSAFEPOINT
 
     // tell the OS we don't need these pages right now
     size_t decommit_size = GC_PAGE_SZ;
+#ifdef MADV_HUGEPAGE
+    // decommitting a 16KB slice would split the backing hugepage; keep the
+    // memory resident and let the freemap recycle the page instead -- unless
+    // threads are pinned to NUMA nodes, where decommitting lets a recycled
+    // page re-fault on its next owner's node instead of staying wherever it
+    // was first touched
+    if (gc_hugepages_enabled && !jl_numa_pinned)
+        goto no_decommit;
+#endif
     if (GC_PAGE_SZ < jl_page_size) {
         // ensure so we don't release more memory than intended
         size_t n_pages = jl_page_size / GC_PAGE_SZ; // exact division
@@ -302,6 +432,18 @@ void jl_gc_free_page(void *p) JL_NOTSAFEPOINT
     }
 #ifdef _OS_WINDOWS_
     VirtualFree(p, decommit_size, MEM_DECOMMIT);
+#elif defined(MADV_FREE)
+    // MADV_FREE keeps the mapping intact and only lets the kernel reclaim
+    // the pages lazily if it needs them, so a page that gets recycled soon
+    // afterwards doesn't pay a re-fault; escalate to the eager
+    // MADV_DONTNEED while an external monitor reports memory pressure
+    // (jl_gc_notify_memory_pressure) or the heap is over its soft
+    // footprint target (jl_gc_set_softlimit)
+    if (jl_atomic_load_relaxed(&gc_mem_pressure) ||
+        jl_atomic_load_relaxed(&gc_heap_over_softlimit))
+        madvise(p, decommit_size, MADV_DONTNEED);
+    else
+        madvise(p, decommit_size, MADV_FREE);
 #else
     madvise(p, decommit_size, MADV_DONTNEED);
 #endif
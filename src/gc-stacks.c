@@ -22,6 +22,9 @@
 // number of stacks to always keep available per pool
 #define MIN_STACK_MAPPINGS_PER_POOL 5
 
+// number of dead task shells kept per thread for reuse by jl_new_task
+#define RECYCLED_TASKS_PER_THREAD 128
+
 const size_t jl_guard_size = (4096 * 8);
 static _Atomic(uint32_t) num_stack_mappings = 0;
 
@@ -52,7 +55,17 @@ static void free_stack(void *stkbuf, size_t bufsz)
 
 static void *malloc_stack(size_t bufsz) JL_NOTSAFEPOINT
 {
-    void* stk = mmap(0, bufsz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_STACK
+    flags |= MAP_STACK; // set up the VMA with stack-appropriate kernel hints
+#endif
+#ifdef MAP_NORESERVE
+    // reserve address space only: pages are committed on first touch, so the
+    // default (multi-MB) task stacks cost nothing until actually used, even
+    // under strict overcommit accounting
+    flags |= MAP_NORESERVE;
+#endif
+    void* stk = mmap(0, bufsz, PROT_READ | PROT_WRITE, flags, -1, 0);
     if (stk == MAP_FAILED)
         return MAP_FAILED;
 #if !defined(JL_HAVE_UCONTEXT) && !defined(JL_HAVE_SIGALTSTACK)
@@ -71,6 +84,19 @@ static void free_stack(void *stkbuf, size_t bufsz)
     munmap(stkbuf, bufsz);
     jl_atomic_fetch_add(&num_stack_mappings, -1);
 }
+
+// Hand a pooled stack's pages back to the kernel while keeping the mapping
+// (and its guard page) installed. The stack stays on the freelist; reusing it
+// later just refaults zero pages, which is far cheaper than a fresh
+// mmap+mprotect, so task spawn cost stays a freelist pop across GC cycles.
+static void decommit_stack(void *stkbuf, size_t bufsz) JL_NOTSAFEPOINT
+{
+#if defined(MADV_FREE)
+    madvise((char*)stkbuf + jl_guard_size, bufsz - jl_guard_size, MADV_FREE);
+#elif defined(MADV_DONTNEED)
+    madvise((char*)stkbuf + jl_guard_size, bufsz - jl_guard_size, MADV_DONTNEED);
+#endif
+}
 #endif
 
 
@@ -153,6 +179,8 @@ JL_DLLEXPORT void *jl_malloc_stack(size_t *bufsz, jl_task_t *owner) JL_NOTSAFEPO
         arraylist_t *pool = &ptls->heap.free_stacks[pool_id];
         if (pool->len > 0) {
             stk = arraylist_pop(pool);
+            if (ptls->heap.decommitted_stacks[pool_id] > pool->len)
+                ptls->heap.decommitted_stacks[pool_id] = pool->len;
         }
     }
     else {
@@ -191,7 +219,7 @@ void sweep_stack_pools(void)
     for (int i = 0; i < jl_n_threads; i++) {
         jl_ptls_t ptls2 = jl_all_tls_states[i];
 
-        // free half of stacks that remain unused since last sweep
+        // trim half of stacks that remain unused since last sweep
         for (int p = 0; p < JL_N_STACK_POOLS; p++) {
             arraylist_t *al = &ptls2->heap.free_stacks[p];
             size_t n_to_free;
@@ -203,12 +231,41 @@ void sweep_stack_pools(void)
             else {
                 n_to_free = 0;
             }
-            for (int n = 0; n < n_to_free; n++) {
+#ifdef _OS_WINDOWS_
+            for (size_t n = 0; n < n_to_free; n++) {
                 void *stk = arraylist_pop(al);
                 free_stack(stk, pool_sizes[p]);
             }
+#else
+            if (n_to_free > 0 &&
+                jl_atomic_load_relaxed(&num_stack_mappings) > MAX_STACK_MAPPINGS / 2) {
+                // under mapping pressure, actually unmap the excess
+                for (size_t n = 0; n < n_to_free; n++) {
+                    void *stk = arraylist_pop(al);
+                    free_stack(stk, pool_sizes[p]);
+                }
+                if (ptls2->heap.decommitted_stacks[p] > al->len)
+                    ptls2->heap.decommitted_stacks[p] = al->len;
+            }
+            else {
+                // otherwise only give the pages back, keeping the mapping
+                // pooled for cheap reuse; the oldest (front) entries decay
+                // first, and already-decommitted ones are not revisited
+                uint32_t decommitted = ptls2->heap.decommitted_stacks[p];
+                for (size_t n = decommitted; n < n_to_free; n++)
+                    decommit_stack(al->items[n], pool_sizes[p]);
+                if (n_to_free > decommitted)
+                    ptls2->heap.decommitted_stacks[p] = n_to_free;
+            }
+#endif
         }
 
+        // Purge shells recycled by the previous sweep that jl_new_task did
+        // not take: nothing marked them, so the pool sweep following this
+        // pass reclaims their cells. Dropping our references first keeps the
+        // cache free of pointers into swept pages.
+        ptls2->heap.recycled_tasks.len = 0;
+
         arraylist_t *live_tasks = &ptls2->heap.live_tasks;
         size_t n = 0;
         size_t ndel = 0;
@@ -239,6 +296,29 @@ void sweep_stack_pools(void)
                     t->ctx.tsan_state = NULL;
                 }
 #endif
+                // The mark phase proved this shell unreachable. Instead of
+                // letting the pool sweep reclaim the cell, keep a bounded
+                // number per thread for jl_new_task to reinitialize: marking
+                // the cell lets it survive the coming sweep, and
+                // jl_gc_take_task_shell resets it to a clean young cell when
+                // it is taken. The value fields are cleared here since what
+                // they point to may be swept this cycle.
+                if (sizeof(jl_task_t) <= GC_MAX_SZCLASS &&
+                    ptls2->heap.recycled_tasks.len < RECYCLED_TASKS_PER_THREAD) {
+                    jl_astaggedvalue(t)->bits.gc = GC_MARKED;
+                    t->next = NULL;
+                    t->queue = NULL;
+                    t->tls = NULL;
+                    t->donenotify = NULL;
+                    t->result = NULL;
+                    t->logstate = NULL;
+                    t->start = NULL;
+                    t->gcstack = NULL;
+                    t->excstack = NULL;
+                    t->eh = NULL;
+                    t->ptls = NULL;
+                    arraylist_push(&ptls2->heap.recycled_tasks, t);
+                }
             }
             if (n >= l - ndel)
                 break;
@@ -250,6 +330,32 @@ void sweep_stack_pools(void)
     }
 }
 
+// Hand a recycled task shell to jl_new_task. The shell kept its type tag, so
+// the caller reinitializes every field exactly as for a fresh allocation; the
+// cache is popped only by its owning thread, so no synchronization is needed.
+jl_task_t *jl_gc_take_task_shell(jl_ptls_t ptls) JL_NOTSAFEPOINT
+{
+    arraylist_t *cache = &ptls->heap.recycled_tasks;
+    if (cache->len == 0)
+        return NULL;
+    jl_task_t *t = (jl_task_t*)arraylist_pop(cache);
+    // The sweep following the shell's resurrection set its age bit and, if
+    // the bit was already set, promoted it to GC_OLD. jl_new_task fills the
+    // fields with plain stores and no write barriers, so the shell must
+    // start over as a clean young object; an old shell would hold
+    // unrecorded references to young values, which a quick collection
+    // would then free out from under the task.
+    jl_taggedvalue_t *o = jl_astaggedvalue(t);
+    o->bits.gc = GC_CLEAN;
+    jl_gc_pagemeta_t *page = page_metadata(o);
+    page->has_young = 1;
+    char *page_begin = gc_page_data(o) + GC_PAGE_OFFSET;
+    int obj_id = (((char*)o) - page_begin) / page->osize;
+    uint8_t *ages = page->ages + obj_id / 8;
+    jl_atomic_fetch_and_relaxed((_Atomic(uint8_t)*)ages, ~(1 << (obj_id % 8)));
+    return t;
+}
+
 JL_DLLEXPORT jl_array_t *jl_live_tasks(void)
 {
     jl_task_t *ct = jl_current_task;
@@ -6,6 +6,9 @@
 #ifdef __GLIBC__
 #include <malloc.h> // for malloc_trim
 #endif
+#ifndef _OS_WINDOWS_
+#include <fcntl.h> // for the JULIA_GC_TELEMETRY backing file
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,6 +29,7 @@ static jl_gc_callback_list_t *gc_cblist_pre_gc;
 static jl_gc_callback_list_t *gc_cblist_post_gc;
 static jl_gc_callback_list_t *gc_cblist_notify_external_alloc;
 static jl_gc_callback_list_t *gc_cblist_notify_external_free;
+static jl_gc_callback_list_t *gc_cblist_memory_pressure;
 
 #define gc_invoke_callbacks(ty, list, args) \
     do { \
@@ -112,6 +116,14 @@ JL_DLLEXPORT void jl_gc_set_cb_notify_external_free(jl_gc_cb_notify_external_fre
         jl_gc_deregister_callback(&gc_cblist_notify_external_free, (jl_gc_cb_func_t)cb);
 }
 
+JL_DLLEXPORT void jl_gc_set_cb_memory_pressure(jl_gc_cb_memory_pressure_t cb, int enable)
+{
+    if (enable)
+        jl_gc_register_callback(&gc_cblist_memory_pressure, (jl_gc_cb_func_t)cb);
+    else
+        jl_gc_deregister_callback(&gc_cblist_memory_pressure, (jl_gc_cb_func_t)cb);
+}
+
 // Save/restore local mark stack to/from thread-local storage.
 
 STATIC_INLINE void export_gc_state(jl_ptls_t ptls, jl_gc_mark_sp_t *sp) {
@@ -182,6 +194,19 @@ bigval_t *big_objects_marked = NULL;
 arraylist_t finalizer_list_marked;
 arraylist_t to_finalize;
 JL_DLLEXPORT _Atomic(int) jl_gc_have_pending_finalizers = 0;
+// When enabled (JULIA_ASYNC_FINALIZERS=1 and more than one thread), the
+// collecting thread does not run the accumulated finalizers itself: it wakes
+// the scheduler pool and the threads drain `to_finalize` in bounded chunks,
+// concurrently with mutator execution.
+JL_DLLEXPORT int jl_gc_async_finalizers = 0;
+// number of threads currently inside jl_gc_run_finalizers_in_list on a
+// chunk taken from `to_finalize`; used by jl_gc_flush_finalizers
+static _Atomic(int) n_finalizers_running = 0;
+// pairs drained per run_finalizers call in async mode, so no single thread
+// gets stuck with a multi-hundred-ms backlog
+#define GC_FINALIZER_CHUNK 4096
+
+static void gc_hist_record(jl_gc_phase_t phase, uint64_t ns) JL_NOTSAFEPOINT;
 
 NOINLINE uintptr_t gc_get_stack_ptr(void)
 {
@@ -399,22 +424,44 @@ static void run_finalizers(jl_task_t *ct)
         return;
     }
     arraylist_t copied_list;
-    memcpy(&copied_list, &to_finalize, sizeof(copied_list));
-    if (to_finalize.items == to_finalize._space) {
-        copied_list.items = copied_list._space;
+    int more = 0;
+    if (jl_gc_async_finalizers && to_finalize.len > 2 * GC_FINALIZER_CHUNK) {
+        // take the newest chunk off the tail, so each chunk still runs in
+        // reverse insertion order; the rest stays pending for other threads
+        size_t nmove = 2 * GC_FINALIZER_CHUNK;
+        size_t rest = to_finalize.len - nmove;
+        arraylist_new(&copied_list, nmove);
+        memcpy(copied_list.items, to_finalize.items + rest, nmove * sizeof(void*));
+        copied_list.len = nmove;
+        to_finalize.len = rest;
+        more = 1;
+    }
+    else {
+        memcpy(&copied_list, &to_finalize, sizeof(copied_list));
+        if (to_finalize.items == to_finalize._space) {
+            copied_list.items = copied_list._space;
+        }
+        jl_atomic_store_relaxed(&jl_gc_have_pending_finalizers, 0);
+        arraylist_new(&to_finalize, 0);
     }
-    jl_atomic_store_relaxed(&jl_gc_have_pending_finalizers, 0);
-    arraylist_new(&to_finalize, 0);
 
     uint64_t save_rngState[4];
     memcpy(&save_rngState[0], &ct->rngState[0], sizeof(save_rngState));
     jl_rng_split(ct->rngState, finalizer_rngState);
 
+    jl_atomic_fetch_add_relaxed(&n_finalizers_running, 1);
+    uint64_t ft0 = jl_hrtime();
     // This releases the finalizers lock.
     jl_gc_run_finalizers_in_list(ct, &copied_list);
+    gc_hist_record(JL_GC_PHASE_FINALIZERS, jl_hrtime() - ft0);
+    jl_atomic_fetch_add_relaxed(&n_finalizers_running, -1);
     arraylist_free(&copied_list);
 
     memcpy(&ct->rngState[0], &save_rngState[0], sizeof(save_rngState));
+    if (more) {
+        // recruit another thread for the remaining chunks
+        jl_wakeup_thread(-1);
+    }
 }
 
 JL_DLLEXPORT void jl_gc_run_pending_finalizers(jl_task_t *ct)
@@ -429,6 +476,24 @@ JL_DLLEXPORT void jl_gc_run_pending_finalizers(jl_task_t *ct)
     }
 }
 
+// Wait until every finalizer enqueued so far has run, for callers that need
+// ordering with respect to finalization (e.g. reopening a file whose old
+// handle is still awaiting its close finalizer). Drains pending chunks from
+// the calling thread where permitted and waits out chunks in flight on other
+// threads. The caller must be in a context that may run finalizers, or other
+// threads must be available to drain them.
+JL_DLLEXPORT void jl_gc_flush_finalizers(void)
+{
+    jl_task_t *ct = jl_current_task;
+    jl_wakeup_thread(-1);
+    while (jl_atomic_load_relaxed(&jl_gc_have_pending_finalizers) ||
+           jl_atomic_load_acquire(&n_finalizers_running) != 0) {
+        jl_gc_run_pending_finalizers(ct);
+        jl_cpu_pause();
+        jl_gc_safepoint();
+    }
+}
+
 JL_DLLEXPORT int jl_gc_get_finalizers_inhibited(jl_ptls_t ptls)
 {
     if (ptls == NULL)
@@ -503,7 +568,11 @@ void jl_gc_run_all_finalizers(jl_task_t *ct)
         if (ptls2)
             schedule_all_finalizers(&ptls2->finalizers);
     }
-    run_finalizers(ct);
+    // in async mode run_finalizers only drains one chunk per call, and at
+    // shutdown no other thread will take the rest
+    do {
+        run_finalizers(ct);
+    } while (to_finalize.len > 0);
 }
 
 void jl_gc_add_finalizer_(jl_ptls_t ptls, void *v, void *f) JL_NOTSAFEPOINT
@@ -621,6 +690,18 @@ static size_t max_collect_interval =  500000000UL;
 // on 32 bit architectures.
 memsize_t max_total_memory = (memsize_t) 2 * 1024 * 1024 * 1024;
 #endif
+// Soft footprint target (0 = disabled). Unlike max_total_memory this is not
+// an allocation ceiling the collector strains against, but a size it steers
+// the heap back towards: collections are scheduled before the heap would
+// pass it, going over it forces a full sweep, and while over it freed pool
+// pages are returned to the OS eagerly (see jl_gc_free_page).
+static memsize_t gc_soft_target = 0;
+// gc_mem_pressure is set by external monitors through
+// jl_gc_notify_memory_pressure; gc_heap_over_softlimit tracks whether the
+// last collection left live_bytes over gc_soft_target. Both are read by
+// jl_gc_free_page to pick between MADV_FREE and MADV_DONTNEED.
+_Atomic(int) gc_mem_pressure = 0;
+_Atomic(int) gc_heap_over_softlimit = 0;
 
 // global variables for GC stats
 
@@ -688,6 +769,56 @@ static int64_t live_bytes = 0;
 static int64_t promoted_bytes = 0;
 static int64_t last_live_bytes = 0; // live_bytes at last collection
 static int64_t t_start = 0; // Time GC starts;
+
+// Out-of-band heap telemetry (see jl_gc_telemetry_t in julia.h). The
+// collecting thread is the only writer and brackets each update with an
+// odd/even bump of `seq`, so samplers need nothing but plain loads and a
+// retry loop: safe at signal time, and from another process when
+// JULIA_GC_TELEMETRY names a file the page is mapped from.
+static jl_gc_telemetry_t gc_telemetry_static;
+static jl_gc_telemetry_t *gc_telemetry = &gc_telemetry_static;
+
+static void gc_telemetry_update(int pause_in_progress, uint64_t pause_ns) JL_NOTSAFEPOINT
+{
+    jl_gc_telemetry_t *p = gc_telemetry;
+    _Atomic(uint64_t) *seq = (_Atomic(uint64_t)*)&p->seq;
+    static_assert(sizeof(_Atomic(uint64_t)) == sizeof(p->seq), "");
+    uint64_t s = jl_atomic_load_relaxed(seq);
+    jl_atomic_store_release(seq, s + 1);
+    jl_fence();
+    p->timestamp = jl_hrtime();
+    p->pause_in_progress = pause_in_progress;
+    p->collections = gc_num.pause;
+    p->full_sweeps = gc_num.full_sweep;
+    p->live_bytes = live_bytes;
+    p->allocd = gc_num.allocd;
+    p->total_allocd = gc_num.total_allocd;
+    p->freed = gc_num.freed;
+    p->total_time = gc_num.total_time;
+    if (pause_ns)
+        p->last_pause = pause_ns;
+    p->max_pause = gc_num.max_pause;
+    p->pool_pages = jl_gc_current_pg_count();
+    jl_fence();
+    jl_atomic_store_release(seq, s + 2);
+}
+
+JL_DLLEXPORT const jl_gc_telemetry_t *jl_gc_telemetry_page(void) JL_NOTSAFEPOINT
+{
+    return gc_telemetry;
+}
+
+// Pause budget controller (jl_gc_set_max_pause). A quick collection's pause
+// grows with the allocation accumulated since the last one, so with a budget
+// set we keep an estimate of the pause cost per allocated byte and size
+// gc_num.interval so the predicted next pause fits the budget, and we defer
+// heuristic escalations to full sweeps while their predicted pause is over
+// budget (bounded by gc_full_defer_cap; memory pressure still forces them).
+static uint64_t gc_max_pause_ns = 0;     // 0: no budget (the default)
+static uint64_t gc_full_pause_est = 0;   // EMA of full-sweep pause, ns
+static double gc_ns_per_allocd = 0;      // EMA of quick pause / bytes allocd
+static int gc_full_deferred = 0;         // full sweeps vetoed since the last one
+static const int gc_full_defer_cap = 8;
 #ifdef __GLIBC__
 // maxrss at last malloc_trim
 static int64_t last_trim_maxrss = 0;
@@ -913,15 +1044,67 @@ void jl_gc_force_mark_old(jl_ptls_t ptls, jl_value_t *v) JL_NOTSAFEPOINT
 static inline void maybe_collect(jl_ptls_t ptls)
 {
     if (jl_atomic_load_relaxed(&ptls->gc_num.allocd) >= 0 || jl_gc_debug_check_other()) {
+        if (__unlikely(ptls->gc_arena_depth > 0) &&
+            jl_atomic_load_relaxed(&ptls->gc_num.allocd) < (int64_t)gc_num.interval) {
+            // inside a compiler arena region, defer the collection to the
+            // region exit, up to one extra collection interval of allocation
+            jl_gc_safepoint_(ptls);
+            return;
+        }
         jl_gc_collect(JL_GC_AUTO);
     }
     else {
         jl_gc_safepoint_(ptls);
     }
+    // cooperative preemption poll: the allocation entry points funneling
+    // through here may already run arbitrary Julia code via collection and
+    // finalizers, which makes them safe places to yield an overrunning task
+    if (__unlikely(jl_task_preempt_quantum != 0 &&
+                   jl_hrtime() >= ptls->preempt_deadline))
+        jl_task_maybe_preempt(ptls);
+}
+
+// Region ("arena") allocation mode for compiler temporaries. Inference and
+// type intersection churn through short-lived types, but any intermediate can
+// escape into the type caches, so giving them separate storage and freeing it
+// wholesale would be unsound. Instead a region defers the automatic
+// collections its allocations would trigger (see maybe_collect) and pays them
+// off with a single quick young-generation sweep on exit, which reclaims the
+// mostly-dead temporaries in one pass instead of repeatedly interrupting
+// compilation. Regions nest and are per-thread.
+JL_DLLEXPORT void jl_gc_begin_arena(void)
+{
+    jl_current_task->ptls->gc_arena_depth++;
+}
+
+JL_DLLEXPORT void jl_gc_end_arena(void)
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    assert(ptls->gc_arena_depth > 0);
+    if (--ptls->gc_arena_depth == 0 &&
+        jl_atomic_load_relaxed(&ptls->gc_num.allocd) >= 0) {
+        jl_gc_collect(JL_GC_INCREMENTAL);
+    }
 }
 
 // weak references
 
+// The per-ptls `heap.weak_refs` lists only hold weak refs that are still
+// young. Once a weak ref reaches the old generation it moves (exactly once,
+// cf. `finalizer_list_marked`) to `weak_refs_marked`, which is only scanned
+// after a full mark -- the only time its entries or their old values can
+// have died. The correctness gap is an old weak ref whose value is (or is
+// re-assigned to) a young object: weak refs are never traced through, so
+// such a ref drops out of the remset after one cycle. Those refs live in
+// `weak_refs_dirty`, the intergenerational weak-ref frontier, scanned every
+// collection: promotion pushes here when the value is still young, and the
+// premark re-adds any weak ref that took a write-barrier hit. Entries leave
+// when their value reaches the old generation (the marked list covers them
+// from then on) or dies. All three lists are mutated only with the world
+// stopped.
+static arraylist_t weak_refs_marked;
+static arraylist_t weak_refs_dirty;
+
 JL_DLLEXPORT jl_weakref_t *jl_gc_new_weakref_th(jl_ptls_t ptls,
                                                 jl_value_t *value)
 {
@@ -932,49 +1115,228 @@ JL_DLLEXPORT jl_weakref_t *jl_gc_new_weakref_th(jl_ptls_t ptls,
     return wr;
 }
 
+static void clear_weak_refs_in_list(void **lst, size_t l)
+{
+    for (size_t n = 0; n < l; n++) {
+        jl_weakref_t *wr = (jl_weakref_t*)lst[n];
+        if (!gc_marked(jl_astaggedvalue(wr->value)->bits.gc))
+            wr->value = (jl_value_t*)jl_nothing;
+    }
+}
+
 static void clear_weak_refs(void)
 {
     for (int i = 0; i < jl_n_threads; i++) {
         jl_ptls_t ptls2 = jl_all_tls_states[i];
-        size_t n, l = ptls2->heap.weak_refs.len;
-        void **lst = ptls2->heap.weak_refs.items;
-        for (n = 0; n < l; n++) {
-            jl_weakref_t *wr = (jl_weakref_t*)lst[n];
-            if (!gc_marked(jl_astaggedvalue(wr->value)->bits.gc))
-                wr->value = (jl_value_t*)jl_nothing;
-        }
+        clear_weak_refs_in_list(ptls2->heap.weak_refs.items,
+                                ptls2->heap.weak_refs.len);
     }
+    clear_weak_refs_in_list(weak_refs_dirty.items, weak_refs_dirty.len);
+    // values referenced only from the marked list are old; they can only
+    // have died if this cycle ran a full mark
+    if (prev_sweep_full)
+        clear_weak_refs_in_list(weak_refs_marked.items, weak_refs_marked.len);
 }
 
 static void sweep_weak_refs(void)
 {
     for (int i = 0; i < jl_n_threads; i++) {
         jl_ptls_t ptls2 = jl_all_tls_states[i];
-        size_t n = 0;
-        size_t ndel = 0;
+        size_t j = 0;
         size_t l = ptls2->heap.weak_refs.len;
         void **lst = ptls2->heap.weak_refs.items;
-        if (l == 0)
+        for (size_t n = 0; n < l; n++) {
+            jl_weakref_t *wr = (jl_weakref_t*)lst[n];
+            uintptr_t bits = jl_astaggedvalue(wr)->bits.gc;
+            if (!gc_marked(bits))
+                continue; // the weak ref itself died
+            if (bits == GC_OLD_MARKED) {
+                // promote; a dead young value was already replaced with
+                // `nothing` by `clear_weak_refs`, so a non-old value here
+                // is alive and the ref belongs on the dirty frontier too
+                arraylist_push(&weak_refs_marked, wr);
+                if (jl_astaggedvalue(wr->value)->bits.gc != GC_OLD_MARKED)
+                    arraylist_push(&weak_refs_dirty, wr);
+                continue;
+            }
+            lst[j++] = wr;
+        }
+        ptls2->heap.weak_refs.len = j;
+    }
+    // keep only dirty entries that are alive and still hold a young value;
+    // the premark may have pushed duplicates, which simply get dropped a
+    // little later than the first copy
+    size_t j = 0;
+    size_t l = weak_refs_dirty.len;
+    void **lst = weak_refs_dirty.items;
+    for (size_t n = 0; n < l; n++) {
+        jl_weakref_t *wr = (jl_weakref_t*)lst[n];
+        if (!gc_marked(jl_astaggedvalue(wr)->bits.gc))
             continue;
-        while (1) {
+        if (jl_astaggedvalue(wr->value)->bits.gc == GC_OLD_MARKED)
+            continue; // the marked list covers it from now on
+        lst[j++] = wr;
+    }
+    weak_refs_dirty.len = j;
+    if (prev_sweep_full) {
+        // after a full mark, drop marked-list entries whose weak ref died
+        j = 0;
+        l = weak_refs_marked.len;
+        lst = weak_refs_marked.items;
+        for (size_t n = 0; n < l; n++) {
             jl_weakref_t *wr = (jl_weakref_t*)lst[n];
             if (gc_marked(jl_astaggedvalue(wr)->bits.gc))
-                n++;
-            else
-                ndel++;
-            if (n >= l - ndel)
-                break;
-            void *tmp = lst[n];
-            lst[n] = lst[n + ndel];
-            lst[n + ndel] = tmp;
+                lst[j++] = wr;
         }
-        ptls2->heap.weak_refs.len -= ndel;
+        weak_refs_marked.len = j;
+    }
+}
+
+// object pinning
+
+// Pinned objects are kept alive and address-stable independently of any
+// Julia-level reference, so their memory can be handed to asynchronous
+// foreign consumers (io_uring submissions, GPU DMA) for indefinite windows.
+// The collector does not move objects today; the registry makes that
+// contract explicit per object, roots it for the duration of the pin, and
+// reserves the freedom to add compaction later with pinned objects
+// exempted. Pins are refcounted so nested windows compose.
+static htable_t pinned_objects;
+// leaf lock; no GC allocation may happen while it is held
+static uv_mutex_t pinned_objects_lock;
+
+JL_DLLEXPORT void jl_gc_pin_object(jl_value_t *v)
+{
+    uv_mutex_lock(&pinned_objects_lock);
+    void **bp = ptrhash_bp(&pinned_objects, v);
+    if (*bp == HT_NOTFOUND)
+        *bp = (void*)(uintptr_t)1;
+    else
+        *bp = (void*)((uintptr_t)*bp + 1);
+    uv_mutex_unlock(&pinned_objects_lock);
+}
+
+JL_DLLEXPORT void jl_gc_unpin_object(jl_value_t *v)
+{
+    uv_mutex_lock(&pinned_objects_lock);
+    void *count = ptrhash_get(&pinned_objects, v);
+    assert(count != HT_NOTFOUND && "unpinning an object that is not pinned");
+    if (count == (void*)(uintptr_t)1)
+        ptrhash_remove(&pinned_objects, v);
+    else
+        ptrhash_put(&pinned_objects, v, (void*)((uintptr_t)count - 1));
+    uv_mutex_unlock(&pinned_objects_lock);
+}
+
+JL_DLLEXPORT int jl_gc_is_pinned(jl_value_t *v)
+{
+    uv_mutex_lock(&pinned_objects_lock);
+    int pinned = ptrhash_get(&pinned_objects, v) != HT_NOTFOUND;
+    uv_mutex_unlock(&pinned_objects_lock);
+    return pinned;
+}
+
+// interned strings are weakly held (see jl_intern_pchar in array.c):
+// tombstone the entries whose string did not survive this collection
+static void sweep_intern_tab(void)
+{
+    for (size_t i = 0; i < jl_intern_tab_sz; i++) {
+        jl_value_t *v = jl_intern_tab[i].str;
+        if (v != NULL && v != JL_INTERN_DELETED &&
+            !gc_marked(jl_astaggedvalue(v)->bits.gc))
+            jl_intern_tab[i].str = JL_INTERN_DELETED;
     }
 }
 
 
 // big value list
 
+// Dead big objects in this size range are not returned to malloc right away.
+// Instead their payload pages are madvised away (keeping only the header
+// resident) and the block is parked on a per-thread size-class freelist, so
+// that workloads churning through large temporaries skip the malloc/free
+// round trip while the OS can still reclaim the memory under pressure.
+// Disable with JULIA_GC_BIG_CACHE=0.
+#define GC_BIG_CACHE_MIN ((size_t)1 << 16)
+#define GC_BIG_CACHE_MAX ((size_t)1 << 26)
+#define GC_BIG_CACHE_PER_CLASS 8
+static int gc_big_cache_enabled = 1;
+
+STATIC_INLINE unsigned big_cache_class(size_t allocsz) JL_NOTSAFEPOINT
+{
+    return 8 * sizeof(size_t) - 1 - __builtin_clzll((unsigned long long)allocsz);
+}
+
+// Try to satisfy a big allocation from the cache. Only an exact size match
+// is reused so that the `sz` accounting of the block stays accurate.
+STATIC_INLINE bigval_t *big_cache_alloc(jl_ptls_t ptls, size_t allocsz) JL_NOTSAFEPOINT
+{
+    if (!gc_big_cache_enabled || allocsz < GC_BIG_CACHE_MIN || allocsz > GC_BIG_CACHE_MAX)
+        return NULL;
+    unsigned cls = big_cache_class(allocsz);
+    bigval_t **pv = &ptls->heap.big_freelists[cls];
+    while (*pv) {
+        bigval_t *v = *pv;
+        if ((v->sz & ~(size_t)3) == allocsz) {
+            *pv = v->next;
+            ptls->heap.big_nfreelist[cls]--;
+            return v;
+        }
+        pv = &v->next;
+    }
+    return NULL;
+}
+
+// Park a dead big object on its owner thread's cache instead of freeing it.
+// Returns 0 if the block is not cacheable and should be freed normally.
+static int big_cache_free(jl_ptls_t ptls2, bigval_t *v) JL_NOTSAFEPOINT
+{
+#ifdef _OS_WINDOWS_
+    // no madvise; the block would stay committed, so don't cache it
+    (void)ptls2;
+    (void)v;
+    return 0;
+#else
+    size_t sz = v->sz & ~(size_t)3;
+    if (!gc_big_cache_enabled || sz < GC_BIG_CACHE_MIN || sz > GC_BIG_CACHE_MAX)
+        return 0;
+    unsigned cls = big_cache_class(sz);
+    if (ptls2->heap.big_nfreelist[cls] >= GC_BIG_CACHE_PER_CLASS)
+        return 0;
+    // return the payload pages to the OS but keep the mapping; the page
+    // holding the header stays resident for the freelist link and size
+    uintptr_t beg = LLT_ALIGN((uintptr_t)v + sizeof(bigval_t), jl_page_size);
+    uintptr_t end = ((uintptr_t)v + sz) & ~(uintptr_t)(jl_page_size - 1);
+    if (end > beg) {
+#ifdef MADV_FREE
+        madvise((void*)beg, end - beg, MADV_FREE);
+#else
+        madvise((void*)beg, end - beg, MADV_DONTNEED);
+#endif
+    }
+    v->next = ptls2->heap.big_freelists[cls];
+    ptls2->heap.big_freelists[cls] = v;
+    ptls2->heap.big_nfreelist[cls]++;
+    return 1;
+#endif
+}
+
+// Drop every cached block; done on a full sweep to bound the address space
+// and header pages held by the caches.
+static void big_cache_flush(jl_ptls_t ptls2) JL_NOTSAFEPOINT
+{
+    for (size_t i = 0; i < JL_GC_BIG_NCLASSES; i++) {
+        bigval_t *v = ptls2->heap.big_freelists[i];
+        while (v) {
+            bigval_t *nxt = v->next;
+            jl_free_aligned(v);
+            v = nxt;
+        }
+        ptls2->heap.big_freelists[i] = NULL;
+        ptls2->heap.big_nfreelist[i] = 0;
+    }
+}
+
 // Size includes the tag and the tag is not cleared!!
 static inline jl_value_t *jl_gc_big_alloc_inner(jl_ptls_t ptls, size_t sz)
 {
@@ -986,13 +1348,18 @@ static inline jl_value_t *jl_gc_big_alloc_inner(jl_ptls_t ptls, size_t sz)
     size_t allocsz = LLT_ALIGN(sz + offs, JL_CACHE_BYTE_ALIGNMENT);
     if (allocsz < sz)  // overflow in adding offs, size was "negative"
         jl_throw(jl_memory_exception);
-    bigval_t *v = (bigval_t*)malloc_cache_align(allocsz);
-    if (v == NULL)
-        jl_throw(jl_memory_exception);
+    bigval_t *v = big_cache_alloc(ptls, allocsz);
+    if (v == NULL) {
+        v = (bigval_t*)malloc_cache_align(allocsz);
+        if (v == NULL)
+            jl_throw(jl_memory_exception);
+    }
     gc_invoke_callbacks(jl_gc_cb_notify_external_alloc_t,
         gc_cblist_notify_external_alloc, (v, allocsz));
     jl_atomic_store_relaxed(&ptls->gc_num.allocd,
         jl_atomic_load_relaxed(&ptls->gc_num.allocd) + allocsz);
+    jl_atomic_store_relaxed(&ptls->gc_num.cum_allocd,
+        jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd) + allocsz);
     jl_atomic_store_relaxed(&ptls->gc_num.bigalloc,
         jl_atomic_load_relaxed(&ptls->gc_num.bigalloc) + 1);
 #ifdef MEMDEBUG
@@ -1022,7 +1389,7 @@ jl_value_t *jl_gc_big_alloc_noinline(jl_ptls_t ptls, size_t sz) {
 
 // Sweep list rooted at *pv, removing and freeing any unmarked objects.
 // Return pointer to last `next` field in the culled list.
-static bigval_t **sweep_big_list(int sweep_full, bigval_t **pv) JL_NOTSAFEPOINT
+static bigval_t **sweep_big_list(jl_ptls_t ptls2, int sweep_full, bigval_t **pv) JL_NOTSAFEPOINT
 {
     bigval_t *v = *pv;
     while (v != NULL) {
@@ -1055,7 +1422,8 @@ static bigval_t **sweep_big_list(int sweep_full, bigval_t **pv) JL_NOTSAFEPOINT
 #endif
             gc_invoke_callbacks(jl_gc_cb_notify_external_free_t,
                 gc_cblist_notify_external_free, (v));
-            jl_free_aligned(v);
+            if (!big_cache_free(ptls2, v))
+                jl_free_aligned(v);
         }
         gc_time_count_big(old_bits, bits);
         v = nxt;
@@ -1066,10 +1434,14 @@ static bigval_t **sweep_big_list(int sweep_full, bigval_t **pv) JL_NOTSAFEPOINT
 static void sweep_big(jl_ptls_t ptls, int sweep_full) JL_NOTSAFEPOINT
 {
     gc_time_big_start();
-    for (int i = 0;i < jl_n_threads;i++)
-        sweep_big_list(sweep_full, &jl_all_tls_states[i]->heap.big_objects);
+    for (int i = 0;i < jl_n_threads;i++) {
+        jl_ptls_t ptls2 = jl_all_tls_states[i];
+        if (sweep_full)
+            big_cache_flush(ptls2);
+        sweep_big_list(ptls2, sweep_full, &ptls2->heap.big_objects);
+    }
     if (sweep_full) {
-        bigval_t **last_next = sweep_big_list(sweep_full, &big_objects_marked);
+        bigval_t **last_next = sweep_big_list(ptls, sweep_full, &big_objects_marked);
         // Move all survivors from big_objects_marked list to big_objects list.
         if (ptls->heap.big_objects)
             ptls->heap.big_objects->prev = last_next;
@@ -1105,6 +1477,8 @@ void jl_gc_count_allocd(size_t sz) JL_NOTSAFEPOINT
     jl_ptls_t ptls = jl_current_task->ptls;
     jl_atomic_store_relaxed(&ptls->gc_num.allocd,
         jl_atomic_load_relaxed(&ptls->gc_num.allocd) + sz);
+    jl_atomic_store_relaxed(&ptls->gc_num.cum_allocd,
+        jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd) + sz);
 }
 
 static void combine_thread_gc_counts(jl_gc_num_t *dest) JL_NOTSAFEPOINT
@@ -1157,17 +1531,55 @@ size_t jl_array_nbytes(jl_array_t *a) JL_NOTSAFEPOINT
     return sz;
 }
 
-static void jl_gc_free_array(jl_array_t *a) JL_NOTSAFEPOINT
+static size_t jl_gc_free_array(jl_array_t *a) JL_NOTSAFEPOINT
 {
-    if (a->flags.how == 2) {
-        char *d = (char*)a->data - a->offset*a->elsize;
-        if (a->flags.isaligned)
-            jl_free_aligned(d);
-        else
-            free(d);
-        gc_num.freed += jl_array_nbytes(a);
-        gc_num.freecall++;
-    }
+    if (a->flags.how != 2)
+        // the buffer was already released on the eager path
+        // (jl_array_unsafe_free), only the tracking entry remains
+        return 0;
+    char *d = (char*)a->data - a->offset*a->elsize;
+    size_t nbytes = jl_array_nbytes(a);
+#ifdef _OS_LINUX_
+    if (a->flags.isaligned &&
+        jl_buf_mmapped(nbytes, jl_array_ndims(a), jl_array_isbitsunion(a)))
+        munmap(d, LLT_ALIGN(nbytes, jl_page_size));
+    else
+#endif
+    if (a->flags.isaligned)
+        jl_free_aligned(d);
+    else
+        free(d);
+    return nbytes;
+}
+
+// Eagerly release `a`'s malloc'd buffer instead of holding it until the
+// array object dies and the next sweep reclaims it: a transient multi-GB
+// workspace otherwise inflates RSS (and collection pressure) for a whole GC
+// cycle after its last use. The object itself stays valid as an empty,
+// unmanaged array — any later access sees zero length rather than freed
+// memory, and the collector never scans a stale data pointer. This function
+// is not a safepoint, so the free and the metadata update are atomic with
+// respect to marking; the mallocarrays tracking entry is recycled at the
+// next sweep, which skips buffers that are already gone.
+JL_DLLEXPORT void jl_array_unsafe_free(jl_array_t *a)
+{
+    if (a->flags.how != 2 || a->flags.isshared)
+        return;
+    size_t nbytes = jl_gc_free_array(a);
+    jl_ptls_t ptls = jl_current_task->ptls;
+    jl_atomic_store_relaxed(&ptls->gc_num.freed,
+        jl_atomic_load_relaxed(&ptls->gc_num.freed) + nbytes);
+    jl_atomic_store_relaxed(&ptls->gc_num.freecall,
+        jl_atomic_load_relaxed(&ptls->gc_num.freecall) + 1);
+    size_t nd = jl_array_ndims(a);
+    for (size_t i = 0; i < nd; i++)
+        jl_array_dim(a, i) = 0;
+    a->data = NULL;
+    a->length = 0;
+    a->offset = 0;
+    if (nd == 1)
+        a->maxsize = 0;
+    a->flags.how = 0;
 }
 
 static void sweep_malloced_arrays(void) JL_NOTSAFEPOINT
@@ -1185,8 +1597,11 @@ static void sweep_malloced_arrays(void) JL_NOTSAFEPOINT
             }
             else {
                 *pma = nxt;
-                assert(ma->a->flags.how == 2);
-                jl_gc_free_array(ma->a);
+                size_t nbytes = jl_gc_free_array(ma->a);
+                if (nbytes) {
+                    gc_num.freed += nbytes;
+                    gc_num.freecall++;
+                }
                 ma->next = ptls2->heap.mafreelist;
                 ptls2->heap.mafreelist = ma;
             }
@@ -1197,13 +1612,69 @@ static void sweep_malloced_arrays(void) JL_NOTSAFEPOINT
     gc_time_mallocd_array_end();
 }
 
+// Concurrent page sweeping
+//
+// With `JULIA_GC_CONCURRENT_SWEEP=1` the pooled-page sweep is moved off the
+// stop-the-world path. Page liveness is fully decided during marking, so after
+// the mark phase the collector only snapshots the set of allocated pages and
+// hands it to a background sweeper thread; the mutators resume with empty pool
+// freelists. The sweeper rebuilds each page's freelist and publishes the page
+// on a per-(thread, pool) ready list, from which `jl_gc_pool_alloc` adopts
+// pages before falling back to allocating fresh ones. The sweeper must be
+// finished before the next collection starts since it owns the page metadata
+// until then.
+static int gc_concurrent_sweep_enabled = 0;
+static _Atomic(jl_gc_pagemeta_t*) *gc_ready_pages; // [jl_n_threads][2 * JL_GC_N_POOLS]
+static jl_gc_pagemeta_t **gc_sweep_pending;
+static size_t gc_sweep_pending_len = 0;
+static size_t gc_sweep_pending_max = 0;
+static int gc_sweep_deferring = 0;
+static int gc_sweep_full_pending = 0;
+static int gc_sweep_prev_full_pending = 0;
+static uv_mutex_t gc_sweep_bg_lock;
+static uv_cond_t gc_sweep_wake_cond;
+static uv_cond_t gc_sweep_done_cond;
+static int gc_sweep_bg_running = 0; // guarded by `gc_sweep_bg_lock`
+
+// Pop a page whose freelist the background sweeper has rebuilt and hand out
+// its first free cell. Each ready list has a single producer (the sweeper)
+// and a single consumer (the owner thread), so a simple CAS pop suffices.
+static NOINLINE jl_taggedvalue_t *gc_pool_adopt_page(jl_ptls_t ptls, jl_gc_pool_t *p) JL_NOTSAFEPOINT
+{
+    int pool_n = gc_pool_n(ptls, p);
+    _Atomic(jl_gc_pagemeta_t*) *slot = &gc_ready_pages[ptls->tid * 2 * JL_GC_N_POOLS + pool_n];
+    jl_gc_pagemeta_t *pg = jl_atomic_load_relaxed(slot);
+    while (pg && !jl_atomic_cmpswap(slot, &pg, pg->next_ready))
+        ;
+    if (!pg)
+        return NULL;
+    jl_taggedvalue_t *v = page_pfl_beg(pg);
+    p->freelist = v->next;
+    pg->nfree = 0;
+    pg->has_young = 1;
+    return v;
+}
+
+// With `JULIA_GC_BUMP_POOLS=1` the pool allocator prefers bump allocation
+// from fresh pages over reusing swept freelist cells. Objects allocated
+// together then sit sequentially in pages that contain no survivors from
+// earlier cycles, so allocation storms keep cache locality and their garbage
+// dies in whole pages, which the sweep reclaims without rebuilding a
+// freelist. This is the nursery-style behavior available to a non-moving
+// collector: survivors stay put (object addresses are identity here, and C
+// code holds raw interior pointers), so there is no evacuation, and the cost
+// is touching more pages when survivors pin partially-full ones. Freelists
+// are still consumed once no fresh page space remains, keeping the footprint
+// bounded by the usual heuristics.
+static int gc_bump_pools = 0;
+
 // pool allocation
 static inline jl_taggedvalue_t *reset_page(const jl_gc_pool_t *p, jl_gc_pagemeta_t *pg, jl_taggedvalue_t *fl) JL_NOTSAFEPOINT
 {
     assert(GC_PAGE_OFFSET >= sizeof(void*));
     pg->nfree = (GC_PAGE_SZ - GC_PAGE_OFFSET) / p->osize;
     jl_ptls_t ptls2 = jl_all_tls_states[pg->thread_n];
-    pg->pool_n = p - ptls2->heap.norm_pools;
+    pg->pool_n = gc_pool_n(ptls2, p);
     memset(pg->ages, 0, GC_PAGE_SZ / 8 / p->osize + 1);
     jl_taggedvalue_t *beg = (jl_taggedvalue_t*)(pg->data + GC_PAGE_OFFSET);
     jl_taggedvalue_t *next = (jl_taggedvalue_t*)pg->data;
@@ -1260,8 +1731,37 @@ static inline jl_value_t *jl_gc_pool_alloc_inner(jl_ptls_t ptls, int pool_offset
     maybe_collect(ptls);
     jl_atomic_store_relaxed(&ptls->gc_num.allocd,
         jl_atomic_load_relaxed(&ptls->gc_num.allocd) + osize);
+    jl_atomic_store_relaxed(&ptls->gc_num.cum_allocd,
+        jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd) + osize);
     jl_atomic_store_relaxed(&ptls->gc_num.poolalloc,
         jl_atomic_load_relaxed(&ptls->gc_num.poolalloc) + 1);
+    if (__unlikely(gc_bump_pools)) {
+        // nursery-style mode: bump from fresh pages while any remain so that
+        // objects allocated together stay adjacent (see gc_bump_pools above)
+        jl_taggedvalue_t *b = p->newpages;
+        if (b) {
+            jl_taggedvalue_t *bnext = (jl_taggedvalue_t*)((char*)b + osize);
+            char *bpage = gc_page_data((char*)b - 1);
+            if (__unlikely(bpage + GC_PAGE_SZ < (char*)bnext)) {
+                // current fresh page is used up: publish its metadata and
+                // advance to the next linked fresh page, if there is one
+                jl_gc_pagemeta_t *pg = jl_assume(page_metadata((char*)b - 1));
+                jl_invariant(pg->osize == p->osize);
+                pg->nfree = 0;
+                pg->has_young = 1;
+                b = *(jl_taggedvalue_t**)bpage;
+                p->newpages = b;
+                if (b)
+                    bnext = (jl_taggedvalue_t*)((char*)b + osize);
+            }
+            if (b) {
+                p->newpages = bnext;
+                return jl_valueof(b);
+            }
+        }
+        // no fresh space left: fall back to the swept freelists before
+        // mapping a new page, so the mode does not inflate the footprint
+    }
     // first try to use the freelist
     jl_taggedvalue_t *v = p->freelist;
     if (v) {
@@ -1271,7 +1771,7 @@ static inline jl_value_t *jl_gc_pool_alloc_inner(jl_ptls_t ptls, int pool_offset
             // we only update pg's fields when the freelist changes page
             // since pg's metadata is likely not in cache
             jl_gc_pagemeta_t *pg = jl_assume(page_metadata(v));
-            assert(pg->osize == p->osize);
+            jl_invariant(pg->osize == p->osize);
             pg->nfree = 0;
             pg->has_young = 1;
         }
@@ -1288,12 +1788,18 @@ static inline jl_value_t *jl_gc_pool_alloc_inner(jl_ptls_t ptls, int pool_offset
             // like the freelist case,
             // but only update the page metadata when it is full
             jl_gc_pagemeta_t *pg = jl_assume(page_metadata((char*)v - 1));
-            assert(pg->osize == p->osize);
+            jl_invariant(pg->osize == p->osize);
             pg->nfree = 0;
             pg->has_young = 1;
             v = *(jl_taggedvalue_t**)cur_page;
         }
         // Not an else!!
+        if (!v && __unlikely(gc_concurrent_sweep_enabled)) {
+            // adopt a page the background sweeper has finished with
+            v = gc_pool_adopt_page(ptls, p);
+            if (v)
+                return jl_valueof(v);
+        }
         if (!v)
             v = add_page(p);
         next = (jl_taggedvalue_t*)((char*)v + osize);
@@ -1334,7 +1840,9 @@ int jl_gc_classify_pools(size_t sz, int *osize)
 int64_t lazy_freed_pages = 0;
 
 // Returns pointer to terminal pointer of list rooted at *pfl.
-static jl_taggedvalue_t **sweep_page(jl_gc_pool_t *p, jl_gc_pagemeta_t *pg, jl_taggedvalue_t **pfl, int sweep_full, int osize) JL_NOTSAFEPOINT
+// `prev_full` is the value of `prev_sweep_full` at the time the liveness of
+// this page was decided (they differ when the sweep runs in the background).
+static jl_taggedvalue_t **sweep_page(jl_gc_pool_t *p, jl_gc_pagemeta_t *pg, jl_taggedvalue_t **pfl, int sweep_full, int prev_full, int osize) JL_NOTSAFEPOINT
 {
     char *data = pg->data;
     uint8_t *ages = pg->ages;
@@ -1366,8 +1874,8 @@ static jl_taggedvalue_t **sweep_page(jl_gc_pool_t *p, jl_gc_pagemeta_t *pg, jl_t
     // For quick sweep, we might be able to skip the page if the page doesn't
     // have any young live cell before marking.
     if (!sweep_full && !pg->has_young) {
-        assert(!prev_sweep_full || pg->prev_nold >= pg->nold);
-        if (!prev_sweep_full || pg->prev_nold == pg->nold) {
+        assert(!prev_full || pg->prev_nold >= pg->nold);
+        if (!prev_full || pg->prev_nold == pg->nold) {
             // the position of the freelist begin/end in this page
             // is stored in its metadata
             if (pg->fl_begin_offset != (uint16_t)-1) {
@@ -1452,12 +1960,22 @@ done:
 // the actual sweeping over all allocated pages in a memory pool
 static inline void sweep_pool_page(jl_taggedvalue_t ***pfl, jl_gc_pagemeta_t *pg, int sweep_full) JL_NOTSAFEPOINT
 {
+    if (__unlikely(gc_sweep_deferring)) {
+        // snapshot the page for the background sweeper instead of sweeping it
+        if (gc_sweep_pending_len >= gc_sweep_pending_max) {
+            gc_sweep_pending_max = gc_sweep_pending_max ? gc_sweep_pending_max * 2 : 4096;
+            gc_sweep_pending = (jl_gc_pagemeta_t**)realloc_s(gc_sweep_pending,
+                    gc_sweep_pending_max * sizeof(jl_gc_pagemeta_t*));
+        }
+        gc_sweep_pending[gc_sweep_pending_len++] = pg;
+        return;
+    }
     int p_n = pg->pool_n;
     int t_n = pg->thread_n;
     jl_ptls_t ptls2 = jl_all_tls_states[t_n];
-    jl_gc_pool_t *p = &ptls2->heap.norm_pools[p_n];
+    jl_gc_pool_t *p = gc_pool_from_n(ptls2, p_n);
     int osize = pg->osize;
-    pfl[t_n * JL_GC_N_POOLS + p_n] = sweep_page(p, pg, pfl[t_n * JL_GC_N_POOLS + p_n], sweep_full, osize);
+    pfl[t_n * 2 * JL_GC_N_POOLS + p_n] = sweep_page(p, pg, pfl[t_n * 2 * JL_GC_N_POOLS + p_n], sweep_full, prev_sweep_full, osize);
 }
 
 // sweep over a pagetable0 for all allocated pages
@@ -1537,6 +2055,91 @@ static void sweep_pool_pagetable(jl_taggedvalue_t ***pfl, int sweep_full) JL_NOT
     memory_map.ub = ub;
 }
 
+// Background sweeper (see the comment above `gc_pool_adopt_page`)
+
+static void gc_sweep_page_concurrent(jl_gc_pagemeta_t *pg, int sweep_full, int prev_full)
+{
+    jl_ptls_t ptls2 = jl_all_tls_states[pg->thread_n];
+    jl_gc_pool_t *p = gc_pool_from_n(ptls2, pg->pool_n);
+    if (!pg->has_marked) {
+        // Unlike the stop-the-world sweep we cannot recycle the page through
+        // `p->newpages` (the owner thread may be allocating), so empty pages
+        // always go back to the page pool. `jl_gc_free_page` expects the
+        // world to be stopped, hence the lock against `jl_gc_alloc_page`.
+        size_t nfree = (GC_PAGE_SZ - GC_PAGE_OFFSET) / pg->osize;
+        gc_num.freed += (nfree - pg->nfree) * pg->osize;
+        uv_mutex_lock(&gc_perm_lock);
+        jl_gc_free_page(pg->data);
+        uv_mutex_unlock(&gc_perm_lock);
+        return;
+    }
+    jl_taggedvalue_t *fl = NULL;
+    jl_taggedvalue_t **pfl = sweep_page(p, pg, &fl, sweep_full, prev_full, pg->osize);
+    *pfl = NULL;
+    if (fl == NULL)
+        return; // page is completely full; nothing to publish
+    _Atomic(jl_gc_pagemeta_t*) *slot = &gc_ready_pages[pg->thread_n * 2 * JL_GC_N_POOLS + pg->pool_n];
+    jl_gc_pagemeta_t *head = jl_atomic_load_relaxed(slot);
+    do {
+        pg->next_ready = head;
+    } while (!jl_atomic_cmpswap(slot, &head, pg));
+}
+
+static void gc_sweep_threadfun(void *arg)
+{
+    (void)arg;
+    uv_mutex_lock(&gc_sweep_bg_lock);
+    while (1) {
+        while (!gc_sweep_bg_running)
+            uv_cond_wait(&gc_sweep_wake_cond, &gc_sweep_bg_lock);
+        uv_mutex_unlock(&gc_sweep_bg_lock);
+        for (size_t i = 0; i < gc_sweep_pending_len; i++)
+            gc_sweep_page_concurrent(gc_sweep_pending[i], gc_sweep_full_pending,
+                                     gc_sweep_prev_full_pending);
+        uv_mutex_lock(&gc_sweep_bg_lock);
+        gc_sweep_bg_running = 0;
+        uv_cond_signal(&gc_sweep_done_cond);
+    }
+}
+
+static void gc_sweep_wake(int sweep_full)
+{
+    uv_mutex_lock(&gc_sweep_bg_lock);
+    gc_sweep_full_pending = sweep_full;
+    gc_sweep_prev_full_pending = prev_sweep_full;
+    gc_sweep_bg_running = 1;
+    uv_cond_signal(&gc_sweep_wake_cond);
+    uv_mutex_unlock(&gc_sweep_bg_lock);
+}
+
+// The sweeper owns the snapshotted page metadata until it is done; the next
+// collection (and anything else walking the pagetable) must wait for it.
+static void gc_sweep_wait_background(void)
+{
+    if (!gc_concurrent_sweep_enabled)
+        return;
+    uv_mutex_lock(&gc_sweep_bg_lock);
+    while (gc_sweep_bg_running)
+        uv_cond_wait(&gc_sweep_done_cond, &gc_sweep_bg_lock);
+    uv_mutex_unlock(&gc_sweep_bg_lock);
+}
+
+static void gc_sweep_init_thread(void)
+{
+    char *env = getenv("JULIA_GC_CONCURRENT_SWEEP");
+    if (!env || atoi(env) == 0)
+        return;
+    uv_mutex_init(&gc_sweep_bg_lock);
+    uv_cond_init(&gc_sweep_wake_cond);
+    uv_cond_init(&gc_sweep_done_cond);
+    size_t sz = jl_n_threads * 2 * JL_GC_N_POOLS * sizeof(jl_gc_pagemeta_t*);
+    gc_ready_pages = (_Atomic(jl_gc_pagemeta_t*)*)malloc_s(sz);
+    memset((void*)gc_ready_pages, 0, sz);
+    uv_thread_t uvtid;
+    uv_thread_create(&uvtid, gc_sweep_threadfun, NULL);
+    gc_concurrent_sweep_enabled = 1;
+}
+
 // sweep over all memory that is being used and not in a pool
 static void gc_sweep_other(jl_ptls_t ptls, int sweep_full) JL_NOTSAFEPOINT
 {
@@ -1572,14 +2175,14 @@ static void gc_sweep_pool(int sweep_full)
 
     // allocate enough space to hold the end of the free list chain
     // for every thread and pool size
-    jl_taggedvalue_t ***pfl = (jl_taggedvalue_t ***) alloca(n_threads * JL_GC_N_POOLS * sizeof(jl_taggedvalue_t**));
+    jl_taggedvalue_t ***pfl = (jl_taggedvalue_t ***) alloca(n_threads * 2 * JL_GC_N_POOLS * sizeof(jl_taggedvalue_t**));
 
     // update metadata of pages that were pointed to by freelist or newpages from a pool
     // i.e. pages being the current allocation target
     for (int t_i = 0; t_i < n_threads; t_i++) {
         jl_ptls_t ptls2 = jl_all_tls_states[t_i];
-        for (int i = 0; i < JL_GC_N_POOLS; i++) {
-            jl_gc_pool_t *p = &ptls2->heap.norm_pools[i];
+        for (int i = 0; i < 2 * JL_GC_N_POOLS; i++) {
+            jl_gc_pool_t *p = gc_pool_from_n(ptls2, i);
             jl_taggedvalue_t *last = p->freelist;
             if (last) {
                 jl_gc_pagemeta_t *pg = jl_assume(page_metadata(last));
@@ -1587,7 +2190,7 @@ static void gc_sweep_pool(int sweep_full)
                 pg->has_young = 1;
             }
             p->freelist =  NULL;
-            pfl[t_i * JL_GC_N_POOLS + i] = &p->freelist;
+            pfl[t_i * 2 * JL_GC_N_POOLS + i] = &p->freelist;
 
             last = p->newpages;
             if (last) {
@@ -1602,12 +2205,37 @@ static void gc_sweep_pool(int sweep_full)
     }
 
     // the actual sweeping
-    sweep_pool_pagetable(pfl, sweep_full);
+    if (gc_concurrent_sweep_enabled) {
+        // drain the ready lists first: a page left unadopted since the last
+        // cycle is about to be snapshotted and republished, and pushing it
+        // while still linked would corrupt the list (duplicate entries, or a
+        // self-cycle when it is still at head), handing its freelist out
+        // twice. The world is stopped and the sweeper idle, so nobody races.
+        for (size_t i = 0; i < n_threads * 2 * JL_GC_N_POOLS; i++) {
+            jl_gc_pagemeta_t *pg = jl_atomic_exchange_relaxed(&gc_ready_pages[i], NULL);
+            while (pg) {
+                jl_gc_pagemeta_t *next = pg->next_ready;
+                pg->next_ready = NULL;
+                pg = next;
+            }
+        }
+        // snapshot the allocated pages and let the background sweeper rebuild
+        // their freelists while the mutators run; the pools restart from empty
+        // freelists and adopt pages as the sweeper publishes them
+        gc_sweep_deferring = 1;
+        gc_sweep_pending_len = 0;
+        sweep_pool_pagetable(pfl, sweep_full);
+        gc_sweep_deferring = 0;
+        gc_sweep_wake(sweep_full);
+    }
+    else {
+        sweep_pool_pagetable(pfl, sweep_full);
+    }
 
     // null out terminal pointers of free lists
     for (int t_i = 0; t_i < n_threads; t_i++) {
-        for (int i = 0; i < JL_GC_N_POOLS; i++) {
-            *pfl[t_i * JL_GC_N_POOLS + i] = NULL;
+        for (int i = 0; i < 2 * JL_GC_N_POOLS; i++) {
+            *pfl[t_i * 2 * JL_GC_N_POOLS + i] = NULL;
         }
     }
 
@@ -1623,10 +2251,42 @@ static void gc_sweep_perm_alloc(void)
 
 // mark phase
 
+// Enable with JULIA_GC_CARD_REMSET. Instead of pushing every remembered pool
+// object on the remset list, the write barrier dirties a card covering the
+// object's cell so that repeated recordings of hot old objects collapse and
+// remset scanning becomes proportional to the number of dirty cards.
+static int gc_card_remset = 0;
+
 JL_DLLEXPORT void jl_gc_queue_root(const jl_value_t *ptr)
 {
     jl_ptls_t ptls = jl_current_task->ptls;
     jl_taggedvalue_t *o = jl_astaggedvalue(ptr);
+    if (__unlikely(gc_card_remset)) {
+        // weak refs must take the exact remset: the premark rebuilds the
+        // dirty weak-ref frontier from it, and a dirtied card cannot do
+        // that job since dirty-card scanning treats the weak ref as an
+        // ordinary object, which by design neither marks nor clears its
+        // value -- the re-pointed young referent would be freed under it
+        jl_gc_pagemeta_t *pg = jl_typeof(ptr) == (jl_value_t*)jl_weakref_type
+            ? NULL : page_metadata(o);
+        if (pg) {
+            // Bucketed mode: leave the GC bits alone (the barrier stays
+            // armed, but re-executions only dirty the same card again) and
+            // record the card holding the object's cell instead of the
+            // object itself. Racing stores of the same byte are benign.
+            size_t card = ((uintptr_t)o - (uintptr_t)gc_page_data(o)) >> GC_CARD_LG2;
+            if (!pg->cards[card]) {
+                pg->cards[card] = 1;
+                ptls->heap.remset_nptr++; // conservative
+            }
+            if (!jl_atomic_load_relaxed(&pg->card_dirty) &&
+                jl_atomic_exchange_relaxed(&pg->card_dirty, 1) == 0)
+                arraylist_push(&ptls->heap.dirty_pages, pg);
+            return;
+        }
+        // big objects have no page metadata and use the exact remset, as
+        // do weak refs (see above)
+    }
     // The modification of the `gc_bits` is not atomic but it
     // should be safe here since GC is not allowed to run here and we only
     // write GC_OLD to the GC bits outside GC. This could cause
@@ -1656,7 +2316,10 @@ void jl_gc_queue_multiroot(const jl_value_t *parent, const jl_value_t *ptr) JL_N
     const uint32_t *ptrs32 = (const uint32_t*)jl_dt_layout_ptrs(ly);
     for (size_t i = 1; i < npointers; i++) {
         uint32_t fld;
-        if (ly->fielddesc_type == 0) {
+        if (ly->ptrs_run) {
+            fld = ly->first_ptr + i;
+        }
+        else if (ly->fielddesc_type == 0) {
             fld = ptrs8[i];
         }
         else if (ly->fielddesc_type == 1) {
@@ -1803,11 +2466,54 @@ void gc_mark_queue_finlist(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp,
                        &markdata, sizeof(markdata), 1);
 }
 
+// Parallel marking
+//
+// When `JULIA_GC_MARK_THREADS` requests dedicated mark workers, the root
+// enumeration phase of the collection does not push roots onto the master's
+// local mark stack. Instead each root is marked (`gc_try_setmark`) on the
+// master thread as usual, but queued as a scan-only entry on a shared root
+// channel. Once enumeration is complete, the master releases the workers and
+// all of them (master included) claim batches from the channel, expanding each
+// batch through `gc_mark_loop` on their private mark stacks. The mark bits are
+// already safe for concurrent setting (see `gc_setmark_tag`), so workers never
+// need to coordinate beyond the batch claim. Load balancing happens at
+// root-object granularity: remsets and call caches contribute thousands of
+// independent entries, which is the work distribution that matters on large
+// heaps. Stealing from another worker's in-progress mark stack (the TODO in
+// `gc_mark_loop`) is not attempted since the data stack interleaves
+// variable-size records.
+static int gc_n_markthreads = 0;
+static jl_ptls_t *gc_mark_worker_ptls;
+static jl_value_t **gc_mark_root_queue;
+static size_t gc_mark_root_max = 0;
+static size_t gc_mark_root_len = 0;      // single producer (master, during STW)
+static _Atomic(size_t) gc_mark_root_next; // batch claim index
+static int gc_mark_roots_divert = 0;      // toggled by the master during root enumeration
+
+// The low pointer bit distinguishes scan-only roots (remset entries, which
+// already have their final GC bits) from freshly marked roots that still need
+// their metadata updated by the mark loop.
+STATIC_INLINE void gc_mark_divert_root(jl_value_t *obj) JL_NOTSAFEPOINT
+{
+    size_t len = gc_mark_root_len;
+    if (__unlikely(len >= gc_mark_root_max)) {
+        gc_mark_root_max = gc_mark_root_max ? gc_mark_root_max * 2 : 32768;
+        gc_mark_root_queue = (jl_value_t**)realloc_s(gc_mark_root_queue,
+                                                     gc_mark_root_max * sizeof(jl_value_t*));
+    }
+    gc_mark_root_queue[len] = obj;
+    gc_mark_root_len = len + 1;
+}
+
 // Queue a object to be scanned. The object should already be marked and the GC metadata
 // should already be updated for it. Only scanning of the object should be performed.
 STATIC_INLINE void gc_mark_queue_scan_obj(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp,
                                           jl_value_t *obj)
 {
+    if (__unlikely(gc_mark_roots_divert)) {
+        gc_mark_divert_root((jl_value_t*)((uintptr_t)obj | 1));
+        return;
+    }
     jl_taggedvalue_t *o = jl_astaggedvalue(obj);
     uintptr_t tag = o->header;
     uint8_t bits = tag & 0xf;
@@ -1829,6 +2535,11 @@ STATIC_INLINE int gc_mark_queue_obj(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_
     uint8_t bits = 0;
     if (!gc_try_setmark(obj, &nptr, &tag, &bits))
         return (int)nptr;
+    if (__unlikely(gc_mark_roots_divert)) {
+        // the mark bit is already set; let a mark worker do the scanning
+        gc_mark_divert_root(obj);
+        return (int)nptr;
+    }
     gc_mark_marked_obj_t data = {obj, tag, bits};
     gc_mark_stack_push(gc_cache, sp, gc_mark_label_addrs[GC_MARK_L_marked_obj],
                        &data, sizeof(data), 1);
@@ -1883,9 +2594,32 @@ STATIC_INLINE int gc_mark_scan_objarray(jl_ptls_t ptls, jl_gc_mark_sp_t *sp,
     (void)jl_assume(objary == (gc_mark_objarray_t*)sp->data);
     for (; begin < end; begin += objary->step) {
         *pnew_obj = *begin;
-        if (*pnew_obj)
+        if (__unlikely(*pnew_obj == NULL) && objary->step == 1) {
+            // Fast-forward over runs of NULL slots eight at a time. The
+            // OR-reduction over a fixed-width block is auto-vectorized into
+            // SIMD compares, which matters for huge, sparsely populated
+            // `Vector{Any}`-style arrays where a branch per slot dominates.
+            do {
+                begin++;
+                while (end - begin >= 8) {
+                    uintptr_t any = 0;
+                    for (int i = 0; i < 8; i++)
+                        any |= (uintptr_t)begin[i];
+                    if (any)
+                        break;
+                    begin += 8;
+                }
+            } while (begin < end && *begin == NULL);
+            if (begin >= end)
+                break;
+            *pnew_obj = *begin;
+        }
+        if (*pnew_obj) {
+            // stay ahead of the slot loads when walking large dense arrays
+            __builtin_prefetch(begin + 32);
             verify_parent2("obj array", objary->parent, begin, "elem(%d)",
                            gc_slot_to_arrayidx(objary->parent, begin));
+        }
         if (!gc_try_setmark(*pnew_obj, &objary->nptr, ptag, pbits))
             continue;
         begin += objary->step;
@@ -2003,6 +2737,24 @@ STATIC_INLINE int gc_mark_scan_array16(jl_ptls_t ptls, jl_gc_mark_sp_t *sp,
 }
 
 
+// Identity index table shared by every run-shaped layout (ptrs_run in
+// jl_get_layout): a type whose pointers occupy the consecutive words
+// first_ptr .. first_ptr+npointers-1 is scanned through this table instead
+// of its own index list, so marking such objects never touches the
+// per-type pointer metadata. This covers the dominant struct shapes (one
+// to a few pointer fields at the front) regardless of fielddesc width, as
+// long as the run ends below 256 words.
+#define GC_PTR_RUN_ROW(n) \
+    n, n + 1, n + 2, n + 3, n + 4, n + 5, n + 6, n + 7, \
+    n + 8, n + 9, n + 10, n + 11, n + 12, n + 13, n + 14, n + 15
+static const uint8_t gc_ptr_run_indices[256] = {
+    GC_PTR_RUN_ROW(0),   GC_PTR_RUN_ROW(16),  GC_PTR_RUN_ROW(32),  GC_PTR_RUN_ROW(48),
+    GC_PTR_RUN_ROW(64),  GC_PTR_RUN_ROW(80),  GC_PTR_RUN_ROW(96),  GC_PTR_RUN_ROW(112),
+    GC_PTR_RUN_ROW(128), GC_PTR_RUN_ROW(144), GC_PTR_RUN_ROW(160), GC_PTR_RUN_ROW(176),
+    GC_PTR_RUN_ROW(192), GC_PTR_RUN_ROW(208), GC_PTR_RUN_ROW(224), GC_PTR_RUN_ROW(240)
+};
+#undef GC_PTR_RUN_ROW
+
 // Scan an object with 8bits field descriptors. see `gc_mark_obj8_t`
 STATIC_INLINE int gc_mark_scan_obj8(jl_ptls_t ptls, jl_gc_mark_sp_t *sp, gc_mark_obj8_t *obj8,
                                     char *parent, uint8_t *begin, uint8_t *end,
@@ -2792,7 +3544,20 @@ mark: {
                 goto pop;
             uintptr_t nptr = npointers << 2 | (bits & GC_OLD);
             assert((layout->nfields > 0 || layout->fielddesc_type == 3) && "opaque types should have been handled specially");
-            if (layout->fielddesc_type == 0) {
+            if (layout->ptrs_run && (uint32_t)layout->first_ptr + npointers <= 256) {
+                // consecutive pointer words: scan through the shared identity
+                // table, skipping the layout's index list entirely
+                obj8_parent = (char*)new_obj;
+                obj8_begin = (uint8_t*)gc_ptr_run_indices + layout->first_ptr;
+                obj8_end = obj8_begin + npointers;
+                assert(obj8_begin < obj8_end);
+                gc_mark_obj8_t markdata = {new_obj, obj8_begin, obj8_end, nptr};
+                gc_mark_stack_push(&ptls->gc_cache, &sp, gc_mark_laddr(obj8),
+                                   &markdata, sizeof(markdata), 0);
+                obj8 = (gc_mark_obj8_t*)sp.data;
+                goto obj8_loaded;
+            }
+            else if (layout->fielddesc_type == 0) {
                 obj8_parent = (char*)new_obj;
                 obj8_begin = (uint8_t*)jl_dt_layout_ptrs(layout);
                 obj8_end = obj8_begin + npointers;
@@ -2840,6 +3605,151 @@ mark: {
     }
 }
 
+// Parallel marking engine (see the comment above `gc_mark_divert_root`)
+
+static uv_mutex_t gc_mark_lock;
+static uv_cond_t gc_mark_wake_cond;
+static uv_cond_t gc_mark_done_cond;
+static _Atomic(uint64_t) gc_mark_generation;
+static int gc_mark_nactive = 0; // guarded by `gc_mark_lock`
+
+#define GC_MARK_ROOT_BATCH 64
+
+// Claim batches of roots from the shared channel and expand them through
+// `gc_mark_loop` on this thread's private mark stack. Runs on the mark workers
+// and on the master thread while it waits for the workers.
+static void gc_mark_drain_roots(jl_ptls_t ptls)
+{
+    jl_gc_mark_cache_t *gc_cache = &ptls->gc_cache;
+    jl_gc_mark_sp_t sp;
+    size_t len = gc_mark_root_len;
+    while (1) {
+        size_t start = jl_atomic_fetch_add(&gc_mark_root_next, GC_MARK_ROOT_BATCH);
+        if (start >= len)
+            return;
+        size_t end = start + GC_MARK_ROOT_BATCH;
+        if (end > len)
+            end = len;
+        gc_mark_sp_init(gc_cache, &sp);
+        for (size_t i = start; i < end; i++) {
+            jl_value_t *root = gc_mark_root_queue[i];
+            if (gc_ptr_tag(root, 1)) {
+                gc_mark_queue_scan_obj(gc_cache, &sp,
+                                       (jl_value_t*)gc_ptr_clear_tag(root, 1));
+            }
+            else {
+                jl_taggedvalue_t *o = jl_astaggedvalue(root);
+                uintptr_t header = o->header;
+                gc_mark_marked_obj_t data = {root, header & ~(uintptr_t)0xf,
+                                             (uint8_t)(header & 0xf)};
+                gc_mark_stack_push(gc_cache, &sp,
+                                   gc_mark_label_addrs[GC_MARK_L_marked_obj],
+                                   &data, sizeof(data), 1);
+            }
+        }
+        gc_mark_loop(ptls, sp);
+    }
+}
+
+static void gc_mark_threadfun(void *arg)
+{
+    jl_ptls_t ptls = (jl_ptls_t)arg;
+    uint64_t gen = 0;
+    uv_mutex_lock(&gc_mark_lock);
+    while (1) {
+        while (jl_atomic_load_relaxed(&gc_mark_generation) == gen)
+            uv_cond_wait(&gc_mark_wake_cond, &gc_mark_lock);
+        gen = jl_atomic_load_relaxed(&gc_mark_generation);
+        uv_mutex_unlock(&gc_mark_lock);
+        gc_mark_drain_roots(ptls);
+        uv_mutex_lock(&gc_mark_lock);
+        if (--gc_mark_nactive == 0)
+            uv_cond_signal(&gc_mark_done_cond);
+    }
+}
+
+static void gc_mark_wake_workers(void)
+{
+    uv_mutex_lock(&gc_mark_lock);
+    gc_mark_nactive = gc_n_markthreads;
+    jl_atomic_store_relaxed(&gc_mark_generation,
+                            jl_atomic_load_relaxed(&gc_mark_generation) + 1);
+    uv_cond_broadcast(&gc_mark_wake_cond);
+    uv_mutex_unlock(&gc_mark_lock);
+}
+
+static void gc_mark_wait_workers(void)
+{
+    uv_mutex_lock(&gc_mark_lock);
+    while (gc_mark_nactive)
+        uv_cond_wait(&gc_mark_done_cond, &gc_mark_lock);
+    uv_mutex_unlock(&gc_mark_lock);
+}
+
+// Fold the worker-local mark state back into the master thread now that
+// marking is done: big object lists and scanned byte counts through the usual
+// cache sync, remset entries into the master's own remset so that the next
+// quick collection sees them.
+static void gc_mark_merge_worker_state(jl_ptls_t ptls)
+{
+    for (int i = 0; i < gc_n_markthreads; i++) {
+        jl_ptls_t ptls2 = gc_mark_worker_ptls[i];
+        gc_sync_cache_nolock(ptls, &ptls2->gc_cache);
+        arraylist_t *remset = ptls2->heap.remset;
+        for (size_t j = 0; j < remset->len; j++)
+            arraylist_push(ptls->heap.remset, remset->items[j]);
+        remset->len = 0;
+        ptls->heap.remset_nptr += ptls2->heap.remset_nptr;
+        ptls2->heap.remset_nptr = 0;
+    }
+}
+
+// A mark worker only ever runs `gc_mark_loop`, so it needs a thread state
+// with just the marking pieces of `jl_init_thread_heap` set up: the private
+// mark stack and an (initially empty) remset for old-to-young references it
+// discovers while scanning.
+static jl_ptls_t gc_mark_worker_new_ptls(int i)
+{
+    jl_ptls_t ptls = (jl_ptls_t)malloc_s(sizeof(jl_tls_states_t));
+    memset(ptls, 0, sizeof(jl_tls_states_t));
+    ptls->tid = -(i + 1);
+    jl_thread_heap_t *heap = &ptls->heap;
+    heap->remset = &heap->_remset[0];
+    heap->last_remset = &heap->_remset[1];
+    arraylist_new(heap->remset, 0);
+    arraylist_new(heap->last_remset, 0);
+    arraylist_new(&heap->rem_bindings, 0);
+    arraylist_new(&heap->dirty_pages, 0);
+    jl_gc_mark_cache_t *gc_cache = &ptls->gc_cache;
+    size_t init_size = 1024;
+    gc_cache->pc_stack = (void**)malloc_s(init_size * sizeof(void*));
+    gc_cache->pc_stack_end = gc_cache->pc_stack + init_size;
+    gc_cache->data_stack = (jl_gc_mark_data_t *)malloc_s(init_size * sizeof(jl_gc_mark_data_t));
+    return ptls;
+}
+
+static void gc_mark_init_threads(void)
+{
+    char *env = getenv("JULIA_GC_MARK_THREADS");
+    if (!env)
+        return;
+    int n = atoi(env);
+    if (n > jl_cpu_threads())
+        n = jl_cpu_threads();
+    if (n <= 0)
+        return;
+    uv_mutex_init(&gc_mark_lock);
+    uv_cond_init(&gc_mark_wake_cond);
+    uv_cond_init(&gc_mark_done_cond);
+    gc_mark_worker_ptls = (jl_ptls_t*)malloc_s(n * sizeof(jl_ptls_t));
+    for (int i = 0; i < n; i++) {
+        gc_mark_worker_ptls[i] = gc_mark_worker_new_ptls(i);
+        uv_thread_t uvtid;
+        uv_thread_create(&uvtid, gc_mark_threadfun, gc_mark_worker_ptls[i]);
+    }
+    gc_n_markthreads = n;
+}
+
 static void jl_gc_queue_thread_local(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp,
                                      jl_ptls_t ptls2)
 {
@@ -2851,6 +3761,38 @@ static void jl_gc_queue_thread_local(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp
         gc_mark_queue_obj(gc_cache, sp, ptls2->previous_task);
     if (ptls2->previous_exception)
         gc_mark_queue_obj(gc_cache, sp, ptls2->previous_exception);
+    // thread-local dispatch cache entries may outlive their typemap
+    for (size_t i = 0; i < JL_TLS_CALL_CACHE_SIZE; i++) {
+        jl_typemap_entry_t *v = jl_atomic_load_relaxed(&ptls2->call_cache[i]);
+        if (v != NULL)
+            gc_mark_queue_obj(gc_cache, sp, v);
+    }
+    // memoized boxes are handed out again on repeat values, so they must
+    // stay live while cached
+    for (size_t i = 0; i < JL_TLS_BOX_CACHE_SIZE; i++) {
+        if (ptls2->box_cache[i] != NULL)
+            gc_mark_queue_obj(gc_cache, sp, ptls2->box_cache[i]);
+    }
+    // isa-cache keys are compared by identity, so they must stay live
+    // while cached lest a recycled address alias a stale verdict
+    for (size_t i = 0; i < JL_TLS_ISA_CACHE_SIZE; i++) {
+        if (ptls2->isa_cache_vt[i] != NULL) {
+            gc_mark_queue_obj(gc_cache, sp, ptls2->isa_cache_vt[i]);
+            gc_mark_queue_obj(gc_cache, sp, ptls2->isa_cache_t[i]);
+        }
+    }
+    // opaque-closure cache keys are likewise compared by identity
+    for (size_t i = 0; i < JL_TLS_OC_CACHE_SIZE; i++) {
+        if (ptls2->oc_cache[i].source != NULL) {
+            gc_mark_queue_obj(gc_cache, sp, ptls2->oc_cache[i].source);
+            gc_mark_queue_obj(gc_cache, sp, ptls2->oc_cache[i].argt);
+            gc_mark_queue_obj(gc_cache, sp, ptls2->oc_cache[i].captt);
+            gc_mark_queue_obj(gc_cache, sp, ptls2->oc_cache[i].rt_ub);
+            gc_mark_queue_obj(gc_cache, sp, ptls2->oc_cache[i].oc_type);
+            if (ptls2->oc_cache[i].consted != NULL)
+                gc_mark_queue_obj(gc_cache, sp, ptls2->oc_cache[i].consted);
+        }
+    }
 }
 
 extern jl_value_t *cmpswap_names JL_GLOBALLY_ROOTED;
@@ -2871,16 +3813,63 @@ static void mark_roots(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp)
             gc_mark_queue_obj(gc_cache, sp, jl_current_modules.table[i]);
         }
     }
+    // pinned objects are roots for as long as a pin is outstanding
+    // (no lock needed: the world is stopped)
+    for (size_t i = 0; i < pinned_objects.size; i += 2) {
+        if (pinned_objects.table[i + 1] != HT_NOTFOUND) {
+            gc_mark_queue_obj(gc_cache, sp, pinned_objects.table[i]);
+        }
+    }
     gc_mark_queue_obj(gc_cache, sp, jl_anytuple_type_type);
     for (size_t i = 0; i < N_CALL_CACHE; i++) {
         jl_typemap_entry_t *v = jl_atomic_load_relaxed(&call_cache[i]);
         if (v != NULL)
             gc_mark_queue_obj(gc_cache, sp, v);
     }
+    for (size_t i = 0; i < N_SIG_CACHE; i++) {
+        jl_typemap_entry_t *v = jl_atomic_load_relaxed(&sig_call_cache[i]);
+        if (v != NULL)
+            gc_mark_queue_obj(gc_cache, sp, v);
+    }
+    // per-callsite inline-cache slots, which also pin entries past invalidation
+    for (jl_pic_slot_block_t *blk = jl_pic_slot_blocks; blk != NULL; blk = blk->next) {
+        for (size_t i = 0; i < blk->used; i++) {
+            jl_typemap_entry_t *v = jl_atomic_load_relaxed(&blk->slots[i]);
+            if (v != NULL)
+                gc_mark_queue_obj(gc_cache, sp, v);
+        }
+    }
+    for (size_t i = 0; i < N_SUBTYPE_CACHE; i++) {
+        // mark both keys even if the slot is mid-insertion: each pointer is
+        // individually a valid object, and lookups validate the pairing
+        jl_value_t *v = jl_atomic_load_relaxed(&subtype_memo_cache[i].x);
+        if (v != NULL)
+            gc_mark_queue_obj(gc_cache, sp, v);
+        v = jl_atomic_load_relaxed(&subtype_memo_cache[i].y);
+        if (v != NULL)
+            gc_mark_queue_obj(gc_cache, sp, v);
+    }
+    for (size_t i = 0; i < N_ABI_CLASSIFY_CACHE; i++) {
+        // pin memoized ABI classification keys lest a recycled address
+        // alias a stale verdict
+        jl_datatype_t *v = jl_atomic_load_relaxed(&jl_abi_classify_cache[i].dt);
+        if (v != NULL)
+            gc_mark_queue_obj(gc_cache, sp, v);
+    }
     if (jl_all_methods != NULL)
         gc_mark_queue_obj(gc_cache, sp, jl_all_methods);
     if (_jl_debug_method_invalidation != NULL)
         gc_mark_queue_obj(gc_cache, sp, _jl_debug_method_invalidation);
+    if (jl_lowering_cache != NULL)
+        gc_mark_queue_obj(gc_cache, sp, jl_lowering_cache);
+    if (jl_ircode_cache != NULL)
+        gc_mark_queue_obj(gc_cache, sp, jl_ircode_cache);
+    // buffers handed to libuv by reference stay rooted until their write
+    // completion callback runs (see jl_uv_write_splice in jl_uv.c)
+    for (size_t i = 0; i < jl_uv_write_root_list.len; i++)
+        gc_mark_queue_obj(gc_cache, sp, jl_uv_write_root_list.items[i]);
+    if (_jl_debug_compilation_timing != NULL)
+        gc_mark_queue_obj(gc_cache, sp, _jl_debug_compilation_timing);
 
     // constants
     gc_mark_queue_obj(gc_cache, sp, jl_emptytuple_type);
@@ -2988,6 +3977,65 @@ JL_DLLEXPORT void jl_gc_reset_stats(void)
     gc_num.max_time_to_safepoint = 0;
 }
 
+// Pause histograms: always-on per-phase distribution of collection times,
+// complementing the running totals in `gc_num`. HDR-style buckets: log2
+// octaves subdivided into JL_GC_HIST_SUBBUCKETS linear sub-buckets, which
+// bounds the relative error of any recorded value to ~1/SUBBUCKETS while
+// covering the full uint64_t nanosecond range. Updates happen on the thread
+// running the collection (or the finalizers), so plain increments suffice;
+// concurrent readers may see a count that is one collection stale.
+#define JL_GC_HIST_SUBBUCKETS 4
+#define JL_GC_HIST_NBUCKETS 256
+
+static uint64_t gc_pause_hist[JL_GC_N_PHASES][JL_GC_HIST_NBUCKETS];
+
+static int gc_hist_bucket(uint64_t ns) JL_NOTSAFEPOINT
+{
+    if (ns < JL_GC_HIST_SUBBUCKETS)
+        return (int)ns;
+    int shift = 0;
+    while (ns >= 2 * JL_GC_HIST_SUBBUCKETS) {
+        ns >>= 1;
+        shift++;
+    }
+    int bucket = (shift + 1) * JL_GC_HIST_SUBBUCKETS +
+                 (int)(ns - JL_GC_HIST_SUBBUCKETS);
+    return bucket < JL_GC_HIST_NBUCKETS ? bucket : JL_GC_HIST_NBUCKETS - 1;
+}
+
+static void gc_hist_record(jl_gc_phase_t phase, uint64_t ns) JL_NOTSAFEPOINT
+{
+    gc_pause_hist[phase][gc_hist_bucket(ns)]++;
+}
+
+JL_DLLEXPORT int jl_gc_pause_histogram(jl_gc_phase_t phase, uint64_t *counts,
+                                       uint64_t *lower_bounds_ns, int nbuckets) JL_NOTSAFEPOINT
+{
+    if ((int)phase < 0 || (int)phase >= JL_GC_N_PHASES)
+        return 0;
+    if (nbuckets > JL_GC_HIST_NBUCKETS)
+        nbuckets = JL_GC_HIST_NBUCKETS;
+    for (int i = 0; i < nbuckets; i++) {
+        if (counts)
+            counts[i] = gc_pause_hist[phase][i];
+        if (lower_bounds_ns) {
+            // inverse of gc_hist_bucket: the smallest value a bucket can hold
+            if (i < JL_GC_HIST_SUBBUCKETS)
+                lower_bounds_ns[i] = (uint64_t)i;
+            else
+                lower_bounds_ns[i] =
+                    (uint64_t)(JL_GC_HIST_SUBBUCKETS + i % JL_GC_HIST_SUBBUCKETS)
+                    << (i / JL_GC_HIST_SUBBUCKETS - 1);
+        }
+    }
+    return JL_GC_HIST_NBUCKETS;
+}
+
+JL_DLLEXPORT void jl_gc_pause_histogram_reset(void) JL_NOTSAFEPOINT
+{
+    memset(gc_pause_hist, 0, sizeof(gc_pause_hist));
+}
+
 // TODO: these were supposed to be thread local
 JL_DLLEXPORT int64_t jl_gc_diff_total_bytes(void) JL_NOTSAFEPOINT
 {
@@ -3028,6 +4076,11 @@ static void jl_gc_premark(jl_ptls_t ptls2)
         jl_value_t *item = (jl_value_t*)items[i];
         objprofile_count(jl_typeof(item), 2, 0);
         jl_astaggedvalue(item)->bits.gc = GC_OLD_MARKED;
+        // a write barrier hit on an old weak ref means its value field may
+        // hold a young object again: put it back on the dirty frontier so
+        // quick collections keep scanning it (see `sweep_weak_refs`)
+        if (jl_typeof(item) == (jl_value_t*)jl_weakref_type)
+            arraylist_push(&weak_refs_dirty, item);
     }
     len = ptls2->heap.rem_bindings.len;
     items = ptls2->heap.rem_bindings.items;
@@ -3037,8 +4090,45 @@ static void jl_gc_premark(jl_ptls_t ptls2)
     }
 }
 
+// Queue every old object whose cell begins in a dirty card. Cells are at
+// fixed `osize` strides so the object starts can be derived from the page
+// metadata. Any page holding an old-marked object has been swept at least
+// once since the cell was allocated, so every cell on it is either live or
+// a freelist link (an aligned pointer, whose gc bits read as GC_CLEAN) --
+// a cell with GC_OLD_MARKED bits is always a real object.
+static void jl_gc_queue_dirty_cards(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp, jl_ptls_t ptls2)
+{
+    arraylist_t *dirty = &ptls2->heap.dirty_pages;
+    for (size_t i = 0; i < dirty->len; i++) {
+        jl_gc_pagemeta_t *pg = (jl_gc_pagemeta_t*)dirty->items[i];
+        char *data = pg->data;
+        int osize = pg->osize;
+        for (int c = 0; c < GC_CARDS_PER_PAGE; c++) {
+            if (!pg->cards[c])
+                continue;
+            pg->cards[c] = 0;
+            // an object spanning into this card from an earlier one is
+            // covered by the card of its own cell
+            size_t beg = (size_t)c << GC_CARD_LG2;
+            size_t off = GC_PAGE_OFFSET;
+            if (beg > off)
+                off += (beg - off + osize - 1) / osize * osize;
+            size_t end = beg + GC_CARD_SZ;
+            for (; off < end && off + osize <= GC_PAGE_SZ; off += osize) {
+                jl_taggedvalue_t *v = (jl_taggedvalue_t*)(data + off);
+                if (v->bits.gc == GC_OLD_MARKED)
+                    gc_mark_queue_scan_obj(gc_cache, sp, jl_valueof(v));
+            }
+        }
+        jl_atomic_store_relaxed(&pg->card_dirty, 0);
+    }
+    dirty->len = 0;
+}
+
 static void jl_gc_queue_remset(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp, jl_ptls_t ptls2)
 {
+    if (__unlikely(gc_card_remset))
+        jl_gc_queue_dirty_cards(gc_cache, sp, ptls2);
     size_t len = ptls2->heap.last_remset->len;
     void **items = ptls2->heap.last_remset->items;
     for (size_t i = 0; i < len; i++)
@@ -3078,6 +4168,10 @@ size_t jl_maxrss(void);
 // Only one thread should be running in this function
 static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
 {
+    // a page sweep deferred by the previous collection must finish before
+    // this one can look at the page metadata
+    gc_sweep_wait_background();
+
     combine_thread_gc_counts(&gc_num);
 
     jl_gc_mark_cache_t *gc_cache = &ptls->gc_cache;
@@ -3093,6 +4187,13 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     for (int t_i = 0; t_i < jl_n_threads; t_i++)
         jl_gc_premark(jl_all_tls_states[t_i]);
 
+    if (gc_n_markthreads > 0) {
+        // divert the root set to the shared channel for the mark workers
+        gc_mark_root_len = 0;
+        jl_atomic_store_relaxed(&gc_mark_root_next, 0);
+        gc_mark_roots_divert = 1;
+    }
+
     for (int t_i = 0; t_i < jl_n_threads; t_i++) {
         jl_ptls_t ptls2 = jl_all_tls_states[t_i];
         // 2.1. mark every object in the `last_remsets` and `rem_binding`
@@ -3111,7 +4212,17 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
             gc_cblist_root_scanner, (collection));
         import_gc_state(ptls, &sp);
     }
-    gc_mark_loop(ptls, sp);
+    if (gc_n_markthreads > 0) {
+        gc_mark_roots_divert = 0;
+        gc_mark_wake_workers();
+        gc_mark_loop(ptls, sp); // anything pushed locally despite the diversion
+        gc_mark_drain_roots(ptls); // help the workers drain the channel
+        gc_mark_wait_workers();
+        gc_mark_merge_worker_state(ptls);
+    }
+    else {
+        gc_mark_loop(ptls, sp);
+    }
     gc_mark_sp_init(gc_cache, &sp);
     gc_num.since_sweep += gc_num.allocd;
     JL_PROBE_GC_MARK_END(scanned_bytes, perm_scanned_bytes);
@@ -3121,6 +4232,7 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     uint64_t mark_time = end_mark_time - start_mark_time;
     gc_num.mark_time = mark_time;
     gc_num.total_mark_time += mark_time;
+    gc_hist_record(JL_GC_PHASE_MARK, mark_time);
     int64_t actual_allocd = gc_num.since_sweep;
     // marking is over
 
@@ -3166,7 +4278,15 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     int64_t live_sz_est = scanned_bytes + perm_scanned_bytes;
     int64_t estimate_freed = live_sz_ub - live_sz_est;
 
+#if defined(GC_VERIFY) && defined(JL_VERIFY_BUILD)
+    // the full re-mark is too expensive to run on every collection in a
+    // verification build; sample it so the steady-state cost stays low
+    static size_t verify_tick = 0;
+    if (++verify_tick % JL_VERIFY_GC_SAMPLE_PERIOD == 0)
+        gc_verify(ptls);
+#else
     gc_verify(ptls);
+#endif
 
     gc_stats_all_pool();
     gc_stats_big_obj();
@@ -3198,6 +4318,15 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
             sweep_full = 1;
             gc_num.interval = max_collect_interval;
         }
+        // A full sweep pauses for live-heap-proportional time; while its
+        // predicted pause is over the budget keep taking quick collections
+        // instead. Memory pressure below still forces one, and the deferral
+        // cap bounds how long an expensive intergen frontier can fester.
+        if (sweep_full && gc_max_pause_ns && gc_full_pause_est > gc_max_pause_ns &&
+            gc_full_deferred < gc_full_defer_cap) {
+            gc_full_deferred++;
+            sweep_full = 0;
+        }
     }
 
 
@@ -3207,6 +4336,11 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     if (live_bytes > max_total_memory) {
         sweep_full = 1;
     }
+    // Same treatment when the footprint target is exceeded: full sweeps are
+    // what frees whole pages back to the OS.
+    if (gc_soft_target && live_bytes > (int64_t)gc_soft_target) {
+        sweep_full = 1;
+    }
     if (gc_sweep_always_full) {
         sweep_full = 1;
     }
@@ -3219,12 +4353,14 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
         // on the first collection after sweep_full, and the current scan
         perm_scanned_bytes = 0;
         promoted_bytes = 0;
+        gc_full_deferred = 0;
     }
     scanned_bytes = 0;
     // 5. start sweeping
     uint64_t start_sweep_time = jl_hrtime();
     JL_PROBE_GC_SWEEP_BEGIN(sweep_full);
     sweep_weak_refs();
+    sweep_intern_tab();
     sweep_stack_pools();
     gc_sweep_foreign_objs();
     gc_sweep_other(ptls, sweep_full);
@@ -3240,6 +4376,7 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     uint64_t sweep_time = gc_end_time - start_sweep_time;
     gc_num.total_sweep_time += sweep_time;
     gc_num.sweep_time = sweep_time;
+    gc_hist_record(JL_GC_PHASE_SWEEP, sweep_time);
 
     // sweeping is over
     // 6. if it is a quick sweep, put back the remembered objects in queued state
@@ -3288,6 +4425,8 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     gc_num.allocd = 0;
     last_live_bytes = live_bytes;
     live_bytes += -gc_num.freed + gc_num.since_sweep;
+    jl_atomic_store_relaxed(&gc_heap_over_softlimit,
+                            gc_soft_target && live_bytes > (int64_t)gc_soft_target);
 
     if (collection == JL_GC_AUTO) {
       // If the current interval is larger than half the live data decrease the interval
@@ -3297,6 +4436,26 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
       if (gc_num.interval < default_collect_interval) gc_num.interval = default_collect_interval;
     }
 
+    // pause budget: update the pause predictors and, if a budget is set, size
+    // the next young generation so its predicted pause fits the budget
+    if (sweep_full)
+        gc_full_pause_est = gc_full_pause_est ? (3 * gc_full_pause_est + pause) / 4 : pause;
+    else if (actual_allocd > 0) {
+        double cost = (double)pause / (double)actual_allocd;
+        gc_ns_per_allocd = gc_ns_per_allocd == 0 ? cost : (3 * gc_ns_per_allocd + cost) / 4;
+    }
+    if (gc_max_pause_ns && collection == JL_GC_AUTO && gc_ns_per_allocd > 0) {
+        // leave headroom for estimation error; collections get scheduled
+        // earlier exactly when the measured allocation-rate cost predicts a
+        // pause past the budget
+        int64_t target = (int64_t)((double)gc_max_pause_ns * 0.75 / gc_ns_per_allocd);
+        int64_t min_interval = default_collect_interval / 16;
+        if (target < min_interval)
+            target = min_interval;
+        if ((int64_t)gc_num.interval > target)
+            gc_num.interval = target;
+    }
+
     if (gc_num.interval + live_bytes > max_total_memory) {
         if (live_bytes < max_total_memory) {
             gc_num.interval = max_total_memory - live_bytes;
@@ -3306,6 +4465,11 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
             gc_num.interval = default_collect_interval;
        }
     }
+    // collect before the heap would pass the soft footprint target
+    if (gc_soft_target && gc_num.interval + live_bytes > (int64_t)gc_soft_target &&
+        live_bytes < (int64_t)gc_soft_target) {
+        gc_num.interval = gc_soft_target - live_bytes;
+    }
 
     gc_time_summary(sweep_full, t_start, gc_end_time, gc_num.freed,
                     live_bytes, gc_num.interval, pause,
@@ -3320,6 +4484,9 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     if (pause > gc_num.max_pause) {
         gc_num.max_pause = pause;
     }
+    // unlike gc_num.pause, this counts recollects separately so the
+    // histogram reflects every stop-the-world episode
+    gc_hist_record(JL_GC_PHASE_PAUSE, pause);
     reset_thread_gc_counts();
 
     return recollect;
@@ -3371,6 +4538,8 @@ JL_DLLEXPORT void jl_gc_collect(jl_gc_collection_t collection)
     gc_invoke_callbacks(jl_gc_cb_pre_gc_t,
         gc_cblist_pre_gc, (collection));
 
+    gc_telemetry_update(1, 0);
+    uint64_t prev_gc_time = gc_num.total_time;
     if (!jl_atomic_load_relaxed(&jl_gc_disable_counter)) {
         JL_LOCK_NOGC(&finalizers_lock);
         if (_jl_gc_collect(ptls, collection)) {
@@ -3381,6 +4550,7 @@ JL_DLLEXPORT void jl_gc_collect(jl_gc_collection_t collection)
         }
         JL_UNLOCK_NOGC(&finalizers_lock);
     }
+    gc_telemetry_update(0, gc_num.total_time - prev_gc_time);
 
     // no-op for non-threading
     jl_safepoint_end_gc();
@@ -3390,7 +4560,14 @@ JL_DLLEXPORT void jl_gc_collect(jl_gc_collection_t collection)
     // Only disable finalizers on current thread
     // Doing this on all threads is racy (it's impossible to check
     // or wait for finalizers on other threads without dead lock).
-    if (!ptls->finalizers_inhibited && ptls->locks.len == 0) {
+    if (jl_gc_async_finalizers && jl_n_threads > 1) {
+        // leave the accumulated list for the scheduler pool to drain in
+        // chunks concurrently with mutator execution, instead of stalling
+        // this thread on the whole backlog
+        if (jl_atomic_load_relaxed(&jl_gc_have_pending_finalizers))
+            jl_wakeup_thread(-1);
+    }
+    else if (!ptls->finalizers_inhibited && ptls->locks.len == 0) {
         int8_t was_in_finalizer = ptls->in_finalizer;
         ptls->in_finalizer = 1;
         run_finalizers(ct);
@@ -3428,21 +4605,29 @@ void jl_init_thread_heap(jl_ptls_t ptls)
         ptls->disable_gc = 1;
     jl_thread_heap_t *heap = &ptls->heap;
     jl_gc_pool_t *p = heap->norm_pools;
+    jl_gc_pool_t *sp = heap->string_pools;
     for (int i = 0; i < JL_GC_N_POOLS; i++) {
         p[i].osize = jl_gc_sizeclasses[i];
         p[i].freelist = NULL;
         p[i].newpages = NULL;
+        sp[i].osize = jl_gc_sizeclasses[i];
+        sp[i].freelist = NULL;
+        sp[i].newpages = NULL;
     }
     arraylist_new(&heap->weak_refs, 0);
     arraylist_new(&heap->live_tasks, 0);
+    arraylist_new(&heap->recycled_tasks, 0);
     heap->mallocarrays = NULL;
     heap->mafreelist = NULL;
     heap->big_objects = NULL;
+    memset(heap->big_freelists, 0, sizeof(heap->big_freelists));
+    memset(heap->big_nfreelist, 0, sizeof(heap->big_nfreelist));
     arraylist_new(&heap->rem_bindings, 0);
     heap->remset = &heap->_remset[0];
     heap->last_remset = &heap->_remset[1];
     arraylist_new(heap->remset, 0);
     arraylist_new(heap->last_remset, 0);
+    arraylist_new(&heap->dirty_pages, 0);
     arraylist_new(&ptls->finalizers, 0);
     arraylist_new(&ptls->sweep_objs, 0);
 
@@ -3471,6 +4656,10 @@ void jl_gc_init(void)
     jl_gc_debug_init();
 
     arraylist_new(&finalizer_list_marked, 0);
+    arraylist_new(&weak_refs_marked, 0);
+    arraylist_new(&weak_refs_dirty, 0);
+    htable_new(&pinned_objects, 0);
+    uv_mutex_init(&pinned_objects_lock);
     arraylist_new(&to_finalize, 0);
 
     gc_num.interval = default_collect_interval;
@@ -3497,8 +4686,41 @@ void jl_gc_init(void)
     if (high_water_mark < max_total_memory)
        max_total_memory = high_water_mark;
 
+    char *cards = getenv("JULIA_GC_CARD_REMSET");
+    if (cards && atoi(cards))
+        gc_card_remset = 1;
+    char *bigcache = getenv("JULIA_GC_BIG_CACHE");
+    if (bigcache && !atoi(bigcache))
+        gc_big_cache_enabled = 0;
+    char *asyncfin = getenv("JULIA_ASYNC_FINALIZERS");
+    if (asyncfin && atoi(asyncfin))
+        jl_gc_async_finalizers = 1;
+    char *bumppools = getenv("JULIA_GC_BUMP_POOLS");
+    if (bumppools && atoi(bumppools))
+        gc_bump_pools = 1;
+#ifndef _OS_WINDOWS_
+    char *telem = getenv("JULIA_GC_TELEMETRY");
+    if (telem && telem[0]) {
+        // back the telemetry page with a file an external agent can map;
+        // fall back to the in-process static page if anything fails
+        int fd = open(telem, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd != -1) {
+            if (ftruncate(fd, sizeof(jl_gc_telemetry_t)) == 0) {
+                void *pg = mmap(NULL, sizeof(jl_gc_telemetry_t), PROT_READ | PROT_WRITE,
+                                MAP_SHARED, fd, 0);
+                if (pg != MAP_FAILED)
+                    gc_telemetry = (jl_gc_telemetry_t*)pg;
+            }
+            close(fd);
+        }
+    }
+#endif
+    gc_telemetry_update(0, 0);
+
     jl_gc_mark_sp_t sp = {NULL, NULL, NULL, NULL};
     gc_mark_loop(NULL, sp);
+    gc_mark_init_threads();
+    gc_sweep_init_thread();
     t_start = jl_hrtime();
 }
 
@@ -3509,6 +4731,46 @@ void jl_gc_set_max_memory(uint64_t max_mem) {
     }
 }
 
+// Set the soft footprint target, in bytes (0 disables it, the default).
+// This is a size the collector steers the heap back towards rather than a
+// limit it enforces: exceeding it remains legal but triggers full sweeps,
+// earlier collections, and eager page return (see gc_soft_target above).
+JL_DLLEXPORT void jl_gc_set_softlimit(uint64_t bytes)
+{
+    if (bytes < (uint64_t)1 << (sizeof(memsize_t) * 8 - 1))
+        gc_soft_target = (memsize_t)bytes;
+}
+
+// Entry point for external memory-pressure monitors (PSI, cgroup memory
+// events, embedder heuristics): call with `pressure` 1 when the system
+// comes under pressure and 0 once it relaxes. While the flag is set, freed
+// pool pages are returned with the eager MADV_DONTNEED instead of
+// MADV_FREE, and registered jl_gc_cb_memory_pressure_t callbacks run so
+// embedders can drop their own caches.
+JL_DLLEXPORT void jl_gc_notify_memory_pressure(int pressure)
+{
+    jl_atomic_store_relaxed(&gc_mem_pressure, !!pressure);
+    gc_invoke_callbacks(jl_gc_cb_memory_pressure_t,
+        gc_cblist_memory_pressure, (pressure));
+}
+
+// Set a soft target, in milliseconds, for the pause of a single collection
+// (0 disables the budget, the default). The collector trades throughput for
+// latency: collections are scheduled early enough that the predicted pause
+// stays within the budget, and heuristic full sweeps are deferred while
+// their predicted pause is over it. The target is best-effort -- a forced
+// full collection or memory pressure can still exceed it.
+JL_DLLEXPORT void jl_gc_set_max_pause(uint64_t max_pause_ms)
+{
+    gc_max_pause_ns = max_pause_ms * 1000000ull;
+    gc_full_deferred = 0;
+}
+
+JL_DLLEXPORT uint64_t jl_gc_get_max_pause(void)
+{
+    return gc_max_pause_ns / 1000000ull;
+}
+
 // callback for passing OOM errors from gmp
 JL_DLLEXPORT void jl_throw_out_of_memory_error(void)
 {
@@ -3526,6 +4788,8 @@ JL_DLLEXPORT void *jl_gc_counted_malloc(size_t sz)
         maybe_collect(ptls);
         jl_atomic_store_relaxed(&ptls->gc_num.allocd,
             jl_atomic_load_relaxed(&ptls->gc_num.allocd) + sz);
+        jl_atomic_store_relaxed(&ptls->gc_num.cum_allocd,
+            jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd) + sz);
         jl_atomic_store_relaxed(&ptls->gc_num.malloc,
             jl_atomic_load_relaxed(&ptls->gc_num.malloc) + 1);
     }
@@ -3541,6 +4805,8 @@ JL_DLLEXPORT void *jl_gc_counted_calloc(size_t nm, size_t sz)
         maybe_collect(ptls);
         jl_atomic_store_relaxed(&ptls->gc_num.allocd,
             jl_atomic_load_relaxed(&ptls->gc_num.allocd) + nm*sz);
+        jl_atomic_store_relaxed(&ptls->gc_num.cum_allocd,
+            jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd) + nm*sz);
         jl_atomic_store_relaxed(&ptls->gc_num.malloc,
             jl_atomic_load_relaxed(&ptls->gc_num.malloc) + 1);
     }
@@ -3571,9 +4837,12 @@ JL_DLLEXPORT void *jl_gc_counted_realloc_with_old_size(void *p, size_t old, size
         if (sz < old)
             jl_atomic_store_relaxed(&ptls->gc_num.freed,
                 jl_atomic_load_relaxed(&ptls->gc_num.freed) + (old - sz));
-        else
+        else {
             jl_atomic_store_relaxed(&ptls->gc_num.allocd,
                 jl_atomic_load_relaxed(&ptls->gc_num.allocd) + (sz - old));
+            jl_atomic_store_relaxed(&ptls->gc_num.cum_allocd,
+                jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd) + (sz - old));
+        }
         jl_atomic_store_relaxed(&ptls->gc_num.realloc,
             jl_atomic_load_relaxed(&ptls->gc_num.realloc) + 1);
     }
@@ -3648,6 +4917,8 @@ JL_DLLEXPORT void *jl_gc_managed_malloc(size_t sz)
         jl_throw(jl_memory_exception);
     jl_atomic_store_relaxed(&ptls->gc_num.allocd,
         jl_atomic_load_relaxed(&ptls->gc_num.allocd) + allocsz);
+    jl_atomic_store_relaxed(&ptls->gc_num.cum_allocd,
+        jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd) + allocsz);
     jl_atomic_store_relaxed(&ptls->gc_num.malloc,
         jl_atomic_load_relaxed(&ptls->gc_num.malloc) + 1);
     int last_errno = errno;
@@ -3683,9 +4954,12 @@ static void *gc_managed_realloc_(jl_ptls_t ptls, void *d, size_t sz, size_t olds
     else if (allocsz < oldsz)
         jl_atomic_store_relaxed(&ptls->gc_num.freed,
             jl_atomic_load_relaxed(&ptls->gc_num.freed) + (oldsz - allocsz));
-    else
+    else {
         jl_atomic_store_relaxed(&ptls->gc_num.allocd,
             jl_atomic_load_relaxed(&ptls->gc_num.allocd) + (allocsz - oldsz));
+        jl_atomic_store_relaxed(&ptls->gc_num.cum_allocd,
+            jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd) + (allocsz - oldsz));
+    }
     jl_atomic_store_relaxed(&ptls->gc_num.realloc,
         jl_atomic_load_relaxed(&ptls->gc_num.realloc) + 1);
 
@@ -3715,6 +4989,88 @@ JL_DLLEXPORT void *jl_gc_managed_realloc(void *d, size_t sz, size_t oldsz,
     return gc_managed_realloc_(ptls, d, sz, oldsz, isaligned, owner, 1);
 }
 
+// Allocate an array data buffer in its own anonymous mapping, so that growing
+// it later can use mremap instead of a copying realloc. Only used for buffers
+// satisfying `jl_buf_mmapped`; accounting mirrors `jl_gc_managed_malloc`.
+void *jl_gc_managed_mmap(size_t sz)
+{
+#ifdef _OS_LINUX_
+    jl_ptls_t ptls = jl_current_task->ptls;
+    maybe_collect(ptls);
+    size_t allocsz = LLT_ALIGN(sz, jl_page_size);
+    if (allocsz < sz)  // overflow in adding offs, size was "negative"
+        jl_throw(jl_memory_exception);
+    jl_atomic_store_relaxed(&ptls->gc_num.allocd,
+        jl_atomic_load_relaxed(&ptls->gc_num.allocd) + allocsz);
+    jl_atomic_store_relaxed(&ptls->gc_num.cum_allocd,
+        jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd) + allocsz);
+    jl_atomic_store_relaxed(&ptls->gc_num.malloc,
+        jl_atomic_load_relaxed(&ptls->gc_num.malloc) + 1);
+    int last_errno = errno;
+    void *b = mmap(NULL, allocsz, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (b == MAP_FAILED)
+        jl_throw(jl_memory_exception);
+    errno = last_errno;
+    maybe_record_alloc_to_profile((jl_value_t*)b, sz, (jl_datatype_t*)jl_buff_tag);
+    return b;
+#else
+    return jl_gc_managed_malloc(sz);
+#endif
+}
+
+// Resize a buffer allocated by `jl_gc_managed_mmap`. Unlike
+// `jl_gc_managed_realloc` this remaps the pages instead of copying the
+// contents, so growing a multi-GB buffer is O(page tables), not O(bytes).
+void *jl_gc_managed_mremap(void *d, size_t sz, size_t oldsz, jl_value_t *owner)
+{
+#ifdef _OS_LINUX_
+    jl_ptls_t ptls = jl_current_task->ptls;
+    maybe_collect(ptls);
+    size_t allocsz = LLT_ALIGN(sz, jl_page_size);
+    size_t oldallocsz = LLT_ALIGN(oldsz, jl_page_size);
+    if (allocsz < sz)  // overflow in adding offs, size was "negative"
+        jl_throw(jl_memory_exception);
+    if (jl_astaggedvalue(owner)->bits.gc == GC_OLD_MARKED) {
+        ptls->gc_cache.perm_scanned_bytes += allocsz - oldallocsz;
+        live_bytes += allocsz - oldallocsz;
+    }
+    else if (allocsz < oldallocsz)
+        jl_atomic_store_relaxed(&ptls->gc_num.freed,
+            jl_atomic_load_relaxed(&ptls->gc_num.freed) + (oldallocsz - allocsz));
+    else {
+        jl_atomic_store_relaxed(&ptls->gc_num.allocd,
+            jl_atomic_load_relaxed(&ptls->gc_num.allocd) + (allocsz - oldallocsz));
+        jl_atomic_store_relaxed(&ptls->gc_num.cum_allocd,
+            jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd) + (allocsz - oldallocsz));
+    }
+    jl_atomic_store_relaxed(&ptls->gc_num.realloc,
+        jl_atomic_load_relaxed(&ptls->gc_num.realloc) + 1);
+    int last_errno = errno;
+    void *b = mremap(d, oldallocsz, allocsz, MREMAP_MAYMOVE);
+    if (b == MAP_FAILED)
+        jl_throw(jl_memory_exception);
+    errno = last_errno;
+    maybe_record_alloc_to_profile((jl_value_t*)b, sz, jl_gc_unknown_type_tag);
+    return b;
+#else
+    return jl_gc_managed_realloc(d, sz, oldsz, 1, owner);
+#endif
+}
+
+// Free a malloc'd array data buffer eagerly (outside of sweeping), after its
+// contents have been moved into a mapping by the caller.
+void jl_gc_free_managed_buf(void *d, size_t oldsz, int isaligned) JL_NOTSAFEPOINT
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    jl_atomic_store_relaxed(&ptls->gc_num.freed,
+        jl_atomic_load_relaxed(&ptls->gc_num.freed) + oldsz);
+    if (isaligned)
+        jl_free_aligned(d);
+    else
+        free(d);
+}
+
 jl_value_t *jl_gc_realloc_string(jl_value_t *s, size_t sz)
 {
     size_t len = jl_string_len(s);
@@ -3917,6 +5273,13 @@ JL_DLLEXPORT int jl_gc_conservative_gc_support_enabled(void)
 JL_DLLEXPORT jl_value_t *jl_gc_internal_obj_base_ptr(void *p)
 {
     p = (char *) p - 1;
+    // reject addresses outside the pool space before walking the pagetable;
+    // this is where nearly all words of a conservatively scanned foreign
+    // stack bail out
+    uintptr_t blo, bhi;
+    jl_gc_pool_heap_bounds(&blo, &bhi);
+    if ((uintptr_t)p < blo || (uintptr_t)p >= bhi)
+        return NULL;
     jl_gc_pagemeta_t *meta = page_metadata(p);
     if (meta && meta->ages) {
         char *page = gc_page_data(p);
@@ -3942,8 +5305,7 @@ JL_DLLEXPORT jl_value_t *jl_gc_internal_obj_base_ptr(void *p)
             goto valid_object;
         }
         jl_gc_pool_t *pool =
-            jl_all_tls_states[meta->thread_n]->heap.norm_pools +
-            meta->pool_n;
+            gc_pool_from_n(jl_all_tls_states[meta->thread_n], meta->pool_n);
         if (meta->fl_begin_offset == (uint16_t) -1) {
             // case 2: this is a page on the newpages list
             jl_taggedvalue_t *newpages = pool->newpages;
@@ -4007,6 +5369,31 @@ JL_DLLEXPORT jl_value_t *jl_gc_internal_obj_base_ptr(void *p)
     return NULL;
 }
 
+// Conservatively scan the memory range [lo, hi) -- typically a foreign
+// stack segment -- and queue every word that resolves to a pool object for
+// marking. Returns the number of objects newly queued. Batching the scan on
+// this side of the library boundary keeps the per-word cost at the two
+// bounds comparisons above instead of an exported-function call, which is
+// the difference between a conservative root scan being noise and being a
+// pause contributor for embedders. Must only be called from GC callbacks,
+// under the same rules as jl_gc_mark_queue_obj.
+JL_DLLEXPORT size_t jl_gc_mark_conservative_range(jl_ptls_t ptls, void *lo, void *hi)
+{
+    uintptr_t blo, bhi;
+    jl_gc_pool_heap_bounds(&blo, &bhi);
+    size_t n = 0;
+    char **words = (char**)LLT_ALIGN((uintptr_t)lo, sizeof(void*));
+    for (; (char*)(words + 1) <= (char*)hi; words++) {
+        uintptr_t w = (uintptr_t)*words;
+        if (w - 1 < blo || w - 1 >= bhi)
+            continue;
+        jl_value_t *obj = jl_gc_internal_obj_base_ptr((void*)w);
+        if (obj && jl_gc_mark_queue_obj(ptls, obj))
+            n++;
+    }
+    return n;
+}
+
 JL_DLLEXPORT size_t jl_gc_max_internal_obj_size(void)
 {
     return GC_MAX_SZCLASS;
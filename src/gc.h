@@ -273,8 +273,14 @@ typedef struct _mallocarray_t {
     struct _mallocarray_t *next;
 } mallocarray_t;
 
+// bucketed remembered set: one card per GC_CARD_SZ bytes of page data
+// (used when JULIA_GC_CARD_REMSET is enabled, see gc.c)
+#define GC_CARD_LG2 9 // 512 bytes
+#define GC_CARD_SZ (1 << GC_CARD_LG2)
+#define GC_CARDS_PER_PAGE (GC_PAGE_SZ / GC_CARD_SZ)
+
 // pool page metadata
-typedef struct {
+typedef struct _jl_gc_pagemeta_t {
     // index of pool that owns this page
     uint8_t pool_n;
     // Whether any cell in the page is marked
@@ -307,8 +313,36 @@ typedef struct {
     uint16_t thread_n;        // thread id of the heap that owns this page
     char *data;
     uint8_t *ages;
+    // next page in the concurrent sweeper's ready list (see gc.c)
+    struct _jl_gc_pagemeta_t *next_ready;
+    // dirty remembered-set cards; a set byte means an old object whose
+    // cell begins in that card may have been stored a young pointer
+    uint8_t cards[GC_CARDS_PER_PAGE];
+    // whether this page is already on a thread's `dirty_pages` list
+    _Atomic(uint8_t) card_dirty;
 } jl_gc_pagemeta_t;
 
+// Strings get a parallel set of pools (`heap.string_pools`, same size
+// classes). The odd multiples of 8 among the size classes were always
+// string-only, but strings whose cell size is a multiple of 16 used to share
+// pages with other objects; segregating them keeps string-heavy allocation
+// bursts (parser output, field extraction) densely packed on pages that
+// contain nothing else, so they are scanned together and die in whole pages.
+// `pool_n` values of JL_GC_N_POOLS and above denote string pools.
+STATIC_INLINE jl_gc_pool_t *gc_pool_from_n(jl_ptls_t ptls2, int pool_n) JL_NOTSAFEPOINT
+{
+    if (pool_n >= JL_GC_N_POOLS)
+        return &ptls2->heap.string_pools[pool_n - JL_GC_N_POOLS];
+    return &ptls2->heap.norm_pools[pool_n];
+}
+
+STATIC_INLINE int gc_pool_n(jl_ptls_t ptls2, const jl_gc_pool_t *p) JL_NOTSAFEPOINT
+{
+    if (p >= ptls2->heap.string_pools)
+        return JL_GC_N_POOLS + (int)(p - ptls2->heap.string_pools);
+    return (int)(p - ptls2->heap.norm_pools);
+}
+
 // Page layout:
 //  Newpage freelist: sizeof(void*)
 //  Padding: GC_PAGE_OFFSET - sizeof(void*)
@@ -393,6 +427,8 @@ extern bigval_t *big_objects_marked;
 extern arraylist_t finalizer_list_marked;
 extern arraylist_t to_finalize;
 extern int64_t lazy_freed_pages;
+extern _Atomic(int) gc_mem_pressure;
+extern _Atomic(int) gc_heap_over_softlimit;
 
 STATIC_INLINE bigval_t *bigval_header(jl_taggedvalue_t *o) JL_NOTSAFEPOINT
 {
@@ -527,6 +563,8 @@ extern void *gc_mark_label_addrs[_GC_MARK_L_MAX];
 void jl_gc_init_page(void);
 NOINLINE jl_gc_pagemeta_t *jl_gc_alloc_page(void) JL_NOTSAFEPOINT;
 void jl_gc_free_page(void *p) JL_NOTSAFEPOINT;
+size_t jl_gc_current_pg_count(void) JL_NOTSAFEPOINT;
+JL_DLLEXPORT void jl_gc_pool_heap_bounds(uintptr_t *lo, uintptr_t *hi) JL_NOTSAFEPOINT;
 
 // GC debug
 
@@ -712,6 +750,7 @@ void gc_count_pool(void);
 size_t jl_array_nbytes(jl_array_t *a) JL_NOTSAFEPOINT;
 
 JL_DLLEXPORT void jl_enable_gc_logging(int enable);
+JL_DLLEXPORT int jl_gc_take_heap_snapshot(const char *path);
 void _report_gc_finished(uint64_t pause, uint64_t freed, int full, int recollect) JL_NOTSAFEPOINT;
 
 #ifdef __cplusplus
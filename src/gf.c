@@ -172,7 +172,11 @@ static jl_method_instance_t *jl_specializations_get_linfo_(jl_method_t *m JL_PRO
             if (!hv)
                 i -= 1;
             assert(jl_svecref(specializations, i) == jl_nothing);
-            jl_svecset(specializations, i, mi); // jl_atomic_store_release?
+            // publish with release so that the lock-free scan above (and the
+            // smallintset lookup) never observes a partially-initialized entry
+            _Atomic(jl_method_instance_t*) *slots = (_Atomic(jl_method_instance_t*)*)jl_svec_data(specializations);
+            jl_atomic_store_release(&slots[i], mi);
+            jl_gc_wb(specializations, mi);
             if (hv) {
                 // TODO: fuse lookup and insert steps?
                 jl_smallintset_insert(&m->speckeyset, (jl_value_t*)m, speccache_hash, i, specializations);
@@ -292,6 +296,12 @@ jl_code_info_t *jl_type_infer(jl_method_instance_t *mi, size_t world, int force)
     if (mi->inInference && !force)
         return NULL;
 
+    // another worker in the fleet may already have inferred this
+    // specialization (see the shared inference cache in dump.c)
+    src = jl_shared_infer_cache_lookup(mi, world);
+    if (src != NULL)
+        return src;
+
     jl_value_t **fargs;
     JL_GC_PUSHARGS(fargs, 3);
     fargs[0] = (jl_value_t*)jl_typeinf_func;
@@ -309,10 +319,16 @@ jl_code_info_t *jl_type_infer(jl_method_instance_t *mi, size_t world, int force)
 #ifdef _OS_WINDOWS_
     DWORD last_error = GetLastError();
 #endif
+    uint64_t inf_start_time = 0;
+    if (_jl_debug_compilation_timing)
+        inf_start_time = jl_hrtime();
     size_t last_age = ct->world_age;
     ct->world_age = jl_typeinf_world;
     mi->inInference = 1;
     in_inference++;
+    // inference's type temporaries are mostly dead on return: batch the GC
+    // work they trigger into one young sweep at region exit
+    jl_gc_begin_arena();
     JL_TRY {
         src = (jl_code_info_t*)jl_apply(fargs, 3);
     }
@@ -332,6 +348,7 @@ jl_code_info_t *jl_type_infer(jl_method_instance_t *mi, size_t world, int force)
         }
         src = NULL;
     }
+    jl_gc_end_arena();
     ct->world_age = last_age;
     in_inference--;
     mi->inInference = 0;
@@ -340,10 +357,24 @@ jl_code_info_t *jl_type_infer(jl_method_instance_t *mi, size_t world, int force)
 #endif
     errno = last_errno;
 
+    if (_jl_debug_compilation_timing && inf_start_time != 0) {
+        // note that nested inference times are attributed to each
+        // method instance on the inference stack
+        jl_value_t *boxedns = NULL;
+        JL_GC_PUSH1(&boxedns);
+        boxedns = jl_box_uint64(jl_hrtime() - inf_start_time);
+        jl_array_ptr_1d_push(_jl_debug_compilation_timing, (jl_value_t*)mi);
+        jl_array_ptr_1d_push(_jl_debug_compilation_timing, (jl_value_t*)jl_symbol("inference"));
+        jl_array_ptr_1d_push(_jl_debug_compilation_timing, boxedns);
+        JL_GC_POP();
+    }
+
     if (src && !jl_is_code_info(src)) {
         src = NULL;
     }
     JL_GC_POP();
+    if (src != NULL)
+        jl_shared_infer_cache_store(mi, src);
 #endif
     return src;
 }
@@ -1222,7 +1253,7 @@ static jl_method_instance_t *cache_method(
         jl_typemap_entry_t *old = (jl_typemap_entry_t*)jl_eqtable_get(oldcache, (jl_value_t*)tt, jl_nothing);
         jl_atomic_store_relaxed(&newentry->next, old);
         jl_gc_wb(newentry, old);
-        jl_array_t *newcache = (jl_array_t*)jl_eqtable_put(jl_atomic_load_relaxed(&mt->leafcache), (jl_value_t*)tt, (jl_value_t*)newentry, NULL);
+        jl_array_t *newcache = (jl_array_t*)jl_eqtable_put_incremental(jl_atomic_load_relaxed(&mt->leafcache), (jl_value_t*)tt, (jl_value_t*)newentry, NULL);
         if (newcache != oldcache) {
             jl_atomic_store_release(&mt->leafcache, newcache);
             jl_gc_wb(mt, newcache);
@@ -1303,8 +1334,11 @@ static jl_value_t *get_intersect_matches(jl_typemap_t *defs, jl_typemap_entry_t
         else
             va = NULL;
     }
+    // the visitor only needs the existence of an intersection, so leave
+    // .env NULL: computing the typevar environment for every scanned entry
+    // is a large share of insertion time on big method tables
     struct matches_env env = {{get_intersect_visitor, (jl_value_t*)type, va,
-            /* .ti = */ NULL, /* .env = */ jl_emptysvec, /* .issubty = */ 0},
+            /* .ti = */ NULL, /* .env = */ NULL, /* .issubty = */ 0},
         /* .newentry = */ newentry, /* .shadowed */ NULL};
     JL_GC_PUSH3(&env.match.env, &env.match.ti, &env.shadowed);
     jl_typemap_intersection_visitor(defs, 0, &env.match);
@@ -1387,6 +1421,27 @@ JL_DLLEXPORT jl_value_t *jl_debug_method_invalidation(int state)
     return jl_nothing;
 }
 
+jl_array_t *_jl_debug_compilation_timing JL_GLOBALLY_ROOTED = NULL;
+// Per-codeinstance compilation cost attribution: while enabled, inference
+// (jl_type_infer below) and LLVM emission (_jl_compile_codeinst in
+// jitlayers.cpp) append (subject, stage::Symbol, value::UInt64) triples to
+// the returned array.  The process-global counter behind
+// jl_cumulative_compile_time cannot say which method the time went to.
+JL_DLLEXPORT jl_value_t *jl_debug_compilation_timing(int state)
+{
+    /* After calling with `state = 1`, caller is responsible for
+       holding a reference to the returned array until this is called
+       again with `state = 0`. */
+    if (state) {
+        if (_jl_debug_compilation_timing)
+            return (jl_value_t*) _jl_debug_compilation_timing;
+        _jl_debug_compilation_timing = jl_alloc_array_1d(jl_array_any_type, 0);
+        return (jl_value_t*) _jl_debug_compilation_timing;
+    }
+    _jl_debug_compilation_timing = NULL;
+    return jl_nothing;
+}
+
 // call external callbacks registered with this method_instance
 static void invalidate_external(jl_method_instance_t *mi, size_t max_world) {
     jl_array_t *callbacks = mi->callbacks;
@@ -1461,8 +1516,11 @@ static void invalidate_method_instance(void (*f)(jl_code_instance_t*), jl_method
     JL_UNLOCK(&replaced->def.method->writelock);
 }
 
-// invalidate cached methods that overlap this definition
-void invalidate_backedges(void (*f)(jl_code_instance_t*), jl_method_instance_t *replaced_mi, size_t max_world, const char *why)
+// invalidate cached methods that overlap this definition.
+// `direct_callers`, when non-NULL, collects the depth-1 callers (each once)
+// so the caller can queue them for eager recompilation; deeper levels of the
+// cone stay lazy and re-infer on their next execution.
+void invalidate_backedges(void (*f)(jl_code_instance_t*), jl_method_instance_t *replaced_mi, size_t max_world, const char *why, arraylist_t *direct_callers)
 {
     JL_LOCK(&replaced_mi->def.method->writelock);
     jl_array_t *backedges = replaced_mi->backedges;
@@ -1472,6 +1530,14 @@ void invalidate_backedges(void (*f)(jl_code_instance_t*), jl_method_instance_t *
         size_t i, l = jl_array_len(backedges);
         jl_method_instance_t **replaced = (jl_method_instance_t**)jl_array_ptr_data(backedges);
         for (i = 0; i < l; i++) {
+            if (direct_callers) {
+                size_t j;
+                for (j = 0; j < direct_callers->len; j++)
+                    if (direct_callers->items[j] == (void*)replaced[i])
+                        break;
+                if (j == direct_callers->len)
+                    arraylist_push(direct_callers, replaced[i]);
+            }
             invalidate_method_instance(f, replaced[i], max_world, 1);
         }
     }
@@ -1485,6 +1551,15 @@ void invalidate_backedges(void (*f)(jl_code_instance_t*), jl_method_instance_t *
     }
 }
 
+// How many of the most recent backedge entries the insertion paths below
+// rescan for duplicates. Inference records a caller's edges together, so
+// duplicates overwhelmingly cluster at the tail; scanning the whole list
+// instead made mass method definition (and `.ji` backedge insertion)
+// quadratic in the number of callers of a hot callee. A duplicate that slips
+// past the window is harmless: invalidation detaches the list before
+// recursing and re-invalidating an already-invalidated instance is a no-op.
+#define BACKEDGE_DEDUP_WINDOW 32
+
 // add a backedge from callee to caller
 JL_DLLEXPORT void jl_method_instance_add_backedge(jl_method_instance_t *callee, jl_method_instance_t *caller)
 {
@@ -1497,17 +1572,81 @@ JL_DLLEXPORT void jl_method_instance_add_backedge(jl_method_instance_t *callee,
     }
     else {
         size_t i, l = jl_array_len(callee->backedges);
-        for (i = 0; i < l; i++) {
-            if (jl_array_ptr_ref(callee->backedges, i) == (jl_value_t*)caller)
+        size_t first = l > BACKEDGE_DEDUP_WINDOW ? l - BACKEDGE_DEDUP_WINDOW : 0;
+        for (i = l; i > first; i--) {
+            if (jl_array_ptr_ref(callee->backedges, i - 1) == (jl_value_t*)caller)
                 break;
         }
-        if (i == l) {
+        if (i == first) {
             jl_array_ptr_1d_push(callee->backedges, (jl_value_t*)caller);
         }
     }
     JL_UNLOCK(&callee->def.method->writelock);
 }
 
+// --- speculative global constants ---
+// Generated code may embed the current value of an assigned-once non-const
+// global (see emit_globalref in codegen.cpp). Each such embedding registers
+// the depending method instance with the binding here, so that a later
+// assignment can push the stale code out of the new world through the
+// backedge invalidation machinery above. The lists hold method-backed
+// instances only (kept alive by their method's specializations cache), so
+// they can live in plain malloc'd memory.
+static jl_mutex_t binding_speculations_lock;
+
+// record that `caller` embedded the current value of `b`
+JL_DLLEXPORT void jl_binding_add_speculation(jl_binding_t *b, jl_method_instance_t *caller)
+{
+    assert(jl_is_method(caller->def.method));
+    JL_LOCK(&binding_speculations_lock);
+    if (b->speculations == NULL) {
+        b->speculations = (arraylist_t*)malloc_s(sizeof(arraylist_t));
+        arraylist_new(b->speculations, 0);
+    }
+    size_t i, l = b->speculations->len;
+    for (i = 0; i < l; i++) {
+        if (b->speculations->items[i] == (void*)caller) {
+            JL_UNLOCK(&binding_speculations_lock);
+            return;
+        }
+    }
+    arraylist_push(b->speculations, caller);
+    JL_UNLOCK(&binding_speculations_lock);
+}
+
+// called after an assignment to `b`: demote every method instance that
+// embedded the old value to the worlds preceding the write
+JL_DLLEXPORT void jl_binding_invalidate_speculations(jl_binding_t *b)
+{
+    if (b->speculations == NULL)
+        return;
+    JL_LOCK(&binding_speculations_lock);
+    arraylist_t *speculations = b->speculations;
+    b->speculations = NULL;
+    JL_UNLOCK(&binding_speculations_lock);
+    if (speculations == NULL)
+        return;
+    size_t world = jl_atomic_fetch_add(&jl_world_counter, 1);
+    size_t i;
+    for (i = 0; i < speculations->len; i++) {
+        jl_method_instance_t *mi = (jl_method_instance_t*)speculations->items[i];
+        invalidate_external(mi, world);
+        invalidate_method_instance(&do_nothing_with_codeinst, mi, world, 0);
+    }
+    if (_jl_debug_method_invalidation) {
+        jl_value_t *loctag = NULL;
+        JL_GC_PUSH1(&loctag);
+        jl_value_t *gr = jl_atomic_load_relaxed(&b->globalref);
+        if (gr)
+            jl_array_ptr_1d_push(_jl_debug_method_invalidation, gr);
+        loctag = jl_cstr_to_string("jl_binding_invalidate_speculations");
+        jl_array_ptr_1d_push(_jl_debug_method_invalidation, loctag);
+        JL_GC_POP();
+    }
+    arraylist_free(speculations);
+    free(speculations);
+}
+
 // add a backedge from a non-existent signature to caller
 JL_DLLEXPORT void jl_method_table_add_backedge(jl_methtable_t *mt, jl_value_t *typ, jl_value_t *caller)
 {
@@ -1520,15 +1659,21 @@ JL_DLLEXPORT void jl_method_table_add_backedge(jl_methtable_t *mt, jl_value_t *t
         jl_array_ptr_set(mt->backedges, 1, caller);
     }
     else {
+        // entries are (typ, caller) pairs; only the trailing window is
+        // rescanned (see BACKEDGE_DEDUP_WINDOW above) since the full
+        // `jl_types_equal` sweep per insert was quadratic during load.
+        // An occasional un-deduplicated pair (or un-shared `typ` instance)
+        // only costs a redundant intersection test at invalidation time.
         size_t i, l = jl_array_len(mt->backedges);
-        for (i = 1; i < l; i += 2) {
-            if (jl_types_equal(jl_array_ptr_ref(mt->backedges, i - 1), typ)) {
-                if (jl_array_ptr_ref(mt->backedges, i) == caller) {
+        size_t first = l > 2 * BACKEDGE_DEDUP_WINDOW ? l - 2 * BACKEDGE_DEDUP_WINDOW : 0;
+        for (i = l; i > first + 1; i -= 2) {
+            if (jl_types_equal(jl_array_ptr_ref(mt->backedges, i - 2), typ)) {
+                if (jl_array_ptr_ref(mt->backedges, i - 1) == caller) {
                     JL_UNLOCK(&mt->writelock);
                     return;
                 }
                 // reuse the already cached instance of this type
-                typ = jl_array_ptr_ref(mt->backedges, i - 1);
+                typ = jl_array_ptr_ref(mt->backedges, i - 2);
             }
         }
         jl_array_ptr_1d_push(mt->backedges, typ);
@@ -1572,6 +1717,37 @@ static int invalidate_mt_cache(jl_typemap_entry_t *oldentry, void *closure0)
     }
     return 1;
 }
+// drop anything in mt->cache and mt->leafcache that was compiled for one of
+// the specializations in `shadowed`
+static void invalidate_mt_caches(jl_methtable_t *mt, jl_array_t *shadowed, jl_typemap_entry_t *newentry, size_t max_world)
+{
+    // TODO: keep track of just the `mi` for which shadowing was true (to avoid recomputing that here)
+    struct invalidate_mt_env mt_cache_env;
+    mt_cache_env.max_world = max_world;
+    mt_cache_env.shadowed = shadowed;
+    mt_cache_env.newentry = newentry;
+    mt_cache_env.invalidated = 0;
+
+    jl_typemap_visitor(jl_atomic_load_relaxed(&mt->cache), invalidate_mt_cache, (void*)&mt_cache_env);
+    jl_array_t *leafcache = jl_atomic_load_relaxed(&mt->leafcache);
+    // visit every level of a partially-migrated table
+    // (invalidate_mt_cache is idempotent, so seeing an entry
+    // in more than one level is harmless)
+    while (leafcache != NULL) {
+        size_t i, l = jl_array_len(leafcache);
+        for (i = 1; i < l; i += 2) {
+            jl_value_t *entry = jl_array_ptr_ref(leafcache, i);
+            if (entry) {
+                while (entry != jl_nothing) {
+                    invalidate_mt_cache((jl_typemap_entry_t*)entry, (void*)&mt_cache_env);
+                    entry = (jl_value_t*)jl_atomic_load_relaxed(&((jl_typemap_entry_t*)entry)->next);
+                }
+            }
+        }
+        leafcache = jl_eqtable_migration_chain(leafcache);
+    }
+}
+
 static int disable_mt_cache(jl_typemap_entry_t *oldentry, void *closure0)
 {
     struct invalidate_mt_env *env = (struct invalidate_mt_env*)closure0;
@@ -1615,16 +1791,22 @@ static void jl_method_table_invalidate(jl_methtable_t *mt, jl_typemap_entry_t *m
     mt_cache_env.invalidated = 0;
     jl_typemap_visitor(jl_atomic_load_relaxed(&mt->cache), disable_mt_cache, (void*)&mt_cache_env);
     jl_array_t *leafcache = jl_atomic_load_relaxed(&mt->leafcache);
-    size_t i, l = jl_array_len(leafcache);
-    for (i = 1; i < l; i += 2) {
-        jl_typemap_entry_t *oldentry = (jl_typemap_entry_t*)jl_array_ptr_ref(leafcache, i);
-        if (oldentry) {
-            while ((jl_value_t*)oldentry != jl_nothing) {
-                if (oldentry->max_world == ~(size_t)0)
-                    oldentry->max_world = mt_cache_env.max_world;
-                oldentry = jl_atomic_load_relaxed(&oldentry->next);
+    size_t i, l;
+    // visit every level of a partially-migrated table (idempotent, so
+    // seeing an entry in more than one level is harmless)
+    while (leafcache != NULL) {
+        l = jl_array_len(leafcache);
+        for (i = 1; i < l; i += 2) {
+            jl_typemap_entry_t *oldentry = (jl_typemap_entry_t*)jl_array_ptr_ref(leafcache, i);
+            if (oldentry) {
+                while ((jl_value_t*)oldentry != jl_nothing) {
+                    if (oldentry->max_world == ~(size_t)0)
+                        oldentry->max_world = mt_cache_env.max_world;
+                    oldentry = jl_atomic_load_relaxed(&oldentry->next);
+                }
             }
         }
+        leafcache = jl_eqtable_migration_chain(leafcache);
     }
     // Invalidate the backedges
     int invalidated = 0;
@@ -1635,7 +1817,7 @@ static void jl_method_table_invalidate(jl_methtable_t *mt, jl_typemap_entry_t *m
         if ((jl_value_t*)mi != jl_nothing) {
             invalidated = 1;
             invalidate_external(mi, methodentry->max_world);
-            invalidate_backedges(&do_nothing_with_codeinst, mi, methodentry->max_world, "jl_method_table_disable");
+            invalidate_backedges(&do_nothing_with_codeinst, mi, methodentry->max_world, "jl_method_table_disable", NULL);
         }
     }
     if (invalidated && _jl_debug_method_invalidation) {
@@ -1649,6 +1831,8 @@ static void jl_method_table_invalidate(jl_methtable_t *mt, jl_typemap_entry_t *m
 
 JL_DLLEXPORT void jl_method_table_disable(jl_methtable_t *mt, jl_method_t *method)
 {
+    if (mt->frozen)
+        jl_error("cannot delete methods from a frozen method table");
     if (jl_options.incremental && jl_generating_output())
         jl_printf(JL_STDERR, "WARNING: method deletion during Module precompile may lead to undefined behavior"
                              "\n  ** incremental compilation may be fatally broken for this module **\n\n");
@@ -1660,6 +1844,61 @@ JL_DLLEXPORT void jl_method_table_disable(jl_methtable_t *mt, jl_method_t *metho
     JL_UNLOCK(&mt->writelock);
 }
 
+// --- module freezing ---
+
+static int freeze_widen_entry(jl_typemap_entry_t *entry, void *closure)
+{
+    // A frozen table can never gain or lose methods, so a dispatch-cache
+    // entry that is valid now stays valid in every later world. Widening
+    // `min_world` to 1 makes the world check on every cache tier in
+    // `jl_lookup_generic_` (and in `lookup_leafcache`) unconditionally true
+    // for these entries. The cost is old-world fidelity: a task pinned to a
+    // world that predates the definition would now dispatch to it, which
+    // freezing explicitly declares acceptable.
+    (void)closure;
+    if (entry->max_world == ~(size_t)0)
+        entry->min_world = 1;
+    return 1;
+}
+
+static int freeze_mtable(jl_methtable_t *mt, void *env)
+{
+    (void)env;
+    JL_LOCK(&mt->writelock);
+    if (!mt->frozen)
+        mt->frozen = 2; // distinct from builtin tables (frozen == 1), for error messages
+    jl_typemap_visitor(jl_atomic_load_relaxed(&mt->cache), freeze_widen_entry, NULL);
+    jl_array_t *leafcache = jl_atomic_load_relaxed(&mt->leafcache);
+    // visit every level of a partially-migrated table (idempotent, so
+    // seeing an entry in more than one level is harmless)
+    while (leafcache != NULL) {
+        size_t i, l = jl_array_len(leafcache);
+        for (i = 1; i < l; i += 2) {
+            jl_typemap_entry_t *entry = (jl_typemap_entry_t*)jl_array_ptr_ref(leafcache, i);
+            if (entry) {
+                while ((jl_value_t*)entry != jl_nothing) {
+                    freeze_widen_entry(entry, NULL);
+                    entry = jl_atomic_load_relaxed(&entry->next);
+                }
+            }
+        }
+        leafcache = jl_eqtable_migration_chain(leafcache);
+    }
+    JL_UNLOCK(&mt->writelock);
+    return 1;
+}
+
+// Declare every method table owned by `m` (and, recursively, by its
+// submodules) closed: adding or deleting methods afterwards is an error, and
+// the world-age window of every currently-valid dispatch-cache entry is
+// widened so the per-call world validation degenerates to an always-taken
+// check. New specializations of the existing methods may still be compiled
+// and cached. Intended for fully-warm static deployments; not reversible.
+JL_DLLEXPORT void jl_module_freeze(jl_module_t *m)
+{
+    foreach_mtable_in_module(m, freeze_mtable, NULL);
+}
+
 static int jl_type_intersection2(jl_value_t *t1, jl_value_t *t2, jl_value_t **isect, jl_value_t **isect2)
 {
     *isect2 = NULL;
@@ -1686,6 +1925,100 @@ static int jl_type_intersection2(jl_value_t *t1, jl_value_t *t2, jl_value_t **is
     return 1;
 }
 
+// --- batched method insertion ---
+// Bulk-loading generated code defines methods one jl_method_table_insert at a
+// time; each insertion allocates its own world age and rescans the method
+// table's call caches for newly-shadowed entries. A batch groups those
+// inserts: every method defined inside it shares one new world age, and the
+// cache sweeps are coalesced into a single pass per affected method table
+// when the batch is closed. While a batch is open, the methods it has
+// inserted so far are already callable, but concurrent callers of the
+// affected generic functions may transiently reach a superseded method, so
+// batches are intended for load-then-use scenarios.
+static jl_mutex_t method_batch_lock;     // held for the whole batch
+static _Atomic(jl_task_t*) method_batch_owner;
+static int method_batch_depth = 0;
+static size_t method_batch_world = 0;
+static arraylist_t method_batch_shadowed; // (mt, mi) pairs pending a cache sweep
+
+static int in_method_batch(void) JL_NOTSAFEPOINT
+{
+    return jl_atomic_load_relaxed(&method_batch_owner) == jl_current_task;
+}
+
+JL_DLLEXPORT void jl_method_batch_begin(void)
+{
+    if (in_method_batch()) {
+        method_batch_depth++;
+        return;
+    }
+    JL_LOCK(&method_batch_lock);
+    method_batch_depth = 1;
+    method_batch_world = jl_atomic_fetch_add(&jl_world_counter, 1) + 1;
+    arraylist_new(&method_batch_shadowed, 0);
+    jl_atomic_store_relaxed(&method_batch_owner, jl_current_task);
+}
+
+JL_DLLEXPORT void jl_method_batch_end(void)
+{
+    assert(in_method_batch());
+    if (--method_batch_depth > 0)
+        return;
+    jl_atomic_store_relaxed(&method_batch_owner, NULL);
+    size_t max_world = method_batch_world - 1;
+    // group the deferred sweeps by method table, then visit each table once
+    htable_t bymt;
+    htable_new(&bymt, 0);
+    size_t i;
+    for (i = 0; i < method_batch_shadowed.len; i += 2) {
+        void *mt = method_batch_shadowed.items[i];
+        arraylist_t *l = (arraylist_t*)ptrhash_get(&bymt, mt);
+        if (l == HT_NOTFOUND) {
+            l = (arraylist_t*)malloc_s(sizeof(arraylist_t));
+            arraylist_new(l, 0);
+            ptrhash_put(&bymt, mt, l);
+        }
+        arraylist_push(l, method_batch_shadowed.items[i + 1]);
+    }
+    arraylist_free(&method_batch_shadowed);
+    jl_array_t *shadowed = NULL;
+    JL_GC_PUSH1(&shadowed);
+    for (i = 0; i < bymt.size; i += 2) {
+        if (bymt.table[i + 1] == HT_NOTFOUND)
+            continue;
+        jl_methtable_t *mt = (jl_methtable_t*)bymt.table[i];
+        arraylist_t *l = (arraylist_t*)bymt.table[i + 1];
+        shadowed = jl_alloc_vec_any(l->len);
+        size_t j;
+        for (j = 0; j < l->len; j++)
+            jl_array_ptr_set(shadowed, j, (jl_value_t*)l->items[j]);
+        arraylist_free(l);
+        free(l);
+        JL_LOCK(&mt->writelock);
+        invalidate_mt_caches(mt, shadowed, NULL, max_world);
+        JL_UNLOCK(&mt->writelock);
+    }
+    JL_GC_POP();
+    htable_free(&bymt);
+    JL_UNLOCK(&method_batch_lock);
+}
+
+// Scoped deoptimization (JULIA_REDEF_BG_COMPILE): when a redefinition
+// invalidates compiled callers, queue the direct callers for background
+// recompilation in the new world. Invalidated call sites already re-dispatch
+// through the invoke indirection, so this trades no correctness; it only
+// moves the re-inference of the code most likely to run next off the
+// foreground, while the rest of the dependency cone stays lazy as usual.
+static int redef_bg_compile(void)
+{
+    static int flag = -1;
+    if (flag == -1) {
+        char *opt = getenv("JULIA_REDEF_BG_COMPILE");
+        flag = (opt != NULL && atoi(opt) != 0);
+    }
+    return flag;
+}
+
 JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method, jl_tupletype_t *simpletype)
 {
     JL_TIMING(ADD_METHOD);
@@ -1695,13 +2028,18 @@ JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method
     jl_value_t *oldvalue = NULL;
     jl_array_t *oldmi = NULL;
     if (method->primary_world == 1)
-        method->primary_world = jl_atomic_fetch_add(&jl_world_counter, 1) + 1;
+        method->primary_world = in_method_batch() ? method_batch_world
+                              : jl_atomic_fetch_add(&jl_world_counter, 1) + 1;
     size_t max_world = method->primary_world - 1;
     jl_value_t *loctag = NULL;  // debug info for invalidation
     jl_value_t *isect = NULL;
     jl_value_t *isect2 = NULL;
     jl_value_t *isect3 = NULL;
     jl_typemap_entry_t *newentry = NULL;
+    int collect_direct = redef_bg_compile() && jl_n_threads > 1 &&
+                         !jl_generating_output() && jl_base_module != NULL;
+    arraylist_t direct_callers;
+    arraylist_new(&direct_callers, 0);
     JL_GC_PUSH7(&oldvalue, &oldmi, &newentry, &loctag, &isect, &isect2, &isect3);
     JL_LOCK(&mt->writelock);
     // first find if we have an existing entry to delete
@@ -1802,7 +2140,18 @@ JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method
                     jl_method_instance_t *mi = jl_atomic_load_relaxed(&data[i]);
                     if ((jl_value_t*)mi == jl_nothing)
                         continue;
-                    isect3 = jl_type_intersection(m->sig, (jl_value_t*)mi->specTypes);
+                    // Nothing can need invalidation if the new signature
+                    // provably cannot overlap this specialization; this skips
+                    // both intersections below for the bulk of the table when
+                    // inserting into heavily-specialized generic functions.
+                    if (jl_obviously_disjoint(type, (jl_value_t*)mi->specTypes))
+                        continue;
+                    if (jl_subtype((jl_value_t*)mi->specTypes, m->sig))
+                        // specializations are normally subtypes of their
+                        // method's signature, making this intersection trivial
+                        isect3 = (jl_value_t*)mi->specTypes;
+                    else
+                        isect3 = jl_type_intersection(m->sig, (jl_value_t*)mi->specTypes);
                     if (jl_type_intersection2(type, isect3, &isect, &isect2)) {
                         if (morespec[j] == (char)morespec_unknown)
                             morespec[j] = (char)(jl_type_morespecific(m->sig, type) ? morespec_is : morespec_isnot);
@@ -1836,32 +2185,26 @@ JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method
                         invalidate_external(mi, max_world);
                         if (mi->backedges) {
                             invalidated = 1;
-                            invalidate_backedges(&do_nothing_with_codeinst, mi, max_world, "jl_method_table_insert");
+                            invalidate_backedges(&do_nothing_with_codeinst, mi, max_world, "jl_method_table_insert",
+                                                 collect_direct ? &direct_callers : NULL);
                         }
                     }
                 }
             }
             if (jl_array_len(oldmi)) {
                 // search mt->cache and leafcache and drop anything that might overlap with the new method
-                // TODO: keep track of just the `mi` for which shadowing was true (to avoid recomputing that here)
-                struct invalidate_mt_env mt_cache_env;
-                mt_cache_env.max_world = max_world;
-                mt_cache_env.shadowed = oldmi;
-                mt_cache_env.newentry = newentry;
-                mt_cache_env.invalidated = 0;
-
-                jl_typemap_visitor(jl_atomic_load_relaxed(&mt->cache), invalidate_mt_cache, (void*)&mt_cache_env);
-                jl_array_t *leafcache = jl_atomic_load_relaxed(&mt->leafcache);
-                size_t i, l = jl_array_len(leafcache);
-                for (i = 1; i < l; i += 2) {
-                    jl_value_t *entry = jl_array_ptr_ref(leafcache, i);
-                    if (entry) {
-                        while (entry != jl_nothing) {
-                            invalidate_mt_cache((jl_typemap_entry_t*)entry, (void*)&mt_cache_env);
-                            entry = (jl_value_t*)jl_atomic_load_relaxed(&((jl_typemap_entry_t*)entry)->next);
-                        }
+                if (in_method_batch()) {
+                    // coalesce the sweeps: remember the shadowed
+                    // specializations and do one pass per table at batch end
+                    size_t i, l = jl_array_len(oldmi);
+                    for (i = 0; i < l; i++) {
+                        arraylist_push(&method_batch_shadowed, mt);
+                        arraylist_push(&method_batch_shadowed, jl_array_ptr_ref(oldmi, i));
                     }
                 }
+                else {
+                    invalidate_mt_caches(mt, oldmi, newentry, max_world);
+                }
             }
         }
         if (invalidated && _jl_debug_method_invalidation) {
@@ -1872,6 +2215,30 @@ JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method
         update_max_args(mt, type);
     }
     JL_UNLOCK(&mt->writelock);
+    if (direct_callers.len) {
+        // hand the invalidated direct callers to the background compiler
+        // (same hook as tiered execution); each one is still reachable from
+        // its method's specializations table, so the raw pointers are safe
+        jl_value_t *bgf = jl_get_global(jl_base_module, jl_symbol("_background_tier_compile"));
+        if (bgf != NULL) {
+            size_t world = jl_atomic_load_acquire(&jl_world_counter);
+            jl_value_t **fargs;
+            JL_GC_PUSHARGS(fargs, 3);
+            fargs[0] = bgf;
+            fargs[2] = jl_box_ulong(world);
+            jl_task_t *ct = jl_current_task;
+            size_t last_age = ct->world_age;
+            ct->world_age = world;
+            size_t i;
+            for (i = 0; i < direct_callers.len; i++) {
+                fargs[1] = (jl_value_t*)direct_callers.items[i];
+                jl_apply(fargs, 3);
+            }
+            ct->world_age = last_age;
+            JL_GC_POP();
+        }
+    }
+    arraylist_free(&direct_callers);
     JL_GC_POP();
 }
 
@@ -2104,6 +2471,44 @@ jl_code_instance_t *jl_compile_method_internal(jl_method_instance_t *mi, size_t
         }
     }
 
+    // tiered execution (JULIA_TIERED_COMPILE): instead of blocking the first
+    // call on the optimizing compiler, install the interpreter as a baseline
+    // tier and hand the optimizing compile to a background task. When it
+    // finishes, the compiled code instance lands ahead of the baseline in
+    // mi->cache and later calls pick it up through the invoke indirection.
+    static int tiered_compile = -1;
+    if (tiered_compile == -1) {
+        char *opt = getenv("JULIA_TIERED_COMPILE");
+        tiered_compile = (opt != NULL && atoi(opt) != 0);
+    }
+    if (tiered_compile && jl_n_threads > 1 && !jl_generating_output() &&
+        jl_is_method(def) && def->source != jl_nothing && def->generator == NULL &&
+        jl_base_module != NULL) {
+        jl_value_t *bgf = jl_get_global(jl_base_module, jl_symbol("_background_tier_compile"));
+        if (bgf != NULL) {
+            jl_code_info_t *interp_src = jl_code_for_interpreter(mi);
+            if (!jl_code_requires_compiler(interp_src)) {
+                codeinst = jl_new_codeinst(mi,
+                    (jl_value_t*)jl_any_type, NULL, NULL,
+                    0, 1, ~(size_t)0, 0, 0, jl_nothing, 0);
+                jl_atomic_store_relaxed(&codeinst->invoke, jl_fptr_interpret_call);
+                jl_mi_cache_insert(mi, codeinst);
+                jl_value_t **fargs;
+                JL_GC_PUSHARGS(fargs, 3);
+                fargs[0] = bgf;
+                fargs[1] = (jl_value_t*)mi;
+                fargs[2] = jl_box_ulong(world);
+                jl_task_t *ct = jl_current_task;
+                size_t last_age = ct->world_age;
+                ct->world_age = jl_get_world_counter();
+                jl_apply(fargs, 3);
+                ct->world_age = last_age;
+                JL_GC_POP();
+                return codeinst;
+            }
+        }
+    }
+
     codeinst = jl_generate_fptr(mi, world);
     if (!codeinst) {
         jl_method_instance_t *unspec = jl_get_unspecialized_from_mi(mi);
@@ -2119,7 +2524,7 @@ jl_code_instance_t *jl_compile_method_internal(jl_method_instance_t *mi, size_t
             }
             jl_generate_fptr_for_unspecialized(ucache);
         }
-        assert(jl_atomic_load_relaxed(&ucache->invoke) != NULL);
+        jl_invariant(jl_atomic_load_relaxed(&ucache->invoke) != NULL);
         if (jl_atomic_load_relaxed(&ucache->invoke) != jl_fptr_sparam &&
             jl_atomic_load_relaxed(&ucache->invoke) != jl_fptr_interpret_call) {
             // only these care about the exact specTypes, otherwise we can use it directly
@@ -2422,6 +2827,24 @@ STATIC_INLINE int sig_match_fast(jl_value_t *arg1t, jl_value_t **args, jl_value_
 
 _Atomic(jl_typemap_entry_t*) call_cache[N_CALL_CACHE] JL_GLOBALLY_ROOTED;
 static _Atomic(uint8_t) pick_which[N_CALL_CACHE];
+
+// Second-chance dispatch cache keyed by the hash of the concrete argument
+// types instead of the callsite. Megamorphic sites (one callsite, many
+// signatures) thrash the callsite-keyed slots above, but repeat signatures
+// still hit here since the key is the type tuple itself, sparing the
+// typemap level walk. Only entries that already satisfy the leafsig
+// criteria for `call_cache` are stored, so a `sig_match_fast` plus world
+// check fully validates a hit.
+_Atomic(jl_typemap_entry_t*) sig_call_cache[N_SIG_CACHE] JL_GLOBALLY_ROOTED;
+
+STATIC_INLINE uint32_t sig_cache_hash(jl_value_t *FT, jl_value_t **args, uint32_t nargs) JL_NOTSAFEPOINT
+{
+    // mix the memoized type hashes; `nargs` counts F plus the arguments
+    uint32_t h = ((jl_datatype_t*)FT)->hash;
+    for (uint32_t i = 0; i < nargs - 1; i++)
+        h = ((h << 5) | (h >> 27)) ^ ((jl_datatype_t*)jl_typeof(args[i]))->hash;
+    return h;
+}
 #ifdef JL_GF_PROFILE
 size_t ncalls;
 void call_cache_stats()
@@ -2439,8 +2862,35 @@ void call_cache_stats()
 }
 #endif
 
+// Inline-cache slots for dynamically-dispatched call sites emitted by codegen
+// (see `emit_apply_generic` in codegen.cpp). Each JIT'd dynamic call site gets
+// its own slot, so a hot site revalidates its last dispatch target directly
+// instead of hashing the callsite and probing the shared caches above. The
+// slots live in malloc'd blocks outside the GC heap and are scanned as roots
+// from gc.c, since a cached entry can outlive its typemap linkage after
+// invalidation. Only entries that satisfy the leafsig criteria for
+// `call_cache` are stored, so a `sig_match_fast` plus world check fully
+// validates a hit.
+jl_pic_slot_block_t *jl_pic_slot_blocks;
+static jl_mutex_t pic_slot_lock;
+
+JL_DLLEXPORT _Atomic(jl_typemap_entry_t*) *jl_alloc_pic_slot(void)
+{
+    JL_LOCK_NOGC(&pic_slot_lock);
+    jl_pic_slot_block_t *blk = jl_pic_slot_blocks;
+    if (blk == NULL || blk->used == PIC_SLOTS_PER_BLOCK) {
+        blk = (jl_pic_slot_block_t*)calloc(1, sizeof(jl_pic_slot_block_t));
+        blk->next = jl_pic_slot_blocks;
+        jl_pic_slot_blocks = blk;
+    }
+    _Atomic(jl_typemap_entry_t*) *slot = &blk->slots[blk->used++];
+    JL_UNLOCK_NOGC(&pic_slot_lock);
+    return slot;
+}
+
 STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t **args, uint32_t nargs,
-                                                       uint32_t callsite, size_t world)
+                                                       uint32_t callsite, size_t world,
+                                                       _Atomic(jl_typemap_entry_t*) *pic)
 {
 #ifdef JL_GF_PROFILE
     ncalls++;
@@ -2475,6 +2925,25 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
     jl_typemap_entry_t *entry = NULL;
     jl_methtable_t *mt = NULL;
     int i;
+    // check the thread-local cache first: a hit here never touches a cache
+    // line any other thread writes to
+    jl_ptls_t ptls = jl_current_task->ptls;
+    uint32_t local_idx = callsite & (JL_TLS_CALL_CACHE_SIZE - 1);
+    entry = jl_atomic_load_relaxed(&ptls->call_cache[local_idx]);
+    if (entry && nargs == jl_svec_len(entry->sig->parameters) &&
+        sig_match_fast(FT, args, jl_svec_data(entry->sig->parameters), nargs)) {
+        // an entry that was valid for this world when the slot was stamped
+        // stays valid for it: invalidation can only cap max_world to a world
+        // that was already current, never below one this task has run in, so
+        // a matching stamp lets us skip touching the entry's world bounds
+        if (ptls->call_cache_world[local_idx] == world ||
+            (world >= entry->min_world && world <= entry->max_world)) {
+            ptls->call_cache_world[local_idx] = world;
+            if (pic)
+                jl_atomic_store_release(pic, entry);
+            goto have_entry;
+        }
+    }
     // check each cache entry to see if it matches
     //#pragma unroll
     //for (i = 0; i < 4; i++) {
@@ -2486,6 +2955,10 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
             if (entry && nargs == jl_svec_len(entry->sig->parameters) && \
                 sig_match_fast(FT, args, jl_svec_data(entry->sig->parameters), nargs) && \
                 world >= entry->min_world && world <= entry->max_world) { \
+                jl_atomic_store_relaxed(&ptls->call_cache[local_idx], entry); \
+                ptls->call_cache_world[local_idx] = world; \
+                if (pic) \
+                    jl_atomic_store_release(pic, entry); \
                 goto have_entry; \
             } \
         } while (0);
@@ -2495,6 +2968,19 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
     LOOP_BODY(3);
 #undef LOOP_BODY
     i = 4;
+    // callsite-keyed slots missed; try the signature-hash-keyed slot, which
+    // survives megamorphic callsites
+    uint32_t sig_idx = sig_cache_hash((jl_value_t*)FT, args, nargs) & (N_SIG_CACHE - 1);
+    entry = jl_atomic_load_relaxed(&sig_call_cache[sig_idx]);
+    if (entry && nargs == jl_svec_len(entry->sig->parameters) &&
+        sig_match_fast(FT, args, jl_svec_data(entry->sig->parameters), nargs) &&
+        world >= entry->min_world && world <= entry->max_world) {
+        jl_atomic_store_relaxed(&ptls->call_cache[local_idx], entry);
+        ptls->call_cache_world[local_idx] = world;
+        if (pic)
+            jl_atomic_store_release(pic, entry);
+        goto have_entry;
+    }
     jl_tupletype_t *tt = NULL;
     int64_t last_alloc;
     if (i == 4) {
@@ -2529,6 +3015,11 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
             int which = jl_atomic_load_relaxed(&pick_which[cache_idx[0]]) + 1;
             jl_atomic_store_relaxed(&pick_which[cache_idx[0]], which);
             jl_atomic_store_release(&call_cache[cache_idx[which & 3]], entry);
+            jl_atomic_store_release(&sig_call_cache[sig_idx], entry);
+            jl_atomic_store_relaxed(&ptls->call_cache[local_idx], entry);
+            ptls->call_cache_world[local_idx] = world;
+            if (pic)
+                jl_atomic_store_release(pic, entry);
         }
     }
 
@@ -2567,14 +3058,123 @@ have_entry:
 
 JL_DLLEXPORT jl_value_t *jl_apply_generic(jl_value_t *F, jl_value_t **args, uint32_t nargs)
 {
+    JL_TIMING(DISPATCH);
     size_t world = jl_current_task->world_age;
     jl_method_instance_t *mfunc = jl_lookup_generic_(F, args, nargs,
                                                      jl_int32hash_fast(jl_return_address()),
-                                                     world);
+                                                     world, NULL);
     JL_GC_PROMISE_ROOTED(mfunc);
     return _jl_invoke(F, args, nargs, mfunc, world);
 }
 
+// `jl_apply_generic` with a dedicated inline-cache slot for the call site.
+// Codegen emits this for dynamic dispatch in JIT'd code, baking the address of
+// a `jl_alloc_pic_slot` slot into the generated code (so it is not usable when
+// compiling for a system image). The slot holds the last successful leafsig
+// lookup at this site and is revalidated exactly like a `call_cache` entry;
+// the signature guard subsumes a first-argument tag check, which on its own
+// would not be sound since dispatch considers every argument type.
+JL_DLLEXPORT jl_value_t *jl_apply_generic_pic(jl_value_t *F, jl_value_t **args, uint32_t nargs, jl_value_t **pic_)
+{
+    _Atomic(jl_typemap_entry_t*) *pic = (_Atomic(jl_typemap_entry_t*)*)pic_;
+    size_t world = jl_current_task->world_age;
+    jl_typemap_entry_t *entry = jl_atomic_load_relaxed(pic);
+    if (entry && nargs + 1 == jl_svec_len(entry->sig->parameters) &&
+        sig_match_fast(jl_typeof(F), args, jl_svec_data(entry->sig->parameters), nargs + 1) &&
+        world >= entry->min_world && world <= entry->max_world) {
+        jl_method_instance_t *mfunc = entry->func.linfo;
+        JL_GC_PROMISE_ROOTED(mfunc);
+        return _jl_invoke(F, args, nargs, mfunc, world);
+    }
+    jl_method_instance_t *mfunc = jl_lookup_generic_(F, args, nargs,
+                                                     jl_int32hash_fast(jl_return_address()),
+                                                     world, pic);
+    JL_GC_PROMISE_ROOTED(mfunc);
+    return _jl_invoke(F, args, nargs, mfunc, world);
+}
+
+// Batched counterpart of `jl_apply_generic` for dynamic map-style loops: one
+// callee applied to `ncalls` argument rows of `nargs` values each, laid out
+// contiguously in `args`, with the results written to `results`. The world
+// age, callsite hash and (on repeated type patterns) the dispatch lookup are
+// paid once per batch instead of once per element; a batch-local slot filled
+// by `jl_lookup_generic_` serves as the hoisted cache and is revalidated per
+// row with `sig_match_fast` only. The caller must keep every argument row and
+// the `results` buffer rooted for the whole batch, since any row's invoke may
+// trigger GC (e.g. pass the data pointers of `Any` arrays).
+JL_DLLEXPORT void jl_apply_generic_batch(jl_value_t *F, jl_value_t **args, uint32_t nargs,
+                                         size_t ncalls, jl_value_t **results)
+{
+    JL_TIMING(DISPATCH);
+    size_t world = jl_current_task->world_age;
+    uint32_t callsite = jl_int32hash_fast(jl_return_address());
+    _Atomic(jl_typemap_entry_t*) batch_cache;
+    jl_atomic_store_relaxed(&batch_cache, NULL);
+    for (size_t i = 0; i < ncalls; i++) {
+        jl_value_t **row = &args[i * nargs];
+        jl_method_instance_t *mfunc;
+        jl_typemap_entry_t *entry = jl_atomic_load_relaxed(&batch_cache);
+        if (entry && nargs + 1 == jl_svec_len(entry->sig->parameters) &&
+            sig_match_fast(jl_typeof(F), row, jl_svec_data(entry->sig->parameters), nargs + 1) &&
+            world >= entry->min_world && world <= entry->max_world) {
+            mfunc = entry->func.linfo;
+        }
+        else {
+            mfunc = jl_lookup_generic_(F, row, nargs, callsite, world, &batch_cache);
+        }
+        JL_GC_PROMISE_ROOTED(mfunc);
+        results[i] = _jl_invoke(F, row, nargs, mfunc, world);
+    }
+}
+
+// Typed counterpart of `jl_apply_generic` for callers that expect a bits
+// result: `rt` names the expected concrete isbits return type and `ret` a
+// buffer of at least `jl_datatype_size(rt)` bytes. When the call produces an
+// instance of exactly `rt`, its payload is copied into `ret` and NULL is
+// returned, so the caller never needs to root or unbox anything. Constant
+// returns are resolved from `rettype_const` without invoking or allocating at
+// all — for trivial accessors this removes the call and the box entirely.
+// When the result is some other type (or `rt` is not isbits), the boxed
+// result is returned exactly as `jl_apply_generic` would return it, and `ret`
+// is left untouched; the call is never re-executed.
+JL_DLLEXPORT jl_value_t *jl_apply_generic_unboxed(jl_value_t *rt, void *ret,
+                                                  jl_value_t *F, jl_value_t **args, uint32_t nargs)
+{
+    JL_TIMING(DISPATCH);
+    size_t world = jl_current_task->world_age;
+    jl_method_instance_t *mfunc = jl_lookup_generic_(F, args, nargs,
+                                                     jl_int32hash_fast(jl_return_address()),
+                                                     world, NULL);
+    JL_GC_PROMISE_ROOTED(mfunc);
+    if (__unlikely(!jl_isbits(rt)))
+        return _jl_invoke(F, args, nargs, mfunc, world);
+    // mirror of the codeinst walk in `_jl_invoke`, so that constant returns
+    // can be copied out before committing to a call
+    jl_code_instance_t *codeinst = jl_atomic_load_relaxed(&mfunc->cache);
+    while (codeinst) {
+        if (codeinst->min_world <= world && world <= codeinst->max_world) {
+            jl_callptr_t invoke = jl_atomic_load_relaxed(&codeinst->invoke);
+            if (invoke == jl_fptr_const_return) {
+                jl_value_t *res = codeinst->rettype_const;
+                if (jl_typeof(res) != rt)
+                    return verify_type(res);
+                memcpy(ret, jl_data_ptr(res), jl_datatype_size(rt));
+                return NULL;
+            }
+            if (invoke != NULL)
+                break;
+        }
+        codeinst = jl_atomic_load_relaxed(&codeinst->next);
+    }
+    jl_value_t *res = _jl_invoke(F, args, nargs, mfunc, world);
+    if (jl_typeof(res) != rt)
+        return res;
+    // the callee's generic entry still allocates this box today, but it dies
+    // here without ever being rooted, stored or returned
+    memcpy(ret, jl_data_ptr(res), jl_datatype_size(rt));
+    return NULL;
+}
+
 static jl_method_match_t *_gf_invoke_lookup(jl_value_t *types JL_PROPAGATES_ROOT, jl_value_t *mt, size_t world, size_t *min_valid, size_t *max_valid)
 {
     jl_value_t *unw = jl_unwrap_unionall((jl_value_t*)types);
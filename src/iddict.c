@@ -1,6 +1,14 @@
 // This file is a part of Julia. License is MIT: https://julialang.org/license
 
-#define hash_size(h) (jl_array_len(h) / 2)
+// Via jl_eqtable_put_incremental, large tables are grown by incremental
+// migration: the new array carries one extra pair past the probe space whose
+// key slot holds svec(old array, cursor) and whose value slot stays NULL, so
+// iteration and serialization skip it. Later insertions move a bounded chunk
+// of entries at a time, and lookups probe the chain of older arrays on a
+// miss. Migrated entries are left in place in the old array, since readers
+// may be probing it concurrently without any lock; a chain is only dropped
+// when a full rehash publishes a fresh array.
+#define hash_size(h) ((jl_array_len(h) / 2) & ~(size_t)1)
 
 // compute empirical max-probe for a given size
 #define max_probe(size) ((size) <= 1024 ? 16 : (size) >> 6)
@@ -8,29 +16,65 @@
 #define keyhash(k) jl_object_id_(jl_typeof(k), k)
 #define h2index(hv, sz) (size_t)(((hv) & ((sz)-1)) * 2)
 
-static inline int jl_table_assign_bp(jl_array_t **pa, jl_value_t *key, jl_value_t *val);
+// tables with at least this many slots grow by incremental migration
+#define EQTABLE_INCR_THRESH (1 << 16)
+// pairs examined per insertion while a migration is pending
+#define EQTABLE_MIGRATE_CHUNK 64
+// maximum chain length before growth falls back to an eager rehash
+#define EQTABLE_MAX_CHAIN 4
+
+static inline int jl_table_assign_bp(jl_array_t **pa, jl_value_t *key, jl_value_t *val, int incremental);
+
+static inline jl_svec_t *eqtable_migration(jl_array_t *a) JL_NOTSAFEPOINT
+{
+    size_t len = jl_array_len(a);
+    if (((len / 2) & 1) == 0)
+        return NULL;
+    _Atomic(jl_value_t*) *tab = (_Atomic(jl_value_t*)*)a->data;
+    return (jl_svec_t*)jl_atomic_load_relaxed(&tab[len - 2]);
+}
+
+// the not-yet-fully-migrated predecessor of `h`, if any
+jl_array_t *jl_eqtable_migration_chain(jl_array_t *h) JL_NOTSAFEPOINT
+{
+    jl_svec_t *hdr = eqtable_migration(h);
+    return hdr == NULL ? NULL : (jl_array_t*)jl_svecref(hdr, 0);
+}
 
 JL_DLLEXPORT jl_array_t *jl_idtable_rehash(jl_array_t *a, size_t newsz)
 {
-    size_t sz = jl_array_len(a);
+    // round down to a power of two (the length of a migrating table
+    // includes its header pair)
+    while (newsz & (newsz - 1))
+        newsz &= newsz - 1;
     size_t i;
-    jl_value_t **ol = (jl_value_t **)a->data;
+    int deeper = 0;
     jl_array_t *newa = jl_alloc_vec_any(newsz);
     // keep the original array in the original slot since we need `ol`
     // to be valid in the loop below.
     JL_GC_PUSH2(&newa, &a);
-    for (i = 0; i < sz; i += 2) {
-        if (ol[i + 1] != NULL) {
-            jl_table_assign_bp(&newa, ol[i], ol[i + 1]);
-            // it is however necessary here because allocation
-            // can (and will) occur in a recursive call inside table_lookup_bp
+    while (a != NULL) {
+        size_t sz = 2 * hash_size(a);
+        jl_value_t **ol = (jl_value_t **)a->data;
+        for (i = 0; i < sz; i += 2) {
+            if (ol[i + 1] != NULL) {
+                // an entry in an older chain level may be shadowed by a
+                // newer one that was already copied
+                if (!deeper || jl_table_peek_bp(newa, ol[i]) == NULL) {
+                    jl_table_assign_bp(&newa, ol[i], ol[i + 1], 0);
+                    // it is however necessary here because allocation
+                    // can (and will) occur in a recursive call inside table_lookup_bp
+                }
+            }
         }
+        a = jl_eqtable_migration_chain(a);
+        deeper = 1;
     }
     JL_GC_POP();
     return newa;
 }
 
-static inline int jl_table_assign_bp(jl_array_t **pa, jl_value_t *key, jl_value_t *val)
+static inline int jl_table_assign_bp(jl_array_t **pa, jl_value_t *key, jl_value_t *val, int incremental)
 {
     // pa points to a **un**rooted address
     uint_t hv;
@@ -92,14 +136,38 @@ static inline int jl_table_assign_bp(jl_array_t **pa, jl_value_t *key, jl_value_
         /* quadruple size, rehash, retry the insert */
         /* it's important to grow the table really fast; otherwise we waste */
         /* lots of time rehashing all the keys over and over. */
-        sz = jl_array_len(a);
+        sz = 2 * hash_size(a);
         if (sz < HT_N_INLINE)
             newsz = HT_N_INLINE;
         else if (sz >= (1 << 19) || (sz <= (1 << 8)))
             newsz = sz << 1;
         else
             newsz = sz << 2;
-        *pa = jl_idtable_rehash(*pa, newsz);
+        int defer = 0;
+        if (incremental && hash_size(a) >= EQTABLE_INCR_THRESH) {
+            int depth = 0;
+            jl_array_t *l = jl_eqtable_migration_chain(a);
+            while (l != NULL) {
+                depth++;
+                l = jl_eqtable_migration_chain(l);
+            }
+            defer = depth < EQTABLE_MAX_CHAIN;
+        }
+        if (defer) {
+            // defer moving the old entries: hang the old array off the new
+            // one and let later insertions migrate it chunk by chunk
+            jl_array_t *newa = NULL;
+            jl_value_t *cursor = NULL;
+            JL_GC_PUSH3(&a, &newa, &cursor);
+            newa = jl_alloc_vec_any(newsz + 2);
+            cursor = jl_box_long(0);
+            jl_array_ptr_set(newa, newsz, (jl_value_t*)jl_svec2((jl_value_t*)a, cursor));
+            JL_GC_POP();
+            *pa = newa;
+        }
+        else {
+            *pa = jl_idtable_rehash(*pa, newsz);
+        }
 
         a = *pa;
         tab = (_Atomic(jl_value_t*)*)a->data;
@@ -109,14 +177,13 @@ static inline int jl_table_assign_bp(jl_array_t **pa, jl_value_t *key, jl_value_
 }
 
 /* returns bp if key is in hash, otherwise NULL */
-inline _Atomic(jl_value_t*) *jl_table_peek_bp(jl_array_t *a, jl_value_t *key) JL_NOTSAFEPOINT
+static inline _Atomic(jl_value_t*) *jl_table_peek_bp_hashed(jl_array_t *a, jl_value_t *key, uint_t hv) JL_NOTSAFEPOINT
 {
     size_t sz = hash_size(a);
     if (sz == 0)
         return NULL;
     size_t maxprobe = max_probe(sz);
     _Atomic(jl_value_t*) *tab = (_Atomic(jl_value_t*)*)a->data;
-    uint_t hv = keyhash(key);
     size_t index = h2index(hv, sz);
     sz *= 2;
     size_t orig = index;
@@ -141,36 +208,151 @@ inline _Atomic(jl_value_t*) *jl_table_peek_bp(jl_array_t *a, jl_value_t *key) JL
     return NULL;
 }
 
-JL_DLLEXPORT
-jl_array_t *jl_eqtable_put(jl_array_t *h, jl_value_t *key, jl_value_t *val, int *p_inserted)
+inline _Atomic(jl_value_t*) *jl_table_peek_bp(jl_array_t *a, jl_value_t *key) JL_NOTSAFEPOINT
+{
+    return jl_table_peek_bp_hashed(a, key, keyhash(key));
+}
+
+// move up to `limit` pending pairs from the oldest part of the table into
+// the current array; runs with the same exclusivity as jl_eqtable_put
+static void jl_eqtable_migrate(jl_array_t **pa, size_t limit)
 {
-    int inserted = jl_table_assign_bp(&h, key, val);
+    jl_array_t *a = *pa;
+    jl_svec_t *hdr = eqtable_migration(a);
+    if (hdr == NULL)
+        return;
+    jl_array_t *old = (jl_array_t*)jl_svecref(hdr, 0);
+    size_t cursor = (size_t)jl_unbox_long(jl_svecref(hdr, 1));
+    size_t end = 2 * hash_size(old);
+    if (cursor >= end)
+        return; // fully migrated; kept only for readers still probing `old`
+    jl_value_t *k = NULL, *v = NULL;
+    JL_GC_PUSH3(&old, &k, &v);
+    _Atomic(jl_value_t*) *otab = (_Atomic(jl_value_t*)*)old->data;
+    while (cursor < end && limit--) {
+        v = jl_atomic_load_relaxed(&otab[cursor + 1]);
+        if (v != NULL) {
+            k = jl_atomic_load_relaxed(&otab[cursor]);
+            // the entry stays visible in `old` for concurrent readers;
+            // insert-if-absent so that a newer binding is not overwritten
+            if (jl_table_peek_bp_hashed(*pa, k, keyhash(k)) == NULL)
+                jl_table_assign_bp(pa, k, v, 1);
+        }
+        cursor += 2;
+    }
+    a = *pa;
+    hdr = eqtable_migration(a);
+    // the insertions above may have grown the table again, in which case
+    // the old cursor no longer applies
+    if (hdr != NULL && (jl_array_t*)jl_svecref(hdr, 0) == old)
+        jl_svecset(hdr, 1, jl_box_long((ssize_t)cursor));
+    JL_GC_POP();
+}
+
+static jl_array_t *jl_eqtable_put_(jl_array_t *h, jl_value_t *key, jl_value_t *val,
+                                   int *p_inserted, int incremental)
+{
+    JL_GC_PUSH1(&h);
+    int inserted = jl_table_assign_bp(&h, key, val, incremental);
+    if (eqtable_migration(h) != NULL) {
+        if (inserted && p_inserted != NULL) {
+            // the key may still be present in a not-yet-migrated array
+            uint_t hv = keyhash(key);
+            jl_array_t *l = jl_eqtable_migration_chain(h);
+            while (l != NULL) {
+                if (jl_table_peek_bp_hashed(l, key, hv) != NULL) {
+                    inserted = 0;
+                    break;
+                }
+                l = jl_eqtable_migration_chain(l);
+            }
+        }
+        jl_eqtable_migrate(&h, EQTABLE_MIGRATE_CHUNK);
+    }
     if (p_inserted)
         *p_inserted = inserted;
+    JL_GC_POP();
     return h;
 }
 
+JL_DLLEXPORT
+jl_array_t *jl_eqtable_put(jl_array_t *h, jl_value_t *key, jl_value_t *val, int *p_inserted)
+{
+    return jl_eqtable_put_(h, key, val, p_inserted, 0);
+}
+
+// like jl_eqtable_put, but a large table is grown by chaining the old array
+// off the new one instead of moving every entry at once, bounding the pause
+// for a single insertion; entries migrate over as later insertions come in.
+// Callers that walk the backing array directly must follow
+// jl_eqtable_migration_chain (or drain first with jl_idtable_drain).
+JL_DLLEXPORT
+jl_array_t *jl_eqtable_put_incremental(jl_array_t *h, jl_value_t *key, jl_value_t *val, int *p_inserted)
+{
+    return jl_eqtable_put_(h, key, val, p_inserted, 1);
+}
+
 // Note: lookup in the IdDict is permitted concurrently, if you avoid deletions,
 // and assuming you do use an external lock around all insertions
 JL_DLLEXPORT
 jl_value_t *jl_eqtable_get(jl_array_t *h, jl_value_t *key, jl_value_t *deflt) JL_NOTSAFEPOINT
 {
-    _Atomic(jl_value_t*) *bp = jl_table_peek_bp(h, key);
-    return (bp == NULL) ? deflt : jl_atomic_load_relaxed(bp);
+    uint_t hv = keyhash(key);
+    while (h != NULL) {
+        _Atomic(jl_value_t*) *bp = jl_table_peek_bp_hashed(h, key, hv);
+        if (bp != NULL)
+            return jl_atomic_load_relaxed(bp);
+        h = jl_eqtable_migration_chain(h);
+    }
+    return deflt;
+}
+
+// variant of `jl_eqtable_get` for callers that already know the key's
+// identity hash (e.g. type objects, which store it inline), saving the
+// `jl_object_id_` call on hot lookup paths
+jl_value_t *jl_eqtable_get_hashed(jl_array_t *h, jl_value_t *key, uintptr_t hv, jl_value_t *deflt) JL_NOTSAFEPOINT
+{
+    while (h != NULL) {
+        _Atomic(jl_value_t*) *bp = jl_table_peek_bp_hashed(h, key, hv);
+        if (bp != NULL)
+            return jl_atomic_load_relaxed(bp);
+        h = jl_eqtable_migration_chain(h);
+    }
+    return deflt;
 }
 
 JL_DLLEXPORT
 jl_value_t *jl_eqtable_pop(jl_array_t *h, jl_value_t *key, jl_value_t *deflt, int *found)
 {
-    _Atomic(jl_value_t*) *bp = jl_table_peek_bp(h, key);
+    uint_t hv = keyhash(key);
+    jl_value_t *val = NULL;
+    int f = 0;
+    // remove every copy along the migration chain so that a stale binding
+    // cannot resurface; the newest one provides the returned value
+    while (h != NULL) {
+        _Atomic(jl_value_t*) *bp = jl_table_peek_bp_hashed(h, key, hv);
+        if (bp != NULL) {
+            if (!f) {
+                f = 1;
+                val = jl_atomic_load_relaxed(bp);
+            }
+            jl_atomic_store_relaxed(bp - 1, jl_nothing); // clear the key
+            jl_atomic_store_relaxed(bp, NULL); // and the value (briefly corrupting the table)
+        }
+        h = jl_eqtable_migration_chain(h);
+    }
     if (found)
-        *found = (bp != NULL);
-    if (bp == NULL)
-        return deflt;
-    jl_value_t *val = jl_atomic_load_relaxed(bp);
-    jl_atomic_store_relaxed(bp - 1, jl_nothing); // clear the key
-    jl_atomic_store_relaxed(bp, NULL); // and the value (briefly corrupting the table)
-    return val;
+        *found = f;
+    return f ? val : deflt;
+}
+
+// complete any pending incremental migration by building a fresh compact
+// table; callers must store the result back, as with jl_idtable_rehash
+JL_DLLEXPORT jl_array_t *jl_idtable_drain(jl_array_t *h)
+{
+    if (eqtable_migration(h) == NULL)
+        return h;
+    return jl_idtable_rehash(h, jl_array_len(h));
 }
 
 JL_DLLEXPORT
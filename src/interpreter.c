@@ -19,6 +19,7 @@ typedef struct {
     jl_method_instance_t *mi; // MethodInstance we're executing, or NULL if toplevel
     jl_module_t *module; // context for globals
     jl_value_t **locals; // slots for holding local slots and ssavalues
+    const uint8_t *ops; // pre-decoded statement opcodes for eval_body, or NULL
     jl_svec_t *sparam_vals; // method static parameters, if eval-ing a method body
     size_t ip; // Leak the currently-evaluating statement index to backtrace capture
     int preevaluation; // use special rules for pre-evaluating expressions (deprecated--only for ccall handling)
@@ -419,11 +420,65 @@ static size_t eval_phi(jl_array_t *stmts, interpreter_state *s, size_t ns, size_
     return ip;
 }
 
+// Statement opcodes for the dispatch loop in eval_body. Statements are
+// classified once per frame (see decode_stmts); the switch in eval_body then
+// dispatches through a jump table instead of re-testing the statement type and
+// expression head every time a loop passes over the same statement.
+enum istmt_op {
+    IOP_EVAL = 0,      // no special control-flow handling: eval_stmt_value
+    IOP_GOTO,
+    IOP_GOTOIFNOT,
+    IOP_RETURN,
+    IOP_UPSILON,
+    IOP_ASSIGN,
+    IOP_ENTER,
+    IOP_LEAVE,
+    IOP_POP_EXCEPTION,
+    IOP_EXPR,          // other expression heads (method/toplevel/meta/...)
+    IOP_NEWVAR,
+    IOP_LINE
+};
+
+static void decode_stmts(jl_array_t *stmts, uint8_t *ops, size_t ns) JL_NOTSAFEPOINT
+{
+    for (size_t i = 0; i < ns; i++) {
+        jl_value_t *stmt = jl_array_ptr_ref(stmts, i);
+        uint8_t op = IOP_EVAL;
+        if (jl_is_gotonode(stmt))
+            op = IOP_GOTO;
+        else if (jl_is_gotoifnot(stmt))
+            op = IOP_GOTOIFNOT;
+        else if (jl_is_returnnode(stmt))
+            op = IOP_RETURN;
+        else if (jl_is_upsilonnode(stmt))
+            op = IOP_UPSILON;
+        else if (jl_is_expr(stmt)) {
+            jl_sym_t *head = ((jl_expr_t*)stmt)->head;
+            if (head == jl_assign_sym)
+                op = IOP_ASSIGN;
+            else if (head == jl_enter_sym)
+                op = IOP_ENTER;
+            else if (head == jl_leave_sym)
+                op = IOP_LEAVE;
+            else if (head == jl_pop_exception_sym)
+                op = IOP_POP_EXCEPTION;
+            else
+                op = IOP_EXPR;
+        }
+        else if (jl_is_newvarnode(stmt))
+            op = IOP_NEWVAR;
+        else if (jl_is_linenode(stmt))
+            op = IOP_LINE;
+        ops[i] = op;
+    }
+}
+
 static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip, int toplevel)
 {
     jl_handler_t __eh;
     size_t ns = jl_array_len(stmts);
     jl_task_t *ct = jl_current_task;
+    const uint8_t *ops = s->ops;
 
     while (1) {
         s->ip = ip;
@@ -435,10 +490,12 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
         assert(!jl_is_phinode(stmt));
         size_t next_ip = ip + 1;
         assert(!jl_is_phinode(stmt) && !jl_is_phicnode(stmt) && "malformed IR");
-        if (jl_is_gotonode(stmt)) {
+        switch (ops[ip]) {
+        case IOP_GOTO: {
             next_ip = jl_gotonode_label(stmt) - 1;
+            break;
         }
-        else if (jl_is_gotoifnot(stmt)) {
+        case IOP_GOTOIFNOT: {
             jl_value_t *cond = eval_value(jl_gotoifnot_cond(stmt), s);
             if (cond == jl_false) {
                 next_ip = jl_gotoifnot_label(stmt) - 1;
@@ -446,11 +503,12 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
             else if (cond != jl_true) {
                 jl_type_error("if", (jl_value_t*)jl_bool_type, cond);
             }
+            break;
         }
-        else if (jl_is_returnnode(stmt)) {
+        case IOP_RETURN: {
             return eval_value(jl_returnnode_value(stmt), s);
         }
-        else if (jl_is_upsilonnode(stmt)) {
+        case IOP_UPSILON: {
             jl_value_t *val = jl_fieldref_noalloc(stmt, 0);
             if (val)
                 val = eval_value(val, s);
@@ -458,158 +516,168 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
             assert(jl_is_ssavalue(phic));
             ssize_t id = ((jl_ssavalue_t*)phic)->id - 1;
             s->locals[jl_source_nslots(s->src) + id] = val;
+            break;
         }
-        else if (jl_is_expr(stmt)) {
-            // Most exprs are allowed to end a BB by fall through
-            jl_sym_t *head = ((jl_expr_t*)stmt)->head;
-            if (head == jl_assign_sym) {
-                jl_value_t *lhs = jl_exprarg(stmt, 0);
-                jl_value_t *rhs = eval_value(jl_exprarg(stmt, 1), s);
-                if (jl_is_slot(lhs)) {
-                    ssize_t n = jl_slot_number(lhs);
-                    assert(n <= jl_source_nslots(s->src) && n > 0);
-                    s->locals[n - 1] = rhs;
+        case IOP_ASSIGN: {
+            jl_value_t *lhs = jl_exprarg(stmt, 0);
+            jl_value_t *rhs = eval_value(jl_exprarg(stmt, 1), s);
+            if (jl_is_slot(lhs)) {
+                ssize_t n = jl_slot_number(lhs);
+                assert(n <= jl_source_nslots(s->src) && n > 0);
+                s->locals[n - 1] = rhs;
+            }
+            else {
+                jl_module_t *modu;
+                jl_sym_t *sym;
+                if (jl_is_globalref(lhs)) {
+                    modu = jl_globalref_mod(lhs);
+                    sym = jl_globalref_name(lhs);
                 }
                 else {
-                    jl_module_t *modu;
-                    jl_sym_t *sym;
-                    if (jl_is_globalref(lhs)) {
-                        modu = jl_globalref_mod(lhs);
-                        sym = jl_globalref_name(lhs);
-                    }
-                    else {
-                        assert(jl_is_symbol(lhs));
-                        modu = s->module;
-                        sym = (jl_sym_t*)lhs;
-                    }
-                    JL_GC_PUSH1(&rhs);
-                    jl_binding_t *b = jl_get_binding_wr_or_error(modu, sym);
-                    jl_checked_assignment(b, rhs);
-                    JL_GC_POP();
+                    assert(jl_is_symbol(lhs));
+                    modu = s->module;
+                    sym = (jl_sym_t*)lhs;
                 }
+                JL_GC_PUSH1(&rhs);
+                jl_binding_t *b = jl_get_binding_wr_or_error(modu, sym);
+                jl_checked_assignment(b, rhs);
+                JL_GC_POP();
             }
-            else if (head == jl_enter_sym) {
-                jl_enter_handler(&__eh);
-                // This is a bit tricky, but supports the implementation of PhiC nodes.
-                // They are conceptually slots, but the slot to store to doesn't get explicitly
-                // mentioned in the store (aka the "UpsilonNode") (this makes them integrate more
-                // nicely with the rest of the SSA representation). In a compiler, we would figure
-                // out which slot to store to at compile time when we encounter the statement. We
-                // can't quite do that here, but we do something similar: We scan the catch entry
-                // block (the only place where PhiC nodes may occur) to find all the Upsilons we
-                // can possibly encounter. Then, we remember which slot they store to (we abuse the
-                // SSA value result array for this purpose). TODO: We could do this only the first
-                // time we encounter a given enter.
-                size_t catch_ip = jl_unbox_long(jl_exprarg(stmt, 0)) - 1;
-                while (catch_ip < ns) {
-                    jl_value_t *phicnode = jl_array_ptr_ref(stmts, catch_ip);
-                    if (!jl_is_phicnode(phicnode))
-                        break;
-                    jl_array_t *values = (jl_array_t*)jl_fieldref_noalloc(phicnode, 0);
-                    for (size_t i = 0; i < jl_array_len(values); ++i) {
-                        jl_value_t *val = jl_array_ptr_ref(values, i);
-                        assert(jl_is_ssavalue(val));
-                        size_t upsilon = ((jl_ssavalue_t*)val)->id - 1;
-                        assert(jl_is_upsilonnode(jl_array_ptr_ref(stmts, upsilon)));
-                        s->locals[jl_source_nslots(s->src) + upsilon] = jl_box_ssavalue(catch_ip + 1);
-                    }
-                    s->locals[jl_source_nslots(s->src) + catch_ip] = NULL;
-                    catch_ip += 1;
-                }
-                // store current top of exception stack for restore in pop_exception.
-                s->locals[jl_source_nslots(s->src) + ip] = jl_box_ulong(jl_excstack_state());
-                if (!jl_setjmp(__eh.eh_ctx, 1)) {
-                    return eval_body(stmts, s, next_ip, toplevel);
-                }
-                else if (s->continue_at) { // means we reached a :leave expression
-                    ip = s->continue_at;
-                    s->continue_at = 0;
-                    continue;
-                }
-                else { // a real exception
-                    ip = catch_ip;
-                    continue;
+            break;
+        }
+        case IOP_ENTER: {
+            jl_enter_handler(&__eh);
+            // This is a bit tricky, but supports the implementation of PhiC nodes.
+            // They are conceptually slots, but the slot to store to doesn't get explicitly
+            // mentioned in the store (aka the "UpsilonNode") (this makes them integrate more
+            // nicely with the rest of the SSA representation). In a compiler, we would figure
+            // out which slot to store to at compile time when we encounter the statement. We
+            // can't quite do that here, but we do something similar: We scan the catch entry
+            // block (the only place where PhiC nodes may occur) to find all the Upsilons we
+            // can possibly encounter. Then, we remember which slot they store to (we abuse the
+            // SSA value result array for this purpose). TODO: We could do this only the first
+            // time we encounter a given enter.
+            size_t catch_ip = jl_unbox_long(jl_exprarg(stmt, 0)) - 1;
+            while (catch_ip < ns) {
+                jl_value_t *phicnode = jl_array_ptr_ref(stmts, catch_ip);
+                if (!jl_is_phicnode(phicnode))
+                    break;
+                jl_array_t *values = (jl_array_t*)jl_fieldref_noalloc(phicnode, 0);
+                for (size_t i = 0; i < jl_array_len(values); ++i) {
+                    jl_value_t *val = jl_array_ptr_ref(values, i);
+                    assert(jl_is_ssavalue(val));
+                    size_t upsilon = ((jl_ssavalue_t*)val)->id - 1;
+                    assert(jl_is_upsilonnode(jl_array_ptr_ref(stmts, upsilon)));
+                    s->locals[jl_source_nslots(s->src) + upsilon] = jl_box_ssavalue(catch_ip + 1);
                 }
+                s->locals[jl_source_nslots(s->src) + catch_ip] = NULL;
+                catch_ip += 1;
             }
-            else if (head == jl_leave_sym) {
-                int hand_n_leave = jl_unbox_long(jl_exprarg(stmt, 0));
-                assert(hand_n_leave > 0);
-                // equivalent to jl_pop_handler(hand_n_leave), but retaining eh for longjmp:
-                jl_handler_t *eh = ct->eh;
-                while (--hand_n_leave > 0)
-                    eh = eh->prev;
-                jl_eh_restore_state(eh);
-                // leave happens during normal control flow, but we must
-                // longjmp to pop the eval_body call for each enter.
-                s->continue_at = next_ip;
-                jl_longjmp(eh->eh_ctx, 1);
+            // store current top of exception stack for restore in pop_exception.
+            s->locals[jl_source_nslots(s->src) + ip] = jl_box_ulong(jl_excstack_state());
+            if (!jl_setjmp(__eh.eh_ctx, 1)) {
+                return eval_body(stmts, s, next_ip, toplevel);
             }
-            else if (head == jl_pop_exception_sym) {
-                size_t prev_state = jl_unbox_ulong(eval_value(jl_exprarg(stmt, 0), s));
-                jl_restore_excstack(prev_state);
+            else if (s->continue_at) { // means we reached a :leave expression
+                ip = s->continue_at;
+                s->continue_at = 0;
+                continue;
             }
-            else if (toplevel) {
-                if (head == jl_method_sym && jl_expr_nargs(stmt) > 1) {
-                    eval_methoddef((jl_expr_t*)stmt, s);
-                }
-                else if (head == jl_toplevel_sym) {
-                    jl_value_t *res = jl_toplevel_eval(s->module, stmt);
-                    s->locals[jl_source_nslots(s->src) + s->ip] = res;
+            else { // a real exception
+                ip = catch_ip;
+                continue;
+            }
+        }
+        case IOP_LEAVE: {
+            int hand_n_leave = jl_unbox_long(jl_exprarg(stmt, 0));
+            assert(hand_n_leave > 0);
+            // equivalent to jl_pop_handler(hand_n_leave), but retaining eh for longjmp:
+            jl_handler_t *eh = ct->eh;
+            while (--hand_n_leave > 0)
+                eh = eh->prev;
+            jl_eh_restore_state(eh);
+            // leave happens during normal control flow, but we must
+            // longjmp to pop the eval_body call for each enter.
+            s->continue_at = next_ip;
+            jl_longjmp(eh->eh_ctx, 1);
+        }
+        case IOP_POP_EXCEPTION: {
+            size_t prev_state = jl_unbox_ulong(eval_value(jl_exprarg(stmt, 0), s));
+            jl_restore_excstack(prev_state);
+            break;
+        }
+        case IOP_EXPR: {
+            // Most exprs are allowed to end a BB by fall through
+            jl_sym_t *head = ((jl_expr_t*)stmt)->head;
+            if (!toplevel) {
+                eval_stmt_value(stmt, s);
+            }
+            else if (head == jl_method_sym && jl_expr_nargs(stmt) > 1) {
+                eval_methoddef((jl_expr_t*)stmt, s);
+            }
+            else if (head == jl_toplevel_sym) {
+                jl_value_t *res = jl_toplevel_eval(s->module, stmt);
+                s->locals[jl_source_nslots(s->src) + s->ip] = res;
+            }
+            else if (jl_is_toplevel_only_expr(stmt)) {
+                jl_toplevel_eval(s->module, stmt);
+            }
+            else if (head == jl_meta_sym) {
+                if (jl_expr_nargs(stmt) == 1 && jl_exprarg(stmt, 0) == (jl_value_t*)jl_nospecialize_sym) {
+                    jl_set_module_nospecialize(s->module, 1);
                 }
-                else if (jl_is_toplevel_only_expr(stmt)) {
-                    jl_toplevel_eval(s->module, stmt);
+                if (jl_expr_nargs(stmt) == 1 && jl_exprarg(stmt, 0) == (jl_value_t*)jl_specialize_sym) {
+                    jl_set_module_nospecialize(s->module, 0);
                 }
-                else if (head == jl_meta_sym) {
-                    if (jl_expr_nargs(stmt) == 1 && jl_exprarg(stmt, 0) == (jl_value_t*)jl_nospecialize_sym) {
-                        jl_set_module_nospecialize(s->module, 1);
-                    }
-                    if (jl_expr_nargs(stmt) == 1 && jl_exprarg(stmt, 0) == (jl_value_t*)jl_specialize_sym) {
-                        jl_set_module_nospecialize(s->module, 0);
-                    }
-                    if (jl_expr_nargs(stmt) == 2) {
-                        if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_optlevel_sym) {
-                            if (jl_is_long(jl_exprarg(stmt, 1))) {
-                                int n = jl_unbox_long(jl_exprarg(stmt, 1));
-                                jl_set_module_optlevel(s->module, n);
-                            }
+                if (jl_expr_nargs(stmt) == 2) {
+                    if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_optlevel_sym) {
+                        if (jl_is_long(jl_exprarg(stmt, 1))) {
+                            int n = jl_unbox_long(jl_exprarg(stmt, 1));
+                            jl_set_module_optlevel(s->module, n);
                         }
-                        else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_compile_sym) {
-                            if (jl_is_long(jl_exprarg(stmt, 1))) {
-                                jl_set_module_compile(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
-                            }
+                    }
+                    else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_compile_sym) {
+                        if (jl_is_long(jl_exprarg(stmt, 1))) {
+                            jl_set_module_compile(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
                         }
-                        else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_infer_sym) {
-                            if (jl_is_long(jl_exprarg(stmt, 1))) {
-                                jl_set_module_infer(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
-                            }
+                    }
+                    else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_infer_sym) {
+                        if (jl_is_long(jl_exprarg(stmt, 1))) {
+                            jl_set_module_infer(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
                         }
-                        else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_max_methods_sym) {
-                            if (jl_is_long(jl_exprarg(stmt, 1))) {
-                                jl_set_module_max_methods(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
-                            }
+                    }
+                    else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_max_methods_sym) {
+                        if (jl_is_long(jl_exprarg(stmt, 1))) {
+                            jl_set_module_max_methods(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
                         }
                     }
                 }
-                else {
-                    eval_stmt_value(stmt, s);
-                }
             }
             else {
                 eval_stmt_value(stmt, s);
             }
+            break;
         }
-        else if (jl_is_newvarnode(stmt)) {
+        case IOP_NEWVAR: {
             jl_value_t *var = jl_fieldref(stmt, 0);
             assert(jl_is_slot(var));
             ssize_t n = jl_slot_number(var);
             assert(n <= jl_source_nslots(s->src) && n > 0);
             s->locals[n - 1] = NULL;
+            break;
         }
-        else if (toplevel && jl_is_linenode(stmt)) {
-            jl_lineno = jl_linenode_line(stmt);
+        case IOP_LINE: {
+            if (toplevel)
+                jl_lineno = jl_linenode_line(stmt);
+            else
+                eval_stmt_value(stmt, s);
+            break;
         }
-        else {
+        case IOP_EVAL:
+        default: {
             eval_stmt_value(stmt, s);
+            break;
+        }
         }
         ip = eval_phi(stmts, s, ns, next_ip);
     }
@@ -655,11 +723,16 @@ jl_value_t *NOINLINE jl_fptr_interpret_call(jl_value_t *f, jl_value_t **args, ui
     jl_array_t *stmts = src->code;
     assert(jl_typeis(stmts, jl_array_any_type));
     unsigned nroots = jl_source_nslots(src) + jl_source_nssavalues(src) + 2;
+    size_t ns = jl_array_len(stmts);
+    uint8_t *ops;
+    JL_CPPALLOCA(ops, ns);
+    decode_stmts(stmts, ops, ns);
     jl_value_t **locals = NULL;
     JL_GC_PUSHFRAME(s, locals, nroots);
     locals[0] = (jl_value_t*)src;
     locals[1] = (jl_value_t*)stmts;
     s->locals = locals + 2;
+    s->ops = ops;
     s->src = src;
     if (jl_is_module(mi->def.value)) {
         s->module = mi->def.module;
@@ -699,6 +772,10 @@ jl_value_t *jl_interpret_opaque_closure(jl_opaque_closure_t *oc, jl_value_t **ar
     jl_task_t *ct = jl_current_task;
     size_t last_age = ct->world_age;
     ct->world_age = oc->world;
+    size_t ns = jl_array_len(code->code);
+    uint8_t *ops;
+    JL_CPPALLOCA(ops, ns);
+    decode_stmts(code->code, ops, ns);
     jl_value_t **locals = NULL;
     JL_GC_PUSHFRAME(s, locals, nroots);
     locals[0] = (jl_value_t*)oc;
@@ -707,6 +784,7 @@ jl_value_t *jl_interpret_opaque_closure(jl_opaque_closure_t *oc, jl_value_t **ar
     JL_GC_PROMISE_ROOTED(code);
     locals[2] = (jl_value_t*)oc->captures;
     s->locals = locals + 2;
+    s->ops = ops;
     s->src = code;
     s->module = source->module;
     s->sparam_vals = NULL;
@@ -736,9 +814,14 @@ jl_value_t *NOINLINE jl_interpret_toplevel_thunk(jl_module_t *m, jl_code_info_t
 {
     interpreter_state *s;
     unsigned nroots = jl_source_nslots(src) + jl_source_nssavalues(src);
-    JL_GC_PUSHFRAME(s, s->locals, nroots);
     jl_array_t *stmts = src->code;
     assert(jl_typeis(stmts, jl_array_any_type));
+    size_t ns = jl_array_len(stmts);
+    uint8_t *ops;
+    JL_CPPALLOCA(ops, ns);
+    decode_stmts(stmts, ops, ns);
+    JL_GC_PUSHFRAME(s, s->locals, nroots);
+    s->ops = ops;
     s->src = src;
     s->module = m;
     s->sparam_vals = jl_emptysvec;
@@ -762,6 +845,7 @@ jl_value_t *NOINLINE jl_interpret_toplevel_expr_in(jl_module_t *m, jl_value_t *e
     jl_value_t **locals;
     JL_GC_PUSHFRAME(s, locals, 0);
     (void)locals;
+    s->ops = NULL; // eval_value only, no statement stream
     s->src = src;
     s->module = m;
     s->sparam_vals = sparam_vals;
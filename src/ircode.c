@@ -797,11 +797,136 @@ JL_DLLEXPORT jl_array_t *jl_compress_ir(jl_method_t *m, jl_code_info_t *code)
     return v;
 }
 
+// --- uncompressed IR cache ---
+
+// Inference re-inflates the same method's compressed IR once per caller it
+// gets inlined into, so hot Base methods can be decompressed hundreds of
+// times per session. Memoize the decoded tree in a small LRU keyed by the
+// compressed blob (one blob per inference result, so the key pins down both
+// the method and the world range it was inferred for). Both directions go
+// through jl_copy_ast, the same copy-on-write discipline the lowering cache
+// uses: callers mutate the copy we hand out, never the cached tree.
+
+#define IR_CACHE_SLOTS 64
+// budget counts compressed bytes (the decoded tree is a small multiple);
+// entries above an 8th of it would churn the rest of the cache out
+#define IR_CACHE_MAX_BYTES (4 << 20)
+
+jl_array_t *jl_ircode_cache JL_GLOBALLY_ROOTED = NULL; // marked as a root in gc.c
+static jl_mutex_t ircode_cache_lock;
+static size_t ircode_cache_bytes[IR_CACHE_SLOTS];
+static uint64_t ircode_cache_stamp[IR_CACHE_SLOTS];
+static uint64_t ircode_cache_tick;
+static size_t ircode_cache_live_bytes;
+
+// caller must hold ircode_cache_lock; returns the freed slot (or -1 if empty)
+static int ircode_cache_evict_lru(jl_array_t *cache)
+{
+    uint64_t oldest = UINT64_MAX;
+    int lru = -1;
+    for (int i = 0; i < IR_CACHE_SLOTS; i++) {
+        if (jl_array_ptr_ref(cache, 2 * i) != NULL && ircode_cache_stamp[i] < oldest) {
+            oldest = ircode_cache_stamp[i];
+            lru = i;
+        }
+    }
+    if (lru >= 0) {
+        jl_array_ptr_set(cache, 2 * lru, NULL);
+        jl_array_ptr_set(cache, 2 * lru + 1, NULL);
+        ircode_cache_live_bytes -= ircode_cache_bytes[lru];
+    }
+    return lru;
+}
+
+static jl_code_info_t *ircode_cache_lookup(jl_array_t *data)
+{
+    jl_array_t *cache = jl_ircode_cache;
+    if (cache == NULL)
+        return NULL;
+    jl_code_info_t *code = NULL;
+    JL_GC_PUSH1(&code);
+    JL_LOCK(&ircode_cache_lock);
+    for (int i = 0; i < IR_CACHE_SLOTS; i++) {
+        if (jl_array_ptr_ref(cache, 2 * i) == (jl_value_t*)data) {
+            code = (jl_code_info_t*)jl_array_ptr_ref(cache, 2 * i + 1);
+            ircode_cache_stamp[i] = ++ircode_cache_tick;
+            break;
+        }
+    }
+    JL_UNLOCK(&ircode_cache_lock);
+    // copy outside the lock; the local keeps the tree rooted if the entry
+    // gets evicted concurrently
+    if (code != NULL)
+        code = (jl_code_info_t*)jl_copy_ast((jl_value_t*)code);
+    JL_GC_POP();
+    return code;
+}
+
+static void ircode_cache_store(jl_array_t *data, jl_code_info_t *code)
+{
+    size_t sz = jl_array_len(data);
+    if (sz > IR_CACHE_MAX_BYTES / 8)
+        return;
+    jl_code_info_t *copy = NULL;
+    JL_GC_PUSH1(&copy);
+    copy = (jl_code_info_t*)jl_copy_ast((jl_value_t*)code);
+    if (jl_ircode_cache == NULL) {
+        jl_array_t *newcache = jl_alloc_vec_any(2 * IR_CACHE_SLOTS);
+        JL_LOCK(&ircode_cache_lock);
+        if (jl_ircode_cache == NULL)
+            jl_ircode_cache = newcache;
+        JL_UNLOCK(&ircode_cache_lock);
+    }
+    JL_LOCK(&ircode_cache_lock);
+    jl_array_t *cache = jl_ircode_cache;
+    int slot = -1;
+    for (int i = 0; i < IR_CACHE_SLOTS; i++) {
+        jl_value_t *k = jl_array_ptr_ref(cache, 2 * i);
+        if (k == (jl_value_t*)data) {
+            // another thread decoded the same blob first
+            slot = -2;
+            break;
+        }
+        if (k == NULL && slot < 0)
+            slot = i;
+    }
+    if (slot != -2) {
+        while (ircode_cache_live_bytes + sz > IR_CACHE_MAX_BYTES) {
+            int freed = ircode_cache_evict_lru(cache);
+            if (freed < 0)
+                break;
+            if (slot < 0)
+                slot = freed;
+        }
+        if (slot < 0)
+            slot = ircode_cache_evict_lru(cache);
+        if (slot >= 0) {
+            jl_array_ptr_set(cache, 2 * slot, (jl_value_t*)data);
+            jl_array_ptr_set(cache, 2 * slot + 1, (jl_value_t*)copy);
+            ircode_cache_bytes[slot] = sz;
+            ircode_cache_stamp[slot] = ++ircode_cache_tick;
+            ircode_cache_live_bytes += sz;
+        }
+    }
+    JL_UNLOCK(&ircode_cache_lock);
+    JL_GC_POP();
+}
+
 JL_DLLEXPORT jl_code_info_t *jl_uncompress_ir(jl_method_t *m, jl_code_instance_t *metadata, jl_array_t *data)
 {
     if (jl_is_code_info(data))
         return (jl_code_info_t*)data;
     JL_TIMING(AST_UNCOMPRESS);
+    jl_code_info_t *cached = ircode_cache_lookup(data);
+    if (cached != NULL) {
+        if (metadata) {
+            cached->min_world = metadata->min_world;
+            cached->max_world = metadata->max_world;
+            cached->rettype = metadata->rettype;
+            cached->parent = metadata->def;
+        }
+        return cached;
+    }
     JL_LOCK(&m->writelock); // protect the roots array (Might GC)
     assert(jl_is_method(m));
     assert(jl_typeis(data, jl_array_uint8_type));
@@ -870,6 +995,7 @@ JL_DLLEXPORT jl_code_info_t *jl_uncompress_ir(jl_method_t *m, jl_code_instance_t
     JL_GC_PUSH1(&code);
     jl_gc_enable(en);
     JL_UNLOCK(&m->writelock); // Might GC
+    ircode_cache_store(data, code);
     JL_GC_POP();
     if (metadata) {
         code->min_world = metadata->min_world;
@@ -880,6 +1006,74 @@ JL_DLLEXPORT jl_code_info_t *jl_uncompress_ir(jl_method_t *m, jl_code_instance_t
     return code;
 }
 
+// Compress a single value against `m`'s root table, in the same format the
+// IR compressor uses. Returns NULL if encoding needed a root without
+// provenance, since the result would only decode inside this process (the
+// same relocatability rule the incremental serializer applies to compressed
+// IR). Used by the shared inference cache to ship rettypes between workers.
+JL_DLLEXPORT jl_array_t *jl_compress_ir_value(jl_method_t *m, jl_value_t *v)
+{
+    JL_LOCK(&m->writelock); // protect the roots array (Might GC)
+    assert(jl_is_method(m));
+    ios_t dest;
+    ios_mem(&dest, 0);
+    int en = jl_gc_enable(0); // Might GC
+
+    if (m->roots == NULL) {
+        m->roots = jl_alloc_vec_any(0);
+        jl_gc_wb(m, m->roots);
+    }
+    jl_ircode_state s = {
+        &dest,
+        m,
+        jl_current_task->ptls,
+        1
+    };
+    jl_encode_value_(&s, v, 1);
+    write_uint8(s.s, s.relocatability);
+
+    ios_flush(s.s);
+    jl_array_t *r = jl_take_buffer(&dest);
+    ios_close(s.s);
+    if (jl_array_len(m->roots) == 0) {
+        m->roots = NULL;
+    }
+    JL_GC_PUSH1(&r);
+    jl_gc_enable(en);
+    JL_UNLOCK(&m->writelock); // Might GC
+    JL_GC_POP();
+    if (((uint8_t*)r->data)[jl_array_len(r) - 1] != 1)
+        return NULL;
+    return r;
+}
+
+JL_DLLEXPORT jl_value_t *jl_uncompress_ir_value(jl_method_t *m, jl_array_t *data)
+{
+    JL_LOCK(&m->writelock); // protect the roots array (Might GC)
+    assert(jl_is_method(m));
+    assert(jl_typeis(data, jl_array_uint8_type));
+    ios_t src;
+    ios_mem(&src, 0);
+    ios_setbuf(&src, (char*)data->data, jl_array_len(data), 0);
+    src.size = jl_array_len(data);
+    int en = jl_gc_enable(0); // Might GC
+    jl_ircode_state s = {
+        &src,
+        m,
+        jl_current_task->ptls,
+        1
+    };
+    jl_value_t *v = jl_decode_value(&s);
+    (void)read_uint8(s.s); // relocatability
+    assert(ios_getc(s.s) == -1);
+    ios_close(s.s);
+    JL_GC_PUSH1(&v);
+    jl_gc_enable(en);
+    JL_UNLOCK(&m->writelock); // Might GC
+    JL_GC_POP();
+    return v;
+}
+
 JL_DLLEXPORT uint8_t jl_ir_flag_inferred(jl_array_t *data)
 {
     if (jl_is_code_info(data))
@@ -13,8 +13,12 @@
 #if JL_LLVM_VERSION >= 130000
 #include <llvm/ExecutionEngine/Orc/ExecutorProcessControl.h>
 #endif
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/FormattedStream.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
 #include <llvm/Support/SmallVectorMemoryBuffer.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Transforms/Utils/Cloning.h>
@@ -94,6 +98,68 @@ void jl_jit_globals(std::map<void *, GlobalVariable*> &globals)
     }
 }
 
+// Method instances whose most recently emitted code still reaches some
+// invoke target through the generic `jl_invoke` entry because the target had
+// no code instance at codegen time. Drained by jl_jit_freeze_invokes; the
+// codegen lock guards all accesses.
+static SmallVector<jl_method_instance_t*, 0> unresolved_invoke_callers;
+
+// One entry per emission batch: the executable ranges the memory manager
+// handed out while the batch was materialized, plus the code instances whose
+// entry points live in those ranges. Used by jl_jit_evict_cold to return the
+// memory of batches whose every instance has been invalidated. The code
+// instances are not GC roots here; they are kept alive by their method
+// instance cache chains (same reasoning as unresolved_invoke_callers above).
+// The codegen lock guards all accesses.
+struct JITCodeRegion {
+    SmallVector<std::pair<void*, size_t>, 4> ranges;
+    SmallVector<jl_code_instance_t*, 4> insts;
+    size_t bytes;
+    uint8_t cold_passes;
+    bool released;
+};
+static std::vector<JITCodeRegion> jit_code_regions;
+static size_t jit_code_live_bytes;
+static size_t jit_code_released_bytes;
+
+extern "C" JL_DLLEXPORT size_t jl_jit_evict_cold_impl(size_t target_bytes);
+
+// Budget in bytes above which _jl_compile_codeinst tries to evict cold code,
+// from JULIA_JIT_CODE_BUDGET_MB. 0 (the default) disables eviction.
+static size_t jl_jit_code_budget(void)
+{
+    static size_t budget = []() -> size_t {
+        const char *env = getenv("JULIA_JIT_CODE_BUDGET_MB");
+        if (!env || !*env)
+            return 0;
+        char *endp = NULL;
+        unsigned long mb = strtoul(env, &endp, 10);
+        if (endp == env)
+            return 0;
+        return (size_t)mb * 1024 * 1024;
+    }();
+    return budget;
+}
+
+// Number of compilations an LLVMContext serves before the pool retires it,
+// from JULIA_JIT_CONTEXT_REUSE. 0 recycles contexts forever (the old
+// behavior); the default bounds how much interned type/constant memory a
+// recycled context can accumulate.
+static size_t jl_jit_context_reuse_cap(void)
+{
+    static size_t cap = []() -> size_t {
+        const char *env = getenv("JULIA_JIT_CONTEXT_REUSE");
+        if (!env || !*env)
+            return 64;
+        char *endp = NULL;
+        unsigned long n = strtoul(env, &endp, 10);
+        if (endp == env)
+            return 64;
+        return (size_t)n;
+    }();
+    return cap;
+}
+
 // this generates llvm code for the lambda info
 // and adds the result to the jitlayers
 // (and the shadow module),
@@ -102,12 +168,14 @@ static jl_callptr_t _jl_compile_codeinst(
         jl_code_instance_t *codeinst,
         jl_code_info_t *src,
         size_t world,
-        orc::ThreadSafeContext context)
+        orc::ThreadSafeContext context,
+        int force_optlevel = -1)
 {
     // caller must hold codegen_lock
     // and have disabled finalizers
     uint64_t start_time = 0;
-    bool timed = !!*jl_ExecutionEngine->get_dump_compiles_stream();
+    bool telemetry = _jl_debug_compilation_timing != NULL;
+    bool timed = telemetry || !!*jl_ExecutionEngine->get_dump_compiles_stream();
     if (timed)
         start_time = jl_hrtime();
 
@@ -117,6 +185,7 @@ static jl_callptr_t _jl_compile_codeinst(
     assert(src && jl_is_code_info(src));
 
     jl_callptr_t fptr = NULL;
+    size_t ir_count = 0;
     // emit the code in LLVM IR form
     jl_codegen_params_t params(std::move(context)); // Locks the context
     params.cache = true;
@@ -135,6 +204,21 @@ static jl_callptr_t _jl_compile_codeinst(
 
         if (params._shared_module)
             jl_ExecutionEngine->addModule(std::move(params._shared_module));
+        if (telemetry) {
+            for (auto &def : emitted)
+                ir_count += std::get<0>(def.second).getModuleUnlocked()->getInstructionCount();
+        }
+        // Remember callers that could not be devirtualized: a call to the
+        // generic `jl_invoke` entry means some invoke target had no code
+        // instance at codegen time, and the emitted code keeps paying the
+        // per-call indirection even after the target gets compiled (see
+        // jl_jit_freeze_invokes below).
+        for (auto &def : emitted) {
+            auto M = std::get<0>(def.second).getModuleUnlocked();
+            GlobalValue *generic_invoke = M->getNamedValue(XSTR(jl_invoke));
+            if (generic_invoke && !generic_invoke->use_empty())
+                unresolved_invoke_callers.push_back(def.first->def);
+        }
         StringMap<orc::ThreadSafeModule*> NewExports;
         StringMap<void*> NewGlobals;
         for (auto &global : params.globals) {
@@ -144,6 +228,10 @@ static jl_callptr_t _jl_compile_codeinst(
             orc::ThreadSafeModule &TSM = std::get<0>(def.second);
             //The underlying context object is still locked because params is not destroyed yet
             auto M = TSM.getModuleUnlocked();
+            if (force_optlevel >= 0) {
+                // pin the optimization level for this module (see OptSelLayerT::emit)
+                M->addModuleFlag(Module::Error, "julia.optlevel", force_optlevel);
+            }
             for (auto &F : M->global_objects()) {
                 if (!F.isDeclaration() && F.getLinkage() == GlobalValue::ExternalLinkage) {
                     NewExports[F.getName()] = &TSM;
@@ -197,10 +285,56 @@ static jl_callptr_t _jl_compile_codeinst(
             fptr = addr;
     }
 
+    // Record the executable memory this batch materialized so that
+    // jl_jit_evict_cold can later return it if every instance in the batch
+    // gets invalidated. The lookups above forced materialization, so the
+    // memory manager has seen all of this batch's code allocations by now.
+    {
+        void *addrs[32];
+        size_t sizes[32];
+        size_t nranges = jl_ExecutionEngine->drainRecentCodeAllocs(
+                addrs, sizes, sizeof(addrs) / sizeof(addrs[0]));
+        if (nranges > 0) {
+            JITCodeRegion region;
+            region.bytes = 0;
+            region.cold_passes = 0;
+            region.released = false;
+            for (size_t i = 0; i < nranges; i++) {
+                region.ranges.push_back(std::make_pair(addrs[i], sizes[i]));
+                region.bytes += sizes[i];
+            }
+            for (auto &def : emitted)
+                region.insts.push_back(def.first);
+            jit_code_live_bytes += region.bytes;
+            jit_code_regions.push_back(std::move(region));
+            size_t budget = jl_jit_code_budget();
+            if (budget && jit_code_live_bytes - jit_code_released_bytes > budget)
+                jl_jit_evict_cold_impl(budget - budget / 4);
+        }
+    }
+
     uint64_t end_time = 0;
     if (timed)
         end_time = jl_hrtime();
 
+    if (telemetry && _jl_debug_compilation_timing) {
+        // attribute the whole emission batch (the root code instance plus
+        // everything its workqueue pulled in) to the instance that
+        // triggered it; machine code size is not known at this layer
+        // since ORC emits object code lazily
+        jl_value_t *boxed = NULL;
+        JL_GC_PUSH1(&boxed);
+        boxed = jl_box_uint64(end_time - start_time);
+        jl_array_ptr_1d_push(_jl_debug_compilation_timing, (jl_value_t*)codeinst);
+        jl_array_ptr_1d_push(_jl_debug_compilation_timing, (jl_value_t*)jl_symbol("codegen"));
+        jl_array_ptr_1d_push(_jl_debug_compilation_timing, boxed);
+        boxed = jl_box_uint64(ir_count);
+        jl_array_ptr_1d_push(_jl_debug_compilation_timing, (jl_value_t*)codeinst);
+        jl_array_ptr_1d_push(_jl_debug_compilation_timing, (jl_value_t*)jl_symbol("ir_size"));
+        jl_array_ptr_1d_push(_jl_debug_compilation_timing, boxed);
+        JL_GC_POP();
+    }
+
     // If logging of the compilation stream is enabled,
     // then dump the method-instance specialization type to the stream
     jl_method_instance_t *mi = codeinst->def;
@@ -417,6 +551,181 @@ void jl_generate_fptr_for_unspecialized_impl(jl_code_instance_t *unspec)
     JL_UNLOCK(&jl_codegen_lock); // Might GC
 }
 
+// Tiered execution (JULIA_TIERED_COMPILE): run the optimizing compile for a
+// method instance whose cache already holds an interpreted baseline entry.
+// jl_generate_fptr would return that baseline through jl_method_compiled, so
+// this compiles into a fresh inferred code instance instead; inserting it at
+// the head of mi->cache publishes it, and later calls reach it through the
+// usual invoke indirection ahead of the baseline. The baseline's invoke
+// pointer is never touched (changing it races with readers of specptr).
+extern "C" JL_DLLEXPORT
+void jl_tiered_compile_upgrade_impl(jl_method_instance_t *mi, size_t world)
+{
+    JL_LOCK(&jl_codegen_lock); // also disables finalizers, to prevent any unexpected recursion
+    auto ctx = jl_ExecutionEngine->getContext();
+    auto &context = *ctx;
+    uint64_t compiler_start_time = 0;
+    uint8_t measure_compile_time_enabled = jl_atomic_load_relaxed(&jl_measure_compile_time_enabled);
+    if (measure_compile_time_enabled)
+        compiler_start_time = jl_hrtime();
+    jl_code_info_t *src = NULL;
+    JL_GC_PUSH1(&src);
+    jl_value_t *ci = jl_rettype_inferred(mi, world, world);
+    jl_code_instance_t *codeinst = (ci == jl_nothing ? NULL : (jl_code_instance_t*)ci);
+    if (codeinst) {
+        src = (jl_code_info_t*)codeinst->inferred;
+        if ((jl_value_t*)src == jl_nothing)
+            src = NULL;
+        else if (jl_is_method(mi->def.method))
+            src = jl_uncompress_ir(mi->def.method, codeinst, (jl_array_t*)src);
+    }
+    if (src == NULL && jl_is_method(mi->def.method) &&
+             jl_symbol_name(mi->def.method->name)[0] != '@') {
+        if (mi->def.method->source != jl_nothing)
+            src = jl_type_infer(mi, world, 0);
+    }
+    if (src && jl_is_code_info(src)) {
+        if (!codeinst) {
+            codeinst = jl_get_method_inferred(mi, src->rettype, src->min_world, src->max_world);
+            if (src->inferred && !codeinst->inferred)
+                codeinst->inferred = jl_nothing;
+        }
+        if (jl_atomic_load_relaxed(&codeinst->invoke) == NULL)
+            _jl_compile_codeinst(codeinst, src, world, context);
+    }
+    if (jl_codegen_lock.count == 1 && measure_compile_time_enabled)
+        jl_atomic_fetch_add_relaxed(&jl_cumulative_compile_time, (jl_hrtime() - compiler_start_time));
+    JL_UNLOCK(&jl_codegen_lock);
+    JL_GC_POP();
+}
+
+extern "C" jl_method_instance_t *jl_gdblookuplinfo(void *p) JL_NOTSAFEPOINT;
+extern "C" JL_DLLEXPORT uint8_t *jl_profile_get_data(void);
+extern "C" JL_DLLEXPORT size_t jl_profile_len_data(void);
+
+// Recompile one method instance at the highest optimization level, into a
+// fresh code instance published at the head of mi->cache like the tiered
+// upgrade above. Unlike that path this runs for methods that already have
+// compiled code: the new entry shadows the old one for every dispatch that
+// goes through the invoke indirection, while the old invoke/specptr pair is
+// left untouched (mutating it races with concurrent readers).
+static int jl_recompile_hot_method(jl_method_instance_t *mi, size_t world)
+{
+    if (!jl_is_method(mi->def.method) || mi->def.method->source == jl_nothing ||
+        jl_symbol_name(mi->def.method->name)[0] == '@')
+        return 0;
+    int success = 0;
+    JL_LOCK(&jl_codegen_lock); // also disables finalizers, to prevent any unexpected recursion
+    auto ctx = jl_ExecutionEngine->getContext();
+    auto &context = *ctx;
+    jl_code_info_t *src = NULL;
+    jl_code_instance_t *codeinst = NULL;
+    JL_GC_PUSH2(&src, &codeinst);
+    jl_value_t *ci = jl_rettype_inferred(mi, world, world);
+    jl_code_instance_t *inferred = (ci == jl_nothing ? NULL : (jl_code_instance_t*)ci);
+    if (inferred) {
+        src = (jl_code_info_t*)inferred->inferred;
+        if ((jl_value_t*)src == jl_nothing)
+            src = NULL;
+        else
+            src = jl_uncompress_ir(mi->def.method, inferred, (jl_array_t*)src);
+    }
+    if (src == NULL)
+        src = jl_type_infer(mi, world, 0);
+    if (src && jl_is_code_info(src)) {
+        codeinst = jl_new_codeinst(mi, src->rettype, NULL, jl_nothing,
+                                   0, src->min_world, src->max_world, 0, 0, jl_nothing, 0);
+        _jl_compile_codeinst(codeinst, src, world, context, /*force_optlevel*/3);
+        if (jl_atomic_load_relaxed(&codeinst->invoke) != NULL) {
+            jl_mi_cache_insert(mi, codeinst);
+            success = 1;
+        }
+    }
+    JL_GC_POP();
+    JL_UNLOCK(&jl_codegen_lock);
+    return success;
+}
+
+// Profile-guided recompilation: aggregate the sampling profiler's buffer per
+// method instance and recompile every method whose JIT frames were sampled at
+// least `threshold` times with the -O3 pipeline (and the larger inlining
+// budget that comes with it). Sample blocks use the layout produced by the
+// samplers in signals-*.c: backtrace entries, then the per-sample metadata
+// words, then a double zero terminator. Only native entries that
+// jl_gdblookuplinfo resolves are counted, so sysimage and C frames are
+// naturally excluded. Must be called from a Julia thread, typically after
+// stopping the profiler; long-running services can invoke it periodically to
+// converge their hot paths to peak optimization.
+extern "C" JL_DLLEXPORT
+size_t jl_profile_recompile_hot_impl(int64_t threshold)
+{
+    if (threshold <= 0)
+        threshold = 250; // ~0.25s of samples at the default 1ms delay
+    jl_bt_element_t *data = (jl_bt_element_t*)jl_profile_get_data();
+    size_t len = jl_profile_len_data();
+    if (data == NULL || len == 0)
+        return 0;
+    DenseMap<jl_method_instance_t*, uint64_t> counts;
+    size_t i = 0;
+    while (i < len) {
+        // find the end of this sample block (same double-zero scan the
+        // Profile stdlib performs)
+        size_t j = i;
+        while (j + 1 < len && !(data[j].uintptr == 0 && data[j + 1].uintptr == 0))
+            j++;
+        if (j + 1 >= len)
+            break;
+        size_t nmeta = 4; // tid, task, cycleclock, sleep state
+        size_t bt_end = j >= i + nmeta ? j - nmeta : i;
+        for (size_t k = i; k < bt_end; k += jl_bt_entry_size(&data[k])) {
+            if (jl_bt_is_native(&data[k])) {
+                jl_method_instance_t *mi = jl_gdblookuplinfo((void*)data[k].uintptr);
+                if (mi != NULL)
+                    counts[mi] += 1;
+            }
+        }
+        i = j + 2;
+    }
+    size_t world = jl_atomic_load_acquire(&jl_world_counter);
+    size_t nrecompiled = 0;
+    for (auto &kv : counts) {
+        if (kv.second >= (uint64_t)threshold)
+            nrecompiled += jl_recompile_hot_method(kv.first, world);
+    }
+    return nrecompiled;
+}
+
+// Freeze pass for warmed-up services: code emitted before its invoke targets
+// were compiled calls them through the generic `jl_invoke` entry, and keeps
+// doing so even once the targets have native code. Recompiling such a caller
+// lets emit_invoke see the now-compiled targets and emit direct calls,
+// removing the per-call invoke-pointer load and the dispatch re-entry.
+// Patching the existing machine code in place is not an option here -- no
+// relocation info is kept for the emitted call sites and other threads may be
+// executing them -- so the "patch" is a fresh code instance published at the
+// head of mi->cache, exactly like the profile-guided recompile above. That
+// also makes un-freezing free: method redefinition caps the new instance's
+// max_world and dispatch stops selecting it, with no explicit unpatching.
+// Callers whose targets are still uncompiled get re-recorded during their
+// recompile, so calling this periodically converges. Returns the number of
+// method instances recompiled.
+extern "C" JL_DLLEXPORT
+size_t jl_jit_freeze_invokes_impl(void)
+{
+    JL_LOCK(&jl_codegen_lock);
+    SmallVector<jl_method_instance_t*, 0> callers;
+    std::swap(callers, unresolved_invoke_callers);
+    JL_UNLOCK(&jl_codegen_lock);
+    size_t world = jl_atomic_load_acquire(&jl_world_counter);
+    SmallPtrSet<jl_method_instance_t*, 32> seen;
+    size_t nrecompiled = 0;
+    for (jl_method_instance_t *mi : callers) {
+        if (seen.insert(mi).second)
+            nrecompiled += jl_recompile_hot_method(mi, world);
+    }
+    return nrecompiled;
+}
+
 
 // get a native disassembly for a compiled method
 extern "C" JL_DLLEXPORT
@@ -516,6 +825,11 @@ void JuliaOJIT::OptSelLayerT::emit(std::unique_ptr<orc::MaterializationResponsib
                     }
                 }
             }
+            // A module flag overrides both the global level and the
+            // per-function levels; profile-guided recompilation uses it to
+            // force already-compiled methods through the -O3 pipeline.
+            if (auto *OL = mdconst::extract_or_null<ConstantInt>(M.getModuleFlag("julia.optlevel")))
+                optlevel = (size_t)OL->getZExtValue();
             optlevel = std::min(std::max(optlevel, optlevel_min), this->count);
         }
     });
@@ -999,16 +1313,73 @@ namespace {
         JuliaOJIT::ResourcePool<std::unique_ptr<PassManager>> PMs;
     };
 
+    // Persistent on-disk cache of JIT-compiled objects, enabled by pointing
+    // JULIA_JIT_OBJECT_CACHE at a directory. Objects are content-addressed by
+    // a hash of the module bitcode plus the target triple/CPU/features and
+    // opt level, so a restarted process reuses the object instead of
+    // re-running the MC pipeline and relocation happens as usual at load.
+    // Modules that embed process-specific runtime pointers hash differently
+    // in the next process and simply miss, which keeps the cache safe without
+    // having to prove a module is position-independent.
+    static StringRef jit_object_cache_dir()
+    {
+        static std::string dir = []() {
+            const char *env = getenv("JULIA_JIT_OBJECT_CACHE");
+            std::string d = env ? env : "";
+            if (!d.empty())
+                sys::fs::create_directories(d);
+            return d;
+        }();
+        return dir;
+    }
+
     struct CompilerT : orc::IRCompileLayer::IRCompiler {
 
         CompilerT(orc::IRSymbolMapper::ManglingOptions MO, TargetMachine &TM, int optlevel)
-        : orc::IRCompileLayer::IRCompiler(MO), TMs(TMCreator(TM, optlevel)) {}
+        : orc::IRCompileLayer::IRCompiler(MO), TMs(TMCreator(TM, optlevel)), optlevel(optlevel) {}
 
         Expected<std::unique_ptr<MemoryBuffer>> operator()(Module &M) override {
-            return orc::SimpleCompiler(***TMs)(M);
+            auto TM = TMs.get();
+            StringRef cachedir = jit_object_cache_dir();
+            if (cachedir.empty())
+                return orc::SimpleCompiler(**TM)(M);
+            SmallVector<char, 0> BC;
+            {
+                raw_svector_ostream OS(BC);
+                WriteBitcodeToFile(M, OS);
+            }
+            SHA1 hash;
+            hash.update(StringRef(BC.data(), BC.size()));
+            hash.update((*TM)->getTargetTriple().str());
+            hash.update((*TM)->getTargetCPU());
+            hash.update((*TM)->getTargetFeatureString());
+            uint8_t lvl = (uint8_t)optlevel;
+            hash.update(ArrayRef<uint8_t>(&lvl, 1));
+            SmallString<256> path(cachedir);
+            sys::path::append(path, toHex(hash.final()) + ".o");
+            auto cached = MemoryBuffer::getFile(path);
+            if (cached)
+                return std::move(*cached);
+            auto Obj = orc::SimpleCompiler(**TM)(M);
+            if (Obj) {
+                // write to a temporary and rename so concurrent processes
+                // sharing the cache never observe a partial object
+                SmallString<256> tmp;
+                int fd;
+                if (!sys::fs::createUniqueFile(path + ".tmp%%%%%%", fd, tmp)) {
+                    {
+                        raw_fd_ostream OS(fd, /*shouldClose*/ true);
+                        OS << (*Obj)->getBuffer();
+                    }
+                    if (sys::fs::rename(tmp, path))
+                        sys::fs::remove(tmp);
+                }
+            }
+            return Obj;
         }
 
         JuliaOJIT::ResourcePool<std::unique_ptr<TargetMachine>> TMs;
+        int optlevel;
     };
 }
 
@@ -1040,6 +1411,22 @@ JuliaOJIT::JuliaOJIT()
         ctx->enableOpaquePointers();
 #endif
         return orc::ThreadSafeContext(std::move(ctx));
+    },
+    [this](orc::ThreadSafeContext &ctx) {
+        // An LLVMContext interns every type and constant of every module
+        // emitted in it and never releases them, so a context recycled
+        // indefinitely grows toward the union of all past compilations'
+        // working sets. Retire it after a bounded number of emissions to
+        // return that memory wholesale; the pool creates a fresh context
+        // on the next demand.
+        size_t cap = jl_jit_context_reuse_cap();
+        if (cap == 0)
+            return false;
+        size_t &uses = ContextUses[ctx.getContext()];
+        if (++uses < cap)
+            return false;
+        ContextUses.erase(ctx.getContext());
+        return true;
     }),
 #ifdef JL_USE_JITLINK
     // TODO: Port our memory management optimisations to JITLink instead of using the
@@ -1067,6 +1454,26 @@ JuliaOJIT::JuliaOJIT()
     },
     OptSelLayer(Pipelines)
 {
+#if JL_LLVM_VERSION >= 130000
+    // Optionally dispatch materialization (optimization + MC emission) to a
+    // pool of background compile threads, so that concurrent lookups of
+    // independent code compile in parallel instead of serially on the
+    // requesting threads. This is safe because modules are emitted from
+    // ThreadSafeContexts and the pass managers and target machines are
+    // pooled per optimization level; callers still block only on the
+    // symbols they actually looked up.
+    if (char *jit_threads = getenv("JULIA_NUM_JIT_THREADS")) {
+        int njitthreads = atoi(jit_threads);
+        if (njitthreads > 0) {
+            CompileThreads = std::make_unique<ThreadPool>(hardware_concurrency(njitthreads));
+            ES.setDispatchTask([this](std::unique_ptr<orc::Task> T) {
+                // ThreadPool::async requires a copyable callable
+                auto SharedT = std::shared_ptr<orc::Task>(std::move(T));
+                CompileThreads->async([SharedT]() { SharedT->run(); });
+            });
+        }
+    }
+#endif
 #ifdef JL_USE_JITLINK
 # if defined(LLVM_SHLIB)
     // When dynamically linking against LLVM, use our custom EH frame registration code
@@ -1309,6 +1716,25 @@ size_t JuliaOJIT::getTotalBytes() const
     // TODO: Implement in future custom JITLink memory manager.
     return 0;
 }
+
+void JuliaOJIT::getCodeRegionStats(size_t *region_bytes, size_t *region_count,
+                                   size_t *hugepage_bytes) const
+{
+    // TODO: Implement in future custom JITLink memory manager.
+    *region_bytes = *region_count = *hugepage_bytes = 0;
+}
+
+size_t JuliaOJIT::releaseCodeRange(void *rt_addr, size_t size) const
+{
+    // TODO: Implement in future custom JITLink memory manager.
+    return 0;
+}
+
+size_t JuliaOJIT::drainRecentCodeAllocs(void **addrs, size_t *sizes, size_t max) const
+{
+    // TODO: Implement in future custom JITLink memory manager.
+    return 0;
+}
 #else
 size_t getRTDyldMemoryManagerTotalBytes(RTDyldMemoryManager *mm);
 
@@ -1316,6 +1742,35 @@ size_t JuliaOJIT::getTotalBytes() const
 {
     return getRTDyldMemoryManagerTotalBytes(MemMgr.get());
 }
+
+void getRTDyldMemoryManagerCodeRegionStats(RTDyldMemoryManager *mm,
+                                           size_t *region_bytes,
+                                           size_t *region_count,
+                                           size_t *hugepage_bytes);
+
+void JuliaOJIT::getCodeRegionStats(size_t *region_bytes, size_t *region_count,
+                                   size_t *hugepage_bytes) const
+{
+    getRTDyldMemoryManagerCodeRegionStats(MemMgr.get(), region_bytes,
+                                          region_count, hugepage_bytes);
+}
+
+size_t getRTDyldMemoryManagerReleaseCodeRange(RTDyldMemoryManager *mm,
+                                              void *rt_addr, size_t size);
+
+size_t JuliaOJIT::releaseCodeRange(void *rt_addr, size_t size) const
+{
+    return getRTDyldMemoryManagerReleaseCodeRange(MemMgr.get(), rt_addr, size);
+}
+
+size_t getRTDyldMemoryManagerDrainCodeAllocs(RTDyldMemoryManager *mm,
+                                             void **addrs, size_t *sizes,
+                                             size_t max);
+
+size_t JuliaOJIT::drainRecentCodeAllocs(void **addrs, size_t *sizes, size_t max) const
+{
+    return getRTDyldMemoryManagerDrainCodeAllocs(MemMgr.get(), addrs, sizes, max);
+}
 #endif
 
 JuliaOJIT *jl_ExecutionEngine;
@@ -1604,3 +2059,67 @@ size_t jl_jit_total_bytes_impl(void)
 {
     return jl_ExecutionEngine->getTotalBytes();
 }
+
+// Mapped-region accounting for JIT code: total bytes of code regions, the
+// number of regions, and how many of those bytes were set up for (transparent)
+// hugepage backing.
+extern "C" JL_DLLEXPORT
+void jl_jit_code_region_stats_impl(size_t *region_bytes, size_t *region_count,
+                                   size_t *hugepage_bytes)
+{
+    jl_ExecutionEngine->getCodeRegionStats(region_bytes, region_count,
+                                           hugepage_bytes);
+}
+
+// Return executable memory of emission batches whose code instances have all
+// been invalidated, until at most target_bytes of recorded code remains live.
+// Invalidation is the safety argument: native callers reach an instance only
+// through specptr calls compiled into their own code, and method invalidation
+// cascades through backedges to every such caller, so once every instance in a
+// batch has max_world < jl_world_counter no future call can enter its code.
+// Frames already executing old-world code are the residual risk; a batch is
+// therefore only evicted on the second pass that finds it fully invalidated,
+// giving in-flight calls one eviction cycle to drain. Each evicted instance's
+// invoke and specptr pointers are cleared so a stale dispatch recompiles
+// through jl_compile_method_internal instead of jumping into released pages.
+// Returns the number of bytes released.
+extern "C" JL_DLLEXPORT
+size_t jl_jit_evict_cold_impl(size_t target_bytes)
+{
+    JL_LOCK(&jl_codegen_lock);
+    size_t world = jl_atomic_load_acquire(&jl_world_counter);
+    size_t released = 0;
+    for (JITCodeRegion &region : jit_code_regions) {
+        if (jit_code_live_bytes - jit_code_released_bytes <= target_bytes)
+            break;
+        if (region.released)
+            continue;
+        bool all_invalid = true;
+        for (jl_code_instance_t *ci : region.insts) {
+            if (ci->max_world >= world) {
+                all_invalid = false;
+                break;
+            }
+        }
+        if (!all_invalid) {
+            region.cold_passes = 0;
+            continue;
+        }
+        if (region.cold_passes == 0) {
+            region.cold_passes = 1;
+            continue;
+        }
+        for (jl_code_instance_t *ci : region.insts) {
+            jl_atomic_store_release(&ci->invoke, (jl_callptr_t)NULL);
+            jl_atomic_store_release(&ci->specptr.fptr, (void*)NULL);
+        }
+        for (auto &range : region.ranges)
+            jl_ExecutionEngine->releaseCodeRange(range.first, range.second);
+        region.released = true;
+        region.insts.clear();
+        jit_code_released_bytes += region.bytes;
+        released += region.bytes;
+    }
+    JL_UNLOCK(&jl_codegen_lock);
+    return released;
+}
@@ -18,6 +18,7 @@
 #include <llvm/Passes/StandardInstrumentations.h>
 
 #include <llvm/Target/TargetMachine.h>
+#include <llvm/Support/ThreadPool.h>
 #include "julia_assert.h"
 #include "debug-registry.h"
 #include "platform.h"
@@ -276,7 +277,13 @@ public:
     >
     struct ResourcePool {
         public:
-        ResourcePool(std::function<ResourceT()> creator) : creator(std::move(creator)), mutex(std::make_unique<WNMutex>()) {}
+        // `retire` (optional) is consulted on release under the pool lock;
+        // returning true destroys the resource instead of requeueing it, and
+        // a later acquire creates a fresh one. Only meaningful for unbounded
+        // pools (max == 0): a bounded pool could strand waiters.
+        ResourcePool(std::function<ResourceT()> creator,
+                     std::function<bool(ResourceT&)> retire = nullptr)
+            : creator(std::move(creator)), retire(std::move(retire)), mutex(std::make_unique<WNMutex>()) {}
         class OwningResource {
             public:
             OwningResource(ResourcePool &pool, ResourceT resource) : pool(pool), resource(std::move(resource)) {}
@@ -344,6 +351,12 @@ public:
         }
         void release(ResourceT &&resource) {
             std::lock_guard<std::mutex> lock(mutex->mutex);
+            if (retire && retire(resource)) {
+                assert(max == 0 && "retiring from a bounded pool could strand waiters");
+                ResourceT dead(std::move(resource));
+                created--;
+                return;
+            }
             pool.push(std::move(resource));
             mutex->empty.notify_one();
         }
@@ -361,6 +374,7 @@ public:
             return top;
         }
         std::function<ResourceT()> creator;
+        std::function<bool(ResourceT&)> retire;
         size_t created = 0;
         BackingT pool;
         struct WNMutex {
@@ -439,6 +453,14 @@ public:
     TargetIRAnalysis getTargetIRAnalysis() const;
 
     size_t getTotalBytes() const;
+    void getCodeRegionStats(size_t *region_bytes, size_t *region_count,
+                            size_t *hugepage_bytes) const;
+    // Return the backing pages of an unreachable code range to the OS
+    // (whole pages only); returns the bytes released. See jl_jit_evict_cold.
+    size_t releaseCodeRange(void *rt_addr, size_t size) const;
+    // Collect the code allocations (runtime address/size pairs) made since
+    // the last call, for per-emission code-size accounting.
+    size_t drainRecentCodeAllocs(void **addrs, size_t *sizes, size_t max) const;
 
     JITDebugInfoRegistry &getDebugInfoRegistry() JL_NOTSAFEPOINT {
         return DebugRegistry;
@@ -467,6 +489,10 @@ private:
 
     JITDebugInfoRegistry DebugRegistry;
 
+    // per-context compilation counts for the retirement policy below;
+    // guarded by the ContextPool lock (the retire callback runs under it)
+    DenseMap<LLVMContext*, size_t> ContextUses;
+
     //Map and inc are guarded by RLST_mutex
     std::mutex RLST_mutex{};
     int RLST_inc = 0;
@@ -485,6 +511,10 @@ private:
     ObjLayerT ObjectLayer;
     const std::array<std::unique_ptr<PipelineT>, 4> Pipelines;
     OptSelLayerT OptSelLayer;
+    // Optional pool of background compile threads (JULIA_NUM_JIT_THREADS).
+    // Declared last so that in-flight materialization tasks are drained
+    // before the layers and the ExecutionSession are torn down.
+    std::unique_ptr<ThreadPool> CompileThreads;
 };
 extern JuliaOJIT *jl_ExecutionEngine;
 orc::ThreadSafeModule jl_create_llvm_module(StringRef name, orc::ThreadSafeContext ctx, bool imaging_mode, const DataLayout &DL = jl_ExecutionEngine->getDataLayout(), const Triple &triple = jl_ExecutionEngine->getTargetTriple());
@@ -503,6 +533,7 @@ orc::ThreadSafeModule &jl_codegen_params_t::shared_module(Module &from) {
 
 Pass *createLowerPTLSPass(bool imaging_mode);
 Pass *createCombineMulAddPass();
+Pass *createBoundsCheckElimPass();
 Pass *createFinalLowerGCPass();
 Pass *createLateLowerGCFramePass();
 Pass *createLowerExcHandlersPass();
@@ -46,10 +46,75 @@ void jl_wake_libuv(void)
 
 jl_mutex_t jl_uv_mutex;
 
+// Event-loop sharding: optionally create `$JULIA_UV_SHARDS` extra uv loops so
+// that I/O-heavy workloads are not serialized on `jl_uv_mutex`. Handles are
+// bound to a shard at creation time (`jl_uv_shard_loop`) and every subsequent
+// operation on them must hold that shard's lock (`jl_uv_shard_lock`),
+// mirroring the iolock protocol of the global loop. Each shard is pumped
+// independently via `jl_process_events(shard)` -- typically by one task
+// dedicated to it -- so the global lock never appears on a shard's
+// steady-state I/O path. Handles on different shards must not be mixed in a
+// single uv request.
+
+typedef struct {
+    uv_loop_t loop;
+    jl_mutex_t lock;
+    uv_async_t wakeup;
+    _Atomic(int) n_waiters;
+} jl_uv_shard_t;
+
+static jl_uv_shard_t *uv_shards = NULL;
+static int uv_n_shards = 0;
+
+static void jl_uv_shard_wakeup_cb(uv_async_t *hdl)
+{
+    uv_stop(hdl->loop);
+}
+
+static void jl_init_uv_shards(void)
+{
+    char *cp = getenv(UV_LOOP_SHARDS_NAME);
+    if (cp == NULL)
+        return;
+    long n = strtol(cp, NULL, 10);
+    if (n <= 0)
+        return;
+    if (n > 256) // each shard wants a task to pump it, so keep this sane
+        n = 256;
+    uv_shards = (jl_uv_shard_t*)malloc_s(n * sizeof(jl_uv_shard_t));
+    memset(uv_shards, 0, n * sizeof(jl_uv_shard_t));
+    for (long i = 0; i < n; i++) {
+        jl_uv_shard_t *shard = &uv_shards[i];
+        if (uv_loop_init(&shard->loop)) {
+            n = i; // ran out of fds? expose only the loops we could create
+            break;
+        }
+        JL_MUTEX_INIT(&shard->lock);
+        uv_async_init(&shard->loop, &shard->wakeup, jl_uv_shard_wakeup_cb);
+        jl_atomic_store_relaxed(&shard->n_waiters, 0);
+    }
+    uv_n_shards = (int)n;
+}
+
+JL_DLLEXPORT int jl_uv_n_event_shards(void)
+{
+    return uv_n_shards;
+}
+
+// loop to bind a handle to shard `shard`; out-of-range indices (notably -1)
+// give the global event loop, so callers can treat "no shard" uniformly
+JL_DLLEXPORT uv_loop_t *jl_uv_shard_loop(int shard)
+{
+    if (shard < 0 || shard >= uv_n_shards)
+        return jl_io_loop;
+    return &uv_shards[shard].loop;
+}
+
 void jl_init_uv(void)
 {
     uv_async_init(jl_io_loop, &signal_async, jl_signal_async_cb);
     JL_MUTEX_INIT(&jl_uv_mutex); // a file-scope initializer can be used instead
+    jl_init_uv_shards();
 }
 
 _Atomic(int) jl_uv_n_waiters = 0;
@@ -77,6 +142,33 @@ JL_DLLEXPORT void jl_iolock_end(void)
     JL_UV_UNLOCK();
 }
 
+JL_DLLEXPORT void jl_uv_shard_lock(int shard)
+{
+    if (shard < 0 || shard >= uv_n_shards) {
+        JL_UV_LOCK();
+        return;
+    }
+    jl_uv_shard_t *s = &uv_shards[shard];
+    if (jl_mutex_trylock(&s->lock)) {
+    }
+    else {
+        jl_atomic_fetch_add_relaxed(&s->n_waiters, 1);
+        jl_fence(); // [^store_buffering_2]
+        uv_async_send(&s->wakeup);
+        JL_LOCK(&s->lock);
+        jl_atomic_fetch_add_relaxed(&s->n_waiters, -1);
+    }
+}
+
+JL_DLLEXPORT void jl_uv_shard_unlock(int shard)
+{
+    if (shard < 0 || shard >= uv_n_shards) {
+        JL_UV_UNLOCK();
+        return;
+    }
+    JL_UNLOCK(&uv_shards[shard].lock);
+}
+
 
 static void jl_uv_call_close_callback(jl_value_t *val)
 {
@@ -204,18 +296,38 @@ JL_DLLEXPORT void *jl_uv_write_handle(uv_write_t *req) { return req->handle; }
 
 extern _Atomic(unsigned) _threadedregion;
 
-JL_DLLEXPORT int jl_process_events(void)
+JL_DLLEXPORT int jl_process_events(int shard)
 {
     jl_task_t *ct = jl_current_task;
+    if (shard >= 0 && shard < uv_n_shards) {
+        // any thread may pump a shard; contention is only with other users
+        // of the same shard, never with the global loop
+        jl_uv_shard_t *s = &uv_shards[shard];
+        jl_gc_safepoint_(ct->ptls);
+        if (jl_atomic_load_relaxed(&s->n_waiters) == 0 && jl_mutex_trylock(&s->lock)) {
+            JL_PROBE_RT_START_PROCESS_EVENTS(ct);
+            s->loop.stop_flag = 0;
+            jl_wake_batch_begin();
+            int r = uv_run(&s->loop, UV_RUN_NOWAIT);
+            JL_PROBE_RT_FINISH_PROCESS_EVENTS(ct);
+            JL_UNLOCK(&s->lock);
+            jl_wake_batch_end(); // one wake decision per target for this iteration
+            return r;
+        }
+        jl_gc_safepoint_(ct->ptls);
+        return 0;
+    }
     uv_loop_t *loop = jl_io_loop;
     jl_gc_safepoint_(ct->ptls);
     if (loop && (jl_atomic_load_relaxed(&_threadedregion) || jl_atomic_load_relaxed(&ct->tid) == 0)) {
         if (jl_atomic_load_relaxed(&jl_uv_n_waiters) == 0 && jl_mutex_trylock(&jl_uv_mutex)) {
             JL_PROBE_RT_START_PROCESS_EVENTS(ct);
             loop->stop_flag = 0;
+            jl_wake_batch_begin();
             int r = uv_run(loop, UV_RUN_NOWAIT);
             JL_PROBE_RT_FINISH_PROCESS_EVENTS(ct);
             JL_UV_UNLOCK();
+            jl_wake_batch_end(); // one wake decision per target for this iteration
             return r;
         }
         jl_gc_safepoint_(ct->ptls);
@@ -491,6 +603,247 @@ static void jl_uv_writecb(uv_write_t *req, int status) JL_NOTSAFEPOINT
     }
 }
 
+// Roots for in-flight by-reference writes (see jl_uv_write_splice below).
+// Scanned by the GC root marking in gc.c; mutated only under JL_UV_LOCK,
+// so the mark phase (which runs with the world stopped) never races a
+// mutation.
+arraylist_t jl_uv_write_root_list;
+
+typedef struct {
+    uv_write_t req;
+    jl_value_t *root;
+} jl_uv_splice_req_t;
+
+static void jl_uv_splice_writecb(uv_write_t *req0, int status) JL_NOTSAFEPOINT
+{
+    // runs on the thread pumping the event loop, which holds JL_UV_LOCK
+    jl_uv_splice_req_t *req = (jl_uv_splice_req_t*)req0;
+    for (size_t i = 0; i < jl_uv_write_root_list.len; i++) {
+        if (jl_uv_write_root_list.items[i] == (void*)req->root) {
+            jl_uv_write_root_list.items[i] =
+                jl_uv_write_root_list.items[--jl_uv_write_root_list.len];
+            break;
+        }
+    }
+    free(req);
+    if (status < 0) {
+        jl_safe_printf("jl_uv_splice_writecb() ERROR: %s %s\n",
+                       uv_strerror(status), uv_err_name(status));
+    }
+}
+
+// Asynchronous by-reference write: hands the caller's memory straight to
+// libuv instead of copying it into a request (jl_uv_puts) or parking the
+// writing task until the write drains (Base's uv_write). `root` is a
+// GC-managed object that keeps `data` alive -- typically the Vector
+// backing an IOBuffer -- and stays rooted until the completion callback
+// runs. The caller must not mutate the region in the meantime; write
+// errors are sticky on the stream and surface on the next write.
+JL_DLLEXPORT int jl_uv_write_splice(uv_stream_t *stream, const char *data,
+                                    size_t n, jl_value_t *root)
+{
+    uv_buf_t buf[1];
+    buf[0].base = (char*)data;
+    buf[0].len = n;
+    JL_UV_LOCK();
+    JL_SIGATOMIC_BEGIN();
+    jl_uv_splice_req_t *req = (jl_uv_splice_req_t*)malloc_s(sizeof(jl_uv_splice_req_t));
+    req->req.data = NULL;
+    req->root = root;
+    arraylist_push(&jl_uv_write_root_list, (void*)root);
+    int err = uv_write(&req->req, stream, buf, 1, jl_uv_splice_writecb);
+    if (err < 0) {
+        // never submitted; the root we just pushed is still last
+        jl_uv_write_root_list.len--;
+        free(req);
+    }
+    JL_UV_UNLOCK();
+    JL_SIGATOMIC_END();
+    return err;
+}
+
+// --- hierarchical timer wheel ---
+//
+// Base `Timer`s used to be full uv_timer_t handles, each participating in
+// libuv's timer heap; with hundreds of thousands of concurrent timers
+// (connection timeouts), the per-timer heap operations and handle
+// allocations dominate. Instead the runtime keeps one uv timer (the
+// "driver") armed at the next interesting tick and stores Julia-level
+// timers as lightweight malloc'd entries in a hierarchical wheel:
+// TW_LEVELS wheels of TW_SLOTS slots, each level covering TW_SLOTS times
+// the span of the previous one at 1ms base resolution. Insert, delete and
+// per-tick expiry are O(1); entries too far out sit in a coarse level and
+// cascade toward level 0 as their due time approaches.
+//
+// All wheel state is guarded by JL_UV_LOCK; expiry callbacks run on the
+// thread pumping the event loop, exactly like uv_timer_cb, so the Base
+// wakeup path (notify on the timer's condition) carries over unchanged.
+
+#define TW_BITS 6
+#define TW_SLOTS (1 << TW_BITS)
+#define TW_MASK (TW_SLOTS - 1)
+#define TW_LEVELS 4
+
+struct _jl_wheel_timer_t {
+    uint64_t due;    // absolute ms on the loop clock
+    uint64_t repeat; // 0 = one-shot
+    jl_timer_wheel_cb cb;
+    void *data;
+    struct _jl_wheel_timer_t *next;
+    struct _jl_wheel_timer_t **prev; // link pointing at us, for O(1) unlink
+};
+
+static jl_wheel_timer_t *tw_slots[TW_LEVELS][TW_SLOTS];
+static uint64_t tw_now;   // last processed tick
+static size_t tw_count;   // pending entries
+static uv_timer_t tw_driver;
+static int tw_initialized = 0;
+
+static void tw_insert(jl_wheel_timer_t *t) JL_NOTSAFEPOINT
+{
+    uint64_t delta = t->due - tw_now;
+    int level = 0;
+    while (level < TW_LEVELS - 1 && (delta >> (TW_BITS * (level + 1))))
+        level++;
+    int slot = (t->due >> (TW_BITS * level)) & TW_MASK;
+    t->next = tw_slots[level][slot];
+    t->prev = &tw_slots[level][slot];
+    if (t->next)
+        t->next->prev = &t->next;
+    tw_slots[level][slot] = t;
+}
+
+static void tw_unlink(jl_wheel_timer_t *t) JL_NOTSAFEPOINT
+{
+    *t->prev = t->next;
+    if (t->next)
+        t->next->prev = t->prev;
+    t->next = NULL;
+    t->prev = NULL;
+}
+
+static void tw_advance(uint64_t now)
+{
+    while (tw_now < now) {
+        if (tw_count == 0) {
+            tw_now = now; // nothing can expire or cascade; skip the gap
+            break;
+        }
+        tw_now++;
+        int slot = (int)(tw_now & TW_MASK);
+        if (slot == 0) {
+            // a level wrapped: cascade the matching coarser slots down
+            for (int level = 1; level < TW_LEVELS; level++) {
+                int s = (int)((tw_now >> (TW_BITS * level)) & TW_MASK);
+                jl_wheel_timer_t *list = tw_slots[level][s];
+                tw_slots[level][s] = NULL;
+                while (list) {
+                    jl_wheel_timer_t *next = list->next;
+                    tw_insert(list);
+                    list = next;
+                }
+                if (s != 0)
+                    break;
+            }
+        }
+        // expire this tick's level-0 slot; entries are unlinked one at a
+        // time so a callback closing another pending timer stays safe
+        while (tw_slots[0][slot]) {
+            jl_wheel_timer_t *t = tw_slots[0][slot];
+            tw_unlink(t);
+            tw_count--;
+            int oneshot = (t->repeat == 0);
+            if (!oneshot) {
+                t->due = tw_now + t->repeat;
+                tw_insert(t);
+                tw_count++;
+            }
+            t->cb(t->data);
+            if (oneshot)
+                free(t); // jl_timer_wheel_stop only frees linked entries
+        }
+    }
+}
+
+// earliest tick at which something can expire or cascade (0 = none)
+static uint64_t tw_next_wake(void) JL_NOTSAFEPOINT
+{
+    for (int level = 0; level < TW_LEVELS; level++) {
+        uint64_t tick = tw_now >> (TW_BITS * level);
+        for (uint64_t d = 1; d <= TW_SLOTS; d++) {
+            if (tw_slots[level][(tick + d) & TW_MASK])
+                return (tick + d) << (TW_BITS * level);
+        }
+    }
+    return 0;
+}
+
+static void tw_driver_cb(uv_timer_t *h);
+
+static void tw_rearm(void)
+{
+    if (tw_count == 0) {
+        uv_timer_stop(&tw_driver);
+        return;
+    }
+    uint64_t wake = tw_next_wake();
+    uint64_t now = uv_now(jl_io_loop);
+    uv_timer_start(&tw_driver, tw_driver_cb, wake > now ? wake - now : 1, 0);
+}
+
+static void tw_driver_cb(uv_timer_t *h)
+{
+    tw_advance(uv_now(h->loop));
+    tw_rearm();
+}
+
+// Register a lightweight timer: fires `cb(data)` after `timeout_ms` and
+// then every `repeat_ms` (0 for one-shot). The returned entry is owned by
+// the wheel; pass it to jl_timer_wheel_stop to cancel. One-shot entries
+// are freed when their callback returns, so they must not be stopped
+// afterwards (Base clears its handle inside the callback).
+JL_DLLEXPORT jl_wheel_timer_t *jl_timer_wheel_start(uint64_t timeout_ms, uint64_t repeat_ms,
+                                                    jl_timer_wheel_cb cb, void *data)
+{
+    JL_UV_LOCK();
+    if (!tw_initialized) {
+        uv_timer_init(jl_io_loop, &tw_driver);
+        tw_now = uv_now(jl_io_loop);
+        tw_initialized = 1;
+    }
+    uv_update_time(jl_io_loop);
+    tw_advance(uv_now(jl_io_loop));
+    jl_wheel_timer_t *t = (jl_wheel_timer_t*)malloc_s(sizeof(jl_wheel_timer_t));
+    t->due = tw_now + (timeout_ms == 0 ? 1 : timeout_ms);
+    t->repeat = repeat_ms;
+    t->cb = cb;
+    t->data = data;
+    tw_insert(t);
+    tw_count++;
+    tw_rearm();
+    JL_UV_UNLOCK();
+    return t;
+}
+
+JL_DLLEXPORT void jl_timer_wheel_stop(jl_wheel_timer_t *t)
+{
+    JL_UV_LOCK();
+    if (t->prev) {
+        tw_unlink(t);
+        tw_count--;
+        free(t);
+        tw_rearm();
+    }
+    // else: a one-shot currently running its expiry callback; the driver
+    // frees it when the callback returns
+    JL_UV_UNLOCK();
+}
+
+JL_DLLEXPORT uint64_t jl_timer_wheel_get_repeat(jl_wheel_timer_t *t) JL_NOTSAFEPOINT
+{
+    return t->repeat;
+}
+
 JL_DLLEXPORT void jl_uv_puts(uv_stream_t *stream, const char *str, size_t n)
 {
     assert(stream);
@@ -535,15 +888,34 @@ JL_DLLEXPORT void jl_uv_puts(uv_stream_t *stream, const char *str, size_t n)
     }
     else {
         // Write to libuv stream...
+        uv_buf_t buf[1];
+        buf[0].base = (char*)str;
+        buf[0].len = n;
+        JL_UV_LOCK();
+        JL_SIGATOMIC_BEGIN();
+        // Try a synchronous write first: when the descriptor can accept the
+        // data immediately (the common case for pipes and consoles that are
+        // keeping up), this writes straight out of the caller's buffer and
+        // skips the request allocation, the copy, and the completion
+        // callback. uv_try_write refuses (UV_EAGAIN) whenever the stream
+        // already has queued write requests, so ordering is preserved.
+        int written = uv_try_write(stream, buf, 1);
+        if (written > 0) {
+            str += written;
+            n -= written;
+        }
+        if (n == 0) {
+            JL_UV_UNLOCK();
+            JL_SIGATOMIC_END();
+            return;
+        }
+        // Queue the remainder (or all of it, if the stream wasn't ready)
         uv_write_t *req = (uv_write_t*)malloc_s(sizeof(uv_write_t) + n);
         char *data = (char*)(req + 1);
         memcpy(data, str, n);
-        uv_buf_t buf[1];
         buf[0].base = data;
         buf[0].len = n;
         req->data = NULL;
-        JL_UV_LOCK();
-        JL_SIGATOMIC_BEGIN();
         int status = uv_write(req, stream, buf, 1, (uv_write_cb)jl_uv_writecb);
         JL_UV_UNLOCK();
         JL_SIGATOMIC_END();
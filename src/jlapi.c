@@ -604,7 +604,7 @@ static NOINLINE int true_main(int argc, char *argv[])
             jl_printf(JL_STDOUT, "\n");
             free(line);
             line = NULL;
-            jl_process_events();
+            jl_process_events(-1);
         }
         JL_CATCH {
             if (line) {
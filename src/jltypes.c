@@ -1396,6 +1396,15 @@ jl_value_t *normalize_unionalls(jl_value_t *t)
 
 static jl_value_t *_jl_instantiate_type_in_env(jl_value_t *ty, jl_unionall_t *env, jl_value_t **vals, jl_typeenv_t *prev, jl_typestack_t *stack);
 
+// Key-hash-striped construction locks for tuple types. Tuple instantiation is
+// self-contained -- the supertype is Any and the field types are the
+// parameters, so nothing below the lock re-enters the type cache -- which
+// lets distinct tuple types be constructed concurrently instead of
+// serializing every thread on typecache_lock. The global lock still guards
+// all cache mutation; see inst_datatype_inner for the lock ordering argument.
+#define TYPECACHE_NSTRIPES 16
+static jl_mutex_t typecache_stripes[TYPECACHE_NSTRIPES];
+
 static jl_value_t *inst_datatype_inner(jl_datatype_t *dt, jl_svec_t *p, jl_value_t **iparams, size_t ntp,
                                        jl_typestack_t *stack, jl_typeenv_t *env)
 {
@@ -1513,11 +1522,21 @@ static jl_value_t *inst_datatype_inner(jl_datatype_t *dt, jl_svec_t *p, jl_value
 
     // acquire the write lock now that we know we need a new object
     // since we're going to immediately leak it globally via the instantiation stack
+    jl_mutex_t *cachelock = &typecache_lock;
     if (cacheable) {
-        JL_LOCK(&typecache_lock); // Might GC
+        if (istuple && jl_atomic_load_relaxed(&typecache_lock.owner) != (jl_task_t*)jl_current_task) {
+            // construct tuples under a stripe chosen by the key hash so
+            // distinct tuple types don't serialize on the global lock. A task
+            // that already holds the global lock (a non-tuple instantiation
+            // reaching a tuple field type) stays on it, so the lock order is
+            // always global -> stripe and never the reverse.
+            unsigned hv = typekey_hash(tn, iparams, ntp, 1);
+            cachelock = &typecache_stripes[hv & (TYPECACHE_NSTRIPES - 1)];
+        }
+        JL_LOCK(cachelock); // Might GC
         jl_value_t *lkup = (jl_value_t*)lookup_type(tn, iparams, ntp);
         if (lkup != NULL) {
-            JL_UNLOCK(&typecache_lock); // Might GC
+            JL_UNLOCK(cachelock); // Might GC
             JL_GC_POP();
             return lkup;
         }
@@ -1615,8 +1634,26 @@ static jl_value_t *inst_datatype_inner(jl_datatype_t *dt, jl_svec_t *p, jl_value
     if (cacheable) {
         if (ndt->layout == NULL && ndt->types != NULL && ndt->isconcretetype)
             jl_compute_field_offsets(ndt);
-        jl_cache_type_(ndt);
-        JL_UNLOCK(&typecache_lock); // Might GC
+        if (cachelock != &typecache_lock) {
+            // cache mutation is serialized on the global lock even when the
+            // construction ran under a stripe; a global-lock holder may have
+            // built the same tuple concurrently, so recheck and prefer its
+            // copy to keep cached types unique
+            JL_LOCK(&typecache_lock); // Might GC
+            jl_value_t *lkup = (jl_value_t*)lookup_type(tn, iparams, ntp);
+            if (lkup != NULL) {
+                JL_UNLOCK(&typecache_lock); // Might GC
+                JL_UNLOCK(cachelock); // Might GC
+                JL_GC_POP();
+                return lkup;
+            }
+            jl_cache_type_(ndt);
+            JL_UNLOCK(&typecache_lock); // Might GC
+        }
+        else {
+            jl_cache_type_(ndt);
+        }
+        JL_UNLOCK(cachelock); // Might GC
     }
 
     JL_GC_POP();
@@ -262,33 +262,8 @@
                              str))))))
         (string->normsymbol str))))
 
-(define (accum-digits c pred port _-digit-sep)
-  (let loop ((str '())
-             (c c))
-    (if (and _-digit-sep (eqv? c #\_))
-        (begin (read-char port)
-               (let ((c (peek-char port)))
-                 (if (and (not (eof-object? c)) (pred c))
-                     (loop str c)
-                     (begin
-                       (io.skip port -1) ; unget _
-                       (list->string (reverse str))))))
-        (if (and (not (eof-object? c)) (pred c))
-            (begin (read-char port)
-                   (loop (cons c str) (peek-char port)))
-            (list->string (reverse str))))))
-
-(define (char-hex? c)
-  (or (char-numeric? c)
-      (and (>= c #\a) (<= c #\f))
-      (and (>= c #\A) (<= c #\F))))
-
-(define (char-oct? c)
-  (and (>= c #\0) (<= c #\7)))
-
-(define (char-bin? c)
-  (or (eqv? c #\0)
-      (eqv? c #\1)))
+;; accum-digits is a C builtin (see julia_extensions.c); it takes the radix
+;; as one of the symbols dec, hex, oct or bin instead of a predicate.
 
 (define (string-to-number s r is-float32)
   (let ((ans (if is-float32
@@ -309,7 +284,7 @@
 
 (define (read-number port leadingdot neg)
   (let ((str  (open-output-string))
-        (pred char-numeric?)
+        (pred 'dec)
         (is-float32-literal #f)
         (is-hex-float-literal #f)
         (leadingzero #f))
@@ -342,13 +317,13 @@
                    (set! leadingzero #t)
                    (cond ((allow #\x)
                           (begin (set! leadingzero #f)
-                                 (set! pred char-hex?)))
+                                 (set! pred 'hex)))
                          ((allow #\o)
                           (begin (set! leadingzero #f)
-                                 (set! pred char-oct?)))
+                                 (set! pred 'oct)))
                          ((allow #\b)
                           (begin (set! leadingzero #f)
-                                 (set! pred char-bin?)))))
+                                 (set! pred 'bin)))))
             (allow #\.)))
     (read-digs leadingzero #t)
     (if (eqv? (peek-char port) #\.)
@@ -364,13 +339,13 @@
                      (io.skip port -1)) ; unget .
                    (begin (write-char #\. str)
                           (read-digs #f #t)
-                          (if (eq? pred char-hex?)
+                          (if (eq? pred 'hex)
                               (set! is-hex-float-literal #t))
                           (disallow-dot)))))
     (let* ((c    (peek-char port))
            (ispP (or (eqv? c #\p) (eqv? c #\P))))
       (if (or (and is-hex-float-literal (or ispP (error "hex float literal must contain \"p\" or \"P\"")))
-              (and (eq? pred char-hex?) ispP)
+              (and (eq? pred 'hex) ispP)
               (memv c '(#\e #\E #\f)))
           (begin (read-char port)
                  (let* ((d (peek-char port))
@@ -388,8 +363,8 @@
                               (disallow-dot))
                        (io.skip port -1))))) ; unget c
       (if (and (char? c)
-               (or (eq? pred char-bin?) (eq? pred char-oct?)
-                   (and (eq? pred char-hex?) (not is-hex-float-literal)))
+               (or (eq? pred 'bin) (eq? pred 'oct)
+                   (and (eq? pred 'hex) (not is-hex-float-literal)))
                (or (char-numeric? c)
                    (identifier-start-char? c)))
           ;; disallow digits after binary or octal literals, e.g., 0b12
@@ -397,9 +372,9 @@
           (error (string "invalid numeric constant \""
                          (get-output-string str) c "\""))))
     (let* ((s (get-output-string str))
-           (r (cond ((eq? pred char-hex?) 16)
-                    ((eq? pred char-oct?) 8)
-                    ((eq? pred char-bin?) 2)
+           (r (cond ((eq? pred 'hex) 16)
+                    ((eq? pred 'oct) 8)
+                    ((eq? pred 'bin) 2)
                     (else 10)))
            (n (string-to-number
                ;; for an unsigned literal starting with -, remove the - and
@@ -416,9 +391,9 @@
           (error (string "numeric constant \"" s "\" cannot be implicitly multiplied because it ends with \".\"")))
       ;; n is #f for integers > typemax(UInt64)
       (cond (is-hex-float-literal (numchk n s) (double n))
-            ((eq? pred char-hex?) (fix-uint-neg neg (sized-uint-literal n s 4)))
-            ((eq? pred char-oct?) (fix-uint-neg neg (sized-uint-oct-literal n s)))
-            ((eq? pred char-bin?) (fix-uint-neg neg (sized-uint-literal n s 1)))
+            ((eq? pred 'hex) (fix-uint-neg neg (sized-uint-literal n s 4)))
+            ((eq? pred 'oct) (fix-uint-neg neg (sized-uint-oct-literal n s)))
+            ((eq? pred 'bin) (fix-uint-neg neg (sized-uint-literal n s 1)))
             (is-float32-literal   (numchk n s) (float n))
             (n (if (and (integer? n) (> n 9223372036854775807))
                    `(macrocall (core @int128_str) (null) ,s)
@@ -501,12 +476,7 @@
 
 (define (bidi-state-terminated? st) (equal? st '(0 . 0)))
 
-(define (skip-line-comment port)
-  (let ((c (peek-char port)))
-    (cond ((eof-object? c)    c)
-          ((eqv? c #\newline) c)
-          (else               (read-char port)
-                              (skip-line-comment port)))))
+;; skip-line-comment is a C builtin (see julia_extensions.c)
 
 (define (skip-multiline-comment port count bds)
   (let ((c (read-char port)))
@@ -2459,6 +2429,8 @@
 
       (else
        (write-char (not-eof-for delim c) b)
+       ;; bulk-copy any following run of plain characters natively
+       (string.copy-plain p b delim raw)
        (loop (read-char p) b e 0 (update-bidi-state bds c))))))
 
 (define (not-eof-1 c)
@@ -124,6 +124,31 @@ static inline void jl_set_typeof(void *v, void *t) JL_NOTSAFEPOINT
 }
 #define jl_typeis(v,t) (jl_typeof(v)==(jl_value_t*)(t))
 
+// Compressed heap references. When the process is started with
+// JULIA_GC_COMPRESSED_HEAP=1 the GC confines its pool pages to a single
+// contiguous reservation of at most 32GB (jl_gc_heap_base / jl_gc_heap_size,
+// both zero when the mode is off), so a pool-allocated object can be stored
+// as a 32-bit offset in units of the 8-byte allocation granule. This is a
+// storage encoding for pointer-dense side tables, not a change of the working
+// representation: jl_value_t* stays 8 bytes and jl_astaggedvalue/jl_typeof
+// are unchanged. Offset 0 is reserved so that a zero jl_cref_t means NULL;
+// only objects for which jl_gc_heap_contains holds may be encoded (big and
+// malloc'd objects live outside the reservation).
+typedef uint32_t jl_cref_t;
+#define JL_CREF_SHIFT 3
+extern JL_DLLEXPORT uintptr_t jl_gc_heap_base;
+extern JL_DLLEXPORT size_t jl_gc_heap_size;
+static inline int jl_gc_heap_contains(const void *p) JL_NOTSAFEPOINT
+{
+    return (uintptr_t)p - jl_gc_heap_base < jl_gc_heap_size;
+}
+#define jl_cref_encode(v)                                               \
+    ((v) == NULL ? (jl_cref_t)0 :                                       \
+     (jl_cref_t)(((uintptr_t)(v) - jl_gc_heap_base) >> JL_CREF_SHIFT))
+#define jl_cref_decode(r)                                               \
+    ((r) == 0 ? NULL :                                                  \
+     (jl_value_t*)(jl_gc_heap_base + ((uintptr_t)(r) << JL_CREF_SHIFT)))
+
 // Symbols are interned strings (hash-consed) stored as an invasive binary tree.
 // The string data is nul-terminated and hangs off the end of the struct.
 typedef struct _jl_sym_t {
@@ -159,7 +184,8 @@ typedef struct {
       3 = has a pointer to the object that owns the data
     */
     uint16_t how:2;
-    uint16_t ndims:9;
+    uint16_t ndims:8;
+    uint16_t hashint:1; // grown by an explicit sizehint that is still in effect
     uint16_t pooled:1;
     uint16_t ptrarray:1; // representation is pointer array
     uint16_t hasptr:1; // representation has embedded pointers
@@ -520,6 +546,8 @@ typedef struct {
     uint16_t alignment; // strictest alignment over all fields
     uint16_t haspadding : 1; // has internal undefined bytes
     uint16_t fielddesc_type : 2; // 0 -> 8, 1 -> 16, 2 -> 32, 3 -> foreign type
+    uint16_t ptrs_run : 1; // the pointers are the consecutive words first_ptr .. first_ptr+npointers-1,
+                           // so scans can skip the ptr index list below (see gc.c)
     // union {
     //     jl_fielddesc8_t field8[nfields];
     //     jl_fielddesc16_t field16[nfields];
@@ -570,10 +598,14 @@ typedef struct {
     _Atomic(jl_value_t*) globalref;  // cached GlobalRef for this binding
     struct _jl_module_t* owner;  // for individual imported bindings -- TODO: make _Atomic
     _Atomic(jl_value_t*) ty;  // binding type
+    // method instances whose generated code embeds the current value of this
+    // binding (see gf.c); malloc'd, NULL until the first speculation
+    arraylist_t *speculations;
     uint8_t constp:1;
     uint8_t exportp:1;
     uint8_t imported:1;
     uint8_t deprecated:2; // 0=not deprecated, 1=renamed, 2=moved to another package
+    uint8_t reassigned:1; // value was overwritten at least once; disables speculation
 } jl_binding_t;
 
 typedef struct {
@@ -581,12 +613,17 @@ typedef struct {
     uint64_t lo;
 } jl_uuid_t;
 
+struct _jl_bindingtable_t;
+
 typedef struct _jl_module_t {
     JL_DATA_TYPE
     jl_sym_t *name;
     struct _jl_module_t *parent;
     // hidden fields:
     htable_t bindings;
+    // read-optimized mirror of `bindings`, probed without the module lock
+    // (see module.c; NULL until the first binding is mirrored)
+    _Atomic(struct _jl_bindingtable_t*) fastbindings;
     arraylist_t usings;  // modules with all bindings potentially imported
     uint64_t build_id;
     jl_uuid_t uuid;
@@ -652,7 +689,7 @@ typedef struct _jl_methtable_t {
     jl_array_t *backedges;
     jl_mutex_t writelock;
     uint8_t offs;  // 0, or 1 to skip splitting typemap on first (function) argument
-    uint8_t frozen; // whether this accepts adding new methods
+    uint8_t frozen; // rejects method addition/deletion: 1 for builtin tables, 2 after jl_module_freeze
 } jl_methtable_t;
 
 typedef struct {
@@ -892,10 +929,59 @@ typedef enum {
 } jl_gc_collection_t;
 
 JL_DLLEXPORT void jl_gc_collect(jl_gc_collection_t);
+JL_DLLEXPORT void jl_gc_set_max_pause(uint64_t max_pause_ms);
+JL_DLLEXPORT uint64_t jl_gc_get_max_pause(void);
+JL_DLLEXPORT void jl_gc_set_softlimit(uint64_t bytes);
+JL_DLLEXPORT void jl_gc_notify_memory_pressure(int pressure);
+
+typedef enum {
+    JL_GC_PHASE_PAUSE = 0,      // whole stop-the-world pause
+    JL_GC_PHASE_MARK = 1,
+    JL_GC_PHASE_SWEEP = 2,
+    JL_GC_PHASE_FINALIZERS = 3, // post-collection finalizer runs
+    JL_GC_N_PHASES = 4,
+} jl_gc_phase_t;
+
+// Copy up to `nbuckets` of the pause histogram for `phase` into `counts`
+// (and the inclusive lower bound of each bucket, in nanoseconds, into
+// `lower_bounds_ns`); either output may be NULL. Returns the total number
+// of buckets the collector maintains, or 0 for an unknown phase.
+JL_DLLEXPORT int jl_gc_pause_histogram(jl_gc_phase_t phase, uint64_t *counts,
+                                       uint64_t *lower_bounds_ns, int nbuckets) JL_NOTSAFEPOINT;
+JL_DLLEXPORT void jl_gc_pause_histogram_reset(void) JL_NOTSAFEPOINT;
+
+// A seqlock-protected snapshot of heap state, updated by the collector at
+// pause boundaries. Sampling is just plain loads: read `seq`, copy the
+// fields, re-read `seq` and retry if it was odd or changed — safe from a
+// signal handler, and from another process when JULIA_GC_TELEMETRY names a
+// file to back the page with (map it read-only and cast).
+typedef struct {
+    uint64_t seq;               // odd while the collector is writing
+    uint64_t timestamp;         // monotonic ns of the last update
+    uint64_t pause_in_progress; // nonzero between pause start and end
+    uint64_t collections;
+    uint64_t full_sweeps;
+    int64_t  live_bytes;
+    int64_t  allocd;            // bytes allocated since the last sweep
+    uint64_t total_allocd;
+    uint64_t freed;             // freed by the last collection
+    uint64_t total_time;        // ns spent collecting, cumulative
+    uint64_t last_pause;        // ns, most recent pause
+    uint64_t max_pause;         // ns
+    uint64_t pool_pages;        // committed pool pages (GC_PAGE_SZ each)
+} jl_gc_telemetry_t;
+JL_DLLEXPORT const jl_gc_telemetry_t *jl_gc_telemetry_page(void) JL_NOTSAFEPOINT;
 
 JL_DLLEXPORT void jl_gc_add_finalizer(jl_value_t *v, jl_function_t *f) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void jl_gc_add_ptr_finalizer(jl_ptls_t ptls, jl_value_t *v, void *f) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void jl_finalize(jl_value_t *o);
+JL_DLLEXPORT void jl_gc_flush_finalizers(void);
+// Pin an object: it stays alive and address-stable until the matching
+// unpin, so its memory may be handed to asynchronous foreign consumers.
+// Pins nest; resizing a pinned array is an error.
+JL_DLLEXPORT void jl_gc_pin_object(jl_value_t *v);
+JL_DLLEXPORT void jl_gc_unpin_object(jl_value_t *v);
+JL_DLLEXPORT int jl_gc_is_pinned(jl_value_t *v);
 JL_DLLEXPORT jl_weakref_t *jl_gc_new_weakref(jl_value_t *value);
 JL_DLLEXPORT jl_value_t *jl_gc_alloc_0w(void);
 JL_DLLEXPORT jl_value_t *jl_gc_alloc_1w(void);
@@ -1560,8 +1646,14 @@ JL_DLLEXPORT jl_array_t *jl_ptr_to_array_1d(jl_value_t *atype, void *data,
                                             size_t nel, int own_buffer);
 JL_DLLEXPORT jl_array_t *jl_ptr_to_array(jl_value_t *atype, void *data,
                                          jl_value_t *dims, int own_buffer);
+JL_DLLEXPORT jl_array_t *jl_map_array_1d(jl_value_t *atype, void *data, size_t nel,
+                                         void (*release)(jl_array_t *a));
+JL_DLLEXPORT jl_array_t *jl_map_array(jl_value_t *atype, void *data, jl_value_t *dims,
+                                      void (*release)(jl_array_t *a));
 
 JL_DLLEXPORT jl_array_t *jl_alloc_array_1d(jl_value_t *atype, size_t nr);
+JL_DLLEXPORT jl_array_t *jl_alloc_array_1d_align(jl_value_t *atype, size_t nr,
+                                                 size_t align);
 JL_DLLEXPORT jl_array_t *jl_alloc_array_2d(jl_value_t *atype, size_t nr,
                                            size_t nc);
 JL_DLLEXPORT jl_array_t *jl_alloc_array_3d(jl_value_t *atype, size_t nr,
@@ -1569,6 +1661,13 @@ JL_DLLEXPORT jl_array_t *jl_alloc_array_3d(jl_value_t *atype, size_t nr,
 JL_DLLEXPORT jl_array_t *jl_pchar_to_array(const char *str, size_t len);
 JL_DLLEXPORT jl_value_t *jl_pchar_to_string(const char *str, size_t len);
 JL_DLLEXPORT jl_value_t *jl_cstr_to_string(const char *str);
+// opt-in weak string interning (see array.c)
+JL_DLLEXPORT jl_value_t *jl_intern_pchar(const char *str, size_t len);
+JL_DLLEXPORT jl_value_t *jl_intern_string(jl_value_t *s);
+// ios-backed streaming string builder (see sys.c)
+JL_DLLEXPORT ios_t *jl_string_builder_new(void);
+JL_DLLEXPORT void jl_string_builder_write(ios_t *s, const char *data, size_t len);
+JL_DLLEXPORT jl_value_t *jl_string_builder_take(ios_t *s);
 JL_DLLEXPORT jl_value_t *jl_alloc_string(size_t len);
 JL_DLLEXPORT jl_value_t *jl_array_to_string(jl_array_t *a);
 JL_DLLEXPORT jl_array_t *jl_alloc_vec_any(size_t n);
@@ -1582,8 +1681,24 @@ JL_DLLEXPORT void jl_array_del_end(jl_array_t *a, size_t dec);
 JL_DLLEXPORT void jl_array_grow_beg(jl_array_t *a, size_t inc);
 JL_DLLEXPORT void jl_array_del_beg(jl_array_t *a, size_t dec);
 JL_DLLEXPORT void jl_array_sizehint(jl_array_t *a, size_t sz);
+// free a malloc'd array buffer immediately, leaving `a` as a valid empty
+// array; any other use of the old contents is undefined
+JL_DLLEXPORT void jl_array_unsafe_free(jl_array_t *a) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void jl_array_ptr_1d_push(jl_array_t *a, jl_value_t *item);
 JL_DLLEXPORT void jl_array_ptr_1d_append(jl_array_t *a, jl_array_t *a2);
+// fused data+selector copy/fill for isbits-Union arrays (0-based offsets)
+JL_DLLEXPORT void jl_array_bitsunion_copy(jl_array_t *dest, size_t doffs,
+                                          jl_array_t *src, size_t soffs, size_t n) JL_NOTSAFEPOINT;
+JL_DLLEXPORT void jl_array_bitsunion_fill(jl_array_t *a, jl_value_t *v, size_t offs, size_t n);
+JL_DLLEXPORT void *jl_memmove_bulk(void *dst, const void *src, size_t nb) JL_NOTSAFEPOINT;
+// first occurrence of needle in haystack (0-based offset, -1 if absent)
+JL_DLLEXPORT int64_t jl_memmem(const char *hay, size_t hlen,
+                               const char *needle, size_t nlen) JL_NOTSAFEPOINT;
+// LSD radix sort of the low `bits` bits of n keys; `t` is same-length scratch.
+// Returns 0 if the sorted keys end up in `v`, 1 if in `t` (see src/sort.c).
+JL_DLLEXPORT int jl_radix_sort_16(uint16_t *v, uint16_t *t, size_t n, unsigned bits) JL_NOTSAFEPOINT;
+JL_DLLEXPORT int jl_radix_sort_32(uint32_t *v, uint32_t *t, size_t n, unsigned bits) JL_NOTSAFEPOINT;
+JL_DLLEXPORT int jl_radix_sort_64(uint64_t *v, uint64_t *t, size_t n, unsigned bits) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_value_t *jl_apply_array_type(jl_value_t *type, size_t dim);
 JL_DLLEXPORT int jl_array_validate_dims(size_t *nel, size_t *tot, uint32_t ndims, size_t *dims, size_t elsz);
 // property access
@@ -1636,6 +1751,8 @@ JL_DLLEXPORT void jl_module_export(jl_module_t *from, jl_sym_t *s);
 JL_DLLEXPORT int jl_is_imported(jl_module_t *m, jl_sym_t *s);
 JL_DLLEXPORT int jl_module_exports_p(jl_module_t *m, jl_sym_t *var);
 JL_DLLEXPORT void jl_add_standard_imports(jl_module_t *m);
+// close every method table owned by `m` against later method definition (see gf.c)
+JL_DLLEXPORT void jl_module_freeze(jl_module_t *m);
 STATIC_INLINE jl_function_t *jl_get_function(jl_module_t *m, const char *name)
 {
     return (jl_function_t*)jl_get_global(m, jl_symbol(name));
@@ -1643,14 +1760,38 @@ STATIC_INLINE jl_function_t *jl_get_function(jl_module_t *m, const char *name)
 
 // eq hash tables
 JL_DLLEXPORT jl_array_t *jl_eqtable_put(jl_array_t *h, jl_value_t *key, jl_value_t *val, int *inserted);
+JL_DLLEXPORT jl_array_t *jl_eqtable_put_incremental(jl_array_t *h, jl_value_t *key, jl_value_t *val, int *inserted);
 JL_DLLEXPORT jl_value_t *jl_eqtable_get(jl_array_t *h, jl_value_t *key, jl_value_t *deflt) JL_NOTSAFEPOINT;
+JL_DLLEXPORT jl_array_t *jl_idtable_drain(jl_array_t *h);
 
 // system information
 JL_DLLEXPORT int jl_errno(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void jl_set_errno(int e) JL_NOTSAFEPOINT;
 JL_DLLEXPORT int32_t jl_stat(const char *path, char *statbuf) JL_NOTSAFEPOINT;
+JL_DLLEXPORT void jl_stat_batch(const char **paths, size_t npaths,
+                                char *statbufs, int32_t *rets);
+JL_DLLEXPORT void jl_prefetch_files(const char **paths, size_t npaths);
 JL_DLLEXPORT int jl_cpu_threads(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT int jl_effective_threads(void) JL_NOTSAFEPOINT;
+
+// Host CPU cache and core topology, probed once at first use so libraries
+// can derive blocking parameters at load time instead of shipping lookup
+// tables. Fields are 0 when the platform does not expose the information;
+// cache sizes are in bytes and describe one cache instance, with the
+// matching `*_sharing` field giving the number of logical CPUs that share
+// it. Detection is per-architecture (see processor_x86.cpp/processor_arm.cpp).
+typedef struct {
+    int logical_cpus;       // online logical CPUs (same as jl_cpu_threads)
+    int smt_threads;        // hardware threads per core (1 = no SMT)
+    int cores_per_llc;      // cores sharing the last-level cache
+    uint32_t l1d_size;      // per-core data cache, bytes
+    uint32_t l1d_linesize;  // data cache line, bytes
+    uint32_t l2_size;
+    uint32_t l2_sharing;    // logical CPUs sharing one L2
+    uint32_t l3_size;
+    uint32_t l3_sharing;    // logical CPUs sharing one L3
+} jl_cpu_topology_t;
+JL_DLLEXPORT const jl_cpu_topology_t *jl_cpu_topology(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT long jl_getpagesize(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT long jl_getallocationgranularity(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT int jl_is_debugbuild(void) JL_NOTSAFEPOINT;
@@ -1746,6 +1887,7 @@ JL_DLLEXPORT void jl_preload_sysimg_so(const char *fname);
 JL_DLLEXPORT void jl_set_sysimg_so(void *handle);
 JL_DLLEXPORT ios_t *jl_create_system_image(void *);
 JL_DLLEXPORT void jl_save_system_image(const char *fname);
+JL_DLLEXPORT void jl_checkpoint_system_image(const char *fname);
 JL_DLLEXPORT void jl_restore_system_image(const char *fname);
 JL_DLLEXPORT void jl_restore_system_image_data(const char *buf, size_t len);
 JL_DLLEXPORT void jl_set_newly_inferred(jl_value_t *newly_inferred);
@@ -1756,6 +1898,7 @@ JL_DLLEXPORT jl_value_t *jl_restore_incremental_from_buf(const char *buf, size_t
 // parsing
 JL_DLLEXPORT jl_value_t *jl_parse_all(const char *text, size_t text_len,
                                       const char *filename, size_t filename_len, size_t lineno);
+JL_DLLEXPORT jl_value_t *jl_parse_all_cached(jl_value_t *text, jl_value_t *filename);
 JL_DLLEXPORT jl_value_t *jl_parse_string(const char *text, size_t text_len,
                                          int offset, int greedy);
 // lowering
@@ -1815,6 +1958,8 @@ JL_DLLEXPORT jl_value_t *jl_copy_ast(jl_value_t *expr JL_MAYBE_UNROOTED);
 // IR representation
 JL_DLLEXPORT jl_array_t *jl_compress_ir(jl_method_t *m, jl_code_info_t *code);
 JL_DLLEXPORT jl_code_info_t *jl_uncompress_ir(jl_method_t *m, jl_code_instance_t *metadata, jl_array_t *data);
+JL_DLLEXPORT jl_array_t *jl_compress_ir_value(jl_method_t *m, jl_value_t *v);
+JL_DLLEXPORT jl_value_t *jl_uncompress_ir_value(jl_method_t *m, jl_array_t *data);
 JL_DLLEXPORT uint8_t jl_ir_flag_inferred(jl_array_t *data) JL_NOTSAFEPOINT;
 JL_DLLEXPORT uint8_t jl_ir_flag_pure(jl_array_t *data) JL_NOTSAFEPOINT;
 JL_DLLEXPORT uint16_t jl_ir_inlining_cost(jl_array_t *data) JL_NOTSAFEPOINT;
@@ -1843,6 +1988,17 @@ STATIC_INLINE int jl_vinfo_usedundef(uint8_t vi)
 // calling into julia ---------------------------------------------------------
 
 JL_DLLEXPORT jl_value_t *jl_apply_generic(jl_value_t *F, jl_value_t **args, uint32_t nargs);
+// Apply `F` to `ncalls` rows of `nargs` arguments each (laid out contiguously
+// in `args`), storing each result in `results`. Both buffers must stay rooted
+// for the whole batch; dispatch state is hoisted out of the per-row loop.
+JL_DLLEXPORT void jl_apply_generic_batch(jl_value_t *F, jl_value_t **args, uint32_t nargs,
+                                         size_t ncalls, jl_value_t **results);
+// Apply `F` to `args`, expecting a result of the concrete isbits type `rt`.
+// On a type match the payload is copied into `ret` (which must hold at least
+// `jl_datatype_size(rt)` bytes) and NULL is returned; otherwise the boxed
+// result is returned as from `jl_apply_generic` and `ret` is untouched.
+JL_DLLEXPORT jl_value_t *jl_apply_generic_unboxed(jl_value_t *rt, void *ret,
+                                                  jl_value_t *F, jl_value_t **args, uint32_t nargs);
 JL_DLLEXPORT jl_value_t *jl_invoke(jl_value_t *F, jl_value_t **args, uint32_t nargs, jl_method_instance_t *meth);
 JL_DLLEXPORT int32_t jl_invoke_api(jl_code_instance_t *linfo);
 
@@ -1905,9 +2061,18 @@ typedef struct _jl_task_t {
     _Atomic(int16_t) tid;
     // threadpool id
     int8_t threadpoolid;
+    // NUMA placement: declared working-set node (-1 for none) and the node
+    // the task last ran on (-1 before its first run); only meaningful when
+    // threads are node-pinned (JULIA_NUMA), see jl_get_task_socket
+    int16_t socket_hint;
+    int16_t last_socket;
     // saved gc stack top for context switches
     jl_gcframe_t *gcstack;
     size_t world_age;
+    // bytes this task allocated while previously scheduled; the running
+    // task's in-progress window lives in its thread's allocation counters
+    // and is added by jl_task_allocd_bytes
+    int64_t allocd_bytes;
     // quick lookup for current ptls
     jl_ptls_t ptls; // == jl_all_tls_states[tid]
     // saved exception stack
@@ -1928,9 +2093,30 @@ typedef struct _jl_task_t {
 
 JL_DLLEXPORT jl_task_t *jl_new_task(jl_function_t*, jl_value_t*, size_t);
 JL_DLLEXPORT void jl_switchto(jl_task_t **pt);
+JL_DLLEXPORT int64_t jl_task_allocd_bytes(jl_task_t *t);
+JL_DLLEXPORT int64_t jl_task_reset_allocd_bytes(jl_task_t *t);
 JL_DLLEXPORT int jl_set_task_tid(jl_task_t *task, int16_t tid) JL_NOTSAFEPOINT;
 JL_DLLEXPORT int jl_set_task_threadpoolid(jl_task_t *task, int8_t tpid) JL_NOTSAFEPOINT;
+JL_DLLEXPORT int jl_set_task_priority_lane(jl_task_t *task, int8_t lane) JL_NOTSAFEPOINT;
+// NUMA-aware scheduling: with JULIA_NUMA pinning each thread has a fixed
+// node, work stealing prefers same-node victims, and a task can be hinted to
+// the node holding its working set. Without pinning every thread reports
+// node 0 and these are no-ops.
+JL_DLLEXPORT int16_t jl_thread_socket(int16_t tid) JL_NOTSAFEPOINT;
+JL_DLLEXPORT int16_t jl_n_sockets(void) JL_NOTSAFEPOINT;
+JL_DLLEXPORT int jl_set_task_socket_hint(jl_task_t *task, int16_t socket) JL_NOTSAFEPOINT;
+JL_DLLEXPORT int16_t jl_get_task_socket(jl_task_t *task) JL_NOTSAFEPOINT;
+JL_DLLEXPORT void jl_set_work_conservation(int8_t enable) JL_NOTSAFEPOINT;
+JL_DLLEXPORT int8_t jl_get_work_conservation(void) JL_NOTSAFEPOINT;
+// scheduler decision tracing (see partr.c)
+JL_DLLEXPORT void jl_sched_trace_enable(int8_t enable);
+JL_DLLEXPORT void jl_sched_trace_note(int kind, int arg);
+JL_DLLEXPORT int jl_sched_trace_dump(const char *path);
 JL_DLLEXPORT void JL_NORETURN jl_throw(jl_value_t *e JL_MAYBE_UNROOTED);
+// Mark an exception type (matched exactly) as trace-free: throwing it skips
+// backtrace capture and handlers see an empty trace. Returns 0 if the
+// registry is full. Pass tf=0 to restore normal capture for the type.
+JL_DLLEXPORT int jl_exception_set_trace_free(jl_value_t *ty, int tf);
 JL_DLLEXPORT void JL_NORETURN jl_rethrow(void);
 JL_DLLEXPORT void JL_NORETURN jl_sig_throw(void);
 JL_DLLEXPORT void JL_NORETURN jl_rethrow_other(jl_value_t *e JL_MAYBE_UNROOTED);
@@ -2026,10 +2212,17 @@ typedef int jl_uv_os_fd_t;
 #define JL_STDERR jl_uv_stderr
 #define JL_STDIN  jl_uv_stdin
 
-JL_DLLEXPORT int jl_process_events(void);
+JL_DLLEXPORT int jl_process_events(int shard);
 
 JL_DLLEXPORT struct uv_loop_s *jl_global_event_loop(void);
 
+// sharded event loops (see jl_uv.c); shard indices outside [0, n) alias the
+// global event loop
+JL_DLLEXPORT int jl_uv_n_event_shards(void);
+JL_DLLEXPORT struct uv_loop_s *jl_uv_shard_loop(int shard);
+JL_DLLEXPORT void jl_uv_shard_lock(int shard);
+JL_DLLEXPORT void jl_uv_shard_unlock(int shard);
+
 JL_DLLEXPORT void jl_close_uv(struct uv_handle_s *handle);
 
 JL_DLLEXPORT jl_array_t *jl_take_buffer(ios_t *s);
@@ -2049,6 +2242,15 @@ typedef struct {
 #endif
 
 JL_DLLEXPORT void jl_uv_puts(struct uv_stream_s *stream, const char *str, size_t n);
+
+// lightweight timers multiplexed onto one uv timer (see jl_uv.c)
+typedef struct _jl_wheel_timer_t jl_wheel_timer_t;
+typedef void (*jl_timer_wheel_cb)(void *data);
+JL_DLLEXPORT jl_wheel_timer_t *jl_timer_wheel_start(uint64_t timeout_ms, uint64_t repeat_ms,
+                                                    jl_timer_wheel_cb cb, void *data);
+JL_DLLEXPORT void jl_timer_wheel_stop(jl_wheel_timer_t *t);
+JL_DLLEXPORT uint64_t jl_timer_wheel_get_repeat(jl_wheel_timer_t *t) JL_NOTSAFEPOINT;
+
 JL_DLLEXPORT int jl_printf(struct uv_stream_s *s, const char *format, ...)
     _JL_FORMAT_ATTR(printf, 2, 3);
 JL_DLLEXPORT int jl_vprintf(struct uv_stream_s *s, const char *format, va_list args)
@@ -2070,6 +2272,7 @@ JL_DLLEXPORT void jl_flush_cstdio(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_value_t *jl_stdout_obj(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_value_t *jl_stderr_obj(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT size_t jl_static_show(JL_STREAM *out, jl_value_t *v) JL_NOTSAFEPOINT;
+JL_DLLEXPORT size_t jl_static_show_bounded(JL_STREAM *out, jl_value_t *v, size_t limit) JL_NOTSAFEPOINT;
 JL_DLLEXPORT size_t jl_static_show_func_sig(JL_STREAM *s, jl_value_t *type) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void jl_print_backtrace(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void jlbacktrace(void) JL_NOTSAFEPOINT; // deprecated
@@ -2194,6 +2397,8 @@ typedef struct {
     int track_allocations;  // can we track allocations?
     int code_coverage;      // can we measure coverage?
     int prefer_specsig;     // are specialized function signatures preferred?
+    int speculate_globals;  // embed assigned-once non-const globals as constants
+                            // (invalidated through the world-age machinery on assignment)
 
     // controls the emission of debug-info. mirrors the clang options
     int gnu_pubnames;       // can we emit the gnu pubnames debuginfo
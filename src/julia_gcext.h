@@ -25,6 +25,11 @@ typedef void (*jl_gc_cb_post_gc_t)(int full) JL_NOTSAFEPOINT;
 typedef void (*jl_gc_cb_notify_external_alloc_t)(void *addr, size_t size) JL_NOTSAFEPOINT;
 typedef void (*jl_gc_cb_notify_external_free_t)(void *addr) JL_NOTSAFEPOINT;
 
+// Callback invoked from jl_gc_notify_memory_pressure with its `pressure`
+// argument, so embedders holding their own caches can react to the same
+// pressure signal as the collector.
+typedef void (*jl_gc_cb_memory_pressure_t)(int pressure) JL_NOTSAFEPOINT;
+
 JL_DLLEXPORT void jl_gc_set_cb_root_scanner(jl_gc_cb_root_scanner_t cb, int enable);
 JL_DLLEXPORT void jl_gc_set_cb_task_scanner(jl_gc_cb_task_scanner_t cb, int enable);
 JL_DLLEXPORT void jl_gc_set_cb_pre_gc(jl_gc_cb_pre_gc_t cb, int enable);
@@ -33,6 +38,8 @@ JL_DLLEXPORT void jl_gc_set_cb_notify_external_alloc(jl_gc_cb_notify_external_al
         int enable);
 JL_DLLEXPORT void jl_gc_set_cb_notify_external_free(jl_gc_cb_notify_external_free_t cb,
         int enable);
+JL_DLLEXPORT void jl_gc_set_cb_memory_pressure(jl_gc_cb_memory_pressure_t cb,
+        int enable);
 
 // Types for custom mark and sweep functions.
 typedef uintptr_t (*jl_markfunc_t)(jl_ptls_t, jl_value_t *obj);
@@ -122,6 +129,21 @@ JL_DLLEXPORT int jl_gc_conservative_gc_support_enabled(void);
 // jl_typeof(obj) is an actual type object.
 JL_DLLEXPORT jl_value_t *jl_gc_internal_obj_base_ptr(void *p);
 
+// Return the conservative address bounds [*lo, *hi) of the pool space, so
+// callers scanning large foreign memory ranges can reject non-pool words
+// inline with two comparisons before paying for a call to
+// jl_gc_internal_obj_base_ptr (which applies the same prefilter itself).
+// The range may cover unmapped gaps and can widen as the heap grows; it
+// never shrinks.
+JL_DLLEXPORT void jl_gc_pool_heap_bounds(uintptr_t *lo, uintptr_t *hi);
+
+// Conservatively scan the memory range [lo, hi) -- e.g. a host thread's
+// stack segment -- queueing every word that resolves to a pool object via
+// jl_gc_internal_obj_base_ptr for marking. Returns the number of objects
+// newly queued. May only be called from GC callbacks, under the same rules
+// as jl_gc_mark_queue_obj; conservative support must have been enabled.
+JL_DLLEXPORT size_t jl_gc_mark_conservative_range(jl_ptls_t ptls, void *lo, void *hi);
+
 // Return a non-null pointer to the start of the stack area if the task
 // has an associated stack buffer. In that case, *size will also contain
 // the size of that stack buffer upon return. Also, if task is a thread's
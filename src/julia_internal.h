@@ -10,6 +10,7 @@
 #include "support/hashing.h"
 #include "support/ptrhash.h"
 #include "support/strtod.h"
+#include "support/lz4.h"
 #include "gc-alloc-profiler.h"
 #include "support/rle.h"
 #include <uv.h>
@@ -62,6 +63,23 @@ void __tsan_switch_to_fiber(void *fiber, unsigned flags);
 #  endif
 #endif
 
+// Cheap O(1) invariant checks on dispatch and GC hot paths. In debug builds
+// this is a plain assert and in release builds it compiles away, but a build
+// configured with WITH_VERIFY=1 (see options.h) keeps the check enabled
+// behind an unlikely branch so invariant violations can still be caught under
+// production load. Only use this for checks whose cost is a few loads and a
+// compare; expensive validation belongs behind GC_VERIFY or JL_DEBUG_BUILD.
+#if defined(JL_VERIFY_BUILD) && defined(JL_NDEBUG)
+JL_DLLEXPORT void JL_NORETURN jl_invariant_fail(const char *expr, const char *file,
+                                                int line) JL_NOTSAFEPOINT;
+#define jl_invariant(cond) do {                                         \
+        if (__unlikely(!(cond)))                                        \
+            jl_invariant_fail(#cond, __FILE__, __LINE__);               \
+    } while (0)
+#else
+#define jl_invariant(cond) assert(cond)
+#endif
+
 #if defined(__GLIBC__) && defined(JULIA_HAS_IFUNC_SUPPORT)
 // Make sure both the compiler and the glibc supports it.
 // Only enable this on known working glibc versions.
@@ -131,6 +149,10 @@ int jl_running_under_rr(int recheck) JL_NOTSAFEPOINT;
 // Returns time in nanosec
 JL_DLLEXPORT uint64_t jl_hrtime(void) JL_NOTSAFEPOINT;
 
+// crc32c.c
+JL_DLLEXPORT uint32_t jl_crc32c(uint32_t crc, const char *buf, size_t len);
+JL_DLLEXPORT int jl_checksum_crc32c_hw(void) JL_NOTSAFEPOINT;
+
 JL_DLLEXPORT void jl_set_peek_cond(uintptr_t);
 JL_DLLEXPORT double jl_get_profile_peek_duration(void);
 JL_DLLEXPORT void jl_set_profile_peek_duration(double);
@@ -234,12 +256,50 @@ extern tracer_cb jl_newmeth_tracer;
 void jl_call_tracer(tracer_cb callback, jl_value_t *tracee);
 void print_func_loc(JL_STREAM *s, jl_method_t *m);
 extern jl_array_t *_jl_debug_method_invalidation JL_GLOBALLY_ROOTED;
-void invalidate_backedges(void (*f)(jl_code_instance_t*), jl_method_instance_t *replaced_mi, size_t max_world, const char *why);
+extern jl_array_t *jl_lowering_cache JL_GLOBALLY_ROOTED; // lowering memo table (ast.c)
+extern jl_array_t *jl_ircode_cache JL_GLOBALLY_ROOTED; // uncompressed IR memo table (ircode.c)
+extern arraylist_t jl_uv_write_root_list; // in-flight splice-write roots (jl_uv.c)
+extern jl_array_t *_jl_debug_compilation_timing JL_GLOBALLY_ROOTED;
+void invalidate_backedges(void (*f)(jl_code_instance_t*), jl_method_instance_t *replaced_mi, size_t max_world, const char *why, arraylist_t *direct_callers);
 
 extern JL_DLLEXPORT size_t jl_page_size;
 extern jl_function_t *jl_typeinf_func;
 extern JL_DLLEXPORT size_t jl_typeinf_world;
 extern _Atomic(jl_typemap_entry_t*) call_cache[N_CALL_CACHE] JL_GLOBALLY_ROOTED;
+extern _Atomic(jl_typemap_entry_t*) sig_call_cache[N_SIG_CACHE] JL_GLOBALLY_ROOTED;
+
+// inline-cache slots for dynamic call sites in JIT'd code: allocated in gf.c,
+// handed out to codegen one slot per call site, and scanned as GC roots
+#define PIC_SLOTS_PER_BLOCK 512
+typedef struct _jl_pic_slot_block_t {
+    struct _jl_pic_slot_block_t *next;
+    size_t used;
+    _Atomic(jl_typemap_entry_t*) slots[PIC_SLOTS_PER_BLOCK];
+} jl_pic_slot_block_t;
+extern jl_pic_slot_block_t *jl_pic_slot_blocks JL_GLOBALLY_ROOTED;
+JL_DLLEXPORT _Atomic(jl_typemap_entry_t*) *jl_alloc_pic_slot(void);
+JL_DLLEXPORT jl_value_t *jl_apply_generic_pic(jl_value_t *F, jl_value_t **args, uint32_t nargs, jl_value_t **pic);
+
+// memo table slot for closed subtype judgments: `seq` is even iff x/y/result
+// are mutually consistent (seqlock, so that readers never block)
+typedef struct {
+    _Atomic(uintptr_t) seq;
+    _Atomic(jl_value_t*) x;
+    _Atomic(jl_value_t*) y;
+    _Atomic(int) result;
+} jl_subtype_cache_slot_t;
+extern jl_subtype_cache_slot_t subtype_memo_cache[N_SUBTYPE_CACHE] JL_GLOBALLY_ROOTED;
+
+// memo table slot for x86-64 ABI classifications (see abi_x86_64.cpp), keyed
+// by datatype pointer identity; the GC roots the keys (see mark_roots) lest a
+// recycled address alias a stale classification. All other fields are only
+// touched under the codegen lock.
+typedef struct {
+    _Atomic(jl_datatype_t*) dt;
+    uint8_t isMemory;
+    uint8_t classes[2];
+} jl_abi_classify_slot_t;
+extern jl_abi_classify_slot_t jl_abi_classify_cache[N_ABI_CLASSIFY_CACHE] JL_GLOBALLY_ROOTED;
 extern jl_array_t *jl_all_methods JL_GLOBALLY_ROOTED;
 
 JL_DLLEXPORT extern int jl_lineno;
@@ -249,6 +309,11 @@ jl_value_t *jl_gc_pool_alloc_noinline(jl_ptls_t ptls, int pool_offset,
                                    int osize);
 jl_value_t *jl_gc_big_alloc_noinline(jl_ptls_t ptls, size_t allocsz);
 JL_DLLEXPORT int jl_gc_classify_pools(size_t sz, int *osize);
+// region ("arena") allocation mode for compiler temporaries: while a region
+// is active on the current thread, automatic collections triggered by its
+// allocations are deferred (bounded) until the outermost region exits
+JL_DLLEXPORT void jl_gc_begin_arena(void);
+JL_DLLEXPORT void jl_gc_end_arena(void);
 extern uv_mutex_t gc_perm_lock;
 void *jl_gc_perm_alloc_nolock(size_t sz, int zero,
     unsigned align, unsigned offset) JL_NOTSAFEPOINT;
@@ -366,6 +431,29 @@ STATIC_INLINE uint8_t JL_CONST_FUNC jl_gc_szclass_align8(unsigned sz)
 #define GC_MAX_SZCLASS (2032-sizeof(void*))
 static_assert(ARRAY_CACHE_ALIGN_THRESHOLD > GC_MAX_SZCLASS, "");
 
+#ifdef _OS_LINUX_
+// at this size and bigger, allocate array data buffers in their own anonymous
+// mapping, so that growing them can use mremap (which remaps pages) instead
+// of a realloc that copies the whole contents
+#define BUFFER_MMAP_THRESH (64 * 1024 * 1024)
+#endif
+
+// whether a `how == 2` array data buffer of this size and shape is (or, at
+// allocation time, should be) backed by its own mapping; restricted to 1-d
+// non-union buffers so that the exact allocated size can be recomputed from
+// the array when it is swept (see `jl_array_nbytes`)
+STATIC_INLINE int jl_buf_mmapped(size_t nbytes, int ndims, int isbitsunion) JL_NOTSAFEPOINT
+{
+#ifdef _OS_LINUX_
+    return ndims == 1 && !isbitsunion && nbytes >= BUFFER_MMAP_THRESH;
+#else
+    (void)nbytes;
+    (void)ndims;
+    (void)isbitsunion;
+    return 0;
+#endif
+}
+
 STATIC_INLINE jl_value_t *jl_gc_alloc_(jl_ptls_t ptls, size_t sz, void *ty)
 {
     jl_value_t *v;
@@ -472,8 +560,12 @@ JL_DLLEXPORT int64_t jl_gc_diff_total_bytes(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT int64_t jl_gc_sync_total_bytes(int64_t offset) JL_NOTSAFEPOINT;
 void jl_gc_track_malloced_array(jl_ptls_t ptls, jl_array_t *a) JL_NOTSAFEPOINT;
 void jl_gc_count_allocd(size_t sz) JL_NOTSAFEPOINT;
+void *jl_gc_managed_mmap(size_t sz);
+void *jl_gc_managed_mremap(void *d, size_t sz, size_t oldsz, jl_value_t *owner);
+void jl_gc_free_managed_buf(void *d, size_t oldsz, int isaligned) JL_NOTSAFEPOINT;
 void jl_gc_run_all_finalizers(jl_task_t *ct);
 void jl_release_task_stack(jl_ptls_t ptls, jl_task_t *task);
+jl_task_t *jl_gc_take_task_shell(jl_ptls_t ptls) JL_NOTSAFEPOINT;
 void jl_gc_add_finalizer_(jl_ptls_t ptls, void *v, void *f) JL_NOTSAFEPOINT;
 
 // Set GC memory trigger in bytes for greedy memory collecting
@@ -532,9 +624,15 @@ typedef union {
 // -- functions -- //
 
 JL_DLLEXPORT jl_code_info_t *jl_type_infer(jl_method_instance_t *li, size_t world, int force);
+void jl_init_shared_infer_cache(void);
+jl_code_info_t *jl_shared_infer_cache_lookup(jl_method_instance_t *mi, size_t world);
+void jl_shared_infer_cache_store(jl_method_instance_t *mi, jl_code_info_t *src);
 JL_DLLEXPORT jl_code_instance_t *jl_compile_method_internal(jl_method_instance_t *meth JL_PROPAGATES_ROOT, size_t world);
 jl_code_instance_t *jl_generate_fptr(jl_method_instance_t *mi JL_PROPAGATES_ROOT, size_t world);
 void jl_generate_fptr_for_unspecialized(jl_code_instance_t *unspec);
+void jl_tiered_compile_upgrade(jl_method_instance_t *mi, size_t world);
+JL_DLLEXPORT size_t jl_profile_recompile_hot(int64_t threshold);
+JL_DLLEXPORT size_t jl_jit_freeze_invokes(void);
 JL_DLLEXPORT jl_code_instance_t *jl_get_method_inferred(
         jl_method_instance_t *mi JL_PROPAGATES_ROOT, jl_value_t *rettype,
         size_t min_world, size_t max_world);
@@ -578,6 +676,17 @@ void jl_install_thread_signal_handler(jl_ptls_t ptls);
 JL_DLLEXPORT jl_fptr_args_t jl_get_builtin_fptr(jl_value_t *b);
 
 extern uv_loop_t *jl_io_loop;
+
+// weak string intern table (array.c); entries whose string died are
+// tombstoned by the GC next to the weak refs (sweep_intern_tab in gc.c)
+typedef struct {
+    jl_value_t *str;
+    uint64_t hash;
+} jl_interned_str_t;
+#define JL_INTERN_DELETED ((jl_value_t*)1)
+extern jl_interned_str_t *jl_intern_tab;
+extern size_t jl_intern_tab_sz;
+extern size_t jl_intern_tab_count;
 void jl_uv_flush(uv_stream_t *stream);
 
 typedef struct jl_typeenv_t {
@@ -595,6 +704,8 @@ int jl_has_concrete_subtype(jl_value_t *typ);
 jl_tupletype_t *jl_inst_arg_tuple_type(jl_value_t *arg1, jl_value_t **args, size_t nargs, int leaf);
 jl_tupletype_t *jl_lookup_arg_tuple_type(jl_value_t *arg1 JL_PROPAGATES_ROOT, jl_value_t **args, size_t nargs, int leaf);
 JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method, jl_tupletype_t *simpletype);
+JL_DLLEXPORT void jl_method_batch_begin(void);
+JL_DLLEXPORT void jl_method_batch_end(void);
 jl_datatype_t *jl_mk_builtin_func(jl_datatype_t *dt, const char *name, jl_fptr_args_t fptr) JL_GC_DISABLED;
 int jl_obviously_unequal(jl_value_t *a, jl_value_t *b);
 JL_DLLEXPORT jl_array_t *jl_find_free_typevars(jl_value_t *v);
@@ -605,6 +716,8 @@ jl_svec_t *jl_outer_unionall_vars(jl_value_t *u);
 jl_value_t *jl_type_intersection_env_s(jl_value_t *a, jl_value_t *b, jl_svec_t **penv, int *issubty);
 jl_value_t *jl_type_intersection_env(jl_value_t *a, jl_value_t *b, jl_svec_t **penv);
 int jl_subtype_matching(jl_value_t *a, jl_value_t *b, jl_svec_t **penv);
+int jl_obviously_disjoint(jl_value_t *a, jl_value_t *b);
+JL_DLLEXPORT uint64_t jl_intersect_fuel_exhausted_count(void);
 JL_DLLEXPORT int jl_types_egal(jl_value_t *a, jl_value_t *b);
 // specificity comparison assuming !(a <: b) and !(b <: a)
 JL_DLLEXPORT int jl_type_morespecific_no_subtype(jl_value_t *a, jl_value_t *b);
@@ -626,9 +739,10 @@ void jl_reinstantiate_inner_types(jl_datatype_t *t);
 jl_datatype_t *jl_lookup_cache_type_(jl_datatype_t *type);
 void jl_cache_type_(jl_datatype_t *type);
 void set_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *rhs, int isatomic) JL_NOTSAFEPOINT;
-jl_value_t *swap_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *rhs, int isatomic);
-jl_value_t *modify_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *op, jl_value_t *rhs, int isatomic);
-jl_value_t *replace_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *expected, jl_value_t *rhs, int isatomic);
+jl_value_t *jl_new_tuplev(jl_datatype_t *type, jl_value_t **args, size_t nargs);
+jl_value_t *swap_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *rhs, int isatomic, enum jl_memory_order order);
+jl_value_t *modify_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *op, jl_value_t *rhs, int isatomic, enum jl_memory_order order);
+jl_value_t *replace_nth_field(jl_datatype_t *st, jl_value_t *v, size_t i, jl_value_t *expected, jl_value_t *rhs, int isatomic, enum jl_memory_order success_order, enum jl_memory_order failure_order);
 jl_expr_t *jl_exprn(jl_sym_t *head, size_t n);
 jl_function_t *jl_new_generic_function(jl_sym_t *name, jl_module_t *module);
 jl_function_t *jl_new_generic_function_with_supertype(jl_sym_t *name, jl_module_t *module, jl_datatype_t *st);
@@ -671,6 +785,7 @@ void jl_compute_field_offsets(jl_datatype_t *st);
 jl_array_t *jl_new_array_for_deserialization(jl_value_t *atype, uint32_t ndims, size_t *dims,
                                              int isunboxed, int hasptr, int isunion, int elsz);
 void jl_module_run_initializer(jl_module_t *m);
+void jl_module_rebuild_fastbindings(jl_module_t *m);
 jl_binding_t *jl_get_module_binding(jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var);
 JL_DLLEXPORT void jl_binding_deprecation_warning(jl_module_t *m, jl_binding_t *b);
 extern jl_array_t *jl_module_init_order JL_GLOBALLY_ROOTED;
@@ -765,6 +880,10 @@ void jl_init_intrinsic_functions(void);
 void jl_init_intrinsic_properties(void);
 void jl_init_tasks(void) JL_GC_DISABLED;
 void jl_init_stack_limits(int ismaster, void **stack_hi, void **stack_lo);
+// cooperative task preemption (task.c); quantum in nanoseconds, 0 disabled
+extern uint64_t jl_task_preempt_quantum;
+void jl_task_preempt_reset(jl_ptls_t ptls) JL_NOTSAFEPOINT;
+void jl_task_maybe_preempt(jl_ptls_t ptls);
 jl_task_t *jl_init_root_task(jl_ptls_t ptls, void *stack_lo, void *stack_hi);
 void jl_init_serializer(void);
 void jl_gc_init(void);
@@ -781,6 +900,7 @@ extern JL_DLLEXPORT ssize_t jl_tls_offset;
 extern JL_DLLEXPORT const int jl_tls_elf_support;
 void jl_init_threading(void);
 void jl_start_threads(void);
+extern int jl_numa_pinned; // threads are pinned to their NUMA node (JULIA_NUMA)
 int jl_effective_threads(void);
 
 // Whether the GC is running
@@ -855,6 +975,14 @@ static inline void jl_set_gc_and_wait(void)
 #endif
 void jl_gc_set_permalloc_region(void *start, void *end);
 
+// image mapping layer (sys.c): mmap policy for sysimage / package cache files
+#define JL_IMAGE_MAP_WRITE    (1 << 0) // copy-on-write writable mapping (for relocations)
+#define JL_IMAGE_MAP_WILLNEED (1 << 1) // start kernel readahead of the whole range
+#define JL_IMAGE_MAP_PREFAULT (1 << 2) // fault the range in eagerly (MAP_POPULATE or background thread)
+#define JL_IMAGE_MAP_HUGEPAGE (1 << 3) // back the range with transparent huge pages if possible
+char *jl_image_map_file(int fd, size_t len, int flags);
+void jl_image_hint(void *data, size_t len, int flags);
+
 typedef struct {
     LLVMOrcThreadSafeModuleRef TSM;
     LLVMValueRef F;
@@ -879,6 +1007,8 @@ JL_DLLEXPORT void jl_get_function_id(void *native_code, jl_code_instance_t *ncod
 // make sure it is rooted if it is used after the function returns
 JL_DLLEXPORT jl_array_t *jl_idtable_rehash(jl_array_t *a, size_t newsz);
 _Atomic(jl_value_t*) *jl_table_peek_bp(jl_array_t *a, jl_value_t *key) JL_NOTSAFEPOINT;
+jl_value_t *jl_eqtable_get_hashed(jl_array_t *h, jl_value_t *key, uintptr_t hv, jl_value_t *deflt) JL_NOTSAFEPOINT;
+jl_array_t *jl_eqtable_migration_chain(jl_array_t *h) JL_NOTSAFEPOINT;
 
 JL_DLLEXPORT jl_method_t *jl_new_method_uninit(jl_module_t*);
 
@@ -893,6 +1023,8 @@ JL_DLLEXPORT jl_method_instance_t *jl_specializations_get_linfo(
 jl_method_instance_t *jl_specializations_get_or_insert(jl_method_instance_t *mi_ins);
 JL_DLLEXPORT void jl_method_instance_add_backedge(jl_method_instance_t *callee, jl_method_instance_t *caller);
 JL_DLLEXPORT void jl_method_table_add_backedge(jl_methtable_t *mt, jl_value_t *typ, jl_value_t *caller);
+JL_DLLEXPORT void jl_binding_add_speculation(jl_binding_t *b, jl_method_instance_t *caller);
+JL_DLLEXPORT void jl_binding_invalidate_speculations(jl_binding_t *b);
 
 uint32_t jl_module_next_counter(jl_module_t *m) JL_NOTSAFEPOINT;
 jl_tupletype_t *arg_type_tuple(jl_value_t *arg1, jl_value_t **args, size_t nargs);
@@ -1039,7 +1171,18 @@ extern JL_DLLEXPORT uv_mutex_t jl_in_stackwalk;
 #  define UNW_LOCAL_ONLY
 #  include <libunwind.h>
 typedef unw_context_t bt_context_t;
+#  if defined(_CPU_X86_64_)
+// The libunwind cursor is paired with a little state for the unwind recipe
+// cache in stackwalk.c: while `recipe_ip` is nonzero the walk is advancing
+// from cached (frame size) recipes alone and `uc` is stale.
+typedef struct {
+    unw_cursor_t uc;
+    uintptr_t recipe_ip;
+    uintptr_t recipe_sp;
+} bt_cursor_t;
+#  else
 typedef unw_cursor_t bt_cursor_t;
+#  endif
 #  if (!defined(SYSTEM_LIBUNWIND) || UNW_VERSION_MAJOR > 1 ||   \
        (UNW_VERSION_MAJOR == 1 && UNW_VERSION_MINOR != 0 && UNW_VERSION_MINOR != 1))
 // Enable our memory manager only for libunwind with our patch or
@@ -1142,9 +1285,50 @@ STATIC_INLINE uint64_t cong(uint64_t max, uint64_t unbias, uint64_t *seed) JL_NO
         ;
     return *seed % max;
 }
+
+// counter-based thread-local RNG (following wyrand): the state is a plain
+// counter, so generation is branch-free -- one increment and one wide
+// multiply-xor -- and the output sequence has full 2^64 period. Each thread
+// seeds its own state (`ptls->rngseed`) from `jl_rand()`, which jl_init_rand
+// feeds from the OS entropy pool.
+STATIC_INLINE uint64_t jl_rand_next(uint64_t *state) JL_NOTSAFEPOINT
+{
+    uint64_t c = (*state += 0xa0761d6478bd642full);
+#if defined(_P64) && defined(__SIZEOF_INT128__)
+    unsigned __int128 r = (unsigned __int128)c * (c ^ 0xe7037ed1a0b428dbull);
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+    // no wide multiply: xor-multiply-xor finalizer (splitmix64-style)
+    c ^= c >> 32;
+    c *= 0xd6e8feb86659fd93ull;
+    c ^= c >> 32;
+    c *= 0xd6e8feb86659fd93ull;
+    c ^= c >> 32;
+    return c;
+#endif
+}
+
+// unbiased draw in [0, max) by Lemire's widening-multiply method: a multiply
+// and a shift map the draw to the range, and only the few draws that would
+// land unevenly (fewer than max out of 2^32) are rejected. Unlike `cong`
+// no precomputed unbias threshold is needed.
+STATIC_INLINE uint32_t jl_rand_bounded(uint64_t *state, uint32_t max) JL_NOTSAFEPOINT
+{
+    uint64_t m = (uint64_t)(uint32_t)jl_rand_next(state) * max;
+    if ((uint32_t)m < max) {
+        uint32_t lim = -max % max; // 2^32 mod max
+        while ((uint32_t)m < lim)
+            m = (uint64_t)(uint32_t)jl_rand_next(state) * max;
+    }
+    return (uint32_t)(m >> 32);
+}
+
 JL_DLLEXPORT uint64_t jl_rand(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void jl_srand(uint64_t) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void jl_init_rand(void);
+JL_DLLEXPORT uint64_t jl_rand_u64(void) JL_NOTSAFEPOINT;
+JL_DLLEXPORT void jl_rand_fill(void *buf, size_t len) JL_NOTSAFEPOINT;
+JL_DLLEXPORT uint32_t jl_rand_bounded_u32(uint32_t max) JL_NOTSAFEPOINT;
 
 JL_DLLEXPORT extern void *jl_libjulia_internal_handle;
 JL_DLLEXPORT extern void *jl_RTLD_DEFAULT_handle;
@@ -1278,6 +1462,10 @@ JL_DLLEXPORT jl_value_t *jl_sqrt_llvm_fast(jl_value_t *a);
 JL_DLLEXPORT jl_value_t *jl_abs_float(jl_value_t *a);
 JL_DLLEXPORT jl_value_t *jl_copysign_float(jl_value_t *a, jl_value_t *b);
 JL_DLLEXPORT jl_value_t *jl_flipsign_int(jl_value_t *a, jl_value_t *b);
+JL_DLLEXPORT int jl_intrinsic_call_bulk(jl_value_t *f, jl_value_t *ety, void *pr,
+                                        const void *pa, const void *pb, size_t n);
+JL_DLLEXPORT int jl_intrinsic_cvt_bulk(jl_value_t *f, jl_value_t *toty, jl_value_t *ety,
+                                       void *pr, const void *pa, size_t n);
 
 JL_DLLEXPORT jl_value_t *jl_arraylen(jl_value_t *a);
 JL_DLLEXPORT jl_value_t *jl_have_fma(jl_value_t *a);
@@ -1350,6 +1538,11 @@ int jl_typemap_visitor(jl_typemap_t *a, jl_typemap_visitor_fptr fptr, void *clos
 
 struct typemap_intersection_env;
 typedef int (*jl_typemap_intersection_visitor_fptr)(jl_typemap_entry_t *l, struct typemap_intersection_env *closure);
+// The visitor keeps all of its mutable state inside this closure, so
+// `jl_typemap_intersection_visitor` is reentrant: concurrent visits over the
+// same (or overlapping) typemaps are safe as long as each carries its own
+// closure and `fptr` confines its side effects to that closure (or to state
+// the caller synchronizes). Both in-tree visitors (gf.c) follow this rule.
 struct typemap_intersection_env {
     // input values
     jl_typemap_intersection_visitor_fptr const fptr; // fptr to call on a match
@@ -1544,6 +1737,11 @@ jl_sym_t *_jl_symbol(const char *str, size_t len) JL_NOTSAFEPOINT;
 JL_DLLEXPORT float julia__gnu_h2f_ieee(uint16_t param) JL_NOTSAFEPOINT;
 JL_DLLEXPORT uint16_t julia__gnu_f2h_ieee(float param) JL_NOTSAFEPOINT;
 JL_DLLEXPORT uint16_t julia__truncdfhf2(double param) JL_NOTSAFEPOINT;
+// bulk half/bfloat16 conversion kernels (hardware-accelerated where possible)
+JL_DLLEXPORT void jl_half_to_float_bulk(float *dst, const uint16_t *src, size_t n);
+JL_DLLEXPORT void jl_float_to_half_bulk(uint16_t *dst, const float *src, size_t n);
+JL_DLLEXPORT void jl_bfloat_to_float_bulk(float *dst, const uint16_t *src, size_t n);
+JL_DLLEXPORT void jl_float_to_bfloat_bulk(uint16_t *dst, const float *src, size_t n);
 //JL_DLLEXPORT double julia__extendhfdf2(uint16_t n) JL_NOTSAFEPOINT;
 //JL_DLLEXPORT int32_t julia__fixhfsi(uint16_t n) JL_NOTSAFEPOINT;
 //JL_DLLEXPORT int64_t julia__fixhfdi(uint16_t n) JL_NOTSAFEPOINT;
@@ -130,6 +130,9 @@ typedef struct {
     _Atomic(uint64_t) poolalloc;
     _Atomic(uint64_t) bigalloc;
     _Atomic(uint64_t) freecall;
+    // monotonic total of bytes allocated on this thread; unlike `allocd` it is
+    // never rewound by collections (used for per-task accounting, see task.c)
+    _Atomic(int64_t) cum_allocd;
 } jl_thread_gc_num_t;
 
 typedef struct {
@@ -138,6 +141,9 @@ typedef struct {
     // live tasks started on this thread
     // that are holding onto a stack from the pool
     arraylist_t live_tasks;
+    // task shells the last sweep proved unreachable, kept for reuse by
+    // jl_new_task until the next sweep purges them
+    arraylist_t recycled_tasks;
 
     // variables for tracking malloc'd arrays
     struct _mallocarray_t *mallocarrays;
@@ -145,6 +151,12 @@ typedef struct {
 
     // variables for tracking big objects
     struct _bigval_t *big_objects;
+    // per-size-class freelists of cached dead big objects, indexed by
+    // floor(log2(allocsz)); a bounded number of madvised blocks is kept
+    // per class (see big_cache_free in gc.c)
+#define JL_GC_BIG_NCLASSES (8 * sizeof(void*))
+    struct _bigval_t *big_freelists[JL_GC_BIG_NCLASSES];
+    uint8_t big_nfreelist[JL_GC_BIG_NCLASSES];
 
     // variables for tracking "remembered set"
     arraylist_t rem_bindings;
@@ -153,6 +165,9 @@ typedef struct {
     int remset_nptr;
     arraylist_t *remset;
     arraylist_t *last_remset;
+    // pool pages with dirty remembered-set cards, recorded by the write
+    // barrier when the bucketed remset is enabled (see gc.c)
+    arraylist_t dirty_pages;
 
     // variables for allocating objects from pools
 #ifdef _P64
@@ -163,9 +178,15 @@ typedef struct {
 #  define JL_GC_N_POOLS 51
 #endif
     jl_gc_pool_t norm_pools[JL_GC_N_POOLS];
+    // same size classes, used only by `jl_alloc_string`, so that strings fill
+    // string-only pages (see `gc_pool_from_n` in gc.h)
+    jl_gc_pool_t string_pools[JL_GC_N_POOLS];
 
 #define JL_N_STACK_POOLS 16
     arraylist_t free_stacks[JL_N_STACK_POOLS];
+    // how many leading entries of each freelist had their pages handed back
+    // to the kernel (madvise) while keeping the mapping (see gc-stacks.c)
+    uint32_t decommitted_stacks[JL_N_STACK_POOLS];
 } jl_thread_heap_t;
 
 // Cache of thread local change to global metadata during GC
@@ -201,6 +222,7 @@ typedef struct {
 } jl_gc_mark_cache_t;
 
 struct _jl_bt_element_t;
+struct _jl_typemap_entry_t;
 
 // This includes all the thread local states we care about for a thread.
 // Changes to TLS field types must be reflected in codegen.
@@ -226,16 +248,26 @@ typedef struct _jl_tls_states_t {
     int8_t in_pure_callback;
     int8_t in_finalizer;
     int8_t disable_gc;
+    // depth of nested compiler arena regions (jl_gc_begin_arena); while
+    // nonzero, automatic collections are deferred to the region exit
+    uint16_t gc_arena_depth;
     // Counter to disable finalizer **on the current thread**
     int finalizers_inhibited;
     jl_thread_heap_t heap; // this is very large, and the offset is baked into codegen
     jl_thread_gc_num_t gc_num;
+    // gc_num.cum_allocd at the moment the current task was switched in
+    int64_t task_alloc_base;
+    // monotonic deadline (jl_hrtime units) past which the next preemption
+    // poll yields the running task back to the scheduler; reset at every
+    // task switch (see jl_task_preempt_reset in task.c)
+    uint64_t preempt_deadline;
     volatile sig_atomic_t defer_signal;
     _Atomic(struct _jl_task_t*) current_task;
     struct _jl_task_t *next_task;
     struct _jl_task_t *previous_task;
     struct _jl_task_t *root_task;
     struct _jl_timing_block_t *timing_stack;
+    struct _jl_timing_trace_ring_t *timing_trace_ring;
     void *stackbase;
     size_t stacksize;
     union {
@@ -250,6 +282,9 @@ typedef struct _jl_tls_states_t {
     size_t bt_size;    // Size for backtrace in transit in bt_data
     // Temporary backtrace buffer used only for allocations profiler.
     struct _jl_bt_element_t *profiling_bt_buffer;
+    // Bytes left until the sampling allocations profiler takes its next
+    // sample (see gc-alloc-profiler.h).
+    size_t alloc_profile_countdown;
     // Atomically set by the sender, reset by the handler.
     volatile _Atomic(sig_atomic_t) signal_request; // TODO: no actual reason for this to be _Atomic
     // Allow the sigint to be raised asynchronously
@@ -270,6 +305,53 @@ typedef struct _jl_tls_states_t {
     // Access via jl_exception_occurred().
     struct _jl_value_t *previous_exception;
 
+    // Thread-local leaf-signature dispatch cache, checked before the shared
+    // `call_cache` in gf.c so that hot dispatch hits never touch a cache line
+    // written by another thread. Entries are scanned as GC roots in gc.c.
+#define JL_TLS_CALL_CACHE_SIZE 256
+    _Atomic(struct _jl_typemap_entry_t*) call_cache[JL_TLS_CALL_CACHE_SIZE];
+    // world each call_cache slot was last validated for: a hit at the same
+    // world can skip the entry's min_world/max_world checks (see gf.c)
+    size_t call_cache_world[JL_TLS_CALL_CACHE_SIZE];
+
+    // Thread-local memoization of recently boxed primitives (see datatype.c).
+    // Boxes of bits values are immutable and compared by their bits, so a
+    // repeated value can be handed the earlier box instead of a fresh
+    // allocation. Entries are scanned as GC roots in gc.c.
+#define JL_TLS_BOX_CACHE_SIZE 64
+    struct _jl_value_t *box_cache[JL_TLS_BOX_CACHE_SIZE];
+    struct _jl_value_t *box_cache_type[JL_TLS_BOX_CACHE_SIZE];
+    uint64_t box_cache_bits[JL_TLS_BOX_CACHE_SIZE];
+
+    // Thread-local cache of recent jl_isa subtype verdicts (see subtype.c).
+    // Keys are the value's concrete datatype and the target type object,
+    // compared by identity; the subtype relation between two type objects
+    // never changes, so entries need no invalidation. Entries are scanned
+    // as GC roots in gc.c so a cached address cannot be recycled under a
+    // live entry.
+#define JL_TLS_ISA_CACHE_SIZE 128
+    struct _jl_value_t *isa_cache_vt[JL_TLS_ISA_CACHE_SIZE];
+    struct _jl_value_t *isa_cache_t[JL_TLS_ISA_CACHE_SIZE];
+    uint8_t isa_cache_ans[JL_TLS_ISA_CACHE_SIZE];
+
+    // Thread-local memoization of opaque closure specialization (see
+    // opaque_closure.c). Callback-heavy code builds a fresh closure per
+    // iteration over the same source method and capture type; the closure
+    // type and resolved entry point depend only on the key fields plus the
+    // world, so a hit skips the type application, specialization lookup and
+    // compilation query. Entries are scanned as GC roots in gc.c.
+#define JL_TLS_OC_CACHE_SIZE 8
+    struct {
+        struct _jl_value_t *source;   // key: the closure's jl_method_t
+        struct _jl_value_t *argt;     // key, compared by identity
+        struct _jl_value_t *captt;    // key: typeof the captures tuple
+        struct _jl_value_t *rt_ub;    // key, compared by identity
+        size_t world;                 // entry is valid only in this world
+        struct _jl_value_t *oc_type;  // resolved OpaqueClosure{argt, rt_ub}
+        struct _jl_value_t *consted;  // non-NULL: constant-return value
+        void *invoke;                 // resolved jl_fptr_args_t entry point
+    } oc_cache[JL_TLS_OC_CACHE_SIZE];
+
     // currently-held locks, to be released when an exception is thrown
     small_arraylist_t locks;
 
@@ -280,6 +362,22 @@ typedef struct _jl_tls_states_t {
         uint64_t sleep_leave;
     )
 
+    // adaptive spin budget (ns) before parking in jl_task_get_next;
+    // 0 means "use the global sleep_threshold" (see partr.c)
+    uint64_t sleep_threshold_cur;
+
+    // wake requests deferred while this thread drains a libuv loop
+    // iteration, flushed as one decision per distinct target
+    // (see jl_wake_batch_begin/jl_wake_batch_end in partr.c)
+#define JL_WAKE_BATCH_TIDS 16
+    struct {
+        int16_t active;    // nesting depth of jl_wake_batch_begin
+        int16_t self;      // saw a request targeting this thread (or -1)
+        int32_t broadcast; // saw multi-queue (-1) requests
+        int32_t ntids;     // distinct foreign targets recorded below
+        int16_t tids[JL_WAKE_BATCH_TIDS];
+    } wake_batch;
+
     // some hidden state (usually just because we don't have the type's size declaration)
 #ifdef LIBRARY_EXPORTS
     uv_mutex_t sleep_lock;
@@ -368,8 +466,11 @@ JL_DLLEXPORT void jl_gc_disable_finalizers_internal(void);
 JL_DLLEXPORT void jl_gc_enable_finalizers_internal(void);
 JL_DLLEXPORT void jl_gc_run_pending_finalizers(struct _jl_task_t *ct);
 extern JL_DLLEXPORT _Atomic(int) jl_gc_have_pending_finalizers;
+extern JL_DLLEXPORT int jl_gc_async_finalizers;
 
 JL_DLLEXPORT void jl_wakeup_thread(int16_t tid);
+JL_DLLEXPORT void jl_wake_batch_begin(void);
+JL_DLLEXPORT void jl_wake_batch_end(void);
 
 #ifdef __cplusplus
 }
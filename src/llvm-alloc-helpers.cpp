@@ -144,6 +144,94 @@ JL_USED_FUNC void AllocUseInfo::dump()
     }
 }
 
+// Scan the uses a callee makes of `arg` to prove that passing it a pointer to
+// a stack allocated (and therefore headerless) object is unobservable. The
+// allowed uses mirror the non-escaping cases of the use walk in
+// `runEscapeAnalysis`, minus anything that could reach the type tag (calls,
+// negative or unknown offset geps) or store a GC reference through the
+// pointer, which would be invisible to the caller's field analysis.
+static bool argUsesAreSafe(const Argument &arg, const DataLayout &DL)
+{
+    SmallVector<const Value*,8> worklist{&arg};
+    SmallPtrSet<const Value*,16> seen{&arg};
+    while (!worklist.empty()) {
+        auto v = worklist.pop_back_val();
+        for (auto &use: v->uses()) {
+            auto inst = dyn_cast<Instruction>(use.getUser());
+            if (!inst)
+                return false;
+            if (isa<LoadInst>(inst) || isa<ICmpInst>(inst))
+                continue;
+            if (auto store = dyn_cast<StoreInst>(inst)) {
+                if (use.getOperandNo() != StoreInst::getPointerOperandIndex())
+                    return false;
+                if (hasObjref(store->getValueOperand()->getType()))
+                    return false;
+                continue;
+            }
+            if (auto gep = dyn_cast<GetElementPtrInst>(inst)) {
+                APInt apoffset(sizeof(void*) * 8, 0, true);
+                if (!gep->accumulateConstantOffset(DL, apoffset) || apoffset.isNegative())
+                    return false;
+            }
+            else if (!isa<BitCastInst>(inst) && !isa<AddrSpaceCastInst>(inst)) {
+                return false;
+            }
+            if (seen.insert(inst).second)
+                worklist.push_back(inst);
+        }
+    }
+    return true;
+}
+
+uint64_t jl_alloc::argEscapeSummary(const Function &F, const JuliaPassContext &pass,
+                                    ArgEscapeSummaryCache &cache)
+{
+    auto lookup = cache.find(&F);
+    if (lookup != cache.end())
+        return lookup->second;
+    uint64_t summary = 0;
+    // Only small leaf callees qualify: a callee that can reach a safepoint may
+    // run a collection while holding the (potentially stack allocated and
+    // headerless) object, and a large body isn't worth scanning repeatedly.
+    bool leaf = !F.isDeclaration() && !F.isInterposable();
+    size_t ninsts = 0;
+    for (auto &bb: F) {
+        if (!leaf)
+            break;
+        for (auto &I: bb) {
+            if (++ninsts > 128) {
+                leaf = false;
+                break;
+            }
+            auto call = dyn_cast<CallBase>(&I);
+            if (!call || isa<IntrinsicInst>(call))
+                continue;
+            auto callee = call->getCalledOperand();
+            if (callee == pass.pgcstack_getter || callee == pass.pointer_from_objref_func ||
+                callee == pass.typeof_func || callee == pass.gc_preserve_begin_func ||
+                callee == pass.gc_preserve_end_func || callee == pass.write_barrier_func ||
+                callee == pass.write_barrier_binding_func)
+                continue;
+            auto cf = call->getCalledFunction();
+            if (cf && cf->getName() == "memcmp")
+                continue;
+            leaf = false;
+            break;
+        }
+    }
+    if (leaf) {
+        auto &DL = F.getParent()->getDataLayout();
+        unsigned nargs = F.arg_size() < 64 ? F.arg_size() : 64;
+        for (unsigned i = 0; i < nargs; i++) {
+            if (argUsesAreSafe(*F.getArg(i), DL))
+                summary |= uint64_t(1) << i;
+        }
+    }
+    cache[&F] = summary;
+    return summary;
+}
+
 void jl_alloc::runEscapeAnalysis(llvm::Instruction *I, EscapeAnalysisRequiredArgs required, EscapeAnalysisOptionalArgs options) {
     required.use_info.reset();
     if (I->use_empty())
@@ -215,6 +303,21 @@ void jl_alloc::runEscapeAnalysis(llvm::Instruction *I, EscapeAnalysisRequiredArg
             // Uses in `jl_roots` operand bundle are not counted as escaping, everything else is.
             if (!call->isBundleOperand(opno) ||
                 call->getOperandBundleForOperand(opno).getTagName() != "jl_roots") {
+                if (options.callee_summaries && call->isArgOperand(use) && opno < 64) {
+                    if (auto callee_f = call->getCalledFunction()) {
+                        if ((argEscapeSummary(*callee_f, required.pass,
+                                              *options.callee_summaries) >> opno) & 1) {
+                            // The callee is a leaf function that cannot capture the
+                            // pointer, look at the type tag or trigger a collection,
+                            // so this is no worse than handing out the raw address
+                            // for the duration of the call.
+                            required.use_info.addrescaped = true;
+                            required.use_info.hasload = true;
+                            required.use_info.hasunknownmem = true;
+                            return true;
+                        }
+                    }
+                }
                 if (isa<UnreachableInst>(call->getParent()->getTerminator())) {
                     required.use_info.haserror = true;
                     return true;
@@ -4,6 +4,7 @@
 #define LLVM_ALLOC_HELPERS_H
 #include <llvm-c/Types.h>
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/SmallSet.h>
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/Instructions.h>
@@ -117,6 +118,18 @@ namespace jl_alloc {
         }
     };
 
+    // Cache of per-argument escape summaries for callees defined in the current
+    // module. Bit `i` of a summary is set when passing an object (or a pointer
+    // derived from it) as argument `i` cannot cause the object to escape, have
+    // its type tag inspected or become reachable by the GC: the callee must be
+    // a small leaf function (it cannot reach a safepoint) whose only uses of
+    // the argument are loads, stores of non-reference values through it,
+    // forward constant offset geps, casts and pointer comparisons.
+    typedef llvm::SmallDenseMap<const llvm::Function*,uint64_t,8> ArgEscapeSummaryCache;
+
+    uint64_t argEscapeSummary(const llvm::Function &F, const JuliaPassContext &pass,
+                              ArgEscapeSummaryCache &cache);
+
     struct EscapeAnalysisRequiredArgs {
         AllocUseInfo &use_info; // The returned escape analysis data
         CheckInst::Stack &check_stack; // A preallocated stack to be used for escape analysis
@@ -129,6 +142,10 @@ namespace jl_alloc {
         //will not be considered. Defaults to nullptr, which means all uses of the allocation
         //are considered
         const llvm::SmallPtrSetImpl<const llvm::BasicBlock*> *valid_set;
+        //Cache of callee argument escape summaries. When set, passing the allocation
+        //to a callee argument that its summary marks as safe is treated like handing
+        //out the raw address (stack allocatable) instead of a true escape.
+        ArgEscapeSummaryCache *callee_summaries = nullptr;
 
         EscapeAnalysisOptionalArgs() = default;
 
@@ -136,6 +153,11 @@ namespace jl_alloc {
             this->valid_set = valid_set;
             return *this;
         }
+
+        EscapeAnalysisOptionalArgs &with_callee_summaries(decltype(callee_summaries) callee_summaries) {
+            this->callee_summaries = callee_summaries;
+            return *this;
+        }
     };
 
     void runEscapeAnalysis(llvm::Instruction *I, EscapeAnalysisRequiredArgs required, EscapeAnalysisOptionalArgs options=EscapeAnalysisOptionalArgs());
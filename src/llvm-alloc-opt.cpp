@@ -86,6 +86,10 @@ static void removeGCPreserve(CallInst *call, Instruction *val)
  *
  *     The results of these cast instructions will be scanned recursively.
  *
+ * * call arguments whose callee is a small leaf function defined in this
+ *   module whose escape summary (see `jl_alloc::argEscapeSummary`) proves
+ *   the argument cannot be captured, type-queried or reached by the GC
+ *
  * All other uses are considered to escape conservatively.
  */
 
@@ -104,6 +108,10 @@ struct AllocOpt : public JuliaPassContext {
     Function *lifetime_start;
     Function *lifetime_end;
 
+    // Per-argument escape summaries for callees defined in this module,
+    // computed lazily by the escape analysis.
+    jl_alloc::ArgEscapeSummaryCache arg_escapes;
+
     bool doInitialization(Module &m);
     bool runOnFunction(Function &F, function_ref<DominatorTree&()> GetDT);
 };
@@ -321,7 +329,8 @@ ssize_t Optimizer::getGCAllocSize(Instruction *I)
 void Optimizer::checkInst(Instruction *I)
 {
     jl_alloc::EscapeAnalysisRequiredArgs required{use_info, check_stack, pass, *pass.DL};
-    jl_alloc::runEscapeAnalysis(I, required);
+    jl_alloc::runEscapeAnalysis(I, required, jl_alloc::EscapeAnalysisOptionalArgs().with_callee_summaries(
+                                    &pass.arg_escapes));
 }
 
 void Optimizer::insertLifetimeEnd(Value *ptr, Constant *sz, Instruction *insert)
@@ -668,6 +677,25 @@ void Optimizer::moveToStack(CallInst *orig_inst, size_t sz, bool has_ref)
                     return;
                 }
             }
+            if (auto callee_f = call->getCalledFunction()) {
+                // Argument uses admitted by a callee escape summary: the callee
+                // only needs the address of the (now stack allocated) object.
+                uint64_t summary = jl_alloc::argEscapeSummary(*callee_f, pass, pass.arg_escapes);
+                Instruction *arg_cast = nullptr;
+                for (unsigned i = 0; i < call->arg_size() && i < 64; i++) {
+                    if (call->getArgOperand(i) == orig_i && (summary >> i) & 1) {
+                        if (!arg_cast) {
+                            arg_cast = new AddrSpaceCastInst(new_i, orig_i->getType(), "", call);
+                            arg_cast->setDebugLoc(call->getDebugLoc());
+                        }
+                        call->setArgOperand(i, arg_cast);
+                    }
+                }
+                // Any remaining uses (e.g. in operand bundles) fall through to
+                // the replacement below on the next iteration.
+                if (arg_cast)
+                    return;
+            }
             // remove from operand bundle
             Value *replace = has_ref ? (Value*)buff : Constant::getNullValue(orig_i->getType());
             user->replaceUsesOfWith(orig_i, replace);
@@ -1160,6 +1188,7 @@ cleanup:
 bool AllocOpt::doInitialization(Module &M)
 {
     initAll(M);
+    arg_escapes.clear();
     if (!alloc_obj_func)
         return false;
 
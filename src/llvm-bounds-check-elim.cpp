@@ -0,0 +1,167 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+#include "llvm-version.h"
+#include "passes.h"
+
+#include <llvm-c/Core.h>
+#include <llvm-c/Types.h>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/Statistic.h>
+#include <llvm/Analysis/ScalarEvolution.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/PassManager.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Pass.h>
+#include <llvm/Support/Debug.h>
+
+#include "julia.h"
+#include "julia_assert.h"
+
+#define DEBUG_TYPE "bounds_check_elim"
+#undef DEBUG
+
+using namespace llvm;
+
+STATISTIC(EliminatedBoundsChecks, "Number of bounds checks proven redundant");
+
+/**
+ * Eliminate bounds checks that are subsumed by an earlier check against the
+ * same (or a smaller) length.
+ *
+ * `emit_bounds_check` emits `icmp ult %i, %len` with a branch to an error
+ * block that reports the failure and is terminated by `unreachable`. After
+ * inlining, chains of views and multiple accesses into the same array leave
+ * several such checks against lengths that CSE has folded to the same value,
+ * but with different (often constant-offset) indices, which the stock passes
+ * only remove when the comparisons are literally identical. Here we use
+ * ScalarEvolution to fold a check whenever some check that dominates it
+ * already established a harder fact: an index at least as large tested
+ * against a length no larger. The branch condition is replaced by `true` and
+ * the dead error block is left for the subsequent CFG cleanups.
+ *
+ * Checks are never reordered or hoisted, so the BoundsError that a program
+ * observes (and any side effects before it) are unchanged.
+ */
+
+namespace {
+
+// Recognize the error successor emitted by emit_bounds_check: a block that
+// calls one of the jl_bounds_error entrypoints and does not return.
+static bool isBoundsErrorBlock(BasicBlock *BB)
+{
+    if (!isa<UnreachableInst>(BB->getTerminator()))
+        return false;
+    for (auto &I: *BB) {
+        if (auto CI = dyn_cast<CallBase>(&I)) {
+            if (auto callee = CI->getCalledFunction()) {
+                if (callee->getName().contains("jl_bounds_error"))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+struct BoundsCheck {
+    BranchInst *Br;
+    Value *Idx;
+    Value *Len;
+};
+
+static bool eliminateBoundsChecks(Function &F, DominatorTree &DT, ScalarEvolution &SE)
+{
+    SmallVector<BoundsCheck, 16> Checks;
+    for (auto &BB: F) {
+        auto Br = dyn_cast<BranchInst>(BB.getTerminator());
+        if (!Br || !Br->isConditional())
+            continue;
+        auto Cmp = dyn_cast<ICmpInst>(Br->getCondition());
+        if (!Cmp || !Cmp->hasOneUse() || Cmp->getPredicate() != ICmpInst::ICMP_ULT)
+            continue;
+        if (!isBoundsErrorBlock(Br->getSuccessor(1)) ||
+            isBoundsErrorBlock(Br->getSuccessor(0)))
+            continue;
+        if (!SE.isSCEVable(Cmp->getOperand(0)->getType()))
+            continue;
+        Checks.push_back({Br, Cmp->getOperand(0), Cmp->getOperand(1)});
+    }
+    if (Checks.size() < 2)
+        return false;
+    bool Changed = false;
+    for (auto &C: Checks) {
+        auto IdxC = SE.getSCEV(C.Idx);
+        auto LenC = SE.getSCEV(C.Len);
+        for (auto &D: Checks) {
+            if (D.Br == C.Br || D.Idx->getType() != C.Idx->getType())
+                continue;
+            // The earlier check must have passed on every path to this one.
+            BasicBlockEdge PassEdge(D.Br->getParent(), D.Br->getSuccessor(0));
+            if (!DT.dominates(PassEdge, C.Br->getParent()))
+                continue;
+            // D passing established `D.Idx <u D.Len`, which implies
+            // `C.Idx <u C.Len` when `C.Idx <=u D.Idx` and `D.Len <=u C.Len`.
+            if (!SE.isKnownPredicate(ICmpInst::ICMP_ULE, IdxC, SE.getSCEV(D.Idx)))
+                continue;
+            if (!SE.isKnownPredicate(ICmpInst::ICMP_ULE, SE.getSCEV(D.Len), LenC))
+                continue;
+            C.Br->setCondition(ConstantInt::getTrue(F.getContext()));
+            ++EliminatedBoundsChecks;
+            Changed = true;
+            break;
+        }
+    }
+    assert(!verifyFunction(F, &errs()));
+    return Changed;
+}
+
+} // namespace
+
+PreservedAnalyses BoundsCheckElimPass::run(Function &F, FunctionAnalysisManager &AM)
+{
+    auto &DT = AM.getResult<DominatorTreeAnalysis>(F);
+    auto &SE = AM.getResult<ScalarEvolutionAnalysis>(F);
+    if (eliminateBoundsChecks(F, DT, SE)) {
+        return PreservedAnalyses::allInSet<CFGAnalyses>();
+    }
+    return PreservedAnalyses::all();
+}
+
+struct BoundsCheckElimLegacy : public FunctionPass {
+    static char ID;
+    BoundsCheckElimLegacy() : FunctionPass(ID)
+    {}
+
+private:
+    bool runOnFunction(Function &F) override {
+        auto &DT = getAnalysis<DominatorTreeWrapperPass>().getDomTree();
+        auto &SE = getAnalysis<ScalarEvolutionWrapperPass>().getSE();
+        return eliminateBoundsChecks(F, DT, SE);
+    }
+
+    void getAnalysisUsage(AnalysisUsage &AU) const override {
+        AU.addRequired<DominatorTreeWrapperPass>();
+        AU.addRequired<ScalarEvolutionWrapperPass>();
+        AU.setPreservesCFG();
+        FunctionPass::getAnalysisUsage(AU);
+    }
+};
+
+char BoundsCheckElimLegacy::ID = 0;
+static RegisterPass<BoundsCheckElimLegacy> X("BoundsCheckElim", "Eliminate dominated bounds checks",
+                                     false /* Only looks at CFG */,
+                                     false /* Analysis Pass */);
+
+Pass *createBoundsCheckElimPass()
+{
+    return new BoundsCheckElimLegacy();
+}
+
+extern "C" JL_DLLEXPORT void LLVMExtraAddBoundsCheckElimPass_impl(LLVMPassManagerRef PM)
+{
+    unwrap(PM)->add(createBoundsCheckElimPass());
+}
@@ -15,6 +15,7 @@
 #include "codegen_shared.h"
 #include "julia.h"
 #include "julia_internal.h"
+#include "gc.h"
 #include "llvm-pass-helpers.h"
 
 #define DEBUG_TYPE "final_gc_lowering"
@@ -57,6 +58,10 @@ private:
     // Lowers a `julia.gc_alloc_bytes` intrinsic.
     Value *lowerGCAllocBytes(CallInst *target, Function &F);
 
+    // Emits the pool-allocation fast path inline for a `julia.gc_alloc_bytes`
+    // intrinsic whose size maps to a GC pool.
+    Value *lowerGCAllocBytesInlinePool(CallInst *target, Function &F, Value *ptls, int offset, int osize);
+
     // Lowers a `julia.queue_gc_root` intrinsic.
     Value *lowerQueueGCRoot(CallInst *target, Function &F);
 
@@ -203,15 +208,138 @@ Value *FinalLowerGC::lowerGCAllocBytes(CallInst *target, Function &F)
             { ptls, ConstantInt::get(getSizeTy(F.getContext()), sz + sizeof(void*)) });
     }
     else {
+#if defined(MEMDEBUG) || defined(GC_DEBUG_ENV)
+        // MEMDEBUG turns every pool allocation into a big allocation inside
+        // `jl_gc_pool_alloc` and GC_DEBUG_ENV makes `maybe_collect` consult
+        // the debug configuration, so keep the runtime call for debug builds.
         auto pool_offs = ConstantInt::get(Type::getInt32Ty(F.getContext()), offset);
         auto pool_osize = ConstantInt::get(Type::getInt32Ty(F.getContext()), osize);
         newI = builder.CreateCall(poolAllocFunc, { ptls, pool_offs, pool_osize });
+#else
+        return lowerGCAllocBytesInlinePool(target, F, ptls, offset, osize);
+#endif
     }
     newI->setAttributes(newI->getCalledFunction()->getAttributes());
     newI->takeName(target);
     return newI;
 }
 
+// Expands a pool allocation to the fast path of `jl_gc_pool_alloc_inner`
+// inline: pop the head of the pool's freelist and bump the thread-local
+// allocation counters, with `jl_gc_pool_alloc` as the out-of-line fallback.
+// Every case the runtime handles specially -- an empty freelist, a freelist
+// that crosses onto a new page (the page metadata must be updated), a
+// collection being due, or the allocation profiler running -- branches to the
+// ordinary call instead, so the slow path commits nothing before re-checking.
+Value *FinalLowerGC::lowerGCAllocBytesInlinePool(CallInst *target, Function &F, Value *ptls, int offset, int osize)
+{
+    auto &ctx = F.getContext();
+    auto T_size = getSizeTy(ctx);
+    auto T_int8 = Type::getInt8Ty(ctx);
+    auto T_int32 = Type::getInt32Ty(ctx);
+    auto T_int64 = Type::getInt64Ty(ctx);
+    auto T_pint8 = Type::getInt8PtrTy(ctx);
+    auto T_ppint8 = PointerType::get(T_pint8, 0);
+    auto T_psize = PointerType::get(T_size, 0);
+    auto ptrAlign = Align(sizeof(void*));
+
+    BasicBlock *checkBB = target->getParent();
+    BasicBlock *contBB = checkBB->splitBasicBlock(target, "alloc.cont");
+    BasicBlock *popBB = BasicBlock::Create(ctx, "alloc.pool.pop", &F, contBB);
+    BasicBlock *fastBB = BasicBlock::Create(ctx, "alloc.pool.fast", &F, contBB);
+    BasicBlock *slowBB = BasicBlock::Create(ctx, "alloc.pool.slow", &F, contBB);
+    // splitBasicBlock ends checkBB with a branch to contBB; we emit our own
+    checkBB->getTerminator()->eraseFromParent();
+
+    IRBuilder<> builder(checkBB);
+    builder.SetCurrentDebugLocation(target->getDebugLoc());
+
+    // `maybe_collect` only runs a collection when gc_num.allocd >= 0
+    Value *allocdPtr = builder.CreateBitCast(
+        builder.CreateConstInBoundsGEP1_32(T_int8, ptls,
+            offsetof(jl_tls_states_t, gc_num) + offsetof(jl_thread_gc_num_t, allocd)),
+        PointerType::get(T_int64, 0));
+    LoadInst *allocd = builder.CreateAlignedLoad(T_int64, allocdPtr, Align(8));
+    allocd->setOrdering(AtomicOrdering::Monotonic);
+    Value *collectDue = builder.CreateICmpSGE(allocd, ConstantInt::get(T_int64, 0));
+
+    // the profiler records every allocation inside `jl_gc_pool_alloc`
+    Module *M = F.getParent();
+    GlobalVariable *profEnabled = M->getGlobalVariable("g_alloc_profile_enabled");
+    if (!profEnabled)
+        profEnabled = new GlobalVariable(*M, T_int32, false, GlobalValue::ExternalLinkage,
+                                         nullptr, "g_alloc_profile_enabled");
+    Value *profiling = builder.CreateICmpNE(
+        builder.CreateAlignedLoad(T_int32, profEnabled, Align(sizeof(int))),
+        ConstantInt::get(T_int32, 0));
+
+    Value *pfl = builder.CreateBitCast(
+        builder.CreateConstInBoundsGEP1_32(T_int8, ptls,
+            offset + offsetof(jl_gc_pool_t, freelist)),
+        T_ppint8);
+    LoadInst *v = builder.CreateAlignedLoad(T_pint8, pfl, ptrAlign);
+    Value *empty = builder.CreateIsNull(v);
+    builder.CreateCondBr(
+        builder.CreateOr(builder.CreateOr(collectDue, profiling), empty),
+        slowBB, popBB);
+
+    builder.SetInsertPoint(popBB);
+    LoadInst *next = builder.CreateAlignedLoad(
+        T_pint8, builder.CreateBitCast(v, T_ppint8), ptrAlign);
+    // when the freelist crosses onto a new page the runtime also updates the
+    // page metadata, so only pop inline while both ends stay on one page
+    Value *pagediff = builder.CreateAnd(
+        builder.CreateXor(builder.CreatePtrToInt(v, T_size),
+                          builder.CreatePtrToInt(next, T_size)),
+        ConstantInt::get(T_size, ~(size_t)(GC_PAGE_SZ - 1)));
+    builder.CreateCondBr(builder.CreateIsNull(pagediff), fastBB, slowBB);
+
+    builder.SetInsertPoint(fastBB);
+    // `jl_gc_safepoint_(ptls)`, as `maybe_collect` does when not collecting
+    Value *safepointPtr = builder.CreateBitCast(
+        builder.CreateConstInBoundsGEP1_32(T_int8, ptls,
+            offsetof(jl_tls_states_t, safepoint)),
+        PointerType::get(T_psize, 0));
+    Value *safepointPage = builder.CreateAlignedLoad(T_psize, safepointPtr, ptrAlign);
+    builder.CreateFence(AtomicOrdering::SequentiallyConsistent, SyncScope::SingleThread);
+    builder.CreateAlignedLoad(T_size, safepointPage, ptrAlign, true /* volatile */);
+    builder.CreateFence(AtomicOrdering::SequentiallyConsistent, SyncScope::SingleThread);
+    // gc_num.allocd += osize; gc_num.poolalloc += 1 (both relaxed)
+    StoreInst *store = builder.CreateAlignedStore(
+        builder.CreateAdd(allocd, ConstantInt::get(T_int64, osize)), allocdPtr, Align(8));
+    store->setOrdering(AtomicOrdering::Monotonic);
+    Value *poolallocPtr = builder.CreateBitCast(
+        builder.CreateConstInBoundsGEP1_32(T_int8, ptls,
+            offsetof(jl_tls_states_t, gc_num) + offsetof(jl_thread_gc_num_t, poolalloc)),
+        PointerType::get(T_int64, 0));
+    LoadInst *poolalloc = builder.CreateAlignedLoad(T_int64, poolallocPtr, Align(8));
+    poolalloc->setOrdering(AtomicOrdering::Monotonic);
+    store = builder.CreateAlignedStore(
+        builder.CreateAdd(poolalloc, ConstantInt::get(T_int64, 1)), poolallocPtr, Align(8));
+    store->setOrdering(AtomicOrdering::Monotonic);
+    builder.CreateAlignedStore(next, pfl, ptrAlign);
+    // jl_valueof(v)
+    Value *fastVal = builder.CreateAddrSpaceCast(
+        builder.CreateBitCast(
+            builder.CreateConstInBoundsGEP1_32(T_int8, v, sizeof(jl_taggedvalue_t)),
+            JuliaType::get_pjlvalue_ty(ctx)),
+        T_prjlvalue);
+    builder.CreateBr(contBB);
+
+    builder.SetInsertPoint(slowBB);
+    CallInst *slowCall = builder.CreateCall(poolAllocFunc,
+        { ptls, ConstantInt::get(T_int32, offset), ConstantInt::get(T_int32, osize) });
+    slowCall->setAttributes(poolAllocFunc->getAttributes());
+    builder.CreateBr(contBB);
+
+    builder.SetInsertPoint(contBB, contBB->begin());
+    PHINode *phi = builder.CreatePHI(T_prjlvalue, 2);
+    phi->addIncoming(fastVal, fastBB);
+    phi->addIncoming(slowCall, slowBB);
+    phi->takeName(target);
+    return phi;
+}
+
 bool FinalLowerGC::doInitialization(Module &M) {
     // Initialize platform-agnostic references.
     initAll(M);
@@ -269,18 +397,13 @@ bool FinalLowerGC::doFinalization(Module &M)
     return true;
 }
 
-template<typename TIterator>
 static void replaceInstruction(
     Instruction *oldInstruction,
-    Value *newInstruction,
-    TIterator &it)
+    Value *newInstruction)
 {
     if (newInstruction != oldInstruction) {
         oldInstruction->replaceAllUsesWith(newInstruction);
-        it = oldInstruction->eraseFromParent();
-    }
-    else {
-        ++it;
+        oldInstruction->eraseFromParent();
     }
 }
 
@@ -306,43 +429,50 @@ bool FinalLowerGC::runOnFunction(Function &F)
     auto queueGCRootFunc = getOrNull(jl_intrinsics::queueGCRoot);
     auto queueGCBindingFunc = getOrNull(jl_intrinsics::queueGCBinding);
 
-    // Lower all calls to supported intrinsics.
+    // Collect all calls to supported intrinsics up front: lowering an
+    // allocation splits its basic block, which an in-place instruction
+    // walk would not survive.
+    SmallVector<CallInst*, 16> worklist;
     for (BasicBlock &BB : F) {
-        for (auto it = BB.begin(); it != BB.end();) {
-            auto *CI = dyn_cast<CallInst>(&*it);
-            if (!CI) {
-                ++it;
+        for (Instruction &I : BB) {
+            auto *CI = dyn_cast<CallInst>(&I);
+            if (!CI)
                 continue;
-            }
-
             Value *callee = CI->getCalledOperand();
+            if (callee == newGCFrameFunc || callee == pushGCFrameFunc ||
+                callee == popGCFrameFunc || callee == getGCFrameSlotFunc ||
+                callee == GCAllocBytesFunc || callee == queueGCRootFunc ||
+                callee == queueGCBindingFunc)
+                worklist.push_back(CI);
+        }
+    }
+
+    // Lower them.
+    for (CallInst *CI : worklist) {
+        Value *callee = CI->getCalledOperand();
 
-            if (callee == newGCFrameFunc) {
-                replaceInstruction(CI, lowerNewGCFrame(CI, F), it);
-            }
-            else if (callee == pushGCFrameFunc) {
-                lowerPushGCFrame(CI, F);
-                it = CI->eraseFromParent();
-            }
-            else if (callee == popGCFrameFunc) {
-                lowerPopGCFrame(CI, F);
-                it = CI->eraseFromParent();
-            }
-            else if (callee == getGCFrameSlotFunc) {
-                replaceInstruction(CI, lowerGetGCFrameSlot(CI, F), it);
-            }
-            else if (callee == GCAllocBytesFunc) {
-                replaceInstruction(CI, lowerGCAllocBytes(CI, F), it);
-            }
-            else if (callee == queueGCRootFunc) {
-                replaceInstruction(CI, lowerQueueGCRoot(CI, F), it);
-            }
-            else if (callee == queueGCBindingFunc) {
-                replaceInstruction(CI, lowerQueueGCBinding(CI, F), it);
-            }
-            else {
-                ++it;
-            }
+        if (callee == newGCFrameFunc) {
+            replaceInstruction(CI, lowerNewGCFrame(CI, F));
+        }
+        else if (callee == pushGCFrameFunc) {
+            lowerPushGCFrame(CI, F);
+            CI->eraseFromParent();
+        }
+        else if (callee == popGCFrameFunc) {
+            lowerPopGCFrame(CI, F);
+            CI->eraseFromParent();
+        }
+        else if (callee == getGCFrameSlotFunc) {
+            replaceInstruction(CI, lowerGetGCFrameSlot(CI, F));
+        }
+        else if (callee == GCAllocBytesFunc) {
+            replaceInstruction(CI, lowerGCAllocBytes(CI, F));
+        }
+        else if (callee == queueGCRootFunc) {
+            replaceInstruction(CI, lowerQueueGCRoot(CI, F));
+        }
+        else if (callee == queueGCBindingFunc) {
+            replaceInstruction(CI, lowerQueueGCBinding(CI, F));
         }
     }
 
@@ -391,7 +521,8 @@ PreservedAnalyses FinalLowerGCPass::run(Module &M, ModuleAnalysisManager &AM)
     }
     modified |= finalLowerGC.doFinalization(M);
     if (modified) {
-        return PreservedAnalyses::allInSet<CFGAnalyses>();
+        // the inline pool-allocation fast path splits basic blocks
+        return PreservedAnalyses::none();
     }
     return PreservedAnalyses::all();
 }
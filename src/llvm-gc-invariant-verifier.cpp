@@ -162,13 +162,16 @@ void GCInvariantVerifier::visitGetElementPtrInst(GetElementPtrInst &GEP) {
 void GCInvariantVerifier::visitCallInst(CallInst &CI) {
     Function *Callee = CI.getCalledFunction();
     if (Callee && (Callee->getName() == "julia.call" ||
-                   Callee->getName() == "julia.call2")) {
-        bool First = true;
+                   Callee->getName() == "julia.call2" ||
+                   Callee->getName() == "julia.call3")) {
+        // julia.call3 passes an untracked cache-slot pointer ahead of %f
+        unsigned NUntracked = Callee->getName() == "julia.call3" ? 2 : 1;
+        unsigned Idx = 0;
         for (Value *Arg : CI.args()) {
             Type *Ty = Arg->getType();
-            Check(Ty->isPointerTy() && cast<PointerType>(Ty)->getAddressSpace() == (First ? 0 : AddressSpace::Tracked),
+            Check(Ty->isPointerTy() && cast<PointerType>(Ty)->getAddressSpace() == (Idx < NUntracked ? 0 : AddressSpace::Tracked),
                 "Invalid derived pointer in jlcall", &CI);
-            First = false;
+            Idx++;
         }
     }
 }
@@ -11,6 +11,7 @@
 #include <llvm/ADT/SetVector.h>
 #include <llvm/ADT/SmallVector.h>
 #include "llvm/Analysis/CFG.h"
+#include <llvm/Analysis/ValueTracking.h>
 #include <llvm/IR/Value.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Dominators.h>
@@ -359,6 +360,7 @@ private:
     void PlaceGCFrameStores(State &S, unsigned MinColorRoot, const std::vector<int> &Colors, Value *GCFrame);
     void PlaceRootsAndUpdateCalls(std::vector<int> &Colors, State &S, std::map<Value *, std::pair<int, int>>);
     bool CleanupIR(Function &F, State *S, bool *CFGModified);
+    bool ElideWriteBarriers(Function &F);
     void NoteUseChain(State &S, BBState &BBS, User *TheUser);
     SmallVector<int, 1> GetPHIRefinements(PHINode *phi, State &S);
     void FixUpRefinements(ArrayRef<int> PHINumbers, State &S);
@@ -384,6 +386,20 @@ static bool isSpecialPtr(Type *Ty) {
     return AddressSpace::FirstSpecial <= AS && AS <= AddressSpace::LastSpecial;
 }
 
+// Check for a cast of a raw stack slot into the tracked addrspace. These are
+// emitted by alloc-opt when it stack allocates an object that is passed to a
+// callee whose escape summary proved the argument harmless. The result is not
+// a GC-managed object: it must never be assigned a GC frame slot since the
+// collector would try to scan it as one.
+static bool isStackTrackedCast(Value *V) {
+    auto ASCI = dyn_cast<AddrSpaceCastInst>(V);
+    if (!ASCI || getValueAddrSpace(ASCI->getPointerOperand()) != 0)
+        return false;
+    // MaxLookup=0 means no limit; missing a stack object here would hand the
+    // collector a pointer without an object header.
+    return isa<AllocaInst>(getUnderlyingObject(ASCI->getPointerOperand(), 0));
+}
+
 // return how many Special pointers are in T (count > 0),
 // and if there is anything else in T (all == false)
 CountTrackedPointers::CountTrackedPointers(Type *T) {
@@ -783,7 +799,8 @@ int LateLowerGCFrame::NumberBase(State &S, Value *CurrentV)
         // Perm rooted
         Number = -2;
     } else if (isa<Argument>(CurrentV) || isa<AllocaInst>(CurrentV) ||
-            (isa<AddrSpaceCastInst>(CurrentV) && !isTrackedValue(CurrentV))) {
+            (isa<AddrSpaceCastInst>(CurrentV) && !isTrackedValue(CurrentV)) ||
+            isStackTrackedCast(CurrentV)) {
         // We know this is rooted in the parent
         // future note: we could chose to exclude argument of type CalleeRooted here
         Number = -1;
@@ -844,7 +861,8 @@ std::vector<int> LateLowerGCFrame::NumberAllBase(State &S, Value *CurrentV) {
     if (tracked.count == 0)
         return Numbers;
     if (isa<Constant>(CurrentV) || isa<AllocaInst>(CurrentV) || isa<Argument>(CurrentV) ||
-            (isa<AddrSpaceCastInst>(CurrentV) && !isTrackedValue(CurrentV))) {
+            (isa<AddrSpaceCastInst>(CurrentV) && !isTrackedValue(CurrentV)) ||
+            isStackTrackedCast(CurrentV)) {
         Numbers.resize(tracked.count, -1);
     }
     else if (auto *SVI = dyn_cast<ShuffleVectorInst>(CurrentV)) {
@@ -1689,7 +1707,7 @@ State LateLowerGCFrame::LocalScan(Function &F) {
             } else if (isa<ReturnInst>(&I)) {
                 NoteOperandUses(S, BBS, I);
             } else if (auto *ASCI = dyn_cast<AddrSpaceCastInst>(&I)) {
-                if (isTrackedValue(ASCI)) {
+                if (isTrackedValue(ASCI) && !isStackTrackedCast(ASCI)) {
                     SmallVector<int, 1> RefinedPtr{};
                     bool task_local = false;
                     auto origin = ASCI->getPointerOperand()->stripPointerCasts();
@@ -2236,6 +2254,184 @@ MDNode *createMutableTBAAAccessTag(MDNode *Tag) {
     return MDBuilder(Tag->getContext()).createMutableTBAAAccessTag(Tag);
 }
 
+// Remove and coalesce write barriers that can never trigger.
+//
+// The lowered barrier checks for an old-and-marked (bits.gc == 3) parent, and
+// an object can only become old-and-marked inside a collection, i.e. at a
+// safepoint. A freshly allocated object starts out young, so barriers whose
+// parent is an allocation with no intervening safepoint are deleted outright;
+// this is computed as a forward must-analysis over the CFG.
+//
+// Additionally, two barriers on the same parent with no safepoint and no
+// control flow between them observe the same mark bits on the parent and the
+// children, so they are merged into a single (multi-child) barrier at the
+// later point. Merely deleting the later one would not be correct: a barrier
+// that finds all of its children marked does not queue the parent, which then
+// remains old-and-marked for the next store.
+bool LateLowerGCFrame::ElideWriteBarriers(Function &F)
+{
+    if (!write_barrier_func && !write_barrier_binding_func)
+        return false;
+    bool any_barrier = false;
+    for (auto &BB: F) {
+        for (auto &I: BB) {
+            auto CI = dyn_cast<CallInst>(&I);
+            if (CI && (CI->getCalledOperand() == write_barrier_func ||
+                       CI->getCalledOperand() == write_barrier_binding_func)) {
+                any_barrier = true;
+                break;
+            }
+        }
+        if (any_barrier)
+            break;
+    }
+    if (!any_barrier)
+        return false;
+    auto isSafepoint = [this] (Instruction &I) {
+        auto CI = dyn_cast<CallBase>(&I);
+        if (!CI)
+            return false;
+        // Intrinsics are never safepoints.
+        if (isa<IntrinsicInst>(CI))
+            return false;
+        if (auto callee = CI->getCalledFunction()) {
+            // Known functions emitted in codegen that are not safepoints
+            if (callee == pgcstack_getter || callee == pointer_from_objref_func ||
+                callee == gc_preserve_begin_func || callee == gc_preserve_end_func ||
+                callee == typeof_func || callee == write_barrier_func ||
+                callee == write_barrier_binding_func || callee->getName() == "memcmp")
+                return false;
+        }
+        if (CI->hasFnAttr(Attribute::ReadNone) || CI->hasFnAttr(Attribute::ReadOnly) ||
+            CI->hasFnAttr(Attribute::ArgMemOnly))
+            return false;
+        return true;
+    };
+    // Apply the block transfer function to the set of objects allocated since
+    // the last safepoint, collecting deletable barriers when `dead` is set.
+    auto transfer = [&] (BasicBlock *BB, SmallPtrSet<Value*,8> &fresh,
+                         SmallVectorImpl<CallInst*> *dead) {
+        for (auto &I: *BB) {
+            auto CI = dyn_cast<CallBase>(&I);
+            if (!CI)
+                continue;
+            auto callee = CI->getCalledOperand();
+            if (callee == write_barrier_func || callee == write_barrier_binding_func) {
+                if (dead && fresh.count(CI->getArgOperand(0)->stripPointerCasts()))
+                    dead->push_back(cast<CallInst>(CI));
+                continue;
+            }
+            if (isSafepoint(I))
+                fresh.clear();
+            // The allocation is itself a safepoint, but its result is fresh.
+            if (callee == alloc_obj_func)
+                fresh.insert(CI);
+        }
+    };
+    // The in-state is the intersection of the predecessors' out-states;
+    // not-yet-computed predecessors (back edges) are optimistically ignored
+    // and refined on later rounds, so the sets shrink monotonically.
+    DenseMap<BasicBlock*, SmallPtrSet<Value*,8>> outs;
+    auto computeIn = [&] (BasicBlock *BB, SmallPtrSet<Value*,8> &fresh) {
+        bool first = true;
+        for (auto pred: predecessors(BB)) {
+            auto it = outs.find(pred);
+            if (it == outs.end())
+                continue;
+            if (first) {
+                fresh = it->second;
+                first = false;
+            }
+            else {
+                SmallVector<Value*,8> stale;
+                for (auto v: fresh) {
+                    if (!it->second.count(v))
+                        stale.push_back(v);
+                }
+                for (auto v: stale)
+                    fresh.erase(v);
+            }
+        }
+    };
+    ReversePostOrderTraversal<Function*> RPOT(&F);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (BasicBlock *BB: RPOT) {
+            SmallPtrSet<Value*,8> fresh;
+            computeIn(BB, fresh);
+            transfer(BB, fresh, nullptr);
+            auto it = outs.find(BB);
+            bool same = it != outs.end() && it->second.size() == fresh.size();
+            if (same) {
+                for (auto v: fresh) {
+                    if (!it->second.count(v)) {
+                        same = false;
+                        break;
+                    }
+                }
+            }
+            if (!same) {
+                outs[BB] = std::move(fresh);
+                changed = true;
+            }
+        }
+    }
+    SmallVector<CallInst*, 16> dead;
+    for (BasicBlock *BB: RPOT) {
+        SmallPtrSet<Value*,8> fresh;
+        computeIn(BB, fresh);
+        transfer(BB, fresh, &dead);
+    }
+    bool Changed = !dead.empty();
+    for (auto CI: dead)
+        CI->eraseFromParent();
+    // Coalesce the remaining barriers within each block: a barrier executes
+    // whenever an earlier barrier in the same block does unless something in
+    // between can unwind, and anything that can unwind is a call and thus
+    // treated as a safepoint here.
+    for (auto &BB: F) {
+        // Pending barrier per (callee, parent) since the last safepoint.
+        SmallDenseMap<std::pair<Value*,Value*>, CallInst*, 4> pending;
+        for (auto it = BB.begin(); it != BB.end();) {
+            Instruction &I = *it;
+            ++it;
+            auto CI = dyn_cast<CallInst>(&I);
+            if (!CI)
+                continue;
+            auto callee = CI->getCalledOperand();
+            if (callee == write_barrier_func || callee == write_barrier_binding_func) {
+                auto key = std::make_pair(callee, CI->getArgOperand(0)->stripPointerCasts());
+                auto &prev = pending[key];
+                if (prev && cast<Function>(callee)->isVarArg()) {
+                    SmallVector<Value*, 4> args(CI->args());
+                    SmallPtrSet<Value*, 4> children(args.begin() + 1, args.end());
+                    for (unsigned i = 1; i < prev->arg_size(); i++) {
+                        Value *child = prev->getArgOperand(i);
+                        if (children.insert(child).second)
+                            args.push_back(child);
+                    }
+                    auto merged = CallInst::Create(cast<Function>(callee), args, "", CI);
+                    merged->setDebugLoc(CI->getDebugLoc());
+                    prev->eraseFromParent();
+                    CI->eraseFromParent();
+                    prev = merged;
+                    Changed = true;
+                }
+                else {
+                    prev = CI;
+                }
+                continue;
+            }
+            // An unwinding call also breaks the "later barrier always executes"
+            // guarantee, even if it is known not to be a safepoint.
+            if (isSafepoint(I) || (isa<CallBase>(I) && !cast<CallBase>(I)->doesNotThrow()))
+                pending.clear();
+        }
+    }
+    return Changed;
+}
+
 bool LateLowerGCFrame::CleanupIR(Function &F, State *S, bool *CFGModified) {
     auto T_int32 = Type::getInt32Ty(F.getContext());
     auto T_size = getSizeTy(F.getContext());
@@ -2390,13 +2586,14 @@ bool LateLowerGCFrame::CleanupIR(Function &F, State *S, bool *CFGModified) {
                 ++it;
                 continue;
             } else if ((call_func && callee == call_func) ||
-                       (call2_func && callee == call2_func)) {
+                       (call2_func && callee == call2_func) ||
+                       (call3_func && callee == call3_func)) {
                 assert(T_prjlvalue);
                 size_t nargs = CI->arg_size();
                 size_t nframeargs = nargs-1;
                 if (callee == call_func)
                     nframeargs -= 1;
-                else if (callee == call2_func)
+                else
                     nframeargs -= 2;
                 SmallVector<Value*, 4> ReplacementArgs;
                 auto arg_it = CI->arg_begin();
@@ -2404,7 +2601,7 @@ bool LateLowerGCFrame::CleanupIR(Function &F, State *S, bool *CFGModified) {
                 Value *new_callee = *(arg_it++);
                 assert(arg_it != CI->arg_end());
                 ReplacementArgs.push_back(*(arg_it++));
-                if (callee == call2_func) {
+                if (callee == call2_func || callee == call3_func) {
                     assert(arg_it != CI->arg_end());
                     ReplacementArgs.push_back(*(arg_it++));
                 }
@@ -2424,13 +2621,15 @@ bool LateLowerGCFrame::CleanupIR(Function &F, State *S, bool *CFGModified) {
                     (llvm::Value*)ConstantPointerNull::get(T_pprjlvalue) :
                     (allocaAddressSpace ? Builder.CreateAddrSpaceCast(Frame, T_prjlvalue->getPointerTo(0)) : Frame));
                 ReplacementArgs.push_back(ConstantInt::get(T_int32, nframeargs));
-                if (callee == call2_func) {
+                if (callee == call2_func || callee == call3_func) {
                     // move trailing arg to the end now
                     Value *front = ReplacementArgs.front();
                     ReplacementArgs.erase(ReplacementArgs.begin());
                     ReplacementArgs.push_back(front);
                 }
-                FunctionType *FTy = callee == call2_func ? JuliaType::get_jlfunc2_ty(CI->getContext()) : JuliaType::get_jlfunc_ty(CI->getContext());
+                FunctionType *FTy = callee == call2_func ? JuliaType::get_jlfunc2_ty(CI->getContext()) :
+                                    callee == call3_func ? JuliaType::get_jlfuncparams_ty(CI->getContext()) :
+                                    JuliaType::get_jlfunc_ty(CI->getContext());
                 CallInst *NewCall = CallInst::Create(FTy, new_callee, ReplacementArgs, "", CI);
                 NewCall->setTailCallKind(CI->getTailCallKind());
                 auto callattrs = CI->getAttributes();
@@ -2605,10 +2804,67 @@ void LateLowerGCFrame::PlaceRootsAndUpdateCalls(std::vector<int> &Colors, State
             "gcframe");
         gcframe->insertBefore(&*F->getEntryBlock().begin());
 
-        auto pushGcframe = CallInst::Create(
-            getOrDeclare(jl_intrinsics::pushGCFrame),
-            {gcframe, ConstantInt::get(T_int32, 0)});
-        pushGcframe->insertAfter(pgcstack);
+        // The frame is only ever inspected at safepoints, so it does not have
+        // to be linked into the pgcstack list until one can be reached. Sink
+        // the push from the entry block to the nearest common dominator of
+        // all safepoints, as long as that block also dominates every return
+        // (each pop must be preceded by the push) and cannot be reached from
+        // itself (pushing twice would link the frame to itself). If there are
+        // no safepoints at all, the collector can never observe the frame and
+        // the push and pops are dropped entirely.
+        CallInst *pushGcframe = nullptr;
+        if (!S.SafepointNumbering.empty()) {
+            if (!S.DT)
+                S.DT = &GetDT();
+            BasicBlock *PushBB = nullptr;
+            for (auto it : S.SafepointNumbering) {
+                BasicBlock *BB = it.first->getParent();
+                // Unreachable safepoints never execute and have no dominator
+                // tree nodes; everything dominates them.
+                if (!S.DT->isReachableFromEntry(BB))
+                    continue;
+                PushBB = PushBB ? S.DT->findNearestCommonDominator(PushBB, BB) : BB;
+            }
+            if (!PushBB)
+                PushBB = &F->getEntryBlock();
+            SmallVector<BasicBlock *, 8> Returns;
+            for (auto &BB : *F) {
+                if (isa<ReturnInst>(BB.getTerminator()))
+                    Returns.push_back(&BB);
+            }
+            auto canPushAt = [&] (BasicBlock *BB) {
+                if (BB == &F->getEntryBlock())
+                    return true;
+                for (auto Ret : Returns) {
+                    if (!S.DT->dominates(BB, Ret))
+                        return false;
+                }
+                return !isPotentiallyReachable(BB->getTerminator(), &BB->front(),
+                                               nullptr, S.DT);
+            };
+            while (!canPushAt(PushBB))
+                PushBB = S.DT->getNode(PushBB)->getIDom()->getBlock();
+            pushGcframe = CallInst::Create(
+                getOrDeclare(jl_intrinsics::pushGCFrame),
+                {gcframe, ConstantInt::get(T_int32, 0)});
+            if (PushBB == &F->getEntryBlock()) {
+                pushGcframe->insertAfter(pgcstack);
+            }
+            else {
+                // Link the frame before the first safepoint in the block (the
+                // slot stores are inserted immediately before the safepoints,
+                // i.e. after the push; an unlinked frame is plain stack memory
+                // so earlier slot writes would be fine regardless).
+                Instruction *InsertBefore = PushBB->getTerminator();
+                for (auto &I : *PushBB) {
+                    if (S.SafepointNumbering.count(&I)) {
+                        InsertBefore = &I;
+                        break;
+                    }
+                }
+                pushGcframe->insertBefore(InsertBefore);
+            }
+        }
 
         // Replace Allocas
         unsigned AllocaSlot = 2; // first two words are metadata
@@ -2679,17 +2935,20 @@ void LateLowerGCFrame::PlaceRootsAndUpdateCalls(std::vector<int> &Colors, State
         }
         auto NRoots = ConstantInt::get(T_int32, MaxColor + 1 + AllocaSlot - 2);
         gcframe->setArgOperand(0, NRoots);
-        pushGcframe->setArgOperand(1, NRoots);
+        if (pushGcframe)
+            pushGcframe->setArgOperand(1, NRoots);
 
         // Insert GC frame stores
         PlaceGCFrameStores(S, AllocaSlot - 2, Colors, gcframe);
-        // Insert GCFrame pops
-        for(Function::iterator I = F->begin(), E = F->end(); I != E; ++I) {
-            if (isa<ReturnInst>(I->getTerminator())) {
-                auto popGcframe = CallInst::Create(
-                    getOrDeclare(jl_intrinsics::popGCFrame),
-                    {gcframe});
-                popGcframe->insertBefore(I->getTerminator());
+        // Insert GCFrame pops (only if the frame was pushed)
+        if (pushGcframe) {
+            for(Function::iterator I = F->begin(), E = F->end(); I != E; ++I) {
+                if (isa<ReturnInst>(I->getTerminator())) {
+                    auto popGcframe = CallInst::Create(
+                        getOrDeclare(jl_intrinsics::popGCFrame),
+                        {gcframe});
+                    popGcframe->insertBefore(I->getTerminator());
+                }
             }
         }
     }
@@ -2698,12 +2957,13 @@ void LateLowerGCFrame::PlaceRootsAndUpdateCalls(std::vector<int> &Colors, State
 bool LateLowerGCFrame::runOnFunction(Function &F, bool *CFGModified) {
     initAll(*F.getParent());
     LLVM_DEBUG(dbgs() << "GC ROOT PLACEMENT: Processing function " << F.getName() << "\n");
+    bool Elided = ElideWriteBarriers(F);
     if (!pgcstack_getter)
-        return CleanupIR(F, nullptr, CFGModified);
+        return CleanupIR(F, nullptr, CFGModified) || Elided;
 
     pgcstack = getPGCstack(F);
     if (!pgcstack)
-        return CleanupIR(F, nullptr, CFGModified);
+        return CleanupIR(F, nullptr, CFGModified) || Elided;
 
     State S = LocalScan(F);
     ComputeLiveness(S);
@@ -295,6 +295,10 @@ private:
     bool has_veccall{false};
     bool has_cloneall{false};
     bool allow_bad_fvars{false};
+    // a sharded image (see jl_dump_native_impl) cannot hold cross-shard
+    // base-relative offsets in static data, so emit absolute addresses and
+    // let the loader rebase them (see parse_sysimg in processor.cpp)
+    bool sharded{false};
 };
 
 template<typename T>
@@ -334,7 +338,8 @@ CloneCtx::CloneCtx(Module &M, function_ref<LoopInfo&(Function&)> GetLI, function
       M(M),
       GetLI(GetLI),
       GetCG(GetCG),
-      allow_bad_fvars(allow_bad_fvars)
+      allow_bad_fvars(allow_bad_fvars),
+      sharded(M.getModuleFlag("julia.image.sharded") != nullptr)
 {
     groups.emplace_back(0, specs[0]);
     uint32_t ntargets = specs.size();
@@ -916,6 +921,8 @@ Constant *CloneCtx::get_ptrdiff32(Constant *ptr, Constant *base) const
 {
     if (ptr->getType()->isPointerTy())
         ptr = ConstantExpr::getPtrToInt(ptr, getSizeTy(ptr->getContext()));
+    if (sharded)
+        return ptr; // absolute entry, rebased by the loader
     auto ptrdiff = ConstantExpr::getSub(ptr, base);
     return sizeof(void*) == 8 ? ConstantExpr::getTrunc(ptrdiff, Type::getInt32Ty(ptr->getContext())) : ptrdiff;
 }
@@ -932,11 +939,19 @@ Constant *CloneCtx::emit_offset_table(const std::vector<T*> &vars, StringRef nam
     auto vbase = ConstantExpr::getPtrToInt(vars[0], T_size);
     uint32_t nvars = vars.size();
     std::vector<Constant*> offsets(nvars + 1);
-    offsets[0] = ConstantInt::get(T_int32, nvars);
-    offsets[1] = ConstantInt::get(T_int32, 0);
-    for (uint32_t i = 1; i < nvars; i++)
-        offsets[i + 1] = get_ptrdiff32(vars[i], vbase);
-    ArrayType *vars_type = ArrayType::get(T_int32, nvars + 1);
+    if (sharded) {
+        // absolute entries, rebased by the loader
+        offsets[0] = ConstantInt::get(T_size, nvars);
+        for (uint32_t i = 0; i < nvars; i++)
+            offsets[i + 1] = ConstantExpr::getPtrToInt(vars[i], T_size);
+    }
+    else {
+        offsets[0] = ConstantInt::get(T_int32, nvars);
+        offsets[1] = ConstantInt::get(T_int32, 0);
+        for (uint32_t i = 1; i < nvars; i++)
+            offsets[i + 1] = get_ptrdiff32(vars[i], vbase);
+    }
+    ArrayType *vars_type = ArrayType::get(sharded ? (Type*)T_size : (Type*)T_int32, nvars + 1);
     add_comdat(new GlobalVariable(M, vars_type, true,
                                   GlobalVariable::ExternalLinkage,
                                   ConstantArray::get(vars_type, offsets),
@@ -989,7 +1004,9 @@ void CloneCtx::emit_metadata()
     // Generate `jl_dispatch_reloc_slots`
     std::set<uint32_t> shared_relocs;
     {
-        auto T_int32 = Type::getInt32Ty(M.getContext());
+        // sharded images store the slot addresses (and every other table
+        // entry) at full width; the loader rebases them to the int32 form
+        auto T_entry = sharded ? getSizeTy(M.getContext()) : Type::getInt32Ty(M.getContext());
         std::stable_sort(gv_relocs.begin(), gv_relocs.end(),
                          [] (const std::pair<Constant*,uint32_t> &lhs,
                              const std::pair<Constant*,uint32_t> &rhs) {
@@ -1002,7 +1019,7 @@ void CloneCtx::emit_metadata()
             // TODO:
             // explicitly set section? so that we are sure the relocation slots
             // are in the same section as `gbase`.
-            auto id_v = ConstantInt::get(T_int32, id);
+            auto id_v = ConstantInt::get(T_entry, id);
             for (; gv_reloc_idx < ngv_relocs && gv_relocs[gv_reloc_idx].second == id;
                  gv_reloc_idx++) {
                 shared_relocs.insert(id);
@@ -1018,8 +1035,8 @@ void CloneCtx::emit_metadata()
                 shared_relocs.insert(id);
             }
         }
-        values[0] = ConstantInt::get(T_int32, values.size() / 2);
-        ArrayType *vars_type = ArrayType::get(T_int32, values.size());
+        values[0] = ConstantInt::get(T_entry, values.size() / 2);
+        ArrayType *vars_type = ArrayType::get(T_entry, values.size());
         add_comdat(new GlobalVariable(M, vars_type, true, GlobalVariable::ExternalLinkage,
                                       ConstantArray::get(vars_type, values),
                                       "jl_dispatch_reloc_slots"));
@@ -1073,11 +1090,26 @@ void CloneCtx::emit_metadata()
         add_comdat(new GlobalVariable(M, idxval->getType(), true,
                                       GlobalVariable::ExternalLinkage,
                                       idxval, "jl_dispatch_fvars_idxs"));
-        ArrayType *offsets_type = ArrayType::get(Type::getInt32Ty(M.getContext()), offsets.size());
+        Type *T_offset = Type::getInt32Ty(M.getContext());
+        if (sharded) {
+            // the loader needs the length up front to rebase the table
+            auto T_size = getSizeTy(M.getContext());
+            offsets.insert(offsets.begin(), ConstantInt::get(T_size, offsets.size()));
+            T_offset = T_size;
+        }
+        ArrayType *offsets_type = ArrayType::get(T_offset, offsets.size());
         add_comdat(new GlobalVariable(M, offsets_type, true,
                                       GlobalVariable::ExternalLinkage,
                                       ConstantArray::get(offsets_type, offsets),
                                       "jl_dispatch_fvars_offsets"));
+        if (sharded) {
+            // marker consulted by the loaders before decoding any table
+            auto T_int32 = Type::getInt32Ty(M.getContext());
+            add_comdat(new GlobalVariable(M, T_int32, true,
+                                          GlobalVariable::ExternalLinkage,
+                                          ConstantInt::get(T_int32, 1),
+                                          "jl_sysimg_abs_tables"));
+        }
     }
 }
 
@@ -1094,6 +1126,12 @@ static bool runMultiVersioning(Module &M, function_ref<LoopInfo&(Function&)> Get
     if (M.getName() == "sysimage")
         return false;
 
+    // when the image is sharded for parallel emission (see jl_dump_native_impl),
+    // multiversioning runs once over the whole module before it is split; the
+    // per-shard pipelines still schedule this pass, so reruns must be a no-op
+    if (M.getModuleFlag("julia.mv.done"))
+        return false;
+
     GlobalVariable *fvars = M.getGlobalVariable("jl_sysimg_fvars");
     GlobalVariable *gvars = M.getGlobalVariable("jl_sysimg_gvars");
     if (allow_bad_fvars && (!fvars || !fvars->hasInitializer() || !isa<ConstantArray>(fvars->getInitializer()) ||
@@ -1135,6 +1173,8 @@ static bool runMultiVersioning(Module &M, function_ref<LoopInfo&(Function&)> Get
     // and collected all the shared/target-specific relocations.
     clone.emit_metadata();
 
+    M.addModuleFlag(Module::Error, "julia.mv.done", 1);
+
     assert(!verifyModule(M, &errs()));
 
     return true;
@@ -28,7 +28,7 @@ JuliaPassContext::JuliaPassContext()
         pointer_from_objref_func(nullptr), alloc_obj_func(nullptr),
         typeof_func(nullptr), write_barrier_func(nullptr),
         write_barrier_binding_func(nullptr), call_func(nullptr),
-        call2_func(nullptr), module(nullptr)
+        call2_func(nullptr), call3_func(nullptr), module(nullptr)
 {
 }
 
@@ -54,6 +54,7 @@ void JuliaPassContext::initFunctions(Module &M)
     alloc_obj_func = M.getFunction("julia.gc_alloc_obj");
     call_func = M.getFunction("julia.call");
     call2_func = M.getFunction("julia.call2");
+    call3_func = M.getFunction("julia.call3");
 }
 
 void JuliaPassContext::initAll(Module &M)
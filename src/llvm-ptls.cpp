@@ -265,9 +265,25 @@ bool LowerPTLS::runOnModule(Module &_M, bool *CFGModified)
     T_pgcstack_getter = FT_pgcstack_getter->getPointerTo();
     T_pppjlvalue = cast<PointerType>(FT_pgcstack_getter->getReturnType());
     if (imaging_mode) {
-        pgcstack_func_slot = create_aliased_global(T_pgcstack_getter, "jl_pgcstack_func_slot");
-        pgcstack_key_slot = create_aliased_global(getSizeTy(_M.getContext()), "jl_pgcstack_key_slot"); // >= sizeof(jl_pgcstack_key_t)
-        pgcstack_offset = create_aliased_global(getSizeTy(_M.getContext()), "jl_tls_offset");
+        if (_M.getModuleFlag("julia.image.secondary_shard")) {
+            // a sharded image (see jl_dump_native_impl) defines the slots in
+            // its primary shard only; the other shards reference them as
+            // external symbols resolved when the image is linked
+            pgcstack_func_slot = new GlobalVariable(_M, T_pgcstack_getter, false,
+                                                    GlobalVariable::ExternalLinkage,
+                                                    nullptr, "jl_pgcstack_func_slot");
+            pgcstack_key_slot = new GlobalVariable(_M, getSizeTy(_M.getContext()), false,
+                                                   GlobalVariable::ExternalLinkage,
+                                                   nullptr, "jl_pgcstack_key_slot");
+            pgcstack_offset = new GlobalVariable(_M, getSizeTy(_M.getContext()), false,
+                                                 GlobalVariable::ExternalLinkage,
+                                                 nullptr, "jl_tls_offset");
+        }
+        else {
+            pgcstack_func_slot = create_aliased_global(T_pgcstack_getter, "jl_pgcstack_func_slot");
+            pgcstack_key_slot = create_aliased_global(getSizeTy(_M.getContext()), "jl_pgcstack_key_slot"); // >= sizeof(jl_pgcstack_key_t)
+            pgcstack_offset = create_aliased_global(getSizeTy(_M.getContext()), "jl_tls_offset");
+        }
     }
 
     for (auto it = pgcstack_getter->user_begin(); it != pgcstack_getter->user_end();) {
@@ -0,0 +1,36 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+// Address table of every function libjulia-internal re-exports through the
+// CLI loader, in the order of jl_exported_funcs.inc.  Exporting the table as
+// a single symbol lets the loader in cli/loader_lib.c bind all of its
+// trampolines with one lookup instead of one dlsym round trip per function.
+//
+// This file deliberately does not include julia.h: only the symbol names are
+// needed here, and the uniform `void (void)` declarations below would
+// conflict with the real prototypes.
+
+#include "platform.h"
+#include "support/dtypes.h"
+
+#include "jl_exported_funcs.inc"
+
+typedef void (anonfunc)(void);
+
+// The definitions carry an `ijl_` prefix (see jl_internal_funcs.inc), which
+// is also the name the loader uses when resolving them one at a time.
+#define XX(name) extern anonfunc i##name;
+JL_RUNTIME_EXPORTED_FUNCS(XX)
+#ifdef _OS_WINDOWS_
+JL_RUNTIME_EXPORTED_FUNCS_WIN(XX)
+#endif
+#undef XX
+
+JL_DLLEXPORT anonfunc *const jl_runtime_exported_func_table[] = {
+#define XX(name) &i##name,
+    JL_RUNTIME_EXPORTED_FUNCS(XX)
+#ifdef _OS_WINDOWS_
+    JL_RUNTIME_EXPORTED_FUNCS_WIN(XX)
+#endif
+#undef XX
+    NULL
+};
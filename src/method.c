@@ -924,7 +924,8 @@ JL_DLLEXPORT jl_method_t* jl_method_def(jl_svec_t *argdata,
     if ((jl_value_t*)mt == jl_nothing)
         jl_error("Method dispatch is unimplemented currently for this method signature");
     if (mt->frozen)
-        jl_error("cannot add methods to a builtin function");
+        jl_error(mt->frozen == 2 ? "cannot add methods to a function in a frozen module" :
+                 "cannot add methods to a builtin function");
 
     // TODO: derive our debug name from the syntax instead of the type
     name = mt->name;
@@ -35,6 +35,7 @@ JL_DLLEXPORT jl_module_t *jl_new_module_(jl_sym_t *name, uint8_t default_names)
     m->max_methods = -1;
     JL_MUTEX_INIT(&m->lock);
     htable_new(&m->bindings, 0);
+    jl_atomic_store_relaxed(&m->fastbindings, NULL);
     arraylist_new(&m->usings, 0);
     JL_GC_PUSH1(&m);
     if (jl_core_module && default_names) {
@@ -154,6 +155,120 @@ JL_DLLEXPORT uint8_t jl_istopmod(jl_module_t *mod)
     return mod->istopmod;
 }
 
+// --- read-optimized mirror of the bindings table ---
+// An open-addressed power-of-two table that can be probed without taking the
+// module lock. All mutation happens while holding the module lock: a new key
+// publishes its binding first and then the key with a release store, and when
+// the load factor is exceeded a doubled copy is published in m->fastbindings.
+// Retired tables are never freed, since lock-free readers may still be probing
+// them; a module leaks at most its final table size this way (a geometric
+// series), matching the htable it mirrors, which is also never freed. The
+// mirror may lag behind the htable (deserializers fill the htable directly),
+// so a miss here says nothing: callers must fall back to the locked path.
+typedef struct _jl_bindingtable_t {
+    size_t sz;      // slot count (a power of two)
+    size_t count;   // filled slots; only read and written under the lock
+    struct {
+        _Atomic(jl_sym_t*) var;
+        _Atomic(jl_binding_t*) binding;
+    } slots[];
+} jl_bindingtable_t;
+
+#define BINDINGTABLE_INIT_SZ 16
+
+static jl_binding_t *jl_bindingtable_lookup(jl_bindingtable_t *bt, jl_sym_t *var) JL_NOTSAFEPOINT
+{
+    if (bt == NULL)
+        return NULL;
+    size_t mask = bt->sz - 1;
+    size_t i = var->hash & mask;
+    size_t probe;
+    for (probe = 0; probe < bt->sz; probe++) {
+        jl_sym_t *k = jl_atomic_load_acquire(&bt->slots[i].var);
+        if (k == NULL)
+            return NULL;
+        if (k == var)
+            return jl_atomic_load_acquire(&bt->slots[i].binding);
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+// insert into `bt` without growing; caller must hold the module lock and
+// have checked there is a free slot
+static void jl_bindingtable_insert(jl_bindingtable_t *bt, jl_sym_t *var, jl_binding_t *b) JL_NOTSAFEPOINT
+{
+    size_t mask = bt->sz - 1;
+    size_t i = var->hash & mask;
+    while (1) {
+        jl_sym_t *k = jl_atomic_load_relaxed(&bt->slots[i].var);
+        if (k == var) {
+            jl_atomic_store_release(&bt->slots[i].binding, b);
+            return;
+        }
+        if (k == NULL) {
+            // publish the binding before the key so that a reader that sees
+            // the key also sees the binding
+            jl_atomic_store_release(&bt->slots[i].binding, b);
+            jl_atomic_store_release(&bt->slots[i].var, var);
+            bt->count++;
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+// mirror `var => b` into the fast table; caller must hold the module lock and
+// have already inserted the binding into m->bindings
+static void jl_bindingtable_put(jl_module_t *m, jl_sym_t *var, jl_binding_t *b) JL_NOTSAFEPOINT
+{
+    jl_bindingtable_t *bt = jl_atomic_load_relaxed(&m->fastbindings);
+    if (bt == NULL || (bt->count + 1) * 3 >= bt->sz * 2) {
+        size_t newsz = bt == NULL ? BINDINGTABLE_INIT_SZ : bt->sz * 2;
+        jl_bindingtable_t *newbt = (jl_bindingtable_t*)calloc(
+                1, sizeof(jl_bindingtable_t) + newsz * sizeof(newbt->slots[0]));
+        if (newbt == NULL)
+            return; // mirroring is best-effort; readers fall back to the lock
+        newbt->sz = newsz;
+        if (bt != NULL) {
+            size_t i;
+            for (i = 0; i < bt->sz; i++) {
+                jl_sym_t *k = jl_atomic_load_relaxed(&bt->slots[i].var);
+                if (k != NULL)
+                    jl_bindingtable_insert(newbt, k,
+                            jl_atomic_load_relaxed(&bt->slots[i].binding));
+            }
+        }
+        jl_bindingtable_insert(newbt, var, b);
+        jl_atomic_store_release(&m->fastbindings, newbt);
+        return;
+    }
+    jl_bindingtable_insert(bt, var, b);
+}
+
+// rebuild the mirror from m->bindings after a deserializer has filled the
+// htable directly; the caller must have exclusive access to the module
+void jl_module_rebuild_fastbindings(jl_module_t *m)
+{
+    void **table = m->bindings.table;
+    size_t count = 0, i;
+    for (i = 1; i < m->bindings.size; i += 2)
+        count += table[i] != HT_NOTFOUND;
+    size_t newsz = BINDINGTABLE_INIT_SZ;
+    while ((count + 1) * 3 >= newsz * 2)
+        newsz *= 2;
+    jl_bindingtable_t *newbt = (jl_bindingtable_t*)calloc(
+            1, sizeof(jl_bindingtable_t) + newsz * sizeof(newbt->slots[0]));
+    if (newbt == NULL)
+        return;
+    newbt->sz = newsz;
+    for (i = 1; i < m->bindings.size; i += 2) {
+        if (table[i] != HT_NOTFOUND)
+            jl_bindingtable_insert(newbt, (jl_sym_t*)table[i - 1], (jl_binding_t*)table[i]);
+    }
+    jl_atomic_store_release(&m->fastbindings, newbt);
+}
+
 static jl_binding_t *new_binding(jl_sym_t *name)
 {
     jl_task_t *ct = jl_current_task;
@@ -164,10 +279,12 @@ static jl_binding_t *new_binding(jl_sym_t *name)
     b->owner = NULL;
     b->ty = NULL;
     b->globalref = NULL;
+    b->speculations = NULL;
     b->constp = 0;
     b->exportp = 0;
     b->imported = 0;
     b->deprecated = 0;
+    b->reassigned = 0;
     return b;
 }
 
@@ -196,6 +313,7 @@ JL_DLLEXPORT jl_binding_t *jl_get_binding_wr(jl_module_t *m JL_PROPAGATES_ROOT,
         *bp = b;
         JL_GC_PROMISE_ROOTED(b);
         jl_gc_wb_buf(m, b, sizeof(jl_binding_t));
+        jl_bindingtable_put(m, var, b);
     }
     else {
         b = NULL;
@@ -262,6 +380,7 @@ JL_DLLEXPORT jl_binding_t *jl_get_binding_for_method_def(jl_module_t *m, jl_sym_
         *bp = b;
         JL_GC_PROMISE_ROOTED(b);
         jl_gc_wb_buf(m, b, sizeof(jl_binding_t));
+        jl_bindingtable_put(m, var, b);
     }
 
     JL_UNLOCK(&m->lock);
@@ -343,6 +462,14 @@ static jl_binding_t *jl_get_binding_(jl_module_t *m, jl_sym_t *var, modstack_t *
         }
         tmp = tmp->prev;
     }
+    // wait-free fast path: an already-resolved binding can be returned (or
+    // followed to its owner) without taking the module lock
+    jl_binding_t *fb = jl_bindingtable_lookup(jl_atomic_load_acquire(&m->fastbindings), var);
+    if (fb != NULL && fb->owner != NULL) {
+        if (fb->owner != m || fb->name != var)
+            return jl_get_binding_(fb->owner, fb->name, &top);
+        return fb;
+    }
     JL_LOCK(&m->lock);
     jl_binding_t *b = _jl_get_module_binding(m, var);
     if (b == HT_NOTFOUND || b->owner == NULL) {
@@ -539,6 +666,7 @@ static void module_import_(jl_module_t *to, jl_module_t *from, jl_sym_t *s, jl_s
             nb->deprecated = b->deprecated;
             *bp = nb;
             jl_gc_wb_buf(to, nb, sizeof(jl_binding_t));
+            jl_bindingtable_put(to, asname, nb);
         }
         JL_UNLOCK(&to->lock);
     }
@@ -618,6 +746,7 @@ JL_DLLEXPORT void jl_module_export(jl_module_t *from, jl_sym_t *s)
         b->owner = NULL;
         *bp = b;
         jl_gc_wb_buf(from, b, sizeof(jl_binding_t));
+        jl_bindingtable_put(from, s, b);
     }
     assert(*bp != HT_NOTFOUND);
     (*bp)->exportp = 1;
@@ -656,6 +785,11 @@ JL_DLLEXPORT int jl_binding_resolved_p(jl_module_t *m, jl_sym_t *var)
 
 JL_DLLEXPORT jl_binding_t *jl_get_module_binding(jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var)
 {
+    // a hit in the lock-free mirror is always the same binding object the
+    // htable holds; only a miss needs the lock
+    jl_binding_t *fb = jl_bindingtable_lookup(jl_atomic_load_acquire(&m->fastbindings), var);
+    if (fb != NULL)
+        return fb;
     JL_LOCK(&m->lock);
     jl_binding_t *b = _jl_get_module_binding(m, var);
     JL_UNLOCK(&m->lock);
@@ -830,8 +964,14 @@ JL_DLLEXPORT void jl_checked_assignment(jl_binding_t *b, jl_value_t *rhs)
         jl_safe_printf("WARNING: redefinition of constant %s. This may fail, cause incorrect answers, or produce other errors.\n",
                        jl_symbol_name(b->name));
     }
-    jl_atomic_store_release(&b->value, rhs);
+    jl_value_t *old = jl_atomic_exchange(&b->value, rhs);
     jl_gc_wb_binding(b, rhs);
+    if (old != NULL && !b->constp) {
+        // any code that speculatively embedded the previous value must be
+        // pushed out of the new world (see jl_binding_add_speculation)
+        b->reassigned = 1;
+        jl_binding_invalidate_speculations(b);
+    }
 }
 
 JL_DLLEXPORT void jl_declare_constant(jl_binding_t *b)
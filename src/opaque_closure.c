@@ -55,26 +55,57 @@ static jl_opaque_closure_t *new_opaque_closure(jl_tupletype_t *argt, jl_value_t
     }
     if (jl_nparams(argt) + 1 - jl_is_va_tuple(argt) < source->nargs - source->isva)
         jl_error("Argument type tuple has too few required arguments for method");
+
+    jl_task_t *ct = jl_current_task;
+    size_t world = jl_atomic_load_acquire(&jl_world_counter);
+    jl_value_t *captt = jl_typeof(captures);
+    size_t slot = (size_t)((((uintptr_t)source_ ^ ((uintptr_t)argt >> 4) ^
+                             ((uintptr_t)captt >> 8) ^ (uintptr_t)rt_ub) *
+                            0x9E3779B97F4A7C15ULL) >> 32) & (JL_TLS_OC_CACHE_SIZE - 1);
+    jl_ptls_t ptls = ct->ptls;
+    if (ptls->oc_cache[slot].source == source_ && ptls->oc_cache[slot].argt == (jl_value_t*)argt &&
+        ptls->oc_cache[slot].captt == captt && ptls->oc_cache[slot].rt_ub == rt_ub &&
+        ptls->oc_cache[slot].world == world) {
+        // same closure shape constructed earlier in this world: the closure
+        // type and entry point are already resolved, only the captures differ
+        jl_opaque_closure_t *oc = (jl_opaque_closure_t*)jl_gc_alloc(
+                ptls, sizeof(jl_opaque_closure_t), ptls->oc_cache[slot].oc_type);
+        oc->source = source;
+        oc->captures = ptls->oc_cache[slot].consted ?
+                       ptls->oc_cache[slot].consted : captures;
+        oc->specptr = NULL;
+        oc->invoke = (jl_fptr_args_t)ptls->oc_cache[slot].invoke;
+        oc->world = world;
+        return oc;
+    }
+
     jl_value_t *sigtype = NULL;
     JL_GC_PUSH1(&sigtype);
-    sigtype = prepend_type(jl_typeof(captures), argt);
+    sigtype = prepend_type(captt, argt);
 
     jl_value_t *oc_type JL_ALWAYS_LEAFTYPE;
     oc_type = jl_apply_type2((jl_value_t*)jl_opaque_closure_type, (jl_value_t*)argt, rt_ub);
     JL_GC_PROMISE_ROOTED(oc_type);
 
     jl_method_instance_t *mi = jl_specializations_get_linfo(source, sigtype, jl_emptysvec);
-    size_t world = jl_atomic_load_acquire(&jl_world_counter);
+    // specializing the closure body churns through compiler temporaries;
+    // run it as an arena region (cf. jl_type_infer) so the mostly-dead
+    // intermediates are reclaimed in one sweep on exit
+    jl_gc_begin_arena();
     jl_code_instance_t *ci = jl_compile_method_internal(mi, world);
+    jl_gc_end_arena();
 
-    jl_task_t *ct = jl_current_task;
     jl_opaque_closure_t *oc = (jl_opaque_closure_t*)jl_gc_alloc(ct->ptls, sizeof(jl_opaque_closure_t), oc_type);
     JL_GC_POP();
     oc->source = source;
     oc->captures = captures;
     oc->specptr = NULL;
+    int cache = 1;
     if (jl_atomic_load_relaxed(&ci->invoke) == jl_fptr_interpret_call) {
         oc->invoke = (jl_fptr_args_t)jl_interpret_opaque_closure;
+        // don't pin the interpreted entry for the rest of the world; a later
+        // construction should pick up the compiled one
+        cache = 0;
     }
     else if (jl_atomic_load_relaxed(&ci->invoke) == jl_fptr_args) {
         oc->invoke = jl_atomic_load_relaxed(&ci->specptr.fptr1);
@@ -87,6 +118,17 @@ static jl_opaque_closure_t *new_opaque_closure(jl_tupletype_t *argt, jl_value_t
         oc->invoke = (jl_fptr_args_t)jl_atomic_load_relaxed(&ci->invoke);
     }
     oc->world = world;
+    if (cache) {
+        ptls->oc_cache[slot].source = source_;
+        ptls->oc_cache[slot].argt = (jl_value_t*)argt;
+        ptls->oc_cache[slot].captt = captt;
+        ptls->oc_cache[slot].rt_ub = rt_ub;
+        ptls->oc_cache[slot].world = world;
+        ptls->oc_cache[slot].oc_type = oc_type;
+        ptls->oc_cache[slot].consted =
+            oc->invoke == (jl_fptr_args_t)jl_fptr_const_opaque_closure ? oc->captures : NULL;
+        ptls->oc_cache[slot].invoke = (void*)oc->invoke;
+    }
     return oc;
 }
 
@@ -12,6 +12,18 @@
 
 #define N_CALL_CACHE 4096
 
+// Size of the signature-hash-keyed dispatch cache (see sig_call_cache in
+// gf.c). Must be a power of two.
+#define N_SIG_CACHE 4096
+
+// Size of the memo table for closed subtype judgments (see subtype_memo_cache
+// in subtype.c). Must be a power of two.
+#define N_SUBTYPE_CACHE 2048
+
+// Size of the memo table for x86-64 ABI classifications (see
+// jl_abi_classify_cache in abi_x86_64.cpp). Must be a power of two.
+#define N_ABI_CLASSIFY_CACHE 512
+
 // object layout options ------------------------------------------------------
 
 // The data for an array this size or below will be allocated within the
@@ -64,6 +76,18 @@
 #endif
 #endif
 
+// JL_VERIFY_BUILD (the WITH_VERIFY make option) is a middle tier between
+// release and debug builds: cheap O(1) invariants (`jl_invariant` in
+// julia_internal.h) stay enabled behind unlikely branches, and the full-heap
+// verifier enabled by GC_VERIFY runs on one collection out of
+// JL_VERIFY_GC_SAMPLE_PERIOD instead of every one, so corruption can be
+// caught on production workloads at a few percent overhead.
+#ifdef JL_VERIFY_BUILD
+#ifndef JL_VERIFY_GC_SAMPLE_PERIOD
+#define JL_VERIFY_GC_SAMPLE_PERIOD 64
+#endif
+#endif
+
 // SEGV_EXCEPTION turns segmentation faults into catchable julia exceptions.
 // This is not recommended, as the memory state after such an exception should
 // be considered untrusted, but can be helpful during development
@@ -122,12 +146,23 @@
 // allow a suspended Task to restart on a different thread
 #define MIGRATE_TASKS
 
+// minimum capacity (in jl_bt_element_t slots) reserved for a task's exception
+// stack the first time it catches. Sized so that one exception plus a typical
+// truncated backtrace fits without regrowing; the buffer stays on the task, so
+// with geometric growth above this floor a retry-heavy catch loop stops
+// allocating once it reaches steady state.
+#define JL_EXCSTACK_MIN_RESERVE 256
+
 // threading options ----------------------------------------------------------
 
 // controls for when threads sleep
 #define THREAD_SLEEP_THRESHOLD_NAME     "JULIA_THREAD_SLEEP_THRESHOLD"
 #define DEFAULT_THREAD_SLEEP_THRESHOLD  16*1000 // nanoseconds (16us)
 
+// cooperative preemption quantum for compute-bound tasks, in nanoseconds;
+// 0 (the default) disables preemption polls entirely (see task.c)
+#define TASK_PREEMPT_QUANTUM_NAME       "JULIA_TASK_PREEMPT"
+
 // defaults for # threads
 #define NUM_THREADS_NAME                "JULIA_NUM_THREADS"
 #ifndef JULIA_NUM_THREADS
@@ -140,6 +175,13 @@
 // affinitization behavior
 #define MACHINE_EXCLUSIVE_NAME          "JULIA_EXCLUSIVE"
 #define DEFAULT_MACHINE_EXCLUSIVE       0
+#define NUMA_PINNING_NAME               "JULIA_NUMA"
+
+// environment variable for the number of sharded libuv event loops
+#define UV_LOOP_SHARDS_NAME             "JULIA_UV_SHARDS"
+
+// environment variable naming the on-disk parse cache directory (see ast.c)
+#define PARSE_CACHE_NAME                "JULIA_PARSE_CACHE"
 
 // partr -- parallel tasks runtime options ------------------------------------
 
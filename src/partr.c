@@ -73,6 +73,155 @@ JL_DLLEXPORT int jl_set_task_threadpoolid(jl_task_t *task, int8_t tpid) JL_NOTSA
     return 1;
 }
 
+// Place a task in (or remove it from) the strict-priority lane of its
+// threadpool: lane tasks run before any other queued work in that pool
+// (see the scheduler queues in base/partr.jl). Encoded as priority 1;
+// only meaningful before the task is scheduled.
+JL_DLLEXPORT int jl_set_task_priority_lane(jl_task_t *task, int8_t lane) JL_NOTSAFEPOINT
+{
+    task->priority = lane ? 1 : 0;
+    return 1;
+}
+
+// Declare the NUMA node holding a task's working set (-1 clears the hint).
+// The scheduler in base/partr.jl then biases placement toward threads pinned
+// to that node; a no-op without JULIA_NUMA pinning since threads have no
+// stable node there.
+JL_DLLEXPORT int jl_set_task_socket_hint(jl_task_t *task, int16_t socket) JL_NOTSAFEPOINT
+{
+    if (socket < -1 || socket >= jl_n_sockets())
+        return 0;
+    task->socket_hint = socket;
+    return 1;
+}
+
+// Effective placement node of a task: the declared hint if any, otherwise
+// the node it last ran on (where its cached state presumably lives), or -1.
+JL_DLLEXPORT int16_t jl_get_task_socket(jl_task_t *task) JL_NOTSAFEPOINT
+{
+    return task->socket_hint >= 0 ? task->socket_hint : task->last_socket;
+}
+
+// When nonzero, idle threads in the default pool may run tasks queued for
+// the interactive pool (never the other way around); off by default so the
+// interactive pool stays isolated. Read from base/partr.jl.
+static _Atomic(int) work_conservation = 0;
+
+JL_DLLEXPORT void jl_set_work_conservation(int8_t enable) JL_NOTSAFEPOINT
+{
+    jl_atomic_store_relaxed(&work_conservation, enable != 0);
+}
+
+JL_DLLEXPORT int8_t jl_get_work_conservation(void) JL_NOTSAFEPOINT
+{
+    return jl_atomic_load_relaxed(&work_conservation);
+}
+
+// --- scheduler decision tracing ---
+
+// Record mode for scheduling decisions: every task handed out by
+// `jl_task_get_next`, every successful steal (reported by the Julia-side
+// deques via `jl_sched_trace_note`), every wakeup request, and every
+// sleep/wake transition is appended to a per-thread ring stamped with a
+// global logical clock, so the recorded rings merge into a total order.
+// Each ring has a single writer (its owner thread), so recording is
+// lock-free: one relaxed fetch-add for the clock and a few plain stores.
+// Enable with `jl_sched_trace_enable(1)` or `JULIA_SCHED_TRACE=1`, dump with
+// `jl_sched_trace_dump(path)`; the rings keep the most recent events, which
+// is what a heisenbug post-mortem wants. Offline analysis of the merged
+// stream exposes steal storms, starvation, and wake herding directly;
+// re-executing a recorded interleaving is out of scope here (it requires
+// control over every nondeterministic event, which is rr's job -- see
+// `jl_running_under_rr`), but a trace recorded under rr lines up with the
+// replayed execution.
+
+#define SCHED_TRACE_EVENTS (1 << 13) // per-thread ring size, power of two
+
+typedef struct {
+    uint64_t clock; // global logical clock; totally ordered across threads
+    uint64_t task;  // opaque task identity, 0 if not applicable
+    int32_t kind;   // JL_SCHED_EV_* below
+    int32_t arg;    // steal victim / wake target tid, -1 if not applicable
+} jl_sched_event_t;
+
+typedef struct {
+    uint64_t n; // events recorded so far; the ring keeps the last SCHED_TRACE_EVENTS
+    jl_sched_event_t ev[SCHED_TRACE_EVENTS];
+} jl_sched_trace_t;
+
+static _Atomic(int) sched_trace_enabled = 0;
+static _Atomic(uint64_t) sched_trace_clock = 0;
+static jl_sched_trace_t **sched_traces = NULL; // one ring per thread, indexed by tid
+
+static void sched_trace_record(int16_t tid, int kind, int arg, jl_task_t *task) JL_NOTSAFEPOINT
+{
+    jl_sched_trace_t **traces = sched_traces;
+    if (traces == NULL || traces[tid] == NULL)
+        return; // enable may not be visible everywhere yet
+    jl_sched_trace_t *tr = traces[tid];
+    jl_sched_event_t *e = &tr->ev[tr->n++ & (SCHED_TRACE_EVENTS - 1)];
+    e->clock = jl_atomic_fetch_add_relaxed(&sched_trace_clock, 1);
+    e->task = (uint64_t)(uintptr_t)task;
+    e->kind = kind;
+    e->arg = arg;
+}
+
+#define sched_trace_on() __unlikely(jl_atomic_load_relaxed(&sched_trace_enabled))
+
+JL_DLLEXPORT void jl_sched_trace_enable(int8_t enable)
+{
+    if (enable && sched_traces == NULL) {
+        jl_sched_trace_t **traces = (jl_sched_trace_t**)calloc(jl_n_threads, sizeof(void*));
+        for (int i = 0; i < jl_n_threads; i++)
+            traces[i] = (jl_sched_trace_t*)calloc(1, sizeof(jl_sched_trace_t));
+        sched_traces = traces;
+    }
+    jl_atomic_store_release(&sched_trace_enabled, enable != 0);
+}
+
+// event kinds, mirrored by the ccall sites in base/partr.jl
+enum {
+    JL_SCHED_EV_GET_NEXT = 1, // scheduled a task from the queues
+    JL_SCHED_EV_STEAL    = 2, // took a task from thread `arg`'s deque
+    JL_SCHED_EV_WAKEUP   = 3, // asked thread `arg` (-1: any) to wake
+    JL_SCHED_EV_SLEEP    = 4, // found no work and blocked
+    JL_SCHED_EV_WAKE     = 5, // resumed from the sleep above
+};
+
+// entry point for the Julia-side scheduler (deque steals)
+JL_DLLEXPORT void jl_sched_trace_note(int kind, int arg)
+{
+    if (sched_trace_on())
+        sched_trace_record(jl_atomic_load_relaxed(&jl_current_task->tid), kind, arg, NULL);
+}
+
+// Write all rings as CSV (clock,tid,kind,arg,task), unmerged; sorting by the
+// first column off-line yields the global interleaving. Returns 0 on success.
+JL_DLLEXPORT int jl_sched_trace_dump(const char *path)
+{
+    if (sched_traces == NULL)
+        return -1;
+    ios_t f;
+    if (ios_file(&f, path, 0, 1, 1, 1) == NULL)
+        return -1;
+    ios_printf(&f, "clock,tid,kind,arg,task\n");
+    for (int tid = 0; tid < jl_n_threads; tid++) {
+        jl_sched_trace_t *tr = sched_traces[tid];
+        if (tr == NULL)
+            continue;
+        uint64_t n = tr->n;
+        uint64_t first = n > SCHED_TRACE_EVENTS ? n - SCHED_TRACE_EVENTS : 0;
+        for (uint64_t i = first; i < n; i++) {
+            jl_sched_event_t *e = &tr->ev[i & (SCHED_TRACE_EVENTS - 1)];
+            ios_printf(&f, "%llu,%d,%d,%d,0x%llx\n",
+                       (unsigned long long)e->clock, tid, (int)e->kind, (int)e->arg,
+                       (unsigned long long)e->task);
+        }
+    }
+    ios_close(&f);
+    return 0;
+}
+
 // GC functions used
 extern int jl_gc_mark_queue_obj_explicit(jl_gc_mark_cache_t *gc_cache,
                                          jl_gc_mark_sp_t *sp, jl_value_t *obj) JL_NOTSAFEPOINT;
@@ -83,8 +232,44 @@ extern int jl_gc_mark_queue_obj_explicit(jl_gc_mark_cache_t *gc_cache,
 JL_DLLEXPORT uint32_t jl_rand_ptls(uint32_t max, uint32_t unbias)
 {
     jl_ptls_t ptls = jl_current_task->ptls;
-    // one-extend unbias back to 64-bits
-    return cong(max, -(uint64_t)-unbias, &ptls->rngseed);
+    // `unbias` is unused now that the bounded draw rejects internally;
+    // the argument is kept so existing callers need not change
+    (void)unbias;
+    return jl_rand_bounded(&ptls->rngseed, max);
+}
+
+// per-thread counter-based RNG service (see jl_rand_next in julia_internal.h)
+
+JL_DLLEXPORT uint64_t jl_rand_u64(void) JL_NOTSAFEPOINT
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    return jl_rand_next(&ptls->rngseed);
+}
+
+// fill `buf` with `len` random bytes from the calling thread's generator;
+// lets callers amortize the ccall over many draws instead of paying one
+// round trip per number
+JL_DLLEXPORT void jl_rand_fill(void *buf, size_t len) JL_NOTSAFEPOINT
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    uint64_t *state = &ptls->rngseed;
+    char *p = (char*)buf;
+    while (len >= sizeof(uint64_t)) {
+        uint64_t r = jl_rand_next(state);
+        memcpy(p, &r, sizeof(uint64_t));
+        p += sizeof(uint64_t);
+        len -= sizeof(uint64_t);
+    }
+    if (len) {
+        uint64_t r = jl_rand_next(state);
+        memcpy(p, &r, len);
+    }
+}
+
+JL_DLLEXPORT uint32_t jl_rand_bounded_u32(uint32_t max) JL_NOTSAFEPOINT
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    return jl_rand_bounded(&ptls->rngseed, max);
 }
 
 // initialize the threading infrastructure
@@ -100,6 +285,9 @@ void jl_init_threadinginfra(void)
         else
             sleep_threshold = (uint64_t)strtol(cp, NULL, 10);
     }
+    cp = getenv("JULIA_SCHED_TRACE");
+    if (cp && strcmp(cp, "0") != 0)
+        jl_sched_trace_enable(1);
 }
 
 
@@ -155,8 +343,37 @@ int jl_running_under_rr(int recheck)
 }
 
 
-//  sleep_check_after_threshold() -- if sleep_threshold ns have passed, return 1
-static int sleep_check_after_threshold(uint64_t *start_cycles)
+// Adaptive spin policy: each thread spins for at most sleep_threshold ns
+// before parking, but a thread whose spins keep ending in sleep shrinks its
+// personal budget (down to 1/32 of the configured threshold) so persistently
+// idle threads park quickly, and a thread whose spin pays off with work grows
+// the budget back toward the configured maximum.
+static void spin_shrink(jl_ptls_t ptls) JL_NOTSAFEPOINT
+{
+    if (sleep_threshold == 0 || sleep_threshold == UINT64_MAX)
+        return;
+    uint64_t t = ptls->sleep_threshold_cur;
+    if (t == 0)
+        t = sleep_threshold;
+    uint64_t tmin = sleep_threshold / 32 + 1;
+    t /= 2;
+    ptls->sleep_threshold_cur = t < tmin ? tmin : t;
+}
+
+static void spin_grow(jl_ptls_t ptls) JL_NOTSAFEPOINT
+{
+    if (sleep_threshold == 0 || sleep_threshold == UINT64_MAX)
+        return;
+    uint64_t t = ptls->sleep_threshold_cur;
+    if (t == 0 || t >= sleep_threshold / 2)
+        t = sleep_threshold;
+    else
+        t *= 2;
+    ptls->sleep_threshold_cur = t;
+}
+
+//  sleep_check_after_threshold() -- if the thread's spin budget has passed, return 1
+static int sleep_check_after_threshold(jl_ptls_t ptls, uint64_t *start_cycles)
 {
     JULIA_DEBUG_SLEEPWAKE( return 1 ); // hammer on the sleep/wake logic much harder
     /**
@@ -171,8 +388,11 @@ static int sleep_check_after_threshold(uint64_t *start_cycles)
         *start_cycles = jl_hrtime();
         return 0;
     }
+    uint64_t threshold = ptls->sleep_threshold_cur;
+    if (threshold == 0)
+        threshold = sleep_threshold;
     uint64_t elapsed_cycles = jl_hrtime() - (*start_cycles);
-    if (elapsed_cycles >= sleep_threshold) {
+    if (elapsed_cycles >= threshold) {
         *start_cycles = 0;
         return 1;
     }
@@ -210,13 +430,39 @@ JL_DLLEXPORT void jl_wakeup_thread(int16_t tid)
 {
     jl_task_t *ct = jl_current_task;
     int16_t self = jl_atomic_load_relaxed(&ct->tid);
+    if (sched_trace_on())
+        sched_trace_record(self, JL_SCHED_EV_WAKEUP, tid, NULL);
+    jl_ptls_t ptls = ct->ptls;
+    if (ptls->wake_batch.active) {
+        // inside a uv loop iteration (jl_process_events): defer and
+        // deduplicate; jl_wake_batch_end flushes once per distinct target
+        // after uv_run returns. The memory fences below are performed at
+        // flush time, which is still after every enqueue in the batch.
+        if (tid == self || tid == -1) {
+            ptls->wake_batch.self = 1;
+            if (tid == -1)
+                ptls->wake_batch.broadcast = 1;
+            return;
+        }
+        int32_t n = ptls->wake_batch.ntids;
+        int32_t i = 0;
+        while (i < n && ptls->wake_batch.tids[i] != tid)
+            i++;
+        if (i < n)
+            return;
+        if (n < JL_WAKE_BATCH_TIDS) {
+            ptls->wake_batch.tids[n] = tid;
+            ptls->wake_batch.ntids = n + 1;
+            return;
+        }
+        // table full: deliver this one immediately
+    }
     if (tid != self)
         jl_fence(); // [^store_buffering_1]
     jl_task_t *uvlock = jl_atomic_load_relaxed(&jl_uv_mutex.owner);
     JULIA_DEBUG_SLEEPWAKE( wakeup_enter = cycleclock() );
     if (tid == self || tid == -1) {
         // we're already awake, but make sure we'll exit uv_run
-        jl_ptls_t ptls = ct->ptls;
         if (jl_atomic_load_relaxed(&ptls->sleep_check_state) == sleeping) {
             jl_atomic_store_relaxed(&ptls->sleep_check_state, not_sleeping);
             JL_PROBE_RT_SLEEP_CHECK_WAKEUP(ptls);
@@ -240,13 +486,22 @@ JL_DLLEXPORT void jl_wakeup_thread(int16_t tid)
     }
     // check if the other threads might be sleeping
     if (tid == -1) {
-        // something added to the multi-queue: notify all threads
-        // in the future, we might want to instead wake some fraction of threads,
-        // and let each of those wake additional threads if they find work
+        // something added to the multi-queue: notify one sleeping thread.
+        // Waking every sleeper for each enqueued task causes a futex wake
+        // storm under bursty load; one wake per enqueue is sufficient, and a
+        // woken thread that still observes queued work passes the wake along
+        // (see jl_task_get_next), so throughput ramps without the broadcast.
+        // A rotor spreads wakes across threads instead of hammering thread 1.
+        static _Atomic(uint32_t) wake_rotor;
+        int nt = jl_n_threads;
+        int16_t start = (int16_t)(jl_atomic_fetch_add_relaxed(&wake_rotor, 1) % nt);
         int anysleep = 0;
-        for (tid = 0; tid < jl_n_threads; tid++) {
-            if (tid != self)
-                anysleep |= wake_thread(tid);
+        for (int i = 0; i < nt; i++) {
+            tid = (int16_t)((start + i) % nt);
+            if (tid != self && wake_thread(tid)) {
+                anysleep = 1;
+                break;
+            }
         }
         // check if we need to notify uv_run too
         if (uvlock != ct && anysleep) {
@@ -258,6 +513,49 @@ JL_DLLEXPORT void jl_wakeup_thread(int16_t tid)
     JULIA_DEBUG_SLEEPWAKE( wakeup_leave = cycleclock() );
 }
 
+// Batched wakeups for the libuv event layer. A thread draining a uv loop
+// iteration produces one jl_wakeup_thread call per completed event, each
+// taking the target's sleep_lock and possibly a futex signal; at high event
+// rates that dominates the loop. jl_process_events brackets uv_run with this
+// pair so the requests accumulate in ptls->wake_batch and a single flush
+// afterwards makes one wake decision per distinct target.
+JL_DLLEXPORT void jl_wake_batch_begin(void)
+{
+    jl_current_task->ptls->wake_batch.active++;
+}
+
+JL_DLLEXPORT void jl_wake_batch_end(void)
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    assert(ptls->wake_batch.active > 0);
+    if (--ptls->wake_batch.active)
+        return;
+    int16_t self = ptls->wake_batch.self;
+    int32_t broadcast = ptls->wake_batch.broadcast;
+    int32_t ntids = ptls->wake_batch.ntids;
+    ptls->wake_batch.self = 0;
+    ptls->wake_batch.broadcast = 0;
+    ptls->wake_batch.ntids = 0;
+    if (self) {
+        // we are awake by definition; just make sure we do not go back to
+        // sleep with work pending. No uv_stop: the uv_run this batch
+        // bracketed has already returned.
+        if (jl_atomic_load_relaxed(&ptls->sleep_check_state) == sleeping) {
+            jl_atomic_store_relaxed(&ptls->sleep_check_state, not_sleeping);
+            JL_PROBE_RT_SLEEP_CHECK_WAKEUP(ptls);
+        }
+    }
+    // wake_batch.active is 0 again, so these take the immediate path and
+    // perform the usual fences and uv-lock checks
+    for (int32_t i = 0; i < ntids; i++)
+        jl_wakeup_thread(ptls->wake_batch.tids[i]);
+    if (broadcast)
+        // one wake covers any number of multi-queue enqueues: a woken thread
+        // that still observes queued work passes the wake along (see
+        // jl_task_get_next)
+        jl_wakeup_thread(-1);
+}
+
 
 // get the next runnable task
 static jl_task_t *get_next_task(jl_value_t *trypoptask, jl_value_t *q)
@@ -267,6 +565,8 @@ static jl_task_t *get_next_task(jl_value_t *trypoptask, jl_value_t *q)
     if (jl_typeis(task, jl_task_type)) {
         int self = jl_atomic_load_relaxed(&jl_current_task->tid);
         jl_set_task_tid(task, self);
+        if (sched_trace_on())
+            sched_trace_record((int16_t)self, JL_SCHED_EV_GET_NEXT, -1, task);
         return task;
     }
     return NULL;
@@ -291,24 +591,46 @@ extern _Atomic(unsigned) _threadedregion;
 
 JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q, jl_value_t *checkempty)
 {
+    JL_TIMING(SCHEDULER);
     jl_task_t *ct = jl_current_task;
     uint64_t start_cycles = 0;
+    int woken = 0;
+
+    if (ct->ptls->wake_batch.active) {
+        // an exception thrown from inside a uv callback can unwind past
+        // jl_wake_batch_end; deliver whatever was recorded rather than
+        // deferring wakes forever
+        ct->ptls->wake_batch.active = 1;
+        jl_wake_batch_end();
+    }
 
     while (1) {
+        // in async-finalizer mode the scheduler threads form the pool that
+        // drains the pending list, one bounded chunk per pass; may GC
+        if (jl_gc_async_finalizers &&
+                jl_atomic_load_relaxed(&jl_gc_have_pending_finalizers))
+            jl_gc_run_pending_finalizers(ct);
         jl_task_t *task = get_next_task(trypoptask, q);
-        if (task)
+        if (task) {
+            if (start_cycles)
+                spin_grow(ct->ptls); // spinning paid off; spin longer next time
+            if (woken && !check_empty(checkempty))
+                jl_wakeup_thread(-1); // more work remains: pass the wake along
             return task;
+        }
 
         // quick, race-y check to see if there seems to be any stuff in there
         jl_cpu_pause();
         if (!check_empty(checkempty)) {
+            if (start_cycles)
+                spin_grow(ct->ptls);
             start_cycles = 0;
             continue;
         }
 
         jl_cpu_pause();
         jl_ptls_t ptls = ct->ptls;
-        if (sleep_check_after_threshold(&start_cycles) || (!jl_atomic_load_relaxed(&_threadedregion) && ptls->tid == 0)) {
+        if (sleep_check_after_threshold(ptls, &start_cycles) || (!jl_atomic_load_relaxed(&_threadedregion) && ptls->tid == 0)) {
             // acquire sleep-check lock
             jl_atomic_store_relaxed(&ptls->sleep_check_state, sleeping);
             jl_fence(); // [^store_buffering_1]
@@ -401,7 +723,10 @@ JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q,
             }
 
             // the other threads will just wait for an individual wake signal to resume
+            spin_shrink(ptls); // the spin went to waste; spin less next time
             JULIA_DEBUG_SLEEPWAKE( ptls->sleep_enter = cycleclock() );
+            if (sched_trace_on())
+                sched_trace_record(ptls->tid, JL_SCHED_EV_SLEEP, -1, NULL);
             int8_t gc_state = jl_gc_safe_enter(ptls);
             uv_mutex_lock(&ptls->sleep_lock);
             while (may_sleep(ptls)) {
@@ -410,13 +735,16 @@ JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q,
             }
             assert(jl_atomic_load_relaxed(&ptls->sleep_check_state) == not_sleeping);
             uv_mutex_unlock(&ptls->sleep_lock);
+            if (sched_trace_on())
+                sched_trace_record(ptls->tid, JL_SCHED_EV_WAKE, -1, NULL);
             JULIA_DEBUG_SLEEPWAKE( ptls->sleep_leave = cycleclock() );
             jl_gc_safe_leave(ptls, gc_state); // contains jl_gc_safepoint
             start_cycles = 0;
+            woken = 1;
         }
         else {
             // maybe check the kernel for new messages too
-            jl_process_events();
+            jl_process_events(-1);
         }
     }
 }
@@ -27,6 +27,10 @@ struct AllocOptPass : PassInfoMixin<AllocOptPass> {
     PreservedAnalyses run(Function &F, FunctionAnalysisManager &AM);
 };
 
+struct BoundsCheckElimPass : PassInfoMixin<BoundsCheckElimPass> {
+    PreservedAnalyses run(Function &F, FunctionAnalysisManager &AM);
+};
+
 struct PropagateJuliaAddrspacesPass : PassInfoMixin<PropagateJuliaAddrspacesPass> {
     PreservedAnalyses run(Function &F, FunctionAnalysisManager &AM);
     static bool isRequired() { return true; }
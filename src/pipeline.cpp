@@ -402,6 +402,7 @@ void buildFullPipeline(ModulePassManager &MPM, PassBuilder &PB, OptimizationLeve
         FPM.addPass(SCCPPass());
         FPM.addPass(CorrelatedValuePropagationPass());
         FPM.addPass(DCEPass());
+        FPM.addPass(BoundsCheckElimPass());
         FPM.addPass(IRCEPass());
         FPM.addPass(InstCombinePass());
         FPM.addPass(JumpThreadingPass());
@@ -411,11 +411,43 @@ static void *jl_precompile(int all)
         }
     }
     m = NULL;
+    if (jl_n_threads > 1) {
+        // run type inference for the worklist on all threads before
+        // jl_create_native takes the codegen lock; the emission loop then
+        // finds every instance already inferred in the cache
+        jl_value_t *f = jl_get_global(jl_base_module, jl_symbol("_parallel_precompile_infer"));
+        if (f != NULL) {
+            jl_task_t *ct = jl_current_task;
+            size_t last_age = ct->world_age;
+            ct->world_age = jl_get_world_counter();
+            jl_value_t *args[2] = {f, (jl_value_t*)m2};
+            jl_apply(args, 2);
+            ct->world_age = last_age;
+        }
+    }
     void *native_code = jl_create_native(m2, NULL, NULL, 0);
     JL_GC_POP();
     return native_code;
 }
 
+// run (and cache) type inference for `mi`, mirroring the lookup-miss path of
+// jl_ci_cache_lookup in aotcompile.cpp; called concurrently from the worker
+// tasks spawned by `Base._parallel_precompile_infer`
+JL_DLLEXPORT void jl_precompile_infer(jl_method_instance_t *mi, size_t world)
+{
+    if (jl_rettype_inferred(mi, world, world) != jl_nothing)
+        return;
+    jl_code_info_t *src = jl_type_infer(mi, world, 0);
+    JL_GC_PUSH1(&src);
+    if (src != NULL) {
+        jl_code_instance_t *codeinst = jl_get_method_inferred(
+                mi, src->rettype, src->min_world, src->max_world);
+        if (src->inferred && !codeinst->inferred)
+            codeinst->inferred = jl_nothing;
+    }
+    JL_GC_POP();
+}
+
 #ifdef __cplusplus
 }
 #endif
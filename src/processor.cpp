@@ -633,10 +633,36 @@ static inline jl_sysimg_fptrs_t parse_sysimg(void *hdl, F &&callback)
     jl_dlsym(hdl, "jl_sysimg_fvars_base", (void**)&text_base, 1);
     res.base = text_base;
 
+    // Sharded images (see jl_dump_native_impl) cannot store base-relative
+    // offsets in static data, so their tables hold absolute addresses with a
+    // length prefix instead (see llvm-multiversioning.cpp). Rebase those into
+    // the int32 form the parsing below expects; the converted tables live for
+    // the lifetime of the process.
+    void *abs_marker;
+    bool abs_tables = jl_dlsym(hdl, "jl_sysimg_abs_tables", &abs_marker, 0) != 0;
+    auto rebase_table = [] (const uintptr_t *entries, size_t n, char *base, bool id_value_pairs) {
+        int32_t *out = (int32_t*)malloc(n * sizeof(int32_t));
+        for (size_t i = 0; i < n; i++) {
+            if (id_value_pairs && (i % 2) == 0)
+                out[i] = (int32_t)entries[i];
+            else
+                out[i] = (int32_t)((char*)entries[i] - base);
+        }
+        return out;
+    };
+
     int32_t *offsets;
     jl_dlsym(hdl, "jl_sysimg_fvars_offsets", (void**)&offsets, 1);
-    uint32_t nfunc = offsets[0];
-    res.offsets = offsets + 1;
+    uint32_t nfunc;
+    if (abs_tables) {
+        const uintptr_t *tbl = (const uintptr_t*)offsets;
+        nfunc = (uint32_t)tbl[0];
+        res.offsets = rebase_table(tbl + 1, nfunc, text_base, false);
+    }
+    else {
+        nfunc = offsets[0];
+        res.offsets = offsets + 1;
+    }
 
     void *ids;
     jl_dlsym(hdl, "jl_dispatch_target_ids", &ids, 1);
@@ -644,12 +670,24 @@ static inline jl_sysimg_fptrs_t parse_sysimg(void *hdl, F &&callback)
 
     int32_t *reloc_slots;
     jl_dlsym(hdl, "jl_dispatch_reloc_slots", (void **)&reloc_slots, 1);
-    const uint32_t nreloc = reloc_slots[0];
-    reloc_slots += 1;
+    uint32_t nreloc;
+    if (abs_tables) {
+        const uintptr_t *tbl = (const uintptr_t*)reloc_slots;
+        nreloc = (uint32_t)tbl[0];
+        reloc_slots = rebase_table(tbl + 1, nreloc * 2, data_base, true);
+    }
+    else {
+        nreloc = reloc_slots[0];
+        reloc_slots += 1;
+    }
     uint32_t *clone_idxs;
     int32_t *clone_offsets;
     jl_dlsym(hdl, "jl_dispatch_fvars_idxs", (void**)&clone_idxs, 1);
     jl_dlsym(hdl, "jl_dispatch_fvars_offsets", (void**)&clone_offsets, 1);
+    if (abs_tables) {
+        const uintptr_t *tbl = (const uintptr_t*)clone_offsets;
+        clone_offsets = rebase_table(tbl + 1, tbl[0], text_base, false);
+    }
     uint32_t tag_len = clone_idxs[0];
     clone_idxs += 1;
 
@@ -730,24 +768,24 @@ template<typename T>
 static inline void check_cmdline(T &&cmdline, bool imaging)
 {
     assert(cmdline.size() > 0);
-    // It's unclear what does specifying multiple target when not generating
-    // sysimg means. Make it an error for now.
+    // Specifying multiple targets when not generating a sysimg means
+    // "pick the one that suits this machine best for the JIT"
+    // (see `select_jit_target`). The cloning related options still only
+    // make sense when generating a sysimg.
     if (!imaging) {
-        if (cmdline.size() > 1) {
-            jl_error("More than one command line CPU targets specified "
-                     "without a `--output-` flag specified");
-        }
-        if (cmdline[0].en.flags & JL_TARGET_CLONE_ALL) {
-            jl_error("\"clone_all\" feature specified "
-                     "without a `--output-` flag specified");
-        }
-        if (cmdline[0].en.flags & JL_TARGET_OPTSIZE) {
-            jl_error("\"opt_size\" feature specified "
-                     "without a `--output-` flag specified");
-        }
-        if (cmdline[0].en.flags & JL_TARGET_MINSIZE) {
-            jl_error("\"min_size\" feature specified "
-                     "without a `--output-` flag specified");
+        for (auto &t: cmdline) {
+            if (t.en.flags & JL_TARGET_CLONE_ALL) {
+                jl_error("\"clone_all\" feature specified "
+                         "without a `--output-` flag specified");
+            }
+            if (t.en.flags & JL_TARGET_OPTSIZE) {
+                jl_error("\"opt_size\" feature specified "
+                         "without a `--output-` flag specified");
+            }
+            if (t.en.flags & JL_TARGET_MINSIZE) {
+                jl_error("\"min_size\" feature specified "
+                         "without a `--output-` flag specified");
+            }
         }
     }
 }
@@ -803,6 +841,36 @@ static inline SysimgMatch match_sysimg_targets(S &&sysimg, T &&target, F &&max_v
     return match;
 }
 
+// Pick among multiple command line targets when no sysimg is being generated.
+// The JIT compiles everything on the machine that runs it, so there is no
+// point in cloning per target the way sysimg generation does; instead the
+// candidates are matched against the host the same way the targets stored in
+// a sysimg are and the JIT compiles for the winner. Prefer the widest
+// host-supported vector register, then the largest feature set, and fall back
+// to the first (baseline) target when none of the others fit the host.
+template<typename T, typename H, typename F>
+static inline uint32_t select_jit_target(T &&candidates, H &&host, F &&max_vector_size)
+{
+    uint32_t best_idx = 0;
+    int best_vsz = 0;
+    int best_nbits = 0;
+    for (uint32_t i = 0; i < candidates.size(); i++) {
+        auto &t = candidates[i];
+        // Check candidate enabled features against host disabled features,
+        // the same validity check `match_sysimg_targets` does.
+        if (!(t.en.features & host.dis.features).empty())
+            continue;
+        int vsz = max_vector_size(t.en.features);
+        int nbits = t.en.features.nbits();
+        if (vsz < best_vsz || (vsz == best_vsz && nbits <= best_nbits))
+            continue;
+        best_idx = i;
+        best_vsz = vsz;
+        best_nbits = nbits;
+    }
+    return best_idx;
+}
+
 // Debug helper
 
 template<typename CPU, size_t n>
@@ -851,3 +919,16 @@ static inline void dump_cpu_spec(uint32_t cpu, const FeatureList<n> &features,
 #include "processor_fallback.cpp"
 
 #endif
+
+// Host topology snapshot for the blocking-parameter API. The probe only runs
+// once; the architecture files provide probe_cpu_topology above.
+extern "C" JL_DLLEXPORT const jl_cpu_topology_t *jl_cpu_topology(void)
+{
+    static const jl_cpu_topology_t topo = [] {
+        jl_cpu_topology_t t = {};
+        t.logical_cpus = jl_cpu_threads();
+        probe_cpu_topology(&t);
+        return t;
+    }();
+    return &topo;
+}
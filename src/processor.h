@@ -89,6 +89,16 @@ extern "C" {
  *     this array as the original/base function offsets.
  *     For other targets, this variable contains an offset array with the length defined in
  *     `jl_dispatch_fvars_idxs`. Tagged indices need relocations.
+ *
+ * # Sharded images
+ * When the image is emitted as multiple object shards (`JULIA_IMAGE_THREADS`,
+ * see `jl_dump_native_impl`), base-relative `int32_t` offsets cannot be
+ * expressed in static data because the symbols they subtract may live in
+ * different objects. Such images export `jl_sysimg_abs_tables` and store every
+ * offset table (`jl_sysimg_{f,g}vars_offsets`, `jl_dispatch_reloc_slots`,
+ * `jl_dispatch_fvars_offsets`) as pointer-sized absolute addresses with a
+ * pointer-sized length prefix; the loader rebases them into the `int32_t`
+ * form described above before use. `jl_dispatch_fvars_idxs` is unchanged.
  */
 
 enum {
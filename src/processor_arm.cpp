@@ -1561,11 +1561,29 @@ static int max_vector_size(const FeatureList<feature_sz> &features)
 #endif
 }
 
+// Index of the command line target the JIT should compile for.
+// With a single target (the common case) this is trivially the first one;
+// a multi-target specification outside of sysimg generation selects the best
+// host-supported candidate, so e.g. a session launched with a deployment
+// image's full target string still vectorizes for the local CPU.
+static uint32_t jit_cmdline_idx(void)
+{
+    auto &cmdline = get_cmdline_targets();
+    if (cmdline.size() == 1)
+        return 0;
+    std::vector<TargetData<feature_sz>> candidates;
+    for (auto &arg: cmdline)
+        candidates.push_back(arg_target_data(arg, false));
+    TargetData<feature_sz> host{};
+    host.name = "native";
+    return select_jit_target(candidates, arg_target_data(host, true), max_vector_size);
+}
+
 static uint32_t sysimg_init_cb(const void *id)
 {
     // First see what target is requested for the JIT.
     auto &cmdline = get_cmdline_targets();
-    TargetData<feature_sz> target = arg_target_data(cmdline[0], true);
+    TargetData<feature_sz> target = arg_target_data(cmdline[jit_cmdline_idx()], true);
     // Then find the best match in the sysimg
     auto sysimg = deserialize_target_data<feature_sz>((const uint8_t*)id);
     for (auto &t: sysimg) {
@@ -1592,6 +1610,11 @@ static void ensure_jit_target(bool imaging)
     check_cmdline(cmdline, imaging);
     if (!jit_targets.empty())
         return;
+    if (!imaging) {
+        // The JIT only ever compiles for one target; pick the best one.
+        jit_targets.push_back(arg_target_data(cmdline[jit_cmdline_idx()], true));
+        return;
+    }
     for (auto &arg: cmdline) {
         auto data = arg_target_data(arg, jit_targets.empty());
         jit_targets.push_back(std::move(data));
@@ -1770,6 +1793,95 @@ static FeatureList<feature_sz> get_max_feature(void)
 
 using namespace ARM;
 
+#if defined(_OS_LINUX_)
+// count the logical CPU ids named by a sysfs cpulist ("0-3,8-11")
+static int count_sysfs_cpulist(const std::string &s)
+{
+    int count = 0;
+    const char *p = s.c_str();
+    while (*p) {
+        char *end;
+        long a = strtol(p, &end, 10);
+        if (end == p)
+            break;
+        long b = a;
+        p = end;
+        if (*p == '-') {
+            b = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        count += (int)(b - a + 1);
+        if (*p == ',')
+            p++;
+    }
+    return count;
+}
+
+static bool read_sysfs_line(const std::string &path, std::string &out)
+{
+    std::ifstream f(path);
+    if (!f)
+        return false;
+    std::getline(f, out);
+    return !out.empty();
+}
+#endif
+
+// Cache and core topology enumeration backing jl_cpu_topology (processor.cpp).
+// ARM does not architect a cache enumeration interface usable from EL0, so
+// read the kernel's view from sysfs like the /proc/cpuinfo parsing above.
+static void probe_cpu_topology(jl_cpu_topology_t *topo)
+{
+#if defined(_OS_LINUX_)
+    for (int idx = 0; idx < 8; idx++) {
+        std::string base = "/sys/devices/system/cpu/cpu0/cache/index" +
+                           std::to_string(idx) + "/";
+        std::string type, line;
+        if (!read_sysfs_line(base + "type", type))
+            break;
+        if (type == "Instruction")
+            continue;
+        long level = 0, size = 0, linesize = 0;
+        if (read_sysfs_line(base + "level", line))
+            level = strtol(line.c_str(), NULL, 10);
+        if (read_sysfs_line(base + "size", line)) {
+            char *end;
+            size = strtol(line.c_str(), &end, 10);
+            if (*end == 'K')
+                size *= 1024;
+            else if (*end == 'M')
+                size *= 1024 * 1024;
+        }
+        if (read_sysfs_line(base + "coherency_line_size", line))
+            linesize = strtol(line.c_str(), NULL, 10);
+        int sharing = 0;
+        if (read_sysfs_line(base + "shared_cpu_list", line))
+            sharing = count_sysfs_cpulist(line);
+        if (level == 1 && type == "Data") {
+            topo->l1d_size = (uint32_t)size;
+            topo->l1d_linesize = (uint32_t)linesize;
+        }
+        else if (level == 2) {
+            topo->l2_size = (uint32_t)size;
+            topo->l2_sharing = (uint32_t)sharing;
+        }
+        else if (level == 3) {
+            topo->l3_size = (uint32_t)size;
+            topo->l3_sharing = (uint32_t)sharing;
+        }
+    }
+    std::string siblings;
+    if (read_sysfs_line("/sys/devices/system/cpu/cpu0/topology/thread_siblings_list",
+                        siblings))
+        topo->smt_threads = count_sysfs_cpulist(siblings);
+#endif
+    if (topo->smt_threads <= 0)
+        topo->smt_threads = 1;
+    uint32_t llc_sharing = topo->l3_sharing ? topo->l3_sharing : topo->l2_sharing;
+    if (llc_sharing)
+        topo->cores_per_llc = llc_sharing / topo->smt_threads;
+}
+
 JL_DLLEXPORT void jl_dump_host_cpu(void)
 {
     dump_cpu_spec(get_host_cpu().first, get_host_cpu().second, feature_names, nfeature_names,
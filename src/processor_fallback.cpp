@@ -33,11 +33,27 @@ static TargetData<1> arg_target_data(const TargetData<1> &arg, bool require_host
     return res;
 }
 
+// Index of the command line target the JIT should compile for.
+// There is no feature information here so when more than one target is
+// specified outside of sysimg generation we can only prefer an exact
+// host name match over the baseline.
+static uint32_t jit_cmdline_idx(void)
+{
+    auto &cmdline = get_cmdline_targets();
+    uint32_t best_idx = 0;
+    for (uint32_t i = 1; i < cmdline.size(); i++) {
+        if (cmdline[i].name == host_cpu_name()) {
+            best_idx = i;
+        }
+    }
+    return best_idx;
+}
+
 static uint32_t sysimg_init_cb(const void *id)
 {
     // First see what target is requested for the JIT.
     auto &cmdline = get_cmdline_targets();
-    TargetData<1> target = arg_target_data(cmdline[0], true);
+    TargetData<1> target = arg_target_data(cmdline[jit_cmdline_idx()], true);
     // Find the last name match or use the default one.
     uint32_t best_idx = 0;
     auto sysimg = deserialize_target_data<1>((const uint8_t*)id);
@@ -57,6 +73,11 @@ static void ensure_jit_target(bool imaging)
     check_cmdline(cmdline, imaging);
     if (!jit_targets.empty())
         return;
+    if (!imaging) {
+        // The JIT only ever compiles for one target; pick the best one.
+        jit_targets.push_back(arg_target_data(cmdline[jit_cmdline_idx()], true));
+        return;
+    }
     for (auto &arg: cmdline) {
         auto data = arg_target_data(arg, jit_targets.empty());
         jit_targets.push_back(std::move(data));
@@ -145,6 +166,13 @@ JL_DLLEXPORT void jl_dump_host_cpu(void)
     jl_safe_printf("Features: %s\n", jl_get_cpu_features_llvm().c_str());
 }
 
+// no cache enumeration on unknown architectures; jl_cpu_topology reports
+// everything as unknown
+static void probe_cpu_topology(jl_cpu_topology_t *topo)
+{
+    topo->smt_threads = 1;
+}
+
 extern "C" int jl_test_cpu_feature(jl_cpu_feature_t)
 {
     return 0;
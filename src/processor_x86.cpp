@@ -834,11 +834,29 @@ static int max_vector_size(const FeatureList<feature_sz> &features)
     return 16;
 }
 
+// Index of the command line target the JIT should compile for.
+// With a single target (the common case) this is trivially the first one;
+// a multi-target specification outside of sysimg generation selects the best
+// host-supported candidate, so e.g. a session launched with a deployment
+// image's full target string still vectorizes for the local CPU.
+static uint32_t jit_cmdline_idx(void)
+{
+    auto &cmdline = get_cmdline_targets();
+    if (cmdline.size() == 1)
+        return 0;
+    std::vector<TargetData<feature_sz>> candidates;
+    for (auto &arg: cmdline)
+        candidates.push_back(arg_target_data(arg, false));
+    TargetData<feature_sz> host{};
+    host.name = "native";
+    return select_jit_target(candidates, arg_target_data(host, true), max_vector_size);
+}
+
 static uint32_t sysimg_init_cb(const void *id)
 {
     // First see what target is requested for the JIT.
     auto &cmdline = get_cmdline_targets();
-    TargetData<feature_sz> target = arg_target_data(cmdline[0], true);
+    TargetData<feature_sz> target = arg_target_data(cmdline[jit_cmdline_idx()], true);
     // Then find the best match in the sysimg
     auto sysimg = deserialize_target_data<feature_sz>((const uint8_t*)id);
     // We translate `generic` to `pentium4` or `x86-64` before sending it to LLVM
@@ -884,6 +902,11 @@ static void ensure_jit_target(bool imaging)
     check_cmdline(cmdline, imaging);
     if (!jit_targets.empty())
         return;
+    if (!imaging) {
+        // The JIT only ever compiles for one target; pick the best one.
+        jit_targets.push_back(arg_target_data(cmdline[jit_cmdline_idx()], true));
+        return;
+    }
     for (auto &arg: cmdline) {
         auto data = arg_target_data(arg, jit_targets.empty());
         jit_targets.push_back(std::move(data));
@@ -1000,6 +1023,69 @@ get_llvm_target_str(const TargetData<feature_sz> &data)
 
 using namespace X86;
 
+// Cache and core topology enumeration backing jl_cpu_topology (processor.cpp).
+// Walks the deterministic cache parameter leaves (4 on Intel, 0x8000001d on
+// AMD processors with topology extensions) and the extended topology leaf 0xb
+// for the SMT width.
+static void probe_cpu_topology(jl_cpu_topology_t *topo)
+{
+    int32_t info0[4];
+    jl_cpuid(info0, 0);
+    uint32_t maxleaf = info0[0];
+    auto vendor = info0[1];
+    int32_t infoex0[4];
+    jl_cpuid(infoex0, 0x80000000);
+    uint32_t maxexleaf = infoex0[0];
+    uint32_t cache_leaf = 0;
+    if (vendor == SIG_AMD && maxexleaf >= 0x8000001d) {
+        int32_t infoex1[4];
+        jl_cpuid(infoex1, 0x80000001);
+        if (infoex1[2] & (1 << 22)) // topology extensions
+            cache_leaf = 0x8000001d;
+    }
+    else if (vendor == SIG_INTEL && maxleaf >= 4) {
+        cache_leaf = 4;
+    }
+    for (uint32_t sub = 0; cache_leaf && sub < 16; sub++) {
+        int32_t ci[4];
+        jl_cpuidex(ci, cache_leaf, sub);
+        uint32_t type = ci[0] & 0x1f;
+        if (type == 0)
+            break;
+        if (type == 2) // instruction cache
+            continue;
+        uint32_t level = (ci[0] >> 5) & 0x7;
+        uint32_t sharing = (((uint32_t)ci[0] >> 14) & 0xfff) + 1;
+        uint32_t line = ((uint32_t)ci[1] & 0xfff) + 1;
+        uint32_t partitions = (((uint32_t)ci[1] >> 12) & 0x3ff) + 1;
+        uint32_t ways = (((uint32_t)ci[1] >> 22) & 0x3ff) + 1;
+        uint32_t size = ways * partitions * line * ((uint32_t)ci[2] + 1);
+        if (level == 1 && type == 1) { // data cache
+            topo->l1d_size = size;
+            topo->l1d_linesize = line;
+        }
+        else if (level == 2) {
+            topo->l2_size = size;
+            topo->l2_sharing = sharing;
+        }
+        else if (level == 3) {
+            topo->l3_size = size;
+            topo->l3_sharing = sharing;
+        }
+    }
+    if (maxleaf >= 0xb) {
+        int32_t ti[4];
+        jl_cpuidex(ti, 0xb, 0);
+        if ((((uint32_t)ti[2] >> 8) & 0xff) == 1) // level type SMT
+            topo->smt_threads = ti[1] & 0xffff;
+    }
+    if (topo->smt_threads == 0)
+        topo->smt_threads = 1;
+    uint32_t llc_sharing = topo->l3_sharing ? topo->l3_sharing : topo->l2_sharing;
+    if (llc_sharing)
+        topo->cores_per_llc = llc_sharing / topo->smt_threads;
+}
+
 JL_DLLEXPORT void jl_dump_host_cpu(void)
 {
     dump_cpu_spec(get_host_cpu().first, get_host_cpu().second, feature_names, nfeature_names,
@@ -30,6 +30,16 @@ extern "C" {
 
 // exceptions -----------------------------------------------------------------
 
+// Failure path of `jl_invariant` (julia_internal.h) in WITH_VERIFY=1 builds.
+// The runtime state is untrusted once an invariant breaks, so report and
+// abort instead of raising a catchable exception.
+JL_DLLEXPORT void JL_NORETURN jl_invariant_fail(const char *expr, const char *file,
+                                                int line)
+{
+    jl_safe_printf("Invariant violated at %s:%d: %s\n", file, line, expr);
+    abort();
+}
+
 JL_DLLEXPORT void JL_NORETURN jl_error(const char *str)
 {
     if (jl_errorexception_type == NULL) {
@@ -330,11 +340,19 @@ static void jl_reserve_excstack(jl_excstack_t **stack JL_REQUIRE_ROOTED_SLOT,
     jl_excstack_t *s = *stack;
     if (s && s->reserved_size >= reserved_size)
         return;
-    size_t bufsz = sizeof(jl_excstack_t) + sizeof(uintptr_t)*reserved_size;
+    // Grow geometrically from a floor rather than to the exact requested
+    // size. The buffer stays on the task across handlers, so catch-heavy
+    // retry loops reach a steady state where no throw allocates, instead of
+    // reallocating whenever a backtrace comes in slightly larger than any
+    // seen on this task before.
+    size_t new_size = s ? s->reserved_size : JL_EXCSTACK_MIN_RESERVE;
+    while (new_size < reserved_size)
+        new_size *= 2;
+    size_t bufsz = sizeof(jl_excstack_t) + sizeof(uintptr_t)*new_size;
     jl_task_t *ct = jl_current_task;
     jl_excstack_t *new_s = (jl_excstack_t*)jl_gc_alloc_buf(ct->ptls, bufsz);
     new_s->top = 0;
-    new_s->reserved_size = reserved_size;
+    new_s->reserved_size = new_size;
     if (s)
         jl_copy_excstack(new_s, s);
     *stack = new_s;
@@ -653,6 +671,19 @@ static int is_globfunction(jl_value_t *v, jl_datatype_t *dv, jl_sym_t **globname
     return 0;
 }
 
+// print a signed decimal integer via uint2str, skipping the printf machinery
+static size_t jl_static_show_dec(JL_STREAM *out, int64_t v) JL_NOTSAFEPOINT
+{
+    char buf[22]; // up to 20 digits, sign, and the terminator
+    uint64_t u = v < 0 ? -(uint64_t)v : (uint64_t)v;
+    char *s = uint2str(buf, sizeof(buf), u, 10);
+    if (v < 0)
+        *--s = '-';
+    size_t len = (size_t)(&buf[sizeof(buf) - 1] - s);
+    jl_uv_puts(out, s, len);
+    return len;
+}
+
 static size_t jl_static_show_x_sym_escaped(JL_STREAM *out, jl_sym_t *name) JL_NOTSAFEPOINT
 {
     size_t n = 0;
@@ -673,6 +704,87 @@ static size_t jl_static_show_x_sym_escaped(JL_STREAM *out, jl_sym_t *name) JL_NO
     return n;
 }
 
+// Render cache for fully qualified type names, keyed by typename. A name and
+// its module path never change once created, so entries need no invalidation.
+// Slots are published once and never replaced, so a lookup is a single atomic
+// load and the cache stays safe to consult from error paths and signal
+// handlers; a slot collision just prints the slow way.
+typedef struct {
+    jl_typename_t *name;
+    jl_sym_t *sym;   // cross-checked on hit, in case `name` was freed and its
+                     // address reused by a different typename
+    size_t len;
+    char str[];
+} jl_qualname_render_t;
+
+#define QUALNAME_CACHE_SIZE 512
+static _Atomic(jl_qualname_render_t*) qualname_cache[QUALNAME_CACHE_SIZE];
+
+static size_t jl_static_show_qualname(JL_STREAM *out, jl_datatype_t *dv,
+                                      struct recur_list *depth) JL_NOTSAFEPOINT
+{
+    jl_typename_t *tn = dv->name;
+    size_t slot = ((uintptr_t)tn / sizeof(void*)) % QUALNAME_CACHE_SIZE;
+    jl_qualname_render_t *ent = jl_atomic_load_acquire(&qualname_cache[slot]);
+    if (ent != NULL && ent->name == tn && ent->sym == tn->name) {
+        jl_uv_puts(out, ent->str, ent->len);
+        return ent->len;
+    }
+    // render to memory so the result can be published for next time
+    jl_sym_t *sym = tn->name;
+    ios_t buf;
+    ios_mem(&buf, 64);
+    if (jl_core_module && (tn->module != jl_core_module ||
+                           !jl_module_exports_p(jl_core_module, sym))) {
+        jl_static_show_x((JL_STREAM*)&buf, (jl_value_t*)tn->module, depth);
+        jl_printf((JL_STREAM*)&buf, ".");
+    }
+    jl_static_show_x_sym_escaped((JL_STREAM*)&buf, sym);
+    size_t len = (size_t)buf.bpos;
+    jl_uv_puts(out, buf.buf, len);
+    if (ent == NULL && jl_core_module) {
+        jl_qualname_render_t *newent =
+            (jl_qualname_render_t*)malloc(sizeof(jl_qualname_render_t) + len);
+        if (newent != NULL) {
+            newent->name = tn;
+            newent->sym = sym;
+            newent->len = len;
+            memcpy(newent->str, buf.buf, len);
+            jl_qualname_render_t *expect = NULL;
+            if (!jl_atomic_cmpswap(&qualname_cache[slot], &expect, newent))
+                free(newent);
+        }
+    }
+    ios_close(&buf);
+    return len;
+}
+
+// A length-bounded sink for jl_static_show: output past `limit` bytes is
+// dropped and the recursion stops descending once the limit is reached, so
+// formatting a huge type for an error message costs O(limit) rather than
+// O(size of the type tree). The magic in `userdata` (otherwise unused for
+// ios streams) lets the recursion recognize its own sink; other ios or uv
+// streams passed to jl_static_show are unaffected.
+#define JL_STATIC_SHOW_BOUNDED_MAGIC ((int64_t)0x4a4c53686f774c6dLL)
+typedef struct {
+    ios_t ios;    // first field: this is what the recursion writes to
+    size_t limit;
+    int truncated;
+} jl_static_show_sink_t;
+
+static jl_static_show_sink_t *jl_static_show_get_sink(JL_STREAM *out) JL_NOTSAFEPOINT
+{
+    if (out == (JL_STREAM*)(uintptr_t)STDOUT_FILENO ||
+        out == (JL_STREAM*)(uintptr_t)STDERR_FILENO)
+        return NULL;
+    ios_t *s = (ios_t*)out;
+    // same layout trick as jl_uv_puts: the ios bm field aliases the uv type
+    // field, and bufmode values start above the uv handle type range
+    if (s->bm != bm_mem || s->userdata != JL_STATIC_SHOW_BOUNDED_MAGIC)
+        return NULL;
+    return (jl_static_show_sink_t*)s;
+}
+
 // `jl_static_show()` cannot call `jl_subtype()`, for the GC reasons
 // explained in the comment on `jl_static_show_x_()`, below.
 // This function checks if `vt <: Function` without triggering GC.
@@ -818,23 +930,25 @@ static size_t jl_static_show_x_(JL_STREAM *out, jl_value_t *v, jl_datatype_t *vt
         }
         if (globfunc) {
             n += jl_printf(out, "typeof(");
-        }
-        if (jl_core_module && (dv->name->module != jl_core_module || !jl_module_exports_p(jl_core_module, sym))) {
-            n += jl_static_show_x(out, (jl_value_t*)dv->name->module, depth);
-            n += jl_printf(out, ".");
-            size_t i = 0;
-            if (globfunc && !jl_id_start_char(u8_nextchar(sn, &i))) {
-                n += jl_printf(out, ":(");
-                quote = 1;
+            if (jl_core_module && (dv->name->module != jl_core_module || !jl_module_exports_p(jl_core_module, sym))) {
+                n += jl_static_show_x(out, (jl_value_t*)dv->name->module, depth);
+                n += jl_printf(out, ".");
+                size_t i = 0;
+                if (!jl_id_start_char(u8_nextchar(sn, &i))) {
+                    n += jl_printf(out, ":(");
+                    quote = 1;
+                }
             }
-        }
-        n += jl_static_show_x_sym_escaped(out, sym);
-        if (globfunc) {
+            n += jl_static_show_x_sym_escaped(out, sym);
             n += jl_printf(out, ")");
             if (quote) {
                 n += jl_printf(out, ")");
             }
         }
+        else {
+            // the common case prints `Module.Path.Name`, which is memoized
+            n += jl_static_show_qualname(out, dv, depth);
+        }
         if (dv->parameters && (jl_value_t*)dv != dv->name->wrapper) {
             size_t j, tlen = jl_nparams(dv);
             if (tlen > 0) {
@@ -854,16 +968,16 @@ static size_t jl_static_show_x_(JL_STREAM *out, jl_value_t *v, jl_datatype_t *vt
         n += jl_printf(out, "#<intrinsic #%d %s>", f, jl_intrinsic_name(f));
     }
     else if (vt == jl_int64_type) {
-        n += jl_printf(out, "%" PRId64, *(int64_t*)v);
+        n += jl_static_show_dec(out, *(int64_t*)v);
     }
     else if (vt == jl_int32_type) {
-        n += jl_printf(out, "%" PRId32, *(int32_t*)v);
+        n += jl_static_show_dec(out, *(int32_t*)v);
     }
     else if (vt == jl_int16_type) {
-        n += jl_printf(out, "%" PRId16, *(int16_t*)v);
+        n += jl_static_show_dec(out, *(int16_t*)v);
     }
     else if (vt == jl_int8_type) {
-        n += jl_printf(out, "%" PRId8, *(int8_t*)v);
+        n += jl_static_show_dec(out, *(int8_t*)v);
     }
     else if (vt == jl_uint64_type) {
         n += jl_printf(out, "0x%016" PRIx64, *(uint64_t*)v);
@@ -1206,6 +1320,12 @@ static size_t jl_static_show_next_(JL_STREAM *out, jl_value_t *v, jl_value_t *pr
     else if ((uintptr_t)v < 4096U) {
         return jl_printf(out, "#<%d>", (int)(uintptr_t)v);
     }
+    jl_static_show_sink_t *sink = jl_static_show_get_sink(out);
+    if (sink != NULL && (size_t)sink->ios.bpos >= sink->limit) {
+        // bounded mode: the limit is reached, stop descending
+        sink->truncated = 1;
+        return 0;
+    }
     unsigned int dist = 1;
     struct recur_list this_item = {depth, v},
                       *newdepth = &this_item,
@@ -1256,6 +1376,28 @@ JL_DLLEXPORT size_t jl_static_show(JL_STREAM *out, jl_value_t *v) JL_NOTSAFEPOIN
     return jl_static_show_x(out, v, 0);
 }
 
+// like jl_static_show, but print at most `limit` bytes, appending "..." when
+// the representation was cut short
+JL_DLLEXPORT size_t jl_static_show_bounded(JL_STREAM *out, jl_value_t *v, size_t limit) JL_NOTSAFEPOINT
+{
+    jl_static_show_sink_t sink;
+    ios_mem(&sink.ios, limit < IOS_BUFSIZE ? limit + 1 : IOS_BUFSIZE);
+    sink.ios.userdata = JL_STATIC_SHOW_BOUNDED_MAGIC;
+    sink.limit = limit;
+    sink.truncated = 0;
+    jl_static_show_x((JL_STREAM*)&sink.ios, v, 0);
+    size_t len = (size_t)sink.ios.bpos;
+    if (len > limit) {
+        len = limit;
+        sink.truncated = 1;
+    }
+    jl_uv_puts(out, sink.ios.buf, len);
+    if (sink.truncated)
+        len += jl_printf(out, "...");
+    ios_close(&sink.ios);
+    return len;
+}
+
 JL_DLLEXPORT size_t jl_static_show_func_sig(JL_STREAM *s, jl_value_t *type) JL_NOTSAFEPOINT
 {
     size_t n = 0;
@@ -208,48 +208,75 @@ extern "C" JL_DLLEXPORT char *jl_format_filename(const char *output_pattern)
 }
 
 
-static uv_mutex_t trampoline_lock; // for accesses to the cache and freelist
+// The per-call-site trampoline caches are tiny; what contends under heavy
+// cfunction registration is the single lock that used to sit in front of all
+// of them. Stripe the lock by cache table so unrelated call sites no longer
+// serialize. A table is always guarded by the same stripe, so each cache
+// still sees plain locked access (ptrhash is not safe for lockless readers
+// during a rehash).
+#define TRAMPOLINE_LOCK_SHARDS 32
+static uv_mutex_t trampoline_locks[TRAMPOLINE_LOCK_SHARDS];
+static uv_mutex_t trampoline_alloc_lock; // serializes freelist pops and slab mapping
 
-static void *trampoline_freelist;
+static uv_mutex_t *trampoline_lock_for(htable_t *cache) JL_NOTSAFEPOINT
+{
+    uintptr_t h = (uintptr_t)cache;
+    return &trampoline_locks[(h >> 4) % TRAMPOLINE_LOCK_SHARDS];
+}
+
+static _Atomic(void*) trampoline_freelist;
 
-static void *trampoline_alloc() JL_NOTSAFEPOINT // lock taken by caller
+static void *trampoline_alloc() JL_NOTSAFEPOINT // allocation lock taken by caller
 {
     const int sz = 64; // oversized for most platforms. todo: use precise value?
-    if (!trampoline_freelist) {
-        int last_errno = errno;
+    // pops are serialized by the allocation lock, so a node we read here
+    // cannot be recycled before the cmpswap (no ABA); concurrent lock-free
+    // pushes from trampoline_free only fail the cmpswap and we reload
+    void *tramp = jl_atomic_load_acquire(&trampoline_freelist);
+    while (tramp) {
+        if (jl_atomic_cmpswap(&trampoline_freelist, &tramp, *(void**)tramp))
+            return tramp;
+    }
+    int last_errno = errno;
 #ifdef _OS_WINDOWS_
-        DWORD last_error = GetLastError();
-        void *mem = VirtualAlloc(NULL, jl_page_size,
-                MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE);
-        if (mem == NULL)
-            jl_throw(jl_memory_exception);
-        SetLastError(last_error);
+    DWORD last_error = GetLastError();
+    void *mem = VirtualAlloc(NULL, jl_page_size,
+            MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+    if (mem == NULL)
+        jl_throw(jl_memory_exception);
+    SetLastError(last_error);
 #else
-        void *mem = mmap(0, jl_page_size, PROT_READ | PROT_WRITE | PROT_EXEC,
-                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-        errno = last_errno;
-        if (mem == MAP_FAILED)
-            jl_throw(jl_memory_exception);
+    void *mem = mmap(0, jl_page_size, PROT_READ | PROT_WRITE | PROT_EXEC,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    errno = last_errno;
+    if (mem == MAP_FAILED)
+        jl_throw(jl_memory_exception);
 #endif
-        errno = last_errno;
-        void *next = NULL;
-        assert(sz < jl_page_size);
-        for (size_t i = 0; i + sz <= jl_page_size; i += sz) {
-            void **curr = (void**)((char*)mem + i);
-            *curr = next;
-            next = (void*)curr;
-        }
-        trampoline_freelist = next;
+    errno = last_errno;
+    void *next = NULL;
+    assert(sz < jl_page_size);
+    for (size_t i = 0; i + sz <= jl_page_size; i += sz) {
+        void **curr = (void**)((char*)mem + i);
+        *curr = next;
+        next = (void*)curr;
     }
-    void *tramp = trampoline_freelist;
-    trampoline_freelist = *(void**)tramp;
+    // keep the topmost slot and publish the rest of the slab; the chain
+    // terminates at `mem`, so splice whatever was pushed meanwhile there
+    tramp = next;
+    void *rest = *(void**)tramp;
+    void *head = jl_atomic_load_relaxed(&trampoline_freelist);
+    do {
+        *(void**)mem = head;
+    } while (!jl_atomic_cmpswap(&trampoline_freelist, &head, rest));
     return tramp;
 }
 
-static void trampoline_free(void *tramp) JL_NOTSAFEPOINT    // lock taken by caller
+static void trampoline_free(void *tramp) JL_NOTSAFEPOINT // lock-free
 {
-    *(void**)tramp = trampoline_freelist;
-    trampoline_freelist = tramp;
+    void *head = jl_atomic_load_relaxed(&trampoline_freelist);
+    do {
+        *(void**)tramp = head;
+    } while (!jl_atomic_cmpswap(&trampoline_freelist, &head, tramp));
 }
 
 static void trampoline_deleter(void **f) JL_NOTSAFEPOINT
@@ -261,14 +288,16 @@ static void trampoline_deleter(void **f) JL_NOTSAFEPOINT
     f[0] = NULL;
     f[2] = NULL;
     f[3] = NULL;
-    uv_mutex_lock(&trampoline_lock);
     if (tramp)
         trampoline_free(tramp);
-    if (fobj && cache)
+    if (fobj && cache) {
+        uv_mutex_t *lock = trampoline_lock_for((htable_t*)cache);
+        uv_mutex_lock(lock);
         ptrhash_remove((htable_t*)cache, fobj);
+        uv_mutex_unlock(lock);
+    }
     if (nval)
         free(nval);
-    uv_mutex_unlock(&trampoline_lock);
 }
 
 typedef void *(*init_trampoline_t)(void *tramp, void **nval) JL_NOTSAFEPOINT;
@@ -288,7 +317,8 @@ jl_value_t *jl_get_cfunction_trampoline(
     jl_value_t **vals)
 {
     // lookup (fobj, vals) in cache
-    uv_mutex_lock(&trampoline_lock);
+    uv_mutex_t *lock = trampoline_lock_for(cache);
+    uv_mutex_lock(lock);
     if (!cache->table)
         htable_new(cache, 1);
     if (fill != jl_emptysvec) {
@@ -298,9 +328,14 @@ jl_value_t *jl_get_cfunction_trampoline(
             cache = htable_new((htable_t*)malloc_s(sizeof(htable_t)), 1);
             *cache2 = cache;
         }
+        // the inner table has its own stripe; the deleter only sees the
+        // inner table, so all of its accesses must go through that stripe
+        uv_mutex_unlock(lock);
+        lock = trampoline_lock_for(cache);
+        uv_mutex_lock(lock);
     }
     void *tramp = ptrhash_get(cache, (void*)fobj);
-    uv_mutex_unlock(&trampoline_lock);
+    uv_mutex_unlock(lock);
     if (tramp != HT_NOTFOUND) {
         assert((jl_datatype_t*)jl_typeof(tramp) == result_type);
         return (jl_value_t*)tramp;
@@ -350,12 +385,14 @@ jl_value_t *jl_get_cfunction_trampoline(
         free(nval);
         jl_rethrow();
     }
-    uv_mutex_lock(&trampoline_lock);
+    uv_mutex_lock(&trampoline_alloc_lock);
     tramp = trampoline_alloc();
+    uv_mutex_unlock(&trampoline_alloc_lock);
     ((void**)result)[0] = tramp;
-    tramp = init_trampoline(tramp, nval);
+    tramp = init_trampoline(tramp, nval); // the slot is exclusively ours until published
+    uv_mutex_lock(lock);
     ptrhash_put(cache, (void*)fobj, result);
-    uv_mutex_unlock(&trampoline_lock);
+    uv_mutex_unlock(lock);
     return result;
 }
 JL_GCC_IGNORE_STOP
@@ -363,5 +400,7 @@ JL_GCC_IGNORE_STOP
 void jl_init_runtime_ccall(void)
 {
     JL_MUTEX_INIT(&libmap_lock);
-    uv_mutex_init(&trampoline_lock);
+    for (int i = 0; i < TRAMPOLINE_LOCK_SHARDS; i++)
+        uv_mutex_init(&trampoline_locks[i]);
+    uv_mutex_init(&trampoline_alloc_lock);
 }
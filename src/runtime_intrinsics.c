@@ -11,6 +11,13 @@
 #include "APInt-C.h"
 #include "julia.h"
 #include "julia_internal.h"
+#include "intrinsics.h"
+#include "processor.h"
+
+#if defined(_CPU_X86_64_) && (defined(_COMPILER_GCC_) || defined(_COMPILER_CLANG_))
+#define JL_HAVE_F16C 1
+#include <immintrin.h>
+#endif
 
 const unsigned int host_char_bit = 8;
 
@@ -185,16 +192,143 @@ static inline uint16_t float_to_half(float param) JL_NOTSAFEPOINT
     return h;
 }
 
+#ifdef JL_HAVE_F16C
+
+// Hardware Float16 conversion (F16C). The scalar soft conversions above
+// remain the fallback for CPUs without the extension; availability is
+// checked once and cached (jl_test_cpu_feature is idempotent, so the
+// unsynchronized initialization race is benign).
+static int have_f16c(void) JL_NOTSAFEPOINT
+{
+    static int cached = -1;
+    if (cached == -1)
+        cached = jl_test_cpu_feature(JL_X86_f16c);
+    return cached;
+}
+
+__attribute__((target("f16c")))
+static float half_to_float_f16c(uint16_t ival) JL_NOTSAFEPOINT
+{
+    return _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(ival)));
+}
+
+__attribute__((target("f16c")))
+static uint16_t float_to_half_f16c(float param) JL_NOTSAFEPOINT
+{
+    __m128i h = _mm_cvtps_ph(_mm_set_ss(param),
+                             _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    return (uint16_t)_mm_extract_epi16(h, 0);
+}
+
+__attribute__((target("f16c,avx")))
+static void half_to_float_bulk_f16c(float *dst, const uint16_t *src, size_t n) JL_NOTSAFEPOINT
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+    for (; i < n; i++)
+        dst[i] = half_to_float_f16c(src[i]);
+}
+
+__attribute__((target("f16c,avx")))
+static void float_to_half_bulk_f16c(uint16_t *dst, const float *src, size_t n) JL_NOTSAFEPOINT
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                    _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128((__m128i*)(dst + i), h);
+    }
+    for (; i < n; i++)
+        dst[i] = float_to_half_f16c(src[i]);
+}
+
+#endif
+
 JL_DLLEXPORT float julia__gnu_h2f_ieee(uint16_t param)
 {
+#ifdef JL_HAVE_F16C
+    if (have_f16c())
+        return half_to_float_f16c(param);
+#endif
     return half_to_float(param);
 }
 
 JL_DLLEXPORT uint16_t julia__gnu_f2h_ieee(float param)
 {
+#ifdef JL_HAVE_F16C
+    if (have_f16c())
+        return float_to_half_f16c(param);
+#endif
     return float_to_half(param);
 }
 
+// bfloat16: truncated Float32, so widening is a shift and narrowing is
+// round-to-nearest-even on the high half of the Float32 bit pattern. The
+// plain loops below vectorize well; there is no pre-AVX512-BF16 hardware
+// conversion to dispatch to.
+
+static inline float bfloat_to_float(uint16_t ival) JL_NOTSAFEPOINT
+{
+    uint32_t bits = (uint32_t)ival << 16;
+    float ret;
+    memcpy(&ret, &bits, sizeof(float));
+    return ret;
+}
+
+static inline uint16_t float_to_bfloat(float param) JL_NOTSAFEPOINT
+{
+    uint32_t f;
+    memcpy(&f, &param, sizeof(float));
+    if (isnan(param))
+        return (uint16_t)((f >> 16) | 0x0040); // quiet the NaN, keep the sign
+    f += 0x7fff + ((f >> 16) & 1); // round to nearest even
+    return (uint16_t)(f >> 16);
+}
+
+// bulk conversion kernels: one call converts a whole buffer, so callers
+// (e.g. ML preprocessing over large Float16 arrays) do not pay a libcall
+// per element, and the hardware-converting loops process 8 values per
+// instruction where F16C is available
+
+JL_DLLEXPORT void jl_half_to_float_bulk(float *dst, const uint16_t *src, size_t n)
+{
+#ifdef JL_HAVE_F16C
+    if (have_f16c()) {
+        half_to_float_bulk_f16c(dst, src, n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        dst[i] = half_to_float(src[i]);
+}
+
+JL_DLLEXPORT void jl_float_to_half_bulk(uint16_t *dst, const float *src, size_t n)
+{
+#ifdef JL_HAVE_F16C
+    if (have_f16c()) {
+        float_to_half_bulk_f16c(dst, src, n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; i++)
+        dst[i] = float_to_half(src[i]);
+}
+
+JL_DLLEXPORT void jl_bfloat_to_float_bulk(float *dst, const uint16_t *src, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        dst[i] = bfloat_to_float(src[i]);
+}
+
+JL_DLLEXPORT void jl_float_to_bfloat_bulk(uint16_t *dst, const float *src, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        dst[i] = float_to_bfloat(src[i]);
+}
+
 JL_DLLEXPORT uint16_t julia__truncdfhf2(double param)
 {
     float res = (float)param;
@@ -1470,3 +1604,242 @@ JL_DLLEXPORT jl_value_t *jl_have_fma(jl_value_t *typ)
     // TODO: run-time feature check?
     return jl_false;
 }
+
+// bulk intrinsic fallbacks ---------------------------------------------------
+// The boxed runtime intrinsics above process one element per call; when
+// uncompiled code applies them across a whole bitstype array, almost all of
+// the time goes into boxing and dispatch rather than arithmetic. The entry
+// points below apply a supported intrinsic to contiguous unboxed buffers in a
+// single call, using plain per-element loops that the C compiler can
+// vectorize. They return 1 when a kernel handled the request and 0 when the
+// caller must fall back to the boxed scalar path, so the supported set can
+// stay limited to operations whose C semantics match the scalar fallbacks
+// exactly (trapping divisions, shifts and float-to-int casts are left out).
+
+#define BULK_BI_LOOP(name, c_type, OP) \
+static void jl_bulk_##name##_##c_type(void *pr, const void *pa, const void *pb, size_t n) JL_NOTSAFEPOINT \
+{ \
+    const c_type *a = (const c_type*)pa; \
+    const c_type *b = (const c_type*)pb; \
+    c_type *r = (c_type*)pr; \
+    size_t i; \
+    for (i = 0; i < n; i++) \
+        r[i] = (c_type)OP(a[i], b[i]); \
+}
+
+#define BULK_UN_LOOP(name, c_type, OP) \
+static void jl_bulk_##name##_##c_type(void *pr, const void *pa, size_t n) JL_NOTSAFEPOINT \
+{ \
+    const c_type *a = (const c_type*)pa; \
+    c_type *r = (c_type*)pr; \
+    size_t i; \
+    for (i = 0; i < n; i++) \
+        r[i] = (c_type)OP(a[i]); \
+}
+
+#define BULK_BI_INT(name, OP) \
+    BULK_BI_LOOP(name, uint8_t, OP) \
+    BULK_BI_LOOP(name, uint16_t, OP) \
+    BULK_BI_LOOP(name, uint32_t, OP) \
+    BULK_BI_LOOP(name, uint64_t, OP)
+
+#define BULK_BI_FLT(name, OP) \
+    BULK_BI_LOOP(name, float, OP) \
+    BULK_BI_LOOP(name, double, OP)
+
+#define BULK_UN_INT(name, OP) \
+    BULK_UN_LOOP(name, uint8_t, OP) \
+    BULK_UN_LOOP(name, uint16_t, OP) \
+    BULK_UN_LOOP(name, uint32_t, OP) \
+    BULK_UN_LOOP(name, uint64_t, OP)
+
+BULK_BI_INT(add_int, add)
+BULK_BI_INT(sub_int, sub)
+BULK_BI_INT(mul_int, mul)
+#define bitand(a,b) a & b
+#define bitor(a,b) a | b
+#define bitxor(a,b) a ^ b
+BULK_BI_INT(and_int, bitand)
+BULK_BI_INT(or_int, bitor)
+BULK_BI_INT(xor_int, bitxor)
+BULK_UN_INT(neg_int, neg)
+#define bitnot(a) ~a
+BULK_UN_INT(not_int, bitnot)
+BULK_BI_FLT(add_float, add)
+BULK_BI_FLT(sub_float, sub)
+BULK_BI_FLT(mul_float, mul)
+BULK_BI_FLT(div_float, div)
+BULK_UN_LOOP(neg_float, float, neg)
+BULK_UN_LOOP(neg_float, double, neg)
+
+// conversions: one cast loop per (from, to) pair; the signed family serves
+// sext_int and sitofp, the unsigned family zext_int, trunc_int and uitofp
+#define BULK_CVT_LOOP(from_t, to_t) \
+static void jl_bulk_cvt_##from_t##_##to_t(void *pr, const void *pa, size_t n) JL_NOTSAFEPOINT \
+{ \
+    const from_t *a = (const from_t*)pa; \
+    to_t *r = (to_t*)pr; \
+    size_t i; \
+    for (i = 0; i < n; i++) \
+        r[i] = (to_t)a[i]; \
+}
+
+#define BULK_CVT_FROM_INT(from_t) \
+    BULK_CVT_LOOP(from_t, int8_t) \
+    BULK_CVT_LOOP(from_t, int16_t) \
+    BULK_CVT_LOOP(from_t, int32_t) \
+    BULK_CVT_LOOP(from_t, int64_t) \
+    BULK_CVT_LOOP(from_t, float) \
+    BULK_CVT_LOOP(from_t, double)
+
+#define BULK_CVT_FROM_UINT(from_t) \
+    BULK_CVT_LOOP(from_t, uint8_t) \
+    BULK_CVT_LOOP(from_t, uint16_t) \
+    BULK_CVT_LOOP(from_t, uint32_t) \
+    BULK_CVT_LOOP(from_t, uint64_t) \
+    BULK_CVT_LOOP(from_t, float) \
+    BULK_CVT_LOOP(from_t, double)
+
+BULK_CVT_FROM_INT(int8_t)
+BULK_CVT_FROM_INT(int16_t)
+BULK_CVT_FROM_INT(int32_t)
+BULK_CVT_FROM_INT(int64_t)
+BULK_CVT_FROM_UINT(uint8_t)
+BULK_CVT_FROM_UINT(uint16_t)
+BULK_CVT_FROM_UINT(uint32_t)
+BULK_CVT_FROM_UINT(uint64_t)
+BULK_CVT_LOOP(float, double)
+BULK_CVT_LOOP(double, float)
+
+// apply binary intrinsic `f` to buffers `pa` and `pb` of `n` unboxed elements
+// of primitive type `ety`, storing into `pr` (pass pb == NULL for the unary
+// intrinsics); returns 0 if no bulk kernel covers the request
+JL_DLLEXPORT int jl_intrinsic_call_bulk(jl_value_t *f, jl_value_t *ety, void *pr,
+                                        const void *pa, const void *pb, size_t n)
+{
+    if (!jl_typeis(f, jl_intrinsic_type) || !jl_is_primitivetype(ety))
+        return 0;
+    enum intrinsic op = (enum intrinsic)*(uint32_t*)jl_data_ptr(f);
+    int sz = jl_datatype_size(ety);
+#define BULK_BI_CASE_INT(name) \
+    case name: \
+        switch (sz) { \
+        case 1: jl_bulk_##name##_uint8_t(pr, pa, pb, n); return 1; \
+        case 2: jl_bulk_##name##_uint16_t(pr, pa, pb, n); return 1; \
+        case 4: jl_bulk_##name##_uint32_t(pr, pa, pb, n); return 1; \
+        case 8: jl_bulk_##name##_uint64_t(pr, pa, pb, n); return 1; \
+        default: return 0; \
+        }
+#define BULK_UN_CASE_INT(name) \
+    case name: \
+        switch (sz) { \
+        case 1: jl_bulk_##name##_uint8_t(pr, pa, n); return 1; \
+        case 2: jl_bulk_##name##_uint16_t(pr, pa, n); return 1; \
+        case 4: jl_bulk_##name##_uint32_t(pr, pa, n); return 1; \
+        case 8: jl_bulk_##name##_uint64_t(pr, pa, n); return 1; \
+        default: return 0; \
+        }
+#define BULK_BI_CASE_FLT(name) \
+    case name: \
+        switch (sz) { \
+        case 4: jl_bulk_##name##_float(pr, pa, pb, n); return 1; \
+        case 8: jl_bulk_##name##_double(pr, pa, pb, n); return 1; \
+        default: return 0; \
+        }
+    switch (op) {
+    BULK_BI_CASE_INT(add_int)
+    BULK_BI_CASE_INT(sub_int)
+    BULK_BI_CASE_INT(mul_int)
+    BULK_BI_CASE_INT(and_int)
+    BULK_BI_CASE_INT(or_int)
+    BULK_BI_CASE_INT(xor_int)
+    BULK_UN_CASE_INT(neg_int)
+    BULK_UN_CASE_INT(not_int)
+    BULK_BI_CASE_FLT(add_float)
+    BULK_BI_CASE_FLT(sub_float)
+    BULK_BI_CASE_FLT(mul_float)
+    BULK_BI_CASE_FLT(div_float)
+    case neg_float:
+        switch (sz) {
+        case 4: jl_bulk_neg_float_float(pr, pa, n); return 1;
+        case 8: jl_bulk_neg_float_double(pr, pa, n); return 1;
+        default: return 0;
+        }
+    default:
+        return 0;
+    }
+#undef BULK_BI_CASE_INT
+#undef BULK_UN_CASE_INT
+#undef BULK_BI_CASE_FLT
+}
+
+// apply conversion intrinsic `f` from buffer `pa` of `n` elements of primitive
+// type `ety` into `pr`, whose element type is `toty`; returns 0 if no bulk
+// kernel covers the request (float-to-int casts are excluded because the C
+// cast is undefined where the LLVM operation saturates)
+JL_DLLEXPORT int jl_intrinsic_cvt_bulk(jl_value_t *f, jl_value_t *toty, jl_value_t *ety,
+                                       void *pr, const void *pa, size_t n)
+{
+    if (!jl_typeis(f, jl_intrinsic_type) ||
+        !jl_is_primitivetype(ety) || !jl_is_primitivetype(toty))
+        return 0;
+    enum intrinsic op = (enum intrinsic)*(uint32_t*)jl_data_ptr(f);
+    int fromsz = jl_datatype_size(ety);
+    int tosz = jl_datatype_size(toty);
+    int tofloat = toty == (jl_value_t*)jl_float32_type || toty == (jl_value_t*)jl_float64_type;
+    int fromfloat = ety == (jl_value_t*)jl_float32_type || ety == (jl_value_t*)jl_float64_type;
+#define BULK_CVT_TO(from_t, itag) \
+    if (tofloat) { \
+        if (tosz == 4) { jl_bulk_cvt_##from_t##_float(pr, pa, n); return 1; } \
+        if (tosz == 8) { jl_bulk_cvt_##from_t##_double(pr, pa, n); return 1; } \
+        return 0; \
+    } \
+    switch (tosz) { \
+    case 1: jl_bulk_cvt_##from_t##_##itag##8_t(pr, pa, n); return 1; \
+    case 2: jl_bulk_cvt_##from_t##_##itag##16_t(pr, pa, n); return 1; \
+    case 4: jl_bulk_cvt_##from_t##_##itag##32_t(pr, pa, n); return 1; \
+    case 8: jl_bulk_cvt_##from_t##_##itag##64_t(pr, pa, n); return 1; \
+    default: return 0; \
+    }
+#define BULK_CVT_DISPATCH(tag, itag) \
+    switch (fromsz) { \
+    case 1: BULK_CVT_TO(tag##8_t, itag) \
+    case 2: BULK_CVT_TO(tag##16_t, itag) \
+    case 4: BULK_CVT_TO(tag##32_t, itag) \
+    case 8: BULK_CVT_TO(tag##64_t, itag) \
+    default: return 0; \
+    }
+    switch (op) {
+    case sext_int:
+    case sitofp:
+        if (fromfloat || (tofloat && op == sext_int) || (!tofloat && op == sitofp))
+            return 0;
+        if (op == sext_int && tosz < fromsz)
+            return 0;
+        BULK_CVT_DISPATCH(int, int)
+    case zext_int:
+    case trunc_int:
+    case uitofp:
+        if (fromfloat || (tofloat && op != uitofp) || (!tofloat && op == uitofp))
+            return 0;
+        if ((op == zext_int && tosz < fromsz) || (op == trunc_int && tosz > fromsz))
+            return 0;
+        BULK_CVT_DISPATCH(uint, uint)
+    case fpext:
+        if (fromsz == 4 && tosz == 8) {
+            jl_bulk_cvt_float_double(pr, pa, n);
+            return 1;
+        }
+        return 0;
+    case fptrunc:
+        if (fromsz == 8 && tosz == 4) {
+            jl_bulk_cvt_double_float(pr, pa, n);
+            return 1;
+        }
+        return 0;
+    default:
+        return 0;
+    }
+#undef BULK_CVT_TO
+#undef BULK_CVT_DISPATCH
+}
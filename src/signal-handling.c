@@ -24,6 +24,21 @@ static volatile size_t bt_size_max = 0;
 static volatile size_t bt_size_cur = 0;
 static volatile uint64_t nsecprof = 0;
 static volatile int running = 0;
+// Online sample aggregation (jl_profile_set_aggregation): identical sample
+// blocks are folded into a count on their first occurrence instead of being
+// appended again, so long profiling runs of steady workloads stop growing the
+// buffer once the distinct stacks have been seen.
+typedef struct {
+    uint64_t hash;
+    size_t offset;  // start of the canonical block in bt_data_prof
+    size_t keylen;  // number of hashed leading words (addresses, tid, task)
+    uint64_t count; // samples folded into this block; 0 marks an empty slot
+} jl_profile_trace_t;
+static int profile_aggregate = 0;
+static jl_profile_trace_t *profile_traces = NULL;
+static size_t profile_traces_sz = 0; // a power of two
+static size_t profile_traces_n = 0;
+static volatile uint64_t profile_n_dropped = 0;
 static const    uint64_t GIGA = 1000000000ULL;
 // Timers to take samples at intervals
 JL_DLLEXPORT void jl_profile_stop_timer(void);
@@ -32,6 +47,21 @@ JL_DLLEXPORT int jl_profile_start_timer(void);
 ///////////////////////
 // Utility functions //
 ///////////////////////
+static int profile_traces_alloc(void)
+{
+    // The smallest block is ~8 words, so at most bt_size_max / 8 distinct
+    // blocks fit in the buffer; size the table for under 50% load.
+    size_t sz = 64;
+    while (sz < bt_size_max / 4 + 16)
+        sz *= 2;
+    profile_traces = (jl_profile_trace_t*)calloc(sz, sizeof(jl_profile_trace_t));
+    if (profile_traces == NULL)
+        return -1;
+    profile_traces_sz = sz;
+    profile_traces_n = 0;
+    return 0;
+}
+
 JL_DLLEXPORT int jl_profile_init(size_t maxsize, uint64_t delay_nsec)
 {
     bt_size_max = maxsize;
@@ -42,6 +72,13 @@ JL_DLLEXPORT int jl_profile_init(size_t maxsize, uint64_t delay_nsec)
     if (bt_data_prof == NULL && maxsize > 0)
         return -1;
     bt_size_cur = 0;
+    profile_n_dropped = 0;
+    free(profile_traces);
+    profile_traces = NULL;
+    profile_traces_sz = 0;
+    profile_traces_n = 0;
+    if (profile_aggregate && maxsize > 0)
+        return profile_traces_alloc();
     return 0;
 }
 
@@ -68,6 +105,11 @@ JL_DLLEXPORT uint64_t jl_profile_delay_nsec(void)
 JL_DLLEXPORT void jl_profile_clear_data(void)
 {
     bt_size_cur = 0;
+    profile_n_dropped = 0;
+    if (profile_traces != NULL) {
+        memset(profile_traces, 0, profile_traces_sz * sizeof(jl_profile_trace_t));
+        profile_traces_n = 0;
+    }
 }
 
 JL_DLLEXPORT int jl_profile_is_running(void)
@@ -75,6 +117,94 @@ JL_DLLEXPORT int jl_profile_is_running(void)
     return running;
 }
 
+// Enable or disable folding of identical sample blocks. May not be changed
+// while the profiler is running; takes effect for data recorded afterwards.
+JL_DLLEXPORT int jl_profile_set_aggregation(int enable)
+{
+    if (running)
+        return -1;
+    profile_aggregate = !!enable;
+    free(profile_traces);
+    profile_traces = NULL;
+    profile_traces_sz = 0;
+    profile_traces_n = 0;
+    if (profile_aggregate && bt_data_prof != NULL && bt_size_max > 0)
+        return profile_traces_alloc();
+    return 0;
+}
+
+// Number of samples discarded because the buffer (or trace table) was full.
+// With aggregation enabled the profiler keeps running when the buffer fills:
+// repeated traces still fold into their existing blocks and only novel
+// traces are dropped (and counted here).
+JL_DLLEXPORT uint64_t jl_profile_n_dropped(void)
+{
+    return profile_n_dropped;
+}
+
+// Copy up to `maxn` (block offset, sample count) pairs for the distinct
+// traces recorded so far; returns the number available. Offsets are 0-based
+// word indices into the profile data; blocks not listed represent one sample
+// each. Call only while the profiler is stopped.
+JL_DLLEXPORT size_t jl_profile_get_fold_counts(size_t *offsets, uint64_t *counts, size_t maxn)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < profile_traces_sz; i++) {
+        if (profile_traces[i].count == 0)
+            continue;
+        if (n < maxn) {
+            offsets[n] = profile_traces[i].offset;
+            counts[n] = profile_traces[i].count;
+        }
+        n++;
+    }
+    return n;
+}
+
+// Called from the profiler signal handler once a complete sample block has
+// been written at bt_data_prof[blockstart..blockend). A block is laid out as
+// the backtrace addresses followed by four metadata words (threadid, taskid,
+// cycle clock, sleep state) and a double-NULL terminator. If an identical
+// trace -- same addresses, thread, task and sleep state; the clock is
+// ignored -- was seen before, its count is bumped and the new block is
+// discarded, keeping the first-seen metadata as canonical. Returns the new
+// end of the buffer. Async-signal-safe: the table is preallocated and the
+// sampler is the only writer (it holds the profile lock with the sampled
+// threads suspended).
+static size_t jl_profile_fold_block(size_t blockstart, size_t blockend) JL_NOTSAFEPOINT
+{
+    if (profile_traces == NULL)
+        return blockend;
+    jl_bt_element_t *prof = (jl_bt_element_t*)bt_data_prof;
+    size_t keylen = blockend - blockstart - 4; // addresses, threadid, taskid
+    uintptr_t sleeping = prof[blockend - 3].uintptr;
+    uint64_t h = memhash_seed((const char*)&prof[blockstart],
+                              keylen * sizeof(jl_bt_element_t), (uint32_t)sleeping);
+    size_t mask = profile_traces_sz - 1;
+    size_t idx = h & mask;
+    while (1) {
+        jl_profile_trace_t *tr = &profile_traces[idx];
+        if (tr->count == 0) {
+            if (4 * profile_traces_n >= 3 * profile_traces_sz)
+                return blockend; // table nearly full; keep the block unfolded
+            tr->hash = h;
+            tr->offset = blockstart;
+            tr->keylen = keylen;
+            tr->count = 1;
+            profile_traces_n++;
+            return blockend;
+        }
+        if (tr->hash == h && tr->keylen == keylen &&
+            prof[tr->offset + keylen + 1].uintptr == sleeping &&
+            memcmp(&prof[tr->offset], &prof[blockstart],
+                   keylen * sizeof(jl_bt_element_t)) == 0) {
+            tr->count++;
+            return blockstart; // duplicate: drop the tentative block
+        }
+        idx = (idx + 1) & mask;
+    }
+}
+
 // Any function that acquires this lock must be either a unmanaged thread
 // or in the GC safe region and must NOT allocate anything through the GC
 // while holding this lock.
@@ -155,8 +285,7 @@ static void jl_shuffle_int_array_inplace(int *carray, int size, uint64_t *seed)
     // The "modern Fisher–Yates shuffle" - O(n) algorithm
     // https://en.wikipedia.org/wiki/Fisher%E2%80%93Yates_shuffle#The_modern_algorithm
     for (int i = size; i-- > 1; ) {
-        uint64_t unbias = UINT64_MAX; // slightly biased, but i is very small
-        size_t j = cong(i, unbias, seed);
+        size_t j = jl_rand_bounded(seed, i);
         uint64_t tmp = carray[j];
         carray[j] = carray[i];
         carray[i] = tmp;
@@ -627,6 +627,7 @@ void *mach_profile_listener(void *arg)
                 _dyld_atfork_parent(); // quickly release the dlsym lock
 
             if (running) {
+                size_t blockstart = bt_size_cur;
 #ifdef LLVMLIBUNWIND
                 /*
                  *  Unfortunately compact unwind info is incorrectly generated for quite a number of
@@ -677,6 +678,9 @@ void *mach_profile_listener(void *arg)
                 // Mark the end of this block with two 0's
                 bt_data_prof[bt_size_cur++].uintptr = 0;
                 bt_data_prof[bt_size_cur++].uintptr = 0;
+
+                // fold the block into an earlier identical one, if any
+                bt_size_cur = jl_profile_fold_block(blockstart, bt_size_cur);
             }
             // We're done! Resume the thread.
             jl_thread_resume(i, 0);
@@ -860,11 +860,27 @@ static void *signal_listener(void *arg)
 
                 // do backtrace for profiler
                 if (profile && running) {
-                    if (jl_profile_is_buffer_full()) {
-                        // Buffer full: Delete the timer
-                        jl_profile_stop_timer();
+                    int full = jl_profile_is_buffer_full();
+                    if (full && profile_aggregate) {
+                        // jl_profile_is_buffer_full keeps a whole round of
+                        // headroom; with aggregation on we keep sampling as
+                        // long as one max-sized block still fits, since
+                        // repeated traces fold away below
+                        full = bt_size_cur + JL_BT_MAX_ENTRY_SIZE + 7 > bt_size_max;
+                    }
+                    if (full) {
+                        if (profile_aggregate) {
+                            // only novel traces no longer fit; count the
+                            // dropped sample and keep the timer running
+                            profile_n_dropped++;
+                        }
+                        else {
+                            // Buffer full: Delete the timer
+                            jl_profile_stop_timer();
+                        }
                     }
                     else {
+                        size_t blockstart = bt_size_cur;
                         // unwinding can fail, so keep track of the current state
                         // and restore from the SEGV handler if anything happens.
                         jl_jmp_buf *old_buf = jl_get_safe_restore();
@@ -897,6 +913,9 @@ static void *signal_listener(void *arg)
                         // Mark the end of this block with two 0's
                         bt_data_prof[bt_size_cur++].uintptr = 0;
                         bt_data_prof[bt_size_cur++].uintptr = 0;
+
+                        // fold the block into an earlier identical one, if any
+                        bt_size_cur = jl_profile_fold_block(blockstart, bt_size_cur);
                     }
                 }
 
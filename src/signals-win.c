@@ -359,6 +359,7 @@ static DWORD WINAPI profile_bt( LPVOID lparam )
                 }
                 else {
                     // Get backtrace data
+                    size_t blockstart = bt_size_cur;
                     bt_size_cur += rec_backtrace_ctx((jl_bt_element_t*)bt_data_prof + bt_size_cur,
                             bt_size_max - bt_size_cur - 1, &ctxThread, NULL);
 
@@ -379,6 +380,9 @@ static DWORD WINAPI profile_bt( LPVOID lparam )
                     // Mark the end of this block with two 0's
                     bt_data_prof[bt_size_cur++].uintptr = 0;
                     bt_data_prof[bt_size_cur++].uintptr = 0;
+
+                    // fold the block into an earlier identical one, if any
+                    bt_size_cur = jl_profile_fold_block(blockstart, bt_size_cur);
                 }
                 jl_unlock_profile();
                 uv_mutex_unlock(&jl_in_stackwalk);
@@ -0,0 +1,70 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+/*
+  native sorting kernels
+
+  LSD radix sort over uint-mapped keys. The adaptive sort in base/sort.jl
+  maps eligible element types (fixed-width ints, floats via the order
+  preserving bit flip) to unsigned keys and calls these kernels for the
+  radix passes; see radix_sort! there for the mapping and buffer handling.
+*/
+
+#include <string.h>
+#include "julia.h"
+#include "julia_internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// LSD radix sort of `n` keys over their low `bits` bits, 8 bits per pass.
+// `v` is the working buffer and `t` caller-provided scratch of the same
+// length; returns 0 if the sorted keys end in `v` and 1 if in `t`. The
+// histograms for every pass are gathered in one scan up front (digit counts
+// are permutation-invariant, so they stay valid as passes shuffle the keys),
+// and a pass whose keys all share one digit value is skipped outright, which
+// makes the sparsely-populated high digits left after the uint mapping
+// subtracts the minimum cost nothing beyond their count.
+#define RADIX_SORT_IMPL(W) \
+JL_DLLEXPORT int jl_radix_sort_##W(uint##W##_t *v, uint##W##_t *t, size_t n, \
+                                   unsigned bits) JL_NOTSAFEPOINT \
+{ \
+    unsigned npasses = (bits + 7) / 8; \
+    if (npasses > W / 8) \
+        npasses = W / 8; \
+    size_t counts[W / 8][256]; \
+    memset(counts, 0, (size_t)npasses * 256 * sizeof(size_t)); \
+    for (size_t k = 0; k < n; k++) { \
+        uint##W##_t x = v[k]; \
+        for (unsigned p = 0; p < npasses; p++) \
+            counts[p][(x >> (8 * p)) & 0xff]++; \
+    } \
+    int flipped = 0; \
+    for (unsigned p = 0; p < npasses; p++) { \
+        size_t *c = counts[p]; \
+        unsigned shift = 8 * p; \
+        if (n && c[(v[0] >> shift) & 0xff] == n) \
+            continue; /* every key has the same digit in this position */ \
+        size_t sum = 0; \
+        for (int i = 0; i < 256; i++) { \
+            size_t cnt = c[i]; \
+            c[i] = sum; \
+            sum += cnt; \
+        } \
+        for (size_t k = 0; k < n; k++) { \
+            uint##W##_t x = v[k]; \
+            t[c[(x >> shift) & 0xff]++] = x; \
+        } \
+        uint##W##_t *tmp = v; v = t; t = tmp; \
+        flipped ^= 1; \
+    } \
+    return flipped; \
+}
+
+RADIX_SORT_IMPL(16)
+RADIX_SORT_IMPL(32)
+RADIX_SORT_IMPL(64)
+
+#ifdef __cplusplus
+}
+#endif
@@ -535,15 +535,124 @@ static int jl_unw_step(bt_cursor_t *cursor, int from_signal_handler, uintptr_t *
 #elif !defined(JL_DISABLE_LIBUNWIND)
 // stacktrace using libunwind
 
+#if defined(_CPU_X86_64_)
+// Unwind recipe cache, keyed by instruction pointer.
+//
+// The sampling profiler replays nearly identical stack walks on every tick,
+// and most of that time goes into libunwind re-deriving the same DWARF CFI
+// answers for the same code addresses. For the common case -- a fixed-size
+// frame reached by a plain `call` -- the step to the caller is fully
+// described by the frame size: the caller's CFA sits at a constant offset
+// from the current stack pointer and the return address is the word just
+// below it. Whenever a full libunwind step produces such a frame we record
+// (ip, frame size) here, so later walks through the same address are a hash
+// lookup and one stack load instead of a CFI evaluation.
+//
+// Each entry packs key and payload into one word so that readers (which
+// include signal handlers) can never observe a torn pair:
+//   bits 16..63  low 48 bits of the keyed instruction pointer
+//   bits  0..15  frame size in pointer-sized slots; 0 means no usable recipe
+//                (the frame size was seen to vary, or the frame is not a
+//                plain call frame), which pins the entry so the fast path
+//                never fires for that address
+#define UNW_RECIPE_BITS 12
+static _Atomic(uint64_t) unw_recipes[1 << UNW_RECIPE_BITS];
+
+STATIC_INLINE size_t unw_recipe_idx(uintptr_t ip) JL_NOTSAFEPOINT
+{
+    return (size_t)((ip * 0x9E3779B97F4A7C15ULL) >> (64 - UNW_RECIPE_BITS));
+}
+
+// Record the step (ip, sp) -> (next_ip, next_sp) that libunwind just made,
+// if it matches the fixed-size call frame shape described above.
+static void unw_recipe_learn(uintptr_t ip, uintptr_t sp, uintptr_t next_ip,
+                             uintptr_t next_sp) JL_NOTSAFEPOINT
+{
+    _Atomic(uint64_t) *slot = &unw_recipes[unw_recipe_idx(ip)];
+    uint64_t tag = (uint64_t)ip << 16;
+    uint64_t word = tag;
+    size_t nslots = (next_sp - sp) / sizeof(void*);
+    if (next_sp > sp && (next_sp & (sizeof(void*) - 1)) == 0 && nslots <= 0xffff &&
+        *(uintptr_t*)(next_sp - sizeof(void*)) == next_ip)
+        word |= nslots;
+    uint64_t old = jl_atomic_load_relaxed(slot);
+    if (old == word)
+        return;
+    if ((old & ~(uint64_t)0xffff) == tag)
+        word = tag; // frame size differs between walks (alloca?): poison the entry
+    jl_atomic_store_relaxed(slot, word);
+}
+
+// Step from the frame at (*ip, *sp) to its caller using only the recipe
+// cache; returns 0 on a cache miss (without touching *ip / *sp).
+static int unw_recipe_step(uintptr_t *ip, uintptr_t *sp) JL_NOTSAFEPOINT
+{
+    uint64_t word = jl_atomic_load_relaxed(&unw_recipes[unw_recipe_idx(*ip)]);
+    size_t nslots = (size_t)(word & 0xffff);
+    if ((word & ~(uint64_t)0xffff) != (uint64_t)*ip << 16 || nslots == 0)
+        return 0;
+    uintptr_t cfa = *sp + nslots * sizeof(void*);
+    *ip = *(uintptr_t*)(cfa - sizeof(void*)); // the return address pushed by `call`
+    *sp = cfa;
+    return *ip != 0;
+}
+#endif
+
 static int jl_unw_init(bt_cursor_t *cursor, bt_context_t *context)
 {
+#if defined(_CPU_X86_64_)
+    cursor->recipe_ip = 0;
+    cursor->recipe_sp = 0;
+    return unw_init_local(&cursor->uc, context) == 0;
+#else
     return unw_init_local(cursor, context) == 0;
+#endif
 }
 
 static int jl_unw_step(bt_cursor_t *cursor, int from_signal_handler, uintptr_t *ip, uintptr_t *sp)
 {
-    (void)from_signal_handler; // libunwind also tracks this
     unw_word_t reg;
+#if defined(_CPU_X86_64_)
+    if (cursor->recipe_ip) {
+        // The libunwind cursor was left behind when this walk switched over
+        // to cached recipes; from here it either stays on recipes or ends.
+        *ip = cursor->recipe_ip;
+        *sp = cursor->recipe_sp;
+        return unw_recipe_step(&cursor->recipe_ip, &cursor->recipe_sp);
+    }
+    if (unw_get_reg(&cursor->uc, UNW_REG_IP, &reg) < 0)
+        return 0;
+    *ip = reg;
+    if (unw_get_reg(&cursor->uc, UNW_REG_SP, &reg) < 0)
+        return 0;
+    *sp = reg;
+    if (from_signal_handler) {
+        // Profiler ticks walk the same hot stacks over and over; prefer the
+        // recipe cache so a warm walk never enters libunwind at all. A recipe
+        // miss further up then truncates this (statistical) sample rather
+        // than falling back, so exact walks -- exceptions, backtrace() --
+        // stay on the full CFI path below.
+        uintptr_t nip = *ip, nsp = *sp;
+        if (unw_recipe_step(&nip, &nsp)) {
+            cursor->recipe_ip = nip;
+            cursor->recipe_sp = nsp;
+            return 1;
+        }
+    }
+    if (unw_step(&cursor->uc) <= 0)
+        return 0;
+    // A successful full step tells us how to skip the CFI work next time.
+    uintptr_t next_ip = 0, next_sp = 0;
+    if (unw_get_reg(&cursor->uc, UNW_REG_IP, &reg) == 0) {
+        next_ip = reg;
+        if (unw_get_reg(&cursor->uc, UNW_REG_SP, &reg) == 0)
+            next_sp = reg;
+    }
+    if (next_sp)
+        unw_recipe_learn(*ip, *sp, next_ip, next_sp);
+    return 1;
+#else
+    (void)from_signal_handler; // libunwind also tracks this
     if (unw_get_reg(cursor, UNW_REG_IP, &reg) < 0)
         return 0;
     *ip = reg;
@@ -551,6 +660,7 @@ static int jl_unw_step(bt_cursor_t *cursor, int from_signal_handler, uintptr_t *
         return 0;
     *sp = reg;
     return unw_step(cursor) > 0;
+#endif
 }
 
 #ifdef LLVMLIBUNWIND
@@ -559,8 +669,15 @@ NOINLINE size_t rec_backtrace_ctx_dwarf(jl_bt_element_t *bt_data, size_t maxsize
 {
     size_t bt_size = 0;
     bt_cursor_t cursor;
+#if defined(_CPU_X86_64_)
+    cursor.recipe_ip = 0;
+    cursor.recipe_sp = 0;
+    if (unw_init_local_dwarf(&cursor.uc, context) != UNW_ESUCCESS)
+        return 0;
+#else
     if (unw_init_local_dwarf(&cursor, context) != UNW_ESUCCESS)
         return 0;
+#endif
     jl_unw_stepn(&cursor, bt_data, &bt_size, NULL, maxsize, 0, &pgcstack, 1);
     return bt_size;
 }
@@ -68,6 +68,7 @@ done by `get_item_for_reloc`.
 
 #ifndef _OS_WINDOWS_
 #include <dlfcn.h>
+#include <sys/mman.h>
 #endif
 
 #include "valgrind.h"
@@ -314,7 +315,7 @@ static const jl_fptr_args_t id_to_fptrs[] = {
     &jl_f_ifelse, &jl_f__structtype, &jl_f__abstracttype, &jl_f__primitivetype,
     &jl_f__typebody, &jl_f__setsuper, &jl_f__equiv_typedef, &jl_f_get_binding_type,
     &jl_f_set_binding_type, &jl_f_opaque_closure_call, &jl_f_donotdelete,
-    &jl_f_getglobal, &jl_f_setglobal, &jl_f_finalizer,
+    &jl_f_getglobal, &jl_f_setglobal, &jl_f_finalizer, &jl_f_kwfunc,
     NULL };
 
 typedef struct {
@@ -390,7 +391,21 @@ static void jl_load_sysimg_so(void)
     if (!imaging_mode && jl_options.use_sysimage_native_code==JL_OPTIONS_USE_SYSIMAGE_NATIVE_CODE_YES) {
         jl_dlsym(jl_sysimg_handle, "jl_sysimg_gvars_base", (void **)&sysimg_gvars_base, 1);
         jl_dlsym(jl_sysimg_handle, "jl_sysimg_gvars_offsets", (void **)&sysimg_gvars_offsets, 1);
-        sysimg_gvars_offsets += 1;
+        void *abs_marker;
+        if (jl_dlsym(jl_sysimg_handle, "jl_sysimg_abs_tables", &abs_marker, 0)) {
+            // a sharded image stores absolute addresses with a length prefix
+            // (see llvm-multiversioning.cpp); rebase them into the int32 form
+            // used by sysimg_gvars (the converted table lives forever)
+            const uintptr_t *tbl = (const uintptr_t*)sysimg_gvars_offsets;
+            size_t nvars = tbl[0];
+            int32_t *rebased = (int32_t*)malloc(nvars * sizeof(int32_t));
+            for (size_t i = 0; i < nvars; i++)
+                rebased[i] = (int32_t)((char*)tbl[i + 1] - (char*)sysimg_gvars_base);
+            sysimg_gvars_offsets = rebased;
+        }
+        else {
+            sysimg_gvars_offsets += 1;
+        }
         assert(sysimg_fptrs.base);
 
         void *pgcstack_func_slot;
@@ -422,6 +437,13 @@ static void jl_load_sysimg_so(void)
     jl_dlsym(jl_sysimg_handle, "jl_system_image_data", (void **)&sysimg_data, 1);
     size_t *plen;
     jl_dlsym(jl_sysimg_handle, "jl_system_image_size", (void **)&plen, 1);
+    // The image blob is mmapped from the shared library and would otherwise be
+    // paged in one major fault at a time as deserialization walks it; start
+    // readahead of the whole range and fault it in from a background thread,
+    // overlapping the disk I/O with the CPU-bound relocation work on a cold
+    // start.
+    jl_image_hint((void*)sysimg_data, *plen,
+                  JL_IMAGE_MAP_WILLNEED | JL_IMAGE_MAP_PREFAULT);
     jl_restore_system_image_data(sysimg_data, *plen);
 }
 
@@ -760,7 +782,8 @@ static void jl_write_module(jl_serializer_state *s, uintptr_t item, jl_module_t
             write_pointerfield(s, jl_atomic_load_relaxed(&b->globalref));
             write_pointerfield(s, (jl_value_t*)b->owner);
             write_pointerfield(s, jl_atomic_load_relaxed(&b->ty));
-            size_t flag_offset = offsetof(jl_binding_t, ty) + sizeof(b->ty);
+            write_pointer(s->s); // speculations is a host-only pointer
+            size_t flag_offset = offsetof(jl_binding_t, speculations) + sizeof(b->speculations);
             ios_write(s->s, (char*)b + flag_offset, sizeof(*b) - flag_offset);
             tot += sizeof(jl_binding_t);
             count += 1;
@@ -771,6 +794,8 @@ static void jl_write_module(jl_serializer_state *s, uintptr_t item, jl_module_t
     newm->bindings.size = count; // stash the count in newm->size
     newm->bindings.table = NULL;
     memset(&newm->bindings._space, 0, sizeof(newm->bindings._space));
+    // the lock-free mirror is a host pointer; rebuilt lazily after load
+    jl_atomic_store_relaxed(&newm->fastbindings, NULL);
 
     // write out the usings list
     memset(&newm->usings._space, 0, sizeof(newm->usings._space));
@@ -1579,6 +1604,7 @@ static void jl_reinit_item(jl_value_t *v, int how) JL_GC_DISABLED
                 b += 1;
                 nbindings -= 1;
             }
+            jl_module_rebuild_fastbindings(mod);
             if (mod->usings.items != &mod->usings._space[0]) {
                 void **newitems = (void**)malloc_s(mod->usings.max * sizeof(void*));
                 memcpy(newitems, mod->usings.items, mod->usings.len * sizeof(void*));
@@ -1988,6 +2014,24 @@ JL_DLLEXPORT void jl_save_system_image(const char *fname)
     JL_SIGATOMIC_END();
 }
 
+// Checkpoint the current (warmed) session as a system image that a fresh
+// process can boot from with --sysimage.  This is the half of a CRIU-style
+// snapshot that the runtime can own: the object graph -- types, methods,
+// globals and inference results -- is captured, while OS-level state (open
+// handles, running tasks, the uv loop, ptls) is deliberately left out and
+// rebuilt by ordinary startup on the restore side.  Since no native_functions
+// are recorded, restored methods recompile (or run interpreted) on first use,
+// but skip all of the load and inference work that dominates a cold start.
+JL_DLLEXPORT void jl_checkpoint_system_image(const char *fname)
+{
+    if (jl_n_threads > 1)
+        jl_error("cannot checkpoint a session with multiple threads");
+    // drop garbage before freezing the heap into the image
+    jl_gc_collect(JL_GC_FULL);
+    native_functions = NULL;
+    jl_save_system_image(fname);
+}
+
 // Takes in a path of the form "usr/lib/julia/sys.so" (jl_restore_system_image should be passed the same string)
 JL_DLLEXPORT void jl_preload_sysimg_so(const char *fname)
 {
@@ -2165,10 +2209,21 @@ JL_DLLEXPORT void jl_restore_system_image(const char *fname)
         JL_SIGATOMIC_BEGIN();
         ios_seek_end(&f);
         size_t len = ios_pos(&f);
-        char *sysimg = (char*)jl_gc_perm_alloc(len, 0, 64, 0);
-        ios_seek(&f, 0);
-        if (ios_readall(&f, sysimg, len) != len)
-            jl_errorf("Error reading system image file.");
+        // Map the image copy-on-write instead of copying it into a fresh
+        // buffer: applying relocations then only dirties the pages that
+        // actually contain relocation targets. Readahead overlaps the file
+        // I/O with the deserialization walk below, and the data segment is
+        // hugepage-backed since the relocated objects live for the whole
+        // process. The mapping is page-aligned, which also satisfies the
+        // vector-alignment requirement for the data section.
+        char *sysimg = jl_image_map_file(f.fd, len,
+                JL_IMAGE_MAP_WRITE | JL_IMAGE_MAP_WILLNEED | JL_IMAGE_MAP_HUGEPAGE);
+        if (sysimg == NULL) {
+            sysimg = (char*)jl_gc_perm_alloc(len, 0, 64, 0);
+            ios_seek(&f, 0);
+            if (ios_readall(&f, sysimg, len) != len)
+                jl_errorf("Error reading system image file.");
+        }
         ios_close(&f);
         ios_static_buffer(&f, sysimg, len);
         jl_restore_system_image_from_stream(&f);
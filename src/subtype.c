@@ -102,6 +102,9 @@ typedef struct jl_stenv_t {
     int intersection;         // true iff subtype is being called from intersection
     int emptiness_only;       // true iff intersection only needs to test for emptiness
     int triangular;           // when intersecting Ref{X} with Ref{<:Y}
+    int fuel;                 // intersection work budget; 0 means unlimited
+    int fuel_exhausted;       // set when the budget ran out; the result is a
+                              // conservative over-approximation
 } jl_stenv_t;
 
 // state manipulation utilities
@@ -1450,6 +1453,8 @@ static void init_stenv(jl_stenv_t *e, jl_value_t **env, int envsz)
     e->intersection = 0;
     e->emptiness_only = 0;
     e->triangular = 0;
+    e->fuel = 0;
+    e->fuel_exhausted = 0;
     e->Lunions.depth = 0;      e->Runions.depth = 0;
     e->Lunions.more = 0;       e->Runions.more = 0;
     e->Lunions.used = 0;       e->Runions.used = 0;
@@ -1848,6 +1853,49 @@ JL_DLLEXPORT int jl_obvious_subtype(jl_value_t *x, jl_value_t *y, int *subtype)
 // points to a rooted array of length `jl_subtype_env_size(y)`.
 // This will be populated with the values of variables from unionall
 // types at the outer level of `y`.
+// Memo table of subtype judgments for closed (typevar-free) pairs, keyed by
+// pointer identity. Closed judgments depend only on the type definitions
+// themselves, which are immutable once the type objects exist (redefinition
+// creates fresh objects), so cached verdicts never need invalidation; the GC
+// roots the keys (see mark_roots), which pins at most N_SUBTYPE_CACHE type
+// pairs. Slots are seqlock-protected so readers are wait-free and a torn
+// x/y pairing can never be observed.
+jl_subtype_cache_slot_t subtype_memo_cache[N_SUBTYPE_CACHE] JL_GLOBALLY_ROOTED;
+
+STATIC_INLINE jl_subtype_cache_slot_t *subtype_cache_slot(jl_value_t *x, jl_value_t *y) JL_NOTSAFEPOINT
+{
+    uintptr_t h = inthash((uintptr_t)x ^ inthash((uintptr_t)y));
+    return &subtype_memo_cache[h & (N_SUBTYPE_CACHE - 1)];
+}
+
+// returns the memoized verdict, or -1 if the pair is not cached
+static int subtype_cache_lookup(jl_value_t *x, jl_value_t *y) JL_NOTSAFEPOINT
+{
+    jl_subtype_cache_slot_t *slot = subtype_cache_slot(x, y);
+    uintptr_t seq = jl_atomic_load_acquire(&slot->seq);
+    if (seq & 1)
+        return -1; // insertion in progress
+    jl_value_t *sx = jl_atomic_load_relaxed(&slot->x);
+    jl_value_t *sy = jl_atomic_load_relaxed(&slot->y);
+    int result = jl_atomic_load_relaxed(&slot->result);
+    jl_fence();
+    if (jl_atomic_load_relaxed(&slot->seq) != seq || sx != x || sy != y)
+        return -1;
+    return result;
+}
+
+static void subtype_cache_insert(jl_value_t *x, jl_value_t *y, int result) JL_NOTSAFEPOINT
+{
+    jl_subtype_cache_slot_t *slot = subtype_cache_slot(x, y);
+    uintptr_t seq = jl_atomic_load_relaxed(&slot->seq);
+    if ((seq & 1) || !jl_atomic_cmpswap(&slot->seq, &seq, seq + 1))
+        return; // lost the slot to a concurrent insertion; skip caching
+    jl_atomic_store_relaxed(&slot->x, x);
+    jl_atomic_store_relaxed(&slot->y, y);
+    jl_atomic_store_relaxed(&slot->result, result);
+    jl_atomic_store_release(&slot->seq, seq + 2);
+}
+
 JL_DLLEXPORT int jl_subtype_env(jl_value_t *x, jl_value_t *y, jl_value_t **env, int envsz)
 {
     jl_stenv_t e;
@@ -1868,6 +1916,12 @@ JL_DLLEXPORT int jl_subtype_env(jl_value_t *x, jl_value_t *y, jl_value_t **env,
         }
         return 1;
     }
+    int closed = envsz == 0 && !jl_has_free_typevars(x) && !jl_has_free_typevars(y);
+    if (closed) {
+        int memo = subtype_cache_lookup(x, y);
+        if (memo >= 0)
+            return memo;
+    }
     int obvious_subtype = 2;
     if (jl_obvious_subtype(x, y, &obvious_subtype)) {
 #ifdef NDEBUG
@@ -1887,6 +1941,8 @@ JL_DLLEXPORT int jl_subtype_env(jl_value_t *x, jl_value_t *y, jl_value_t **env,
     if (obvious_subtype == 0 || (obvious_subtype == 1 && envsz == 0))
         subtype = obvious_subtype; // this ensures that running in a debugger doesn't change the result
 #endif
+    if (closed)
+        subtype_cache_insert(x, y, subtype);
     return subtype;
 }
 
@@ -2062,6 +2118,30 @@ int jl_has_intersect_type_not_kind(jl_value_t *t)
     return 0;
 }
 
+// Small per-thread cache over the `jl_subtype(jl_typeof(x), t)` fallbacks
+// of jl_isa below. The interpreter and runtime type assertions ask the
+// same (concrete datatype, target type) questions over and over; both keys
+// are compared by identity and the subtype relation between two existing
+// type objects never changes, so hits never need invalidation (the entries
+// are scanned as GC roots in gc.c, which keeps a cached address from being
+// recycled under a live entry).
+static int jl_isa_cached_subtype(jl_value_t *vt, jl_value_t *t)
+{
+    jl_task_t *ct = jl_get_current_task();
+    if (ct == NULL || ct->ptls == NULL)
+        return jl_subtype(vt, t);
+    jl_ptls_t ptls = ct->ptls;
+    uint32_t i = (uint32_t)((((uintptr_t)vt >> 4) * 23 ^ ((uintptr_t)t >> 4))
+                            % JL_TLS_ISA_CACHE_SIZE);
+    if (ptls->isa_cache_vt[i] == vt && ptls->isa_cache_t[i] == t)
+        return ptls->isa_cache_ans[i];
+    int ans = jl_subtype(vt, t);
+    ptls->isa_cache_vt[i] = vt;
+    ptls->isa_cache_t[i] = t;
+    ptls->isa_cache_ans[i] = (uint8_t)ans;
+    return ans;
+}
+
 JL_DLLEXPORT int jl_isa(jl_value_t *x, jl_value_t *t)
 {
     if (jl_typeis(x,t) || t == (jl_value_t*)jl_any_type)
@@ -2097,7 +2177,7 @@ JL_DLLEXPORT int jl_isa(jl_value_t *x, jl_value_t *t)
                     return 0;
                 }
             }
-            if (jl_subtype(jl_typeof(x), t))
+            if (jl_isa_cached_subtype(jl_typeof(x), t))
                 return 1;
             if (jl_has_intersect_type_not_kind(t2)) {
                 JL_GC_PUSH1(&x);
@@ -2111,7 +2191,7 @@ JL_DLLEXPORT int jl_isa(jl_value_t *x, jl_value_t *t)
     }
     if (jl_is_concrete_type(t) && jl_type_equality_is_identity(jl_typeof(x), t))
         return 0;
-    return jl_subtype(jl_typeof(x), t);
+    return jl_isa_cached_subtype(jl_typeof(x), t);
 }
 
 // type intersection
@@ -2960,8 +3040,37 @@ static int subtype_by_bounds(jl_value_t *x, jl_value_t *y, jl_stenv_t *e) JL_NOT
 // (as opposed to being outside any type constructor, or comparing variable bounds).
 // this is used to record the positions where type variables occur for the
 // diagonal rule (record_var_occurrence).
+// Work budget for a single type intersection, counted in recursive
+// `intersect` calls. Well-behaved method signatures use a tiny fraction of
+// this; the exponential cases hit it in well under a second, at which point
+// the query degrades to a correct but imprecise answer (see below) instead
+// of stalling method definition for minutes.
+#define INTERSECT_FUEL 2000000
+
+// number of intersections that ran out of fuel and over-approximated;
+// entries computed this way may deserve slow-path treatment by the caller
+static _Atomic(uint64_t) intersect_fuel_exhausted_stat;
+
+JL_DLLEXPORT uint64_t jl_intersect_fuel_exhausted_count(void)
+{
+    return jl_atomic_load_relaxed(&intersect_fuel_exhausted_stat);
+}
+
 static jl_value_t *intersect(jl_value_t *x, jl_value_t *y, jl_stenv_t *e, int param)
 {
+    if (e->fuel) {
+        // pathological signatures can make the union-choice search below
+        // exponential; once the work budget is gone, unwind as fast as
+        // possible. The interim results are meaningless and intersect_all
+        // discards them, substituting a conservative over-approximation.
+        if (e->fuel_exhausted)
+            return y;
+        if (--e->fuel == 0) {
+            e->fuel_exhausted = 1;
+            jl_atomic_fetch_add_relaxed(&intersect_fuel_exhausted_stat, 1);
+            return y;
+        }
+    }
     if (x == y) return y;
     if (jl_is_typevar(x)) {
         if (jl_is_typevar(y)) {
@@ -3178,6 +3287,11 @@ static jl_value_t *intersect_all(jl_value_t *x, jl_value_t *y, jl_stenv_t *e)
     save_env(e, saved, &se);
     int lastset = 0, niter = 0, total_iter = 0;
     jl_value_t *ii = intersect(x, y, e, 0);
+    if (e->fuel_exhausted) {
+        // ran out of budget partway through: `ii` may be garbage, and `y`
+        // is always a correct (if imprecise) answer
+        ii = y;
+    }
     is[0] = ii;  // root
     if (ii == jl_bottom_type) {
         restore_env(e, *saved, &se);
@@ -3199,6 +3313,10 @@ static jl_value_t *intersect_all(jl_value_t *x, jl_value_t *y, jl_stenv_t *e)
 
         is[0] = ii;
         is[1] = intersect(x, y, e, 0);
+        if (e->fuel_exhausted) {
+            ii = y;
+            break;
+        }
         if (is[1] == jl_bottom_type) {
             restore_env(e, *saved, &se);
         }
@@ -3244,6 +3362,7 @@ static jl_value_t *intersect_types(jl_value_t *x, jl_value_t *y, int emptiness_o
     init_stenv(&e, NULL, 0);
     e.intersection = e.ignore_free = 1;
     e.emptiness_only = emptiness_only;
+    e.fuel = INTERSECT_FUEL;
     return intersect_all(x, y, &e);
 }
 
@@ -3258,6 +3377,14 @@ JL_DLLEXPORT int jl_has_empty_intersection(jl_value_t *x, jl_value_t *y)
     return intersect_types(x, y, 1) == jl_bottom_type;
 }
 
+// Conservative emptiness test without running the intersection algorithm:
+// returns 1 only when the intersection is provably empty, and 0 when the
+// types intersect or disjointness cannot be decided cheaply.
+int jl_obviously_disjoint(jl_value_t *a, jl_value_t *b)
+{
+    return obviously_disjoint(a, b, 0);
+}
+
 // return a SimpleVector of all vars from UnionAlls wrapping a given type
 jl_svec_t *jl_outer_unionall_vars(jl_value_t *u)
 {
@@ -3415,6 +3542,7 @@ jl_value_t *jl_type_intersection_env_s(jl_value_t *a, jl_value_t *b, jl_svec_t *
         jl_stenv_t e;
         init_stenv(&e, NULL, 0);
         e.intersection = e.ignore_free = 1;
+        e.fuel = INTERSECT_FUEL;
         e.envout = env;
         if (szb)
             memset(env, 0, szb*sizeof(void*));
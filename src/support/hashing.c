@@ -4,6 +4,7 @@
   Hashing
 */
 #include <stdlib.h>
+#include <string.h>
 #include "dtypes.h"
 #include "utils.h"
 #include "hashing.h"
@@ -52,10 +53,80 @@ uint32_t int64to32hash(uint64_t key)
 
 #define _MHASH_SEED_ 0xcafe8881
 
+#if defined(_P64) && defined(__SIZEOF_INT128__)
+#define MEMHASH_HAS_WIDE 1
+// Keys at least this long are hashed with the wide-multiply hash below
+// instead of MurmurHash3. The crossover is small since the wide hash
+// processes 48 bytes per iteration, but short keys dominate and keeping
+// them on MurmurHash3 keeps their hash values unchanged.
+#define MEMHASH_WIDE_THRESH 64
+
+// wyhash-style mixing: fold a 64x64->128 multiply back to 64 bits
+static inline uint64_t widemul_mix(uint64_t a, uint64_t b) JL_NOTSAFEPOINT
+{
+    unsigned __int128 r = (unsigned __int128)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+}
+
+static inline uint64_t widemul_read8(const char *p) JL_NOTSAFEPOINT
+{
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+// Wide-multiply hash (following wyhash), ~8 bytes/cycle on 64-bit
+// hardware vs ~2 for MurmurHash3. Requires n >= 16; only reached via
+// MEMHASH_WIDE_THRESH above.
+static uint64_t memhash_wide(const char *buf, size_t n, uint64_t seed) JL_NOTSAFEPOINT
+{
+    static const uint64_t sec[4] = {
+        0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+        0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+    };
+    const char *p = buf;
+    size_t i = n;
+    uint64_t a, b;
+    seed ^= widemul_mix(seed ^ sec[0], sec[1]);
+    if (i > 48) {
+        uint64_t see1 = seed, see2 = seed;
+        do {
+            seed = widemul_mix(widemul_read8(p) ^ sec[1],
+                               widemul_read8(p + 8) ^ seed);
+            see1 = widemul_mix(widemul_read8(p + 16) ^ sec[2],
+                               widemul_read8(p + 24) ^ see1);
+            see2 = widemul_mix(widemul_read8(p + 32) ^ sec[3],
+                               widemul_read8(p + 40) ^ see2);
+            p += 48;
+            i -= 48;
+        } while (i > 48);
+        seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+        seed = widemul_mix(widemul_read8(p) ^ sec[1],
+                           widemul_read8(p + 8) ^ seed);
+        p += 16;
+        i -= 16;
+    }
+    a = widemul_read8(p + i - 16) ^ sec[1];
+    b = widemul_read8(p + i - 8) ^ seed;
+    {
+        unsigned __int128 r = (unsigned __int128)a * b;
+        a = (uint64_t)r;
+        b = (uint64_t)(r >> 64);
+    }
+    return widemul_mix(a ^ sec[0] ^ n, b ^ sec[1]);
+}
+#endif
+
 uint64_t memhash(const char *buf, size_t n)
 {
     uint64_t out[2];
 
+#ifdef MEMHASH_HAS_WIDE
+    if (n >= MEMHASH_WIDE_THRESH)
+        return memhash_wide(buf, n, _MHASH_SEED_);
+#endif
     // TODO: expose 128-bit hash
 #ifdef _P64
     MurmurHash3_x64_128(buf, n, _MHASH_SEED_, out);
@@ -69,6 +140,10 @@ uint64_t memhash_seed(const char *buf, size_t n, uint32_t seed)
 {
     uint64_t out[2];
 
+#ifdef MEMHASH_HAS_WIDE
+    if (n >= MEMHASH_WIDE_THRESH)
+        return memhash_wide(buf, n, seed);
+#endif
     // TODO: expose 128-bit hash
 #ifdef _P64
     MurmurHash3_x64_128(buf, n, seed, out);
@@ -82,14 +157,45 @@ uint32_t memhash32(const char *buf, size_t n)
 {
     uint32_t out;
 
+#ifdef MEMHASH_HAS_WIDE
+    if (n >= MEMHASH_WIDE_THRESH) {
+        uint64_t h = memhash_wide(buf, n, _MHASH_SEED_);
+        return (uint32_t)(h ^ (h >> 32));
+    }
+#endif
     MurmurHash3_x86_32(buf, n, _MHASH_SEED_, &out);
     return out;
 }
 
+// Seeded 64-bit digest for bulk integrity checking: the wide-multiply hash
+// above where it exists (~8 bytes/cycle), MurmurHash3 otherwise. The value
+// is stable within a build but not across word sizes, so formats using it
+// must record which checksum they wrote (see dump.c's compressed sections).
+JL_DLLEXPORT uint64_t jl_checksum_fast64(const char *buf, size_t n, uint64_t seed)
+{
+#ifdef MEMHASH_HAS_WIDE
+    if (n >= 16)
+        return memhash_wide(buf, n, seed);
+#endif
+    uint64_t out[2];
+#ifdef _P64
+    MurmurHash3_x64_128(buf, n, (uint32_t)(seed ^ (seed >> 32)), out);
+#else
+    MurmurHash3_x86_128(buf, n, (uint32_t)(seed ^ (seed >> 32)), out);
+#endif
+    return out[1] ^ seed;
+}
+
 uint32_t memhash32_seed(const char *buf, size_t n, uint32_t seed)
 {
     uint32_t out;
 
+#ifdef MEMHASH_HAS_WIDE
+    if (n >= MEMHASH_WIDE_THRESH) {
+        uint64_t h = memhash_wide(buf, n, seed);
+        return (uint32_t)(h ^ (h >> 32));
+    }
+#endif
     MurmurHash3_x86_32(buf, n, seed, &out);
     return out;
 }
@@ -23,19 +23,25 @@ htable_t *htable_new(htable_t *h, size_t size)
     if (size <= HT_N_INLINE / 2) {
         h->size = size = HT_N_INLINE;
         h->table = &h->_space[0];
+        h->meta = &h->_metaspace[0];
     }
     else {
         size = next_power_of_two(size);
         size *= 2;  // 2 pointers per key/value pair
         size *= 2;  // aim for 50% occupancy
         h->size = size;
-        h->table = (void**)LLT_ALLOC(size * sizeof(void*));
+        // control bytes (one per slot, plus a mirrored group for wrapping)
+        // are carved out of the same allocation, after the slots
+        h->table = (void**)LLT_ALLOC(size * sizeof(void*) + size / 2 + HT_GROUP_SIZE);
     }
     if (h->table == NULL)
         return NULL;
+    if (h->table != &h->_space[0])
+        h->meta = (unsigned char*)&h->table[size];
     size_t i;
     for (i = 0; i < size; i++)
         h->table[i] = HT_NOTFOUND;
+    memset(h->meta, 0, size / 2 + HT_GROUP_SIZE);
     return h;
 }
 
@@ -59,6 +65,7 @@ void htable_reset(htable_t *h, size_t sz)
         size_t i, hsz = h->size;
         for (i = 0; i < hsz; i++)
             h->table[i] = HT_NOTFOUND;
+        memset(h->meta, 0, hsz / 2 + HT_GROUP_SIZE);
     }
 }
 
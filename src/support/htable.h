@@ -5,6 +5,9 @@
 
 #define HT_N_INLINE 32
 
+// slots probed per control-byte group scan
+#define HT_GROUP_SIZE 16
+
 #include "analyzer_annotations.h"
 #include <stddef.h>
 
@@ -20,11 +23,20 @@ extern "C" {
 // where `2*i < size`. An empty slot at index `i` is indicated with
 // `value == HT_NOTFOUND`.
 //
-// `_space` is reserved space for efficiently allocating small tables.
+// `meta` holds one control byte per slot (0 for never-occupied, else the
+// high bit plus 7 bits of the key's hash) so that probing scans a group
+// of 16 bytes at a time instead of touching the key/value lines; the
+// first 16 bytes are mirrored past the end so groups can wrap without
+// branching. Iterating `table` directly as above remains valid.
+//
+// `_space`/`_metaspace` are reserved space for efficiently allocating
+// small tables.
 typedef struct {
     size_t size;
     void **table;
+    unsigned char *meta;
     void *_space[HT_N_INLINE];
+    unsigned char _metaspace[HT_N_INLINE];
 } htable_t;
 
 // define this to be an invalid key/value
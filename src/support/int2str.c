@@ -1,6 +1,7 @@
 // This file is a part of Julia. License is MIT: https://julialang.org/license
 
 #include <stdlib.h>
+#include <string.h>
 #include "dtypes.h"
 #include "utils.h"
 
@@ -8,12 +9,35 @@
 extern "C" {
 #endif
 
+// all two-digit decimal numbers "00".."99", for emitting base-10 output two
+// digits per divide
+static const char dec_d100[] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
 char *uint2str(char *dest, size_t len, uint64_t num, uint32_t base)
 {
     int i = len-1;
     uint64_t b = (uint64_t)base;
     char ch;
     dest[i--] = '\0';
+    if (base == 10) {
+        while (i >= 1 && num >= 100) {
+            const char *d = &dec_d100[2 * (num % 100)];
+            dest[i--] = d[1];
+            dest[i--] = d[0];
+            num /= 100;
+        }
+        while (i >= 0) {
+            dest[i--] = (char)('0' + num % 10);
+            num /= 10;
+            if (num == 0)
+                break;
+        }
+        return &dest[i+1];
+    }
     while (i >= 0) {
         ch = (char)(num % b);
         if (ch < 10)
@@ -28,6 +52,26 @@ char *uint2str(char *dest, size_t len, uint64_t num, uint32_t base)
     return &dest[i+1];
 }
 
+// format `n` numbers into `dest` back to back, each NUL-terminated, with the
+// starting offset of the i-th string stored in offs[i]; returns the total
+// number of bytes used, or 0 if `dest` is too small to hold all of them
+JL_DLLEXPORT size_t uint2str_batch(char *dest, size_t len, const uint64_t *nums,
+                                   size_t n, uint32_t base, size_t *offs)
+{
+    char buf[66]; // enough for 64 binary digits plus the terminator
+    size_t i, sl, pos = 0;
+    for (i = 0; i < n; i++) {
+        char *s = uint2str(buf, sizeof(buf), nums[i], base);
+        sl = (size_t)(&buf[sizeof(buf) - 1] - s);
+        if (pos + sl + 1 > len)
+            return 0;
+        memcpy(&dest[pos], s, sl + 1);
+        offs[i] = pos;
+        pos += sl + 1;
+    }
+    return pos;
+}
+
 int isdigit_base(char c, int base)
 {
     if (base < 11)
@@ -960,6 +960,14 @@ ios_t *ios_file(ios_t *s, const char *fname, int rd, int wr, int create, int tru
     if (fd == -1)
         goto open_file_err;
 
+#if !defined(_OS_WINDOWS_) && defined(POSIX_FADV_SEQUENTIAL)
+    // Read-only ios_t consumers (serialized module loading in particular)
+    // overwhelmingly read the file front to back; tell the kernel so it
+    // enlarges the readahead window and read() rarely blocks on the disk.
+    if (rd && !wr)
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
     s = ios_fd(s, fd, 1, 1);
     s->fpos = 0;
     if (!rd)
@@ -1216,6 +1224,86 @@ char *ios_readline(ios_t *s)
     return ios_take_buffer(&dest, &n);
 }
 
+// whether the buffered bytes are all the stream will ever deliver
+static int ios_source_exhausted(ios_t *s)
+{
+    return s->bm == bm_mem || s->fd == -1 || s->_eof;
+}
+
+// Zero-copy line iteration: return a pointer to the next '\n'-terminated
+// record directly inside the stream's buffer, with its length (including the
+// terminator; the final record of a stream may lack one) in *len. Returns
+// NULL at end of stream. The pointer is only valid until the next operation
+// on `s`, since refilling can move or reallocate the buffer; callers that
+// need the bytes beyond that must copy them (or use ios_readline).
+char *ios_nextline(ios_t *s, size_t *len)
+{
+    size_t scanned = 0; // prefix already known to contain no '\n'
+    while (1) {
+        size_t avail = (size_t)(s->size - s->bpos);
+        if (avail > scanned) {
+            char *pd = (char*)memchr(s->buf + s->bpos + scanned, '\n', avail - scanned);
+            if (pd != NULL) {
+                char *start = s->buf + s->bpos;
+                *len = (size_t)(pd - start) + 1;
+                s->bpos += *len;
+                return start;
+            }
+            scanned = avail;
+        }
+        if (ios_source_exhausted(s)) {
+            if (avail == 0)
+                return NULL;
+            // final record without a terminator
+            char *start = s->buf + s->bpos;
+            *len = avail;
+            s->bpos = s->size;
+            return start;
+        }
+        // refill, keeping the whole partial record buffered; this can move
+        // or grow the buffer, so restart the address computations
+        if (ios_readprep(s, avail + LINE_CHUNK_SIZE) <= avail) {
+            // no progress; treat as end of stream like ios_copyuntil does
+            s->_eof = 1;
+        }
+    }
+}
+
+// Batch variant of ios_nextline: carve up to `nmax` consecutive records out
+// of the buffered data (refilled at most once, up front), storing their
+// start pointers in `lines` and lengths in `lens`. All returned pointers
+// stay valid together until the next operation on `s`, since no refill
+// happens once carving starts. A partial record at the end of the buffer is
+// left for the next call, so a short count means the buffer needs another
+// refill, not end of stream; only a return of 0 with ios_eof(s) means the
+// records are exhausted.
+size_t ios_nextline_batch(ios_t *s, char **lines, size_t *lens, size_t nmax)
+{
+    // readprep tops the buffer up from the fd in one read, so the refill
+    // cost is amortized over every record buffered here
+    size_t avail = ios_readprep(s, LINE_CHUNK_SIZE);
+    size_t i = 0;
+    while (i < nmax && avail > 0) {
+        char *start = s->buf + s->bpos;
+        char *pd = (char*)memchr(start, '\n', avail);
+        size_t len;
+        if (pd == NULL) {
+            if (!ios_source_exhausted(s))
+                break; // incomplete record; more data may come
+            len = avail; // final record without a terminator
+        }
+        else {
+            len = (size_t)(pd - start) + 1;
+        }
+        lines[i] = start;
+        lens[i] = len;
+        i++;
+        s->bpos += len;
+        avail -= len;
+    }
+    return i;
+}
+
 extern int vasprintf(char **strp, const char *fmt, va_list ap);
 
 int ios_vprintf(ios_t *s, const char *format, va_list args)
@@ -135,6 +135,10 @@ JL_DLLEXPORT int ios_vprintf(ios_t *s, const char *format, va_list args);
 JL_DLLEXPORT int ios_getutf8(ios_t *s, uint32_t *pwc);
 JL_DLLEXPORT int ios_peekutf8(ios_t *s, uint32_t *pwc);
 JL_DLLEXPORT char *ios_readline(ios_t *s) JL_NOTSAFEPOINT;
+// zero-copy record iteration; the returned pointers alias the stream buffer
+// and are only valid until the next operation on the stream
+JL_DLLEXPORT char *ios_nextline(ios_t *s, size_t *len) JL_NOTSAFEPOINT;
+JL_DLLEXPORT size_t ios_nextline_batch(ios_t *s, char **lines, size_t *lens, size_t nmax) JL_NOTSAFEPOINT;
 
 // discard data buffered for reading
 JL_DLLEXPORT void ios_purge(ios_t *s);
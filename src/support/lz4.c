@@ -0,0 +1,194 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+/*
+  self-contained codec for the LZ4 block format
+  (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md)
+
+  This is a greedy single-pass compressor with a 64K-entry hash table, in
+  the spirit of the reference implementation's fast mode. Output produced
+  here is valid LZ4 and external LZ4 blocks decode here, but no framing is
+  implied: callers must record the compressed and uncompressed sizes
+  themselves (see the cache-file chunk format in dump.c).
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "dtypes.h"
+#include "lz4.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LZ4_HASH_LOG    16
+#define LZ4_HASH_SIZE   ((size_t)1 << LZ4_HASH_LOG)
+#define LZ4_MAX_DIST    65535
+#define LZ4_MIN_MATCH   4
+// format rules: the last 5 bytes are always literals, and the last match
+// must start at least 12 bytes before the end of the block
+#define LZ4_LAST_LITERALS  5
+#define LZ4_MF_LIMIT       12
+
+static uint32_t lz4_read32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t lz4_hash(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - LZ4_HASH_LOG);
+}
+
+// worst-case compressed size for `n` input bytes (incompressible input
+// expands by 1 byte per 255 plus the trailing-literal token overhead)
+size_t jl_lz4_compress_bound(size_t n)
+{
+    return n + n / 255 + 16;
+}
+
+// compress `n` bytes into `dst`; returns the compressed size, or 0 if the
+// output does not fit in `cap` (give jl_lz4_compress_bound(n) to rule that out)
+size_t jl_lz4_compress(const char *src, size_t n, char *dst, size_t cap)
+{
+    const uint8_t *ip = (const uint8_t*)src;
+    const uint8_t *iend = ip + n;
+    const uint8_t *anchor = ip;
+    const uint8_t *mflimit = n > LZ4_MF_LIMIT ? iend - LZ4_MF_LIMIT : ip;
+    const uint8_t *matchlimit = iend - LZ4_LAST_LITERALS;
+    uint8_t *op = (uint8_t*)dst;
+    uint8_t *oend = op + cap;
+    uint32_t *htab;
+    size_t l;
+    if (n > LZ4_MF_LIMIT) {
+        // table entries are `offset from src + 1`, so that 0 means empty
+        htab = (uint32_t*)calloc(LZ4_HASH_SIZE, sizeof(uint32_t));
+        if (htab == NULL)
+            return 0;
+        while (ip < mflimit) {
+            uint32_t seq = lz4_read32(ip);
+            uint32_t h = lz4_hash(seq);
+            const uint8_t *match = (const uint8_t*)src + htab[h] - 1;
+            int hit = htab[h] != 0 && (size_t)(ip - match) <= LZ4_MAX_DIST &&
+                      lz4_read32(match) == seq;
+            htab[h] = (uint32_t)(ip - (const uint8_t*)src) + 1;
+            if (!hit) {
+                ip++;
+                continue;
+            }
+            // extend the match forward, leaving the mandatory trailing literals
+            const uint8_t *mp = match + LZ4_MIN_MATCH;
+            const uint8_t *p = ip + LZ4_MIN_MATCH;
+            while (p < matchlimit && *p == *mp) {
+                p++;
+                mp++;
+            }
+            size_t litlen = (size_t)(ip - anchor);
+            size_t mlen = (size_t)(p - ip) - LZ4_MIN_MATCH;
+            if ((size_t)(oend - op) < litlen + litlen / 255 + mlen / 255 + 8) {
+                free(htab);
+                return 0;
+            }
+            uint8_t *token = op++;
+            *token = (litlen < 15 ? (uint8_t)litlen : 15) << 4;
+            if (litlen >= 15) {
+                for (l = litlen - 15; l >= 255; l -= 255)
+                    *op++ = 255;
+                *op++ = (uint8_t)l;
+            }
+            memcpy(op, anchor, litlen);
+            op += litlen;
+            uint16_t dist = (uint16_t)(ip - match);
+            *op++ = (uint8_t)dist;
+            *op++ = (uint8_t)(dist >> 8);
+            *token |= mlen < 15 ? (uint8_t)mlen : 15;
+            if (mlen >= 15) {
+                for (l = mlen - 15; l >= 255; l -= 255)
+                    *op++ = 255;
+                *op++ = (uint8_t)l;
+            }
+            ip = p;
+            anchor = ip;
+            if (ip < mflimit)
+                htab[lz4_hash(lz4_read32(ip - 2))] =
+                    (uint32_t)(ip - 2 - (const uint8_t*)src) + 1;
+        }
+        free(htab);
+    }
+    // trailing literal run (always present, even for an empty input)
+    size_t litlen = (size_t)(iend - anchor);
+    if ((size_t)(oend - op) < litlen + litlen / 255 + 2)
+        return 0;
+    uint8_t *token = op++;
+    *token = (litlen < 15 ? (uint8_t)litlen : 15) << 4;
+    if (litlen >= 15) {
+        for (l = litlen - 15; l >= 255; l -= 255)
+            *op++ = 255;
+        *op++ = (uint8_t)l;
+    }
+    memcpy(op, anchor, litlen);
+    op += litlen;
+    return (size_t)(op - (uint8_t*)dst);
+}
+
+// decompress an LZ4 block of `n` bytes into `dst`; returns the decompressed
+// size, or 0 if the input is malformed or the output exceeds `cap`
+size_t jl_lz4_decompress(const char *src, size_t n, char *dst, size_t cap)
+{
+    const uint8_t *ip = (const uint8_t*)src;
+    const uint8_t *iend = ip + n;
+    uint8_t *op = (uint8_t*)dst;
+    uint8_t *oend = op + cap;
+    if (n == 0)
+        return 0;
+    for (;;) {
+        if (ip >= iend)
+            return 0;
+        uint8_t token = *ip++;
+        size_t litlen = token >> 4;
+        if (litlen == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend)
+                    return 0;
+                b = *ip++;
+                litlen += b;
+            } while (b == 255);
+        }
+        if (litlen > (size_t)(iend - ip) || litlen > (size_t)(oend - op))
+            return 0;
+        memcpy(op, ip, litlen);
+        op += litlen;
+        ip += litlen;
+        if (ip == iend)
+            break; // the block ends with its final literal run
+        if (iend - ip < 2)
+            return 0;
+        size_t dist = ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (dist == 0 || dist > (size_t)(op - (uint8_t*)dst))
+            return 0;
+        size_t mlen = (token & 15) + LZ4_MIN_MATCH;
+        if ((token & 15) == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend)
+                    return 0;
+                b = *ip++;
+                mlen += b;
+            } while (b == 255);
+        }
+        if (mlen > (size_t)(oend - op))
+            return 0;
+        // byte-at-a-time: matches may overlap their own output
+        const uint8_t *mp = op - dist;
+        while (mlen--)
+            *op++ = *mp++;
+    }
+    return (size_t)(op - (uint8_t*)dst);
+}
+
+#ifdef __cplusplus
+}
+#endif
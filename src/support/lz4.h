@@ -0,0 +1,18 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+#ifndef JL_LZ4_H
+#define JL_LZ4_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+JL_DLLEXPORT size_t jl_lz4_compress_bound(size_t n);
+JL_DLLEXPORT size_t jl_lz4_compress(const char *src, size_t n, char *dst, size_t cap);
+JL_DLLEXPORT size_t jl_lz4_decompress(const char *src, size_t n, char *dst, size_t cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -9,6 +9,8 @@ extern "C" {
 
 JL_DLLEXPORT double jl_strtod_c(const char *nptr, char **endptr);
 JL_DLLEXPORT float jl_strtof_c(const char *nptr, char **endptr);
+JL_DLLEXPORT size_t jl_strtod_batch(const char *nptr, char **endptr, char sep,
+                                    double *vals, size_t nvals);
 
 #ifdef __cplusplus
 }
@@ -37,6 +37,24 @@
 
 #include "utf8.h"
 
+#ifdef _CPU_X86_64_
+#include <emmintrin.h>
+
+// advance over a run of ASCII bytes 16 at a time; stops at the first block
+// containing a high byte, or when fewer than 16 bytes remain
+static inline const unsigned char *u8_skim_ascii(const unsigned char *p,
+                                                 const unsigned char *pend)
+{
+    while (p + 16 <= pend) {
+        __m128i x = _mm_loadu_si128((const __m128i*)p);
+        if (_mm_movemask_epi8(x))
+            break;
+        p += 16;
+    }
+    return p;
+}
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -224,6 +242,18 @@ size_t u8_offset(const char *s, size_t charnum)
 size_t u8_charnum(const char *s, size_t offset)
 {
     size_t charnum = 0;
+#ifdef _CPU_X86_64_
+    // count 16 bytes at a time: a byte starts a character unless it is a
+    // continuation byte 0x80..0xbf, i.e. unless (signed)byte < -64
+    const __m128i c64 = _mm_set1_epi8(-64);
+    while (offset >= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)s);
+        unsigned cont = (unsigned)_mm_movemask_epi8(_mm_cmplt_epi8(x, c64));
+        charnum += 16 - __builtin_popcount(cont);
+        s += 16;
+        offset -= 16;
+    }
+#endif
     if (offset) {
        do {
           // Simply not count continuation bytes
@@ -243,6 +273,27 @@ size_t u8_strwidth(const char *s)
 
     while ((sc = (signed char)*s) != 0) {
         if (sc >= 0) {
+#if defined(_CPU_X86_64_) && !defined(_COMPILER_ASAN_ENABLED_)
+            // the aligned loads may read (harmlessly) past the end of the
+            // allocation, which a sanitizer would flag
+            if (((uintptr_t)s & 15) == 0) {
+                // aligned loads cannot fault before the terminator, so we may
+                // consume whole blocks of nonzero ASCII (each of width 1)
+                for (;;) {
+                    __m128i x = _mm_load_si128((const __m128i*)s);
+                    __m128i z = _mm_cmpeq_epi8(x, _mm_setzero_si128());
+                    if (_mm_movemask_epi8(x) | _mm_movemask_epi8(z))
+                        break;
+                    tot += 16;
+                    s += 16;
+                }
+                sc = (signed char)*s;
+                if (sc == 0)
+                    break;
+                if (sc < 0)
+                    continue;
+            }
+#endif
             s++;
             if (sc) tot++;
         }
@@ -454,6 +505,44 @@ char *u8_memchr(const char *s, uint32_t ch, size_t sz, size_t *charn)
     int csz;
 
     *charn = 0;
+#ifdef _CPU_X86_64_
+    if (ch < 0x80) {
+        // an ASCII needle can be searched for bytewise, counting character
+        // starts (non-continuation bytes) in bulk as we go. a stray run of
+        // continuation bytes at the very start counts as one character, so
+        // consume it here to keep the bulk count exact
+        const __m128i needle = _mm_set1_epi8((char)ch);
+        const __m128i c64 = _mm_set1_epi8(-64);
+        if (sz && !isutf(s[0])) {
+            while (i < sz && !isutf(s[i]))
+                i++;
+            (*charn)++;
+        }
+        while (i + 16 <= sz) {
+            __m128i x = _mm_loadu_si128((const __m128i*)&s[i]);
+            unsigned hit = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, needle));
+            unsigned cont = (unsigned)_mm_movemask_epi8(_mm_cmplt_epi8(x, c64));
+            while (hit) {
+                unsigned j = (unsigned)__builtin_ctz(hit);
+                // a matching byte trailed by continuation bytes decodes as
+                // part of a longer (malformed) sequence and is not a match
+                if (i + j + 1 < sz && !isutf(s[i + j + 1])) {
+                    hit &= hit - 1;
+                    continue;
+                }
+                *charn += __builtin_popcount(~cont & ((1u << j) - 1));
+                return (char*)&s[i + j];
+            }
+            *charn += 16 - __builtin_popcount(cont);
+            i += 16;
+        }
+        // a character may straddle the last block boundary; its start byte
+        // was already counted, so skip its remaining continuation bytes
+        while (i < sz && !isutf(s[i]))
+            i++;
+        lasti = i;
+    }
+#endif
     while (i < sz) {
         c = csz = 0;
         do {
@@ -550,6 +639,10 @@ int u8_isvalid(const char *str, size_t len)
     pnt = (unsigned char *)str;
     pend = (unsigned char *)str + len;
     // First scan for non-ASCII characters as fast as possible
+#ifdef _CPU_X86_64_
+    pnt = u8_skim_ascii(pnt, pend);
+    if (pnt == pend) return 1;
+#endif
     do {
         if (*pnt++ & 0x80) goto chkutf8;
     } while (pnt < pend);
@@ -590,6 +683,9 @@ chkutf8:
         pnt += 3;
     }
     // Find next non-ASCII characters as fast as possible
+#ifdef _CPU_X86_64_
+    pnt = u8_skim_ascii(pnt, pend);
+#endif
     while (pnt < pend) {
         if (*pnt++ & 0x80) goto chkutf8;
     }
@@ -8,6 +8,8 @@ extern "C" {
 #endif
 
 char *uint2str(char *dest, size_t len, uint64_t num, uint32_t base);
+JL_DLLEXPORT size_t uint2str_batch(char *dest, size_t len, const uint64_t *nums,
+                                   size_t n, uint32_t base, size_t *offs);
 int str2int(char *str, size_t len, int64_t *res, uint32_t base);
 int isdigit_base(char c, int base);
 
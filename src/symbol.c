@@ -17,6 +17,23 @@ extern "C" {
 
 static _Atomic(jl_sym_t*) symtab = NULL;
 
+// Open-addressing hash index over the symbol tree. The tree remains the
+// authoritative structure (serialization and `jl_get_root_symbol` walk it);
+// the index exists so that the interning fast path is a wait-free O(1) probe
+// instead of an O(depth) pointer chase. Lookups never take a lock; inserts
+// and resizes are serialized by `gc_perm_lock`, which the insert path of
+// `_jl_symbol` already holds. Old tables are leaked on resize since readers
+// may still be probing them (total waste is bounded by the final table size).
+typedef struct {
+    size_t sz;    // power of two
+    size_t count; // only mutated with gc_perm_lock held
+    _Atomic(jl_sym_t*) tab[1];
+} jl_symhash_t;
+
+static _Atomic(jl_symhash_t*) symhash = NULL;
+
+#define SYMHASH_INIT_SZ (1 << 14)
+
 #define MAX_SYM_LEN ((size_t)INTPTR_MAX - sizeof(jl_taggedvalue_t) - sizeof(jl_sym_t) - 1)
 
 static uintptr_t hash_symbol(const char *str, size_t len) JL_NOTSAFEPOINT
@@ -76,6 +93,55 @@ static jl_sym_t *symtab_lookup(_Atomic(jl_sym_t*) *ptree, const char *str, size_
     return node;
 }
 
+static jl_sym_t *symhash_lookup(const char *str, size_t len, uintptr_t h) JL_NOTSAFEPOINT
+{
+    jl_symhash_t *tab = jl_atomic_load_acquire(&symhash);
+    if (tab == NULL)
+        return NULL;
+    size_t mask = tab->sz - 1;
+    for (size_t i = h & mask;; i = (i + 1) & mask) {
+        jl_sym_t *node = jl_atomic_load_acquire(&tab->tab[i]);
+        if (node == NULL)
+            return NULL;
+        if (node->hash == h && strncmp(str, jl_symbol_name(node), len) == 0 &&
+            jl_symbol_name(node)[len] == 0)
+            return node;
+    }
+}
+
+// requires gc_perm_lock to be held
+static void symhash_insert_slot(jl_symhash_t *tab, jl_sym_t *sym) JL_NOTSAFEPOINT
+{
+    size_t mask = tab->sz - 1;
+    size_t i = sym->hash & mask;
+    while (jl_atomic_load_relaxed(&tab->tab[i]) != NULL)
+        i = (i + 1) & mask;
+    jl_atomic_store_release(&tab->tab[i], sym);
+    tab->count++;
+}
+
+// requires gc_perm_lock to be held
+static void symhash_insert(jl_sym_t *sym) JL_NOTSAFEPOINT
+{
+    jl_symhash_t *tab = jl_atomic_load_relaxed(&symhash);
+    if (tab == NULL || tab->count >= tab->sz - tab->sz / 4) {
+        size_t newsz = tab == NULL ? SYMHASH_INIT_SZ : tab->sz * 2;
+        jl_symhash_t *newtab = (jl_symhash_t*)jl_gc_perm_alloc_nolock(
+                offsetof(jl_symhash_t, tab) + newsz * sizeof(void*), 1, sizeof(void*), 0);
+        newtab->sz = newsz;
+        if (tab != NULL) {
+            for (size_t i = 0; i < tab->sz; i++) {
+                jl_sym_t *node = jl_atomic_load_relaxed(&tab->tab[i]);
+                if (node != NULL)
+                    symhash_insert_slot(newtab, node);
+            }
+        }
+        jl_atomic_store_release(&symhash, newtab);
+        tab = newtab;
+    }
+    symhash_insert_slot(tab, sym);
+}
+
 jl_sym_t *_jl_symbol(const char *str, size_t len) JL_NOTSAFEPOINT // (or throw)
 {
 #ifndef __clang_gcanalyzer__
@@ -85,17 +151,18 @@ jl_sym_t *_jl_symbol(const char *str, size_t len) JL_NOTSAFEPOINT // (or throw)
         jl_exceptionf(jl_argumenterror_type, "Symbol name too long");
 #endif
     assert(!memchr(str, 0, len));
-    _Atomic(jl_sym_t*) *slot;
-    jl_sym_t *node = symtab_lookup(&symtab, str, len, &slot);
+    jl_sym_t *node = symhash_lookup(str, len, hash_symbol(str, len));
     if (node == NULL) {
+        // May have raced with an insert, or the symbol may be new:
+        // the tree is authoritative, so recheck it under the lock.
+        _Atomic(jl_sym_t*) *slot;
         uv_mutex_lock(&gc_perm_lock);
-        // Someone might have updated it, check and look up again
-        if (jl_atomic_load_relaxed(slot) != NULL && (node = symtab_lookup(slot, str, len, &slot))) {
-            uv_mutex_unlock(&gc_perm_lock);
-            return node;
+        node = symtab_lookup(&symtab, str, len, &slot);
+        if (node == NULL) {
+            node = mk_symbol(str, len);
+            symhash_insert(node);
+            jl_atomic_store_release(slot, node);
         }
-        node = mk_symbol(str, len);
-        jl_atomic_store_release(slot, node);
         uv_mutex_unlock(&gc_perm_lock);
     }
     return node;
@@ -108,7 +175,11 @@ JL_DLLEXPORT jl_sym_t *jl_symbol(const char *str) JL_NOTSAFEPOINT // (or throw)
 
 JL_DLLEXPORT jl_sym_t *jl_symbol_lookup(const char *str) JL_NOTSAFEPOINT
 {
-    return symtab_lookup(&symtab, str, strlen(str), NULL);
+    size_t len = strlen(str);
+    jl_sym_t *node = symhash_lookup(str, len, hash_symbol(str, len));
+    if (node == NULL)
+        node = symtab_lookup(&symtab, str, len, NULL);
+    return node;
 }
 
 JL_DLLEXPORT jl_sym_t *jl_symbol_n(const char *str, size_t len)
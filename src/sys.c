@@ -93,6 +93,91 @@ JL_DLLEXPORT int64_t jl_lseek(HANDLE fd, int64_t offset, int whence)
 #endif
 JL_DLLEXPORT int jl_sizeof_ios_t(void) { return sizeof(ios_t); }
 
+// --- image mapping layer ---
+// Unified mmap policy for the system image and package cache files. The
+// deserializers used to fault these in one 4K page at a time as the
+// restore walk touched them, which turns startup into random-read I/O on
+// slow (e.g. network) filesystems. The flags below let each call site say
+// how its mapping will be used; unsupported hints degrade to nothing.
+
+#ifndef _OS_WINDOWS_
+
+typedef struct {
+    char *data;
+    size_t len;
+} jl_image_prefault_job_t;
+
+static void jl_image_prefault_threadfun(void *arg)
+{
+    jl_image_prefault_job_t *job = (jl_image_prefault_job_t*)arg;
+    size_t pagesz = jl_getpagesize();
+    volatile char sink = 0;
+    for (size_t i = 0; i < job->len; i += pagesz)
+        sink += job->data[i];
+    (void)sink;
+    free(job);
+}
+
+#endif
+
+// apply paging policy to an existing mapping (e.g. the image blob inside a
+// dlopen'd sysimage shared library, which we did not map ourselves)
+void jl_image_hint(void *data, size_t len, int flags)
+{
+#ifndef _OS_WINDOWS_
+    size_t pagesz = jl_getpagesize();
+    uintptr_t first = (uintptr_t)data & ~(pagesz - 1);
+    uintptr_t last = LLT_ALIGN((uintptr_t)data + len, pagesz);
+#ifdef MADV_HUGEPAGE
+    if (flags & JL_IMAGE_MAP_HUGEPAGE)
+        madvise((void*)first, last - first, MADV_HUGEPAGE);
+#endif
+#ifdef MADV_WILLNEED
+    if (flags & JL_IMAGE_MAP_WILLNEED)
+        madvise((void*)first, last - first, MADV_WILLNEED);
+#endif
+    if (flags & JL_IMAGE_MAP_PREFAULT) {
+        // touch the range sequentially off-thread so page-in overlaps with
+        // the deserialization walk instead of stalling it fault by fault
+        jl_image_prefault_job_t *job = (jl_image_prefault_job_t*)malloc_s(sizeof(jl_image_prefault_job_t));
+        job->data = (char*)first;
+        job->len = last - first;
+        uv_thread_t uvtid;
+        if (uv_thread_create(&uvtid, jl_image_prefault_threadfun, job))
+            free(job);
+    }
+#else
+    (void)data; (void)len; (void)flags;
+#endif
+}
+
+// map `len` bytes of an image file starting at its beginning, with paging
+// policy applied; returns NULL if the file cannot be mapped (caller falls
+// back to reading it into a buffer)
+char *jl_image_map_file(int fd, size_t len, int flags)
+{
+#ifndef _OS_WINDOWS_
+    int prot = PROT_READ | ((flags & JL_IMAGE_MAP_WRITE) ? PROT_WRITE : 0);
+    int mflags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    // prefault synchronously at map time when the kernel can do it for us;
+    // the background thread below then has nothing left to fault
+    if (flags & JL_IMAGE_MAP_PREFAULT) {
+        mflags |= MAP_POPULATE;
+        flags &= ~JL_IMAGE_MAP_PREFAULT;
+    }
+#endif
+    char *data = (char*)mmap(NULL, len, prot, mflags, fd, 0);
+    if (data == MAP_FAILED)
+        return NULL;
+    jl_image_hint(data, len, flags);
+    return data;
+#else
+    (void)fd; (void)len; (void)flags;
+    return NULL;
+#endif
+}
+
 JL_DLLEXPORT long jl_ios_fd(ios_t *s) { return s->fd; }
 
 JL_DLLEXPORT int32_t jl_nb_available(ios_t *s)
@@ -147,6 +232,74 @@ JL_DLLEXPORT int32_t jl_fstat(uv_os_fd_t fd, char *statbuf)
     return ret;
 }
 
+// Stat many paths in one call: the requests fan out across libuv's fs
+// threadpool (driven by a private loop), so probing a directory's worth of
+// paths costs a few overlapped disk round-trips instead of one per path.
+// `statbufs` must hold `npaths * sizeof(uv_stat_t)` bytes and `rets[i]`
+// receives the uv error code for `paths[i]`.
+
+typedef struct {
+    uv_fs_t req;
+    char *statbuf;
+    int32_t *ret;
+} batch_stat_req_t;
+
+static void jl_stat_batch_cb(uv_fs_t *req)
+{
+    batch_stat_req_t *r = (batch_stat_req_t*)req;
+    *r->ret = (int32_t)req->result;
+    if (req->result == 0)
+        memcpy(r->statbuf, req->ptr, sizeof(uv_stat_t));
+    uv_fs_req_cleanup(req);
+}
+
+JL_DLLEXPORT void jl_stat_batch(const char **paths, size_t npaths,
+                                char *statbufs, int32_t *rets)
+{
+    uv_loop_t loop;
+    if (npaths == 0)
+        return;
+    if (npaths == 1 || uv_loop_init(&loop) != 0) {
+        // nothing to overlap (or out of fds): stat synchronously
+        for (size_t i = 0; i < npaths; i++)
+            rets[i] = jl_stat(paths[i], statbufs + i * sizeof(uv_stat_t));
+        return;
+    }
+    batch_stat_req_t *reqs = (batch_stat_req_t*)malloc_s(npaths * sizeof(batch_stat_req_t));
+    for (size_t i = 0; i < npaths; i++) {
+        reqs[i].statbuf = statbufs + i * sizeof(uv_stat_t);
+        reqs[i].ret = &rets[i];
+        if (uv_fs_stat(&loop, &reqs[i].req, paths[i], jl_stat_batch_cb) != 0)
+            rets[i] = jl_stat(paths[i], reqs[i].statbuf);
+    }
+    uv_run(&loop, UV_RUN_DEFAULT);
+    uv_loop_close(&loop);
+    free(reqs);
+}
+
+// Ask the kernel to start reading `paths` into the page cache. The hint is
+// asynchronous and best-effort: it returns as soon as the readahead is
+// queued, so a caller that is about to open and verify each file serially
+// (package loading walks its dependency caches this way) overlaps all of
+// the disk reads with the first file's processing instead of paying one
+// cold read per file. Errors (missing files, exhausted fds) are ignored;
+// the subsequent real open will report them.
+JL_DLLEXPORT void jl_prefetch_files(const char **paths, size_t npaths)
+{
+#if !defined(_OS_WINDOWS_) && defined(POSIX_FADV_WILLNEED)
+    for (size_t i = 0; i < npaths; i++) {
+        int fd = open(paths[i], O_RDONLY);
+        if (fd == -1)
+            continue;
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        close(fd);
+    }
+#else
+    (void)paths;
+    (void)npaths;
+#endif
+}
+
 JL_DLLEXPORT unsigned int jl_stat_dev(char *statbuf)
 {
     return ((uv_stat_t*)statbuf)->st_dev;
@@ -241,6 +394,31 @@ JL_DLLEXPORT unsigned long jl_geteuid(void)
 
 // --- buffer manipulation ---
 
+// Streaming string builder: accumulate pieces into one growing ios buffer so
+// that building a large string by repeated appends costs amortized O(n)
+// instead of one full copy per concatenation.
+
+JL_DLLEXPORT ios_t *jl_string_builder_new(void)
+{
+    ios_t *s = (ios_t*)malloc_s(sizeof(ios_t));
+    ios_mem(s, 0);
+    return s;
+}
+
+JL_DLLEXPORT void jl_string_builder_write(ios_t *s, const char *data, size_t len)
+{
+    ios_write(s, data, len);
+}
+
+// take the accumulated contents as a String and free the builder
+JL_DLLEXPORT jl_value_t *jl_string_builder_take(ios_t *s)
+{
+    jl_value_t *str = jl_pchar_to_string(s->buf, s->size);
+    ios_close(s);
+    free(s);
+    return str;
+}
+
 JL_DLLEXPORT jl_array_t *jl_take_buffer(ios_t *s)
 {
     size_t n;
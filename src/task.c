@@ -368,6 +368,8 @@ static void ctx_switch(jl_task_t *lastt)
     jl_task_t **pt = &ptls->next_task;
     jl_task_t *t = *pt;
     assert(t != lastt);
+    // remember where the task runs so the scheduler can keep it node-local
+    t->last_socket = jl_thread_socket(ptls->tid);
     // none of these locks should be held across a task switch
     assert(ptls->locks.len == 0);
 
@@ -427,6 +429,11 @@ static void ctx_switch(jl_task_t *lastt)
     }
 
     // set up global state for new task and clear global state for old task
+    // charge the allocation window since the last switch to the outgoing task
+    int64_t cum_allocd = jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd);
+    lastt->allocd_bytes += cum_allocd - ptls->task_alloc_base;
+    ptls->task_alloc_base = cum_allocd;
+    jl_task_preempt_reset(ptls);
     t->ptls = ptls;
     jl_atomic_store_relaxed(&ptls->current_task, t);
     JL_GC_PROMISE_ROOTED(t);
@@ -592,6 +599,30 @@ JL_DLLEXPORT void jl_switchto(jl_task_t **pt)
     jl_switch();
 }
 
+// Cumulative bytes allocated by `t`. For the running task this includes the
+// window since it was last switched in; querying a task that is currently
+// running on another thread returns a value that may lag by that window.
+JL_DLLEXPORT int64_t jl_task_allocd_bytes(jl_task_t *t)
+{
+    int64_t v = t->allocd_bytes;
+    jl_task_t *ct = jl_current_task;
+    if (t == ct)
+        v += jl_atomic_load_relaxed(&ct->ptls->gc_num.cum_allocd) - ct->ptls->task_alloc_base;
+    return v;
+}
+
+// Read-and-zero form of jl_task_allocd_bytes, so a per-request measurement
+// is a reset followed by a read.
+JL_DLLEXPORT int64_t jl_task_reset_allocd_bytes(jl_task_t *t)
+{
+    int64_t v = jl_task_allocd_bytes(t);
+    jl_task_t *ct = jl_current_task;
+    if (t == ct)
+        ct->ptls->task_alloc_base = jl_atomic_load_relaxed(&ct->ptls->gc_num.cum_allocd);
+    t->allocd_bytes = 0;
+    return v;
+}
+
 JL_DLLEXPORT JL_NORETURN void jl_no_exc_handler(jl_value_t *e)
 {
     // NULL exception objects are used when rethrowing. we don't have a handler to process
@@ -640,6 +671,46 @@ static void JL_NORETURN throw_internal(jl_task_t *ct, jl_value_t *exception JL_M
     assert(0);
 }
 
+// Exception types registered here are thrown without capturing a backtrace:
+// stack unwinding is nearly all of the cost of a throw, which matters for
+// code using exceptions as high-rate control flow. Registered types are
+// matched exactly (not by subtyping) and `catch_backtrace` reports an empty
+// trace for them. The registry is a small lock-free array; registration pins
+// the type so the entries stay valid without a GC hook.
+#define JL_MAX_TRACE_FREE_TYPES 32
+static _Atomic(jl_value_t*) trace_free_exception_types[JL_MAX_TRACE_FREE_TYPES];
+
+JL_DLLEXPORT int jl_exception_set_trace_free(jl_value_t *ty, int tf)
+{
+    for (int i = 0; i < JL_MAX_TRACE_FREE_TYPES; i++) {
+        jl_value_t *t = jl_atomic_load_relaxed(&trace_free_exception_types[i]);
+        if (t == ty) {
+            if (!tf && jl_atomic_cmpswap(&trace_free_exception_types[i], &t, NULL))
+                jl_gc_unpin_object(ty);
+            return 1;
+        }
+    }
+    if (!tf)
+        return 1; // was not registered
+    jl_gc_pin_object(ty);
+    for (int i = 0; i < JL_MAX_TRACE_FREE_TYPES; i++) {
+        jl_value_t *expected = NULL;
+        if (jl_atomic_cmpswap(&trace_free_exception_types[i], &expected, ty))
+            return 1;
+    }
+    jl_gc_unpin_object(ty);
+    return 0; // registry full
+}
+
+STATIC_INLINE int exception_is_trace_free(jl_value_t *ty) JL_NOTSAFEPOINT
+{
+    for (int i = 0; i < JL_MAX_TRACE_FREE_TYPES; i++) {
+        if (jl_atomic_load_relaxed(&trace_free_exception_types[i]) == ty)
+            return 1;
+    }
+    return 0;
+}
+
 // record backtrace and raise an error
 JL_DLLEXPORT void jl_throw(jl_value_t *e JL_MAYBE_UNROOTED)
 {
@@ -650,7 +721,10 @@ JL_DLLEXPORT void jl_throw(jl_value_t *e JL_MAYBE_UNROOTED)
     jl_task_t *ct = jl_get_current_task();
     if (ct == NULL) // During startup
         jl_no_exc_handler(e);
-    record_backtrace(ct->ptls, 1);
+    if (__unlikely(exception_is_trace_free(jl_typeof(e))))
+        ct->ptls->bt_size = 0; // fast unhappy path: throw with an empty trace
+    else
+        record_backtrace(ct->ptls, 1);
     throw_internal(ct, e);
 }
 
@@ -756,7 +830,11 @@ void jl_rng_split(uint64_t to[4], uint64_t from[4]) JL_NOTSAFEPOINT
 JL_DLLEXPORT jl_task_t *jl_new_task(jl_function_t *start, jl_value_t *completion_future, size_t ssize)
 {
     jl_task_t *ct = jl_current_task;
-    jl_task_t *t = (jl_task_t*)jl_gc_alloc(ct->ptls, sizeof(jl_task_t), jl_task_type);
+    // prefer a shell recycled by the last sweep (see gc-stacks.c); every
+    // field is (re)initialized below either way
+    jl_task_t *t = jl_gc_take_task_shell(ct->ptls);
+    if (t == NULL)
+        t = (jl_task_t*)jl_gc_alloc(ct->ptls, sizeof(jl_task_t), jl_task_type);
     JL_PROBE_RT_NEW_TASK(ct, t);
     t->copy_stack = 0;
     if (ssize == 0) {
@@ -800,8 +878,11 @@ JL_DLLEXPORT jl_task_t *jl_new_task(jl_function_t *start, jl_value_t *completion
     t->priority = 0;
     jl_atomic_store_relaxed(&t->tid, t->copy_stack ? jl_atomic_load_relaxed(&ct->tid) : -1); // copy_stacks are always pinned since they can't be moved
     t->threadpoolid = ct->threadpoolid;
+    t->socket_hint = -1;
+    t->last_socket = -1;
     t->ptls = NULL;
     t->world_age = ct->world_age;
+    t->allocd_bytes = 0;
 
 #ifdef COPY_STACKS
     if (!t->copy_stack) {
@@ -870,9 +951,58 @@ JL_DLLEXPORT void jl_schedule_task(jl_task_t *task)
 }
 #endif
 
+// --- cooperative preemption ---
+// A compute-bound task otherwise runs until it yields explicitly, starving
+// the libuv loop and every other task on its thread. When
+// JULIA_TASK_PREEMPT is set to a quantum in nanoseconds, each task switch
+// arms a monotonic deadline on the thread, and runtime entry points that
+// are already allowed to run arbitrary Julia code (the allocation slow
+// paths, via maybe_collect in gc.c) poll it, yielding the overrunning task
+// back to the scheduler. Tasks that neither allocate nor call into the
+// runtime are still unpreemptable; forcing those from a signal handler
+// cannot be done safely, since a task switch must not happen on a signal
+// frame.
+uint64_t jl_task_preempt_quantum = 0; // 0: preemption disabled
+
+void jl_task_preempt_reset(jl_ptls_t ptls) JL_NOTSAFEPOINT
+{
+    ptls->preempt_deadline = jl_task_preempt_quantum == 0 ? UINT64_MAX :
+        jl_hrtime() + jl_task_preempt_quantum;
+}
+
+// Slow path of the poll in maybe_collect: the deadline has passed, yield if
+// the current context permits running the scheduler.
+void jl_task_maybe_preempt(jl_ptls_t ptls)
+{
+    // only preempt from states where arbitrary Julia code may already run:
+    // not inside finalizers or pure callbacks, not in a sigatomic region
+    // (which covers the runtime locks), not inside a compiler arena region,
+    // and not before the scheduler exists
+    if (ptls->in_finalizer || ptls->in_pure_callback ||
+        ptls->finalizers_inhibited || ptls->defer_signal ||
+        ptls->gc_arena_depth > 0 || !jl_base_module)
+        return;
+    // push the deadline out before yielding so that polls reached while the
+    // scheduler itself runs (it allocates too) don't recurse
+    jl_task_preempt_reset(ptls);
+    jl_yield();
+}
+
 // Do one-time initializations for task system
 void jl_init_tasks(void) JL_GC_DISABLED
 {
+    char *pq = getenv(TASK_PREEMPT_QUANTUM_NAME);
+    if (pq) {
+        char *endp;
+        unsigned long long quantum = strtoull(pq, &endp, 10);
+        if (endp != pq && *endp == '\0') {
+            jl_task_preempt_quantum = quantum;
+        }
+        else {
+            jl_safe_printf("invalid " TASK_PREEMPT_QUANTUM_NAME " value: %s\n", pq);
+            exit(1);
+        }
+    }
     char *acs = getenv("JULIA_COPY_STACKS");
     if (acs) {
         if (!strcmp(acs, "1") || !strcmp(acs, "yes"))
@@ -1034,6 +1164,115 @@ static void jl_set_fiber(jl_ucontext_t *t)
     unw_resume(&c);
 }
 #elif defined(JL_HAVE_ASM)
+
+// Hand-written fiber switch for the common Linux targets. A cooperative task
+// switch only needs to preserve what the C ABI says survives a function call:
+// the callee-saved registers, the stack pointer and the resume address.
+// sigsetjmp/siglongjmp additionally go through the libc PLT, (de)mangle the
+// saved pointers and branch on the (unused) saved-mask flag, and swapcontext
+// is a full sigprocmask syscall; the straight-line loads and stores below
+// switch in a few dozen cycles. The register layout inside uc_mcontext is
+// private to these routines: a context written by jl_fiber_swap_asm can only
+// be resumed by jl_fiber_set_asm, never by jl_longjmp, so every save and
+// resume of a non-copy fiber context below must go through this pair.
+#if defined(_OS_LINUX_) && !defined(JL_HAVE_UNW_CONTEXT) && \
+    (defined(_CPU_X86_64_) || defined(_CPU_AARCH64_)) && \
+    !defined(_COMPILER_TSAN_ENABLED_) && !defined(_COMPILER_ASAN_ENABLED_)
+#define JL_HAVE_FAST_SWITCH
+#endif
+
+#ifdef JL_HAVE_FAST_SWITCH
+void jl_fiber_swap_asm(uintptr_t *save_ctx, uintptr_t *restore_ctx) JL_NOTSAFEPOINT;
+void JL_NORETURN jl_fiber_set_asm(uintptr_t *restore_ctx) JL_NOTSAFEPOINT;
+#if defined(_CPU_X86_64_)
+// layout (8-byte slots): 0 rsp, 1 rip, 2 rbx, 3 rbp, 4 r12, 5 r13, 6 r14, 7 r15
+static_assert(sizeof(jl_jmp_buf) >= 8 * sizeof(uintptr_t), "fiber context does not fit in jmp_buf");
+asm(".text\n"
+    ".p2align 4\n"
+    ".global jl_fiber_swap_asm\n"
+    ".hidden jl_fiber_swap_asm\n"
+    ".type jl_fiber_swap_asm,@function\n"
+"jl_fiber_swap_asm:\n"
+    "\tmovq (%rsp), %rax\n"       // return address is the resume point
+    "\tleaq 8(%rsp), %rcx\n"      // caller's stack pointer, after return
+    "\tmovq %rcx, 0(%rdi)\n"
+    "\tmovq %rax, 8(%rdi)\n"
+    "\tmovq %rbx, 16(%rdi)\n"
+    "\tmovq %rbp, 24(%rdi)\n"
+    "\tmovq %r12, 32(%rdi)\n"
+    "\tmovq %r13, 40(%rdi)\n"
+    "\tmovq %r14, 48(%rdi)\n"
+    "\tmovq %r15, 56(%rdi)\n"
+    "\tmovq %rsi, %rdi\n"
+    "\tjmp jl_fiber_set_asm\n"
+    ".size jl_fiber_swap_asm,.-jl_fiber_swap_asm\n"
+    ".global jl_fiber_set_asm\n"
+    ".hidden jl_fiber_set_asm\n"
+    ".type jl_fiber_set_asm,@function\n"
+"jl_fiber_set_asm:\n"
+    "\tmovq 16(%rdi), %rbx\n"
+    "\tmovq 24(%rdi), %rbp\n"
+    "\tmovq 32(%rdi), %r12\n"
+    "\tmovq 40(%rdi), %r13\n"
+    "\tmovq 48(%rdi), %r14\n"
+    "\tmovq 56(%rdi), %r15\n"
+    "\tmovq 0(%rdi), %rsp\n"
+    "\tjmpq *8(%rdi)\n"
+    ".size jl_fiber_set_asm,.-jl_fiber_set_asm\n");
+#elif defined(_CPU_AARCH64_)
+// layout (8-byte slots): 0 sp, 1 pc, 2-11 x19-x28, 12 x29, 13-20 d8-d15
+static_assert(sizeof(jl_jmp_buf) >= 21 * sizeof(uintptr_t), "fiber context does not fit in jmp_buf");
+asm(".text\n"
+    ".p2align 2\n"
+    ".global jl_fiber_swap_asm\n"
+    ".hidden jl_fiber_swap_asm\n"
+    ".type jl_fiber_swap_asm,@function\n"
+"jl_fiber_swap_asm:\n"
+    "\tmov x2, sp\n"
+    "\tstp x2, x30, [x0]\n"       // x30 (lr) is the resume point
+    "\tstp x19, x20, [x0, 16]\n"
+    "\tstp x21, x22, [x0, 32]\n"
+    "\tstp x23, x24, [x0, 48]\n"
+    "\tstp x25, x26, [x0, 64]\n"
+    "\tstp x27, x28, [x0, 80]\n"
+    "\tstr x29, [x0, 96]\n"
+    "\tstp d8, d9, [x0, 104]\n"
+    "\tstp d10, d11, [x0, 120]\n"
+    "\tstp d12, d13, [x0, 136]\n"
+    "\tstp d14, d15, [x0, 152]\n"
+    "\tmov x0, x1\n"
+    "\tb jl_fiber_set_asm\n"
+    ".size jl_fiber_swap_asm,.-jl_fiber_swap_asm\n"
+    ".global jl_fiber_set_asm\n"
+    ".hidden jl_fiber_set_asm\n"
+    ".type jl_fiber_set_asm,@function\n"
+"jl_fiber_set_asm:\n"
+    "\tldp x2, x30, [x0]\n"
+    "\tldp x19, x20, [x0, 16]\n"
+    "\tldp x21, x22, [x0, 32]\n"
+    "\tldp x23, x24, [x0, 48]\n"
+    "\tldp x25, x26, [x0, 64]\n"
+    "\tldp x27, x28, [x0, 80]\n"
+    "\tldr x29, [x0, 96]\n"
+    "\tldp d8, d9, [x0, 104]\n"
+    "\tldp d10, d11, [x0, 120]\n"
+    "\tldp d12, d13, [x0, 136]\n"
+    "\tldp d14, d15, [x0, 152]\n"
+    "\tmov sp, x2\n"
+    "\tret\n"                     // jumps to the resume point in x30
+    ".size jl_fiber_set_asm,.-jl_fiber_set_asm\n");
+#endif
+static void jl_swap_fiber(jl_ucontext_t *lastt, jl_ucontext_t *t)
+{
+    tsan_switch_to_ctx(t);
+    jl_fiber_swap_asm((uintptr_t*)&lastt->ctx.uc_mcontext,
+                      (uintptr_t*)&t->ctx.uc_mcontext); // resumes here on switch back
+}
+static void jl_set_fiber(jl_ucontext_t *t)
+{
+    jl_fiber_set_asm((uintptr_t*)&t->ctx.uc_mcontext);
+}
+#else
 static void jl_swap_fiber(jl_ucontext_t *lastt, jl_ucontext_t *t)
 {
     if (jl_setjmp(lastt->ctx.uc_mcontext, 0))
@@ -1046,6 +1285,7 @@ static void jl_set_fiber(jl_ucontext_t *t)
     jl_longjmp(t->ctx.uc_mcontext, 1);
 }
 #endif
+#endif
 
 #if defined(JL_HAVE_UNW_CONTEXT) && !defined(JL_HAVE_ASM)
 #if defined(_CPU_X86_) || defined(_CPU_X86_64_)
@@ -1112,6 +1352,43 @@ static void jl_start_fiber_swap(jl_ucontext_t *lastt, jl_ucontext_t *t)
 #endif
 
 #if defined(JL_HAVE_ASM)
+#ifdef JL_HAVE_FAST_SWITCH
+// Build a resumable context for a fiber that has not run yet: the resume
+// point is start_task on a fresh frame whose caller chain is NULL, so the
+// unwinder terminates there. The remaining register slots are left
+// uninitialized; start_task assumes nothing about them.
+static void jl_prep_start_ctx(jl_ucontext_t *t) JL_NOTSAFEPOINT
+{
+    char *stk = ((char**)&t->ctx)[0];
+    size_t ssize = ((size_t*)&t->ctx)[1];
+    uintptr_t *buf = (uintptr_t*)&t->ctx.uc_mcontext;
+    stk += ssize;
+#if defined(_CPU_X86_64_)
+    stk -= sizeof(uintptr_t);
+    *(uintptr_t*)stk = 0; // fake NULL return address, instead of RSP
+    buf[0] = (uintptr_t)stk;
+    buf[1] = (uintptr_t)&start_task;
+    buf[3] = 0; // clear RBP to terminate the unwinder
+#else // _CPU_AARCH64_
+    buf[0] = (uintptr_t)stk;
+    buf[1] = (uintptr_t)&start_task;
+    buf[12] = 0; // clear the frame pointer (x29) to terminate the unwinder
+#endif
+}
+static void jl_start_fiber_swap(jl_ucontext_t *lastt, jl_ucontext_t *t)
+{
+    assert(lastt);
+    jl_prep_start_ctx(t);
+    tsan_switch_to_ctx(t);
+    jl_fiber_swap_asm((uintptr_t*)&lastt->ctx.uc_mcontext,
+                      (uintptr_t*)&t->ctx.uc_mcontext); // resumes here on switch back
+}
+static void jl_start_fiber_set(jl_ucontext_t *t)
+{
+    jl_prep_start_ctx(t);
+    jl_fiber_set_asm((uintptr_t*)&t->ctx.uc_mcontext);
+}
+#else
 static void jl_start_fiber_swap(jl_ucontext_t *lastt, jl_ucontext_t *t)
 {
     assert(lastt);
@@ -1200,6 +1477,7 @@ static void jl_start_fiber_set(jl_ucontext_t *t)
     __builtin_unreachable();
 }
 #endif
+#endif
 
 #if defined(JL_HAVE_SIGALTSTACK)
 #if defined(_COMPILER_TSAN_ENABLED_)
@@ -1362,9 +1640,14 @@ jl_task_t *jl_init_root_task(jl_ptls_t ptls, void *stack_lo, void *stack_hi)
     ct->excstack = NULL;
     jl_atomic_store_relaxed(&ct->tid, ptls->tid);
     ct->threadpoolid = jl_threadpoolid(ptls->tid);
+    ct->socket_hint = -1;
+    ct->last_socket = jl_thread_socket(ptls->tid);
     ct->sticky = 1;
     ct->ptls = ptls;
     ct->world_age = 1; // OK to run Julia code on this task
+    ct->allocd_bytes = 0;
+    ptls->task_alloc_base = jl_atomic_load_relaxed(&ptls->gc_num.cum_allocd);
+    jl_task_preempt_reset(ptls);
     ptls->root_task = ct;
     jl_atomic_store_relaxed(&ptls->current_task, ct);
     JL_GC_PROMISE_ROOTED(ct);
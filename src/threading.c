@@ -528,6 +528,97 @@ void jl_init_threading(void)
 
 static uv_barrier_t thread_init_done;
 
+// NUMA topology, detected at startup when NUMA pinning is requested
+// (see JULIA_NUMA in jl_start_threads); `jl_numa_pinned` tells the GC
+// that threads stay on their node, so first-touch page placement is
+// worth preserving (see jl_gc_free_page).
+int jl_numa_pinned = 0;
+#ifdef _OS_LINUX_
+static int numa_nnodes = 0;
+static char *numa_masks = NULL; // numa_nnodes masks of cpumasksize bytes each
+
+// parse a sysfs cpulist like "0-15,32-47" into a byte-per-cpu mask
+static int numa_parse_cpulist(const char *list, char *mask, int cpumasksize)
+{
+    const char *p = list;
+    while (*p && *p != '\n') {
+        char *end;
+        long lo = strtol(p, &end, 10);
+        if (end == p)
+            return -1;
+        long hi = lo;
+        p = end;
+        if (*p == '-') {
+            hi = strtol(p + 1, &end, 10);
+            if (end == p + 1)
+                return -1;
+            p = end;
+        }
+        for (long c = lo; c <= hi && c < cpumasksize; c++)
+            mask[c] = 1;
+        if (*p == ',')
+            p++;
+    }
+    return 0;
+}
+
+// returns the number of NUMA nodes (0 if the topology cannot be read or
+// the machine only has one node) and fills `numa_masks`
+static int numa_detect(int cpumasksize)
+{
+    int node;
+    for (node = 0; ; node++) {
+        char path[128], line[4096];
+        snprintf(path, sizeof(path),
+                 "/sys/devices/system/node/node%d/cpulist", node);
+        FILE *f = fopen(path, "r");
+        if (f == NULL)
+            break;
+        if (node == 0) {
+            numa_masks = (char*)malloc_s((size_t)cpumasksize * 64);
+            memset(numa_masks, 0, (size_t)cpumasksize * 64);
+        }
+        char *mask = numa_masks + (size_t)node * cpumasksize;
+        if (fgets(line, sizeof(line), f) == NULL ||
+            numa_parse_cpulist(line, mask, cpumasksize) != 0) {
+            fclose(f);
+            return 0;
+        }
+        fclose(f);
+        if (node == 63) { // cap at 64 nodes (the size of numa_masks)
+            node++;
+            break;
+        }
+    }
+    if (node < 2)
+        return 0;
+    return node;
+}
+#endif
+
+// Locality id of a thread for NUMA-aware scheduling. With node pinning
+// enabled the mapping is the static round-robin assignment made in
+// jl_start_threads below; without pinning threads have no stable node, so
+// everything reports node 0 and the locality-aware paths degenerate to the
+// plain policies.
+JL_DLLEXPORT int16_t jl_thread_socket(int16_t tid) JL_NOTSAFEPOINT
+{
+#ifdef _OS_LINUX_
+    if (jl_numa_pinned)
+        return (int16_t)(tid % numa_nnodes);
+#endif
+    return 0;
+}
+
+JL_DLLEXPORT int16_t jl_n_sockets(void) JL_NOTSAFEPOINT
+{
+#ifdef _OS_LINUX_
+    if (jl_numa_pinned)
+        return (int16_t)numa_nnodes;
+#endif
+    return 1;
+}
+
 void jl_start_threads(void)
 {
     int cpumasksize = uv_cpumask_size();
@@ -544,6 +635,24 @@ void jl_start_threads(void)
     if (cp && strcmp(cp, "0") != 0)
         exclusive = 1;
 
+#ifdef _OS_LINUX_
+    // NUMA pinning: assign threads to NUMA nodes round-robin and pin each
+    // thread to all CPUs of its node (rather than to a single proc), so
+    // that first-touched pages -- including each thread's GC pools -- stay
+    // on the local memory controller while the kernel can still balance
+    // threads within the node; takes precedence over JULIA_EXCLUSIVE
+    cp = getenv(NUMA_PINNING_NAME);
+    if (cp && strcmp(cp, "0") != 0) {
+        numa_nnodes = numa_detect(cpumasksize);
+        if (numa_nnodes > 0) {
+            jl_numa_pinned = 1;
+            exclusive = 0;
+            uvtid = uv_thread_self();
+            uv_thread_setaffinity(&uvtid, numa_masks, NULL, cpumasksize);
+        }
+    }
+#endif
+
     // exclusive use: affinitize threads, master thread on proc 0, rest
     // according to a 'compact' policy
     // non-exclusive: no affinity settings; let the kernel move threads about
@@ -570,6 +679,11 @@ void jl_start_threads(void)
         t->tid = i;
         t->barrier = &thread_init_done;
         uv_thread_create(&uvtid, jl_threadfun, t);
+#ifdef _OS_LINUX_
+        if (jl_numa_pinned)
+            uv_thread_setaffinity(&uvtid, numa_masks + (size_t)(i % numa_nnodes) * cpumasksize,
+                                  NULL, cpumasksize);
+#endif
         if (exclusive) {
             mask[i] = 1;
             uv_thread_setaffinity(&uvtid, mask, NULL, cpumasksize);
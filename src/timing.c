@@ -62,6 +62,114 @@ jl_timing_block_t *jl_pop_timing_block(jl_timing_block_t *cur_block)
     return cur_block->prev;
 }
 
+// Scoped-event tracing: while enabled, every timing block entry/exit is also
+// appended to a per-thread event ring, giving a timeline view of the runtime
+// on top of the aggregate counters above. Each ring has a single writer (its
+// thread) and keeps the most recent events, so emission is a few stores with
+// no locks or allocation on the hot path.
+
+#define JL_TIMING_TRACE_RING_SZ 65536 // events per thread, a power of two
+
+typedef struct {
+    uint64_t t;    // cycleclock() at emission
+    int32_t owner; // jl_timing_owners
+    int32_t phase; // 0 = begin, 1 = end
+} jl_timing_trace_event_t;
+
+struct _jl_timing_trace_ring_t {
+    jl_timing_trace_event_t events[JL_TIMING_TRACE_RING_SZ];
+    _Atomic(uint64_t) n; // events ever emitted; the ring keeps the last RING_SZ
+    int16_t tid;
+};
+
+_Atomic(int) jl_timing_trace_enabled = 0;
+static struct _jl_timing_trace_ring_t **trace_rings = NULL;
+// cycle <-> wall-clock calibration, taken when tracing is enabled
+static uint64_t trace_t0_cycles = 0;
+static uint64_t trace_t0_ns = 0;
+
+JL_DLLEXPORT int jl_timing_trace_enable(int enable)
+{
+    if (enable && trace_rings == NULL) {
+        trace_rings = (struct _jl_timing_trace_ring_t**)calloc(jl_n_threads, sizeof(void*));
+        if (trace_rings == NULL)
+            return -1;
+    }
+    if (enable) {
+        trace_t0_cycles = cycleclock();
+        trace_t0_ns = jl_hrtime();
+    }
+    jl_atomic_store_release(&jl_timing_trace_enabled, !!enable);
+    return 0;
+}
+
+void jl_timing_trace_event(int owner, int phase, uint64_t t)
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    struct _jl_timing_trace_ring_t *ring = ptls->timing_trace_ring;
+    if (ring == NULL) {
+        if (trace_rings == NULL || ptls->tid >= jl_n_threads)
+            return;
+        ring = (struct _jl_timing_trace_ring_t*)calloc(1, sizeof(*ring));
+        if (ring == NULL)
+            return;
+        ring->tid = ptls->tid;
+        ptls->timing_trace_ring = ring;
+        trace_rings[ptls->tid] = ring;
+    }
+    uint64_t n = jl_atomic_load_relaxed(&ring->n);
+    jl_timing_trace_event_t *ev = &ring->events[n & (JL_TIMING_TRACE_RING_SZ - 1)];
+    ev->t = t;
+    ev->owner = owner;
+    ev->phase = phase;
+    jl_atomic_store_release(&ring->n, n + 1);
+}
+
+// Write the recorded events as a Chrome trace-event file (loadable in
+// chrome://tracing, Perfetto, speedscope, ...), with timestamps in
+// microseconds and one track per thread. Meant to be called after
+// jl_timing_trace_enable(0); a dump while tracing is running may observe
+// (and skips) partially overwritten ring slots.
+JL_DLLEXPORT int jl_timing_trace_dump(const char *fname)
+{
+    if (trace_rings == NULL)
+        return -1;
+    // convert cycle counts to time using the rate observed while tracing
+    uint64_t now_cycles = cycleclock();
+    uint64_t now_ns = jl_hrtime();
+    double ns_per_cycle = now_cycles == trace_t0_cycles ? 1.0 :
+        (double)(now_ns - trace_t0_ns) / (double)(now_cycles - trace_t0_cycles);
+    FILE *f = fopen(fname, "w");
+    if (f == NULL)
+        return -1;
+    int pid = (int)uv_os_getpid();
+    fputs("[\n", f);
+    int first = 1;
+    for (int i = 0; i < jl_n_threads; i++) {
+        struct _jl_timing_trace_ring_t *ring = trace_rings[i];
+        if (ring == NULL)
+            continue;
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                   "\"args\":{\"name\":\"julia thread %d\"}}",
+                first ? "" : ",\n", pid, (int)ring->tid, (int)ring->tid);
+        first = 0;
+        uint64_t n = jl_atomic_load_acquire(&ring->n);
+        uint64_t start = n > JL_TIMING_TRACE_RING_SZ ? n - JL_TIMING_TRACE_RING_SZ : 0;
+        for (uint64_t j = start; j < n; j++) {
+            jl_timing_trace_event_t ev = ring->events[j & (JL_TIMING_TRACE_RING_SZ - 1)];
+            if (ev.owner < 0 || ev.owner >= (int)JL_TIMING_LAST || ev.t < trace_t0_cycles)
+                continue;
+            double ts = (double)(ev.t - trace_t0_cycles) * ns_per_cycle / 1e3;
+            fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"julia\",\"ph\":\"%c\",\"ts\":%.3f,"
+                       "\"pid\":%d,\"tid\":%d}",
+                    jl_timing_names[ev.owner], ev.phase ? 'E' : 'B', ts, pid, (int)ring->tid);
+        }
+    }
+    fputs("\n]\n", f);
+    fclose(f);
+    return 0;
+}
+
 void jl_timing_block_start(jl_timing_block_t *cur_block)
 {
     _jl_timing_block_start(cur_block, cycleclock());
@@ -76,6 +184,8 @@ void jl_timing_block_stop(jl_timing_block_t *cur_block)
 
 void jl_init_timing(void) { }
 void jl_destroy_timing(void) { }
+JL_DLLEXPORT int jl_timing_trace_enable(int enable) { (void)enable; return -1; }
+JL_DLLEXPORT int jl_timing_trace_dump(const char *fname) { (void)fname; return -1; }
 
 #endif
 
@@ -25,6 +25,13 @@ void jl_print_timings(void);
 jl_timing_block_t *jl_pop_timing_block(jl_timing_block_t *cur_block);
 void jl_timing_block_start(jl_timing_block_t *cur_block);
 void jl_timing_block_stop(jl_timing_block_t *cur_block);
+// Scoped-event tracing (timing.c): while enabled, every timing block entry
+// and exit is also appended to a per-thread lock-free event ring, which
+// jl_timing_trace_dump writes out as a Chrome trace-event file.
+extern _Atomic(int) jl_timing_trace_enabled;
+void jl_timing_trace_event(int owner, int phase, uint64_t t);
+JL_DLLEXPORT int jl_timing_trace_enable(int enable);
+JL_DLLEXPORT int jl_timing_trace_dump(const char *fname);
 #ifdef __cplusplus
 }
 #endif
@@ -65,7 +72,9 @@ void jl_timing_block_stop(jl_timing_block_t *cur_block);
         X(ADD_METHOD),            \
         X(LOAD_MODULE),           \
         X(SAVE_MODULE),           \
-        X(INIT_MODULE),
+        X(INIT_MODULE),           \
+        X(DISPATCH),              \
+        X(SCHEDULER),
 
 enum jl_timing_owners {
 #define X(name) JL_TIMING_ ## name
@@ -116,6 +125,8 @@ STATIC_INLINE uint64_t _jl_timing_block_init(jl_timing_block_t *block, int owner
 
 STATIC_INLINE void _jl_timing_block_ctor(jl_timing_block_t *block, int owner) {
     uint64_t t = _jl_timing_block_init(block, owner);
+    if (__unlikely(jl_atomic_load_relaxed(&jl_timing_trace_enabled)))
+        jl_timing_trace_event(owner, 0, t);
     jl_task_t *ct = jl_current_task;
     jl_timing_block_t **prevp = &ct->ptls->timing_stack;
     block->prev = *prevp;
@@ -128,6 +139,8 @@ STATIC_INLINE void _jl_timing_block_destroy(jl_timing_block_t *block) {
     uint64_t t = cycleclock();
     jl_task_t *ct = jl_current_task;
     _jl_timing_block_stop(block, t);
+    if (__unlikely(jl_atomic_load_relaxed(&jl_timing_trace_enabled)))
+        jl_timing_trace_event(block->owner, 1, t);
     jl_timing_data[block->owner] += block->total;
     jl_timing_block_t **pcur = &ct->ptls->timing_stack;
     assert(*pcur == block);
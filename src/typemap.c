@@ -289,7 +289,18 @@ static jl_typemap_t *mtcache_hash_lookup(jl_array_t *cache JL_PROPAGATES_ROOT, j
 {
     if (cache == (jl_array_t*)jl_an_empty_vec_any)
         return (jl_typemap_t*)jl_nothing;
-    jl_typemap_t *ml = (jl_typemap_t*)jl_eqtable_get(cache, ty, jl_nothing);
+    // The keys stored here are interned type objects that carry their
+    // identity hash inline (concrete types in `arg1`/`targ`, typenames in
+    // `name1`/`tname`), so the common dispatch probe can reuse that hash
+    // instead of recomputing it through `jl_object_id_` on every lookup.
+    jl_typemap_t *ml;
+    jl_value_t *tag = jl_typeof(ty);
+    if (tag == (jl_value_t*)jl_datatype_type && ((jl_datatype_t*)ty)->isconcretetype)
+        ml = (jl_typemap_t*)jl_eqtable_get_hashed(cache, ty, ((jl_datatype_t*)ty)->hash, jl_nothing);
+    else if (tag == (jl_value_t*)jl_typename_type)
+        ml = (jl_typemap_t*)jl_eqtable_get_hashed(cache, ty, ((jl_typename_t*)ty)->hash, jl_nothing);
+    else
+        ml = (jl_typemap_t*)jl_eqtable_get(cache, ty, jl_nothing);
     JL_GC_PROMISE_ROOTED(ml); // clang-sa doesn't trust our JL_PROPAGATES_ROOT claim
     return ml;
 }
@@ -440,6 +451,8 @@ static int jl_typemap_intersection_node_visitor(jl_typemap_entry_t *ml, struct t
     // mark this `register` because (for branch prediction)
     // that can be absolutely critical for speed
     register jl_typemap_intersection_visitor_fptr fptr = closure->fptr;
+    // loop-invariant: `closure->type` does not change across entries
+    int dispatch_tuple = jl_is_dispatch_tupletype(closure->type);
     while (ml != (void*)jl_nothing) {
         if (closure->type == (jl_value_t*)ml->sig) {
             // fast-path for the intersection of a type with itself
@@ -462,7 +475,7 @@ static int jl_typemap_intersection_node_visitor(jl_typemap_entry_t *ml, struct t
                 // for intersect(A, B) even though A is a dispatch tuple and !(A <: B).
                 // For dispatch purposes in such a case we know there's no match. This check
                 // fixes issue #30394.
-                if (closure->issubty || !jl_is_dispatch_tupletype(closure->type))
+                if (closure->issubty || !dispatch_tuple)
                     if (!fptr(ml, closure))
                         return 0;
             }
@@ -923,6 +936,9 @@ jl_typemap_entry_t *jl_typemap_entry_assoc_exact(jl_typemap_entry_t *ml, jl_valu
     // some manually-unrolled common special cases
     while (ml->simplesig == (void*)jl_nothing && ml->guardsigs == jl_emptysvec && ml->isleafsig) {
         // use a tight loop for as long as possible
+        jl_typemap_entry_t *next = jl_atomic_load_relaxed(&ml->next);
+        if (next != (void*)jl_nothing)
+            __builtin_prefetch(next); // overlap fetching the next entry with this signature check
         if (world >= ml->min_world && world <= ml->max_world) {
             if (n == jl_nparams(ml->sig) && jl_typeof(arg1) == jl_tparam(ml->sig, 0)) {
                 if (n == 1)
@@ -942,12 +958,13 @@ jl_typemap_entry_t *jl_typemap_entry_assoc_exact(jl_typemap_entry_t *ml, jl_valu
                 }
             }
         }
-        ml = jl_atomic_load_relaxed(&ml->next);
+        ml = next;
         if (ml == (void*)jl_nothing)
             return NULL;
     }
 
     for (; ml != (void*)jl_nothing; ml = jl_atomic_load_relaxed(&ml->next)) {
+        __builtin_prefetch(jl_atomic_load_relaxed(&ml->next));
         if (world < ml->min_world || world > ml->max_world)
             continue; // ignore replaced methods
         size_t lensig = jl_nparams(ml->sig);
@@ -172,6 +172,21 @@ Clear any existing backtraces from the internal buffer.
 """
 clear() = ccall(:jl_profile_clear_data, Cvoid, ())
 
+"""
+    recompile_hot(threshold::Integer = 0)
+
+Recompile every method whose compiled frames appear at least `threshold` times
+in the collected profile data at the highest optimization level, replacing the
+code used by future calls. Pass `threshold <= 0` to use a default threshold.
+Returns the number of methods recompiled.
+
+Long-running services can call this periodically after a profiling run (and
+then [`clear`](@ref) the buffer) to converge their hot paths to peak
+optimization even when the session runs at a lower optimization level.
+"""
+recompile_hot(threshold::Integer = 0) =
+    Int(ccall(:jl_profile_recompile_hot, Csize_t, (Int64,), threshold))
+
 const LineInfoDict = Dict{UInt64, Vector{StackFrame}}
 const LineInfoFlatDict = Dict{UInt64, StackFrame}
 
@@ -605,6 +620,45 @@ len_data() = convert(Int, ccall(:jl_profile_len_data, Csize_t, ()))
 
 maxlen_data() = convert(Int, ccall(:jl_profile_maxlen_data, Csize_t, ()))
 
+"""
+    Profile.set_aggregation(enable::Bool)
+
+Enable or disable online folding of identical sample blocks in the C sampler.
+When enabled, a repeated (stack, thread, task, sleep-state) sample bumps a
+count on its first-seen block instead of appending a copy, so long profiling
+runs stop growing the buffer once the distinct stacks have been seen, and the
+profiler keeps running when the buffer fills (dropped novel samples are
+counted, see [`n_dropped_samples`](@ref)). Per-block sample counts can be
+retrieved with [`get_fold_counts`](@ref). May only be changed while the
+profiler is stopped; takes effect at the next [`init`](@ref).
+"""
+set_aggregation(enable::Bool) = ccall(:jl_profile_set_aggregation, Cint, (Cint,), enable) == 0
+
+"""
+    Profile.n_dropped_samples() -> UInt64
+
+Number of profile samples discarded because the sample buffer was full. Always
+zero unless aggregation is enabled (see [`set_aggregation`](@ref)); without it
+the profiler instead stops when the buffer fills.
+"""
+n_dropped_samples() = ccall(:jl_profile_n_dropped, UInt64, ())
+
+"""
+    Profile.get_fold_counts() -> (offsets, counts)
+
+Return the 0-based word offsets of the distinct sample blocks recorded with
+aggregation enabled, and the number of samples folded into each. Blocks not
+listed represent one sample each.
+"""
+function get_fold_counts()
+    n = ccall(:jl_profile_get_fold_counts, Csize_t, (Ptr{Csize_t}, Ptr{UInt64}, Csize_t), C_NULL, C_NULL, 0)
+    offsets = Vector{Csize_t}(undef, n)
+    counts = Vector{UInt64}(undef, n)
+    n2 = ccall(:jl_profile_get_fold_counts, Csize_t, (Ptr{Csize_t}, Ptr{UInt64}, Csize_t), offsets, counts, n)
+    @assert n2 == n
+    return offsets, counts
+end
+
 error_codes = Dict(
     -1=>"cannot specify signal action for profiling",
     -2=>"cannot create the timer for profiling",
@@ -38,6 +38,12 @@ let r = Profile.retrieve()
     end
 end
 
+# profile-guided recompilation: the samples collected above are dominated by
+# `busywait`, so a threshold of one sample must recompile something while an
+# unreachably large one must not
+@test Profile.recompile_hot(typemax(Int32)) == 0
+@test Profile.recompile_hot(1) >= 1
+
 let iobuf = IOBuffer()
     Profile.print(iobuf, format=:tree, C=true)
     str = String(take!(iobuf))
@@ -144,3 +144,56 @@ L2:
 }
 """)
 # CHECK-LABEL: }{{$}}
+
+# Test that an allocation passed to a leaf callee defined in the same module
+# is still stack allocated when the callee's escape summary proves the
+# argument harmless, and that a capturing callee blocks the optimization.
+
+# CHECK-LABEL: @leaf_callee_arg
+# CHECK-NOT: @julia.gc_alloc_obj
+# CHECK: alloca
+# CHECK: [[CAST:%.*]] = addrspacecast {}* {{.*}} to {} addrspace(10)*
+# CHECK: call {{i[0-9]+}} @leaf_callee({} addrspace(10)* [[CAST]])
+println("""
+define $isz @leaf_callee({} addrspace(10)* %obj) {
+  %p = bitcast {} addrspace(10)* %obj to $isz addrspace(10)*
+  %pd = addrspacecast $isz addrspace(10)* %p to $isz addrspace(11)*
+  %r = load $isz, $isz addrspace(11)* %pd
+  ret $isz %r
+}
+
+define $isz @leaf_callee_arg($isz %x) {
+  %pgcstack = call {}*** @julia.get_pgcstack()
+  %ptls = call {}*** @julia.ptls_states()
+  %ptls_i8 = bitcast {}*** %ptls to i8*
+  %v = call noalias {} addrspace(10)* @julia.gc_alloc_obj(i8* %ptls_i8, $isz 8, {} addrspace(10)* @tag)
+  %v_p = bitcast {} addrspace(10)* %v to $isz addrspace(10)*
+  store $isz %x, $isz addrspace(10)* %v_p
+  %r = call $isz @leaf_callee({} addrspace(10)* %v)
+  ret $isz %r
+}
+""")
+# CHECK-LABEL: }{{$}}
+
+# CHECK-LABEL: @capture_callee_arg
+# CHECK: @julia.gc_alloc_obj
+println("""
+@glob = external global {} addrspace(10)*
+
+define void @capture_callee({} addrspace(10)* %obj) {
+  store {} addrspace(10)* %obj, {} addrspace(10)** @glob
+  ret void
+}
+
+define void @capture_callee_arg($isz %x) {
+  %pgcstack = call {}*** @julia.get_pgcstack()
+  %ptls = call {}*** @julia.ptls_states()
+  %ptls_i8 = bitcast {}*** %ptls to i8*
+  %v = call noalias {} addrspace(10)* @julia.gc_alloc_obj(i8* %ptls_i8, $isz 8, {} addrspace(10)* @tag)
+  %v_p = bitcast {} addrspace(10)* %v to $isz addrspace(10)*
+  store $isz %x, $isz addrspace(10)* %v_p
+  call void @capture_callee({} addrspace(10)* %v)
+  ret void
+}
+""")
+# CHECK-LABEL: }{{$}}
@@ -0,0 +1,87 @@
+; RUN: opt -enable-new-pm=0 -load libjulia-codegen%shlibext -BoundsCheckElim -S %s | FileCheck %s
+; RUN: opt -enable-new-pm=1 --load-pass-plugin=libjulia-codegen%shlibext -passes='function(BoundsCheckElim)' -S %s | FileCheck %s
+
+declare void @ijl_bounds_error_int(i8* nonnull readonly, i64)
+declare i64 @use(i64)
+
+; A check against the same length with a smaller constant index is implied by
+; the dominating one and folds to an unconditional branch.
+define i64 @subsumed_constant(i8* %a, i64 %len) {
+; CHECK-LABEL: @subsumed_constant
+; CHECK: br i1 %ok1, label %pass1, label %fail1
+; CHECK: pass1:
+; CHECK: br i1 true, label %pass2, label %fail2
+top:
+  %ok1 = icmp ult i64 7, %len
+  br i1 %ok1, label %pass1, label %fail1
+
+fail1:
+  call void @ijl_bounds_error_int(i8* %a, i64 8)
+  unreachable
+
+pass1:
+  %ok2 = icmp ult i64 3, %len
+  br i1 %ok2, label %pass2, label %fail2
+
+fail2:
+  call void @ijl_bounds_error_int(i8* %a, i64 4)
+  unreachable
+
+pass2:
+  ret i64 0
+}
+
+; The same index checked twice against the same length (e.g. after inlining
+; two accesses) needs only the first check.
+define i64 @subsumed_same_index(i8* %a, i64 %i, i64 %len) {
+; CHECK-LABEL: @subsumed_same_index
+; CHECK: br i1 %ok1, label %pass1, label %fail1
+; CHECK: pass1:
+; CHECK: br i1 true, label %pass2, label %fail2
+top:
+  %ok1 = icmp ult i64 %i, %len
+  br i1 %ok1, label %pass1, label %fail1
+
+fail1:
+  call void @ijl_bounds_error_int(i8* %a, i64 %i)
+  unreachable
+
+pass1:
+  %v = call i64 @use(i64 %i)
+  %ok2 = icmp ult i64 %i, %len
+  br i1 %ok2, label %pass2, label %fail2
+
+fail2:
+  call void @ijl_bounds_error_int(i8* %a, i64 %i)
+  unreachable
+
+pass2:
+  ret i64 %v
+}
+
+; A larger index is not implied by a dominating check of a smaller one.
+define i64 @not_subsumed(i8* %a, i64 %len) {
+; CHECK-LABEL: @not_subsumed
+; CHECK: br i1 %ok1, label %pass1, label %fail1
+; CHECK: pass1:
+; CHECK-NEXT: %ok2 = icmp ult i64 9, %len
+; CHECK-NEXT: br i1 %ok2, label %pass2, label %fail2
+top:
+  %ok1 = icmp ult i64 5, %len
+  br i1 %ok1, label %pass1, label %fail1
+
+fail1:
+  call void @ijl_bounds_error_int(i8* %a, i64 6)
+  unreachable
+
+pass1:
+  %ok2 = icmp ult i64 9, %len
+  br i1 %ok2, label %pass2, label %fail2
+
+fail2:
+  call void @ijl_bounds_error_int(i8* %a, i64 10)
+  unreachable
+
+pass2:
+  ret i64 0
+}
@@ -59,7 +59,12 @@ top:
   %pgcstack = call {}*** @julia.get_pgcstack()
   %ptls = call {}*** @julia.ptls_states()
   %ptls_i8 = bitcast {}*** %ptls to i8*
-; CHECK: %v = call noalias nonnull {} addrspace(10)* @ijl_gc_pool_alloc
+; CHECK: load i32, i32* @g_alloc_profile_enabled
+; CHECK: alloc.pool.fast:
+; CHECK: alloc.pool.slow:
+; CHECK: call noalias nonnull {} addrspace(10)* @ijl_gc_pool_alloc
+; CHECK: alloc.cont:
+; CHECK: %v = phi {} addrspace(10)*
   %v = call {} addrspace(10)* @julia.gc_alloc_bytes(i8* %ptls_i8, i64 8)
   %0 = bitcast {} addrspace(10)* %v to {} addrspace(10)* addrspace(10)*
   %1 = getelementptr {} addrspace(10)*, {} addrspace(10)* addrspace(10)* %0, i64 -1
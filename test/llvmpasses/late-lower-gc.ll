@@ -125,6 +125,84 @@ top:
 ; CHECK: ret i32
 }
 
+define void @lazy_frame_push(i64 %a, i1 %cond) {
+top:
+; CHECK-LABEL: @lazy_frame_push
+; The only safepoints are in %join, which dominates the return, so the frame
+; is not pushed until then.
+; CHECK: %gcframe = call {} addrspace(10)** @julia.new_gc_frame(i32 1)
+; CHECK-NOT: @julia.push_gc_frame
+; CHECK: join:
+; CHECK-NEXT: call void @julia.push_gc_frame({} addrspace(10)** %gcframe, i32 1)
+; CHECK: call void @julia.pop_gc_frame
+    %pgcstack = call {}*** @julia.get_pgcstack()
+    br i1 %cond, label %left, label %right
+
+left:
+    br label %join
+
+right:
+    br label %join
+
+join:
+    %aboxed = call {} addrspace(10)* @jl_box_int64(i64 signext %a)
+    call void @boxed_simple({} addrspace(10)* %aboxed, {} addrspace(10)* %aboxed)
+    ret void
+}
+
+declare void @julia.write_barrier({} addrspace(10)*, ...)
+
+define void @elide_wb_fresh(i64 %a) {
+top:
+; CHECK-LABEL: @elide_wb_fresh
+; The parent was just allocated with no safepoint in between, so it cannot be
+; old and the write barrier is removed.
+; CHECK-NOT: ijl_gc_queue_root
+  %pgcstack = call {}*** @julia.get_pgcstack()
+  %0 = bitcast {}*** %pgcstack to {}**
+  %current_task = getelementptr inbounds {}*, {}** %0, i64 -12
+  %child = call {} addrspace(10)* @jl_box_int64(i64 %a)
+  %v = call {} addrspace(10)* @julia.gc_alloc_obj({}** %current_task, i64 8, {} addrspace(10)* @tag)
+  %vf = bitcast {} addrspace(10)* %v to {} addrspace(10)* addrspace(10)*
+  store {} addrspace(10)* %child, {} addrspace(10)* addrspace(10)* %vf
+  call void ({} addrspace(10)*, ...) @julia.write_barrier({} addrspace(10)* %v, {} addrspace(10)* %child)
+  ret void
+}
+
+define void @coalesce_wb({} addrspace(10)* %p, {} addrspace(10)* %c1, {} addrspace(10)* %c2) {
+top:
+; CHECK-LABEL: @coalesce_wb
+; Two barriers on the same parent with no safepoint in between are merged
+; into one (multi-child) barrier.
+; CHECK: ijl_gc_queue_root
+; CHECK-NOT: ijl_gc_queue_root
+  %pgcstack = call {}*** @julia.get_pgcstack()
+  %fp = bitcast {} addrspace(10)* %p to {} addrspace(10)* addrspace(10)*
+  store {} addrspace(10)* %c1, {} addrspace(10)* addrspace(10)* %fp
+  call void ({} addrspace(10)*, ...) @julia.write_barrier({} addrspace(10)* %p, {} addrspace(10)* %c1)
+  %fp2 = getelementptr {} addrspace(10)*, {} addrspace(10)* addrspace(10)* %fp, i64 1
+  store {} addrspace(10)* %c2, {} addrspace(10)* addrspace(10)* %fp2
+  call void ({} addrspace(10)*, ...) @julia.write_barrier({} addrspace(10)* %p, {} addrspace(10)* %c2)
+  ret void
+}
+
+define void @wb_past_safepoint({} addrspace(10)* %c) {
+top:
+; CHECK-LABEL: @wb_past_safepoint
+; A safepoint between the allocation and the barrier may promote the object,
+; so the barrier has to stay.
+; CHECK: ijl_gc_queue_root
+  %pgcstack = call {}*** @julia.get_pgcstack()
+  %0 = bitcast {}*** %pgcstack to {}**
+  %current_task = getelementptr inbounds {}*, {}** %0, i64 -12
+  %v = call {} addrspace(10)* @julia.gc_alloc_obj({}** %current_task, i64 8, {} addrspace(10)* @tag)
+  call void @jl_safepoint()
+  %vf = bitcast {} addrspace(10)* %v to {} addrspace(10)* addrspace(10)*
+  store {} addrspace(10)* %c, {} addrspace(10)* addrspace(10)* %vf
+  call void ({} addrspace(10)*, ...) @julia.write_barrier({} addrspace(10)* %v, {} addrspace(10)* %c)
+  ret void
+}
+
 !0 = !{i64 0, i64 23}
 !1 = !{!1}
 !2 = !{!7} ; scope list
@@ -0,0 +1,370 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+// Microbenchmarks for the C runtime primitives the rest of the system is
+// built on: generic dispatch, pool allocation, subtyping, typemap lookup,
+// task switching, libuv-backed writes and GC pause latency under allocation
+// churn. The harness prints one JSON object
+// per benchmark and can gate against a baseline file produced by an earlier
+// run (see the `runtimebench` target in test/Makefile):
+//
+//     runtimebench [--quick] [--json FILE] [--baseline FILE] [--tolerance PCT]
+//
+// Exit status is nonzero if any benchmark regressed by more than the
+// tolerance (default 20%) relative to the baseline.
+
+#include <julia.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+JULIA_DEFINE_FAST_TLS // only define this once, in an executable
+
+// wall time in nanoseconds
+static uint64_t now_ns(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (uint64_t)(count.QuadPart * (1e9 / freq.QuadPart));
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+// cycle counter where the hardware makes one cheap to read; elsewhere fall
+// back to nanoseconds so the per-op ratios in one run stay comparable
+static uint64_t cycles(void)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    unsigned hi, lo;
+    __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+    uint64_t virtual_timer;
+    __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (virtual_timer));
+    return virtual_timer;
+#else
+    return now_ns();
+#endif
+}
+
+static jl_value_t *checked_eval_string(const char *code)
+{
+    jl_value_t *result = jl_eval_string(code);
+    if (jl_exception_occurred()) {
+        // none of these allocate, so a gc-root (JL_GC_PUSH) is not necessary
+        jl_call2(jl_get_function(jl_base_module, "showerror"),
+                 jl_stderr_obj(),
+                 jl_exception_occurred());
+        jl_printf(jl_stderr_stream(), "\n");
+        jl_atexit_hook(1);
+        exit(1);
+    }
+    return result;
+}
+
+static void check_exception(const char *name)
+{
+    if (jl_exception_occurred()) {
+        fprintf(stderr, "runtimebench: exception in benchmark %s\n", name);
+        jl_call2(jl_get_function(jl_base_module, "showerror"),
+                 jl_stderr_obj(),
+                 jl_exception_occurred());
+        jl_printf(jl_stderr_stream(), "\n");
+        jl_atexit_hook(1);
+        exit(1);
+    }
+}
+
+typedef struct {
+    const char *name;
+    uint64_t iters;
+    double ns_per_op;
+    double cycles_per_op;
+} bench_result_t;
+
+#define MAX_RESULTS 16
+static bench_result_t results[MAX_RESULTS];
+static int nresults = 0;
+
+static void record(const char *name, uint64_t iters, uint64_t ns, uint64_t cyc)
+{
+    bench_result_t *r = &results[nresults++];
+    r->name = name;
+    r->iters = iters;
+    r->ns_per_op = (double)ns / iters;
+    r->cycles_per_op = (double)cyc / iters;
+    fprintf(stderr, "%-16s %12.2f ns/op %12.2f cycles/op\n",
+            name, r->ns_per_op, r->cycles_per_op);
+}
+
+// defeat dead-code elimination of the benchmarked results
+static volatile uintptr_t sink;
+
+// --- C-level loops ---
+
+static void bench_dispatch(uint64_t iters)
+{
+    jl_value_t *f = jl_get_function(jl_base_module, "+");
+    jl_value_t *args[2];
+    JL_GC_PUSH3(&f, &args[0], &args[1]);
+    args[0] = jl_box_int64(3);
+    args[1] = jl_box_int64(4);
+    // warmup (compiles the target)
+    jl_apply_generic(f, args, 2);
+    check_exception("dispatch");
+    uint64_t t0 = now_ns(), c0 = cycles();
+    for (uint64_t i = 0; i < iters; i++)
+        sink += (uintptr_t)jl_apply_generic(f, args, 2);
+    record("dispatch", iters, now_ns() - t0, cycles() - c0);
+    JL_GC_POP();
+}
+
+static void bench_alloc(uint64_t iters)
+{
+    // every jl_box_float64 is a fresh pool allocation
+    uint64_t t0 = now_ns(), c0 = cycles();
+    for (uint64_t i = 0; i < iters; i++)
+        sink += (uintptr_t)jl_box_float64((double)i * 1.0001);
+    record("pool_alloc", iters, now_ns() - t0, cycles() - c0);
+}
+
+static void bench_subtype(uint64_t iters)
+{
+    jl_value_t *sub = checked_eval_string(
+        "Tuple{typeof(sum), Vector{Float64}, Base.HasShape{1}}");
+    jl_value_t *super = checked_eval_string(
+        "Tuple{Any, AbstractArray{T, 1} where T, Base.IteratorSize}");
+    JL_GC_PUSH2(&sub, &super);
+    uint64_t t0 = now_ns(), c0 = cycles();
+    for (uint64_t i = 0; i < iters; i++)
+        sink += (uintptr_t)jl_subtype(sub, super);
+    record("subtype", iters, now_ns() - t0, cycles() - c0);
+    JL_GC_POP();
+}
+
+// --- Julia-driven loops (timed from C around one call) ---
+
+static void bench_julia_loop(const char *name, const char *fname, uint64_t iters)
+{
+    jl_value_t *f = jl_get_function(jl_main_module, fname);
+    jl_value_t *n = NULL;
+    JL_GC_PUSH2(&f, &n);
+    // warmup/compile outside the timed region
+    n = jl_box_int64(1);
+    jl_call1(f, n);
+    check_exception(name);
+    n = jl_box_int64((int64_t)iters);
+    uint64_t t0 = now_ns(), c0 = cycles();
+    sink += (uintptr_t)jl_call1(f, n);
+    uint64_t ns = now_ns() - t0, cyc = cycles() - c0;
+    check_exception(name);
+    record(name, iters, ns, cyc);
+    JL_GC_POP();
+}
+
+static void define_julia_helpers(void)
+{
+    // typemap lookup through Base._methods_by_ftype; the Ref keeps the
+    // signature from being constant-folded away
+    checked_eval_string(
+        "function __rb_typemap(n)\n"
+        "    T = Ref{Any}(Tuple{typeof(sum), Vector{Float64}})\n"
+        "    c = 0\n"
+        "    for i = 1:n\n"
+        "        ms = Base._methods_by_ftype(T[], -1, Base.get_world_counter())\n"
+        "        c += ms === false ? 0 : length(ms)\n"
+        "    end\n"
+        "    return c\n"
+        "end");
+    // each yield is a pair of task switches through the scheduler; the
+    // worker is bounded so it does not keep spinning into later benchmarks
+    checked_eval_string(
+        "function __rb_switch(n)\n"
+        "    t = Task(() -> for i = 1:(n + 1); yield(); end)\n"
+        "    t.sticky = true\n"
+        "    schedule(t)\n"
+        "    for i = 1:n\n"
+        "        yield()\n"
+        "    end\n"
+        "    wait(t)\n"
+        "    return n\n"
+        "end");
+    // steady allocation churn with a sliding window of survivors, so the
+    // collector sees both short-lived garbage and live data to mark
+    checked_eval_string(
+        "function __rb_gcchurn(n)\n"
+        "    retained = Vector{Any}(undef, 1024)\n"
+        "    for i = 1:n\n"
+        "        retained[1 + i % 1024] = zeros(64)\n"
+        "    end\n"
+        "    return n\n"
+        "end");
+    checked_eval_string(
+        "function __rb_uvwrite(n)\n"
+        "    path = Sys.iswindows() ? \"NUL\" : \"/dev/null\"\n"
+        "    buf = zeros(UInt8, 4096)\n"
+        "    open(path, \"w\") do io\n"
+        "        for i = 1:n\n"
+        "            write(io, buf)\n"
+        "        end\n"
+        "    end\n"
+        "    return n\n"
+        "end");
+}
+
+// GC latency: drive allocation churn and report pause percentiles from the
+// collector's built-in histogram (jl_gc_pause_histogram) rather than timing
+// individual collections from here
+static void bench_gc_latency(uint64_t iters)
+{
+    jl_value_t *f = jl_get_function(jl_main_module, "__rb_gcchurn");
+    jl_value_t *n = NULL;
+    JL_GC_PUSH2(&f, &n);
+    // warmup/compile outside the measured region
+    n = jl_box_int64(1000);
+    jl_call1(f, n);
+    check_exception("gc_latency");
+    jl_gc_pause_histogram_reset();
+    n = jl_box_int64((int64_t)iters);
+    sink += (uintptr_t)jl_call1(f, n);
+    check_exception("gc_latency");
+    JL_GC_POP();
+
+    uint64_t counts[256], bounds[256];
+    int nb = jl_gc_pause_histogram(JL_GC_PHASE_PAUSE, counts, bounds, 256);
+    if (nb > 256)
+        nb = 256;
+    uint64_t total = 0;
+    for (int i = 0; i < nb; i++)
+        total += counts[i];
+    if (total == 0) {
+        fprintf(stderr, "gc_latency: no collections triggered, skipping\n");
+        return;
+    }
+    uint64_t seen = 0, p50 = 0, p99 = 0;
+    for (int i = 0; i < nb; i++) {
+        seen += counts[i];
+        if (p50 == 0 && seen * 2 >= total)
+            p50 = bounds[i];
+        if (p99 == 0 && seen * 100 >= total * 99)
+            p99 = bounds[i];
+    }
+    record("gc_pause_p50", 1, p50, 0);
+    record("gc_pause_p99", 1, p99, 0);
+}
+
+// --- output and baseline gating ---
+
+static void write_json(FILE *out)
+{
+    // one object per line, so the baseline parser can stay line-based
+    for (int i = 0; i < nresults; i++)
+        fprintf(out, "{\"name\":\"%s\",\"iters\":%llu,"
+                     "\"ns_per_op\":%.3f,\"cycles_per_op\":%.3f}\n",
+                results[i].name, (unsigned long long)results[i].iters,
+                results[i].ns_per_op, results[i].cycles_per_op);
+}
+
+static int compare_baseline(const char *path, double tolerance_pct)
+{
+    FILE *in = fopen(path, "r");
+    if (in == NULL) {
+        fprintf(stderr, "runtimebench: cannot open baseline %s\n", path);
+        return 1;
+    }
+    int failed = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), in)) {
+        char name[64];
+        double base_ns;
+        char *namep = strstr(line, "\"name\":\"");
+        char *nsp = strstr(line, "\"ns_per_op\":");
+        if (namep == NULL || nsp == NULL)
+            continue;
+        if (sscanf(namep + strlen("\"name\":\""), "%63[^\"]", name) != 1)
+            continue;
+        if (sscanf(nsp + strlen("\"ns_per_op\":"), "%lf", &base_ns) != 1)
+            continue;
+        for (int i = 0; i < nresults; i++) {
+            if (strcmp(results[i].name, name) != 0)
+                continue;
+            double limit = base_ns * (1.0 + tolerance_pct / 100.0);
+            if (results[i].ns_per_op > limit) {
+                fprintf(stderr,
+                        "REGRESSION: %s %.2f ns/op vs baseline %.2f ns/op "
+                        "(+%.1f%%, tolerance %.1f%%)\n",
+                        name, results[i].ns_per_op, base_ns,
+                        100.0 * (results[i].ns_per_op / base_ns - 1.0),
+                        tolerance_pct);
+                failed = 1;
+            }
+        }
+    }
+    fclose(in);
+    return failed;
+}
+
+int main(int argc, char *argv[])
+{
+    int quick = 0;
+    const char *json_path = NULL;
+    const char *baseline_path = NULL;
+    double tolerance_pct = 20.0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0)
+            quick = 1;
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            json_path = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            baseline_path = argv[++i];
+        else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+            tolerance_pct = atof(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--quick] [--json FILE] "
+                            "[--baseline FILE] [--tolerance PCT]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    jl_init();
+    define_julia_helpers();
+
+    uint64_t scale = quick ? 1 : 50;
+    bench_dispatch(40000 * scale);
+    bench_alloc(200000 * scale);
+    bench_subtype(20000 * scale);
+    bench_julia_loop("typemap_lookup", "__rb_typemap", 2000 * scale);
+    bench_julia_loop("task_switch", "__rb_switch", 20000 * scale);
+    bench_julia_loop("uv_write", "__rb_uvwrite", 4000 * scale);
+    bench_gc_latency(200000 * scale);
+
+    if (json_path != NULL) {
+        FILE *out = fopen(json_path, "w");
+        if (out == NULL) {
+            fprintf(stderr, "runtimebench: cannot write %s\n", json_path);
+            jl_atexit_hook(1);
+            return 2;
+        }
+        write_json(out);
+        fclose(out);
+    }
+    else {
+        write_json(stdout);
+    }
+
+    int ret = 0;
+    if (baseline_path != NULL)
+        ret = compare_baseline(baseline_path, tolerance_pct);
+    jl_atexit_hook(ret);
+    return ret;
+}